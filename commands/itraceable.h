@@ -28,6 +28,8 @@
 
 #include "ichangeable.h"
 
+#include <QtGlobal>
+
 namespace ysm
 {
 	//! \brief Interface for type independent value tracing.
@@ -45,6 +47,12 @@ namespace ysm
 		 */
 		virtual ITraceableValue* cloneValue() const = 0;
 
+		/*!
+		 * \brief Estimates the memory used by this value.
+		 * \return The value's size in bytes.
+		 */
+		virtual qint64 getValueSize() const = 0;
+
 	protected:
 
 		//! \brief Initialize new instance.
@@ -89,6 +89,20 @@ namespace ysm
 		 */
 		virtual bool didChangeRendering() const = 0;
 
+		/*!
+		 * \brief Estimates the memory required to keep this command in the undo history.
+		 * \return The command's size in bytes.
+		 */
+		virtual qint64 getMemorySize() const = 0;
+
+		/*!
+		 * \brief Tries to merge a command, that was executed directly after this command, into this command.
+		 * On success, undoing this command must also revert the merged command, which is deleted by the queue.
+		 * \param command The executed command.
+		 * \return True, if the command was merged.
+		 */
+		virtual bool mergeWith(IUICommand* command) = 0;
+
 		/*!
 		 * \brief List of all objects, that are changed during execution.
 		 * Note:
@@ -83,15 +83,35 @@ namespace ysm
 		/// @brief Ends the command block.
 		virtual void endCommandBlock() = 0;
 
+		/**
+		 * @brief Returns the estimated memory used by the undo and redo history.
+		 * @return The history's size in bytes.
+		 */
+		virtual qint64 getHistorySize() const = 0;
+
+		/**
+		 * @brief Returns the memory budget of the undo history.
+		 * @return The budget in bytes, zero if unlimited.
+		 */
+		virtual qint64 getHistoryBudget() const = 0;
+
+		/**
+		 * @brief Sets the memory budget of the undo history. The oldest commands are dropped, if it's exceeded.
+		 * @param historyBudget The budget in bytes, zero if unlimited.
+		 */
+		virtual void setHistoryBudget(qint64 historyBudget) = 0;
+
 	signals:
 
 		/// @brief Emitted, whenever a command will be executed, that removes data.
 		void willRemoveData(Document*, const QList<IChangeable*>&);
 
 		/// @brief Emitted, whenever a command was executed, that changes data.
+		/// The changes of a command block are emitted at once, after the block is finished.
 		void didChangeData(Document*, const QList<IChangeable*>&);
 
 		/// @brief Emitted, whenever a command was executed, that added data.
+		/// The additions of a command block are emitted at once, after the block is finished.
 		void didAddData(Document*, const QList<IChangeable*>&);
 
 		/// @brief Emmited, whenever a command was executed, that changes rendering output.
@@ -32,31 +32,29 @@ AutoLayoutItemsCommand::AutoLayoutItemsCommand(IPipeline* pipeline, PipelineScen
 	_pipeline(pipeline),
 	_layouter(layouter)
 {
-	//Calculate a new auto layout.
-	_layouter->updateAutoLayout(_pipeline);
-
 	//Layout all pipeline blocks.
 	foreach(IBlock* block, _pipeline->getBlocks())
-	{
-		//Store the old and new position.
-		_oldPositions[block] = _layouter->getItemPosition(block, QPointF());
-		_newPositions[block] = _layouter->getAutoLayoutItemPosition(block);
-	}
+		if(_layouter->hasAutoLayoutItemPosition(block))
+		{
+			//Store the old and new position.
+			_oldPositions[block] = _layouter->getItemPosition(block, QPointF());
+			_newPositions[block] = _layouter->getAutoLayoutItemPosition(block);
+		}
 
 	//Layout all pipeline commands.
 	foreach(IRenderCommand* renderCommand, _pipeline->getRenderCommands())
-	{
-		//Store the old and new position.
-		_oldPositions[renderCommand] = _layouter->getItemPosition(renderCommand, QPointF());
-		_newPositions[renderCommand] = _layouter->getAutoLayoutItemPosition(renderCommand);
-	}
+		if(_layouter->hasAutoLayoutItemPosition(renderCommand))
+		{
+			//Store the old and new position.
+			_oldPositions[renderCommand] = _layouter->getItemPosition(renderCommand, QPointF());
+			_newPositions[renderCommand] = _layouter->getAutoLayoutItemPosition(renderCommand);
+		}
 }
 
 bool AutoLayoutItemsCommand::execute()
 {
-	//Iterate over all items and set their new position.
-	foreach(IPipelineItem* pipelineItem, _newPositions.keys())
-		_layouter->setItemPosition(pipelineItem, _newPositions[pipelineItem]);
+	//Animate all items to their new position.
+	_layouter->animateItemPositions(_newPositions);
 
 	//Always succeeds.
 	return true;
@@ -64,9 +62,8 @@ bool AutoLayoutItemsCommand::execute()
 
 bool AutoLayoutItemsCommand::undo()
 {
-	//Iterate over all items and set their old position.
-	foreach(IPipelineItem* pipelineItem, _oldPositions.keys())
-		_layouter->setItemPosition(pipelineItem, _oldPositions[pipelineItem]);
+	//Animate all items back to their old position.
+	_layouter->animateItemPositions(_oldPositions);
 
 	//Always succeeds.
 	return true;
@@ -38,16 +38,16 @@ namespace ysm
 {
 	class PipelineSceneLayouter;
 
-	//! \brief Command that auto layouts a pipeline scene.
+	//! \brief Command that moves the pipeline items to the positions of the layouter's latest auto layout.
 	class AutoLayoutItemsCommand : public UIDataChangingCommand
 	{
 
 	public:
 
 		/*!
-		 * \brief Initialize new instance.
+		 * \brief Initialize new instance. Items without auto layout position keep their position.
 		 * \param pipeline The pipeline.
-		 * \param layouter The layouter.
+		 * \param layouter The layouter, which already calculated the auto layout.
 		 */
 		AutoLayoutItemsCommand(IPipeline* pipeline, PipelineSceneLayouter* layouter);
 
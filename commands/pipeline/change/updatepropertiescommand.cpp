@@ -54,6 +54,47 @@ bool UpdatePropertiesCommand::execute()
 	return true;
 }
 
+qint64 UpdatePropertiesCommand::getMemorySize() const
+{
+	//Add the update operations to the backups.
+	qint64 memorySize = UIDataChangingCommand::getMemorySize();
+	foreach(IUpdatePropertyCommand* command, _commands)
+		memorySize += command->getMemorySize();
+
+	return memorySize;
+}
+
+QSet<IProperty*> UpdatePropertiesCommand::getUpdatedProperties() const
+{
+	//Collect the properties of all update operations.
+	QSet<IProperty*> properties;
+	foreach(IUpdatePropertyCommand* command, _commands)
+		properties.insert(command->getProperty());
+
+	return properties;
+}
+
+bool UpdatePropertiesCommand::mergeWith(IUICommand* command)
+{
+	//Only executed updates of the same item can be merged.
+	UpdatePropertiesCommand* updateCommand = dynamic_cast<UpdatePropertiesCommand*>(command);
+	if(!updateCommand || updateCommand->_pipelineItem != _pipelineItem || !_wasExecuted || !updateCommand->_wasExecuted)
+		return false;
+
+	//Both commands must update exactly the same properties.
+	if(_commands.isEmpty() || getUpdatedProperties() != updateCommand->getUpdatedProperties())
+		return false;
+
+	//The newer operations replace the current ones, so that redo restores the latest values.
+	qDeleteAll(_commands);
+	_commands = updateCommand->_commands;
+	updateCommand->_commands.clear();
+
+	//Keep the own backups, which hold the values in front of both commands.
+	mergePropertyBackups(updateCommand);
+	return true;
+}
+
 bool UpdatePropertiesCommand::undo()
 {
 	//Executed.
@@ -29,8 +29,10 @@
 #include "commands/uidatachangingcommand.h"
 #include "data/ipipelineitem.h"
 #include "data/iproperty.h"
+#include "data/common/utils.h"
 
 #include <QDebug>
+#include <QSet>
 
 namespace ysm
 {
@@ -49,10 +51,20 @@ namespace ysm
 			virtual ~IUpdatePropertyCommand() { }
 
 			//! \brief Forward execution.
+			//! Backwards execution is done by restoring the property backups.
 			virtual void redo() = 0;
 
-			//! \brief Backwards execution.
-			virtual void undo() = 0;
+			/*!
+			 * \brief Returns the updated property.
+			 * \return The property.
+			 */
+			virtual IProperty* getProperty() const = 0;
+
+			/*!
+			 * \brief Estimates the memory used by the operation.
+			 * \return The operation's size in bytes.
+			 */
+			virtual qint64 getMemorySize() const = 0;
 
 		protected:
 
@@ -81,17 +93,15 @@ namespace ysm
 			//! \brief Forward execution.
 			void redo() Q_DECL_OVERRIDE
 			{
-				_oldValue = static_cast<S>(_property->getValue());
 				if(!_property->isReadOnly())
 					_property->setValue(_newValue);
 			}
 
-			//! \brief Backwards execution.
-			void undo() Q_DECL_OVERRIDE
-			{
-				if(!_property->isReadOnly())
-					_property->setValue(_oldValue);
-			}
+			//! \brief Returns the updated property.
+			IProperty* getProperty() const Q_DECL_OVERRIDE { return _property; }
+
+			//! \brief Estimates the memory used by the operation.
+			qint64 getMemorySize() const Q_DECL_OVERRIDE { return sizeof(*this) + Utils::getMemorySize(_newValue); }
 
 		private:
 
@@ -101,8 +111,8 @@ namespace ysm
 			//! \brief The property to operate on.
 			T* _property;
 
-			//! \brief Old and new value.
-			S _newValue, _oldValue;
+			//! \brief The new value.
+			S _newValue;
 		};
 
 
@@ -121,15 +131,17 @@ namespace ysm
 			UpdatePropertyFromStringCommand(IPipelineItem* pipelineItem, T* property, QString value) :
 				_pipelineItem(pipelineItem),
 				_property(property),
-				_newValue(value),
-				_oldValue(property->toString())
+				_newValue(value)
 			{ }
 
 			//! \brief Forward execution.
 			void redo() Q_DECL_OVERRIDE { _property->fromString(_newValue); }
 
-			//! \brief Backwards execution.
-			void undo() Q_DECL_OVERRIDE { _property->fromString(_oldValue); }
+			//! \brief Returns the updated property.
+			IProperty* getProperty() const Q_DECL_OVERRIDE { return _property; }
+
+			//! \brief Estimates the memory used by the operation.
+			qint64 getMemorySize() const Q_DECL_OVERRIDE { return sizeof(*this) + Utils::getMemorySize(_newValue); }
 
 		private:
 
@@ -139,8 +151,8 @@ namespace ysm
 			//! \brief The property to operate on.
 			T* _property;
 
-			//! \brief Old and new value.
-			QString _newValue, _oldValue;
+			//! \brief The new value.
+			QString _newValue;
 		};
 
 	public:
@@ -176,6 +188,20 @@ namespace ysm
 		 */
 		bool undo() Q_DECL_OVERRIDE;
 
+		/*!
+		 * \brief Estimates the memory required to keep this command in the undo history.
+		 * \return The command's size in bytes.
+		 */
+		qint64 getMemorySize() const Q_DECL_OVERRIDE;
+
+		/*!
+		 * \brief Merges a consecutive update of exactly the same properties of the same item into this command.
+		 * The newer command's values replace this command's values, while this command's backups are kept.
+		 * \param command The executed command.
+		 * \return True, if the command was merged.
+		 */
+		bool mergeWith(IUICommand* command) Q_DECL_OVERRIDE;
+
 		/*!
 		 * Adds an update operation.
 		 * \param property The property to change.
@@ -220,6 +246,14 @@ namespace ysm
 			}
 		}
 
+	protected:
+
+		/*!
+		 * \brief Returns all properties that are updated by this command.
+		 * \return The updated properties.
+		 */
+		QSet<IProperty*> getUpdatedProperties() const;
+
 	private:
 
 		//! \brief Internal commands, used to execute this command.
@@ -35,8 +35,7 @@ using namespace ysm;
 bool ValidatePipelineCommand::ListVisitor::blockVisited(Block* block)
 {
 	//Item and status property could change.
-	_changedObjects.append(block);
-	_changedObjects.append(block->getProperty<StringProperty>(PropertyID::MessageLog));
+	visitItem(block);
 
 	//Keep iterating.
 	return true;
@@ -45,8 +44,7 @@ bool ValidatePipelineCommand::ListVisitor::blockVisited(Block* block)
 bool ValidatePipelineCommand::ListVisitor::portVisited(Port* port)
 {
 	//Item and status property could change.
-	_changedObjects.append(port);
-	_changedObjects.append(port->getProperty<StringProperty>(PropertyID::MessageLog));
+	visitItem(port);
 
 	//Keep iterating.
 	return true;
@@ -55,8 +53,7 @@ bool ValidatePipelineCommand::ListVisitor::portVisited(Port* port)
 bool ValidatePipelineCommand::ListVisitor::connectionVisited(Connection* connection)
 {
 	//Item and status property could change.
-	_changedObjects.append(connection);
-	_changedObjects.append(connection->getProperty<StringProperty>(PropertyID::MessageLog));
+	visitItem(connection);
 
 	//Keep iterating.
 	return true;
@@ -65,13 +62,39 @@ bool ValidatePipelineCommand::ListVisitor::connectionVisited(Connection* connect
 bool ValidatePipelineCommand::ListVisitor::renderCommandVisited(RenderCommand* command)
 {
 	//Item and status property could change.
-	_changedObjects.append(command);
-	_changedObjects.append(command->getProperty<StringProperty>(PropertyID::MessageLog));
+	visitItem(command);
 
 	//Keep iterating.
 	return true;
 }
 
+void ValidatePipelineCommand::ListVisitor::visitItem(IPipelineItem* item)
+{
+	//Remember the status to detect changes later on.
+	ItemStatus itemStatus;
+	itemStatus._item = item;
+	itemStatus._status = item->getStatus();
+	itemStatus._message = item->getProperty<StringProperty>(PropertyID::MessageLog)->getValue();
+	_visitedItems.append(itemStatus);
+}
+
+QList<IChangeable*> ValidatePipelineCommand::ListVisitor::getChangedObjects() const
+{
+	//Only items with a changed status need to be updated.
+	QList<IChangeable*> changedObjects;
+	foreach(const ItemStatus& itemStatus, _visitedItems)
+	{
+		StringProperty* messageLog = itemStatus._item->getProperty<StringProperty>(PropertyID::MessageLog);
+		if(itemStatus._item->getStatus() != itemStatus._status || messageLog->getValue() != itemStatus._message)
+		{
+			changedObjects.append(itemStatus._item);
+			changedObjects.append(messageLog);
+		}
+	}
+
+	return changedObjects;
+}
+
 ValidatePipelineCommand::ValidatePipelineCommand(IPipeline* pipeline, bool resetStatus) :
 	_reset(resetStatus)
 {
@@ -90,6 +113,9 @@ bool ValidatePipelineCommand::execute()
 	else
 		_pipeline->validatePipeline();
 
+	//Collect the items, whose status was actually changed.
+	_changedObjects = _listVisitor.getChangedObjects();
+
 	//Always succeeds.
 	return true;
 }
@@ -103,7 +129,7 @@ QList<IChangeable*> ValidatePipelineCommand::getChangedObjects(IChangeable::Oper
 	//If change operation is queued, list all changed objects.
 	QList<IChangeable*> changedObjects = UICommand::getChangedObjects(operation);
 	if(operation == IChangeable::Change)
-		changedObjects.append(_listVisitor._changedObjects);
+		changedObjects.append(_changedObjects);
 
 	//Return list of changed objects.
 	return changedObjects;
@@ -72,10 +72,32 @@ namespace ysm
 			 */
 			bool renderCommandVisited(RenderCommand* command) Q_DECL_OVERRIDE;
 
-		public:
+			/*!
+			 * \brief Lists all visited items, whose status changed since they were visited.
+			 * \return The changed items and their status properties.
+			 */
+			QList<IChangeable*> getChangedObjects() const;
+
+		private:
+
+			/*!
+			 * \brief Stores the current status of the item.
+			 * \param item The visited item.
+			 */
+			void visitItem(IPipelineItem* item);
+
+		private:
 
-			//! \brief List of all changed objects that were visited.
-			QList<IChangeable*> _changedObjects;
+			//! \brief Status of a visited item.
+			struct ItemStatus
+			{
+				IPipelineItem* _item;
+				PipelineItemStatus _status;
+				QString _message;
+			};
+
+			//! \brief List of all visited items and their status at the time of the visit.
+			QList<ItemStatus> _visitedItems;
 		};
 
 	public:
@@ -126,6 +148,9 @@ namespace ysm
 		//! \brief A visitor that checks for changed objects.
 		ListVisitor _listVisitor;
 
+		//! \brief The items whose status was changed by the command.
+		QList<IChangeable*> _changedObjects;
+
 		//! \brief True if reset is executed instead of validation.
 		bool _reset;
 	};
@@ -35,5 +35,8 @@ UICommand::UICommand() :
 QList<IChangeable*> UICommand::getChangedObjects(IChangeable::Operation operation) { return QList<IChangeable*>(); }
 bool UICommand::executeImplicit(IUICommandQueue* commandQueue) { return true; }
 
+qint64 UICommand::getMemorySize() const { return sizeof(UICommand); }
+bool UICommand::mergeWith(IUICommand* command) { Q_UNUSED(command); return false; }
+
 int UICommand::getCommandBlock() const { return _commandBlock; }
 void UICommand::setCommandBlock(int commandBlock) { _commandBlock = commandBlock; }
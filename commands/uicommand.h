@@ -66,6 +66,19 @@ namespace ysm
 		 */
 		QList<IChangeable*> getChangedObjects(IChangeable::Operation operation) Q_DECL_OVERRIDE;
 
+		/*!
+		 * \brief Estimates the memory required to keep this command in the undo history.
+		 * \return The command's size in bytes.
+		 */
+		qint64 getMemorySize() const Q_DECL_OVERRIDE;
+
+		/*!
+		 * \brief Tries to merge a command into this command. By default, commands are never merged.
+		 * \param command The executed command.
+		 * \return True, if the command was merged.
+		 */
+		bool mergeWith(IUICommand* command) Q_DECL_OVERRIDE;
+
 	protected:
 
 		//! \brief Initialize new instance.
@@ -26,8 +26,13 @@
 #include "uicommandqueue.h"
 #include "iuicommand.h"
 
+#include "data/common/memorytracker.h"
+
 #include <iostream>
 
+//Commands executed within this interval (in ms) are merged, if possible.
+#define MERGE_INTERVAL 1000
+
 using namespace ysm;
 
 
@@ -37,11 +42,27 @@ UICommandQueue::UICommandQueue(Document* parent) :
 	_undoCounter(0),
 	_currentBlock(0),
 	_nextBlock(0),
-	_currentBlockDepth(0)
-{ }
+	_currentBlockDepth(0),
+	_deferredSignalDepth(0),
+	_historySize(0)
+{
+	//The memory tracker keeps the history budget in the application settings.
+	_historyBudget = MemoryTracker::getInstance()->getBudget(MemoryCategory::UndoHistory);
+
+	//Apply budget changes, e.g. made in the memory view.
+	MemoryTracker::getInstance()->addEvictionHandler(this, MemoryCategory::UndoHistory, [this](qint64)
+	{
+		enforceHistoryBudget();
+		updateMemoryUsage();
+	});
+}
 
 UICommandQueue::~UICommandQueue()
 {
+	//Stop accounting the history.
+	MemoryTracker::getInstance()->removeEvictionHandlers(this);
+	MemoryTracker::getInstance()->removeUsage(this);
+
 	//Clear the stacks.
 	qDeleteAll(_redoStack);
 	qDeleteAll(_undoStack);
@@ -52,20 +73,18 @@ void UICommandQueue::emitPreExecute(IUICommand* command, bool isUndo)
 	//Check for objects that will be removed.
 	QList<IChangeable*> removedList = command->getChangedObjects(isUndo ? IChangeable::Add : IChangeable::Remove);
 	if(!removedList.isEmpty())
+	{
+		//Objects must be removed immediately, so deliver the deferred changes first to keep the order.
+		emitDeferredSignals();
 		emit willRemoveData(_document, removedList);
+	}
 }
 
 void UICommandQueue::emitPostExecute(IUICommand* command, bool isUndo)
 {
-	//Check for objects that were changed.
-	QList<IChangeable*> changedList = command->getChangedObjects(IChangeable::Change);
-	if(!changedList.isEmpty())
-		emit didChangeData(_document, changedList);
-
-	//Check for objects that were added.
-	QList<IChangeable*> addedList = command->getChangedObjects(isUndo ? IChangeable::Remove : IChangeable::Add);
-	if(!addedList.isEmpty())
-		emit didAddData(_document, addedList);
+	//Collect the changed and added objects, they are emitted after the outermost command.
+	_deferredChanges.append(command->getChangedObjects(IChangeable::Change));
+	_deferredAdditions.append(command->getChangedObjects(isUndo ? IChangeable::Remove : IChangeable::Add));
 
 	//Check if rendering was changed.
 	if(command->didChangeRendering())
@@ -75,13 +94,41 @@ void UICommandQueue::emitPostExecute(IUICommand* command, bool isUndo)
 	emit stateChanged();
 }
 
+void UICommandQueue::beginDeferredSignals() { _deferredSignalDepth++; }
+void UICommandQueue::endDeferredSignals()
+{
+	//Emit the collected changes after the outermost command.
+	_deferredSignalDepth--;
+	if(!_deferredSignalDepth)
+		emitDeferredSignals();
+}
+
+void UICommandQueue::emitDeferredSignals()
+{
+	//Take the lists, handlers might execute further commands.
+	QList<IChangeable*> addedList = _deferredAdditions;
+	QList<IChangeable*> changedList = _deferredChanges;
+	_deferredAdditions.clear();
+	_deferredChanges.clear();
+
+	//Emit the added objects first, as later commands might have changed them.
+	if(!addedList.isEmpty())
+		emit didAddData(_document, addedList);
+
+	if(!changedList.isEmpty())
+		emit didChangeData(_document, changedList);
+}
+
 void UICommandQueue::execute(IUICommand* command)
 {
 	//Ensure the command exists.
 	if(!command) return;
 
 	//Clear the redo stack.
-	_redoStack.clear();
+	clearRedoStack();
+
+	//Remember the latest command, to check wether the command can be merged.
+	IUICommand* previousCommand = (_undoStack.empty() || _currentBlockDepth) ? NULL : _undoStack.top();
 
 	//Begin command block to group implicit commands.
 	beginCommandBlock();
@@ -93,12 +140,20 @@ void UICommandQueue::execute(IUICommand* command)
 	//Emit pre execution signals.
 	emitPreExecute(command, false);
 
-	//Execute, then add to undo list if successful.
+	//Execute, then merge or add to undo list if successful.
 	bool success = command->execute();
+	bool merged = false;
 	if(success && command->isUndoable())
 	{
-		_undoStack.push(command);
-		_undoCounter++;
+		merged = mergeCommand(command, previousCommand);
+		if(!merged)
+		{
+			_undoStack.push(command);
+			_historySize += command->getMemorySize();
+			_undoCounter++;
+		}
+
+		_mergeTimer.restart();
 	}
 
 	//Emit post execution signals.
@@ -108,12 +163,110 @@ void UICommandQueue::execute(IUICommand* command)
 	endCommandBlock();
 
 	//Delete the command, if not used anymore.
-	if(!success || !command->isUndoable())
+	if(!success || !command->isUndoable() || merged)
 		delete command;
+
+	//Drop old commands after the outermost command was executed.
+	if(!_currentBlockDepth)
+		enforceHistoryBudget();
+
+	updateMemoryUsage();
+}
+
+bool UICommandQueue::mergeCommand(IUICommand* command, IUICommand* previousCommand)
+{
+	//Only merge top level commands, that did not push any implicit commands.
+	if(!previousCommand || _undoStack.empty() || _undoStack.top() != previousCommand)
+		return false;
+
+	//Do not merge the saved state or commands that were not executed in quick succession.
+	if(isSaved() || !_mergeTimer.isValid() || _mergeTimer.elapsed() > MERGE_INTERVAL)
+		return false;
+
+	//The previous command must not be part of a larger command block.
+	int previousBlock = previousCommand->getCommandBlock();
+	if(_undoStack.size() > 1 && previousBlock && _undoStack[_undoStack.size() - 2]->getCommandBlock() == previousBlock)
+		return false;
+
+	//Merge and update the history size.
+	qint64 previousSize = previousCommand->getMemorySize();
+	if(!previousCommand->mergeWith(command))
+		return false;
+
+	_historySize += previousCommand->getMemorySize() - previousSize;
+	return true;
+}
+
+void UICommandQueue::clearRedoStack()
+{
+	//Delete all commands, they can not be executed anymore.
+	foreach(IUICommand* command, _redoStack)
+		_historySize -= command->getMemorySize();
+
+	qDeleteAll(_redoStack);
+	_redoStack.clear();
+}
+
+void UICommandQueue::enforceHistoryBudget()
+{
+	//The budget might have been changed by another queue or the memory view.
+	MemoryTracker* memoryTracker = MemoryTracker::getInstance();
+	_historyBudget = memoryTracker->getBudget(MemoryCategory::UndoHistory);
+
+	//Check wether a budget is set.
+	if(_historyBudget <= 0)
+		return;
+
+	//The budget is shared by the histories of all documents, so compare it with the usage of the whole category.
+	updateMemoryUsage();
+	qint64 excess = memoryTracker->getUsage(MemoryCategory::UndoHistory) - _historyBudget;
+
+	//Drop the oldest command blocks, until the budget is met.
+	bool historyChanged = false;
+	while(excess > 0 && !_undoStack.empty())
+	{
+		//Find the size of the oldest command block (commands without block are never grouped).
+		int oldestBlock = _undoStack.first()->getCommandBlock();
+		int blockSize = 1;
+		while(oldestBlock && blockSize < _undoStack.size() && _undoStack[blockSize]->getCommandBlock() == oldestBlock)
+			blockSize++;
+
+		//Always keep the latest command block.
+		if(blockSize == _undoStack.size())
+			break;
+
+		//Delete the block's commands.
+		for(int i = 0; i < blockSize; i++)
+		{
+			IUICommand* command = _undoStack.takeFirst();
+			_historySize -= command->getMemorySize();
+			excess -= command->getMemorySize();
+			delete command;
+		}
+
+		historyChanged = true;
+	}
+
+	//Notify about the dropped history.
+	if(historyChanged)
+	{
+		updateMemoryUsage();
+		emit stateChanged();
+	}
 }
 
 
 bool UICommandQueue::undo()
+{
+	//Undo the whole command block, then emit its changes at once.
+	beginDeferredSignals();
+	bool success = undoBlock();
+	endDeferredSignals();
+
+	return success;
+}
+
+bool UICommandQueue::undoBlock()
 {
 	//Ensure commands are available.
 	if(_undoStack.empty()) return false;
@@ -121,6 +274,9 @@ bool UICommandQueue::undo()
 	//Access the latest command from stack.
 	IUICommand* undoCommand = _undoStack.pop();
 
+	//The next command must not be merged into an older one.
+	_mergeTimer.invalidate();
+
 	//Emit pre execution signals (reverse execution).
 	emitPreExecute(undoCommand, true);
 
@@ -145,13 +301,23 @@ bool UICommandQueue::undo()
 
 	//Iteratively execute a possible block of commands.
 	if(currentBlock && nextBlock == currentBlock)
-		return undo();
+		return undoBlock();
 
 	//Successfully executed.
 	return true;
 }
 
 bool UICommandQueue::redo()
+{
+	//Redo the whole command block, then emit its changes at once.
+	beginDeferredSignals();
+	bool success = redoBlock();
+	endDeferredSignals();
+
+	return success;
+}
+
+bool UICommandQueue::redoBlock()
 {
 	//Ensure commands are available.
 	if(_redoStack.empty()) return false;
@@ -159,6 +325,9 @@ bool UICommandQueue::redo()
 	//Access the latest command from stack.
 	IUICommand* redoCommand = _redoStack.pop();
 
+	//The next command must not be merged into the redone one.
+	_mergeTimer.invalidate();
+
 	//Emit pre execution signals.
 	emitPreExecute(redoCommand, false);
 
@@ -180,7 +349,7 @@ bool UICommandQueue::redo()
 
 	//Iteratively execute a possible block of commands.
 	if(currentBlock && nextBlock == currentBlock)
-		return redo();
+		return redoBlock();
 
 	//Successfully executed.
 	return success;
@@ -194,6 +363,9 @@ void UICommandQueue::clear()
 
 	_redoStack.clear();
 	_undoStack.clear();
+	_historySize = 0;
+	_mergeTimer.invalidate();
+	updateMemoryUsage();
 
 	//Mark as saved.
 	save();
@@ -210,6 +382,24 @@ void UICommandQueue::save()
 
 bool UICommandQueue::isSaved() const { return _undoCounter == 0; }
 
+qint64 UICommandQueue::getHistorySize() const { return _historySize; }
+qint64 UICommandQueue::getHistoryBudget() const { return _historyBudget; }
+
+void UICommandQueue::setHistoryBudget(qint64 historyBudget)
+{
+	//Store the budget and apply it.
+	_historyBudget = historyBudget;
+	MemoryTracker::getInstance()->setBudget(MemoryCategory::UndoHistory, _historyBudget);
+	enforceHistoryBudget();
+	updateMemoryUsage();
+}
+
+void UICommandQueue::updateMemoryUsage()
+{
+	//Report the history as a whole, it's not owned by a block.
+	MemoryTracker::getInstance()->setUsage(this, MemoryCategory::UndoHistory, _historySize, _document->getName());
+}
+
 void UICommandQueue::endCommandBlock()
 {
 	//Decrease the command depth.
@@ -218,6 +408,9 @@ void UICommandQueue::endCommandBlock()
 	//Clear the current command block, if neccessary.
 	if(!_currentBlockDepth)
 		_currentBlock = 0;
+
+	//Emit the changes of the whole block.
+	endDeferredSignals();
 }
 
 void UICommandQueue::beginCommandBlock()
@@ -228,4 +421,7 @@ void UICommandQueue::beginCommandBlock()
 
 	//Increase the command depth.
 	_currentBlockDepth++;
+
+	//Defer the changes until the block is finished.
+	beginDeferredSignals();
 }
@@ -32,6 +32,7 @@
 
 #include <QObject>
 #include <QStack>
+#include <QElapsedTimer>
 
 namespace ysm
 {
@@ -82,6 +83,25 @@ namespace ysm
 		/// @brief Ends the command block.
 		void endCommandBlock() Q_DECL_OVERRIDE;
 
+		/**
+		 * @brief Returns the estimated memory used by the undo and redo history.
+		 * @return The history's size in bytes.
+		 */
+		qint64 getHistorySize() const Q_DECL_OVERRIDE;
+
+		/**
+		 * @brief Returns the memory budget of the undo histories of all documents.
+		 * @return The budget in bytes, zero if unlimited.
+		 */
+		qint64 getHistoryBudget() const Q_DECL_OVERRIDE;
+
+		/**
+		 * @brief Sets the memory budget of the undo histories of all documents. The oldest commands are dropped, if it's exceeded.
+		 * The budget is stored to the application settings.
+		 * @param historyBudget The budget in bytes, zero if unlimited.
+		 */
+		void setHistoryBudget(qint64 historyBudget) Q_DECL_OVERRIDE;
+
 	public slots:
 
 		/**
@@ -112,6 +132,47 @@ namespace ysm
 		 */
 		void emitPostExecute(IUICommand* command, bool isUndo);
 
+		/// @brief Defers the data change signals, until the outermost command or command block is finished.
+		void beginDeferredSignals();
+
+		/// @brief Ends deferring the data change signals and emits the collected changes, if outermost.
+		void endDeferredSignals();
+
+		/// @brief Emits the collected added and changed objects as one signal each.
+		void emitDeferredSignals();
+
+		/**
+		 * @brief Undo the latest executed command and any further commands of its command block.
+		 * @return False, if undo stack was empty or the command failed.
+		 */
+		bool undoBlock();
+
+		/**
+		 * @brief Redo the latest undone command and any further commands of its command block.
+		 * @return False, if redo stack was empty or the command failed.
+		 */
+		bool redoBlock();
+
+		/**
+		 * @brief Tries to merge the executed command into the latest command on the undo stack.
+		 * Commands are only merged, if both were executed separately and in quick succession, and the latest command
+		 * does not represent the saved state.
+		 * @param command The executed command.
+		 * @param previousCommand The latest command on the undo stack, before the command was executed.
+		 * @return True, if the command was merged and can be deleted.
+		 */
+		bool mergeCommand(IUICommand* command, IUICommand* previousCommand);
+
+		/// @brief Deletes all commands on the redo stack.
+		void clearRedoStack();
+
+		/// @brief Deletes the oldest command blocks from the undo stack, until the histories of all documents fit into
+		/// the budget. The latest command block is always kept.
+		void enforceHistoryBudget();
+
+		/// @brief Reports the history's size to the memory tracker.
+		void updateMemoryUsage();
+
 	private:
 
 		/// @brief The queue's parent.
@@ -134,6 +195,24 @@ namespace ysm
 
 		/// @brief The current block's depth.
 		int _currentBlockDepth;
+
+		/// @brief Depth of nested commands and blocks, that defer the data change signals.
+		int _deferredSignalDepth;
+
+		/// @brief Objects added while the signals are deferred.
+		QList<IChangeable*> _deferredAdditions;
+
+		/// @brief Objects changed while the signals are deferred.
+		QList<IChangeable*> _deferredChanges;
+
+		/// @brief The estimated size of all commands on the undo and redo stack.
+		qint64 _historySize;
+
+		/// @brief The history's memory budget, zero if unlimited.
+		qint64 _historyBudget;
+
+		/// @brief Measures the time since the latest command was pushed, used to merge consecutive commands.
+		QElapsedTimer _mergeTimer;
 	};
 }
 
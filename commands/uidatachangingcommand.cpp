@@ -32,6 +32,8 @@
 #include "data/irendercommand.h"
 #include "data/properties/property.h"
 
+#include <QSet>
+
 using namespace ysm;
 
 
@@ -63,6 +65,14 @@ void UIDataChangingCommand::PropertyBackup::restoreProperty() const
 	}
 }
 
+IProperty* UIDataChangingCommand::PropertyBackup::getTarget() const { return _target; }
+
+qint64 UIDataChangingCommand::PropertyBackup::getMemorySize() const
+{
+	//Include the cloned value's payload, if available.
+	return sizeof(PropertyBackup) + (_backup ? _backup->getValueSize() : 0);
+}
+
 UIDataChangingCommand::UIDataChangingCommand() :
 	_backupsDone(false)
 { }
@@ -72,6 +82,20 @@ UIDataChangingCommand::~UIDataChangingCommand() { qDeleteAll(_propertyBackups);
 bool UIDataChangingCommand::isUndoable() const { return true; }
 bool UIDataChangingCommand::didChangeRendering() const { return true; }
 
+qint64 UIDataChangingCommand::getMemorySize() const
+{
+	//Sum up the property backups.
+	qint64 memorySize = UICommand::getMemorySize();
+	foreach(PropertyBackup* propertyBackup, _propertyBackups)
+		memorySize += propertyBackup->getMemorySize();
+
+	//Add the changed object references.
+	foreach(const QList<IChangeable*>& changedObjects, _changedObjects)
+		memorySize += changedObjects.size() * sizeof(IChangeable*);
+
+	return memorySize;
+}
+
 QList<IChangeable*> UIDataChangingCommand::getChangedObjects(IChangeable::Operation operation)
 { return _changedObjects[operation]; }
 
@@ -101,20 +125,9 @@ void UIDataChangingCommand::backupProperties(IPipelineItem* pipelineItem)
 
 void UIDataChangingCommand::backupProperties(IPipeline* pipeline)
 {
-	//Find block and connection changes.
-	foreach(IBlock* block, pipeline->getBlocks())
-	{
-		//Backup block changes.
-		backupProperties(block);
-
-		//Backup connection changes.
-		foreach(IConnection* connection, block->getOutConnections())
-			backupProperties(connection);
-	}
-
-	//Find command changes.
-	foreach(IRenderCommand* command, pipeline->getRenderCommands())
-		backupProperties(command);
+	//The pipeline journals all changed properties of its blocks, connections and commands.
+	foreach(IProperty* property, pipeline->getChangedProperties())
+		backupProperty(property);
 }
 
 void UIDataChangingCommand::clearProperties(IPipelineItem *pipelineItem)
@@ -127,24 +140,31 @@ void UIDataChangingCommand::clearProperties(IPipelineItem *pipelineItem)
 
 void UIDataChangingCommand::clearProperties(IPipeline* pipeline)
 {
-	//Clear block and connection changes.
-	foreach(IBlock* block, pipeline->getBlocks())
-	{
-		//Backup block changes.
-		clearProperties(block);
-
-		//Clear connection changes.
-		foreach(IConnection* connection, block->getOutConnections())
-			clearProperties(connection);
-	}
-
-	//Clear command changes.
-	foreach(IRenderCommand* command, pipeline->getRenderCommands())
-		clearProperties(command);
+	//Only the journaled properties need to be cleared.
+	foreach(IProperty* property, pipeline->getChangedProperties())
+		property->clearChanged();
 }
 
 void UIDataChangingCommand::propertyBackupsDone() { _backupsDone = true; }
 
+void UIDataChangingCommand::mergePropertyBackups(UIDataChangingCommand* command)
+{
+	//Collect the properties that are already backed up.
+	QSet<IProperty*> backedUpProperties;
+	foreach(PropertyBackup* propertyBackup, _propertyBackups)
+		backedUpProperties.insert(propertyBackup->getTarget());
+
+	//Take over all backups of further properties, the remaining ones are deleted with the other command.
+	for(int i = command->_propertyBackups.size() - 1; i >= 0; i--)
+		if(!backedUpProperties.contains(command->_propertyBackups[i]->getTarget()))
+			_propertyBackups.append(command->_propertyBackups.takeAt(i));
+
+	//Take over the changed objects.
+	foreach(IChangeable* changedObject, command->_changedObjects[IChangeable::Change])
+		if(!_changedObjects[IChangeable::Change].contains(changedObject))
+			_changedObjects[IChangeable::Change].append(changedObject);
+}
+
 void UIDataChangingCommand::restoreProperties()
 {
 	//Iterate over all properties and restore their value.
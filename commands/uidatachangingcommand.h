@@ -59,6 +59,18 @@ namespace ysm
 			//! \brief Restore the property's value.
 			void restoreProperty() const;
 
+			/*!
+			 * \brief Returns the backed up property.
+			 * \return The target property.
+			 */
+			IProperty* getTarget() const;
+
+			/*!
+			 * \brief Estimates the memory used by the backup.
+			 * \return The backup's size in bytes.
+			 */
+			qint64 getMemorySize() const;
+
 		private:
 
 			//! \brief The target property to backup.
@@ -92,6 +104,12 @@ namespace ysm
 		 */
 		bool didChangeRendering() const Q_DECL_OVERRIDE;
 
+		/*!
+		 * \brief Estimates the memory required to keep this command in the undo history.
+		 * \return The command's size in bytes.
+		 */
+		qint64 getMemorySize() const Q_DECL_OVERRIDE;
+
 	protected:
 
 		/// Initialize new instance.
@@ -153,6 +171,14 @@ namespace ysm
 		//! \brief Restores all backed up properties.
 		void restoreProperties();
 
+		/*!
+		 * \brief Takes over the property backups of a command, that was executed directly after this command.
+		 * Backups of properties that are already backed up by this command are dropped, because this command's backup
+		 * holds the older value. The other command's changed objects are added to this command's changed objects.
+		 * \param command The newer command.
+		 */
+		void mergePropertyBackups(UIDataChangingCommand* command);
+
 	private:
 
 		//! \brief List of changed objects.
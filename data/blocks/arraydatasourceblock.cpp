@@ -113,11 +113,12 @@ namespace ysm
 
 		ConnectionPoints conPoints;
 
-		conPoints << qMakePair(BlockType::Buffer, PortType::Data_In);
+		conPoints << qMakePair(BlockType::Buffer, PortType::Data_In)
+				  << qMakePair(BlockType::ParallelPrimitive, PortType::Data_In);
 
 		if (!checkConnectionPoints(dest, conPoints))
 		{
-			denialReason = "Array output must be connected to a Buffer block";
+			denialReason = "Array output must be connected to a Buffer or Parallel Primitive block";
 			return false;
 		}
 
@@ -73,7 +73,38 @@ namespace ysm
 		if (type == BlockType::Undefined)
 			throw std::invalid_argument{"type may not be BlockType::Undefined"};
 
-		return objects([type](const Block* block) { return (block->getType() == type); });
+		if (!_areTypeBucketsValid)
+		{
+			_typeBuckets.clear();
+
+			for (Block* block : _objects)
+				_typeBuckets[static_cast<int>(block->getType())].append(block);
+
+			_areTypeBucketsValid = true;
+		}
+
+		return _typeBuckets.value(static_cast<int>(type));
+	}
+
+	void BlockList::append(const Block* block)
+	{
+		bool isNew = !contains(block);
+
+		PipelineItemList::append(block);
+
+		if (isNew && _areTypeBucketsValid)
+			_typeBuckets[static_cast<int>(block->getType())].append(const_cast<Block*>(block));
+	}
+
+	void BlockList::insert(const int i, const Block* block)
+	{
+		bool isNew = !contains(block);
+
+		PipelineItemList::insert(i, block);
+
+		// Keeping the bucket in list order requires a rebuild
+		if (isNew)
+			_areTypeBucketsValid = false;
 	}
 
 	void BlockList::deserialize(const QDomElement* xmlElement, SerializationContext* ctx)
@@ -116,6 +147,9 @@ namespace ysm
 		{
 			Block* block = _objects[i];
 			emit block->blockRemoved();
+
+			if (_areTypeBucketsValid)
+				_typeBuckets[static_cast<int>(block->getType())].removeOne(block);
 		}
 
 		PipelineItemList::remove(i, deleteObj);
@@ -132,4 +166,15 @@ namespace ysm
 
 		return PipelineItemList::remove(block, deleteObj);
 	}
+
+	void BlockList::clear()
+	{
+		// Deleted blocks must not be found while clearing
+		_areTypeBucketsValid = false;
+
+		PipelineItemList::clear();
+
+		_typeBuckets.clear();
+		_areTypeBucketsValid = true;
+	}
 }
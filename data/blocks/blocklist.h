@@ -66,11 +66,19 @@ namespace ysm
 		QVector<Block*> findBlocks(const BlockType type) const;
 
 	public:
+		void append(const Block* block) override;
+		void insert(const int i, const Block* block) override;
 		void remove(const int i, bool deleteObj = true) override;
 		bool remove(const Block* block, bool deleteObj = true) override;
+		void clear() override;
 
 	public: // ISerializable
 		void deserialize(const QDomElement* xmlElement, SerializationContext* ctx) override;
+
+	private:
+		// Blocks grouped by their type (in list order); rebuilt lazily after insertions in the middle of the list
+		mutable QHash<int, QVector<Block*>> _typeBuckets;
+		mutable bool _areTypeBucketsValid{true};
 	};
 
 	// Template member functions
@@ -59,6 +59,10 @@ namespace ysm
 		ImageLoader,
 		TextureLoader,
 		Array,
+		Readback,
+		MeshOptimizer,
+		ParallelPrimitive,
+		MeshLOD,
 
 		// Fixed function blocks
 		Rasterization = 2000,
@@ -69,6 +69,11 @@ namespace ysm
 		return _usageAccess;
 	}
 
+	UIntProperty* BufferBlock::getInstanceDivisor()
+	{
+		return _instanceDivisor;
+	}
+
 	Port* BufferBlock::getDataInPort()
 	{
 		return _dataInPort;
@@ -109,6 +114,9 @@ namespace ysm
 
 		_usageAccess = _properties->newProperty<EnumProperty>(PropertyID::Buffer_UsageAccess, "Usage Access");
 		*_usageAccess = Usage_Draw;
+
+		_instanceDivisor = _properties->newProperty<UIntProperty>(PropertyID::Buffer_InstanceDivisor, "Instance Divisor");
+		*_instanceDivisor = 0;
 	}
 
 	void BufferBlock::createPorts()
@@ -151,10 +159,11 @@ namespace ysm
 			conPoints << qMakePair(BlockType::Shader_Geometry, PortType::Shader_UBO);
 			conPoints << qMakePair(BlockType::Shader_Geometry, PortType::Shader_AtomicCounterIn);
 			conPoints << qMakePair(BlockType::Texture, PortType::Data_In);
+			conPoints << qMakePair(BlockType::Readback, PortType::GenericIn);
 
 			if (!checkConnectionPoints(dest, conPoints))
 			{
-				denialReason = "Buffer output must be connected to a Vertex Array Object, Vertex Puller, Texture or any Shader block";
+				denialReason = "Buffer output must be connected to a Vertex Array Object, Vertex Puller, Texture, Readback or any Shader block";
 				return false;
 			}
 
@@ -283,6 +292,11 @@ namespace ysm
 		return data;
 	}
 
+	int BufferBlock::getCacheBlockId() const
+	{
+		return static_cast<int>(getID());
+	}
+
 	const BufferBlock::BufferData* BufferBlock::getBufferData()
 	{
 		const BufferData* data = getCachedData<BufferData>();
@@ -105,6 +105,11 @@ namespace ysm
 		 */
 		EnumProperty* getUsageAccess();
 
+		/**
+		 * @brief Gets the instance divisor used for vertex attributes sourced from this buffer (0 = per vertex)
+		 */
+		UIntProperty* getInstanceDivisor();
+
 		// Port access
 		/**
 		 * @brief Gets the data in-port
@@ -123,6 +128,7 @@ namespace ysm
 		// ICacheable
 		CacheObject::Key getCacheKey(bool retrieveForeignKey) override;
 		CacheObject::CacheObjectData* createCacheData() override;
+		int getCacheBlockId() const override;
 
 	protected:
 		void createProperties() override;
@@ -143,6 +149,8 @@ namespace ysm
 		{
 			QByteArray data;
 			unsigned int elementCount{0};
+
+			qint64 getMemorySize() const override { return data.capacity(); }
 		} _emptyData;
 
 		/**
@@ -181,6 +189,8 @@ namespace ysm
 		EnumProperty* _usageFrequency{nullptr};
 		EnumProperty* _usageAccess{nullptr};
 
+		UIntProperty* _instanceDivisor{nullptr};
+
 		// Ports
 		Port* _dataInPort{nullptr};
 		Port* _dataOutPort{nullptr};
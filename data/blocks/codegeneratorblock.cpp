@@ -94,5 +94,6 @@ namespace ysm
 		*_api = API_OpenGL;
 
 		_outFile = _properties->newProperty<FilenameProperty>(PropertyID::CodeGenerator_FileName, "Filename");
+		_outFile->setOutput(true);
 	}
 }
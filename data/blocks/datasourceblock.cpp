@@ -25,6 +25,7 @@
 
 #include "datasourceblock.h"
 #include "data/types/datasource.h"
+#include "data/types/geometrydatasource.h"
 #include "data/types/typeutils.h"
 #include "connection.h"
 
@@ -119,11 +120,28 @@ namespace ysm
 
 			conPoints << qMakePair(BlockType::Mixer, PortType::Data_In)
 					  << qMakePair(BlockType::Buffer, PortType::Data_In)
-					  << qMakePair(BlockType::Texture, PortType::Data_In);
+					  << qMakePair(BlockType::Texture, PortType::Data_In)
+					  << qMakePair(BlockType::MeshOptimizer, PortType::Data_In)
+					  << qMakePair(BlockType::ParallelPrimitive, PortType::Data_In)
+					  << qMakePair(BlockType::MeshLOD, PortType::Data_In);
 
 			if (!checkConnectionPoints(dest, conPoints))
 			{
-				denialReason = "Data Source output must be connected to a Mixer, Buffer or Texture block";
+				denialReason = "Data Source output must be connected to a Mixer, Buffer, Texture, Mesh Optimizer, Parallel Primitive or Mesh LOD block";
+				return false;
+			}
+
+			// Only geometry can be optimized
+			if (dest->getBlock()->getType() == BlockType::MeshOptimizer && !dynamic_cast<GeometryDataSource*>(_dataSource))
+			{
+				denialReason = "Only geometry data sources can be connected to a Mesh Optimizer block";
+				return false;
+			}
+
+			// Only geometry can be simplified
+			if (dest->getBlock()->getType() == BlockType::MeshLOD && !dynamic_cast<GeometryDataSource*>(_dataSource))
+			{
+				denialReason = "Only geometry data sources can be connected to a Mesh LOD block";
 				return false;
 			}
 
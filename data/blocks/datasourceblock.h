@@ -280,6 +280,9 @@ namespace ysm
 				break;
 
 			default:
+				// Packed formats are created from 4D vectors
+				if (TypeConversion::isPackedType(typeConv.targetType))
+					output = TypeConversion::convertVectorToPackedByteArray(TypeConversion::convertToVec4(*data), dataIndex, typeConv);
 				break;
 			}
 		}
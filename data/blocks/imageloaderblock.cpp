@@ -137,7 +137,7 @@ namespace ysm
 
 		setStatus(PipelineItemStatus::Healthy);
 
-		// Set the file name for our image data source and let it load the image immediately
-		_imageDataSource.setImageFile(imgFile, *_imageGrid, true);
+		// Set the file name for our image data source and let it load the image immediately, unless a project is being loaded
+		_imageDataSource.setImageFile(imgFile, *_imageGrid, !getPipeline()->getManager()->isDeferringDataLoads());
 	}
 }
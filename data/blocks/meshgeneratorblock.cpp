@@ -45,6 +45,12 @@ namespace ysm
 		enumNames[Geom_Circle] = "Circle";
 		enumNames[Geom_Cuboid] = "Cuboid";
         enumNames[Geom_Sphere] = "Sphere";
+		enumNames[Geom_Grid] = "Grid";
+		enumNames[Geom_UVSphere] = "UV Sphere";
+		enumNames[Geom_IcoSphere] = "Icosphere";
+		enumNames[Geom_Torus] = "Torus";
+		enumNames[Geom_Cylinder] = "Cylinder";
+		enumNames[Geom_Heightfield] = "Heightfield";
 
 		return enumNames;
 	}
@@ -99,6 +105,26 @@ namespace ysm
 		return _sections;
 	}
 
+	UIntProperty* MeshGeneratorBlock::getRings()
+	{
+		return _rings;
+	}
+
+	UIntProperty* MeshGeneratorBlock::getSubdivisions()
+	{
+		return _subdivisions;
+	}
+
+	FloatProperty* MeshGeneratorBlock::getTubeRadius()
+	{
+		return _tubeRadius;
+	}
+
+	FilenameProperty* MeshGeneratorBlock::getHeightMap()
+	{
+		return _heightMap;
+	}
+
 	void MeshGeneratorBlock::createProperties()
 	{
 		GeometryDataSourceBlock::createProperties();
@@ -136,6 +162,17 @@ namespace ysm
 		_sections = _properties->newProperty<UIntProperty>(PropertyID::Mesh_Sections, "Circle Sections");
 		*_sections = 32;
 
+		_rings = _properties->newProperty<UIntProperty>(PropertyID::Mesh_Rings, "Rings");
+		*_rings = 16;
+
+		_subdivisions = _properties->newProperty<UIntProperty>(PropertyID::Mesh_Subdivisions, "Icosphere Subdivisions");
+		*_subdivisions = 3;
+
+		_tubeRadius = _properties->newProperty<FloatProperty>(PropertyID::Mesh_TubeRadius, "Torus Tube Radius");
+		*_tubeRadius = 0.25f;
+
+		_heightMap = _properties->newProperty<FilenameProperty>(PropertyID::Mesh_HeightMap, "Height Map");
+
 		_meshVertexCount = _properties->newProperty<UIntProperty>(PropertyID::Mesh_VertexCount, "Vertex Count", true);
 		_meshVertexCount->setSerializable(false);
 		_meshVertexCount->delegateValue(
@@ -179,6 +216,30 @@ namespace ysm
             case Geom_Sphere:
                 _meshDataSource.createSphere(*_radius, *_sections, *_center);
                 break;
+
+			case Geom_Grid:
+				_meshDataSource.createGrid(*_width, *_height, *_sections, *_rings, *_center);
+				break;
+
+			case Geom_UVSphere:
+				_meshDataSource.createUVSphere(*_radius, *_sections, *_rings, *_center);
+				break;
+
+			case Geom_IcoSphere:
+				_meshDataSource.createIcoSphere(*_radius, *_subdivisions, *_center);
+				break;
+
+			case Geom_Torus:
+				_meshDataSource.createTorus(*_radius, *_tubeRadius, *_sections, *_rings, *_center);
+				break;
+
+			case Geom_Cylinder:
+				_meshDataSource.createCylinder(*_radius, *_height, *_sections, *_rings, *_center);
+				break;
+
+			case Geom_Heightfield:
+				_meshDataSource.createHeightfield(*_heightMap, *_width, *_height, *_depth, *_center);
+				break;
 			}
 		}
 		catch (std::exception& excp)
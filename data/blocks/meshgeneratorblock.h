@@ -28,6 +28,7 @@
 
 #include "geometrydatasourceblock.h"
 #include "data/types/meshgeneratordatasource.h"
+#include "data/properties/filenameproperty.h"
 
 namespace ysm
 {
@@ -50,6 +51,12 @@ namespace ysm
 			Geom_Circle,
 			Geom_Cuboid,
             Geom_Sphere,
+			Geom_Grid,
+			Geom_UVSphere,
+			Geom_IcoSphere,
+			Geom_Torus,
+			Geom_Cylinder,
+			Geom_Heightfield,
 		};
 
 		/**
@@ -116,6 +123,26 @@ namespace ysm
 		 */
 		UIntProperty* getSections();
 
+		/**
+		 * @brief Gets the ring count of grids, spheres, tori and cylinders
+		 */
+		UIntProperty* getRings();
+
+		/**
+		 * @brief Gets the icosphere subdivision count
+		 */
+		UIntProperty* getSubdivisions();
+
+		/**
+		 * @brief Gets the torus tube radius
+		 */
+		FloatProperty* getTubeRadius();
+
+		/**
+		 * @brief Gets the heightfield image file
+		 */
+		FilenameProperty* getHeightMap();
+
 	protected:
 		void createProperties() override;
 
@@ -136,6 +163,10 @@ namespace ysm
 		FloatProperty* _depth{nullptr};
 		FloatProperty* _radius{nullptr};
 		UIntProperty* _sections{nullptr};
+		UIntProperty* _rings{nullptr};
+		UIntProperty* _subdivisions{nullptr};
+		FloatProperty* _tubeRadius{nullptr};
+		FilenameProperty* _heightMap{nullptr};
 		BoolProperty* _interpolate{nullptr};
 
 		UIntProperty* _meshVertexCount{nullptr};
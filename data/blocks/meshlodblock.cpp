@@ -0,0 +1,113 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "meshlodblock.h"
+#include "data/properties/propertylist.h"
+
+#include <QStringList>
+
+namespace ysm
+{
+	MeshLODBlock::MeshLODBlock(Pipeline* parent) :
+		MeshProcessorBlock(&_lodDataSource, parent, block_type, "Mesh LOD"),
+		_lodDataSource{parent, this}
+	{
+
+	}
+
+	UIntProperty* MeshLODBlock::getLevelCount()
+	{
+		return _levelCount;
+	}
+
+	FloatProperty* MeshLODBlock::getLevelRatio()
+	{
+		return _levelRatio;
+	}
+
+	BoolProperty* MeshLODBlock::getPreserveBorders()
+	{
+		return _preserveBorders;
+	}
+
+	const MeshLODDataSource::LevelChain& MeshLODBlock::getLevelChain()
+	{
+		return _lodDataSource.getLevelChain();
+	}
+
+	void MeshLODBlock::createProperties()
+	{
+		MeshProcessorBlock::createProperties();
+
+		_levelCount = _properties->newProperty<UIntProperty>(PropertyID::LOD_LevelCount, "Level Count");
+		*_levelCount = 4;
+
+		_levelRatio = _properties->newProperty<FloatProperty>(PropertyID::LOD_LevelRatio, "Level Ratio");
+		*_levelRatio = 0.5f;
+
+		_preserveBorders = _properties->newProperty<BoolProperty>(PropertyID::LOD_PreserveBorders, "Preserve Borders");
+		*_preserveBorders = true;
+
+		// The levels are generated in the background, so they have to be checked every time
+		_triangleCounts = _properties->newProperty<StringProperty>(PropertyID::LOD_TriangleCounts, "Triangle Counts", true);
+		_triangleCounts->setSerializable(false);
+		_triangleCounts->delegateValue(
+					[this]()->const QString& {
+						static QString __ret;
+						QStringList counts;
+						for (const MeshLODDataSource::Level& level : _lodDataSource.getPendingLevelChain().levels)
+							counts << QString::number(level.indexCount / 3);
+						__ret = counts.join(", ");
+						return __ret;
+					},
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+
+		_errors = _properties->newProperty<StringProperty>(PropertyID::LOD_Errors, "Errors", true);
+		_errors->setSerializable(false);
+		_errors->delegateValue(
+					[this]()->const QString& {
+						static QString __ret;
+						QStringList errors;
+						for (const MeshLODDataSource::Level& level : _lodDataSource.getPendingLevelChain().levels)
+							errors << QString::number(level.error, 'g', 3);
+						__ret = errors.join(", ");
+						return __ret;
+					},
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+	}
+
+	void MeshLODBlock::updateOptions()
+	{
+		MeshLODDataSource::Options options;
+		options.levelCount = *_levelCount;
+		options.levelRatio = *_levelRatio;
+		options.preserveBorders = *_preserveBorders;
+
+		_lodDataSource.setOptions(options);
+	}
+}
@@ -0,0 +1,93 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef MESHLODBLOCK_H
+#define MESHLODBLOCK_H
+
+#include "meshprocessorblock.h"
+#include "data/types/meshloddatasource.h"
+
+namespace ysm
+{
+	/**
+	 * @brief Block simplifying the mesh of a geometry data source into a chain of detail levels
+	 * The index list output holds all levels one after another; draw commands using it as their index buffer only draw
+	 * a single level, selected by the projected size of the mesh if enabled.
+	 */
+	class MeshLODBlock : public MeshProcessorBlock
+	{
+		Q_OBJECT
+
+	public:
+		static const BlockType block_type{BlockType::MeshLOD};
+
+	public:
+		// Construction
+		explicit MeshLODBlock(Pipeline* parent);
+
+	public:
+		// Property access
+		/**
+		 * @brief Gets the number of detail levels, including the full mesh
+		 */
+		UIntProperty* getLevelCount();
+
+		/**
+		 * @brief Gets the ratio of the triangle counts of two successive levels
+		 */
+		FloatProperty* getLevelRatio();
+
+		/**
+		 * @brief Gets whether open borders of the mesh are kept in place
+		 */
+		BoolProperty* getPreserveBorders();
+
+		// Data access
+		/**
+		 * @brief Gets the level table of the generated chain, waiting for the generation to finish
+		 */
+		const MeshLODDataSource::LevelChain& getLevelChain();
+
+	protected:
+		void createProperties() override;
+
+		void updateOptions() override;
+
+	private:
+		// The data source
+		MeshLODDataSource _lodDataSource;
+
+		// Properties
+		UIntProperty* _levelCount{nullptr};
+		FloatProperty* _levelRatio{nullptr};
+		BoolProperty* _preserveBorders{nullptr};
+
+		StringProperty* _triangleCounts{nullptr};
+		StringProperty* _errors{nullptr};
+	};
+}
+
+#endif
@@ -0,0 +1,123 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "meshoptimizerblock.h"
+#include "data/properties/propertylist.h"
+
+namespace ysm
+{
+	MeshOptimizerBlock::MeshOptimizerBlock(Pipeline* parent) :
+		MeshProcessorBlock(&_optimizerDataSource, parent, block_type, "Mesh Optimizer"),
+		_optimizerDataSource{parent, this}
+	{
+
+	}
+
+	BoolProperty* MeshOptimizerBlock::getOptimizeVertexCache()
+	{
+		return _optimizeVertexCache;
+	}
+
+	BoolProperty* MeshOptimizerBlock::getOptimizeVertexFetch()
+	{
+		return _optimizeVertexFetch;
+	}
+
+	BoolProperty* MeshOptimizerBlock::getOptimizeOverdraw()
+	{
+		return _optimizeOverdraw;
+	}
+
+	FloatProperty* MeshOptimizerBlock::getOverdrawThreshold()
+	{
+		return _overdrawThreshold;
+	}
+
+	UIntProperty* MeshOptimizerBlock::getCacheSize()
+	{
+		return _cacheSize;
+	}
+
+	void MeshOptimizerBlock::createProperties()
+	{
+		MeshProcessorBlock::createProperties();
+
+		_optimizeVertexCache = _properties->newProperty<BoolProperty>(PropertyID::Optimizer_VertexCache, "Optimize Vertex Cache");
+		*_optimizeVertexCache = true;
+
+		_optimizeVertexFetch = _properties->newProperty<BoolProperty>(PropertyID::Optimizer_VertexFetch, "Optimize Vertex Fetch");
+		*_optimizeVertexFetch = true;
+
+		_optimizeOverdraw = _properties->newProperty<BoolProperty>(PropertyID::Optimizer_Overdraw, "Optimize Overdraw");
+		*_optimizeOverdraw = false;
+
+		_overdrawThreshold = _properties->newProperty<FloatProperty>(PropertyID::Optimizer_OverdrawThreshold, "Overdraw Threshold");
+		*_overdrawThreshold = 1.05f;
+
+		_cacheSize = _properties->newProperty<UIntProperty>(PropertyID::Optimizer_CacheSize, "Cache Size");
+		*_cacheSize = 16;
+
+		// Statistics are computed in the background, so they have to be checked every time
+		_acmrBefore = _properties->newProperty<FloatProperty>(PropertyID::Optimizer_ACMRBefore, "ACMR Before", true);
+		_acmrBefore->setSerializable(false);
+		_acmrBefore->delegateValue(
+					[this]()->const float& { static float __ret = 0.0f; __ret = _optimizerDataSource.getStatistics().acmrBefore; return __ret; },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+
+		_acmrAfter = _properties->newProperty<FloatProperty>(PropertyID::Optimizer_ACMRAfter, "ACMR After", true);
+		_acmrAfter->setSerializable(false);
+		_acmrAfter->delegateValue(
+					[this]()->const float& { static float __ret = 0.0f; __ret = _optimizerDataSource.getStatistics().acmrAfter; return __ret; },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+
+		_atvrBefore = _properties->newProperty<FloatProperty>(PropertyID::Optimizer_ATVRBefore, "ATVR Before", true);
+		_atvrBefore->setSerializable(false);
+		_atvrBefore->delegateValue(
+					[this]()->const float& { static float __ret = 0.0f; __ret = _optimizerDataSource.getStatistics().atvrBefore; return __ret; },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+
+		_atvrAfter = _properties->newProperty<FloatProperty>(PropertyID::Optimizer_ATVRAfter, "ATVR After", true);
+		_atvrAfter->setSerializable(false);
+		_atvrAfter->delegateValue(
+					[this]()->const float& { static float __ret = 0.0f; __ret = _optimizerDataSource.getStatistics().atvrAfter; return __ret; },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+	}
+
+	void MeshOptimizerBlock::updateOptions()
+	{
+		MeshOptimizerDataSource::Options options;
+		options.vertexCache = *_optimizeVertexCache;
+		options.vertexFetch = *_optimizeVertexFetch;
+		options.overdraw = *_optimizeOverdraw;
+		options.overdrawThreshold = *_overdrawThreshold;
+		options.cacheSize = *_cacheSize;
+
+		_optimizerDataSource.setOptions(options);
+	}
+}
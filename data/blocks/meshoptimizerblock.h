@@ -0,0 +1,98 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef MESHOPTIMIZERBLOCK_H
+#define MESHOPTIMIZERBLOCK_H
+
+#include "meshprocessorblock.h"
+#include "data/types/meshoptimizerdatasource.h"
+
+namespace ysm
+{
+	/**
+	 * @brief Block optimizing the mesh of a geometry data source for the vertex cache, overdraw and vertex fetching
+	 */
+	class MeshOptimizerBlock : public MeshProcessorBlock
+	{
+		Q_OBJECT
+
+	public:
+		static const BlockType block_type{BlockType::MeshOptimizer};
+
+	public:
+		// Construction
+		explicit MeshOptimizerBlock(Pipeline* parent);
+
+	public:
+		// Property access
+		/**
+		 * @brief Gets whether the triangles are reordered for the vertex cache
+		 */
+		BoolProperty* getOptimizeVertexCache();
+
+		/**
+		 * @brief Gets whether the vertices are reordered for fetch locality
+		 */
+		BoolProperty* getOptimizeVertexFetch();
+
+		/**
+		 * @brief Gets whether triangle clusters are reordered to reduce overdraw
+		 */
+		BoolProperty* getOptimizeOverdraw();
+
+		/**
+		 * @brief Gets the ACMR degradation allowed when splitting the mesh into clusters for overdraw optimization
+		 */
+		FloatProperty* getOverdrawThreshold();
+
+		/**
+		 * @brief Gets the size of the simulated vertex cache
+		 */
+		UIntProperty* getCacheSize();
+
+	protected:
+		void createProperties() override;
+
+		void updateOptions() override;
+
+	private:
+		// The data source
+		MeshOptimizerDataSource _optimizerDataSource;
+
+		// Properties
+		BoolProperty* _optimizeVertexCache{nullptr};
+		BoolProperty* _optimizeVertexFetch{nullptr};
+		BoolProperty* _optimizeOverdraw{nullptr};
+		FloatProperty* _overdrawThreshold{nullptr};
+		UIntProperty* _cacheSize{nullptr};
+
+		FloatProperty* _acmrBefore{nullptr};
+		FloatProperty* _acmrAfter{nullptr};
+		FloatProperty* _atvrBefore{nullptr};
+		FloatProperty* _atvrAfter{nullptr};
+	};
+}
+
+#endif
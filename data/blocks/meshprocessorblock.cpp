@@ -0,0 +1,98 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "meshprocessorblock.h"
+#include "port.h"
+#include "portlist.h"
+#include "connection.h"
+
+namespace ysm
+{
+	MeshProcessorBlock::MeshProcessorBlock(MeshProcessorDataSource* dataSource, Pipeline* parent, BlockType type, const QString& name) :
+		GeometryDataSourceBlock(dataSource, parent, type, name),
+		_processorDataSource{dataSource}
+	{
+		connect(this, SIGNAL(blockConnected(Connection*)), this, SLOT(onConnectionEstablished(Connection*)));
+		connect(this, SIGNAL(blockDisconnected(Connection*)), this, SLOT(onConnectionRemoved(Connection*)));
+	}
+
+	Port* MeshProcessorBlock::getMeshInPort()
+	{
+		return _meshInPort;
+	}
+
+	DataSourceBlock* MeshProcessorBlock::getMeshSource() const
+	{
+		QVector<IConnection*> connections = _meshInPort->getInConnections();
+		if (connections.size() != 1)
+			return nullptr;
+
+		return dynamic_cast<DataSourceBlock*>(connections[0]->getSource());
+	}
+
+	void MeshProcessorBlock::createPorts()
+	{
+		GeometryDataSourceBlock::createPorts();
+
+		_meshInPort = _ports->newPort(PortType::Data_In, PortDirection::In, "Mesh In");
+	}
+
+	void MeshProcessorBlock::reloadDataSource()
+	{
+		setStatus(PipelineItemStatus::Healthy);
+
+		DataSourceBlock* source = getMeshSource();
+
+		_processorDataSource->setSource(source ? dynamic_cast<GeometryDataSource*>(source->getDataSource()) : nullptr);
+		updateOptions();
+
+		// Start processing right away, so that the result is ready once the data is needed
+		if (getPipeline()->getManager()->isDeferringDataLoads())
+			return;
+
+		try
+		{
+			_processorDataSource->startProcessing();
+		}
+		catch (std::exception& excp)
+		{
+			QString msg = QString("The source mesh could not be retrieved: %1").arg(excp.what());
+			setStatus(PipelineItemStatus::Sick, msg);
+		}
+	}
+
+	void MeshProcessorBlock::onConnectionEstablished(Connection* con)
+	{
+		if (con->getDestPort() == _meshInPort)
+			reloadDataSource();
+	}
+
+	void MeshProcessorBlock::onConnectionRemoved(Connection* con)
+	{
+		// The connection might still be listed, so drop the source directly
+		if (con->getDestPort() == _meshInPort)
+			_processorDataSource->setSource(nullptr);
+	}
+}
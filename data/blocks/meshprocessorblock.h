@@ -0,0 +1,81 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef MESHPROCESSORBLOCK_H
+#define MESHPROCESSORBLOCK_H
+
+#include "geometrydatasourceblock.h"
+#include "data/types/meshprocessordatasource.h"
+
+namespace ysm
+{
+	/**
+	 * @brief Base for blocks processing the mesh of a geometry data source in the background
+	 * Any output of the geometry data source can be connected to the mesh in-port; the block always processes the whole mesh.
+	 */
+	class MeshProcessorBlock : public GeometryDataSourceBlock
+	{
+		Q_OBJECT
+
+	public:
+		// Construction
+		explicit MeshProcessorBlock(MeshProcessorDataSource* dataSource, Pipeline* parent, BlockType type, const QString& name);
+
+	public:
+		// Port access
+		/**
+		 * @brief Gets the mesh in-port
+		 */
+		Port* getMeshInPort();
+
+		/**
+		 * @brief Gets the block providing the mesh, or null if not connected
+		 */
+		DataSourceBlock* getMeshSource() const;
+
+	protected:
+		void createPorts() override;
+
+		void reloadDataSource() override;
+
+		/**
+		 * @brief Passes the current property values on to the data source
+		 */
+		virtual void updateOptions() = 0;
+
+	protected slots:
+		void onConnectionEstablished(Connection* con);
+		void onConnectionRemoved(Connection* con);
+
+	private:
+		// The data source
+		MeshProcessorDataSource* _processorDataSource{nullptr};
+
+		// Ports
+		Port* _meshInPort{nullptr};
+	};
+}
+
+#endif
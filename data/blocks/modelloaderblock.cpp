@@ -94,8 +94,8 @@ namespace ysm
 
 		setStatus(PipelineItemStatus::Healthy);
 
-		// Set the file name for our model data source and let it load the model immediately
-		_modelDataSource.setModelFile(modelFile, *_combineMeshes, true);
+		// Set the file name for our model data source and let it load the model immediately, unless a project is being loaded
+		_modelDataSource.setModelFile(modelFile, *_combineMeshes, !getPipeline()->getManager()->isDeferringDataLoads());
 	}
 
 	void ModelLoaderBlock::applyPropertyChanges(IProperty* prop)
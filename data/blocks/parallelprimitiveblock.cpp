@@ -0,0 +1,288 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "parallelprimitiveblock.h"
+#include "datasourceblock.h"
+#include "connection.h"
+#include "data/properties/propertylist.h"
+#include "data/blocks/portlist.h"
+#include "data/blocks/port.h"
+
+namespace ysm
+{
+	QMap<int, QString> ParallelPrimitiveBlock::getPrimitiveNames()
+	{
+		QMap<int, QString> enumNames;
+
+		enumNames[static_cast<int>(ParallelPrimitives::Primitive::RadixSort)] = "Radix Sort";
+		enumNames[static_cast<int>(ParallelPrimitives::Primitive::InclusiveScan)] = "Inclusive Scan";
+		enumNames[static_cast<int>(ParallelPrimitives::Primitive::ExclusiveScan)] = "Exclusive Scan";
+		enumNames[static_cast<int>(ParallelPrimitives::Primitive::Compaction)] = "Compaction";
+		enumNames[static_cast<int>(ParallelPrimitives::Primitive::SegmentedReduction)] = "Segmented Reduction";
+
+		return enumNames;
+	}
+
+	QMap<int, QString> ParallelPrimitiveBlock::getOperatorNames()
+	{
+		QMap<int, QString> enumNames;
+
+		enumNames[static_cast<int>(ParallelPrimitives::Operator::Sum)] = "Sum";
+		enumNames[static_cast<int>(ParallelPrimitives::Operator::Minimum)] = "Minimum";
+		enumNames[static_cast<int>(ParallelPrimitives::Operator::Maximum)] = "Maximum";
+
+		return enumNames;
+	}
+
+	QMap<int, QString> ParallelPrimitiveBlock::getSortOutputNames()
+	{
+		QMap<int, QString> enumNames;
+
+		enumNames[static_cast<int>(ParallelPrimitives::SortOutput::Keys)] = "Sorted Keys";
+		enumNames[static_cast<int>(ParallelPrimitives::SortOutput::Values)] = "Original Indices";
+
+		return enumNames;
+	}
+
+	ParallelPrimitiveBlock::ParallelPrimitiveBlock(Pipeline* parent) : UniformBaseBlock(parent, block_type, "Parallel Primitive")
+	{
+
+	}
+
+	Port* ParallelPrimitiveBlock::getDataInPort()
+	{
+		return _inPort;
+	}
+
+	Port* ParallelPrimitiveBlock::getGenericOutPort()
+	{
+		return _outPort;
+	}
+
+	EnumProperty* ParallelPrimitiveBlock::getPrimitive()
+	{
+		return _primitive;
+	}
+
+	EnumProperty* ParallelPrimitiveBlock::getDataType()
+	{
+		return _dataType;
+	}
+
+	EnumProperty* ParallelPrimitiveBlock::getOperator()
+	{
+		return _operator;
+	}
+
+	EnumProperty* ParallelPrimitiveBlock::getSortOutput()
+	{
+		return _sortOutput;
+	}
+
+	UIntProperty* ParallelPrimitiveBlock::getSegmentSize()
+	{
+		return _segmentSize;
+	}
+
+	UIntProperty* ParallelPrimitiveBlock::getGrainSize()
+	{
+		return _grainSize;
+	}
+
+	const ParallelPrimitives::Statistics& ParallelPrimitiveBlock::getStatistics() const
+	{
+		return _statistics;
+	}
+
+	void ParallelPrimitiveBlock::createPorts()
+	{
+		UniformBaseBlock::createPorts();
+
+		_inPort = _ports->newPort(PortType::Data_In, PortDirection::In, "In");
+		_outPort = _ports->newPort(PortType::GenericOut, PortDirection::Out, "Out");
+	}
+
+	void ParallelPrimitiveBlock::createProperties()
+	{
+		UniformBaseBlock::createProperties();
+
+		_primitive = _properties->newProperty<EnumProperty>(PropertyID::Primitive_Primitive, "Primitive");
+		*_primitive = static_cast<int>(ParallelPrimitives::Primitive::RadixSort);
+
+		_dataType = _properties->newProperty<EnumProperty>(PropertyID::Primitive_DataType, "Data Type");
+		*_dataType = static_cast<int>(DataType::Float);
+
+		_operator = _properties->newProperty<EnumProperty>(PropertyID::Primitive_Operator, "Operator");
+		*_operator = static_cast<int>(ParallelPrimitives::Operator::Sum);
+
+		_sortOutput = _properties->newProperty<EnumProperty>(PropertyID::Primitive_SortOutput, "Sort Output");
+		*_sortOutput = static_cast<int>(ParallelPrimitives::SortOutput::Keys);
+
+		_segmentSize = _properties->newProperty<UIntProperty>(PropertyID::Primitive_SegmentSize, "Segment Size");
+		*_segmentSize = 0;
+
+		_grainSize = _properties->newProperty<UIntProperty>(PropertyID::Primitive_GrainSize, "Grain Size");
+		*_grainSize = 0;
+
+		// Statistics are updated whenever the output is computed, so they have to be checked every time
+		_elementCount = _properties->newProperty<UIntProperty>(PropertyID::Primitive_ElementCount, "Element Count", true);
+		_elementCount->setSerializable(false);
+		_elementCount->delegateValue(
+					[this]()->const unsigned int& { return _statistics.elementCount; },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+
+		_chunkCount = _properties->newProperty<UIntProperty>(PropertyID::Primitive_ChunkCount, "Chunk Count", true);
+		_chunkCount->setSerializable(false);
+		_chunkCount->delegateValue(
+					[this]()->const unsigned int& { return _statistics.chunkCount; },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+
+		_throughput = _properties->newProperty<FloatProperty>(PropertyID::Primitive_Throughput, "Elements per Second", true);
+		_throughput->setSerializable(false);
+		_throughput->delegateValue(
+					[this]()->const float& { static float __ret = 0.0f; __ret = _statistics.throughput; return __ret; },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+
+		_referenceThroughput = _properties->newProperty<FloatProperty>(PropertyID::Primitive_ReferenceThroughput, "Reference Elements per Second", true);
+		_referenceThroughput->setSerializable(false);
+		_referenceThroughput->delegateValue(
+					[this]()->const float& { static float __ret = 0.0f; __ret = _statistics.referenceThroughput; return __ret; },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+
+		_referenceMeasured = _properties->newProperty<BoolProperty>(PropertyID::Primitive_ReferenceMeasured, "Reference Measured", true);
+		_referenceMeasured->setSerializable(false);
+		_referenceMeasured->delegateValue(
+					[this]()->const bool& { return _statistics.referenceMeasured; },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+
+		_verified = _properties->newProperty<BoolProperty>(PropertyID::Primitive_Verified, "Verified", true);
+		_verified->setSerializable(false);
+		_verified->delegateValue(
+					[this]()->const bool& { return _statistics.verified; },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+	}
+
+	bool ParallelPrimitiveBlock::canAcceptConnection(IPort* src, IPort* dest, QString& denialReason)
+	{
+		if (!Block::canAcceptConnection(src, dest, denialReason))
+			return false;
+
+		if (src == _outPort)
+		{
+			ConnectionPoints conPoints;
+
+			conPoints << qMakePair(BlockType::Buffer, PortType::Data_In)
+					  << qMakePair(BlockType::Mixer, PortType::Data_In)
+					  << qMakePair(BlockType::ParallelPrimitive, PortType::Data_In);
+
+			if (!checkConnectionPoints(dest, conPoints))
+			{
+				denialReason = "Parallel Primitive output must be connected to a Buffer, Mixer or Parallel Primitive block";
+				return false;
+			}
+
+			return true;
+		}
+
+		// Nope, we don't like this connection
+		return false;
+	}
+
+	void ParallelPrimitiveBlock::prepareConnection(Connection* con)
+	{
+		// The output is never connected to a shader, so no uniform properties are needed
+		Q_UNUSED(con);
+	}
+
+	ParallelPrimitives::Options ParallelPrimitiveBlock::getOptions() const
+	{
+		ParallelPrimitives::Options options;
+
+		options.primitive = static_cast<ParallelPrimitives::Primitive>(_primitive->getValue());
+		options.dataType = static_cast<DataType>(_dataType->getValue());
+		options.reduceOperator = static_cast<ParallelPrimitives::Operator>(_operator->getValue());
+		options.sortOutput = static_cast<ParallelPrimitives::SortOutput>(_sortOutput->getValue());
+		options.segmentSize = *_segmentSize;
+		options.grainSize = *_grainSize;
+
+		return options;
+	}
+
+	QByteArray ParallelPrimitiveBlock::retrieveInputData() const
+	{
+		QVector<IConnection*> connections = _inPort->getInConnections();
+		if (connections.size() != 1)
+			return QByteArray();
+
+		IBlock* source = connections[0]->getSource();
+		IPort* sourcePort = connections[0]->getSourcePort();
+
+		if (UniformBaseBlock* uniform = dynamic_cast<UniformBaseBlock*>(source))
+			return uniform->retrieveUniformData(sourcePort);
+
+		if (DataSourceBlock* dataSrc = dynamic_cast<DataSourceBlock*>(source))
+		{
+			TypeConversion::ConversionOptions typeConv;
+
+			// Do not convert the data
+			typeConv.targetType = DataType::NoType;
+
+			return dataSrc->retrieveOutput(dataSrc->findOutputByPort(sourcePort), typeConv, -1);
+		}
+
+		return QByteArray();
+	}
+
+	unsigned int ParallelPrimitiveBlock::getOutputSize(IPort* port) const
+	{
+		return retrieveUniformData(port).size();
+	}
+
+	QByteArray ParallelPrimitiveBlock::retrieveUniformData(IPort* port) const
+	{
+		Q_UNUSED(port);
+
+		QByteArray input = retrieveInputData();
+		ParallelPrimitives::Options options = getOptions();
+
+		// Only execute the primitive if the input or options changed
+		if (!_hasOutput || !(options == _cachedOptions) || input != _cachedInput)
+		{
+			_cachedOutput = ParallelPrimitives::execute(input, options, &_statistics);
+			_cachedInput = input;
+			_cachedOptions = options;
+			_hasOutput = true;
+		}
+
+		return _cachedOutput;
+	}
+}
@@ -0,0 +1,168 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef PARALLELPRIMITIVEBLOCK_H
+#define PARALLELPRIMITIVEBLOCK_H
+
+#include "uniforms/uniformbaseblock.h"
+#include "data/types/parallelprimitives.h"
+
+namespace ysm
+{
+	/**
+	 * @brief Block applying a data-parallel primitive (sort, scan, compaction or reduction) to the data fed into a buffer
+	 * The input is read from an Array, Readback, Data Source or another primitive block and interpreted as tightly
+	 * packed elements of the selected data type. The result is computed once per input and cached.
+	 */
+	class ParallelPrimitiveBlock : public UniformBaseBlock
+	{
+		Q_OBJECT
+
+	public:
+		static const BlockType block_type{BlockType::ParallelPrimitive};
+
+		/**
+		 * @brief Returns the string representations of the primitives
+		 */
+		static QMap<int, QString> getPrimitiveNames();
+
+		/**
+		 * @brief Returns the string representations of the operators
+		 */
+		static QMap<int, QString> getOperatorNames();
+
+		/**
+		 * @brief Returns the string representations of the sort outputs
+		 */
+		static QMap<int, QString> getSortOutputNames();
+
+	public:
+		// Construction
+		explicit ParallelPrimitiveBlock(Pipeline* parent);
+
+	public:
+		// Port access
+		/**
+		 * @brief Gets the data in-port
+		 */
+		Port* getDataInPort();
+
+		/**
+		 * @brief Gets the single out-port
+		 */
+		Port* getGenericOutPort();
+
+		// Property access
+		/**
+		 * @brief Gets the primitive to execute
+		 */
+		EnumProperty* getPrimitive();
+
+		/**
+		 * @brief Gets the data type of the input elements
+		 */
+		EnumProperty* getDataType();
+
+		/**
+		 * @brief Gets the operator used for scans and reductions
+		 */
+		EnumProperty* getOperator();
+
+		/**
+		 * @brief Gets whether sorting outputs the sorted keys or their original indices
+		 */
+		EnumProperty* getSortOutput();
+
+		/**
+		 * @brief Gets the number of elements per reduced segment (0 reduces all elements)
+		 */
+		UIntProperty* getSegmentSize();
+
+		/**
+		 * @brief Gets the number of elements processed per parallel chunk (0 selects it automatically)
+		 */
+		UIntProperty* getGrainSize();
+
+		/**
+		 * @brief Gets the statistics of the latest execution
+		 */
+		const ParallelPrimitives::Statistics& getStatistics() const;
+
+	public:
+		// Raw data functions
+		unsigned int getOutputSize(IPort* port) const override;
+		QByteArray retrieveUniformData(IPort* port) const override;
+
+	public:
+		bool canAcceptConnection(IPort* src, IPort* dest, QString& denialReason) override;
+
+	protected:
+		void createPorts() override;
+		void createProperties() override;
+
+		/**
+		 * @brief Retrieves the raw data of the connected block, or an empty array if not connected
+		 */
+		QByteArray retrieveInputData() const;
+
+		/**
+		 * @brief Gets the options set by the properties
+		 */
+		ParallelPrimitives::Options getOptions() const;
+
+	protected slots:
+		void prepareConnection(Connection* con) override;
+
+	private:
+		// Ports
+		Port* _inPort{nullptr};
+		Port* _outPort{nullptr};
+
+		// Properties
+		EnumProperty* _primitive{nullptr};
+		EnumProperty* _dataType{nullptr};
+		EnumProperty* _operator{nullptr};
+		EnumProperty* _sortOutput{nullptr};
+		UIntProperty* _segmentSize{nullptr};
+		UIntProperty* _grainSize{nullptr};
+
+		UIntProperty* _elementCount{nullptr};
+		UIntProperty* _chunkCount{nullptr};
+		FloatProperty* _throughput{nullptr};
+		FloatProperty* _referenceThroughput{nullptr};
+		BoolProperty* _referenceMeasured{nullptr};
+		BoolProperty* _verified{nullptr};
+
+		// The result of the latest execution
+		mutable QByteArray _cachedInput;
+		mutable ParallelPrimitives::Options _cachedOptions;
+		mutable QByteArray _cachedOutput;
+		mutable ParallelPrimitives::Statistics _statistics;
+		mutable bool _hasOutput{false};
+	};
+}
+
+#endif
@@ -69,14 +69,16 @@ namespace ysm
 			if (blockType != BlockType::Undefined)
 			{
 				// Only add connections which target to a block of type blockType
-				cons.append(_connections->objects([blockType](Connection* con)
+				auto matchesType = [blockType](Connection* con)
 				{
 					if (con->getDest() && con->getDest()->getType() == blockType)
 						return true;
 
 					return false;
-				}
-				));
+				};
+
+				for (Connection* con : _connections->filtered(matchesType))
+					cons.append(con);
 			}
 			else
 				cons.append(_connections->objects());
@@ -0,0 +1,218 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "readbackdatasourceblock.h"
+#include "data/properties/propertylist.h"
+#include "data/blocks/portlist.h"
+#include "data/blocks/port.h"
+#include "data/blocks/connection.h"
+#include "data/types/gltypes.h"
+
+#include <cstring>
+
+namespace ysm
+{
+
+	ReadbackDataSourceBlock::ReadbackDataSourceBlock(Pipeline* parent) : UniformBaseBlock(parent, block_type, "Readback Data Source")
+	{
+
+	}
+
+	Port* ReadbackDataSourceBlock::getGenericInPort()
+	{
+		return _inPort;
+	}
+
+	Port* ReadbackDataSourceBlock::getGenericOutPort()
+	{
+		return _outPort;
+	}
+
+	IBlock* ReadbackDataSourceBlock::getReadbackSource() const
+	{
+		QVector<IConnection*> connections = _inPort->getInConnections();
+		if (connections.size() != 1)
+			return nullptr;
+
+		return connections[0]->getSource();
+	}
+
+	EnumProperty* ReadbackDataSourceBlock::getDataType()
+	{
+		return _dataType;
+	}
+
+	UIntProperty* ReadbackDataSourceBlock::getFrame()
+	{
+		return _frame;
+	}
+
+	UIntProperty* ReadbackDataSourceBlock::getByteCount()
+	{
+		return _byteCount;
+	}
+
+	FloatDataProperty* ReadbackDataSourceBlock::getData()
+	{
+		return _data;
+	}
+
+	void ReadbackDataSourceBlock::setReadbackResult(const QByteArray& data, unsigned int frame)
+	{
+		// Results are volatile, so they bypass the command queue and are never serialized
+		_result = data;
+		_resultFrame = frame;
+		_resultVersion++;
+	}
+
+	void ReadbackDataSourceBlock::createPorts()
+	{
+		UniformBaseBlock::createPorts();
+
+		_inPort = _ports->newPort(PortType::GenericIn, PortDirection::In, "In");
+		_outPort = _ports->newPort(PortType::GenericOut, PortDirection::Out, "Out");
+	}
+
+	void ReadbackDataSourceBlock::createProperties()
+	{
+		UniformBaseBlock::createProperties();
+
+		_dataType = _properties->newProperty<EnumProperty>(PropertyID::Readback_DataType, "Data Type");
+		*_dataType = static_cast<int>(DataType::Float);
+
+		_frame = _properties->newProperty<UIntProperty>(PropertyID::Readback_Frame, "Frame", true);
+		_frame->setSerializable(false);
+		_frame->delegateValue(
+					[this]()->const unsigned int& { return _resultFrame; },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+
+		_byteCount = _properties->newProperty<UIntProperty>(PropertyID::Readback_Byte, "Bytes", true);
+		_byteCount->setSerializable(false);
+		_byteCount->delegateValue(
+					[this]()->const unsigned int& { static unsigned int __ret; __ret = _result.size(); return __ret; },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+
+		_data = _properties->newProperty<FloatDataProperty>(PropertyID::Readback_Data, "Data", true);
+		_data->setSerializable(false);
+		_data->delegateValue(
+					[this]()->const FloatData& { return getConvertedResult(); },
+					nullptr,
+					[this](bool clear)->bool { return !clear; });
+	}
+
+	const FloatData& ReadbackDataSourceBlock::getConvertedResult() const
+	{
+		// Only convert again, if a new result arrived or the interpretation changed
+		if (_convertedVersion == _resultVersion && _convertedType == _dataType->getValue())
+			return _convertedResult;
+
+		int count = _result.size() / 4;
+		_convertedResult.resize(count);
+
+		const char* raw = _result.constData();
+		for (int i = 0; i < count; i++)
+		{
+			switch (static_cast<DataType>(_dataType->getValue()))
+			{
+			case DataType::Int:
+			{
+				int v;
+				std::memcpy(&v, raw + i * 4, 4);
+				_convertedResult[i] = static_cast<float>(v);
+				break;
+			}
+			case DataType::UInt:
+			{
+				unsigned int v;
+				std::memcpy(&v, raw + i * 4, 4);
+				_convertedResult[i] = static_cast<float>(v);
+				break;
+			}
+			default:
+				std::memcpy(&_convertedResult[i], raw + i * 4, 4);
+				break;
+			}
+		}
+
+		_convertedVersion = _resultVersion;
+		_convertedType = _dataType->getValue();
+		return _convertedResult;
+	}
+
+	bool ReadbackDataSourceBlock::canAcceptConnection(IPort* src, IPort* dest, QString& denialReason)
+	{
+		if (!Block::canAcceptConnection(src, dest, denialReason))
+			return false;
+
+		if (src == _outPort)
+		{
+			ConnectionPoints conPoints;
+
+			conPoints << qMakePair(BlockType::Buffer, PortType::Data_In)
+					  << qMakePair(BlockType::ParallelPrimitive, PortType::Data_In);
+
+			if (!checkConnectionPoints(dest, conPoints))
+			{
+				denialReason = "Readback output must be connected to a Buffer or Parallel Primitive block";
+				return false;
+			}
+
+			return true;
+		}
+
+		// Nope, we don't like this connection
+		return false;
+	}
+
+	void ReadbackDataSourceBlock::prepareConnection(Connection* con)
+	{
+		// Simply ignore UniformBaseBlock::prepareConnection()
+		Q_UNUSED(con);
+	}
+
+	unsigned int ReadbackDataSourceBlock::getOutputSize(IPort* port) const
+	{
+		Q_UNUSED(port);
+
+		return _result.size();
+	}
+
+	QByteArray ReadbackDataSourceBlock::retrieveUniformData(IPort* port) const
+	{
+		Q_UNUSED(port);
+
+		return _result;
+	}
+
+	CacheObject::Key ReadbackDataSourceBlock::getCacheKey(bool retrieveForeignKey)
+	{
+		Q_UNUSED(retrieveForeignKey);
+
+		// The version identifies the result, so there is no need to encode the whole data
+		return QString("ReadbackBlock/%1/%2").arg(getID()).arg(_resultVersion);
+	}
+}
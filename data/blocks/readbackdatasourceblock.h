@@ -0,0 +1,145 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef READBACKDATASOURCEBLOCK_H
+#define READBACKDATASOURCEBLOCK_H
+
+#include "uniforms/uniformbaseblock.h"
+
+namespace ysm
+{
+	/**
+	 * @brief Data source block receiving the contents of a GPU resource read back by the render view.
+	 * The source is a Buffer (e.g. filled by transform feedback or a shader storage block) or a Texture (e.g. a
+	 * framebuffer attachment) connected to the in-port. Results arrive asynchronously, usually one or more frames after
+	 * they have been rendered, and are exposed like an Array data source to inspect them and feed them into Buffers.
+	 */
+	class ReadbackDataSourceBlock : public UniformBaseBlock
+	{
+		Q_OBJECT
+
+	public:
+		static const BlockType block_type{BlockType::Readback};
+
+	public:
+		// Construction
+		explicit ReadbackDataSourceBlock(Pipeline* parent);
+
+	public:
+		// Port access
+		/**
+		 * @brief Gets the single in-port, connected to the block being read back
+		 */
+		Port* getGenericInPort();
+
+		/**
+		 * @brief Gets the single out-port
+		 */
+		Port* getGenericOutPort();
+
+		/**
+		 * @brief Gets the block being read back, or null if not connected
+		 */
+		IBlock* getReadbackSource() const;
+
+		// Property access
+		/**
+		 * @brief Gets the datatype the results are interpreted as
+		 */
+		EnumProperty* getDataType();
+
+		/**
+		 * @brief Gets the frame the latest result has been read back in
+		 */
+		UIntProperty* getFrame();
+
+		/**
+		 * @brief Gets the byte count of the latest result
+		 */
+		UIntProperty* getByteCount();
+
+		/**
+		 * @brief Gets the latest result, converted to floats
+		 */
+		FloatDataProperty* getData();
+
+	public:
+		// Readback
+		/**
+		 * @brief Stores the result of a readback; does not change the pipeline
+		 * @param data The raw data as read from the GPU
+		 * @param frame The frame the data has been rendered in
+		 */
+		void setReadbackResult(const QByteArray& data, unsigned int frame);
+
+	public:
+		// Raw data functions
+		unsigned int getOutputSize(IPort* port) const override;
+		QByteArray retrieveUniformData(IPort* port) const override;
+
+	public:
+		// ICacheable
+		CacheObject::Key getCacheKey(bool retrieveForeignKey) override;
+
+	public:
+		bool canAcceptConnection(IPort* src, IPort* dest, QString& denialReason) override;
+
+	protected:
+		void createPorts() override;
+		void createProperties() override;
+
+	protected slots:
+		void prepareConnection(Connection* con) override;
+
+	private:
+		/**
+		 * @brief Converts the latest result to floats, if not done yet
+		 */
+		const FloatData& getConvertedResult() const;
+
+	private:
+		// Ports
+		Port* _inPort{nullptr};
+		Port* _outPort{nullptr};
+
+		// Properties
+		EnumProperty* _dataType{nullptr};
+		UIntProperty* _frame{nullptr};
+		UIntProperty* _byteCount{nullptr};
+		FloatDataProperty* _data{nullptr};
+
+		// Readback result
+		QByteArray _result;
+		unsigned int _resultFrame{0};
+		unsigned int _resultVersion{0};
+
+		// Converted result
+		mutable FloatData _convertedResult;
+		mutable unsigned int _convertedVersion{0};
+		mutable int _convertedType{-1};
+	};
+}
+
+#endif // READBACKDATASOURCEBLOCK_H
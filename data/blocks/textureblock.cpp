@@ -145,10 +145,11 @@ namespace ysm
 			conPoints << qMakePair(BlockType::Shader_Geometry, PortType::Shader_Texture);
 			conPoints << qMakePair(BlockType::Shader_Fragment, PortType::Shader_Texture);
 			conPoints << qMakePair(BlockType::TextureView, PortType::TextureView_Texture);
+			conPoints << qMakePair(BlockType::Readback, PortType::GenericIn);
 
 			if (!checkConnectionPoints(dest, conPoints))
 			{
-				denialReason = "Texture output must be connected to a Shader or Texture View block";
+				denialReason = "Texture output must be connected to a Shader, Texture View or Readback block";
 				return false;
 			}
 
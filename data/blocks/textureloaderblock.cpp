@@ -106,6 +106,11 @@ namespace ysm
 		return data;
 	}
 
+	int TextureLoaderBlock::getCacheBlockId() const
+	{
+		return static_cast<int>(getID());
+	}
+
 	void TextureLoaderBlock::createProperties()
 	{
 		Block::createProperties();
@@ -147,7 +152,8 @@ namespace ysm
 		{
 			QString textureFile = *_textureFile;
 
-			if (!textureFile.isEmpty())
+			// While a project is being loaded, the texture is loaded on first access instead
+			if (!textureFile.isEmpty() && !getPipeline()->getManager()->isDeferringDataLoads())
 			{
 				// Force loading of the texture file by accessing the texture data
 				getTextureData();
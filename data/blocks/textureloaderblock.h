@@ -69,6 +69,7 @@ namespace ysm
 		// ICacheable
 		CacheObject::Key getCacheKey(bool retrieveForeignKey) override;
 		CacheObject::CacheObjectData* createCacheData() override;
+		int getCacheBlockId() const override;
 
 	protected:
 		void createProperties() override;
@@ -88,6 +89,8 @@ namespace ysm
 
 			TextureData() { }
 			TextureData(gli::texture&& tex) : texture{tex} { }
+
+			qint64 getMemorySize() const override { return texture.empty() ? 0 : static_cast<qint64>(texture.size()); }
 		} _emptyData;
 
 		/**
@@ -42,6 +42,12 @@ namespace ysm
 		removeFromCache();
 	}
 
+	void CacheableObject::prefetchCacheData()
+	{
+		// Retrieving the cache object creates the data on demand
+		_pool->getCacheObject(this);
+	}
+
 	void CacheableObject::removeFromCache()
 	{
 		// Remove this object from all cache objects
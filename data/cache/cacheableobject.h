@@ -39,6 +39,12 @@ namespace ysm
 		explicit CacheableObject(Pipeline* pipeline);
 		virtual ~CacheableObject();
 
+	public:
+		/**
+		 * @brief Materializes the cached data for this object if it isn't cached yet
+		 */
+		void prefetchCacheData();
+
 	protected:
 		/**
 		 * @brief Retrieves the cached data for this object
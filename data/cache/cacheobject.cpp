@@ -24,6 +24,9 @@
  ***********************************************************************************/
 
 #include "cacheobject.h"
+#include "icacheable.h"
+
+#include "data/common/memorytracker.h"
 
 namespace ysm
 {
@@ -34,6 +37,8 @@ namespace ysm
 
 	CacheObject::~CacheObject()
 	{
+		MemoryTracker::getInstance()->removeUsage(this);
+
 		delete _data;
 	}
 
@@ -49,12 +54,24 @@ namespace ysm
 			delete _data;
 
 		_data = data;
+		_memorySize = (data ? data->getMemorySize() : 0);
+
+		updateMemoryUsage();
 	}
 
 	void CacheObject::registerOwner(const ICacheable* owner)
 	{
 		if (!_owners.contains(owner))
+		{
 			_owners << owner;
+
+			// Attribute the data to the first owner that belongs to a block
+			if (_blockId < 0 && owner->getCacheBlockId() >= 0)
+			{
+				_blockId = owner->getCacheBlockId();
+				updateMemoryUsage();
+			}
+		}
 	}
 
 	void CacheObject::unregisterOwner(const ICacheable* owner)
@@ -71,4 +88,24 @@ namespace ysm
 	{
 		return _owners.isEmpty();
 	}
+
+	qint64 CacheObject::getMemorySize() const
+	{
+		return _memorySize;
+	}
+
+	quint64 CacheObject::getLastAccess() const
+	{
+		return _lastAccess;
+	}
+
+	void CacheObject::setLastAccess(quint64 lastAccess)
+	{
+		_lastAccess = lastAccess;
+	}
+
+	void CacheObject::updateMemoryUsage()
+	{
+		MemoryTracker::getInstance()->setUsage(this, MemoryCategory::Cache, _memorySize, _key, _blockId);
+	}
 }
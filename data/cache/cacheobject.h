@@ -28,6 +28,7 @@
 
 #include <QByteArray>
 #include <QList>
+#include <QVector>
 #include <stdexcept>
 
 namespace ysm
@@ -50,6 +51,18 @@ namespace ysm
 		{
 			CacheObjectData() { }
 			virtual ~CacheObjectData() { }
+
+			/**
+			 * @brief Estimates the memory used by the data, reported to the memory tracker
+			 */
+			virtual qint64 getMemorySize() const { return 0; }
+
+		protected:
+			/**
+			 * @brief Returns the memory allocated by @p vector
+			 */
+			template<typename T>
+			static qint64 getVectorSize(const QVector<T>& vector) { return static_cast<qint64>(vector.capacity()) * sizeof(T); }
 		};
 
 	public:
@@ -98,12 +111,38 @@ namespace ysm
 		 */
 		bool isOrphaned() const;
 
+		// Eviction
+		/**
+		 * @brief Retrieves the memory used by the attached data
+		 */
+		qint64 getMemorySize() const;
+
+		/**
+		 * @brief Retrieves the stamp of the last access
+		 */
+		quint64 getLastAccess() const;
+
+		/**
+		 * @brief Marks the object as accessed, using the pool's access counter
+		 */
+		void setLastAccess(quint64 lastAccess);
+
+	private:
+		/**
+		 * @brief Reports the attached data to the memory tracker
+		 */
+		void updateMemoryUsage();
+
 	private:
 		CachePool* _cachePool{nullptr};
 
 		Key _key;
 		CacheObjectData* _data{nullptr};
 
+		qint64 _memorySize{0};
+		quint64 _lastAccess{0};
+		int _blockId{-1};
+
 		QList<const ICacheable*> _owners;
 	};
 
@@ -24,18 +24,24 @@
  ***********************************************************************************/
 
 #include "cachepool.h"
+#include "data/common/memorytracker.h"
 
 #include <QVector>
 
+#include <algorithm>
+
 namespace ysm
 {
 	CachePool::CachePool()
 	{
-
+		// Trim the cache if it exceeds its budget
+		MemoryTracker::getInstance()->addEvictionHandler(this, MemoryCategory::Cache, [this](qint64 bytes) { evict(bytes); });
 	}
 
 	CachePool::~CachePool()
 	{
+		MemoryTracker::getInstance()->removeEvictionHandlers(this);
+
 		clearCache();
 	}
 
@@ -77,6 +83,7 @@ namespace ysm
 		CacheObject* cacheObject = _cacheObjects[key];
 
 		cacheObject->registerOwner(owner);
+		cacheObject->setLastAccess(++_accessCounter);
 
 		// Remove owner from any other cache objects (an object can only be cached once)
 		for (CacheObject* co : _cacheObjects)
@@ -139,4 +146,35 @@ namespace ysm
 		qDeleteAll(_cacheObjects);
 		_cacheObjects.clear();
 	}
+
+	void CachePool::evict(qint64 bytes)
+	{
+		// Sort the objects by their last access
+		QVector<CacheObject*> cacheObjects;
+
+		for (CacheObject* co : _cacheObjects)
+			cacheObjects << co;
+
+		std::sort(cacheObjects.begin(), cacheObjects.end(), [](CacheObject* a, CacheObject* b) { return a->getLastAccess() < b->getLastAccess(); });
+
+		// Remove the oldest ones
+		qint64 freedBytes = 0;
+
+		for (CacheObject* co : cacheObjects)
+		{
+			if (freedBytes >= bytes)
+				break;
+
+			// Keep objects in use, the memory tracker reports the exceeded budget instead
+			if (co->getMemorySize() == 0 || co->getLastAccess() > _evictionCounter)
+				continue;
+
+			freedBytes += co->getMemorySize();
+
+			_cacheObjects.remove(co->getKey());
+			delete co;
+		}
+
+		_evictionCounter = _accessCounter;
+	}
 }
@@ -71,8 +71,19 @@ namespace ysm
 		 */
 		void clearCache();
 
+		/**
+		 * @brief Removes the least recently used objects, until at least @p bytes are freed
+		 * Evicted objects are recreated by their owners on the next access. This must not be called while an owner
+		 * is using its cached data, which is ensured by the memory tracker calling it from the event loop.
+		 * Objects accessed since the last eviction are kept, as they are in use and would be recreated right away.
+		 */
+		void evict(qint64 bytes);
+
 	private:
 		QMap<CacheObject::Key, CacheObject*> _cacheObjects;
+
+		quint64 _accessCounter{0};
+		quint64 _evictionCounter{0};
 	};
 }
 
@@ -45,6 +45,9 @@ namespace ysm
 		/// @brief Creates the actual cached data.
 		virtual CacheObject::CacheObjectData* createCacheData() = 0;
 
+		/// @brief Retrieves the ID of the block the cached data is accounted to, or -1.
+		virtual int getCacheBlockId() const { return -1; }
+
 	protected:
 
 		/// @brief Initialize new instance.
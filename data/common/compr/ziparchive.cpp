@@ -24,11 +24,15 @@
  ***********************************************************************************/
 
 #include "ziparchive.h"
+#include "data/common/threadpool.h"
 
 #include <QDirIterator>
 #include <QDebug>
+#include <QBuffer>
+#include <QVector>
 
 #define NAME_BUFFER_SIZE	1024
+#define CHUNK_SIZE			(1024 * 1024)
 
 namespace ysm
 {
@@ -87,30 +91,141 @@ namespace ysm
 
 		QFileInfo fi{fileName};
 		QString nameInArchive = (zipDir.isEmpty() ? fi.fileName() : QFileInfo(QDir(zipDir), fi.fileName()).filePath());
-		zip_fileinfo zipInfo;
+		QFile file{fileName};
+
+		if (!file.open(QIODevice::ReadOnly))
+			return false;
+
+		// Compressing already compressed formats again only costs time
+		return writeFile(&file, nameInArchive, !isCompressedFormat(fileName));
+	}
+
+	bool ZipArchive::addData(const QByteArray& data, QString nameInArchive)
+	{
+		// Not opened for storing?
+		if (!_zipFile)
+			return false;
+
+		QBuffer buffer;
+		buffer.setData(data);
 
+		if (!buffer.open(QIODevice::ReadOnly))
+			return false;
+
+		return writeFile(&buffer, nameInArchive, true);
+	}
+
+	bool ZipArchive::writeFile(QIODevice* source, QString nameInArchive, bool compress)
+	{
+		zip_fileinfo zipInfo;
 		memset(&zipInfo, 0, sizeof(zipInfo));
 
-		// Create a new file in the archive
-		if (zipOpenNewFileInZip(_zipFile, qPrintable(nameInArchive), &zipInfo, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, Z_BEST_COMPRESSION) == ZIP_OK)
+		if (!compress)
 		{
-			QFile file{fileName};
-			bool ret = false;
+			// Stored files are written as they are
+			if (zipOpenNewFileInZip(_zipFile, qPrintable(nameInArchive), &zipInfo, nullptr, 0, nullptr, 0, nullptr, 0, 0) != ZIP_OK)
+				return false;
 
-			// Write the contents to the archive file
-			if (file.open(QIODevice::ReadOnly))
+			bool ret = true;
+
+			while (ret && !source->atEnd())
 			{
-				QByteArray contents = file.readAll();
+				QByteArray chunk = source->read(CHUNK_SIZE);
 
-				if (zipWriteInFileInZip(_zipFile, contents.data(), contents.size()) == ZIP_OK)
-					ret = true;
+				if (zipWriteInFileInZip(_zipFile, chunk.data(), chunk.size()) != ZIP_OK)
+					ret = false;
 			}
 
 			zipCloseFileInZip(_zipFile);
 			return ret;
 		}
 
-		return false;
+		// Compressed files are deflated by ourselves, so the file is opened in raw mode
+		if (zipOpenNewFileInZip2(_zipFile, qPrintable(nameInArchive), &zipInfo, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, Z_BEST_COMPRESSION, 1) != ZIP_OK)
+			return false;
+
+		int chunkCount = qMax(1, ThreadPool::getThreadCount());
+		QVector<QByteArray> input(chunkCount);
+		QVector<QByteArray> output(chunkCount);
+		QVector<bool> deflated(chunkCount);
+
+		uLong crc = crc32(0L, Z_NULL, 0);
+		uLong uncompressedSize = 0;
+		bool isFinished = false;
+		bool ret = true;
+
+		while (ret && !isFinished)
+		{
+			// Read the next chunks, one for each thread
+			int chunks = 0;
+
+			while (chunks < chunkCount && !source->atEnd())
+				input[chunks++] = source->read(CHUNK_SIZE);
+
+			isFinished = source->atEnd();
+
+			// An empty source still needs to finish the stream
+			if (chunks == 0)
+				input[chunks++].clear();
+
+			// Deflate the chunks in parallel, each one starting a new deflate block
+			ThreadPool::parallelFor(chunks, [&](int i)
+			{
+				deflated[i] = deflateChunk(input[i], output[i], isFinished && i == chunks - 1);
+			});
+
+			for (int i = 0; i < chunks; ++i)
+			{
+				if (!deflated[i])
+					ret = false;
+			}
+
+			// Write the chunks in order
+			for (int i = 0; ret && i < chunks; ++i)
+			{
+				crc = crc32(crc, reinterpret_cast<const Bytef*>(input[i].constData()), input[i].size());
+				uncompressedSize += input[i].size();
+
+				if (zipWriteInFileInZip(_zipFile, output[i].constData(), output[i].size()) != ZIP_OK)
+					ret = false;
+			}
+		}
+
+		zipCloseFileInZipRaw(_zipFile, uncompressedSize, crc);
+		return ret;
+	}
+
+	bool ZipArchive::isCompressedFormat(QString fileName)
+	{
+		static const QStringList compressedFormats = QStringList() << "png" << "jpg" << "jpeg" << "ktx" << "dds" << "zip" << "gz";
+		return compressedFormats.contains(QFileInfo(fileName).suffix(), Qt::CaseInsensitive);
+	}
+
+	bool ZipArchive::deflateChunk(const QByteArray& input, QByteArray& output, bool isLast)
+	{
+		z_stream stream;
+		memset(&stream, 0, sizeof(stream));
+
+		// Raw deflate without header, as expected by zip archives
+		if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+			return false;
+
+		// A sync flush adds an empty block at most, so the bound is always sufficient
+		output.resize(static_cast<int>(deflateBound(&stream, input.size())) + 16);
+
+		stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.constData()));
+		stream.avail_in = input.size();
+		stream.next_out = reinterpret_cast<Bytef*>(output.data());
+		stream.avail_out = output.size();
+
+		// Non-final chunks end on a byte boundary, so they can be concatenated
+		int result = deflate(&stream, isLast ? Z_FINISH : Z_SYNC_FLUSH);
+		bool ret = (isLast ? result == Z_STREAM_END : result == Z_OK) && stream.avail_in == 0;
+
+		output.resize(output.size() - stream.avail_out);
+		deflateEnd(&stream);
+
+		return ret;
 	}
 
 	bool ZipArchive::addDirectory(QString dirName, QString baseDir)
@@ -145,7 +260,7 @@ namespace ysm
 		return true;
 	}
 
-	bool ZipArchive::unpackContents(QString destDir)
+	bool ZipArchive::unpackContents(QString destDir, const QStringList& skippedFiles)
 	{
 		// Not opened for unpacking?
 		if (!_unzipFile)
@@ -167,6 +282,10 @@ namespace ysm
 				// Get information about the current file
 				if (unzGetCurrentFileInfo(_unzipFile, &unzipInfo, nameBuffer, NAME_BUFFER_SIZE, nullptr, 0, nullptr, 0) == UNZ_OK)
 				{
+					// Skip files that are read directly
+					if (skippedFiles.contains(nameBuffer))
+						continue;
+
 					// Finally, open the file and read its contents
 					if (unzOpenCurrentFile(_unzipFile) == UNZ_OK)
 					{
@@ -186,6 +305,56 @@ namespace ysm
 		return ret;
 	}
 
+	QStringList ZipArchive::getFileNames()
+	{
+		QStringList fileNames;
+
+		// Not opened for unpacking?
+		if (!_unzipFile)
+			return fileNames;
+
+		if (unzGoToFirstFile(_unzipFile) == UNZ_OK)
+		{
+			do
+			{
+				char nameBuffer[NAME_BUFFER_SIZE];
+				memset(nameBuffer, 0, NAME_BUFFER_SIZE * sizeof(char));
+
+				if (unzGetCurrentFileInfo(_unzipFile, nullptr, nameBuffer, NAME_BUFFER_SIZE, nullptr, 0, nullptr, 0) == UNZ_OK)
+					fileNames << nameBuffer;
+			} while (unzGoToNextFile(_unzipFile) == UNZ_OK);
+		}
+
+		return fileNames;
+	}
+
+	bool ZipArchive::readFile(QString nameInArchive, QByteArray& data)
+	{
+		// Not opened for unpacking?
+		if (!_unzipFile)
+			return false;
+
+		unz_file_info unzipInfo;
+		memset(&unzipInfo, 0, sizeof(unzipInfo));
+
+		// Find the file in the archive
+		if (unzLocateFile(_unzipFile, qPrintable(nameInArchive), 1) != UNZ_OK)
+			return false;
+
+		if (unzGetCurrentFileInfo(_unzipFile, &unzipInfo, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK)
+			return false;
+
+		if (unzOpenCurrentFile(_unzipFile) != UNZ_OK)
+			return false;
+
+		// Read the whole file at once
+		data.resize(unzipInfo.uncompressed_size);
+		int copied = (data.size() > 0 ? unzReadCurrentFile(_unzipFile, data.data(), data.size()) : 0);
+
+		unzCloseCurrentFile(_unzipFile);
+		return (copied == data.size());
+	}
+
 	bool ZipArchive::unpackFile(QString destDir, QString fileName, unsigned int fileSize)
 	{
 		QFileInfo fullPath{QDir{destDir}, fileName};
@@ -30,6 +30,10 @@
 #include <minizip/unzip.h>
 
 #include <QString>
+#include <QStringList>
+#include <QByteArray>
+
+class QIODevice;
 
 namespace ysm
 {
@@ -65,9 +69,15 @@ namespace ysm
 		// File handling
 		/**
 		 * @brief Adds the specified file to the archive
+		 * The file is streamed into the archive; already compressed formats are stored without compressing them again.
 		 */
 		bool addFile(QString fileName, QString zipDir);
 
+		/**
+		 * @brief Adds the given data as file @p nameInArchive to the archive
+		 */
+		bool addData(const QByteArray& data, QString nameInArchive);
+
 		/**
 		 * @brief Adds the specified directory to the archive
 		 */
@@ -77,7 +87,17 @@ namespace ysm
 		 * @brief Extracts the contents of the archive to @p destDir
 		 * Note: Existing files will be overwritten
 		 */
-		bool unpackContents(QString destDir);
+		bool unpackContents(QString destDir, const QStringList& skippedFiles = QStringList());
+
+		/**
+		 * @brief Lists the names of all files in the archive
+		 */
+		QStringList getFileNames();
+
+		/**
+		 * @brief Reads the file @p nameInArchive directly from the archive into @p data
+		 */
+		bool readFile(QString nameInArchive, QByteArray& data);
 
 	private:
 		/**
@@ -85,6 +105,23 @@ namespace ysm
 		 */
 		bool unpackFile(QString destDir, QString fileName, unsigned int fileSize);
 
+		/**
+		 * @brief Writes the contents of @p source to a new file in the archive
+		 * @param compress If true, the contents are deflated in parallel chunks; otherwise, they are stored
+		 */
+		bool writeFile(QIODevice* source, QString nameInArchive, bool compress);
+
+		/**
+		 * @brief Checks if the given file is in an already compressed format
+		 */
+		static bool isCompressedFormat(QString fileName);
+
+		/**
+		 * @brief Deflates a single chunk into a raw deflate stream; all chunks can be concatenated
+		 * @param isLast If true, the chunk finishes the stream
+		 */
+		static bool deflateChunk(const QByteArray& input, QByteArray& output, bool isLast);
+
 	private:
 		zipFile _zipFile{nullptr};
 		unzFile _unzipFile{nullptr};
@@ -0,0 +1,336 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "memorytracker.h"
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <QSettings>
+#include <QThread>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ysm
+{
+	namespace
+	{
+		/**
+		 * @brief Returns the settings key of the budget of @p category
+		 */
+		QString getBudgetKey(MemoryCategory category)
+		{
+			switch (category)
+			{
+				case MemoryCategory::Cache:				return "memoryBudget/cache";
+				case MemoryCategory::UndoHistory:		return "historyBudget";
+				case MemoryCategory::GLBuffer:			return "memoryBudget/glBuffer";
+				case MemoryCategory::GLTexture:			return "memoryBudget/glTexture";
+				case MemoryCategory::GLRenderBuffer:	return "memoryBudget/glRenderBuffer";
+			}
+
+			return QString();
+		}
+
+		/**
+		 * @brief Returns the default budget of @p category
+		 */
+		qint64 getDefaultBudget(MemoryCategory category)
+		{
+			// GPU memory is unlimited by default, the driver knows better
+			switch (category)
+			{
+				case MemoryCategory::Cache:			return Q_INT64_C(1024) * 1024 * 1024;
+				case MemoryCategory::UndoHistory:	return Q_INT64_C(256) * 1024 * 1024;
+				default:							return 0;
+			}
+		}
+	}
+
+	MemoryTracker::MemoryTracker()
+	{
+		// Budget enforcement must run on the main thread, where the owners are not in the middle of an operation
+		if (QCoreApplication::instance() && thread() != QCoreApplication::instance()->thread())
+			moveToThread(QCoreApplication::instance()->thread());
+
+		QSettings settings;
+
+		for (int i = 0; i < CategoryCount; ++i)
+		{
+			MemoryCategory category = static_cast<MemoryCategory>(i);
+
+			_usage[i] = 0;
+			_highWaterMarks[i] = 0;
+			_budgets[i] = settings.value(getBudgetKey(category), getDefaultBudget(category)).toLongLong();
+		}
+	}
+
+	MemoryTracker* MemoryTracker::getInstance()
+	{
+		// Created on first use, which is thread safe
+		static MemoryTracker memoryTracker;
+		return &memoryTracker;
+	}
+
+	QString MemoryTracker::getCategoryName(MemoryCategory category)
+	{
+		switch (category)
+		{
+			case MemoryCategory::Cache:				return tr("Data cache");
+			case MemoryCategory::UndoHistory:		return tr("Undo history");
+			case MemoryCategory::GLBuffer:			return tr("GL buffers");
+			case MemoryCategory::GLTexture:			return tr("GL textures");
+			case MemoryCategory::GLRenderBuffer:	return tr("GL renderbuffers");
+		}
+
+		return QString();
+	}
+
+	void MemoryTracker::setUsage(const void* owner, MemoryCategory category, qint64 bytes, const QString& name, int blockId)
+	{
+		if (!owner)
+			throw std::invalid_argument{"owner may not be null"};
+
+		if (bytes <= 0)
+		{
+			removeUsage(owner);
+			return;
+		}
+
+		QMutexLocker locker(&_mutex);
+
+		// Replace the previous report of the owner
+		auto it = _allocations.find(owner);
+
+		if (it != _allocations.end())
+		{
+			_usage[static_cast<int>(it->category)] -= it->bytes;
+			_totalUsage -= it->bytes;
+		}
+		else
+			it = _allocations.insert(owner, Allocation());
+
+		it->category = category;
+		it->bytes = bytes;
+		it->name = name;
+		it->blockId = blockId;
+
+		int index = static_cast<int>(category);
+
+		_usage[index] += bytes;
+		_totalUsage += bytes;
+		_highWaterMarks[index] = qMax(_highWaterMarks[index], _usage[index]);
+		_totalHighWaterMark = qMax(_totalHighWaterMark, _totalUsage);
+		_revision++;
+
+		// Trim the category later on the main thread, the owner may still be working with its data
+		if (_budgets[index] > 0 && _usage[index] > _budgets[index] && !_enforcementPending)
+		{
+			_enforcementPending = true;
+			QMetaObject::invokeMethod(this, "enforceBudgets", Qt::QueuedConnection);
+		}
+	}
+
+	void MemoryTracker::removeUsage(const void* owner)
+	{
+		QMutexLocker locker(&_mutex);
+
+		auto it = _allocations.find(owner);
+
+		if (it == _allocations.end())
+			return;
+
+		_usage[static_cast<int>(it->category)] -= it->bytes;
+		_totalUsage -= it->bytes;
+		_revision++;
+
+		_allocations.erase(it);
+	}
+
+	qint64 MemoryTracker::getUsage(MemoryCategory category) const
+	{
+		QMutexLocker locker(&_mutex);
+		return _usage[static_cast<int>(category)];
+	}
+
+	qint64 MemoryTracker::getTotalUsage() const
+	{
+		QMutexLocker locker(&_mutex);
+		return _totalUsage;
+	}
+
+	qint64 MemoryTracker::getHighWaterMark(MemoryCategory category) const
+	{
+		QMutexLocker locker(&_mutex);
+		return _highWaterMarks[static_cast<int>(category)];
+	}
+
+	qint64 MemoryTracker::getTotalHighWaterMark() const
+	{
+		QMutexLocker locker(&_mutex);
+		return _totalHighWaterMark;
+	}
+
+	QList<MemoryTracker::Consumer> MemoryTracker::getTopConsumers(int count) const
+	{
+		QList<Consumer> consumers;
+
+		{
+			QMutexLocker locker(&_mutex);
+
+			// Sum up the allocations of each block, unowned allocations are listed on their own
+			QHash<int, int> blockConsumers;
+
+			for (const Allocation& allocation : _allocations)
+			{
+				if (allocation.blockId >= 0 && blockConsumers.contains(allocation.blockId))
+				{
+					consumers[blockConsumers[allocation.blockId]].bytes += allocation.bytes;
+					continue;
+				}
+
+				if (allocation.blockId >= 0)
+					blockConsumers[allocation.blockId] = consumers.size();
+
+				Consumer consumer;
+				consumer.name = allocation.name;
+				consumer.blockId = allocation.blockId;
+				consumer.bytes = allocation.bytes;
+				consumers << consumer;
+			}
+		}
+
+		std::sort(consumers.begin(), consumers.end(), [](const Consumer& a, const Consumer& b) { return a.bytes > b.bytes; });
+
+		return consumers.mid(0, count);
+	}
+
+	quint64 MemoryTracker::getRevision() const
+	{
+		QMutexLocker locker(&_mutex);
+		return _revision;
+	}
+
+	qint64 MemoryTracker::getBudget(MemoryCategory category) const
+	{
+		QMutexLocker locker(&_mutex);
+		return _budgets[static_cast<int>(category)];
+	}
+
+	void MemoryTracker::setBudget(MemoryCategory category, qint64 budget)
+	{
+		{
+			QMutexLocker locker(&_mutex);
+
+			_budgets[static_cast<int>(category)] = qMax(budget, Q_INT64_C(0));
+			_revision++;
+		}
+
+		QSettings().setValue(getBudgetKey(category), qMax(budget, Q_INT64_C(0)));
+
+		// Apply the new budget
+		QMetaObject::invokeMethod(this, "enforceBudgets", Qt::QueuedConnection);
+	}
+
+	bool MemoryTracker::fitsBudget(MemoryCategory category, qint64 bytes, const void* owner) const
+	{
+		QMutexLocker locker(&_mutex);
+
+		int index = static_cast<int>(category);
+
+		if (_budgets[index] <= 0)
+			return true;
+
+		// A replaced allocation of the owner is freed first
+		qint64 usage = _usage[index];
+		auto it = _allocations.find(owner);
+
+		if (owner && it != _allocations.end() && it->category == category)
+			usage -= it->bytes;
+
+		return usage + bytes <= _budgets[index];
+	}
+
+	void MemoryTracker::addEvictionHandler(const void* owner, MemoryCategory category, const EvictionHandler& handler)
+	{
+		QMutexLocker locker(&_mutex);
+		_handlers << Handler{owner, category, handler};
+	}
+
+	void MemoryTracker::removeEvictionHandlers(const void* owner)
+	{
+		QMutexLocker locker(&_mutex);
+
+		for (int i = _handlers.size() - 1; i >= 0; --i)
+		{
+			if (_handlers[i].owner == owner)
+				_handlers.removeAt(i);
+		}
+	}
+
+	void MemoryTracker::enforceBudgets()
+	{
+		for (int i = 0; i < CategoryCount; ++i)
+		{
+			MemoryCategory category = static_cast<MemoryCategory>(i);
+			QList<Handler> handlers;
+
+			{
+				QMutexLocker locker(&_mutex);
+
+				if (i == 0)
+					_enforcementPending = false;
+
+				if (_budgets[i] <= 0 || _usage[i] <= _budgets[i])
+					continue;
+
+				for (const Handler& handler : _handlers)
+				{
+					if (handler.category == category)
+						handlers << handler;
+				}
+			}
+
+			// The handlers report their freed memory, so the lock must not be held
+			for (const Handler& handler : handlers)
+			{
+				qint64 excess = getUsage(category) - getBudget(category);
+
+				if (excess <= 0)
+					break;
+
+				handler.evict(excess);
+			}
+
+			qint64 usage = getUsage(category);
+			qint64 budget = getBudget(category);
+
+			if (budget > 0 && usage > budget)
+				emit budgetExceeded(category, usage, budget);
+		}
+	}
+}
@@ -0,0 +1,218 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef MEMORYTRACKER_H
+#define MEMORYTRACKER_H
+
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+
+#include <functional>
+
+namespace ysm
+{
+	/**
+	 * @brief The categories memory is accounted in
+	 */
+	enum class MemoryCategory
+	{
+		Cache,
+		UndoHistory,
+		GLBuffer,
+		GLTexture,
+		GLRenderBuffer,
+	};
+
+	/**
+	 * @brief Application wide accounting of CPU and GPU memory
+	 * Every allocation owner reports the bytes it currently holds, by category and owning block. The tracker keeps
+	 * totals and high-water marks and enforces configurable budgets per category: categories with eviction handlers
+	 * (e.g. the cache) are trimmed on the main thread, all others are expected to check fitsBudget() before allocating.
+	 * All functions are thread safe.
+	 */
+	class MemoryTracker : public QObject
+	{
+		Q_OBJECT
+
+	public:
+		/// @brief Number of categories
+		static const int CategoryCount = static_cast<int>(MemoryCategory::GLRenderBuffer) + 1;
+
+		/**
+		 * @brief A consumer of memory, summed up over all allocations of a block or an unowned allocation
+		 */
+		struct Consumer
+		{
+			QString name;
+			int blockId{-1};
+			qint64 bytes{0};
+		};
+
+		/// @brief Frees at least the given number of bytes, if possible
+		using EvictionHandler = std::function<void(qint64 bytes)>;
+
+	public:
+		/**
+		 * @brief Returns the application's memory tracker
+		 */
+		static MemoryTracker* getInstance();
+
+		/**
+		 * @brief Returns the display name of @p category
+		 */
+		static QString getCategoryName(MemoryCategory category);
+
+	public:
+		// Accounting
+		/**
+		 * @brief Sets the bytes currently held by @p owner, replacing any previous report of the owner
+		 * @param owner Any pointer identifying the allocation
+		 * @param category The category the allocation belongs to
+		 * @param bytes The allocation's size, zero removes the allocation
+		 * @param name The allocation's display name
+		 * @param blockId The ID of the owning block or -1
+		 */
+		void setUsage(const void* owner, MemoryCategory category, qint64 bytes, const QString& name = QString(), int blockId = -1);
+
+		/**
+		 * @brief Removes the allocation of @p owner
+		 */
+		void removeUsage(const void* owner);
+
+		/**
+		 * @brief Returns the bytes currently used in @p category
+		 */
+		qint64 getUsage(MemoryCategory category) const;
+
+		/**
+		 * @brief Returns the bytes currently used in all categories
+		 */
+		qint64 getTotalUsage() const;
+
+		/**
+		 * @brief Returns the maximum bytes ever used in @p category
+		 */
+		qint64 getHighWaterMark(MemoryCategory category) const;
+
+		/**
+		 * @brief Returns the maximum bytes ever used in all categories at once
+		 */
+		qint64 getTotalHighWaterMark() const;
+
+		/**
+		 * @brief Returns the largest consumers, allocations of the same block are summed up
+		 * @param count The maximum number of consumers
+		 */
+		QList<Consumer> getTopConsumers(int count) const;
+
+		/**
+		 * @brief Returns a counter, that changes whenever the usage changed
+		 */
+		quint64 getRevision() const;
+
+	public:
+		// Budgets
+		/**
+		 * @brief Returns the budget of @p category in bytes, zero if unlimited
+		 */
+		qint64 getBudget(MemoryCategory category) const;
+
+		/**
+		 * @brief Sets the budget of @p category in bytes, zero if unlimited
+		 * The budget is stored to the application settings.
+		 */
+		void setBudget(MemoryCategory category, qint64 budget);
+
+		/**
+		 * @brief Checks whether @p bytes can be allocated in @p category without exceeding its budget
+		 * @param owner If the owner already holds an allocation, it is assumed to be replaced
+		 */
+		bool fitsBudget(MemoryCategory category, qint64 bytes, const void* owner = nullptr) const;
+
+		/**
+		 * @brief Registers a handler, that is called on the main thread if @p category exceeds its budget
+		 */
+		void addEvictionHandler(const void* owner, MemoryCategory category, const EvictionHandler& handler);
+
+		/**
+		 * @brief Removes all eviction handlers of @p owner
+		 */
+		void removeEvictionHandlers(const void* owner);
+
+	signals:
+		/**
+		 * @brief Emitted on the main thread, if a category still exceeds its budget after eviction
+		 */
+		void budgetExceeded(MemoryCategory category, qint64 usage, qint64 budget);
+
+	protected slots:
+		/**
+		 * @brief Calls the eviction handlers of all categories, which exceed their budget
+		 */
+		void enforceBudgets();
+
+	private:
+		// Construction
+		explicit MemoryTracker();
+
+	private:
+		/**
+		 * @brief A single reported allocation
+		 */
+		struct Allocation
+		{
+			MemoryCategory category;
+			qint64 bytes;
+			QString name;
+			int blockId;
+		};
+
+		struct Handler
+		{
+			const void* owner;
+			MemoryCategory category;
+			EvictionHandler evict;
+		};
+
+		mutable QMutex _mutex;
+
+		QMap<const void*, Allocation> _allocations;
+		QList<Handler> _handlers;
+
+		qint64 _usage[CategoryCount];
+		qint64 _highWaterMarks[CategoryCount];
+		qint64 _budgets[CategoryCount];
+		qint64 _totalUsage{0};
+		qint64 _totalHighWaterMark{0};
+
+		quint64 _revision{0};
+		bool _enforcementPending{false};
+	};
+}
+
+#endif
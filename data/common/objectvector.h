@@ -27,6 +27,7 @@
 #define OBJECTVECTOR_H
 
 #include <QVector>
+#include <QHash>
 #include <memory>
 #include <functional>
 
@@ -78,6 +79,52 @@ namespace ysm
 		template<typename I = T>
 		QVector<I*> objects(const std::function<bool(T*)> pred = nullptr) const;
 
+		/**
+		 * @brief Non-allocating view on all objects matching a predicate, to be used in range-based for loops
+		 * @arg I The object class to cast the objects to
+		 */
+		template<typename I = T>
+		class FilteredView
+		{
+		public:
+			class const_iterator
+			{
+			public:
+				const_iterator(typename QVector<T*>::const_iterator it, typename QVector<T*>::const_iterator end, const std::function<bool(T*)>* pred) : _it{it}, _end{end}, _pred{pred} { skip(); }
+
+				I* operator *() const { return *_it; }
+				const_iterator& operator ++() { ++_it; skip(); return *this; }
+				bool operator !=(const const_iterator& other) const { return _it != other._it; }
+				bool operator ==(const const_iterator& other) const { return _it == other._it; }
+
+			private:
+				void skip() { while (_it != _end && *_pred && !(*_pred)(*_it)) ++_it; }
+
+			private:
+				typename QVector<T*>::const_iterator _it;
+				typename QVector<T*>::const_iterator _end;
+				const std::function<bool(T*)>* _pred{nullptr};
+			};
+
+		public:
+			FilteredView(const QVector<T*>& objects, const std::function<bool(T*)> pred) : _objects{objects}, _pred{pred} { }
+
+			const_iterator begin() const { return const_iterator{_objects.cbegin(), _objects.cend(), &_pred}; }
+			const_iterator end() const { return const_iterator{_objects.cend(), _objects.cend(), &_pred}; }
+
+		private:
+			const QVector<T*>& _objects;
+			std::function<bool(T*)> _pred;
+		};
+
+		/**
+		 * @brief Returns a view of all objects matching the given predicate @p pred, without copying them
+		 * The view must not be used after the vector has been modified.
+		 * @arg I The object class to cast the objects to
+		 */
+		template<typename I = T>
+		FilteredView<I> filtered(const std::function<bool(T*)> pred) const;
+
 		// Item modifications
 		virtual void append(const T* t);
 		virtual void insert(const int i, const T* t);
@@ -109,9 +156,19 @@ namespace ysm
 		void serialize(QDomElement* xmlElement, SerializationContext* ctx) const override;
 		void deserialize(const QDomElement* xmlElement, SerializationContext* ctx) override;
 
+	protected:
+		/**
+		 * @brief Updates the positions stored in the index after insertions or removals in the middle of the vector
+		 */
+		void rebuildIndex() const;
+
 	protected:
 		vector_type _objects;
 
+		// Maps all objects to their position in the vector; positions are updated lazily
+		mutable QHash<const T*, int> _index;
+		mutable bool _isIndexValid{true};
+
 		QString _xmlElementName;
 	};
 
@@ -144,33 +201,45 @@ namespace ysm
 	template<typename T>
 	int ObjectVector<T>::indexOf(const T* t, const int from) const
 	{
-		for (int i = from; i < size(); ++i)
-		{
-			if (_objects[i] == t)
-				return i;
-		}
+		if (!_index.contains(t))
+			return -1;
+
+		if (!_isIndexValid)
+			rebuildIndex();
 
-		return -1;
+		// Objects are unique, so there is no other occurence behind from
+		int i = _index.value(t);
+		return (i >= from ? i : -1);
 	}
 
 	template<typename T>
 	bool ObjectVector<T>::contains(const T* t) const
 	{
-		return (indexOf(t) != -1);
+		return _index.contains(t);
 	}
 
 	template<typename T>
 	void ObjectVector<T>::append(const T* t)
 	{
 		if (!contains(t))
+		{
+			_index.insert(t, _objects.size());
 			_objects.append(const_cast<T*>(t));
+		}
 	}
 
 	template<typename T>
 	void ObjectVector<T>::insert(const int i, const T* t)
 	{
 		if (!contains(t))
+		{
 			_objects.insert(i, const_cast<T*>(t));
+			_index.insert(t, i);
+
+			// All following objects have been moved
+			if (i < _objects.size() - 1)
+				_isIndexValid = false;
+		}
 	}
 
 	template<typename T>
@@ -179,6 +248,11 @@ namespace ysm
 		T* obj = _objects[i];
 
 		_objects.remove(i);
+		_index.remove(obj);
+
+		// All following objects have been moved
+		if (i < _objects.size())
+			_isIndexValid = false;
 
 		if (deleteObj)
 			delete obj;
@@ -208,8 +282,22 @@ namespace ysm
 			T* obj = _objects[0];
 			_objects.removeAt(0);
 
+			_index.remove(obj);
+			_isIndexValid = false;
+
 			delete obj;
 		}
+
+		_isIndexValid = true;
+	}
+
+	template<typename T>
+	void ObjectVector<T>::rebuildIndex() const
+	{
+		for (int i = 0; i < _objects.size(); ++i)
+			_index[_objects[i]] = i;
+
+		_isIndexValid = true;
 	}
 
 	template<typename T>
@@ -301,6 +389,9 @@ namespace ysm
 	{
 		QVector<I*> vec;
 
+		if (!pred)
+			vec.reserve(_objects.size());
+
 		for (const object_type& obj : _objects)
 		{
 			if (pred && !pred(obj))
@@ -311,6 +402,13 @@ namespace ysm
 
 		return vec;
 	}
+
+	template<typename T>
+	template<typename I>
+	typename ObjectVector<T>::template FilteredView<I> ObjectVector<T>::filtered(const std::function<bool(T*)> pred) const
+	{
+		return FilteredView<I>{_objects, pred};
+	}
 }
 
 #endif
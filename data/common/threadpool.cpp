@@ -0,0 +1,91 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "threadpool.h"
+
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+
+namespace ysm
+{
+	namespace
+	{
+		/**
+		 * @brief Task running a function on the thread pool
+		 */
+		class FunctionTask : public QRunnable
+		{
+		public:
+			explicit FunctionTask(const std::function<void()>& func) : _func(func)
+			{
+
+			}
+
+			void run() override
+			{
+				_func();
+			}
+
+		private:
+			std::function<void()> _func;
+		};
+	}
+
+	void ThreadPool::start(const std::function<void()>& func)
+	{
+		QThreadPool::globalInstance()->start(new FunctionTask(func));
+	}
+
+	void ThreadPool::parallelFor(int chunkCount, const std::function<void(int)>& func)
+	{
+		if (chunkCount <= 1)
+		{
+			if (chunkCount == 1)
+				func(0);
+
+			return;
+		}
+
+		// The caller waits for the tasks, so they may refer to the function
+		QSemaphore done;
+
+		for (int i = 1; i < chunkCount; ++i)
+		{
+			start([&func, &done, i]() {
+				func(i);
+				done.release();
+			});
+		}
+
+		func(0);
+		done.acquire(chunkCount - 1);
+	}
+
+	int ThreadPool::getThreadCount()
+	{
+		return QThreadPool::globalInstance()->maxThreadCount();
+	}
+}
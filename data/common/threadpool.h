@@ -0,0 +1,61 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <functional>
+
+namespace ysm
+{
+	/**
+	 * @brief Runs work on the global thread pool
+	 * All background and parallel work of the data sources and views goes through this class.
+	 */
+	class ThreadPool
+	{
+	public:
+		/**
+		 * @brief Runs @p func on the global thread pool without waiting for it
+		 */
+		static void start(const std::function<void()>& func);
+
+		/**
+		 * @brief Calls @p func for every chunk in [0, @p chunkCount), distributing the chunks over the global thread pool
+		 * The first chunk is processed on the calling thread; returns once all chunks have been processed.
+		 */
+		static void parallelFor(int chunkCount, const std::function<void(int)>& func);
+
+		/**
+		 * @brief Gets the number of threads work can be distributed over
+		 */
+		static int getThreadCount();
+
+	private:
+		explicit ThreadPool();
+	};
+}
+
+#endif
@@ -27,6 +27,26 @@
 
 namespace ysm
 {	
+	qint64 Utils::getMemorySize(const QString& value)
+	{
+		return sizeof(value) + value.capacity() * sizeof(QChar);
+	}
+
+	qint64 Utils::getMemorySize(const QStringList& value)
+	{
+		qint64 size = sizeof(value);
+
+		for (const QString& str : value)
+			size += getMemorySize(str);
+
+		return size;
+	}
+
+	qint64 Utils::getMemorySize(const QByteArray& value)
+	{
+		return sizeof(value) + value.capacity();
+	}
+
 	QString Utils::encodeEscapeCharacters(QString str, bool includeQuotes)
 	{
 		str.replace("\\", "\\\\");
@@ -27,6 +27,8 @@
 #define UTILS_H
 
 #include <QVector>
+#include <QStringList>
+#include <QByteArray>
 #include <type_traits>
 
 #include "data/types/types.h"
@@ -55,6 +57,34 @@ namespace ysm
 		 */
 		static bool convertStringToFloatArray(const QString& s, QVector<float> &result);
 
+		// Memory utilities
+		/**
+		 * @brief Estimates the memory used by a value, including its heap allocated payload
+		 */
+		template<typename T>
+		static qint64 getMemorySize(const T& value) { Q_UNUSED(value); return sizeof(T); }
+
+		/**
+		 * @brief Estimates the memory used by a vector, including its reserved elements
+		 */
+		template<typename T>
+		static qint64 getMemorySize(const QVector<T>& value) { return sizeof(value) + value.capacity() * sizeof(T); }
+
+		/**
+		 * @brief Estimates the memory used by a string
+		 */
+		static qint64 getMemorySize(const QString& value);
+
+		/**
+		 * @brief Estimates the memory used by a string list
+		 */
+		static qint64 getMemorySize(const QStringList& value);
+
+		/**
+		 * @brief Estimates the memory used by a byte array
+		 */
+		static qint64 getMemorySize(const QByteArray& value);
+
 	private:
 		explicit Utils();	
 	};
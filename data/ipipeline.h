@@ -39,6 +39,7 @@ namespace ysm
 	class IPort;
 	class IConnection;
 	class IRenderCommand;
+	class IProperty;
 
 	/// @brief Interface for pipelines.
 	class IPipeline : public ISerializable, public IChangeable
@@ -166,6 +167,12 @@ namespace ysm
 		/// @brief Delete all render commands.
 		virtual void clearRenderCommands() = 0;
 
+		/**
+		 * @brief Retrieves all properties of the pipeline's items that have changed since their change flag was cleared.
+		 * @return List of changed properties, in the order they have been changed.
+		 */
+		virtual QVector<IProperty*> getChangedProperties() const = 0;
+
 	protected:
 
 		/// @brief Initialize new instance.
@@ -32,9 +32,13 @@
 #include "data/blocks/connectionlist.h"
 #include "data/rendercommands/rendercommand.h"
 #include "data/rendercommands/rendercommandlist.h"
+#include "data/properties/propertybase.h"
 #include "visitors/validatepipelinevisitor.h"
 #include "visitors/resetpipelinevisitor.h"
 
+#include <QPair>
+#include <algorithm>
+
 namespace ysm
 {
 	Pipeline::Pipeline(PipelineManager* manager) : _blocks{new BlockList{this}}, _renderCommands{new RenderCommandList{this}}, _manager{manager}
@@ -44,6 +48,9 @@ namespace ysm
 
 	Pipeline::~Pipeline()
 	{
+		// Deleted items don't need to be validated anymore
+		_isInvalidationLocked = true;
+
 		delete _blocks;
 		delete _renderCommands;
 	}
@@ -86,6 +93,94 @@ namespace ysm
 		return true;
 	}
 
+	void Pipeline::addToJournal(PropertyBase* property, bool isVolatile)
+	{
+		QHash<PropertyBase*, quint64>& journal = isVolatile ? _volatileProperties : _changedProperties;
+
+		// Keep the sequence of the first change
+		if (!journal.contains(property))
+			journal.insert(property, _journalSequence++);
+	}
+
+	void Pipeline::removeFromJournal(PropertyBase* property, bool keepVolatile)
+	{
+		_changedProperties.remove(property);
+
+		if (!keepVolatile)
+			_volatileProperties.remove(property);
+	}
+
+	void Pipeline::invalidateItem(IPipelineItem* item)
+	{
+		// Status updates of the validation itself (or deleting the pipeline) don't invalidate anything
+		if (_isInvalidationLocked || !item)
+			return;
+
+		auto invalidateBlockType = [this](BlockType type)
+		{
+			if (!_invalidatedBlockTypes.contains(type))
+				_invalidatedBlockTypes.append(type);
+		};
+
+		if (Block* block = dynamic_cast<Block*>(item))
+		{
+			_invalidatedBlocks.insert(block);
+
+			// The neighbours depend on the block's connections
+			for (IConnection* connection : block->getInConnections())
+				_invalidatedBlocks.insert(dynamic_cast<Block*>(connection->getSource()));
+
+			for (IConnection* connection : block->getOutConnections())
+				_invalidatedBlocks.insert(dynamic_cast<Block*>(connection->getDest()));
+
+			// Camera controls are checked for uniqueness
+			if (block->getType() == BlockType::CameraControl)
+				invalidateBlockType(BlockType::CameraControl);
+
+			// Code generators depend on the connection of the fragment tests to the display
+			if (block->getType() == BlockType::FragmentTests || block->getType() == BlockType::Display)
+				invalidateBlockType(BlockType::CodeGenerator);
+		}
+		else if (Port* port = dynamic_cast<Port*>(item))
+			_invalidatedBlocks.insert(port->getBlock());
+		else if (Connection* connection = dynamic_cast<Connection*>(item))
+		{
+			_invalidatedBlocks.insert(connection->getSource());
+			_invalidatedBlocks.insert(connection->getDest());
+
+			// Code generators depend on the connection of the fragment tests to the display
+			for (IBlock* block : {connection->getSource(), connection->getDest()})
+			{
+				if (block && (block->getType() == BlockType::FragmentTests || block->getType() == BlockType::Display))
+					invalidateBlockType(BlockType::CodeGenerator);
+			}
+		}
+		else if (RenderCommand* command = dynamic_cast<RenderCommand*>(item))
+		{
+			// The order and assignment of all commands is relevant for these blocks
+			invalidateBlockType(BlockType::VertexPuller);
+			invalidateBlockType(BlockType::Display);
+			invalidateBlockType(BlockType::FrameBufferObject);
+
+			if (command->getAssignedBlock())
+				_invalidatedBlocks.insert(command->getAssignedBlock());
+		}
+	}
+
+	bool Pipeline::isAttached(IPipelineItem* item) const
+	{
+		if (Block* block = dynamic_cast<Block*>(item))
+			return _blocks->contains(block);
+
+		if (Connection* connection = dynamic_cast<Connection*>(item))
+			return _blocks->contains(connection->getSource()) && connection->getSourcePort()->getConnectionList()->contains(connection);
+
+		if (RenderCommand* command = dynamic_cast<RenderCommand*>(item))
+			return _renderCommands->contains(command);
+
+		return false;
+	}
+
 	unsigned int Pipeline::getOpenGLVersion() const
 	{
 		return _openGLVersion;
@@ -102,9 +197,35 @@ namespace ysm
 
 	PipelineItemStatus Pipeline::validatePipeline()
 	{
-		ValidatePipelineVisitor visitor(this);
+		// After the first validation, only the invalidated blocks need to be verified again
+		QSet<Block*> blocks = _invalidatedBlocks;
+
+		for (BlockType type : _invalidatedBlockTypes)
+		{
+			for (Block* block : _blocks->findBlocks(type))
+				blocks.insert(block);
+		}
+
+		ValidatePipelineVisitor visitor(this, _isValidated ? &blocks : nullptr);
+
+		_isInvalidationLocked = true;
+
+		try
+		{
+			takeVisitor(&visitor);
+		}
+		catch (...)
+		{
+			_isInvalidationLocked = false;
+			throw;
+		}
+
+		_isInvalidationLocked = false;
+		_isValidated = true;
+
+		_invalidatedBlocks.clear();
+		_invalidatedBlockTypes.clear();
 
-		takeVisitor(&visitor);
 		return visitor.getStatus();
 	}
 
@@ -124,7 +245,15 @@ namespace ysm
 		if (type == BlockType::Undefined)
 			throw std::invalid_argument{"type may not be BlockType::Undefined"};
 
-		return _blocks->objects<IBlock>([type](const Block* block) { return block->getType() == type; });
+		// Use the block list's type buckets instead of testing all blocks
+		QVector<Block*> typeBlocks = _blocks->findBlocks(type);
+		QVector<IBlock*> blocks;
+		blocks.reserve(typeBlocks.size());
+
+		for (Block* block : typeBlocks)
+			blocks.append(block);
+
+		return blocks;
 	}
 
 	IBlock* Pipeline::addBlock(const BlockType type)
@@ -283,6 +412,38 @@ namespace ysm
 		_renderCommands->clear();
 	}
 
+	QVector<IProperty*> Pipeline::getChangedProperties() const
+	{
+		// Collect all journaled properties; a property might be both changed and volatile
+		QHash<PropertyBase*, quint64> candidates = _volatileProperties;
+
+		for (auto it = _changedProperties.cbegin(); it != _changedProperties.cend(); ++it)
+		{
+			if (!candidates.contains(it.key()) || candidates.value(it.key()) > it.value())
+				candidates.insert(it.key(), it.value());
+		}
+
+		// Sort the candidates by their journal sequence to keep the change order stable
+		QVector<QPair<quint64, PropertyBase*>> sequence;
+		sequence.reserve(candidates.size());
+
+		for (auto it = candidates.cbegin(); it != candidates.cend(); ++it)
+			sequence.append(qMakePair(it.value(), it.key()));
+
+		std::sort(sequence.begin(), sequence.end());
+
+		// Items that were removed from the pipeline keep their journal entries, as they might be restored later on
+		QVector<IProperty*> properties;
+
+		for (const auto& entry : sequence)
+		{
+			if (isAttached(entry.second->getOwner()) && entry.second->hasChanged())
+				properties.append(entry.second);
+		}
+
+		return properties;
+	}
+
 	void Pipeline::serialize(QDomElement* xmlElement, SerializationContext* ctx) const
 	{
 		xmlElement->setAttribute("openGLVersion", _openGLVersion);
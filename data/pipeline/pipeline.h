@@ -27,18 +27,23 @@
 #define PIPELINE_H
 
 #include <QObject>
+#include <QHash>
+#include <QSet>
 
 #include "data/ipipeline.h"
 #include "data/iversionable.h"
 
 namespace ysm
 {
+	class Block;
 	class Port;
 	class Connection;
 	class BlockList;
 	class RenderCommandList;
 	class PipelineVisitor;
 	class PipelineManager;
+	class PropertyBase;
+	class IPipelineItem;
 
 	/**
 	 * @brief Represents a pipeline
@@ -75,6 +80,25 @@ namespace ysm
 		 */
 		bool takeVisitor(PipelineVisitor* visitor);
 
+		// Change journal
+		/**
+		 * @brief Adds a property to the change journal
+		 * @param isVolatile If true, the property is kept until it is removed from the pipeline, since its changes are detected by a delegate
+		 */
+		void addToJournal(PropertyBase* property, bool isVolatile);
+
+		/**
+		 * @brief Removes a property from the change journal
+		 * @param keepVolatile If true, volatile properties are kept in the journal
+		 */
+		void removeFromJournal(PropertyBase* property, bool keepVolatile);
+
+		// Validation
+		/**
+		 * @brief Marks the blocks whose validation depends on the given item to be verified again by the next validation
+		 */
+		void invalidateItem(IPipelineItem* item);
+
 	public: // IPipeline
 		// General attributes
 		unsigned int getOpenGLVersion() const override;
@@ -104,6 +128,15 @@ namespace ysm
 		void deleteRenderCommand(const IRenderCommand* cmd, bool removeOnly = false) override;
 		void clearRenderCommands() override;
 
+		// Changes
+		QVector<IProperty*> getChangedProperties() const override;
+
+	private:
+		/**
+		 * @brief Checks if the given item is currently part of the pipeline
+		 */
+		bool isAttached(IPipelineItem* item) const;
+
 	public:
 		// ISerializable
 		void serialize(QDomElement* xmlElement, SerializationContext* ctx) const override;
@@ -116,6 +149,18 @@ namespace ysm
 		RenderCommandList* _renderCommands{nullptr};
 
 		PipelineManager* _manager{nullptr};
+
+		// Journaled properties, mapped to the sequence number of their journal entry
+		QHash<PropertyBase*, quint64> _changedProperties;
+		QHash<PropertyBase*, quint64> _volatileProperties;
+		quint64 _journalSequence{0};
+
+		// Blocks (and block types) that need to be verified again by the next validation
+		QSet<Block*> _invalidatedBlocks;
+		QList<BlockType> _invalidatedBlockTypes;
+
+		bool _isValidated{false};
+		bool _isInvalidationLocked{false};
 	};
 }
 
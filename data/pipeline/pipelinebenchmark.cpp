@@ -0,0 +1,143 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "pipelinebenchmark.h"
+#include "pipeline.h"
+#include "pipelinemanager.h"
+#include "pipelineprojectstream.h"
+
+#include "data/iblock.h"
+#include "data/ipipeline.h"
+
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTemporaryDir>
+
+#include <stdexcept>
+
+using namespace ysm;
+
+//Every unit chains a buffer, a vertex array, a vertex puller and a vertex shader, which also receives a uniform.
+const int blocksPerUnit = 5;
+const int connectionsPerUnit = 4;
+
+void PipelineBenchmark::run(const QVector<int>& blockCounts)
+{
+	//Store the projects in a directory removed afterwards.
+	QTemporaryDir directory;
+	if(!directory.isValid())
+		throw std::runtime_error("The temporary directory for the project files could not be created");
+
+	_results.clear();
+	for(int blockCount : blockCounts)
+		_results.append(measure(blockCount, directory.path() + "/benchmark.ysm"));
+}
+
+const QVector<PipelineBenchmark::Result>& PipelineBenchmark::getResults() const
+{ return _results; }
+
+QString PipelineBenchmark::getReport() const
+{
+	QString report = QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+			.arg("Blocks", 8)
+			.arg("Connections", 12)
+			.arg("Build [ms]", 12)
+			.arg("Validate [ms]", 14)
+			.arg("Store [ms]", 12)
+			.arg("Load [ms]", 12)
+			.arg("Delete [ms]", 12)
+			.arg("Total/Block [us]", 18);
+
+	for(const Result& result : _results)
+	{
+		qint64 total = result.buildTime + result.validateTime + result.storeTime + result.loadTime + result.deleteTime;
+		report += QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+				.arg(result.blockCount, 8)
+				.arg(result.connectionCount, 12)
+				.arg(result.buildTime / 1e6, 12, 'f', 3)
+				.arg(result.validateTime / 1e6, 14, 'f', 3)
+				.arg(result.storeTime / 1e6, 12, 'f', 3)
+				.arg(result.loadTime / 1e6, 12, 'f', 3)
+				.arg(result.deleteTime / 1e6, 12, 'f', 3)
+				.arg(total / 1e3 / qMax(result.blockCount, 1), 18, 'f', 3);
+	}
+
+	return report;
+}
+
+PipelineBenchmark::Result PipelineBenchmark::measure(int blockCount, const QString& filename) const
+{
+	Result result;
+	QElapsedTimer timer;
+	PipelineManager manager;
+	IPipeline* pipeline = manager.addPipeline();
+
+	//Build the pipeline.
+	int unitCount = qMax(1, blockCount / blocksPerUnit);
+	timer.start();
+	for(int i = 0; i < unitCount; ++i)
+	{
+		IBlock* buffer = pipeline->addBlock(BlockType::Buffer);
+		IBlock* vao = pipeline->addBlock(BlockType::VertexArrayObject);
+		IBlock* vertexPuller = pipeline->addBlock(BlockType::VertexPuller);
+		IBlock* vertexShader = pipeline->addBlock(BlockType::Shader_Vertex);
+		IBlock* elapsedTime = pipeline->addBlock(BlockType::Uniform_ElapsedTime);
+
+		pipeline->addConnection(buffer->getPort(PortType::Data_Out), vao->getPort(PortType::Data_In));
+		pipeline->addConnection(vao->getPort(PortType::GenericOut), vertexPuller->getPort(PortType::GenericIn));
+		pipeline->addConnection(vertexPuller->getPort(PortType::GenericOut), vertexShader->getPort(PortType::GenericIn));
+		pipeline->addConnection(elapsedTime->getPort(PortType::GenericOut), vertexShader->getPort(PortType::Shader_Uniform));
+	}
+	result.buildTime = timer.nsecsElapsed();
+	result.blockCount = unitCount * blocksPerUnit;
+	result.connectionCount = unitCount * connectionsPerUnit;
+
+	//Validate all blocks, as done before the first rendering.
+	timer.restart();
+	pipeline->validatePipeline();
+	result.validateTime = timer.nsecsElapsed();
+
+	//Store the project file.
+	QStringList messages;
+	timer.restart();
+	if(!PipelineProjectStream::storeProject(&manager, filename, messages))
+		throw std::runtime_error(QString("The pipeline could not be stored: %1").arg(messages.join(' ')).toStdString());
+	result.storeTime = timer.nsecsElapsed();
+
+	//Load the project into a new manager.
+	timer.restart();
+	IPipelineManager* loadedManager = PipelineProjectStream::loadProject(filename, messages);
+	if(!loadedManager)
+		throw std::runtime_error(QString("The pipeline could not be loaded: %1").arg(messages.join(' ')).toStdString());
+	result.loadTime = timer.nsecsElapsed();
+
+	//Delete the loaded pipeline.
+	timer.restart();
+	delete loadedManager;
+	result.deleteTime = timer.nsecsElapsed();
+
+	return result;
+}
@@ -0,0 +1,83 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef PIPELINEBENCHMARK_H
+#define PIPELINEBENCHMARK_H
+
+#include <QString>
+#include <QVector>
+
+namespace ysm
+{
+	//! \brief Measures how building, validating, storing and loading pipelines scales with their number of blocks.
+	class PipelineBenchmark
+	{
+	public:
+
+		//! \brief Timings of one pipeline in nanoseconds.
+		struct Result
+		{
+			int blockCount;				/*!< Number of blocks of the pipeline. */
+			int connectionCount;		/*!< Number of connections of the pipeline. */
+			qint64 buildTime;			/*!< Time spent adding the blocks and connections. */
+			qint64 validateTime;		/*!< Time spent validating the whole pipeline. */
+			qint64 storeTime;			/*!< Time spent storing the project file. */
+			qint64 loadTime;			/*!< Time spent loading the project file into a new manager. */
+			qint64 deleteTime;			/*!< Time spent deleting the loaded pipeline. */
+		};
+
+	public:
+
+		/*!
+		 * \brief Builds, validates, stores and loads a pipeline for every block count.
+		 * \param blockCounts The block counts, rounded down to whole units of connected blocks.
+		 * \throws std::runtime_error If a pipeline could not be stored or loaded.
+		 */
+		void run(const QVector<int>& blockCounts);
+
+		//! \brief Gets the timings of all pipelines.
+		const QVector<Result>& getResults() const;
+
+		//! \brief Gets a table of the timings, including the time per block.
+		QString getReport() const;
+
+	private:
+
+		/*!
+		 * \brief Measures a single pipeline.
+		 * \param blockCount The number of blocks.
+		 * \param filename The project file to store the pipeline into.
+		 */
+		Result measure(int blockCount, const QString& filename) const;
+
+	private:
+
+		//! \brief The timings of all pipelines.
+		QVector<Result> _results;
+	};
+}
+
+#endif
@@ -241,6 +241,10 @@ namespace ysm
 	template<typename T>
 	void PipelineItem<T>::setStatus(const PipelineItemStatus status, const QString& msg)
 	{
+		// Statuses set from outside the validation need to be verified again
+		if (_status != status && _pipeline)
+			_pipeline->invalidateItem(this);
+
 		_status = status;
 
 		if (_status == PipelineItemStatus::Healthy)
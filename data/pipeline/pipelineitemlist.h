@@ -27,6 +27,7 @@
 #define PIPELINEITEMLIST_H
 
 #include "pipelinemanager.h"
+#include "pipeline.h"
 #include "data/common/objectvector.h"
 #include "data/common/dataexceptions.h"
 
@@ -54,6 +55,10 @@ namespace ysm
 		void append(const T* item) override;
 		void insert(const int i, const T* item) override;
 
+		using ObjectVector<T>::remove;
+		void remove(const int i, bool deleteObj = true) override;
+		void clear() override;
+
 	protected:
 		Pipeline* _pipeline{nullptr};
 	};
@@ -86,6 +91,8 @@ namespace ysm
 		}
 
 		ObjectVector<T>::append(item);
+
+		_pipeline->invalidateItem(itemNC);
 	}
 
 	template<typename T>
@@ -101,6 +108,26 @@ namespace ysm
 		}
 
 		ObjectVector<T>::insert(i, item);
+
+		_pipeline->invalidateItem(itemNC);
+	}
+
+	template<typename T>
+	void PipelineItemList<T>::remove(const int i, bool deleteObj)
+	{
+		// Invalidate before the item might get deleted
+		_pipeline->invalidateItem(ObjectVector<T>::at(i));
+
+		ObjectVector<T>::remove(i, deleteObj);
+	}
+
+	template<typename T>
+	void PipelineItemList<T>::clear()
+	{
+		for (auto it = ObjectVector<T>::cbegin(); it != ObjectVector<T>::cend(); ++it)
+			_pipeline->invalidateItem(*it);
+
+		ObjectVector<T>::clear();
 	}
 }
 
@@ -32,6 +32,12 @@
 #include "data/blocks/connection.h"
 #include "data/rendercommands/rendercommand.h"
 #include "data/rendercommands/rendercommandlist.h"
+#include "data/blocks/datasourceblock.h"
+#include "data/cache/cacheableobject.h"
+
+#include <QTimer>
+#include <QQueue>
+#include <QSet>
 
 using namespace ysm;
 
@@ -131,7 +137,8 @@ void PipelineManager::deletePipeline(const IPipeline* pipeline)
 
 void PipelineManager::reset()
 {
-	//Cleanup cache.
+	//Drop pending prefetches and cleanup cache.
+	_prefetchQueue.clear();
 	_cachePool.clearCache();
 
 	//Remove all pipelines.
@@ -158,6 +165,106 @@ void PipelineManager::deserialize(const QDomElement* root, SerializationContext*
 	if(element.isNull())
 		throw SerializationException("The serialization data doesn't contain any pipelines");
 
-	//Deserialize the content.
-	_pipelines->deserialize(&element, context);
+	//Deserialize the content without loading any data source payloads; these are materialized on first access.
+	_deferDataLoads = true;
+
+	try
+	{
+		_pipelines->deserialize(&element, context);
+	}
+	catch(...)
+	{
+		_deferDataLoads = false;
+		throw;
+	}
+
+	_deferDataLoads = false;
+
+	//Load the payloads in the background once the project is shown.
+	prefetchDataSources();
+}
+
+bool PipelineManager::isDeferringDataLoads() const { return _deferDataLoads; }
+
+void PipelineManager::prefetchDataSources()
+{
+	QQueue<IBlock*> pending;
+	QSet<IBlock*> visited;
+	QList<IBlock*> ordered;
+
+	//Seed with all visible displays and the blocks their pipeline's render commands operate on.
+	for(Pipeline* pipeline : *_pipelines)
+	{
+		bool isVisible = false;
+		for(IBlock* block : pipeline->getBlocks(BlockType::Display))
+		{
+			if(block->getProperty<BoolProperty>(PropertyID::Display_Visible)->getValue())
+			{
+				pending.enqueue(block);
+				isVisible = true;
+			}
+		}
+
+		if(isVisible)
+		{
+			for(IRenderCommand* command : pipeline->getRenderCommands())
+				if(command->getAssignedBlock())
+					pending.enqueue(command->getAssignedBlock());
+		}
+	}
+
+	//Walk upstream breadth-first, so that the sources closest to a visible display come first.
+	while(!pending.isEmpty())
+	{
+		IBlock* block = pending.dequeue();
+		if(visited.contains(block))
+			continue;
+
+		visited.insert(block);
+		ordered.append(block);
+
+		for(IConnection* connection : block->getInConnections())
+			pending.enqueue(connection->getSource());
+	}
+
+	//Everything else follows in pipeline order.
+	for(Pipeline* pipeline : *_pipelines)
+		for(IBlock* block : pipeline->getBlocks())
+			if(!visited.contains(block))
+				ordered.append(block);
+
+	//Queue the blocks that own a cacheable payload.
+	bool wasIdle = _prefetchQueue.isEmpty();
+	_prefetchQueue.clear();
+
+	for(IBlock* block : ordered)
+		if(dynamic_cast<DataSourceBlock*>(block) || dynamic_cast<CacheableObject*>(block))
+			_prefetchQueue.append(block->getID());
+
+	if(wasIdle && !_prefetchQueue.isEmpty())
+		QTimer::singleShot(0, this, SLOT(prefetchNextDataSource()));
+}
+
+void PipelineManager::prefetchNextDataSource()
+{
+	if(_prefetchQueue.isEmpty())
+		return;
+
+	//The block might have been deleted in the meantime.
+	Block* block = findGlobalBlock(_prefetchQueue.takeFirst());
+
+	if(block && block->getPipeline()->getManager() == this)
+	{
+		CacheableObject* cacheable = dynamic_cast<CacheableObject*>(block);
+		if(DataSourceBlock* dataSourceBlock = dynamic_cast<DataSourceBlock*>(block))
+			cacheable = dataSourceBlock->getDataSource();
+
+		//Accessing the cache materializes the payload if it's not cached yet.
+		if(cacheable)
+			cacheable->prefetchCacheData();
+	}
+
+	//Yield to the event loop between two blocks.
+	if(!_prefetchQueue.isEmpty())
+		QTimer::singleShot(0, this, SLOT(prefetchNextDataSource()));
 }
@@ -189,6 +189,26 @@ namespace ysm
 		 */
 		void deserialize(const QDomElement* root, SerializationContext* context) override;
 
+	public:
+
+		/**
+		 * @brief Checks whether data sources currently defer loading their payloads.
+		 * This is the case while a project is being deserialized; payloads are then materialized on first access.
+		 * @return True, if loading is deferred.
+		 */
+		bool isDeferringDataLoads() const;
+
+		/**
+		 * @brief Queues all data source blocks for loading their payloads in the background.
+		 * Blocks reachable from visible display blocks are loaded first, one block per event loop iteration.
+		 */
+		void prefetchDataSources();
+
+	private slots:
+
+		/// @brief Loads the payload of the next queued data source block.
+		void prefetchNextDataSource();
+
 	private:
 
 		/// @brief List of all pipelines.
@@ -200,6 +220,12 @@ namespace ysm
 		/// @brief Cache pool holding cache data.
 		CachePool _cachePool;
 
+		/// @brief True while data sources must not load their payloads immediately.
+		bool _deferDataLoads{false};
+
+		/// @brief Identifiers of the blocks waiting to be prefetched, in priority order.
+		QList<PipelineItemID> _prefetchQueue;
+
 	private:
 
 		/// @brief The currently highest item identifier.
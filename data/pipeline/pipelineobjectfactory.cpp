@@ -55,6 +55,10 @@
 #include "data/blocks/textureloaderblock.h"
 #include "data/blocks/cameracontrolblock.h"
 #include "data/blocks/arraydatasourceblock.h"
+#include "data/blocks/readbackdatasourceblock.h"
+#include "data/blocks/meshoptimizerblock.h"
+#include "data/blocks/parallelprimitiveblock.h"
+#include "data/blocks/meshlodblock.h"
 #include "data/blocks/uniforms/doubleuniformblock.h"
 #include "data/blocks/uniforms/floatuniformblock.h"
 #include "data/blocks/uniforms/intuniformblock.h"
@@ -292,6 +296,10 @@ namespace ysm
 		REGISTER_BLOCK_TYPE(ModelLoaderBlock);
 		REGISTER_BLOCK_TYPE(TextureLoaderBlock);
 		REGISTER_BLOCK_TYPE(ArrayDataSourceBlock);
+		REGISTER_BLOCK_TYPE(ReadbackDataSourceBlock);
+		REGISTER_BLOCK_TYPE(MeshOptimizerBlock);
+		REGISTER_BLOCK_TYPE(ParallelPrimitiveBlock);
+		REGISTER_BLOCK_TYPE(MeshLODBlock);
 
 		// Fixed function blocks
 		REGISTER_BLOCK_TYPE(RasterizationBlock);
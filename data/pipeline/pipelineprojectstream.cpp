@@ -37,8 +37,8 @@
 
 #include <QIODevice>
 #include <QFileInfo>
-#include <QTemporaryDir>
 #include <QXmlStreamReader>
+#include <QSet>
 
 using namespace ysm;
 
@@ -56,9 +56,11 @@ IPipelineManager* PipelineProjectStream::loadProject(QString filename, QStringLi
 		unknownFile.read(&identifierBytes[0], 2);
 		unknownFile.close();
 
-		//Extract zip archives.
-		if(identifierBytes[0] == 'P' && identifierBytes[1] == 'K')
-			if(!extractArchive(filename, messages))
+		//Zip archives contain the project file, which is read directly from the archive.
+		QByteArray projectData;
+		bool isArchive = (identifierBytes[0] == 'P' && identifierBytes[1] == 'K');
+		if(isArchive)
+			if(!extractArchive(filename, projectData, messages))
 			{
 				messages << "Unable to extract project archive.";
 				return NULL;
@@ -68,14 +70,17 @@ IPipelineManager* PipelineProjectStream::loadProject(QString filename, QStringLi
 		QFile sourceFile(filename);
 		QFileInfo sourceInfo(sourceFile);
 
-		//Open the new project file.
-		if(sourceFile.open(QIODevice::ReadOnly | QIODevice::Text))
+		//Open the new project file, unless it was read from the archive.
+		if(isArchive || sourceFile.open(QIODevice::ReadOnly | QIODevice::Text))
 		{
+			if(!isArchive)
+				projectData = sourceFile.readAll();
+
 			//Try to create the XML document.
 			int errorLine;
 			QString errorMessage;
 			QDomDocument xmlDocument;
-			if(!xmlDocument.setContent(&sourceFile, &errorMessage, &errorLine))
+			if(!xmlDocument.setContent(projectData, &errorMessage, &errorLine))
 			{
 				messages << "Unable to parse project file: " + sourceFile.fileName();
 				messages << QString("Error in line (%1): %2").arg(errorLine).arg(errorMessage);
@@ -128,6 +133,31 @@ bool PipelineProjectStream::storeProject(IPipelineManager *source, QString filen
 	//Export the assets.
 	if(exportAssets) storeAssets(source, filename, messages);
 
+	//Serialize the project.
+	QString projectData;
+	if(!serializeProject(source, filename, projectData, messages, exportAssets, additionalObjects))
+		return false;
+
+	//Create the project file.
+	QFile targetFile(filename);
+	if(!targetFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+	{
+		messages << "Could not create project file.";
+		return false;
+	}
+
+	//Write to project file.
+	QTextStream outputStream(&targetFile);
+	outputStream << projectData;
+
+	//Successfully stored.
+	return true;
+}
+
+bool PipelineProjectStream::serializeProject(IPipelineManager* source, QString filename, QString& projectData,
+											 QStringList& messages, bool exportAssets,
+											 QList<ISerializable*>* additionalObjects)
+{
 	//Create the basic XML document and root element.
 	QDomDocument xmlDocument;
 	QDomElement rootElement = xmlDocument.createElement("YSMProject");
@@ -157,17 +187,8 @@ bool PipelineProjectStream::storeProject(IPipelineManager *source, QString filen
 		//Retrieve context messages.
 		messages << context.getMessages();
 
-		//Create the project file.
-		QFile targetFile(filename);
-		if(!targetFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
-		{
-			messages << "Could not create project file.";
-			return false;
-		}
-
-		//Write to project file.
-		QTextStream outputStream(&targetFile);
-		outputStream << xmlDocument.toString(4);
+		//Create the XML representation.
+		projectData = xmlDocument.toString(4);
 	}
 
 	//Handle possible errors.
@@ -177,7 +198,7 @@ bool PipelineProjectStream::storeProject(IPipelineManager *source, QString filen
 		return false;
 	}
 
-	//Successfully stored.
+	//Successfully serialized.
 	return true;
 }
 
@@ -188,17 +209,15 @@ bool PipelineProjectStream::compressProject(IPipelineManager *source, QString fi
 	ZipArchive zipArchive;
 	QFileInfo fileInfo(filename);
 
-	//Create a temporary directory to store the data.
-	QTemporaryDir temporaryDirectory(QDir::temp().absoluteFilePath("YSMProject"));
-	QString temporaryPath = temporaryDirectory.path();
-
-	//Adjust the target to be inside the temporary folder and set the correct extension (which is *.zip otherwise).
-	QFileInfo temporaryInfo(temporaryPath, fileInfo.fileName());
-	QString temporaryFilename = temporaryInfo.absoluteFilePath();
-	temporaryFilename.replace(fileInfo.completeSuffix(), "ysm");
+	//The project file inside the archive has the correct extension (which is *.zip otherwise).
+	QString projectFilename = fileInfo.absoluteFilePath();
+	projectFilename.replace(fileInfo.completeSuffix(), "ysm");
+	QString assetsDirectory = getAssetsDirectory(projectFilename).dirName();
 
-	//Store the project to the temporary path.
-	storeProject(source, temporaryFilename, messages, true, additionalObjects);
+	//Serialize the project, pointing all paths into the assets directory.
+	QString projectData;
+	if(!serializeProject(source, projectFilename, projectData, messages, true, additionalObjects))
+		return false;
 
 	//Try to open the archive.
 	if(!zipArchive.openZip(filename, ZipArchive::ModePack))
@@ -207,19 +226,27 @@ bool PipelineProjectStream::compressProject(IPipelineManager *source, QString fi
 		return false;
 	}
 
-	//Compress the data.
-	if(!zipArchive.addDirectory(temporaryPath))
+	//Write the project file straight from memory.
+	if(!zipArchive.addData(projectData.toUtf8(), QFileInfo(projectFilename).fileName()))
 	{
 		messages << "Unable to add files to target archive.";
 		return false;
 	}
 
+	//Stream the assets from their source location.
+	foreach(QString assetFile, getAssetFiles(source))
+		if(!zipArchive.addFile(assetFile, assetsDirectory))
+		{
+			messages << QString("The asset '%1' could not be added to the archive").arg(assetFile);
+			return false;
+		}
+
 	//Close and create the archive.
 	zipArchive.closeZip();
 	return true;
 }
 
-bool PipelineProjectStream::extractArchive(QString& filename, QStringList& messages)
+bool PipelineProjectStream::extractArchive(QString& filename, QByteArray& projectData, QStringList& messages)
 {
 	//Get archive data.
 	ZipArchive zipArchive;
@@ -232,15 +259,24 @@ bool PipelineProjectStream::extractArchive(QString& filename, QStringList& messa
 		return false;
 	}
 
-	//Extract the archive.
-	if(!zipArchive.unpackContents(fileInfo.dir().absolutePath()))
+	//Adjust file name to operate on *.ysm from now on.
+	filename.replace(fileInfo.completeSuffix(), "ysm");
+	QString projectName = QFileInfo(filename).fileName();
+
+	//Read the project file directly from the archive.
+	if(!zipArchive.readFile(projectName, projectData))
+	{
+		messages << "Zip archive does not contain a project file.";
+		return false;
+	}
+
+	//Extract the assets only.
+	if(!zipArchive.unpackContents(fileInfo.dir().absolutePath(), QStringList() << projectName))
 	{
 		messages << "Zip archive could not be extracted.";
 		return false;
 	}
 
-	//Adjust file name to operate on *.ysm from now on.
-	filename.replace(fileInfo.completeSuffix(), "ysm");
 	return true;
 }
 
@@ -319,24 +355,14 @@ QDir PipelineProjectStream::getAssetsDirectory(QString filename)
 
 bool PipelineProjectStream::storeAssets(IPipelineManager* source, QString filename, QStringList& messages)
 {
-	//Concrete pipeline manager is required to use visitors.
-	PipelineManager* projectManager = static_cast<PipelineManager*>(source);
-
 	//Create assets directory.
 	QDir assetsDirectory = getAssetsDirectory(filename);
 	assetsDirectory.mkpath(".");
 
-	//Use a visitor to find all assets in the pipeline.
-	AssetsPipelineVisitor visitor;
-	projectManager->takeVisitor(&visitor);
-
-	//Iterate over all retrieved files and store them.
-	QStringList assetFileList = visitor.getAssetFiles();
+	//Iterate over all assets in the pipeline and store them.
+	QStringList assetFileList = getAssetFiles(source);
 	foreach(QString assetFile, assetFileList)
 	{
-		//Validate the file.
-		if(assetFile.trimmed().isEmpty()) continue;
-
 		//Try to copy the file to the target directory.
 		if(!copyAsset(assetFile, assetsDirectory))
 		{
@@ -352,6 +378,30 @@ bool PipelineProjectStream::storeAssets(IPipelineManager* source, QString filena
 	return true;
 }
 
+QStringList PipelineProjectStream::getAssetFiles(IPipelineManager* source)
+{
+	//Concrete pipeline manager is required to use visitors.
+	PipelineManager* projectManager = static_cast<PipelineManager*>(source);
+
+	//Use a visitor to find all assets in the pipeline.
+	AssetsPipelineVisitor visitor;
+	projectManager->takeVisitor(&visitor);
+
+	//Skip invalid files and files with the same name, as they would be stored to the same asset.
+	QStringList assetFiles;
+	QSet<QString> assetNames;
+	foreach(QString assetFile, visitor.getAssetFiles())
+	{
+		QString assetName = QFileInfo(assetFile).fileName();
+		if(assetFile.trimmed().isEmpty() || assetNames.contains(assetName)) continue;
+
+		assetNames.insert(assetName);
+		assetFiles << assetFile;
+	}
+
+	return assetFiles;
+}
+
 bool PipelineProjectStream::copyAsset(const QString& sourceAsset, const QDir& directory)
 {
 	//Build the asset's target path.
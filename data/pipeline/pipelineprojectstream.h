@@ -84,6 +84,19 @@ namespace ysm
 
 	private:
 
+		/*!
+		 * \brief Serializes an existing pipeline manager to XML.
+		 * \param source The pipeline to store.
+		 * \param filename The target file, used to adjust the paths.
+		 * \param projectData Returns the project's XML representation.
+		 * \param messages Returns messages that might have occured during saving.
+		 * \param exportAssets True, if the paths should point into the assets directory.
+		 * \param additionalObjects Additional serializable data.
+		 * \return True on success.
+		 */
+		static bool serializeProject(IPipelineManager* source, QString filename, QString& projectData, QStringList& messages,
+									 bool exportAssets, QList<ISerializable*>* additionalObjects);
+
 		/*!
 		 * \brief Loads the additional serializable data.
 		 * \param root The root XML element.
@@ -125,6 +138,13 @@ namespace ysm
 		 */
 		static bool storeAssets(IPipelineManager *source, QString filename, QStringList& messages);
 
+		/*!
+		 * \brief Retrieve all asset files used by the project.
+		 * \param source The pipeline.
+		 * \return The asset files, which have unique file names.
+		 */
+		static QStringList getAssetFiles(IPipelineManager* source);
+
 		/*!
 		 * \brief Store a single project asset.
 		 * \param sourceAsset The asset.
@@ -134,12 +154,13 @@ namespace ysm
 		static bool copyAsset(const QString& sourceAsset, const QDir& directory);
 
 		/*!
-		 * \brief Extract an archive that holds a project.
+		 * \brief Extract an archive that holds a project. Only the assets are written to disk.
 		 * \param filename The archive's filename, which is replaced by the project's filename.
+		 * \param projectData Returns the project file's contents, which are read directly from the archive.
 		 * \param messages Possible error messages.
 		 * \return True on success.
 		 */
-		static bool extractArchive(QString& filename, QStringList& messages);
+		static bool extractArchive(QString& filename, QByteArray& projectData, QStringList& messages);
 	};
 }
 
@@ -36,7 +36,8 @@ namespace ysm
 
 	bool ResetPipelineVisitor::blockVisited(Block* block)
 	{
-		if(!block->isOverridingStatus())
+		// Healthy items are skipped, so they don't need to be validated again
+		if(!block->isOverridingStatus() && block->getStatus() != PipelineItemStatus::Healthy)
 			block->setStatus(PipelineItemStatus::Healthy);
 
 		return true;
@@ -44,7 +45,7 @@ namespace ysm
 
 	bool ResetPipelineVisitor::renderCommandVisited(RenderCommand* command)
 	{
-		if(!command->isOverridingStatus())
+		if(!command->isOverridingStatus() && command->getStatus() != PipelineItemStatus::Healthy)
 			command->setStatus(PipelineItemStatus::Healthy);
 
 		return true;
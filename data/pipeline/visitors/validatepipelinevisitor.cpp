@@ -56,10 +56,24 @@
 
 namespace ysm
 {
-	ValidatePipelineVisitor::ValidatePipelineVisitor(Pipeline* pipeline) : _pipeline{pipeline}
+	ValidatePipelineVisitor::ValidatePipelineVisitor(Pipeline* pipeline, const QSet<Block*>* blocks) : _pipeline{pipeline}, _blocks{blocks}
 	{
 		if (!pipeline)
 			throw std::invalid_argument{"pipeline may not be null"};
+
+		// Index the render commands by their assigned blocks, so that blocks don't need to search all of them
+		QVector<IRenderCommand*> commands = _pipeline->getRenderCommands();
+
+		for (IRenderCommand* command : commands)
+		{
+			if (command->getAssignedBlock())
+				_assignedCommands.insert(command->getAssignedBlock(), command);
+		}
+
+		if (!commands.isEmpty())
+			_lastCommand = commands.last();
+
+		_cameraControlCount = _pipeline->getBlocks(BlockType::CameraControl).size();
 	}
 
 	PipelineItemStatus ValidatePipelineVisitor::getStatus() const
@@ -69,6 +83,13 @@ namespace ysm
 
 	bool ValidatePipelineVisitor::blockVisited(Block* block)
 	{
+		// Blocks that don't need to be verified again keep their status
+		if (_blocks && !_blocks->contains(block))
+		{
+			updateStatus(block);
+			return true;
+		}
+
 		switch (block->getType())
 		{
 		case BlockType::Mixer:
@@ -172,7 +193,7 @@ namespace ysm
 		if(!block)
 			throw std::bad_cast{};
 
-		if( _pipeline->getBlocks(BlockType::CameraControl).size() > 1)
+		if(_cameraControlCount > 1)
 			block->setStatus(PipelineItemStatus::Sick, "There must not exist more than one Camera Control Block per pipeline");
 		else if(block->getGenericOutPort()->getConnectionCount() == 0)
 			block->setStatus(PipelineItemStatus::Chilled, "This block is orphaned");
@@ -228,9 +249,9 @@ namespace ysm
 
 		bool foundCommand = false;
 		unsigned int needIBO = 0;
-		for(IRenderCommand* command : _pipeline->getRenderCommands())
+		for(IRenderCommand* command : _assignedCommands.values(block))
 		{
-			if( command->getCommand() == RenderCommandType::Draw && command->getAssignedBlock() == block)
+			if(command->getCommand() == RenderCommandType::Draw)
 			{
 				foundCommand = true;
 
@@ -279,17 +300,13 @@ namespace ysm
 
 		if (block->getGenericInPort()->getConnectionCount() == 0)
 			block->setStatus(PipelineItemStatus::Chilled, "This Block is orphaned");
-		else
-			for(IRenderCommand* command : _pipeline->getRenderCommands())
-			{
-				if(	command->getCommand() == RenderCommandType::Clear &&
-					command->getAssignedBlock() == block &&
-					_pipeline->getRenderCommands().last() == command)
-				{
-					block->setStatus(PipelineItemStatus::Chilled, "the assigned clear command is the last command in the execution order");
-					return;
-				}
-			}
+		else if(_lastCommand &&
+				_lastCommand->getCommand() == RenderCommandType::Clear &&
+				_lastCommand->getAssignedBlock() == block)
+		{
+			block->setStatus(PipelineItemStatus::Chilled, "the assigned clear command is the last command in the execution order");
+			return;
+		}
 
 		// In case we reach this statement, everything is ok
 		block->setStatus(PipelineItemStatus::Healthy);
@@ -349,17 +366,13 @@ namespace ysm
 			block->setStatus(PipelineItemStatus::Sick, "A FBO block needs to be connected to at least one Fragment Tests block");
 		else if(block->getGenericInPort()->getConnectionCount() > 1)
 			block->setStatus(PipelineItemStatus::Chilled, "Connecting multiple passes to a FBO  a beta feature and not verified completly. Stay cautious.");
-		else
-			for(IRenderCommand* command : _pipeline->getRenderCommands())
-			{
-				if(	command->getCommand() == RenderCommandType::Clear &&
-					command->getAssignedBlock() == block &&
-					_pipeline->getRenderCommands().last() == command)
-				{
-					block->setStatus(PipelineItemStatus::Chilled, "the assigned clear command is the last command in the execution order");
-					return;
-				}
-			}
+		else if(_lastCommand &&
+				_lastCommand->getCommand() == RenderCommandType::Clear &&
+				_lastCommand->getAssignedBlock() == block)
+		{
+			block->setStatus(PipelineItemStatus::Chilled, "the assigned clear command is the last command in the execution order");
+			return;
+		}
 
 		// In case we reach this statement, everything is ok
 		block->setStatus(PipelineItemStatus::Healthy);
@@ -497,8 +510,17 @@ namespace ysm
 			block->setStatus(PipelineItemStatus::Sick, "A code generator block must be connected to a fragment tests block");
 		else if (block->getGenericInPort()->getConnectionCount() > 1)
 			block->setStatus(PipelineItemStatus::Sick, "A code generator block may only have a single connection");
+		else if (block->getOutFile()->getValue().isEmpty())
+			block->setStatus(PipelineItemStatus::Chilled, "No output file has been chosen");
 		else
-			block->setStatus(PipelineItemStatus::Healthy);
+		{
+			// The code is generated from the frame rendered into a display
+			Connection* connection = dynamic_cast<Connection*>(block->getGenericInPort()->getInConnections().first());
+			if (!connection || !connection->getSourcePort()->isConnectedTo(BlockType::Display, PortType::GenericIn))
+				block->setStatus(PipelineItemStatus::Chilled, "Code is only generated, if the fragment tests block is connected to a display");
+			else
+				block->setStatus(PipelineItemStatus::Healthy);
+		}
 	}
 
 	void ValidatePipelineVisitor::verifyBlockGroup_FixedFunction(IBlock* block)
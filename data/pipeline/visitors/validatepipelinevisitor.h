@@ -29,10 +29,14 @@
 #include "pipelinevisitor.h"
 #include "data/pipeline/pipelineitemstatus.h"
 
+#include <QMultiHash>
+#include <QSet>
+
 namespace ysm
 {
 	class IBlock;
 	class IPipelineItem;
+	class IRenderCommand;
 	class MixerBlock;
 	class BufferBlock;
 	class VertexPullerBlock;
@@ -58,7 +62,10 @@ namespace ysm
 	{
 	public:
 		// Construction
-		explicit ValidatePipelineVisitor(Pipeline* pipeline);
+		/**
+		 * @param blocks The blocks to verify; if null, all blocks are verified. Other items only contribute their current status.
+		 */
+		explicit ValidatePipelineVisitor(Pipeline* pipeline, const QSet<Block*>* blocks = nullptr);
 
 	public:
 		/**
@@ -104,8 +111,15 @@ namespace ysm
 
 	private:
 		Pipeline* _pipeline{nullptr};
+		const QSet<Block*>* _blocks{nullptr};
 
 		PipelineItemStatus _status{PipelineItemStatus::Healthy};
+
+		// Render command lookups, built once per validation
+		QMultiHash<const IBlock*, IRenderCommand*> _assignedCommands;
+		IRenderCommand* _lastCommand{nullptr};
+
+		int _cameraControlCount{0};
 	};
 }
 
@@ -32,6 +32,16 @@ namespace ysm
 
 	}
 
+	void FilenameProperty::setOutput(bool output)
+	{
+		_output = output;
+	}
+
+	bool FilenameProperty::isOutput() const
+	{
+		return _output;
+	}
+
 	void FilenameProperty::serialize(QDomElement* xmlElement, SerializationContext* ctx) const
 	{
 		// Serialization needs to be adjusted to support assets.
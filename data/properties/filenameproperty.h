@@ -39,9 +39,23 @@ namespace ysm
 		// Construction
 		explicit FilenameProperty(const PropertyID id, const QString& name = "", bool isReadOnly = false);
 
+	public:
+		/**
+		 * @brief Sets whether the file is written rather than read, so that it may not exist yet
+		 */
+		void setOutput(bool output);
+
+		/**
+		 * @brief Returns whether the file is written rather than read
+		 */
+		bool isOutput() const;
+
 	public: // ISerializable
 		void serialize(QDomElement* xmlElement, SerializationContext* ctx) const override;
 		void deserialize(const QDomElement* xmlElement, SerializationContext* ctx) override;
+
+	private:
+		bool _output{false};
 	};
 }
 
@@ -65,6 +65,12 @@ namespace ysm
 		 */
 		ITraceableValue* cloneValue() const override;
 
+		/**
+		 * @brief Estimates the memory used by this value.
+		 * @return The value's size in bytes.
+		 */
+		qint64 getValueSize() const override;
+
 		/**
 		 * @brief Gets the represented value.
 		 * @return The represented value.
@@ -191,6 +197,9 @@ namespace ysm
 		void clearChanged() override;
 		ITraceableValue* getUnchangedValue() const override;
 
+	protected: // PropertyBase
+		bool hasChangeDelegate() const override;
+
 	public: // ISerializable
 		inline void serialize(QDomElement* xmlElement, SerializationContext* ctx) const override;
 		inline void deserialize(const QDomElement* xmlElement, SerializationContext* ctx) override;
@@ -239,6 +248,12 @@ namespace ysm
 		return new PropertyValue<T>(_value);
 	}
 
+	template<typename T>
+	qint64 PropertyValue<T>::getValueSize() const
+	{
+		return Utils::getMemorySize(_value);
+	}
+
 	template<typename T>
 	T PropertyValue<T>::getValue() const
 	{
@@ -293,9 +308,16 @@ namespace ysm
 	template<typename T, PropertyType P>
 	void Property<T,P>::valueChanging()
 	{
+		// Any change might affect the owner's validation
+		if(_isInitialized)
+			invalidateOwner();
+
 		// Do not overwrite value until changedValue() is called
 		if(!_unchangedValue && _isInitialized)
+		{
 			_unchangedValue = toTraceableValue();
+			journalChange();
+		}
 	}
 
 	template<typename T, PropertyType P>
@@ -315,6 +337,10 @@ namespace ysm
 		_getValueDelegate = getter;
 		_setValueDelegate = setter;
 		_hasChangedDelegate = change;
+
+		// Changes are only detected by the delegate, so the property needs to be checked every time
+		if (_hasChangedDelegate)
+			journalVolatile();
 	}
 
 	template<typename T, PropertyType P>
@@ -354,6 +380,13 @@ namespace ysm
 	template<typename T, PropertyType P>
 	void Property<T,P>::setReadOnly(const bool readOnly)
 	{
+		// Read only changes are traced as well
+		if (_isReadOnly != readOnly)
+		{
+			journalChange();
+			invalidateOwner();
+		}
+
 		_isReadOnly = readOnly;
 	}
 
@@ -418,6 +451,12 @@ namespace ysm
 		return false;
 	}
 
+	template<typename T, PropertyType P>
+	bool Property<T,P>::hasChangeDelegate() const
+	{
+		return static_cast<bool>(_hasChangedDelegate);
+	}
+
 	template<typename T, PropertyType P>
 	bool Property<T,P>::hasChanged() const
 	{
@@ -444,6 +483,8 @@ namespace ysm
 		delete _unchangedValue;
 		_unchangedValue = nullptr;
 		_wasReadOnly = _isReadOnly;
+
+		journalClear();
 	}
 
 	template<typename T, PropertyType P>
@@ -26,6 +26,7 @@
 #include "propertybase.h"
 #include "data/ipipelineitem.h"
 #include "data/ipipeline.h"
+#include "data/pipeline/pipeline.h"
 
 namespace ysm
 {
@@ -34,6 +35,36 @@ namespace ysm
 
 	}
 
+	PropertyBase::~PropertyBase()
+	{
+		if (_pipeline)
+			_pipeline->removeFromJournal(this, false);
+	}
+
+	void PropertyBase::journalChange()
+	{
+		if (_pipeline)
+			_pipeline->addToJournal(this, false);
+	}
+
+	void PropertyBase::journalVolatile()
+	{
+		if (_pipeline)
+			_pipeline->addToJournal(this, true);
+	}
+
+	void PropertyBase::journalClear()
+	{
+		if (_pipeline)
+			_pipeline->removeFromJournal(this, true);
+	}
+
+	void PropertyBase::invalidateOwner()
+	{
+		if (_pipeline)
+			_pipeline->invalidateItem(_owner);
+	}
+
 	IPipelineItem* PropertyBase::getOwner() const
 	{
 		return _owner;
@@ -34,6 +34,7 @@ namespace ysm
 {
 	class IPipelineItem;
 	class IPipelineItemPrivate;
+	class Pipeline;
 
 	/**
 	 * @brief Base class for properties (never used directly)
@@ -78,12 +79,43 @@ namespace ysm
 
 	protected:
 		explicit PropertyBase();
+		virtual ~PropertyBase();
+
+	protected:
+		// Change journal
+		/**
+		 * @brief Adds this property to the pipeline's change journal, called whenever the property starts to differ from its unchanged state
+		 */
+		void journalChange();
+
+		/**
+		 * @brief Adds this property to the pipeline's volatile properties, used if changes are detected by a delegate
+		 */
+		void journalVolatile();
+
+		/**
+		 * @brief Removes this property from the pipeline's change journal, called when the change flag is cleared
+		 */
+		void journalClear();
+
+		/**
+		 * @brief Notifies the pipeline that the owner needs to be validated again
+		 */
+		void invalidateOwner();
+
+		/**
+		 * @brief Checks if changes of this property are detected by a delegate
+		 */
+		virtual bool hasChangeDelegate() const { return false; }
 
 	protected:
 		// Always points at the same instance, but prevents reinterpret casts
 		IPipelineItem* _owner{nullptr};
 		IPipelineItemPrivate* _privateOwner{nullptr};
 
+		// The pipeline, whose change journal is used
+		Pipeline* _pipeline{nullptr};
+
 		unsigned int _minimumVersion{DEFAULT_MINIMUM_VERSION};
 		unsigned int _deprecatedVersion{0};
 		unsigned int _maximumVersion{0};
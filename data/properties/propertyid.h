@@ -50,6 +50,7 @@ namespace ysm
 		Buffer_Binding,
 		Buffer_Name,
 		Buffer_EntryCount,
+		Buffer_InstanceDivisor,
 
 		// Data
 		Data_Outputs = 400,
@@ -149,6 +150,10 @@ namespace ysm
 		Mesh_VertexCount,
 		Mesh_ElementCount,
 		Mesh_InterpolateNormals,
+		Mesh_Rings,
+		Mesh_Subdivisions,
+		Mesh_TubeRadius,
+		Mesh_HeightMap,
 
 		// Textures, Texture Views, Samplers & Images
 		Img_FileName = 10100,
@@ -208,6 +213,44 @@ namespace ysm
 		Array_Data,
 		Array_Byte,
 
+		// Readback
+		Readback_DataType,
+		Readback_Frame,
+		Readback_Byte,
+		Readback_Data,
+
+		// Mesh optimizer
+		Optimizer_VertexCache,
+		Optimizer_VertexFetch,
+		Optimizer_Overdraw,
+		Optimizer_OverdrawThreshold,
+		Optimizer_CacheSize,
+		Optimizer_ACMRBefore,
+		Optimizer_ACMRAfter,
+		Optimizer_ATVRBefore,
+		Optimizer_ATVRAfter,
+
+		// Parallel primitive
+		Primitive_Primitive,
+		Primitive_DataType,
+		Primitive_Operator,
+		Primitive_SortOutput,
+		Primitive_SegmentSize,
+		Primitive_GrainSize,
+		Primitive_ElementCount,
+		Primitive_ChunkCount,
+		Primitive_Throughput,
+		Primitive_ReferenceThroughput,
+		Primitive_ReferenceMeasured,
+		Primitive_Verified,
+
+		// Mesh LOD
+		LOD_LevelCount,
+		LOD_LevelRatio,
+		LOD_PreserveBorders,
+		LOD_TriangleCounts,
+		LOD_Errors,
+
 		// Rasterization
 		Rasterization_CullFaceMode = 11000,
 		Rasterization_EnableCulling,
@@ -268,6 +311,8 @@ namespace ysm
 		Draw_Instanced,
 		Draw_InstanceCount,
 		Draw_AutoElementCount,
+		Draw_LODSelection,
+		Draw_LODThreshold,
 
 		// Transform Feedback
 		TransformFeedback_BufferMode = 15000,
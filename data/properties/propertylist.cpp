@@ -106,6 +106,12 @@ namespace ysm
 		{
 			propBase->_owner = _owner;
 			propBase->_privateOwner = _privateOwner;
+			propBase->_pipeline = _pipeline;
+
+			if (propBase->hasChangeDelegate())
+				propBase->journalVolatile();
+			else if (propBase->hasChanged())
+				propBase->journalChange();
 		}
 
 		ObjectVector<IProperty>::append(prop);
@@ -121,6 +127,12 @@ namespace ysm
 		{
 			propBase->_owner = _owner;
 			propBase->_privateOwner = _privateOwner;
+			propBase->_pipeline = _pipeline;
+
+			if (propBase->hasChangeDelegate())
+				propBase->journalVolatile();
+			else if (propBase->hasChanged())
+				propBase->journalChange();
 		}
 
 		ObjectVector<IProperty>::insert(i, prop);
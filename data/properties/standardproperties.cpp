@@ -25,6 +25,9 @@
 
 #include "standardproperties.h"
 
+#include <QtEndian>
+#include <cstring>
+
 namespace ysm
 {
 	// Helpers
@@ -41,33 +44,67 @@ namespace ysm
 		return ok;
 	}
 
-	template<typename V, typename P, typename T>
+	// Text representation of data array elements (matches the representation of the single value properties)
+
+	static void appendDataElement(QString& s, int v) { s += QString::number(v); }
+	static void appendDataElement(QString& s, unsigned int v) { s += QString::number(v); }
+	static void appendDataElement(QString& s, float v) { s += QString::number(v); }
+	static void appendDataElement(QString& s, const QVector2D& v) { s += QString("%1;%2").arg(v.x()).arg(v.y()); }
+	static void appendDataElement(QString& s, const QVector3D& v) { s += QString("%1;%2;%3").arg(v.x()).arg(v.y()).arg(v.z()); }
+	static void appendDataElement(QString& s, const QVector4D& v) { s += QString("%1;%2;%3;%4").arg(v.x()).arg(v.y()).arg(v.z()).arg(v.w()); }
+
+	static bool parseDataElement(const QStringRef& s, int& v) { bool ok = false; v = s.toInt(&ok); return ok; }
+	static bool parseDataElement(const QStringRef& s, unsigned int& v) { bool ok = false; v = s.toUInt(&ok); return ok; }
+	static bool parseDataElement(const QStringRef& s, float& v) { bool ok = false; v = s.toFloat(&ok); return ok; }
+
+	template<typename V>
+	bool parseDataVectorElement(const QStringRef& s, V& v, const int components)
+	{
+		QVector<QStringRef> vals = s.split(';');
+
+		if (vals.size() != components)
+			return false;
+
+		for (int i = 0; i < components; ++i)
+		{
+			if (!parseDataElement(vals[i], v[i]))
+				return false;
+		}
+
+		return true;
+	}
+
+	static bool parseDataElement(const QStringRef& s, QVector2D& v) { return parseDataVectorElement(s, v, 2); }
+	static bool parseDataElement(const QStringRef& s, QVector3D& v) { return parseDataVectorElement(s, v, 3); }
+	static bool parseDataElement(const QStringRef& s, QVector4D& v) { return parseDataVectorElement(s, v, 4); }
+
+	template<typename T>
 	QString convertDataArrayToString(T& t)
 	{
-		QStringList vals;
+		QString s;
+		bool isFirst = true;
 
-		for (V v : t.getValue())
+		for (const auto& v : t.getValue())
 		{
-			P prop{v};
-			vals << prop.toString();
+			if (!isFirst)
+				s += '|';
+
+			appendDataElement(s, v);
+			isFirst = false;
 		}
 
-		return vals.join('|');
+		return s;
 	}
 
-	template<typename V, typename P, typename T>
+	template<typename V, typename T>
 	bool convertStringToDataArray(const QString& s, T& t)
 	{
-		QStringList vals = s.split('|');
-		V newVals;
+		QVector<QStringRef> vals = s.splitRef('|');
+		V newVals(vals.size());
 
-		for (QString v : vals)
+		for (int i = 0; i < vals.size(); ++i)
 		{
-			P prop;
-
-			if (prop.fromString(v))
-				newVals << prop.getValue();
-			else
+			if (!parseDataElement(vals[i], newVals[i]))
 				return false;
 		}
 
@@ -75,6 +112,93 @@ namespace ysm
 		return true;
 	}
 
+	// Binary representation of data arrays: base64 encoded, little endian 32 bit words
+
+	const QString DATA_ARRAY_ENCODING = "base64";
+	const int DATA_ARRAY_ENCODING_VERSION = 1;
+
+	template<typename V>
+	QString encodeDataArray(const QVector<V>& values)
+	{
+		static_assert(sizeof(V) % sizeof(quint32) == 0, "V must consist of 32 bit words");
+
+		QByteArray bytes{reinterpret_cast<const char*>(values.constData()), static_cast<int>(values.size() * sizeof(V))};
+
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+		quint32* words = reinterpret_cast<quint32*>(bytes.data());
+
+		for (int i = 0; i < bytes.size() / static_cast<int>(sizeof(quint32)); ++i)
+			words[i] = qToLittleEndian(words[i]);
+#endif
+
+		return QString::fromLatin1(bytes.toBase64());
+	}
+
+	template<typename V>
+	bool decodeDataArray(const QString& s, QVector<V>& values)
+	{
+		QByteArray bytes = QByteArray::fromBase64(s.toLatin1());
+
+		if (bytes.size() % sizeof(V) != 0)
+			return false;
+
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+		quint32* words = reinterpret_cast<quint32*>(bytes.data());
+
+		for (int i = 0; i < bytes.size() / static_cast<int>(sizeof(quint32)); ++i)
+			words[i] = qFromLittleEndian(words[i]);
+#endif
+
+		values.resize(bytes.size() / sizeof(V));
+		memcpy(values.data(), bytes.constData(), bytes.size());
+		return true;
+	}
+
+	template<typename T>
+	void serializeDataArrayProperty(const T& prop, QDomElement* xmlElement, SerializationContext* ctx)
+	{
+		xmlElement->setAttribute("id", static_cast<int>(prop.getID()));
+		xmlElement->setAttribute("encoding", DATA_ARRAY_ENCODING);
+		xmlElement->setAttribute("encodingVersion", DATA_ARRAY_ENCODING_VERSION);
+
+		if (!prop.getValue().isEmpty())
+		{
+			QDomText data = ctx->createTextElement(encodeDataArray(prop.getValue()));
+			xmlElement->appendChild(data);
+		}
+	}
+
+	template<typename T>
+	void deserializeDataArrayProperty(T& prop, const QDomElement* xmlElement, SerializationContext* ctx)
+	{
+		QString data = xmlElement->text();
+
+		if (data.isEmpty())
+			return;
+
+		bool isReadOnly = prop.isReadOnly();
+		prop.setReadOnly(false);
+
+		if (!xmlElement->hasAttribute("encoding"))
+		{
+			// Text representation of older files
+			prop.fromString(data);
+		}
+		else if (xmlElement->attribute("encoding") == DATA_ARRAY_ENCODING && xmlElement->attribute("encodingVersion").toInt() <= DATA_ARRAY_ENCODING_VERSION)
+		{
+			typename T::value_type values;
+
+			if (decodeDataArray(data, values))
+				prop.setValue(values);
+			else
+				ctx->addMessage(QString("The data of property '%1' is corrupted").arg(prop.getName()));
+		}
+		else
+			ctx->addMessage(QString("The data encoding of property '%1' is not supported").arg(prop.getName()));
+
+		prop.setReadOnly(isReadOnly);
+	}
+
 	// Serialization member specializations
 	// Standard property types
 
@@ -317,73 +441,145 @@ namespace ysm
 	template<>
 	QString Property<Vec2Data, PropertyType::DataVec2>::toString() const
 	{
-		return convertDataArrayToString<QVector2D, Vec2Property>(*this);
+		return convertDataArrayToString(*this);
 	}
 
 	template<>
 	bool Property<Vec2Data, PropertyType::DataVec2>::fromString(const QString& string)
 	{
-		return convertStringToDataArray<Vec2Data, Vec2Property>(string, *this);
+		return convertStringToDataArray<Vec2Data>(string, *this);
+	}
+
+	template<>
+	void Property<Vec2Data, PropertyType::DataVec2>::serialize(QDomElement* xmlElement, SerializationContext* ctx) const
+	{
+		serializeDataArrayProperty(*this, xmlElement, ctx);
+	}
+
+	template<>
+	void Property<Vec2Data, PropertyType::DataVec2>::deserialize(const QDomElement* xmlElement, SerializationContext* ctx)
+	{
+		deserializeDataArrayProperty(*this, xmlElement, ctx);
 	}
 
 	template<>
 	QString Property<Vec3Data, PropertyType::DataVec3>::toString() const
 	{
-		return convertDataArrayToString<QVector3D, Vec3Property>(*this);
+		return convertDataArrayToString(*this);
 	}
 
 	template<>
 	bool Property<Vec3Data, PropertyType::DataVec3>::fromString(const QString& string)
 	{
-		return convertStringToDataArray<Vec3Data, Vec3Property>(string, *this);
+		return convertStringToDataArray<Vec3Data>(string, *this);
+	}
+
+	template<>
+	void Property<Vec3Data, PropertyType::DataVec3>::serialize(QDomElement* xmlElement, SerializationContext* ctx) const
+	{
+		serializeDataArrayProperty(*this, xmlElement, ctx);
+	}
+
+	template<>
+	void Property<Vec3Data, PropertyType::DataVec3>::deserialize(const QDomElement* xmlElement, SerializationContext* ctx)
+	{
+		deserializeDataArrayProperty(*this, xmlElement, ctx);
 	}
 
 	template<>
 	QString Property<Vec4Data, PropertyType::DataVec4>::toString() const
 	{
-		return convertDataArrayToString<QVector4D, Vec4Property>(*this);
+		return convertDataArrayToString(*this);
 	}
 
 	template<>
 	bool Property<Vec4Data, PropertyType::DataVec4>::fromString(const QString& string)
 	{
-		return convertStringToDataArray<Vec4Data, Vec4Property>(string, *this);
+		return convertStringToDataArray<Vec4Data>(string, *this);
+	}
+
+	template<>
+	void Property<Vec4Data, PropertyType::DataVec4>::serialize(QDomElement* xmlElement, SerializationContext* ctx) const
+	{
+		serializeDataArrayProperty(*this, xmlElement, ctx);
+	}
+
+	template<>
+	void Property<Vec4Data, PropertyType::DataVec4>::deserialize(const QDomElement* xmlElement, SerializationContext* ctx)
+	{
+		deserializeDataArrayProperty(*this, xmlElement, ctx);
 	}
 
 	template<>
 	QString Property<IntData, PropertyType::DataInt>::toString() const
 	{
-		return convertDataArrayToString<int, IntProperty>(*this);
+		return convertDataArrayToString(*this);
 	}
 
 	template<>
 	bool Property<IntData, PropertyType::DataInt>::fromString(const QString& string)
 	{
-		return convertStringToDataArray<IntData, IntProperty>(string, *this);
+		return convertStringToDataArray<IntData>(string, *this);
+	}
+
+	template<>
+	void Property<IntData, PropertyType::DataInt>::serialize(QDomElement* xmlElement, SerializationContext* ctx) const
+	{
+		serializeDataArrayProperty(*this, xmlElement, ctx);
+	}
+
+	template<>
+	void Property<IntData, PropertyType::DataInt>::deserialize(const QDomElement* xmlElement, SerializationContext* ctx)
+	{
+		deserializeDataArrayProperty(*this, xmlElement, ctx);
 	}
 
 	template<>
 	QString Property<UIntData, PropertyType::DataUInt>::toString() const
 	{
-		return convertDataArrayToString<unsigned int, UIntProperty>(*this);
+		return convertDataArrayToString(*this);
 	}
 
 	template<>
 	bool Property<UIntData, PropertyType::DataUInt>::fromString(const QString& string)
 	{
-		return convertStringToDataArray<UIntData, UIntProperty>(string, *this);
+		return convertStringToDataArray<UIntData>(string, *this);
+	}
+
+	template<>
+	void Property<UIntData, PropertyType::DataUInt>::serialize(QDomElement* xmlElement, SerializationContext* ctx) const
+	{
+		serializeDataArrayProperty(*this, xmlElement, ctx);
+	}
+
+	template<>
+	void Property<UIntData, PropertyType::DataUInt>::deserialize(const QDomElement* xmlElement, SerializationContext* ctx)
+	{
+		deserializeDataArrayProperty(*this, xmlElement, ctx);
 	}
 
 	template<>
 	QString Property<FloatData, PropertyType::DataFloat>::toString() const
 	{
-		return convertDataArrayToString<float, FloatProperty>(*this);
+		return convertDataArrayToString(*this);
 	}
 
 	template<>
 	bool Property<FloatData, PropertyType::DataFloat>::fromString(const QString& string)
 	{
-		return convertStringToDataArray<FloatData, FloatProperty>(string, *this);
+		return convertStringToDataArray<FloatData>(string, *this);
+	}
+
+	template<>
+	void Property<FloatData, PropertyType::DataFloat>::serialize(QDomElement* xmlElement, SerializationContext* ctx) const
+	{
+		serializeDataArrayProperty(*this, xmlElement, ctx);
+	}
+
+	template<>
+	void Property<FloatData, PropertyType::DataFloat>::deserialize(const QDomElement* xmlElement, SerializationContext* ctx)
+	{
+		deserializeDataArrayProperty(*this, xmlElement, ctx);
 	}
 
 	template<>
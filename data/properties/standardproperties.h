@@ -118,6 +118,20 @@ namespace ysm
 	template<> bool Property<UIntData, PropertyType::DataUInt>::fromString(const QString& string);
 	template<> QString Property<FloatData, PropertyType::DataFloat>::toString() const;
 	template<> bool Property<FloatData, PropertyType::DataFloat>::fromString(const QString& string);
+
+	// Data arrays are stored in a binary encoding, falling back to the text representation for older files
+	template<> void Property<Vec2Data, PropertyType::DataVec2>::serialize(QDomElement* xmlElement, SerializationContext* ctx) const;
+	template<> void Property<Vec2Data, PropertyType::DataVec2>::deserialize(const QDomElement* xmlElement, SerializationContext* ctx);
+	template<> void Property<Vec3Data, PropertyType::DataVec3>::serialize(QDomElement* xmlElement, SerializationContext* ctx) const;
+	template<> void Property<Vec3Data, PropertyType::DataVec3>::deserialize(const QDomElement* xmlElement, SerializationContext* ctx);
+	template<> void Property<Vec4Data, PropertyType::DataVec4>::serialize(QDomElement* xmlElement, SerializationContext* ctx) const;
+	template<> void Property<Vec4Data, PropertyType::DataVec4>::deserialize(const QDomElement* xmlElement, SerializationContext* ctx);
+	template<> void Property<IntData, PropertyType::DataInt>::serialize(QDomElement* xmlElement, SerializationContext* ctx) const;
+	template<> void Property<IntData, PropertyType::DataInt>::deserialize(const QDomElement* xmlElement, SerializationContext* ctx);
+	template<> void Property<UIntData, PropertyType::DataUInt>::serialize(QDomElement* xmlElement, SerializationContext* ctx) const;
+	template<> void Property<UIntData, PropertyType::DataUInt>::deserialize(const QDomElement* xmlElement, SerializationContext* ctx);
+	template<> void Property<FloatData, PropertyType::DataFloat>::serialize(QDomElement* xmlElement, SerializationContext* ctx) const;
+	template<> void Property<FloatData, PropertyType::DataFloat>::deserialize(const QDomElement* xmlElement, SerializationContext* ctx);
 }
 
 #endif
@@ -87,6 +87,12 @@ namespace ysm
 
 		_instanceCount = _properties->newProperty<UIntProperty>(PropertyID::Draw_InstanceCount, "Instance Count");
 		*_instanceCount = 1;
+
+		_lodSelection = _properties->newProperty<BoolProperty>(PropertyID::Draw_LODSelection, "Select Detail Level");
+		*_lodSelection = false;
+
+		_lodThreshold = _properties->newProperty<FloatProperty>(PropertyID::Draw_LODThreshold, "Detail Level Threshold");
+		*_lodThreshold = 1.0f;
 	}
 
 	bool DrawRenderCommand::canAcceptBlockAssignment(IBlock* block, QString& denialReason)
@@ -132,4 +138,14 @@ namespace ysm
 	{
 		return _instanceCount;
 	}
+
+	BoolProperty* DrawRenderCommand::getLODSelection()
+	{
+		return _lodSelection;
+	}
+
+	FloatProperty* DrawRenderCommand::getLODThreshold()
+	{
+		return _lodThreshold;
+	}
 }
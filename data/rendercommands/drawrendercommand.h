@@ -117,6 +117,17 @@ namespace ysm
 		 */
 		UIntProperty* getInstanceCount();
 
+		/**
+		 * @brief Determines whether the detail level of a mesh LOD index buffer is chosen by the projected size of the mesh
+		 * Otherwise, the finest level is drawn.
+		 */
+		BoolProperty* getLODSelection();
+
+		/**
+		 * @brief Gets the largest geometric error in pixels that a selected detail level may show on screen
+		 */
+		FloatProperty* getLODThreshold();
+
 	public:
 		bool canAcceptBlockAssignment(IBlock* block, QString& denialReason) override;
 
@@ -132,6 +143,8 @@ namespace ysm
 		UIntProperty* _firstIndex{nullptr};
 		BoolProperty* _instanced{nullptr};
 		UIntProperty* _instanceCount{nullptr};
+		BoolProperty* _lodSelection{nullptr};
+		FloatProperty* _lodThreshold{nullptr};
 	};
 }
 
@@ -85,7 +85,10 @@ namespace ysm
 			connect(blockEx, SIGNAL(blockRemoved()), this, SLOT(onBlockRemoved()));
 		}
 
+		// Both, the previously and the newly assigned block need to be validated again
+		_pipeline->invalidateItem(this);
 		_assignedBlock = blockEx;
+		_pipeline->invalidateItem(this);
 	}
 
 	bool RenderCommand::canAcceptBlockAssignment(IBlock* block, QString& denialReason)
@@ -24,6 +24,7 @@
  ***********************************************************************************/
 
 #include "datasource.h"
+#include "data/blocks/block.h"
 
 namespace ysm
 {
@@ -46,4 +47,9 @@ namespace ysm
 	{
 		return ((_outputs & outputs) == outputs);
 	}
+
+	int DataSource::getCacheBlockId() const
+	{
+		return (_block ? static_cast<int>(_block->getID()) : -1);
+	}
 }
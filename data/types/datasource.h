@@ -64,6 +64,10 @@ namespace ysm
 		 */
 		bool hasOutputs(const unsigned int outputs) const;		
 
+	public:
+		// ICacheable
+		int getCacheBlockId() const override;
+
 	protected:
 		Block* _block{nullptr};
 
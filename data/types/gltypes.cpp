@@ -83,12 +83,69 @@ namespace ysm
 			glslType = GLSLDataType::Float;
 			break;
 
+		case DataType::HalfVec2:
+			glType = GLDataType::HalfFloat;
+			glslType = GLSLDataType::Vec2;
+			break;
+
+		case DataType::HalfVec3:
+			glType = GLDataType::HalfFloat;
+			glslType = GLSLDataType::Vec3;
+			break;
+
+		case DataType::HalfVec4:
+			glType = GLDataType::HalfFloat;
+			glslType = GLSLDataType::Vec4;
+			break;
+
+		case DataType::SNorm8Vec4:
+			glType = GLDataType::Byte;
+			glslType = GLSLDataType::Vec4;
+			break;
+
+		case DataType::UNorm8Vec4:
+			glType = GLDataType::UByte;
+			glslType = GLSLDataType::Vec4;
+			break;
+
+		case DataType::SNorm16Vec2:
+		case DataType::OctahedralSNorm16: // Decoded in the shader
+			glType = GLDataType::Short;
+			glslType = GLSLDataType::Vec2;
+			break;
+
+		case DataType::SNorm16Vec4:
+			glType = GLDataType::Short;
+			glslType = GLSLDataType::Vec4;
+			break;
+
+		case DataType::UNorm16Vec2:
+			glType = GLDataType::UShort;
+			glslType = GLSLDataType::Vec2;
+			break;
+
+		case DataType::UNorm16Vec4:
+			glType = GLDataType::UShort;
+			glslType = GLSLDataType::Vec4;
+			break;
+
+		case DataType::SNorm2101010Rev:
+			glType = GLDataType::Int2101010Rev;
+			glslType = GLSLDataType::Vec4;
+			break;
+
 		default:
 			glType = GLDataType::NoType;
 			glslType = GLSLDataType::NoType;
 		}
 	}
 
+	bool GLTypes::isNormalizedDataType(DataType dataType)
+	{
+		// Half floats are the only packed format that isn't normalized
+		return TypeConversion::isPackedType(dataType) && dataType != DataType::HalfVec2 && dataType != DataType::HalfVec3 && dataType != DataType::HalfVec4;
+	}
+
 	GLTypes::GLTypes()
 	{
 
@@ -141,5 +198,6 @@ namespace ysm
 		_dataTypeNames[GLDataType::HalfFloat] = "Half Float";
 		_dataTypeNames[GLDataType::Double] = "Double";
 		_dataTypeNames[GLDataType::Fixed] = "Fixed";
+		_dataTypeNames[GLDataType::Int2101010Rev] = "Packed Int 2-10-10-10";
 	}
 }
@@ -47,6 +47,7 @@ namespace ysm
 		Float,
 		Double,
 		Fixed,
+		Int2101010Rev,
 	};
 
 	enum class GLSLDataType
@@ -104,6 +105,11 @@ namespace ysm
 		 */
 		static void convertDataTypeToGLTypes(DataType dataType, GLDataType& glType, int& count, GLSLDataType& glslType);
 
+		/**
+		 * @brief Checks whether the GL type of @p dataType holds normalized integers
+		 */
+		static bool isNormalizedDataType(DataType dataType);
+
 	private:
 		explicit GLTypes();
 
@@ -89,6 +89,8 @@ namespace ysm
 
 			Vec4Data imageData;
 			ImageGridCells imageCells;
+
+			qint64 getMemorySize() const override { return getVectorSize(imageData) + getVectorSize(imageCells); }
 		} _emptyData;
 
 		/**
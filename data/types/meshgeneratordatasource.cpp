@@ -24,15 +24,108 @@
  ***********************************************************************************/
 
 #include "meshgeneratordatasource.h"
+#include "data/blocks/block.h"
+#include "data/common/threadpool.h"
 
 #include <QVector3D>
 #include <QtMath>
+#include <QHash>
+#include <QImage>
+#include <QFileInfo>
+#include <QDateTime>
 #include <cstring>
-
-#include <QDebug>
+#include <algorithm>
 
 namespace ysm
 {
+	namespace
+	{
+		// Minimum number of elements a parallel task should process
+		const int MinElementsPerTask = 16384;
+
+		// Maximum number of icosahedron subdivisions (20 * 4^10 triangles)
+		const unsigned int MaxIcoSubdivisions = 10;
+
+		/**
+		 * @brief Calls @p func for consecutive ranges of @p rows rows, distributing them over the global thread pool
+		 * Each row is assumed to produce @p elementsPerRow elements; small workloads are processed on the calling thread.
+		 */
+		void parallelRows(int rows, int elementsPerRow, const std::function<void(int, int)>& func)
+		{
+			int taskCount = qMin(ThreadPool::getThreadCount(), (rows * qMax(elementsPerRow, 1)) / MinElementsPerTask);
+
+			if (taskCount <= 1 || rows < 2)
+			{
+				func(0, rows);
+				return;
+			}
+
+			int rowsPerTask = (rows + taskCount - 1) / taskCount;
+
+			ThreadPool::parallelFor((rows + rowsPerTask - 1) / rowsPerTask, [&](int task) {
+				int begin = task * rowsPerTask;
+				func(begin, qMin(begin + rowsPerTask, rows));
+			});
+		}
+
+		/**
+		 * @brief Precomputes sin and cos of @p count + 1 evenly spaced angles within [0, @p range]
+		 * This keeps all trigonometric calls out of the per-vertex loops.
+		 */
+		void computeSinCos(unsigned int count, double range, QVector<float>& sinValues, QVector<float>& cosValues)
+		{
+			sinValues.resize(count + 1);
+			cosValues.resize(count + 1);
+
+			for (unsigned int i = 0; i <= count; ++i)
+			{
+				double angle = (range * i) / count;
+
+				sinValues[i] = static_cast<float>(qSin(angle));
+				cosValues[i] = static_cast<float>(qCos(angle));
+			}
+
+			// Close the circle exactly
+			if (qFuzzyCompare(range, 2 * M_PI))
+			{
+				sinValues[count] = sinValues[0];
+				cosValues[count] = cosValues[0];
+			}
+		}
+
+		/**
+		 * @brief Writes the indices for the quads of the grid rows [@p begin, @p end), each consisting of @p columns quads and @p stride vertices
+		 * The quad (v0, v1, v2, v3) is split into (v0, v1, v2) and (v2, v1, v3), where v1 is the next vertex within a row and v2 the one in the next row.
+		 * If @p flip is set, the winding of both triangles is reversed.
+		 */
+		void writeGridIndices(unsigned int* indices, unsigned int columns, unsigned int stride, int begin, int end, bool flip = false)
+		{
+			unsigned int* idx = indices + static_cast<size_t>(begin) * columns * 6;
+
+			for (int r = begin; r < end; ++r)
+			{
+				for (unsigned int c = 0; c < columns; ++c)
+				{
+					unsigned int v0 = r * stride + c;
+					unsigned int v1 = flip ? v0 + stride : v0 + 1;
+					unsigned int v2 = flip ? v0 + 1 : v0 + stride;
+					unsigned int v3 = v0 + stride + 1;
+
+					*idx++ = v0; *idx++ = v1; *idx++ = v2;
+					*idx++ = v2; *idx++ = v1; *idx++ = v3;
+				}
+			}
+		}
+	}
+
+	void MeshGeneratorDataSource::MeshData::allocate(int vertexCount, int indexCount)
+	{
+		vertexPositions.resize(vertexCount);
+		vertexNormals.resize(vertexCount);
+		textureCoordinates.resize(vertexCount);
+		indexList.resize(indexCount);
+	}
+
 	MeshGeneratorDataSource::MeshGeneratorDataSource(Pipeline* pipeline, Block* block) : GeometryDataSource(pipeline, block)
 	{
 		_outputs = VertexPositions|VertexNormals|TextureCoordinates|IndexList;
@@ -42,9 +135,6 @@ namespace ysm
 	{
 		clearGeometry();
 
-		// Pre-compute the cache key
-		_cacheKey = QString("Triangle/%1,%2/%3,%4/%5,%6").arg(pt1.x()).arg(pt1.y()).arg(pt2.x()).arg(pt2.y()).arg(pt3.x()).arg(pt3.y());
-
 		float xMin = std::numeric_limits<float>::max();
 		float xMax = std::numeric_limits<float>::min();
 		float yMin = std::numeric_limits<float>::max();
@@ -68,12 +158,21 @@ namespace ysm
 		if (width <= 0.0f || height <= 0.0f)
 			throw std::invalid_argument{"The triangle has no area"};
 
-		_vertexPositions << pt1 << pt2 << pt3;
-		_vertexNormals << -pt1.normalized() << -pt2.normalized() << -pt3.normalized();
-		_textureCoordinates << QVector2D{(pt1.x() - xMin) / width, (pt1.y() - yMin) / height}
-							<< QVector2D{(pt2.x() - xMin) / width, (pt2.y() - yMin) / height}
-							<< QVector2D{(pt3.x() - xMin) / width, (pt3.y() - yMin) / height};
-		_indexList << 0 << 1 << 2;
+		setGenerator(QString("Triangle/%1,%2/%3,%4/%5,%6").arg(pt1.x()).arg(pt1.y()).arg(pt2.x()).arg(pt2.y()).arg(pt3.x()).arg(pt3.y()),
+					 [=](MeshData* data)
+		{
+			const QVector2D points[] = {pt1, pt2, pt3};
+
+			data->allocate(3, 3);
+
+			for (int i = 0; i < 3; ++i)
+			{
+				data->vertexPositions[i] = QVector3D{points[i]};
+				data->vertexNormals[i] = -QVector3D{points[i].normalized()};
+				data->textureCoordinates[i] = QVector3D{(points[i].x() - xMin) / width, (points[i].y() - yMin) / height, 0.0f};
+				data->indexList[i] = i;
+			}
+		});
 	}
 
 	void MeshGeneratorDataSource::createRectangle(const float width, const float height, const QVector3D center)
@@ -83,19 +182,23 @@ namespace ysm
 
 		clearGeometry();
 
-		// Pre-compute the cache key
-		_cacheKey = QString("Rectangle/%1/%2/%3,%4,%5").arg(width).arg(height).arg(center.x()).arg(center.y()).arg(center.z());
+		setGenerator(QString("Rectangle/%1/%2/%3,%4,%5").arg(width).arg(height).arg(center.x()).arg(center.y()).arg(center.z()),
+					 [=](MeshData* data)
+		{
+			const QVector2D corners[] = {{1.0f, 1.0f}, {0.0f, 1.0f}, {0.0f, 0.0f}, {1.0f, 0.0f}};
+			const unsigned int indices[] = {0, 1, 2, 0, 2, 3};
 
-		float halfWidth = width * 0.5f;
-		float halfHeight = height * 0.5f;
+			data->allocate(4, 6);
 
-		_vertexPositions << QVector3D{center.x() + halfWidth, center.y() + halfHeight, center.z()}
-						 << QVector3D{center.x() - halfWidth, center.y() + halfHeight, center.z()}
-						 << QVector3D{center.x() - halfWidth, center.y() - halfHeight, center.z()}
-						 << QVector3D{center.x() + halfWidth, center.y() - halfHeight, center.z()};
-		_vertexNormals << QVector3D{0.0f, 0.0f, 1.0f} << QVector3D{0.0f, 0.0f, 1.0f} << QVector3D{0.0f, 0.0f, 1.0f} << QVector3D{0.0f, 0.0f, 1.0f};
-		_textureCoordinates << QVector3D{1.0f, 1.0f, 0.0f} << QVector3D{0.0f, 1.0f, 0.0f} << QVector3D{0.0f, 0.0f, 0.0f} << QVector3D{1.0f, 0.0f, 0.0f};
-		_indexList << 0 << 1 << 2 << 0 << 2 << 3;
+			for (int i = 0; i < 4; ++i)
+			{
+				data->vertexPositions[i] = QVector3D{center.x() + (corners[i].x() - 0.5f) * width, center.y() + (corners[i].y() - 0.5f) * height, center.z()};
+				data->vertexNormals[i] = QVector3D{0.0f, 0.0f, 1.0f};
+				data->textureCoordinates[i] = QVector3D{corners[i]};
+			}
+
+			std::memcpy(data->indexList.data(), indices, sizeof(indices));
+		});
 	}
 
 	void MeshGeneratorDataSource::createCircle(const float radius, const unsigned int sections, const QVector3D center)
@@ -105,32 +208,83 @@ namespace ysm
 
 		clearGeometry();
 
-		// Pre-compute the cache key
-		_cacheKey = QString("Circle/%1,%2,%3/%4/%5").arg(center.x()).arg(center.y()).arg(center.z()).arg(radius).arg(sections);
+		setGenerator(QString("Circle/%1,%2,%3/%4/%5").arg(center.x()).arg(center.y()).arg(center.z()).arg(radius).arg(sections),
+					 [=](MeshData* data)
+		{
+			QVector<float> sinValues, cosValues;
+			computeSinCos(sections, 2 * M_PI, sinValues, cosValues);
+
+			data->allocate(sections + 1, sections * 3);
+
+			QVector3D* positions = data->vertexPositions.data();
+			QVector3D* normals = data->vertexNormals.data();
+			QVector3D* texCoords = data->textureCoordinates.data();
+			unsigned int* indices = data->indexList.data();
+
+			positions[0] = center;
+			normals[0] = QVector3D{0.0f, 0.0f, 1.0f};
+			texCoords[0] = QVector3D{0.5f, 0.5f, 0.0f};
+
+			parallelRows(sections, 1, [=](int begin, int end)
+			{
+				for (int i = begin; i < end; ++i)
+				{
+					unsigned int v = i + 1;
+
+					positions[v] = QVector3D{cosValues[i] * radius + center.x(), sinValues[i] * radius + center.y(), center.z()};
+					normals[v] = QVector3D{0.0f, 0.0f, 1.0f};
+					texCoords[v] = QVector3D{(cosValues[i] + 1) * 0.5f, (sinValues[i] + 1) * 0.5f, 0.0f};
 
-		double curAngle = 0.0;
-		double incAngle = (2 * M_PI) / sections;
+					indices[i * 3 + 0] = 0;
+					indices[i * 3 + 1] = v;
+					indices[i * 3 + 2] = (v % sections) + 1;
+				}
+			});
+		});
+	}
 
-		_vertexPositions << center;
-		_vertexNormals << QVector3D{0.0f, 0.0f, 1.0f};
-		_textureCoordinates << QVector3D{0.5f, 0.5f, 0.0f};
+	void MeshGeneratorDataSource::createGrid(const float width, const float height, const unsigned int columns, const unsigned int rows, const QVector3D center)
+	{
+		if (width <= 0.0f || height <= 0.0f)
+			throw std::invalid_argument{"The width/height of the grid must be > 0.0"};
+
+		if (columns < 1 || rows < 1)
+			throw std::invalid_argument{"The number of sections/rings for a grid must be >= 1"};
 
-		for (unsigned int i = 1; i <= sections; ++i)
+		clearGeometry();
+
+		setGenerator(QString("Grid/%1,%2,%3/%4/%5/%6/%7").arg(center.x()).arg(center.y()).arg(center.z()).arg(width).arg(height).arg(columns).arg(rows),
+					 [=](MeshData* data)
 		{
-			QVector2D v{static_cast<float>(qCos(curAngle)), static_cast<float>(qSin(curAngle))};
-			QVector2D p{(v.x() * radius) + center.x(), (v.y() * radius) + center.y()};
+			unsigned int stride = columns + 1;
 
-			_vertexPositions << QVector3D{p.x(), p.y(), center.z()};
-			_vertexNormals << QVector3D{0.0f, 0.0f, 1.0f}.normalized();
-			_textureCoordinates << QVector3D{(v.x() + 1) * 0.5f, (v.y() + 1) * 0.5f, 0.0f};
+			data->allocate(stride * (rows + 1), columns * rows * 6);
 
-			if (i >= 2)
-				_indexList << 0 << i - 1 << i;
+			QVector3D* positions = data->vertexPositions.data();
+			QVector3D* normals = data->vertexNormals.data();
+			QVector3D* texCoords = data->textureCoordinates.data();
+			unsigned int* indices = data->indexList.data();
 
-			curAngle += incAngle;
-		}
+			parallelRows(rows + 1, stride, [=](int begin, int end)
+			{
+				for (int r = begin; r < end; ++r)
+				{
+					float v = static_cast<float>(r) / rows;
+
+					for (unsigned int c = 0; c <= columns; ++c)
+					{
+						float u = static_cast<float>(c) / columns;
+						unsigned int vertex = r * stride + c;
+
+						positions[vertex] = QVector3D{center.x() + (u - 0.5f) * width, center.y() + (v - 0.5f) * height, center.z()};
+						normals[vertex] = QVector3D{0.0f, 0.0f, 1.0f};
+						texCoords[vertex] = QVector3D{u, v, 0.0f};
+					}
+				}
 
-		_indexList << 0 << sections << 1;
+				writeGridIndices(indices, columns, stride, begin, qMin<int>(end, rows));
+			});
+		});
 	}
 
 	void MeshGeneratorDataSource::createCuboid(const float width, const float height, const float depth, bool interpolate, const QVector3D center)
@@ -140,50 +294,58 @@ namespace ysm
 
 		clearGeometry();
 
-		// Pre-compute the cache key
-		_cacheKey = QString("Cuboid/%1,%2,%3/%4/%5/%6/%7").arg(center.x()).arg(center.y()).arg(center.z()).arg(width).arg(height).arg(depth).arg(interpolate);
-
-		// Iterate over all 6 faces.
-		QVector3D vPos, vTex, vNormal;
-		for(int face = 0; face < 6; face++)
+		setGenerator(QString("Cuboid/%1,%2,%3/%4/%5/%6/%7").arg(center.x()).arg(center.y()).arg(center.z()).arg(width).arg(height).arg(depth).arg(interpolate),
+					 [=](MeshData* data)
 		{
-			for(int corner = 0; corner < 4; corner++)
-			{
-				int x = corner / 2;
-				int y = corner % 2;
-				int z = face / 3;
+			data->allocate(6 * 4, 6 * 6);
+
+			QVector3D* positions = data->vertexPositions.data();
+			QVector3D* normals = data->vertexNormals.data();
+			QVector3D* texCoords = data->textureCoordinates.data();
+			unsigned int* indices = data->indexList.data();
 
-				switch(face)
+			// Iterate over all 6 faces.
+			QVector3D vPos, vTex, vNormal;
+			for(int face = 0; face < 6; face++)
+			{
+				for(int corner = 0; corner < 4; corner++)
 				{
-				case 0:
-				case 3:
-					vPos = { (x - 0.5f) * width, (y - 0.5f) * height, (z - 0.5f) * depth };
-					vNormal = { 0.0, 0.0, (z - 0.5f) * depth };
-					vTex = { x * width, y * height, 0.0 };
-					break;
-				case 1:
-				case 4:
-					vPos = { (y - 0.5f) * width, (z - 0.5f) * height, (x - 0.5f) * depth };
-					vNormal = { 0.0, (z - 0.5f) * height, 0.0 };
-					vTex = { x * depth, y * width, 0.0 };
-					break;
-				case 2:
-				case 5:
-					vPos = { (z - 0.5f) * width, (x - 0.5f) * height, (y - 0.5f) * depth };
-					vNormal = { (z - 0.5f) * width, 0.0, 0.0 };
-					vTex = { x * height, y * depth, 0.0 };
-					break;
+					int x = corner / 2;
+					int y = corner % 2;
+					int z = face / 3;
+
+					switch(face)
+					{
+					case 0:
+					case 3:
+						vPos = { (x - 0.5f) * width, (y - 0.5f) * height, (z - 0.5f) * depth };
+						vNormal = { 0.0, 0.0, (z - 0.5f) * depth };
+						vTex = { x * width, y * height, 0.0 };
+						break;
+					case 1:
+					case 4:
+						vPos = { (y - 0.5f) * width, (z - 0.5f) * height, (x - 0.5f) * depth };
+						vNormal = { 0.0, (z - 0.5f) * height, 0.0 };
+						vTex = { x * depth, y * width, 0.0 };
+						break;
+					case 2:
+					case 5:
+						vPos = { (z - 0.5f) * width, (x - 0.5f) * height, (y - 0.5f) * depth };
+						vNormal = { (z - 0.5f) * width, 0.0, 0.0 };
+						vTex = { x * height, y * depth, 0.0 };
+						break;
+					}
+
+					*positions++ = vPos + center;
+					*normals++ = (interpolate ? vPos.normalized() : vNormal);
+					*texCoords++ = vTex;
 				}
 
-				_vertexPositions << vPos + center;
-				_vertexNormals << (interpolate ? vPos.normalized() : vNormal);
-				_textureCoordinates << vTex;
+				// Index list renders 6 vertices (two full triangles).
+				*indices++ = face * 4 + 0; *indices++ = face * 4 + 1; *indices++ = face * 4 + 2;
+				*indices++ = face * 4 + 3; *indices++ = face * 4 + 2; *indices++ = face * 4 + 1;
 			}
-
-			// Index list renders 6 vertices (two full triangles).
-			_indexList << face * 4 + 0 << face * 4 + 1 << face * 4 + 2
-					   << face * 4 + 3 << face * 4 + 2 << face * 4 + 1;
-		}
+		});
 	}
 
 	void MeshGeneratorDataSource::createSphere(const float radius, const float sections, const QVector3D center)
@@ -193,110 +355,460 @@ namespace ysm
 
 		clearGeometry();
 
-		// Pre-compute the cache key
-		_cacheKey = QString("Sphere/%1,%2,%3/%5/%6").arg(center.x()).arg(center.y()).arg(center.z()).arg(radius).arg(sections);
+		setGenerator(QString("Sphere/%1,%2,%3/%5/%6").arg(center.x()).arg(center.y()).arg(center.z()).arg(radius).arg(sections),
+					 [=](MeshData* data)
+		{
+			// Number of slices and triangles per slice
+			int slices = qCeil(sections);
+
+			// Calculate the angle between different points.
+			float angle = 2 * M_PI / sections;
+
+			data->allocate((slices - 1) * slices * 4, (slices - 1) * slices * 6);
+
+			QVector3D* positions = data->vertexPositions.data();
+			QVector3D* normals = data->vertexNormals.data();
+			QVector3D* texCoords = data->textureCoordinates.data();
+			unsigned int* indices = data->indexList.data();
+
+			// Create the inner triangles, one triangle "ring" per slice.
+			parallelRows(slices - 1, slices * 4, [=](int begin, int end)
+			{
+				for(int i = begin + 1; i < end + 1; i++)
+				{
+					// Calculate new slice data.
+					float prevRadius = qSin((i - 1) * angle / 2) * radius;
+					float prevHeight = qCos((i - 1) * angle / 2) * radius;
+					float curRadius = qSin(i * angle / 2) * radius;
+					float curHeight = qCos(i * angle / 2) * radius;
+					float nextRadius = qSin((i + 1) * angle / 2) * radius;
+					float nextHeight = qCos((i + 1) * angle / 2) * radius;
+
+					// Every slice is rotated by half a triangle.
+					float offset = -0.5f * (i - 1);
+
+					for(int j = 0; j < slices; j++)
+					{
+						int vertexOffset = ((i - 1) * slices + j) * 4;
+						const QVector3D corners[] =
+						{
+							{ (float) qSin((j + offset) * angle) * prevRadius, prevHeight, (float) qCos((j + offset) * angle) * prevRadius },
+							{ (float) qSin((j - .5f + offset) * angle) * curRadius, curHeight, (float) qCos((j - .5f + offset) * angle) * curRadius },
+							{ (float) qSin((j + .5f + offset) * angle) * curRadius, curHeight, (float) qCos((j + .5f + offset) * angle) * curRadius },
+							{ (float) qSin((j + offset) * angle) * nextRadius, nextHeight, (float) qCos((j + offset) * angle) * nextRadius },
+						};
+
+						for (int k = 0; k < 4; ++k)
+						{
+							positions[vertexOffset + k] = corners[k] + center;
+							normals[vertexOffset + k] = corners[k].normalized();
+							texCoords[vertexOffset + k] = QVector3D { corners[k].x() / radius, corners[k].y() / radius, 1.0f };
+						}
+
+						unsigned int* idx = indices + ((i - 1) * slices + j) * 6;
+						idx[0] = vertexOffset + 0; idx[1] = vertexOffset + 1; idx[2] = vertexOffset + 2;
+						idx[3] = vertexOffset + 3; idx[4] = vertexOffset + 2; idx[5] = vertexOffset + 1;
+					}
+				}
+			});
+		});
+	}
+
+	void MeshGeneratorDataSource::createUVSphere(const float radius, const unsigned int sections, const unsigned int rings, const QVector3D center)
+	{
+		if (radius <= 0.0f)
+			throw std::invalid_argument{"The radius of the sphere must be > 0.0"};
+
+		if (sections < 3 || rings < 2)
+			throw std::invalid_argument{"A UV sphere needs at least 3 sections and 2 rings"};
 
-		// Calculate the angle between different points.
-		float angle = 2 * M_PI / sections;
+		clearGeometry();
 
-		// Create the inner triangles.
-		float offset = 0.0f;
-		for(int i = 1; i < sections; i++)
+		setGenerator(QString("UVSphere/%1,%2,%3/%4/%5/%6").arg(center.x()).arg(center.y()).arg(center.z()).arg(radius).arg(sections).arg(rings),
+					 [=](MeshData* data)
 		{
-			// Calculate new slice data.
-			float prevRadius = qSin((i - 1) * angle / 2) * radius;
-			float prevHeight = qCos((i - 1) * angle / 2) * radius;
-			float curRadius = qSin(i * angle / 2) * radius;
-			float curHeight = qCos(i * angle / 2) * radius;
-			float nextRadius = qSin((i + 1) * angle / 2) * radius;
-			float nextHeight = qCos((i + 1) * angle / 2) * radius;
-
-			qDebug() << curHeight << curRadius;
-
-			// Create one triangle "ring".
-			QVector3D vPos;
-			for(int j = 0; j < sections; j++)
+			QVector<float> sinLon, cosLon, sinLat, cosLat;
+			computeSinCos(sections, 2 * M_PI, sinLon, cosLon);
+			computeSinCos(rings, M_PI, sinLat, cosLat);
+
+			unsigned int stride = sections + 1;
+
+			data->allocate(stride * (rings + 1), sections * rings * 6);
+
+			QVector3D* positions = data->vertexPositions.data();
+			QVector3D* normals = data->vertexNormals.data();
+			QVector3D* texCoords = data->textureCoordinates.data();
+			unsigned int* indices = data->indexList.data();
+
+			// Rows run from the north to the south pole
+			parallelRows(rings + 1, stride, [=, &sinLon, &cosLon, &sinLat, &cosLat](int begin, int end)
 			{
-				vPos = QVector3D
+				for (int r = begin; r < end; ++r)
 				{
-					(float) qSin((j + offset) * angle) * prevRadius,
-					prevHeight,
-					(float) qCos((j + offset) * angle) * prevRadius,
-				};
-				_vertexPositions << vPos + center;
-				_vertexNormals << vPos.normalized();
-				_textureCoordinates << QVector3D { vPos.x() / radius, vPos.y() / radius, 1.0f };
+					for (unsigned int s = 0; s <= sections; ++s)
+					{
+						unsigned int vertex = r * stride + s;
+						QVector3D normal{sinLat[r] * cosLon[s], cosLat[r], -sinLat[r] * sinLon[s]};
+
+						positions[vertex] = normal * radius + center;
+						normals[vertex] = normal;
+						texCoords[vertex] = QVector3D{static_cast<float>(s) / sections, 1.0f - static_cast<float>(r) / rings, 0.0f};
+					}
+				}
+
+				// Rows advance southwards, so the winding must be flipped to keep the faces pointing outwards
+				writeGridIndices(indices, sections, stride, begin, qMin<int>(end, rings), true);
+			});
+		});
+	}
+
+	void MeshGeneratorDataSource::createIcoSphere(const float radius, const unsigned int subdivisions, const QVector3D center)
+	{
+		if (radius <= 0.0f)
+			throw std::invalid_argument{"The radius of the sphere must be > 0.0"};
+
+		if (subdivisions > MaxIcoSubdivisions)
+			throw std::invalid_argument{QString("The number of subdivisions of an icosphere must be <= %1").arg(MaxIcoSubdivisions).toStdString()};
+
+		clearGeometry();
+
+		setGenerator(QString("IcoSphere/%1,%2,%3/%4/%5").arg(center.x()).arg(center.y()).arg(center.z()).arg(radius).arg(subdivisions),
+					 [=](MeshData* data)
+		{
+			const float t = (1.0f + qSqrt(5.0f)) / 2.0f;
+			const QVector3D baseVertices[] =
+			{
+				{-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0},
+				{0, -1, t}, {0, 1, t}, {0, -1, -t}, {0, 1, -t},
+				{t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1},
+			};
+			const unsigned int baseFaces[] =
+			{
+				0, 11, 5,	0, 5, 1,	0, 1, 7,	0, 7, 10,	0, 10, 11,
+				1, 5, 9,	5, 11, 4,	11, 10, 2,	10, 7, 6,	7, 1, 8,
+				3, 9, 4,	3, 4, 2,	3, 2, 6,	3, 6, 8,	3, 8, 9,
+				4, 9, 5,	2, 4, 11,	6, 2, 10,	8, 6, 7,	9, 8, 1,
+			};
+
+			// Every subdivision quadruples the faces; the vertex count follows from Euler's formula
+			int faceCount = 20 << (2 * subdivisions);
+			int vertexCount = faceCount / 2 + 2;
+
+			data->allocate(vertexCount, faceCount * 3);
 
-				vPos = QVector3D
+			QVector3D* positions = data->vertexPositions.data();
+			int vertices = 0;
+
+			for (const QVector3D& vertex : baseVertices)
+				positions[vertices++] = vertex.normalized();
+
+			// Subdivide into the index list and a scratch list alternately, so that the final level ends in the index list
+			UIntData scratch(faceCount * 3);
+			unsigned int* current = (subdivisions % 2) ? scratch.data() : data->indexList.data();
+			unsigned int* next = (subdivisions % 2) ? data->indexList.data() : scratch.data();
+
+			std::memcpy(current, baseFaces, sizeof(baseFaces));
+
+			QHash<quint64, unsigned int> midpoints;
+
+			auto getMidpoint = [&](unsigned int a, unsigned int b)->unsigned int
+			{
+				quint64 key = (static_cast<quint64>(qMin(a, b)) << 32) | qMax(a, b);
+				auto it = midpoints.constFind(key);
+
+				if (it != midpoints.constEnd())
+					return it.value();
+
+				positions[vertices] = ((positions[a] + positions[b]) * 0.5f).normalized();
+				midpoints.insert(key, vertices);
+				return vertices++;
+			};
+
+			for (unsigned int level = 0, levelFaces = 20; level < subdivisions; ++level, levelFaces *= 4)
+			{
+				midpoints.clear();
+				midpoints.reserve(levelFaces * 3 / 2);
+
+				unsigned int* out = next;
+
+				for (unsigned int f = 0; f < levelFaces; ++f)
 				{
-					(float) qSin((j - .5f + offset) * angle) * curRadius,
-					curHeight,
-					(float) qCos((j - .5f + offset) * angle) * curRadius
-				};
-				_vertexPositions << vPos + center;
-				_vertexNormals << vPos.normalized();
-				_textureCoordinates << QVector3D { vPos.x() / radius, vPos.y() / radius, 1.0f };
+					unsigned int a = current[f * 3 + 0];
+					unsigned int b = current[f * 3 + 1];
+					unsigned int c = current[f * 3 + 2];
+					unsigned int ab = getMidpoint(a, b);
+					unsigned int bc = getMidpoint(b, c);
+					unsigned int ca = getMidpoint(c, a);
+
+					*out++ = a; *out++ = ab; *out++ = ca;
+					*out++ = b; *out++ = bc; *out++ = ab;
+					*out++ = c; *out++ = ca; *out++ = bc;
+					*out++ = ab; *out++ = bc; *out++ = ca;
+				}
+
+				std::swap(current, next);
+			}
+
+			QVector3D* normals = data->vertexNormals.data();
+			QVector3D* texCoords = data->textureCoordinates.data();
 
-				vPos = QVector3D
+			// Derive the remaining attributes from the unit positions
+			parallelRows(vertexCount, 1, [=](int begin, int end)
+			{
+				for (int v = begin; v < end; ++v)
 				{
-					(float) qSin((j + .5f + offset) * angle) * curRadius,
-					curHeight,
-					(float) qCos((j + .5f + offset) * angle) * curRadius
-				};
-				_vertexPositions << vPos + center;
-				_vertexNormals << vPos.normalized();
-				_textureCoordinates << QVector3D { vPos.x() / radius, vPos.y() / radius, 1.0f };
+					QVector3D normal = positions[v];
+
+					normals[v] = normal;
+					texCoords[v] = QVector3D{static_cast<float>(0.5 + qAtan2(-normal.z(), normal.x()) / (2 * M_PI)),
+											 static_cast<float>(1.0 - qAcos(qBound(-1.0f, normal.y(), 1.0f)) / M_PI), 0.0f};
+					positions[v] = normal * radius + center;
+				}
+			});
+		});
+	}
+
+	void MeshGeneratorDataSource::createTorus(const float radius, const float tubeRadius, const unsigned int sections, const unsigned int rings, const QVector3D center)
+	{
+		if (radius <= 0.0f || tubeRadius <= 0.0f)
+			throw std::invalid_argument{"The radius/tube radius of the torus must be > 0.0"};
+
+		if (sections < 3 || rings < 3)
+			throw std::invalid_argument{"A torus needs at least 3 sections and 3 rings"};
+
+		clearGeometry();
+
+		setGenerator(QString("Torus/%1,%2,%3/%4/%5/%6/%7").arg(center.x()).arg(center.y()).arg(center.z()).arg(radius).arg(tubeRadius).arg(sections).arg(rings),
+					 [=](MeshData* data)
+		{
+			QVector<float> sinRing, cosRing, sinTube, cosTube;
+			computeSinCos(sections, 2 * M_PI, sinRing, cosRing);
+			computeSinCos(rings, 2 * M_PI, sinTube, cosTube);
+
+			unsigned int stride = rings + 1;
 
-				vPos = QVector3D
+			data->allocate(stride * (sections + 1), sections * rings * 6);
+
+			QVector3D* positions = data->vertexPositions.data();
+			QVector3D* normals = data->vertexNormals.data();
+			QVector3D* texCoords = data->textureCoordinates.data();
+			unsigned int* indices = data->indexList.data();
+
+			// Rows run around the ring, columns around the tube
+			parallelRows(sections + 1, stride, [=, &sinRing, &cosRing, &sinTube, &cosTube](int begin, int end)
+			{
+				for (int s = begin; s < end; ++s)
 				{
-					(float) qSin((j + offset) * angle) * nextRadius,
-					nextHeight,
-					(float) qCos((j + offset) * angle) * nextRadius
-				};
-				_vertexPositions << vPos + center;
-				_vertexNormals << vPos.normalized();
-				_textureCoordinates << QVector3D { vPos.x() / radius, vPos.y() / radius, 1.0f };
+					for (unsigned int r = 0; r <= rings; ++r)
+					{
+						unsigned int vertex = s * stride + r;
+						float distance = radius + tubeRadius * cosTube[r];
+						QVector3D normal{cosTube[r] * cosRing[s], sinTube[r], -cosTube[r] * sinRing[s]};
+
+						positions[vertex] = QVector3D{distance * cosRing[s], tubeRadius * sinTube[r], -distance * sinRing[s]} + center;
+						normals[vertex] = normal;
+						texCoords[vertex] = QVector3D{static_cast<float>(s) / sections, static_cast<float>(r) / rings, 0.0f};
+					}
+				}
+
+				// Within a row, the next vertex lies further around the tube, so the winding must be flipped
+				writeGridIndices(indices, rings, stride, begin, qMin<int>(end, sections), true);
+			});
+		});
+	}
+
+	void MeshGeneratorDataSource::createCylinder(const float radius, const float height, const unsigned int sections, const unsigned int rings, const QVector3D center)
+	{
+		if (radius <= 0.0f || height <= 0.0f)
+			throw std::invalid_argument{"The radius/height of the cylinder must be > 0.0"};
+
+		if (sections < 3 || rings < 1)
+			throw std::invalid_argument{"A cylinder needs at least 3 sections and 1 ring"};
+
+		clearGeometry();
+
+		setGenerator(QString("Cylinder/%1,%2,%3/%4/%5/%6/%7").arg(center.x()).arg(center.y()).arg(center.z()).arg(radius).arg(height).arg(sections).arg(rings),
+					 [=](MeshData* data)
+		{
+			QVector<float> sinValues, cosValues;
+			computeSinCos(sections, 2 * M_PI, sinValues, cosValues);
+
+			unsigned int stride = sections + 1;
+			unsigned int sideVertices = stride * (rings + 1);
+			unsigned int sideIndices = sections * rings * 6;
+
+			// The side is followed by the top and bottom cap, each consisting of a center and its rim
+			data->allocate(sideVertices + 2 * (sections + 1), sideIndices + 2 * sections * 3);
+
+			QVector3D* positions = data->vertexPositions.data();
+			QVector3D* normals = data->vertexNormals.data();
+			QVector3D* texCoords = data->textureCoordinates.data();
+			unsigned int* indices = data->indexList.data();
+
+			// Rows run from the bottom to the top
+			parallelRows(rings + 1, stride, [=, &sinValues, &cosValues](int begin, int end)
+			{
+				for (int r = begin; r < end; ++r)
+				{
+					float v = static_cast<float>(r) / rings;
+
+					for (unsigned int s = 0; s <= sections; ++s)
+					{
+						unsigned int vertex = r * stride + s;
+
+						positions[vertex] = QVector3D{cosValues[s] * radius, (v - 0.5f) * height, -sinValues[s] * radius} + center;
+						normals[vertex] = QVector3D{cosValues[s], 0.0f, -sinValues[s]};
+						texCoords[vertex] = QVector3D{static_cast<float>(s) / sections, v, 0.0f};
+					}
+				}
+
+				writeGridIndices(indices, sections, stride, begin, qMin<int>(end, rings));
+			});
+
+			for (int cap = 0; cap < 2; ++cap)
+			{
+				float direction = cap ? -1.0f : 1.0f;
+				unsigned int centerVertex = sideVertices + cap * (sections + 1);
+				unsigned int* idx = indices + sideIndices + cap * sections * 3;
+
+				positions[centerVertex] = QVector3D{0.0f, direction * height * 0.5f, 0.0f} + center;
+				normals[centerVertex] = QVector3D{0.0f, direction, 0.0f};
+				texCoords[centerVertex] = QVector3D{0.5f, 0.5f, 0.0f};
+
+				for (unsigned int s = 0; s < sections; ++s)
+				{
+					unsigned int vertex = centerVertex + 1 + s;
+					unsigned int nextVertex = centerVertex + 1 + (s + 1) % sections;
 
-				int indexOffset = ((i - 1) * sections + j) * 4;
-				_indexList << indexOffset + 0 << indexOffset + 1 << indexOffset + 2
-						   << indexOffset + 3 << indexOffset + 2 << indexOffset + 1;
+					positions[vertex] = QVector3D{cosValues[s] * radius, direction * height * 0.5f, -sinValues[s] * radius} + center;
+					normals[vertex] = QVector3D{0.0f, direction, 0.0f};
+					texCoords[vertex] = QVector3D{0.5f + 0.5f * cosValues[s], 0.5f - 0.5f * sinValues[s], 0.0f};
+
+					// The bottom cap faces downwards, so its winding is reversed
+					*idx++ = centerVertex;
+					*idx++ = cap ? nextVertex : vertex;
+					*idx++ = cap ? vertex : nextVertex;
+				}
 			}
+		});
+	}
 
-			// Adjust the offset.
-			offset -= 0.5;
-		}
+	void MeshGeneratorDataSource::createHeightfield(const QString& imageFile, const float width, const float height, const float depth, const QVector3D center)
+	{
+		if (width <= 0.0f || depth <= 0.0f)
+			throw std::invalid_argument{"The width/depth of the heightfield must be > 0.0"};
+
+		clearGeometry();
+
+		if (imageFile.isEmpty())
+			return;
+
+		// Include the modification time, so that changed images are picked up
+		QFileInfo fileInfo{imageFile};
+		qint64 modified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+		setGenerator(QString("Heightfield/%1@%2/%3,%4,%5/%6/%7/%8").arg(imageFile).arg(modified).arg(center.x()).arg(center.y()).arg(center.z()).arg(width).arg(height).arg(depth),
+					 [=](MeshData* data)
+		{
+			QImage image;
+
+			if (!image.load(imageFile))
+				throw std::runtime_error{"The height map could not be loaded"};
+
+			image = image.convertToFormat(QImage::Format_Grayscale8);
+
+			int columns = image.width();
+			int rows = image.height();
+
+			if (columns < 2 || rows < 2)
+				throw std::runtime_error{"The height map must be at least 2x2 pixels"};
+
+			float stepX = width / (columns - 1);
+			float stepZ = depth / (rows - 1);
+
+			data->allocate(columns * rows, (columns - 1) * (rows - 1) * 6);
+
+			QVector3D* positions = data->vertexPositions.data();
+			QVector3D* normals = data->vertexNormals.data();
+			QVector3D* texCoords = data->textureCoordinates.data();
+			unsigned int* indices = data->indexList.data();
+
+			parallelRows(rows, columns, [=, &image](int begin, int end)
+			{
+				auto sample = [&image, columns, rows, height](int x, int y)->float
+				{
+					x = qBound(0, x, columns - 1);
+					y = qBound(0, y, rows - 1);
+					return image.constScanLine(y)[x] / 255.0f * height;
+				};
+
+				for (int r = begin; r < end; ++r)
+				{
+					for (int c = 0; c < columns; ++c)
+					{
+						unsigned int vertex = r * columns + c;
+
+						// Central differences give the slope along x and z
+						float slopeX = (sample(c + 1, r) - sample(c - 1, r)) / (2 * stepX);
+						float slopeZ = (sample(c, r + 1) - sample(c, r - 1)) / (2 * stepZ);
+
+						positions[vertex] = QVector3D{c * stepX - width * 0.5f, sample(c, r), r * stepZ - depth * 0.5f} + center;
+						normals[vertex] = QVector3D{-slopeX, 1.0f, -slopeZ}.normalized();
+						texCoords[vertex] = QVector3D{static_cast<float>(c) / (columns - 1), 1.0f - static_cast<float>(r) / (rows - 1), 0.0f};
+					}
+				}
+
+				// Rows advance along +z, so the winding must be flipped to let the faces point upwards
+				writeGridIndices(indices, columns - 1, columns, begin, qMin(end, rows - 1), true);
+			});
+		});
 	}
 
 	const Vec3Data& MeshGeneratorDataSource::getVertexPositions()
 	{
-		return _vertexPositions;
+		return getMeshData()->vertexPositions;
 	}
 
 	const Vec3Data& MeshGeneratorDataSource::getTextureCoordinates()
 	{
-		return _textureCoordinates;
+		return getMeshData()->textureCoordinates;
 	}
 
 	const Vec3Data& MeshGeneratorDataSource::getVertexNormals()
 	{
-		return _vertexNormals;
+		return getMeshData()->vertexNormals;
 	}
 
 	const UIntData& MeshGeneratorDataSource::getIndexList()
 	{
-		return _indexList;
+		return getMeshData()->indexList;
 	}
 
-	void MeshGeneratorDataSource::clearGeometry()
+	const MeshGeneratorDataSource::MeshData* MeshGeneratorDataSource::getMeshData()
 	{
-		_vertexPositions.clear();
-		_textureCoordinates.clear();
-		_vertexNormals.clear();
-		_indexList.clear();
+		const MeshData* data = getCachedData<MeshData>();
+
+		if (!data)
+		{
+			// No data cached (maybe the generation failed); return an empty dummy
+			data = &_emptyData;
+		}
+
+		return data;
+	}
 
+	void MeshGeneratorDataSource::clearGeometry()
+	{
+		_generator = nullptr;
 		_cacheKey = "";
 	}
 
+	void MeshGeneratorDataSource::setGenerator(const CacheObject::Key& cacheKey, const Generator& generator)
+	{
+		_cacheKey = cacheKey;
+		_generator = generator;
+	}
+
 	CacheObject::Key MeshGeneratorDataSource::getCacheKey(bool retrieveForeignKey)
 	{
 		Q_UNUSED(retrieveForeignKey);
@@ -307,7 +819,25 @@ namespace ysm
 
 	CacheObject::CacheObjectData* MeshGeneratorDataSource::createCacheData()
 	{
-		// Never actually cache this object
-		return nullptr;
+		if (!_generator)
+			return nullptr;
+
+		// Data must be created on the heap, will be managed by the cache pool
+		MeshData* data = new MeshData;
+
+		try
+		{
+			_generator(data);
+		}
+		catch (std::exception& excp)
+		{
+			delete data;
+			data = nullptr;
+
+			QString msg = QString("The mesh could not be generated: %1").arg(excp.what());
+			_block->setStatus(PipelineItemStatus::Sick, msg);
+		}
+
+		return data;
 	}
 }
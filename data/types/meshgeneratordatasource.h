@@ -29,12 +29,16 @@
 #include <QVector2D>
 #include <QVector3D>
 
+#include <functional>
+
 #include "geometrydatasource.h"
 
 namespace ysm
 {
 	/**
-	 * @brief Simple Mesh generator
+	 * @brief Parametric mesh generator
+	 * The create functions only validate and store the parameters; the actual geometry is generated on demand and
+	 * cached by its parameter key. All generators precompute the final sizes and write straight into the attribute streams.
 	 */
 	class MeshGeneratorDataSource : public GeometryDataSource
 	{
@@ -58,6 +62,11 @@ namespace ysm
 		 */
 		void createCircle(const float radius, const unsigned int sections, const QVector3D center = QVector3D(0.0f, 0.0f, 0.0f));
 
+		/**
+		 * @brief Creates a grid of size @p width x @p height at @p center, subdivided into @p columns x @p rows quads
+		 */
+		void createGrid(const float width, const float height, const unsigned int columns, const unsigned int rows, const QVector3D center = QVector3D(0.0f, 0.0f, 0.0f));
+
 		// 3D Geometry generation
 		/**
 		 * @brief Creates a cuboid of size @p width x @p height x @p depth at @p center and @interpolate the normals.
@@ -69,6 +78,31 @@ namespace ysm
          */
         void createSphere(const float radius, const float sections, const QVector3D center = QVector3D(0.0f, 0.0f, 0.0f));
 
+		/**
+		 * @brief Creates a UV sphere of radius @p radius at @p center, consisting of @p sections longitudinal and @p rings latitudinal segments
+		 */
+		void createUVSphere(const float radius, const unsigned int sections, const unsigned int rings, const QVector3D center = QVector3D(0.0f, 0.0f, 0.0f));
+
+		/**
+		 * @brief Creates an icosphere of radius @p radius at @p center by subdividing an icosahedron @p subdivisions times
+		 */
+		void createIcoSphere(const float radius, const unsigned int subdivisions, const QVector3D center = QVector3D(0.0f, 0.0f, 0.0f));
+
+		/**
+		 * @brief Creates a torus around the y axis with ring radius @p radius and tube radius @p tubeRadius at @p center
+		 */
+		void createTorus(const float radius, const float tubeRadius, const unsigned int sections, const unsigned int rings, const QVector3D center = QVector3D(0.0f, 0.0f, 0.0f));
+
+		/**
+		 * @brief Creates a capped cylinder along the y axis of radius @p radius and height @p height at @p center
+		 */
+		void createCylinder(const float radius, const float height, const unsigned int sections, const unsigned int rings, const QVector3D center = QVector3D(0.0f, 0.0f, 0.0f));
+
+		/**
+		 * @brief Creates a heightfield in the xz plane of size @p width x @p depth at @p center from the luminance of @p imageFile, scaled by @p height
+		 */
+		void createHeightfield(const QString& imageFile, const float width, const float height, const float depth, const QVector3D center = QVector3D(0.0f, 0.0f, 0.0f));
+
 	public:
 		// Data access
 		const Vec3Data& getVertexPositions() override;
@@ -82,13 +116,42 @@ namespace ysm
 		CacheObject::CacheObjectData*createCacheData() override;
 
 	private:
+		struct MeshData : CacheObject::CacheObjectData
+		{
+			Vec3Data vertexPositions;
+			Vec3Data vertexNormals;
+			Vec3Data textureCoordinates;
+			UIntData indexList;
+
+			/**
+			 * @brief Allocates all attribute streams for @p vertexCount vertices and @p indexCount indices
+			 */
+			void allocate(int vertexCount, int indexCount);
+
+			qint64 getMemorySize() const override
+			{
+				return getVectorSize(vertexPositions) + getVectorSize(vertexNormals) + getVectorSize(textureCoordinates)
+						+ getVectorSize(indexList);
+			}
+		} _emptyData;
+
+		using Generator = std::function<void(MeshData*)>;
+
+		/**
+		 * @brief Gets the cached mesh data
+		 * If no data could be generated, _emptyData is returned.
+		 */
+		const MeshData* getMeshData();
+
 		void clearGeometry();
 
+		/**
+		 * @brief Stores the generator for the geometry identified by @p cacheKey
+		 */
+		void setGenerator(const CacheObject::Key& cacheKey, const Generator& generator);
+
 	private:
-		Vec3Data _vertexPositions;
-		Vec3Data _vertexNormals;
-		Vec3Data _textureCoordinates;        
-		UIntData _indexList;
+		Generator _generator;
 
 		CacheObject::Key _cacheKey;
 	};
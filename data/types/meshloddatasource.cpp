@@ -0,0 +1,706 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "meshloddatasource.h"
+#include "data/common/threadpool.h"
+
+#include <QHash>
+#include <QSet>
+#include <QAtomicInt>
+#include <QtMath>
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+namespace ysm
+{
+	namespace
+	{
+		// Bounds of the level chain
+		const unsigned int MaxLevelCount = 16;
+		const float MinLevelRatio = 0.01f;
+		const float MaxLevelRatio = 0.99f;
+
+		// Weight of the planes keeping open borders in place
+		const double BorderWeight = 10.0;
+
+		/**
+		 * @brief Symmetric 4x4 matrix measuring the squared distance of a point to a set of planes (Garland & Heckbert)
+		 */
+		struct Quadric
+		{
+			double a2{0.0}, ab{0.0}, ac{0.0}, ad{0.0};
+			double b2{0.0}, bc{0.0}, bd{0.0};
+			double c2{0.0}, cd{0.0};
+			double d2{0.0};
+
+			/**
+			 * @brief Adds the plane through the given point with the given unit normal
+			 */
+			void addPlane(const QVector3D& normal, const QVector3D& point, double weight)
+			{
+				double a = normal.x();
+				double b = normal.y();
+				double c = normal.z();
+				double d = -QVector3D::dotProduct(normal, point);
+
+				a2 += weight * a * a; ab += weight * a * b; ac += weight * a * c; ad += weight * a * d;
+				b2 += weight * b * b; bc += weight * b * c; bd += weight * b * d;
+				c2 += weight * c * c; cd += weight * c * d;
+				d2 += weight * d * d;
+			}
+
+			Quadric& operator+=(const Quadric& other)
+			{
+				a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+				b2 += other.b2; bc += other.bc; bd += other.bd;
+				c2 += other.c2; cd += other.cd;
+				d2 += other.d2;
+
+				return *this;
+			}
+
+			/**
+			 * @brief Gets the sum of the squared distances of the point to all planes
+			 */
+			double evaluate(const QVector3D& p) const
+			{
+				double x = p.x();
+				double y = p.y();
+				double z = p.z();
+
+				double error = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+						+ b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+						+ c2 * z * z + 2.0 * cd * z
+						+ d2;
+
+				// Rounding may yield slightly negative values
+				return qMax(error, 0.0);
+			}
+		};
+
+		/**
+		 * @brief A possible edge collapse, ordered by its cost
+		 */
+		struct Collapse
+		{
+			double cost;
+			int from;
+			int to;
+			unsigned int fromVersion;
+			unsigned int toVersion;
+
+			bool operator>(const Collapse& other) const
+			{
+				return cost > other.cost;
+			}
+		};
+
+		/**
+		 * @brief Quadric error edge collapse of a triangle list, moving vertices onto their neighbours only
+		 * The vertices are the welded positions of the mesh, so that the mesh is not torn apart at attribute seams.
+		 */
+		class Simplifier
+		{
+		public:
+			Simplifier(const QVector<int>& triangles, const QVector<QVector3D>& positions, const QVector<Quadric>& quadrics) :
+				_triangles(triangles),
+				_positions(positions),
+				_quadrics(quadrics),
+				_removed(triangles.size() / 3, false),
+				_vertexTriangles(positions.size()),
+				_collapsedInto(positions.size(), -1),
+				_versions(positions.size(), 0),
+				_triangleCount(triangles.size() / 3)
+			{
+				for (int t = 0; t < _triangleCount; ++t)
+				{
+					for (int k = 0; k < 3; ++k)
+						_vertexTriangles[_triangles[t * 3 + k]].append(t);
+				}
+			}
+
+			/**
+			 * @brief Collapses edges until at most the given number of triangles is left or no edge can be collapsed
+			 * @return The largest squared error of any collapse performed
+			 */
+			double simplify(int targetTriangleCount)
+			{
+				double maxError = 0.0;
+
+				for (int t = 0; t < _triangleCount; ++t)
+				{
+					for (int k = 0; k < 3; ++k)
+						pushCollapse(_triangles[t * 3 + k], _triangles[t * 3 + (k + 1) % 3]);
+				}
+
+				int aliveCount = _triangleCount;
+
+				while (aliveCount > targetTriangleCount && !_candidates.empty())
+				{
+					Collapse collapse = _candidates.top();
+					_candidates.pop();
+
+					// Outdated candidates are dropped lazily
+					if (_collapsedInto[collapse.from] >= 0 || _collapsedInto[collapse.to] >= 0)
+						continue;
+
+					if (_versions[collapse.from] != collapse.fromVersion || _versions[collapse.to] != collapse.toVersion)
+						continue;
+
+					if (!isCollapseValid(collapse.from, collapse.to))
+						continue;
+
+					aliveCount -= applyCollapse(collapse.from, collapse.to);
+					maxError = qMax(maxError, collapse.cost);
+				}
+
+				return maxError;
+			}
+
+			/**
+			 * @brief Checks whether the given triangle survived the simplification
+			 */
+			bool isTriangleAlive(int triangle) const
+			{
+				return !_removed[triangle];
+			}
+
+			/**
+			 * @brief Gets the current (welded) vertex of a triangle corner
+			 */
+			int getCorner(int triangle, int corner) const
+			{
+				return _triangles[triangle * 3 + corner];
+			}
+
+		private:
+			void pushCollapse(int a, int b)
+			{
+				if (a == b)
+					return;
+
+				Quadric quadric = _quadrics[a];
+				quadric += _quadrics[b];
+
+				// Only the endpoints are considered, so that the vertex data can be shared by all levels
+				double costToB = quadric.evaluate(_positions[b]);
+				double costToA = quadric.evaluate(_positions[a]);
+
+				if (costToB <= costToA)
+					_candidates.push(Collapse{costToB, a, b, _versions[a], _versions[b]});
+				else
+					_candidates.push(Collapse{costToA, b, a, _versions[b], _versions[a]});
+			}
+
+			bool isCollapseValid(int from, int to) const
+			{
+				int sharedTriangles = 0;
+
+				for (int t : _vertexTriangles[from])
+				{
+					if (_removed[t])
+						continue;
+
+					if (contains(t, to))
+					{
+						sharedTriangles++;
+						continue;
+					}
+
+					// Moving the vertex must not flip or degenerate any of the remaining triangles
+					QVector3D corners[3];
+					for (int k = 0; k < 3; ++k)
+						corners[k] = _positions[_triangles[t * 3 + k]];
+
+					QVector3D before = QVector3D::crossProduct(corners[1] - corners[0], corners[2] - corners[0]);
+
+					for (int k = 0; k < 3; ++k)
+					{
+						if (_triangles[t * 3 + k] == from)
+							corners[k] = _positions[to];
+					}
+
+					QVector3D after = QVector3D::crossProduct(corners[1] - corners[0], corners[2] - corners[0]);
+
+					if (QVector3D::dotProduct(before, after) <= 0.0f)
+						return false;
+				}
+
+				// The edge might have vanished by earlier collapses
+				if (sharedTriangles == 0)
+					return false;
+
+				// Link condition: the endpoints may only share the neighbours opposite to the collapsed edge
+				QSet<int> fromNeighbours = getNeighbours(from);
+				QSet<int> toNeighbours = getNeighbours(to);
+
+				return fromNeighbours.intersect(toNeighbours).size() <= sharedTriangles;
+			}
+
+			int applyCollapse(int from, int to)
+			{
+				int removedCount = 0;
+
+				_quadrics[to] += _quadrics[from];
+
+				for (int t : _vertexTriangles[from])
+				{
+					if (_removed[t])
+						continue;
+
+					if (contains(t, to))
+					{
+						_removed[t] = true;
+						removedCount++;
+						continue;
+					}
+
+					for (int k = 0; k < 3; ++k)
+					{
+						if (_triangles[t * 3 + k] == from)
+							_triangles[t * 3 + k] = to;
+					}
+
+					_vertexTriangles[to].append(t);
+				}
+
+				_vertexTriangles[from].clear();
+				_collapsedInto[from] = to;
+				_versions[to]++;
+
+				// Drop the removed triangles and requeue the edges whose costs changed
+				QVector<int>& triangles = _vertexTriangles[to];
+				triangles.erase(std::remove_if(triangles.begin(), triangles.end(), [this](int t) { return _removed[t]; }), triangles.end());
+
+				for (int neighbour : getNeighbours(to))
+					pushCollapse(to, neighbour);
+
+				return removedCount;
+			}
+
+			bool contains(int triangle, int vertex) const
+			{
+				return _triangles[triangle * 3] == vertex || _triangles[triangle * 3 + 1] == vertex || _triangles[triangle * 3 + 2] == vertex;
+			}
+
+			QSet<int> getNeighbours(int vertex) const
+			{
+				QSet<int> neighbours;
+
+				for (int t : _vertexTriangles[vertex])
+				{
+					if (_removed[t])
+						continue;
+
+					for (int k = 0; k < 3; ++k)
+					{
+						if (_triangles[t * 3 + k] != vertex)
+							neighbours.insert(_triangles[t * 3 + k]);
+					}
+				}
+
+				return neighbours;
+			}
+
+		private:
+			QVector<int> _triangles;
+			const QVector<QVector3D>& _positions;
+			QVector<Quadric> _quadrics;
+
+			QVector<bool> _removed;
+			QVector<QVector<int>> _vertexTriangles;
+			QVector<int> _collapsedInto;
+			QVector<unsigned int> _versions;
+			int _triangleCount;
+
+			std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> _candidates;
+		};
+	}
+
+	class MeshLODDataSource::Task : public MeshProcessorDataSource::Task
+	{
+	public:
+		Options options;
+		LevelMeshData output;
+
+		QAtomicInt pendingLevels{0};
+
+		/**
+		 * @brief Prepares the mesh and schedules the simplification of all levels; called on a worker thread
+		 */
+		void run(const QSharedPointer<MeshProcessorDataSource::Task>& self) override;
+
+		MeshData* createResult() const override
+		{
+			return new LevelMeshData(output);
+		}
+
+	private:
+		// The triangles in welded vertices, shared by all levels
+		QVector<int> triangles;
+		QVector<QVector3D> weldedPositions;
+		QVector<Quadric> quadrics;
+
+		// Maps the vertices to their welded position and back
+		QVector<int> weldedIndex;
+		QVector<QVector<unsigned int>> weldedVertices;
+
+		// The result of each level
+		QVector<UIntData> levelIndices;
+		QVector<float> levelErrors;
+
+		void prepare();
+		void simplifyLevel(int level);
+		void complete();
+
+		unsigned int matchVertex(int welded, unsigned int original) const;
+	};
+
+	void MeshLODDataSource::Task::run(const QSharedPointer<MeshProcessorDataSource::Task>& self)
+	{
+		try
+		{
+			prepare();
+		}
+		catch (std::exception& excp)
+		{
+			setError(excp.what());
+			complete();
+			return;
+		}
+
+		// The first level is the unchanged mesh; all others are simplified independently of each other
+		int levelCount = levelIndices.size();
+		pendingLevels.storeRelease(levelCount - 1);
+
+		if (levelCount <= 1)
+		{
+			complete();
+			return;
+		}
+
+		// No worker ever waits for another one, so the levels cannot starve the thread pool
+		for (int level = 1; level < levelCount; ++level)
+		{
+			// The workers keep the task alive, even if the data source has moved on
+			ThreadPool::start([this, self, level]() {
+				simplifyLevel(level);
+
+				if (!pendingLevels.deref())
+					complete();
+			});
+		}
+	}
+
+	void MeshLODDataSource::Task::prepare()
+	{
+		int vertexCount = getVertexCount(input);
+
+		if (input.vertexPositions.isEmpty())
+			throw std::runtime_error{"The mesh has no vertex positions"};
+
+		// Non-indexed meshes are simplified as if every vertex was referenced once
+		UIntData indexList = input.indexList;
+
+		if (indexList.isEmpty())
+		{
+			indexList.resize(vertexCount);
+			for (int v = 0; v < vertexCount; ++v)
+				indexList[v] = v;
+		}
+
+		if (indexList.size() % 3 != 0)
+			throw std::runtime_error{"The index list does not describe a triangle list"};
+
+		for (unsigned int index : indexList)
+		{
+			if (index >= static_cast<unsigned int>(vertexCount))
+				throw std::runtime_error{"The index list references a non-existing vertex"};
+		}
+
+		// Weld vertices sharing a position, so that collapses work across normal and texture seams
+		QHash<QByteArray, int> uniquePositions;
+		weldedIndex.resize(vertexCount);
+
+		for (int v = 0; v < vertexCount; ++v)
+		{
+			const QVector3D& position = input.vertexPositions[v];
+			QByteArray key(reinterpret_cast<const char*>(&position), sizeof(QVector3D));
+
+			int welded = uniquePositions.value(key, -1);
+
+			if (welded < 0)
+			{
+				welded = weldedPositions.size();
+				uniquePositions.insert(key, welded);
+				weldedPositions.append(position);
+				weldedVertices.append(QVector<unsigned int>());
+			}
+
+			weldedIndex[v] = welded;
+			weldedVertices[welded].append(v);
+		}
+
+		triangles.resize(indexList.size());
+		for (int i = 0; i < indexList.size(); ++i)
+			triangles[i] = weldedIndex[indexList[i]];
+
+		// Accumulate the planes of all adjacent triangles, and count the edge uses to find open borders
+		quadrics.resize(weldedPositions.size());
+
+		QHash<QPair<int, int>, int> edgeUses;
+
+		for (int t = 0; t < triangles.size() / 3; ++t)
+		{
+			const QVector3D& p0 = weldedPositions[triangles[t * 3]];
+			const QVector3D& p1 = weldedPositions[triangles[t * 3 + 1]];
+			const QVector3D& p2 = weldedPositions[triangles[t * 3 + 2]];
+
+			QVector3D normal = QVector3D::crossProduct(p1 - p0, p2 - p0).normalized();
+
+			// Degenerated triangles don't define a plane
+			if (normal.isNull())
+				continue;
+
+			for (int k = 0; k < 3; ++k)
+				quadrics[triangles[t * 3 + k]].addPlane(normal, p0, 1.0);
+
+			for (int k = 0; k < 3; ++k)
+			{
+				int a = triangles[t * 3 + k];
+				int b = triangles[t * 3 + (k + 1) % 3];
+				edgeUses[qMakePair(qMin(a, b), qMax(a, b))]++;
+			}
+		}
+
+		if (options.preserveBorders)
+		{
+			for (int t = 0; t < triangles.size() / 3; ++t)
+			{
+				const QVector3D& p0 = weldedPositions[triangles[t * 3]];
+				const QVector3D& p1 = weldedPositions[triangles[t * 3 + 1]];
+				const QVector3D& p2 = weldedPositions[triangles[t * 3 + 2]];
+
+				QVector3D normal = QVector3D::crossProduct(p1 - p0, p2 - p0).normalized();
+
+				if (normal.isNull())
+					continue;
+
+				for (int k = 0; k < 3; ++k)
+				{
+					int a = triangles[t * 3 + k];
+					int b = triangles[t * 3 + (k + 1) % 3];
+
+					if (edgeUses.value(qMakePair(qMin(a, b), qMax(a, b))) != 1)
+						continue;
+
+					// A plane perpendicular to the triangle keeps the border from moving inwards
+					QVector3D edge = weldedPositions[b] - weldedPositions[a];
+					QVector3D borderNormal = QVector3D::crossProduct(edge, normal).normalized();
+
+					quadrics[a].addPlane(borderNormal, weldedPositions[a], BorderWeight);
+					quadrics[b].addPlane(borderNormal, weldedPositions[a], BorderWeight);
+				}
+			}
+		}
+
+		unsigned int levelCount = qBound(1u, options.levelCount, MaxLevelCount);
+
+		levelIndices.resize(levelCount);
+		levelErrors.fill(0.0f, levelCount);
+
+		levelIndices[0] = indexList;
+	}
+
+	void MeshLODDataSource::Task::simplifyLevel(int level)
+	{
+		try
+		{
+			float ratio = qBound(MinLevelRatio, options.levelRatio, MaxLevelRatio);
+			int triangleCount = triangles.size() / 3;
+			int targetCount = qMax(1, qFloor(triangleCount * qPow(ratio, level)));
+
+			Simplifier simplifier{triangles, weldedPositions, quadrics};
+			double maxError = simplifier.simplify(targetCount);
+
+			// The base index list is shared with the input, so it must only be read here
+			const UIntData& baseIndices = levelIndices.at(0);
+
+			UIntData indices;
+			indices.reserve(targetCount * 3);
+
+			for (int t = 0; t < triangleCount; ++t)
+			{
+				if (!simplifier.isTriangleAlive(t))
+					continue;
+
+				for (int k = 0; k < 3; ++k)
+					indices.append(matchVertex(simplifier.getCorner(t, k), baseIndices.at(t * 3 + k)));
+			}
+
+			// Every worker writes its own entries only
+			levelIndices[level] = indices;
+			levelErrors[level] = static_cast<float>(qSqrt(maxError));
+		}
+		catch (std::exception& excp)
+		{
+			setError(excp.what());
+		}
+	}
+
+	void MeshLODDataSource::Task::complete()
+	{
+		if (getError().isEmpty())
+		{
+			static_cast<MeshData&>(output) = input;
+			output.indexList.clear();
+
+			float maxError = 0.0f;
+
+			for (int level = 0; level < levelIndices.size(); ++level)
+			{
+				Level entry;
+				entry.firstIndex = output.indexList.size();
+				entry.indexCount = levelIndices[level].size();
+
+				// Coarser levels never deviate less than finer ones, which keeps the level selection monotonic
+				maxError = qMax(maxError, levelErrors[level]);
+				entry.error = maxError;
+
+				output.indexList += levelIndices[level];
+				output.levelChain.levels.append(entry);
+			}
+
+			// Bounding sphere around the center of the bounding box
+			QVector3D minimum = input.vertexPositions[0];
+			QVector3D maximum = input.vertexPositions[0];
+
+			for (const QVector3D& position : input.vertexPositions)
+			{
+				minimum = QVector3D(qMin(minimum.x(), position.x()), qMin(minimum.y(), position.y()), qMin(minimum.z(), position.z()));
+				maximum = QVector3D(qMax(maximum.x(), position.x()), qMax(maximum.y(), position.y()), qMax(maximum.z(), position.z()));
+			}
+
+			QVector3D center = (minimum + maximum) * 0.5f;
+			float radius = 0.0f;
+
+			for (const QVector3D& position : input.vertexPositions)
+				radius = qMax(radius, (position - center).length());
+
+			output.levelChain.boundsCenter = center;
+			output.levelChain.boundsRadius = radius;
+		}
+
+		// The intermediate data isn't needed any longer
+		triangles.clear();
+		weldedPositions.clear();
+		quadrics.clear();
+		weldedIndex.clear();
+		weldedVertices.clear();
+		levelIndices.clear();
+
+		finish();
+	}
+
+	unsigned int MeshLODDataSource::Task::matchVertex(int welded, unsigned int original) const
+	{
+		if (weldedIndex[original] == welded)
+			return original;
+
+		// The corner moved onto another position; take the vertex there whose attributes resemble the original ones most
+		const QVector<unsigned int>& candidates = weldedVertices[welded];
+
+		unsigned int bestVertex = candidates[0];
+		float bestDistance = std::numeric_limits<float>::max();
+
+		for (unsigned int candidate : candidates)
+		{
+			float distance = 0.0f;
+
+			if (!input.vertexNormals.isEmpty())
+				distance += (input.vertexNormals[candidate] - input.vertexNormals[original]).lengthSquared();
+
+			if (!input.textureCoordinates.isEmpty())
+				distance += (input.textureCoordinates[candidate] - input.textureCoordinates[original]).lengthSquared();
+
+			if (!input.vertexColors.isEmpty())
+				distance += (input.vertexColors[candidate] - input.vertexColors[original]).lengthSquared();
+
+			if (distance < bestDistance)
+			{
+				bestDistance = distance;
+				bestVertex = candidate;
+			}
+		}
+
+		return bestVertex;
+	}
+
+	MeshLODDataSource::MeshLODDataSource(Pipeline* pipeline, Block* block) : MeshProcessorDataSource(pipeline, block, "MeshLODDataSource")
+	{
+
+	}
+
+	void MeshLODDataSource::setOptions(const Options& options)
+	{
+		_options = options;
+	}
+
+	MeshLODDataSource::LevelChain MeshLODDataSource::getPendingLevelChain()
+	{
+		if (Task* task = static_cast<Task*>(getFinishedTask()))
+			return task->output.levelChain;
+
+		return LevelChain();
+	}
+
+	const MeshLODDataSource::LevelChain& MeshLODDataSource::getLevelChain()
+	{
+		// Without a result, the empty dummy without a level table is returned
+		const LevelMeshData* data = dynamic_cast<const LevelMeshData*>(getMeshData());
+
+		return data ? data->levelChain : _emptyLevelChain;
+	}
+
+	QString MeshLODDataSource::getOptionsKey() const
+	{
+		return QString("%1,%2,%3").arg(_options.levelCount).arg(_options.levelRatio).arg(_options.preserveBorders);
+	}
+
+	MeshProcessorDataSource::Task* MeshLODDataSource::createTask() const
+	{
+		Task* task = new Task;
+		task->options = _options;
+
+		return task;
+	}
+
+	QString MeshLODDataSource::getFailureMessage() const
+	{
+		return "The detail levels could not be generated";
+	}
+}
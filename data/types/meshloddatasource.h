@@ -0,0 +1,133 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef MESHLODDATASOURCE_H
+#define MESHLODDATASOURCE_H
+
+#include <QVector3D>
+
+#include "meshprocessordatasource.h"
+
+namespace ysm
+{
+	/**
+	 * @brief Data source simplifying the triangle mesh of another geometry data source into a chain of detail levels
+	 * Every level is derived from the full mesh by quadric error edge collapse onto existing vertices, so all levels share
+	 * the unchanged vertex attributes of the source. The index lists of all levels are packed into one index list, the
+	 * finest level first; the level table tells which range of it belongs to which level.
+	 * The levels are simplified in parallel on the global thread pool.
+	 */
+	class MeshLODDataSource : public MeshProcessorDataSource
+	{
+	public:
+		// Types
+		/**
+		 * @brief The simplification options
+		 */
+		struct Options
+		{
+			unsigned int levelCount{4};
+			float levelRatio{0.5f};
+			bool preserveBorders{true};
+		};
+
+		/**
+		 * @brief A single detail level within the packed index list
+		 */
+		struct Level
+		{
+			unsigned int firstIndex{0};
+			unsigned int indexCount{0};
+
+			// The largest geometric deviation from the full mesh, in object space units
+			float error{0.0f};
+		};
+
+		/**
+		 * @brief The level table, along with the bounding sphere of the mesh
+		 */
+		struct LevelChain
+		{
+			QVector<Level> levels;
+			QVector3D boundsCenter;
+			float boundsRadius{0.0f};
+		};
+
+	public:
+		explicit MeshLODDataSource(Pipeline* pipeline, Block* block);
+
+	public:
+		// Setup
+		/**
+		 * @brief Sets the simplification options
+		 */
+		void setOptions(const Options& options);
+
+		/**
+		 * @brief Gets the level table of the current result without waiting for it
+		 * As long as no result is available, the table is empty.
+		 */
+		LevelChain getPendingLevelChain();
+
+		/**
+		 * @brief Gets the level table of the current result, waiting for a running simplification
+		 */
+		const LevelChain& getLevelChain();
+
+	protected:
+		// MeshProcessorDataSource
+		QString getOptionsKey() const override;
+		MeshProcessorDataSource::Task* createTask() const override;
+		QString getFailureMessage() const override;
+
+	private:
+		/**
+		 * @brief The mesh along with its level table
+		 */
+		struct LevelMeshData : MeshData
+		{
+			LevelChain levelChain;
+
+			qint64 getMemorySize() const override
+			{
+				return MeshData::getMemorySize() + getVectorSize(levelChain.levels);
+			}
+		};
+
+		/**
+		 * @brief A single simplification, shared between the data source and the workers
+		 */
+		class Task;
+
+	private:
+		Options _options;
+
+		// Returned as long as no levels could be generated
+		LevelChain _emptyLevelChain;
+	};
+}
+
+#endif
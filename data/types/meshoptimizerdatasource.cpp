@@ -0,0 +1,662 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "meshoptimizerdatasource.h"
+
+#include <QHash>
+#include <QtMath>
+#include <algorithm>
+
+namespace ysm
+{
+	namespace
+	{
+		// Bounds of the simulated post-transform vertex cache
+		const unsigned int MinCacheSize = 4;
+		const unsigned int MaxCacheSize = 64;
+
+		// Forsyth's vertex scoring parameters
+		const float CacheDecayPower = 1.5f;
+		const float LastTriangleScore = 0.75f;
+		const float ValenceBoostScale = 2.0f;
+		const float ValenceBoostPower = 0.5f;
+		const int MaxPrecomputedValence = 32;
+
+		/**
+		 * @brief Vertex scores of Forsyth's linear-speed vertex cache optimization, precomputed for a given cache size
+		 */
+		class VertexScoreTable
+		{
+		public:
+			explicit VertexScoreTable(unsigned int cacheSize) : _cacheSize{cacheSize}
+			{
+				_cacheScores.resize(cacheSize);
+
+				for (unsigned int i = 0; i < cacheSize; ++i)
+				{
+					// The vertices of the last triangle get a fixed score, so that no strips are preferred
+					if (i < 3)
+						_cacheScores[i] = LastTriangleScore;
+					else
+						_cacheScores[i] = qPow(1.0f - float(i - 3) / (cacheSize - 3), CacheDecayPower);
+				}
+
+				_valenceScores.resize(MaxPrecomputedValence);
+
+				for (int i = 1; i < MaxPrecomputedValence; ++i)
+					_valenceScores[i] = ValenceBoostScale * qPow(float(i), -ValenceBoostPower);
+			}
+
+			float score(int cachePosition, int liveTriangles) const
+			{
+				// Vertices without any triangles left must never be preferred
+				if (liveTriangles == 0)
+					return -1.0f;
+
+				float score = (cachePosition >= 0 && cachePosition < int(_cacheSize)) ? _cacheScores[cachePosition] : 0.0f;
+
+				if (liveTriangles < MaxPrecomputedValence)
+					return score + _valenceScores[liveTriangles];
+
+				return score + ValenceBoostScale * qPow(float(liveTriangles), -ValenceBoostPower);
+			}
+
+		private:
+			unsigned int _cacheSize;
+
+			QVector<float> _cacheScores;
+			QVector<float> _valenceScores;
+		};
+
+		/**
+		 * @brief Simulates a FIFO vertex cache of @p cacheSize entries
+		 * Uses timestamps instead of an actual queue; flush empties the cache in constant time.
+		 */
+		class FifoCache
+		{
+		public:
+			FifoCache(int vertexCount, unsigned int cacheSize) : _timestamps(vertexCount, 0), _cacheSize{cacheSize}, _time{cacheSize + 1}
+			{
+
+			}
+
+			bool access(unsigned int index)
+			{
+				if (_time - _timestamps[index] > _cacheSize)
+				{
+					_timestamps[index] = _time++;
+					return false;
+				}
+
+				return true;
+			}
+
+			int accessTriangle(const unsigned int* triangle)
+			{
+				int misses = 0;
+
+				for (int k = 0; k < 3; ++k)
+				{
+					if (!access(triangle[k]))
+						++misses;
+				}
+
+				return misses;
+			}
+
+			void flush()
+			{
+				_time += _cacheSize + 1;
+			}
+
+		private:
+			QVector<unsigned int> _timestamps;
+			unsigned int _cacheSize;
+			unsigned int _time;
+		};
+
+		/**
+		 * @brief Computes the ACMR and ATVR of @p indices for a FIFO cache of @p cacheSize entries
+		 */
+		void analyzeVertexCache(const UIntData& indices, int vertexCount, unsigned int cacheSize, float& acmr, float& atvr)
+		{
+			FifoCache cache{vertexCount, cacheSize};
+			QVector<bool> referenced(vertexCount, false);
+			int misses = 0;
+			int uniqueVertices = 0;
+
+			for (unsigned int index : indices)
+			{
+				if (!cache.access(index))
+					++misses;
+
+				if (!referenced[index])
+				{
+					referenced[index] = true;
+					++uniqueVertices;
+				}
+			}
+
+			acmr = indices.isEmpty() ? 0.0f : float(misses) / (indices.size() / 3);
+			atvr = uniqueVertices == 0 ? 0.0f : float(misses) / uniqueVertices;
+		}
+
+		/**
+		 * @brief Reorders the triangles of @p indices using Forsyth's linear-speed vertex cache optimization
+		 */
+		UIntData optimizeVertexCache(const UIntData& indices, int vertexCount, unsigned int cacheSize)
+		{
+			const unsigned int* triangles = indices.constData();
+			int triangleCount = indices.size() / 3;
+			VertexScoreTable scores{cacheSize};
+
+			// Build the vertex-triangle adjacency; the live triangles of each vertex are kept at the front of its range
+			QVector<int> adjacencyOffsets(vertexCount + 1, 0);
+
+			for (unsigned int index : indices)
+				adjacencyOffsets[index + 1]++;
+
+			for (int v = 0; v < vertexCount; ++v)
+				adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+
+			QVector<int> adjacency(indices.size());
+			QVector<int> liveTriangles(vertexCount);
+			QVector<int> fillOffsets = adjacencyOffsets;
+
+			for (int v = 0; v < vertexCount; ++v)
+				liveTriangles[v] = adjacencyOffsets[v + 1] - adjacencyOffsets[v];
+
+			for (int i = 0; i < indices.size(); ++i)
+				adjacency[fillOffsets[triangles[i]]++] = i / 3;
+
+			// Initial scores
+			QVector<int> cachePositions(vertexCount, -1);
+			QVector<float> vertexScores(vertexCount);
+			QVector<float> triangleScores(triangleCount);
+			QVector<bool> emitted(triangleCount, false);
+
+			for (int v = 0; v < vertexCount; ++v)
+				vertexScores[v] = scores.score(-1, liveTriangles[v]);
+
+			int bestTriangle = -1;
+			float bestScore = -1.0f;
+
+			for (int t = 0; t < triangleCount; ++t)
+			{
+				triangleScores[t] = vertexScores[triangles[t * 3]] + vertexScores[triangles[t * 3 + 1]] + vertexScores[triangles[t * 3 + 2]];
+
+				if (triangleScores[t] > bestScore)
+				{
+					bestScore = triangleScores[t];
+					bestTriangle = t;
+				}
+			}
+
+			UIntData result;
+			result.reserve(indices.size());
+
+			QVector<unsigned int> cache;
+			QVector<unsigned int> newCache;
+			int scanPosition = 0;
+
+			cache.reserve(cacheSize + 3);
+			newCache.reserve(cacheSize + 3);
+
+			while (bestTriangle >= 0)
+			{
+				const unsigned int* triangle = triangles + bestTriangle * 3;
+
+				emitted[bestTriangle] = true;
+				newCache.clear();
+
+				for (int k = 0; k < 3; ++k)
+				{
+					unsigned int v = triangle[k];
+					result.append(v);
+
+					// Remove the triangle from the live triangles of the vertex
+					int begin = adjacencyOffsets[v];
+					int end = begin + liveTriangles[v];
+
+					for (int i = begin; i < end; ++i)
+					{
+						if (adjacency[i] == bestTriangle)
+						{
+							adjacency[i] = adjacency[end - 1];
+							liveTriangles[v]--;
+							break;
+						}
+					}
+
+					if (!newCache.contains(v))
+						newCache.append(v);
+				}
+
+				// The emitted vertices move to the front of the cache
+				for (unsigned int v : cache)
+				{
+					if (!newCache.contains(v))
+						newCache.append(v);
+				}
+
+				// Update the scores of all vertices that were or are in the cache, including the ones falling out
+				for (int i = 0; i < newCache.size(); ++i)
+				{
+					unsigned int v = newCache[i];
+
+					cachePositions[v] = (i < int(cacheSize)) ? i : -1;
+
+					float score = scores.score(cachePositions[v], liveTriangles[v]);
+					float delta = score - vertexScores[v];
+
+					vertexScores[v] = score;
+
+					for (int j = adjacencyOffsets[v], end = adjacencyOffsets[v] + liveTriangles[v]; j < end; ++j)
+						triangleScores[adjacency[j]] += delta;
+				}
+
+				if (newCache.size() > int(cacheSize))
+					newCache.resize(cacheSize);
+
+				std::swap(cache, newCache);
+
+				// The next triangle is the best one touching the cache
+				bestTriangle = -1;
+				bestScore = -1.0f;
+
+				for (unsigned int v : cache)
+				{
+					for (int j = adjacencyOffsets[v], end = adjacencyOffsets[v] + liveTriangles[v]; j < end; ++j)
+					{
+						int t = adjacency[j];
+
+						if (triangleScores[t] > bestScore)
+						{
+							bestScore = triangleScores[t];
+							bestTriangle = t;
+						}
+					}
+				}
+
+				// If the cache is exhausted, continue with the next triangle in input order
+				if (bestTriangle < 0)
+				{
+					while (scanPosition < triangleCount && emitted[scanPosition])
+						++scanPosition;
+
+					if (scanPosition < triangleCount)
+						bestTriangle = scanPosition;
+				}
+			}
+
+			return result;
+		}
+
+		/**
+		 * @brief Reorders clusters of the cache optimized @p indices so that outward facing clusters are drawn first
+		 * Clusters start where the cache simulation restarts (all vertices of a triangle miss) and are split further as long
+		 * as the ACMR of the split parts stays within @p threshold of the cluster's ACMR.
+		 */
+		UIntData optimizeOverdraw(const UIntData& indices, const Vec3Data& positions, unsigned int cacheSize, float threshold)
+		{
+			const unsigned int* triangles = indices.constData();
+			int triangleCount = indices.size() / 3;
+
+			// Hard boundaries
+			QVector<int> hardBoundaries;
+			FifoCache cache{positions.size(), cacheSize};
+
+			for (int t = 0; t < triangleCount; ++t)
+			{
+				if (cache.accessTriangle(triangles + t * 3) == 3 || t == 0)
+					hardBoundaries.append(t);
+			}
+
+			hardBoundaries.append(triangleCount);
+
+			// Soft boundaries
+			QVector<int> clusters;
+
+			for (int c = 0; c + 1 < hardBoundaries.size(); ++c)
+			{
+				int begin = hardBoundaries[c];
+				int end = hardBoundaries[c + 1];
+				int misses = 0;
+
+				cache.flush();
+
+				for (int t = begin; t < end; ++t)
+					misses += cache.accessTriangle(triangles + t * 3);
+
+				float clusterACMR = float(misses) / (end - begin);
+				int start = begin;
+
+				cache.flush();
+				misses = 0;
+				clusters.append(begin);
+
+				for (int t = begin; t < end - 1; ++t)
+				{
+					misses += cache.accessTriangle(triangles + t * 3);
+
+					if (float(misses) / (t + 1 - start) <= threshold * clusterACMR)
+					{
+						start = t + 1;
+						misses = 0;
+
+						cache.flush();
+						clusters.append(start);
+					}
+				}
+			}
+
+			clusters.append(triangleCount);
+
+			// Determine the area weighted centroid and the normal of every cluster
+			struct Cluster
+			{
+				int begin;
+				int end;
+				QVector3D centroid;
+				QVector3D normal;
+				float area;
+				float sortKey;
+			};
+
+			QVector<Cluster> sortedClusters;
+			QVector3D meshCentroid;
+			float meshArea = 0.0f;
+
+			for (int c = 0; c + 1 < clusters.size(); ++c)
+			{
+				Cluster cluster{clusters[c], clusters[c + 1], QVector3D(), QVector3D(), 0.0f, 0.0f};
+
+				for (int t = cluster.begin; t < cluster.end; ++t)
+				{
+					const QVector3D& p0 = positions[triangles[t * 3]];
+					const QVector3D& p1 = positions[triangles[t * 3 + 1]];
+					const QVector3D& p2 = positions[triangles[t * 3 + 2]];
+
+					QVector3D normal = QVector3D::crossProduct(p1 - p0, p2 - p0);
+					float area = normal.length();
+
+					cluster.centroid += (p0 + p1 + p2) * (area / 3.0f);
+					cluster.normal += normal;
+					cluster.area += area;
+				}
+
+				meshCentroid += cluster.centroid;
+				meshArea += cluster.area;
+
+				if (cluster.area > 0.0f)
+					cluster.centroid /= cluster.area;
+
+				sortedClusters.append(cluster);
+			}
+
+			if (meshArea > 0.0f)
+				meshCentroid /= meshArea;
+
+			for (Cluster& cluster : sortedClusters)
+				cluster.sortKey = QVector3D::dotProduct(cluster.centroid - meshCentroid, cluster.normal.normalized());
+
+			std::stable_sort(sortedClusters.begin(), sortedClusters.end(), [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+			UIntData result;
+			result.reserve(indices.size());
+
+			for (const Cluster& cluster : sortedClusters)
+			{
+				for (int i = cluster.begin * 3; i < cluster.end * 3; ++i)
+					result.append(triangles[i]);
+			}
+
+			return result;
+		}
+
+		/**
+		 * @brief Moves the elements of @p data to their positions in @p remap; elements mapped to -1 are dropped
+		 */
+		template<typename T>
+		void remapVertices(QVector<T>& data, const QVector<int>& remap, int vertexCount)
+		{
+			if (data.isEmpty())
+				return;
+
+			QVector<T> remapped(vertexCount);
+
+			for (int i = 0; i < data.size(); ++i)
+			{
+				if (remap[i] >= 0)
+					remapped[remap[i]] = data[i];
+			}
+
+			data = remapped;
+		}
+
+		/**
+		 * @brief Remaps a vertex attribute
+		 */
+		struct RemapAttribute
+		{
+			const QVector<int>& remap;
+			int vertexCount;
+
+			template<typename T>
+			void operator()(QVector<T>& data) const
+			{
+				remapVertices(data, remap, vertexCount);
+			}
+		};
+
+		/**
+		 * @brief Appends the raw bytes of a single vertex attribute to a key
+		 */
+		struct AppendVertexKey
+		{
+			QByteArray& key;
+			int index;
+
+			template<typename T>
+			void operator()(const QVector<T>& data) const
+			{
+				if (!data.isEmpty())
+					key.append(reinterpret_cast<const char*>(&data[index]), sizeof(T));
+			}
+		};
+	}
+
+	class MeshOptimizerDataSource::Task : public MeshProcessorDataSource::Task
+	{
+	public:
+		Options options;
+
+		MeshData output;
+		Statistics statistics;
+
+		/**
+		 * @brief Performs the optimization; called on a worker thread
+		 */
+		void run(const QSharedPointer<MeshProcessorDataSource::Task>& self) override;
+
+		MeshData* createResult() const override
+		{
+			return new MeshData(output);
+		}
+
+	private:
+		template<typename F>
+		void forEachAttribute(MeshData& data, F func)
+		{
+			func(data.vertexPositions);
+			func(data.vertexNormals);
+			func(data.vertexTangents);
+			func(data.vertexBitangents);
+			func(data.vertexColors);
+			func(data.textureCoordinates);
+		}
+
+		void createIndexList(MeshData& data, int vertexCount);
+	};
+
+	void MeshOptimizerDataSource::Task::run(const QSharedPointer<MeshProcessorDataSource::Task>& self)
+	{
+		Q_UNUSED(self);
+
+		try
+		{
+			MeshData data = input;
+			int vertexCount = getVertexCount(data);
+			unsigned int cacheSize = qBound(MinCacheSize, options.cacheSize, MaxCacheSize);
+
+			// Non-indexed meshes are drawn without any vertex reuse
+			if (data.indexList.isEmpty())
+			{
+				if (vertexCount % 3 != 0)
+					throw std::runtime_error{"The vertices do not describe a triangle list"};
+
+				statistics.acmrBefore = vertexCount > 0 ? 3.0f : 0.0f;
+				statistics.atvrBefore = vertexCount > 0 ? 1.0f : 0.0f;
+
+				createIndexList(data, vertexCount);
+				vertexCount = getVertexCount(data);
+			}
+			else
+			{
+				if (data.indexList.size() % 3 != 0)
+					throw std::runtime_error{"The index list does not describe a triangle list"};
+
+				for (unsigned int index : data.indexList)
+				{
+					if (index >= static_cast<unsigned int>(vertexCount))
+						throw std::runtime_error{"The index list references a non-existing vertex"};
+				}
+
+				analyzeVertexCache(data.indexList, vertexCount, cacheSize, statistics.acmrBefore, statistics.atvrBefore);
+			}
+
+			if (options.vertexCache)
+				data.indexList = optimizeVertexCache(data.indexList, vertexCount, cacheSize);
+
+			if (options.overdraw && !data.vertexPositions.isEmpty())
+				data.indexList = optimizeOverdraw(data.indexList, data.vertexPositions, cacheSize, qMax(options.overdrawThreshold, 1.0f));
+
+			if (options.vertexFetch)
+			{
+				// Number the vertices in order of their first use
+				QVector<int> remap(vertexCount, -1);
+				int usedVertices = 0;
+
+				for (unsigned int& index : data.indexList)
+				{
+					if (remap[index] < 0)
+						remap[index] = usedVertices++;
+
+					index = remap[index];
+				}
+
+				forEachAttribute(data, RemapAttribute{remap, usedVertices});
+				vertexCount = usedVertices;
+			}
+
+			analyzeVertexCache(data.indexList, vertexCount, cacheSize, statistics.acmrAfter, statistics.atvrAfter);
+
+			output = data;
+		}
+		catch (std::exception& excp)
+		{
+			setError(excp.what());
+		}
+
+		finish();
+	}
+
+	void MeshOptimizerDataSource::Task::createIndexList(MeshData& data, int vertexCount)
+	{
+		// Merge vertices with identical attributes
+		QHash<QByteArray, int> uniqueVertices;
+		QVector<int> remap(vertexCount, -1);
+
+		data.indexList.resize(vertexCount);
+
+		for (int v = 0; v < vertexCount; ++v)
+		{
+			QByteArray key;
+
+			forEachAttribute(data, AppendVertexKey{key, v});
+
+			int index = uniqueVertices.value(key, -1);
+
+			if (index < 0)
+			{
+				// First occurrence; later duplicates are dropped
+				index = uniqueVertices.size();
+				uniqueVertices.insert(key, index);
+				remap[v] = index;
+			}
+
+			data.indexList[v] = index;
+		}
+
+		forEachAttribute(data, RemapAttribute{remap, uniqueVertices.size()});
+	}
+
+	MeshOptimizerDataSource::MeshOptimizerDataSource(Pipeline* pipeline, Block* block) : MeshProcessorDataSource(pipeline, block, "MeshOptimizerDataSource")
+	{
+
+	}
+
+	void MeshOptimizerDataSource::setOptions(const Options& options)
+	{
+		_options = options;
+	}
+
+	MeshOptimizerDataSource::Statistics MeshOptimizerDataSource::getStatistics()
+	{
+		if (Task* task = static_cast<Task*>(getFinishedTask()))
+			return task->statistics;
+
+		return Statistics();
+	}
+
+	QString MeshOptimizerDataSource::getOptionsKey() const
+	{
+		return QString("%1,%2,%3,%4/%5").arg(_options.vertexCache).arg(_options.vertexFetch).arg(_options.overdraw)
+				.arg(_options.overdrawThreshold).arg(_options.cacheSize);
+	}
+
+	MeshProcessorDataSource::Task* MeshOptimizerDataSource::createTask() const
+	{
+		Task* task = new Task;
+		task->options = _options;
+
+		return task;
+	}
+
+	QString MeshOptimizerDataSource::getFailureMessage() const
+	{
+		return "The mesh could not be optimized";
+	}
+}
@@ -0,0 +1,99 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef MESHOPTIMIZERDATASOURCE_H
+#define MESHOPTIMIZERDATASOURCE_H
+
+#include "meshprocessordatasource.h"
+
+namespace ysm
+{
+	/**
+	 * @brief Data source optimizing the triangle mesh of another geometry data source
+	 * The index list is reordered for the post-transform vertex cache (Forsyth), optionally followed by an overdraw-aware
+	 * cluster ordering, and the vertices are reordered for fetch locality. Non-indexed input is indexed first.
+	 */
+	class MeshOptimizerDataSource : public MeshProcessorDataSource
+	{
+	public:
+		// Types
+		/**
+		 * @brief The optimization options
+		 */
+		struct Options
+		{
+			bool vertexCache{true};
+			bool vertexFetch{true};
+			bool overdraw{false};
+			float overdrawThreshold{1.05f};
+			unsigned int cacheSize{16};
+		};
+
+		/**
+		 * @brief Vertex cache statistics before and after the optimization
+		 * The average cache miss ratio (ACMR) is given per triangle, the average transformed vertex ratio (ATVR) per vertex.
+		 */
+		struct Statistics
+		{
+			float acmrBefore{0.0f};
+			float acmrAfter{0.0f};
+			float atvrBefore{0.0f};
+			float atvrAfter{0.0f};
+		};
+
+	public:
+		explicit MeshOptimizerDataSource(Pipeline* pipeline, Block* block);
+
+	public:
+		// Setup
+		/**
+		 * @brief Sets the optimization options
+		 */
+		void setOptions(const Options& options);
+
+		/**
+		 * @brief Gets the statistics of the current result without waiting for it
+		 * As long as no result is available, all values are zero.
+		 */
+		Statistics getStatistics();
+
+	protected:
+		// MeshProcessorDataSource
+		QString getOptionsKey() const override;
+		MeshProcessorDataSource::Task* createTask() const override;
+		QString getFailureMessage() const override;
+
+	private:
+		/**
+		 * @brief A single optimization, shared between the data source and the worker
+		 */
+		class Task;
+
+	private:
+		Options _options;
+	};
+}
+
+#endif
@@ -0,0 +1,258 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "meshprocessordatasource.h"
+#include "data/blocks/block.h"
+#include "data/common/threadpool.h"
+
+#include <stdexcept>
+
+namespace ysm
+{
+	bool MeshProcessorDataSource::Task::isFinished() const
+	{
+		return _finished.loadAcquire();
+	}
+
+	void MeshProcessorDataSource::Task::wait()
+	{
+		_done.acquire();
+		_done.release();
+	}
+
+	QString MeshProcessorDataSource::Task::getError() const
+	{
+		QMutexLocker locker{&_errorMutex};
+
+		return _error;
+	}
+
+	void MeshProcessorDataSource::Task::setError(const QString& message)
+	{
+		QMutexLocker locker{&_errorMutex};
+
+		if (_error.isEmpty())
+			_error = message;
+	}
+
+	void MeshProcessorDataSource::Task::finish()
+	{
+		_finished.storeRelease(1);
+		_done.release();
+	}
+
+	int MeshProcessorDataSource::Task::getVertexCount(const MeshData& data)
+	{
+		int vertexCount = -1;
+
+		auto count = [&vertexCount](int size) {
+			if (size == 0)
+				return;
+
+			if (vertexCount >= 0 && size != vertexCount)
+				throw std::runtime_error{"All vertex attributes must have the same number of elements"};
+
+			vertexCount = size;
+		};
+
+		count(data.vertexPositions.size());
+		count(data.vertexNormals.size());
+		count(data.vertexTangents.size());
+		count(data.vertexBitangents.size());
+		count(data.vertexColors.size());
+		count(data.textureCoordinates.size());
+
+		return qMax(vertexCount, 0);
+	}
+
+	MeshProcessorDataSource::MeshProcessorDataSource(Pipeline* pipeline, Block* block, const QString& name) : GeometryDataSource(pipeline, block),
+		_name{name}
+	{
+		// The outputs don't depend on the source, so connections survive changing it
+		_outputs = VertexPositions|VertexNormals|VertexTangents|VertexBitangents|VertexColors|TextureCoordinates|IndexList;
+	}
+
+	void MeshProcessorDataSource::setSource(GeometryDataSource* source)
+	{
+		_source = source;
+	}
+
+	void MeshProcessorDataSource::startProcessing()
+	{
+		if (!_source)
+		{
+			_task.reset();
+			return;
+		}
+
+		CacheObject::Key key = getCacheKey(true);
+
+		if (_task && _task->key == key)
+			return;
+
+		QSharedPointer<Task> task{createTask()};
+
+		task->key = key;
+
+		// The source data is implicitly shared, so copying it for the workers is cheap
+		if (_source->hasOutputs(VertexPositions))
+			task->input.vertexPositions = _source->getVertexPositions();
+
+		if (_source->hasOutputs(VertexNormals))
+			task->input.vertexNormals = _source->getVertexNormals();
+
+		if (_source->hasOutputs(VertexTangents))
+			task->input.vertexTangents = _source->getVertexTangents();
+
+		if (_source->hasOutputs(VertexBitangents))
+			task->input.vertexBitangents = _source->getVertexBitangents();
+
+		if (_source->hasOutputs(VertexColors))
+			task->input.vertexColors = _source->getVertexColors();
+
+		if (_source->hasOutputs(TextureCoordinates))
+			task->input.textureCoordinates = _source->getTextureCoordinates();
+
+		if (_source->hasOutputs(IndexList))
+			task->input.indexList = _source->getIndexList();
+
+		_task = task;
+
+		ThreadPool::start([task]() { task->run(task); });
+	}
+
+	bool MeshProcessorDataSource::isProcessing() const
+	{
+		return _task && !_task->isFinished();
+	}
+
+	MeshProcessorDataSource::Task* MeshProcessorDataSource::getFinishedTask()
+	{
+		startProcessing();
+
+		if (_task && _task->isFinished())
+			return _task.data();
+
+		return nullptr;
+	}
+
+	const Vec3Data& MeshProcessorDataSource::getVertexPositions()
+	{
+		return getMeshData()->vertexPositions;
+	}
+
+	const Vec3Data& MeshProcessorDataSource::getVertexNormals()
+	{
+		return getMeshData()->vertexNormals;
+	}
+
+	const Vec3Data& MeshProcessorDataSource::getVertexTangents()
+	{
+		return getMeshData()->vertexTangents;
+	}
+
+	const Vec3Data& MeshProcessorDataSource::getVertexBitangents()
+	{
+		return getMeshData()->vertexBitangents;
+	}
+
+	const Vec4Data& MeshProcessorDataSource::getVertexColors()
+	{
+		return getMeshData()->vertexColors;
+	}
+
+	const Vec3Data& MeshProcessorDataSource::getTextureCoordinates()
+	{
+		return getMeshData()->textureCoordinates;
+	}
+
+	const UIntData& MeshProcessorDataSource::getIndexList()
+	{
+		return getMeshData()->indexList;
+	}
+
+	const MeshProcessorDataSource::MeshData* MeshProcessorDataSource::getMeshData()
+	{
+		const MeshData* data = getCachedData<MeshData>();
+
+		if (!data)
+		{
+			// Nothing connected or the processing failed; return an empty dummy
+			data = &_emptyData;
+		}
+
+		return data;
+	}
+
+	CacheObject::Key MeshProcessorDataSource::getCacheKey(bool retrieveForeignKey)
+	{
+		Q_UNUSED(retrieveForeignKey);
+
+		if (!_source || _resolvingKey)
+			return _name + "/None";
+
+		// The result only depends on the source data and the options
+		_resolvingKey = true;
+		CacheObject::Key sourceKey = _source->getCacheKey(true);
+		_resolvingKey = false;
+
+		return QString("%1/%2/%3").arg(_name).arg(sourceKey).arg(getOptionsKey());
+	}
+
+	CacheObject::CacheObjectData* MeshProcessorDataSource::createCacheData()
+	{
+		if (!_source)
+			return nullptr;
+
+		QSharedPointer<Task> task;
+
+		try
+		{
+			startProcessing();
+			task = _task;
+		}
+		catch (std::exception& excp)
+		{
+			QString msg = QString("The source mesh could not be retrieved: %1").arg(excp.what());
+			_block->setStatus(PipelineItemStatus::Sick, msg);
+			return nullptr;
+		}
+
+		// Usually the processing has been started long before the data is needed
+		task->wait();
+
+		QString error = task->getError();
+
+		if (!error.isEmpty())
+		{
+			QString msg = QString("%1: %2").arg(getFailureMessage()).arg(error);
+			_block->setStatus(PipelineItemStatus::Sick, msg);
+			return nullptr;
+		}
+
+		// Data must be created on the heap, will be managed by the cache pool
+		return task->createResult();
+	}
+}
@@ -0,0 +1,207 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef MESHPROCESSORDATASOURCE_H
+#define MESHPROCESSORDATASOURCE_H
+
+#include <QSharedPointer>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QSemaphore>
+
+#include "geometrydatasource.h"
+
+namespace ysm
+{
+	/**
+	 * @brief Base for data sources processing the triangle mesh of another geometry data source in the background
+	 * The processing runs on the global thread pool as soon as startProcessing is called; the result is cached by the
+	 * source key and the options of the derived data source. All geometry outputs are provided; outputs the source lacks stay empty.
+	 */
+	class MeshProcessorDataSource : public GeometryDataSource
+	{
+	public:
+		// Types
+		/**
+		 * @brief The attributes of a mesh
+		 */
+		struct MeshData : CacheObject::CacheObjectData
+		{
+			Vec3Data vertexPositions;
+			Vec3Data vertexNormals;
+			Vec3Data vertexTangents;
+			Vec3Data vertexBitangents;
+			Vec4Data vertexColors;
+			Vec3Data textureCoordinates;
+			UIntData indexList;
+
+			qint64 getMemorySize() const override
+			{
+				return getVectorSize(vertexPositions) + getVectorSize(vertexNormals) + getVectorSize(vertexTangents)
+						+ getVectorSize(vertexBitangents) + getVectorSize(vertexColors) + getVectorSize(textureCoordinates)
+						+ getVectorSize(indexList);
+			}
+		};
+
+		/**
+		 * @brief A single processing run, shared between the data source and the workers
+		 */
+		class Task
+		{
+		public:
+			virtual ~Task() { }
+
+			/**
+			 * @brief Processes the input; called on a worker thread
+			 * The processing may be continued by further workers; whichever finishes last has to call finish.
+			 */
+			virtual void run(const QSharedPointer<Task>& self) = 0;
+
+			/**
+			 * @brief Creates the data to be cached from the result; only called if no error occurred
+			 */
+			virtual MeshData* createResult() const = 0;
+
+			/**
+			 * @brief Checks whether the processing has finished
+			 */
+			bool isFinished() const;
+
+			/**
+			 * @brief Blocks until the processing has finished
+			 */
+			void wait();
+
+			/**
+			 * @brief Gets the first error that occurred, or an empty string
+			 */
+			QString getError() const;
+
+		public:
+			CacheObject::Key key;
+			MeshData input;
+
+		protected:
+			/**
+			 * @brief Records an error; only the first one is kept
+			 */
+			void setError(const QString& message);
+
+			/**
+			 * @brief Marks the processing as finished and wakes up all waiting threads
+			 */
+			void finish();
+
+			/**
+			 * @brief Determines the common element count of all non-empty vertex attributes of @p data
+			 * If the counts differ, an exception is thrown.
+			 */
+			static int getVertexCount(const MeshData& data);
+
+		private:
+			QString _error;
+			mutable QMutex _errorMutex;
+
+			QAtomicInt _finished{0};
+			QSemaphore _done;
+		};
+
+	public:
+		explicit MeshProcessorDataSource(Pipeline* pipeline, Block* block, const QString& name);
+
+	public:
+		// Setup
+		/**
+		 * @brief Sets the data source to process (or null to disconnect it)
+		 */
+		void setSource(GeometryDataSource* source);
+
+		/**
+		 * @brief Starts processing the current source, unless the result for the current key is already available or pending
+		 * The source data is retrieved on the calling thread; if an error occurs, an exception is thrown.
+		 */
+		void startProcessing();
+
+		/**
+		 * @brief Checks whether a processing is still running
+		 */
+		bool isProcessing() const;
+
+	public:
+		// Data access
+		const Vec3Data& getVertexPositions() override;
+		const Vec3Data& getVertexNormals() override;
+		const Vec3Data& getVertexTangents() override;
+		const Vec3Data& getVertexBitangents() override;
+		const Vec4Data& getVertexColors() override;
+		const Vec3Data& getTextureCoordinates() override;
+		const UIntData& getIndexList() override;
+
+	public:
+		// ICacheable
+		CacheObject::Key getCacheKey(bool retrieveForeignKey) override;
+		CacheObject::CacheObjectData* createCacheData() override;
+
+	protected:
+		/**
+		 * @brief Gets the part of the cache key describing the current options
+		 */
+		virtual QString getOptionsKey() const = 0;
+
+		/**
+		 * @brief Creates a task processing the mesh with the current options
+		 */
+		virtual Task* createTask() const = 0;
+
+		/**
+		 * @brief Gets the message a failed processing is reported with, followed by the error
+		 */
+		virtual QString getFailureMessage() const = 0;
+
+		/**
+		 * @brief Starts processing if necessary and gets the task without waiting for it
+		 * As long as no result is available, null is returned.
+		 */
+		Task* getFinishedTask();
+
+		/**
+		 * @brief Gets the cached mesh data, waiting for a running processing
+		 * If no data could be generated, an empty dummy is returned.
+		 */
+		const MeshData* getMeshData();
+
+	private:
+		QString _name;
+		MeshData _emptyData;
+
+		GeometryDataSource* _source{nullptr};
+		QSharedPointer<Task> _task;
+
+		// Guards against cycles of processors
+		bool _resolvingKey{false};
+	};
+}
+
+#endif
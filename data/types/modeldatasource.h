@@ -108,6 +108,20 @@ namespace ysm
 			};
 
 			QVector<MeshData> meshes;
+
+			qint64 getMemorySize() const override
+			{
+				qint64 size = getVectorSize(meshes);
+
+				for (const MeshData& mesh : meshes)
+				{
+					size += getVectorSize(mesh.vertexPositions) + getVectorSize(mesh.vertexNormals) + getVectorSize(mesh.vertexTangents)
+							+ getVectorSize(mesh.vertexBitangents) + getVectorSize(mesh.vertexColors)
+							+ getVectorSize(mesh.textureCoordinates) + getVectorSize(mesh.indexList);
+				}
+
+				return size;
+			}
 		} _emptyData;
 
 		/**
@@ -0,0 +1,604 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "parallelprimitives.h"
+#include "data/common/threadpool.h"
+
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QtMath>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+#include <stdexcept>
+
+namespace ysm
+{
+	namespace
+	{
+		// Elements per hardware thread, below which chunks aren't worth the scheduling overhead
+		const unsigned int MinGrainSize = 4096;
+
+		// Radix sort digit width
+		const int RadixBits = 8;
+		const int RadixSize = 1 << RadixBits;
+
+		// Tolerance when verifying floating point results, as the parallel order of operations differs
+		const float FloatTolerance = 1e-4f;
+
+		/**
+		 * @brief Gets the first element of @p chunk
+		 */
+		inline int chunkBegin(int count, int chunkCount, int chunk)
+		{
+			return static_cast<int>(static_cast<qint64>(count) * chunk / chunkCount);
+		}
+
+		// Order-preserving conversion of keys to unsigned integers
+		inline quint32 toRadixKey(unsigned int value)
+		{
+			return value;
+		}
+
+		inline quint32 toRadixKey(int value)
+		{
+			return static_cast<quint32>(value) ^ 0x80000000u;
+		}
+
+		inline quint32 toRadixKey(float value)
+		{
+			quint32 bits;
+			memcpy(&bits, &value, sizeof(bits));
+
+			// Negative numbers are ordered reversed, positive ones behind them
+			return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+		}
+
+		// Scan and reduction operators
+		template<typename T>
+		struct SumOperator
+		{
+			static T identity() { return T(0); }
+			T operator()(T a, T b) const { return a + b; }
+		};
+
+		template<typename T>
+		struct MinimumOperator
+		{
+			static T identity() { return std::numeric_limits<T>::max(); }
+			T operator()(T a, T b) const { return b < a ? b : a; }
+		};
+
+		template<typename T>
+		struct MaximumOperator
+		{
+			static T identity() { return std::numeric_limits<T>::lowest(); }
+			T operator()(T a, T b) const { return a < b ? b : a; }
+		};
+
+		/**
+		 * @brief Stable key-value LSD radix sort; every chunk counts and scatters its own elements
+		 */
+		template<typename T>
+		void radixSort(const QVector<T>& input, QVector<T>& sortedKeys, QVector<quint32>& sortedValues, int chunkCount)
+		{
+			const int count = input.size();
+			const T* in = input.constData();
+
+			QVector<quint32> keys(count), values(count), nextKeys(count), nextValues(count);
+			QVector<int> offsets(chunkCount * RadixSize);
+
+			quint32* keyData = keys.data();
+			quint32* valueData = values.data();
+			quint32* nextKeyData = nextKeys.data();
+			quint32* nextValueData = nextValues.data();
+			int* offsetData = offsets.data();
+
+			ThreadPool::parallelFor(chunkCount, [&](int chunk) {
+				for (int i = chunkBegin(count, chunkCount, chunk); i < chunkBegin(count, chunkCount, chunk + 1); i++)
+				{
+					keyData[i] = toRadixKey(in[i]);
+					valueData[i] = static_cast<quint32>(i);
+				}
+			});
+
+			for (int shift = 0; shift < 32; shift += RadixBits)
+			{
+				// Count the digits of every chunk
+				std::fill(offsetData, offsetData + offsets.size(), 0);
+
+				ThreadPool::parallelFor(chunkCount, [&](int chunk) {
+					int* histogram = offsetData + chunk * RadixSize;
+					for (int i = chunkBegin(count, chunkCount, chunk); i < chunkBegin(count, chunkCount, chunk + 1); i++)
+						histogram[(keyData[i] >> shift) & (RadixSize - 1)]++;
+				});
+
+				// Turn the counts into offsets, ordered by digit first and chunk second to keep the sort stable
+				int offset = 0;
+				for (int digit = 0; digit < RadixSize; digit++)
+				{
+					for (int chunk = 0; chunk < chunkCount; chunk++)
+					{
+						int& entry = offsetData[chunk * RadixSize + digit];
+						int digitCount = entry;
+
+						entry = offset;
+						offset += digitCount;
+					}
+				}
+
+				// Scatter the elements
+				ThreadPool::parallelFor(chunkCount, [&](int chunk) {
+					int* chunkOffsets = offsetData + chunk * RadixSize;
+					for (int i = chunkBegin(count, chunkCount, chunk); i < chunkBegin(count, chunkCount, chunk + 1); i++)
+					{
+						int target = chunkOffsets[(keyData[i] >> shift) & (RadixSize - 1)]++;
+
+						nextKeyData[target] = keyData[i];
+						nextValueData[target] = valueData[i];
+					}
+				});
+
+				std::swap(keyData, nextKeyData);
+				std::swap(valueData, nextValueData);
+			}
+
+			// Gather the original keys
+			sortedKeys.resize(count);
+			sortedValues.resize(count);
+
+			T* sortedKeyData = sortedKeys.data();
+			quint32* sortedValueData = sortedValues.data();
+
+			ThreadPool::parallelFor(chunkCount, [&](int chunk) {
+				for (int i = chunkBegin(count, chunkCount, chunk); i < chunkBegin(count, chunkCount, chunk + 1); i++)
+				{
+					sortedKeyData[i] = in[valueData[i]];
+					sortedValueData[i] = valueData[i];
+				}
+			});
+		}
+
+		/**
+		 * @brief Three-phase prefix scan: reduce every chunk, scan the chunk results, then scan every chunk
+		 */
+		template<typename T, typename Op>
+		void scan(const QVector<T>& input, QVector<T>& output, bool inclusive, int chunkCount)
+		{
+			const int count = input.size();
+			const T* in = input.constData();
+			Op op;
+
+			output.resize(count);
+			T* out = output.data();
+
+			QVector<T> chunkResults(chunkCount, Op::identity());
+			T* chunkResultData = chunkResults.data();
+
+			ThreadPool::parallelFor(chunkCount, [&](int chunk) {
+				T result = Op::identity();
+				for (int i = chunkBegin(count, chunkCount, chunk); i < chunkBegin(count, chunkCount, chunk + 1); i++)
+					result = op(result, in[i]);
+
+				chunkResultData[chunk] = result;
+			});
+
+			// Exclusive scan of the chunk results
+			T carry = Op::identity();
+			for (int chunk = 0; chunk < chunkCount; chunk++)
+			{
+				T result = chunkResultData[chunk];
+
+				chunkResultData[chunk] = carry;
+				carry = op(carry, result);
+			}
+
+			ThreadPool::parallelFor(chunkCount, [&](int chunk) {
+				T result = chunkResultData[chunk];
+				for (int i = chunkBegin(count, chunkCount, chunk); i < chunkBegin(count, chunkCount, chunk + 1); i++)
+				{
+					if (inclusive)
+					{
+						result = op(result, in[i]);
+						out[i] = result;
+					}
+					else
+					{
+						out[i] = result;
+						result = op(result, in[i]);
+					}
+				}
+			});
+		}
+
+		/**
+		 * @brief Stream compaction keeping all non-zero elements in order
+		 */
+		template<typename T>
+		void compact(const QVector<T>& input, QVector<T>& output, int chunkCount)
+		{
+			const int count = input.size();
+			const T* in = input.constData();
+
+			QVector<int> chunkOffsets(chunkCount + 1, 0);
+			int* offsetData = chunkOffsets.data();
+
+			ThreadPool::parallelFor(chunkCount, [&](int chunk) {
+				int kept = 0;
+				for (int i = chunkBegin(count, chunkCount, chunk); i < chunkBegin(count, chunkCount, chunk + 1); i++)
+				{
+					if (in[i] != T(0))
+						kept++;
+				}
+
+				offsetData[chunk + 1] = kept;
+			});
+
+			for (int chunk = 0; chunk < chunkCount; chunk++)
+				offsetData[chunk + 1] += offsetData[chunk];
+
+			output.resize(offsetData[chunkCount]);
+			T* out = output.data();
+
+			ThreadPool::parallelFor(chunkCount, [&](int chunk) {
+				int target = offsetData[chunk];
+				for (int i = chunkBegin(count, chunkCount, chunk); i < chunkBegin(count, chunkCount, chunk + 1); i++)
+				{
+					if (in[i] != T(0))
+						out[target++] = in[i];
+				}
+			});
+		}
+
+		/**
+		 * @brief Reduction of consecutive segments; few large segments are split into chunks themselves
+		 */
+		template<typename T, typename Op>
+		void reduceSegments(const QVector<T>& input, QVector<T>& output, unsigned int segmentSize, int chunkCount)
+		{
+			const int count = input.size();
+			const T* in = input.constData();
+			const int segment = (segmentSize > 0 && segmentSize < static_cast<unsigned int>(count)) ? static_cast<int>(segmentSize) : qMax(count, 1);
+			const int segmentCount = (count + segment - 1) / segment;
+			Op op;
+
+			output.fill(Op::identity(), segmentCount);
+			T* out = output.data();
+
+			if (segmentCount >= chunkCount)
+			{
+				// Distribute the segments among the chunks
+				ThreadPool::parallelFor(chunkCount, [&](int chunk) {
+					for (int s = chunkBegin(segmentCount, chunkCount, chunk); s < chunkBegin(segmentCount, chunkCount, chunk + 1); s++)
+					{
+						T result = Op::identity();
+						for (int i = s * segment; i < qMin(count, (s + 1) * segment); i++)
+							result = op(result, in[i]);
+
+						out[s] = result;
+					}
+				});
+			}
+			else
+			{
+				// Reduce every segment in parallel
+				QVector<T> chunkResults(chunkCount);
+				T* chunkResultData = chunkResults.data();
+
+				for (int s = 0; s < segmentCount; s++)
+				{
+					const int first = s * segment;
+					const int size = qMin(count, first + segment) - first;
+
+					ThreadPool::parallelFor(chunkCount, [&](int chunk) {
+						T result = Op::identity();
+						for (int i = first + chunkBegin(size, chunkCount, chunk); i < first + chunkBegin(size, chunkCount, chunk + 1); i++)
+							result = op(result, in[i]);
+
+						chunkResultData[chunk] = result;
+					});
+
+					T result = Op::identity();
+					for (int chunk = 0; chunk < chunkCount; chunk++)
+						result = op(result, chunkResultData[chunk]);
+
+					out[s] = result;
+				}
+			}
+		}
+
+		/**
+		 * @brief Runs the scan or reduction with the selected operator
+		 */
+		template<typename T, template<typename> class Op>
+		void scanOrReduce(const ParallelPrimitives::Options& options, const QVector<T>& input, QVector<T>& output, int chunkCount)
+		{
+			switch (options.primitive)
+			{
+			case ParallelPrimitives::Primitive::InclusiveScan:
+				scan<T, Op<T> >(input, output, true, chunkCount);
+				break;
+
+			case ParallelPrimitives::Primitive::ExclusiveScan:
+				scan<T, Op<T> >(input, output, false, chunkCount);
+				break;
+
+			default:
+				reduceSegments<T, Op<T> >(input, output, options.segmentSize, chunkCount);
+				break;
+			}
+		}
+
+		/**
+		 * @brief Converts the typed result to raw data
+		 */
+		template<typename T>
+		QByteArray toByteArray(const QVector<T>& data)
+		{
+			return QByteArray(reinterpret_cast<const char*>(data.constData()), data.size() * static_cast<int>(sizeof(T)));
+		}
+
+		/**
+		 * @brief Executes the primitive; a single chunk is used for the reference
+		 */
+		template<typename T>
+		QByteArray executeTyped(const QByteArray& inputData, const ParallelPrimitives::Options& options, int chunkCount, bool reference)
+		{
+			QVector<T> input(inputData.size() / static_cast<int>(sizeof(T)));
+			memcpy(input.data(), inputData.constData(), input.size() * sizeof(T));
+
+			QVector<T> output;
+
+			switch (options.primitive)
+			{
+			case ParallelPrimitives::Primitive::RadixSort:
+			{
+				QVector<quint32> values;
+
+				if (reference)
+				{
+					// Stable comparison sort on the same key order
+					values.resize(input.size());
+					for (int i = 0; i < values.size(); i++)
+						values[i] = static_cast<quint32>(i);
+
+					std::stable_sort(values.begin(), values.end(), [&input](quint32 a, quint32 b) {
+						return toRadixKey(input[a]) < toRadixKey(input[b]);
+					});
+
+					output.resize(input.size());
+					for (int i = 0; i < values.size(); i++)
+						output[i] = input[values[i]];
+				}
+				else
+					radixSort(input, output, values, chunkCount);
+
+				if (options.sortOutput == ParallelPrimitives::SortOutput::Values)
+					return toByteArray(values);
+
+				break;
+			}
+
+			case ParallelPrimitives::Primitive::Compaction:
+				compact(input, output, reference ? 1 : chunkCount);
+				break;
+
+			default:
+				switch (options.reduceOperator)
+				{
+				case ParallelPrimitives::Operator::Minimum:
+					scanOrReduce<T, MinimumOperator>(options, input, output, reference ? 1 : chunkCount);
+					break;
+
+				case ParallelPrimitives::Operator::Maximum:
+					scanOrReduce<T, MaximumOperator>(options, input, output, reference ? 1 : chunkCount);
+					break;
+
+				default:
+					scanOrReduce<T, SumOperator>(options, input, output, reference ? 1 : chunkCount);
+					break;
+				}
+				break;
+			}
+
+			return toByteArray(output);
+		}
+
+		/**
+		 * @brief Dispatches the execution by data type
+		 */
+		QByteArray executeTypes(const QByteArray& input, const ParallelPrimitives::Options& options, int chunkCount, bool reference)
+		{
+			switch (options.dataType)
+			{
+			case DataType::Int:
+				return executeTyped<int>(input, options, chunkCount, reference);
+
+			case DataType::UInt:
+				return executeTyped<unsigned int>(input, options, chunkCount, reference);
+
+			case DataType::Float:
+				return executeTyped<float>(input, options, chunkCount, reference);
+
+			default:
+				throw std::runtime_error{"Parallel primitives only support Int, UInt and Float elements"};
+			}
+		}
+
+		/**
+		 * @brief Compares the parallel result to the reference, allowing rounding differences for floats
+		 */
+		bool matchesReference(const QByteArray& result, const QByteArray& reference, DataType outputType)
+		{
+			if (result.size() != reference.size())
+				return false;
+
+			if (outputType != DataType::Float)
+				return result == reference;
+
+			const float* a = reinterpret_cast<const float*>(result.constData());
+			const float* b = reinterpret_cast<const float*>(reference.constData());
+			const int count = result.size() / static_cast<int>(sizeof(float));
+
+			// Partial sums may cancel out, so the rounding error is relative to the largest magnitude
+			float magnitude = 1.0f;
+			for (int i = 0; i < count; i++)
+				magnitude = qMax(magnitude, qAbs(b[i]));
+
+			for (int i = 0; i < count; i++)
+			{
+				if (a[i] != b[i] && qAbs(a[i] - b[i]) > FloatTolerance * magnitude)
+					return false;
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Converts the measured time to elements per second
+		 */
+		double getThroughput(unsigned int elementCount, qint64 nsecs)
+		{
+			return elementCount / (qMax(nsecs, Q_INT64_C(1)) * 1e-9);
+		}
+
+		// Number of executions after which a verified configuration is compared to the reference again
+		const unsigned int VerificationInterval = 64;
+
+		/**
+		 * @brief The verification state of a configuration
+		 */
+		struct Verification
+		{
+			bool failed{false};
+			unsigned int runsSinceVerification{0};
+		};
+
+		// Configurations executed so far, shared by all blocks
+		QMutex verificationMutex;
+		QHash<QString, Verification> verifications;
+
+		/**
+		 * @brief Gets the key of everything the parallel result depends on besides the input data
+		 * Inputs are grouped by the power of two of their element count, so every size class is verified on its own.
+		 */
+		QString getConfigurationKey(const ParallelPrimitives::Options& options, int chunkCount, unsigned int elementCount)
+		{
+			int sizeClass = 0;
+			while (elementCount >>= 1)
+				++sizeClass;
+
+			return QString("%1/%2/%3/%4/%5/%6/%7").arg(static_cast<int>(options.primitive)).arg(static_cast<int>(options.dataType))
+					.arg(static_cast<int>(options.reduceOperator)).arg(static_cast<int>(options.sortOutput)).arg(options.segmentSize)
+					.arg(chunkCount).arg(sizeClass);
+		}
+	}
+
+	DataType ParallelPrimitives::getOutputType(const Options& options)
+	{
+		if (options.primitive == Primitive::RadixSort && options.sortOutput == SortOutput::Values)
+			return DataType::UInt;
+
+		return options.dataType;
+	}
+
+	unsigned int ParallelPrimitives::getDefaultGrainSize()
+	{
+		// More hardware threads allow for smaller chunks
+		static const unsigned int grainSize = MinGrainSize * 16 / qBound(1, ThreadPool::getThreadCount(), 16);
+		return grainSize;
+	}
+
+	QByteArray ParallelPrimitives::execute(const QByteArray& input, const Options& options, Statistics* statistics)
+	{
+		const unsigned int elementCount = input.size() / 4;
+		const unsigned int grainSize = options.grainSize > 0 ? options.grainSize : getDefaultGrainSize();
+
+		// Never use more chunks than the pool can run at once
+		const int chunkCount = qBound(1, static_cast<int>(elementCount / qMax(grainSize, 1u)), qMax(1, ThreadPool::getThreadCount()));
+
+		const QString configuration = getConfigurationKey(options, chunkCount, elementCount);
+		bool parallel = true;
+		bool verify = true;
+
+		{
+			QMutexLocker locker{&verificationMutex};
+
+			// Configurations the parallel implementation failed for are executed by the reference only; all others are
+			// compared to the reference on their first execution and then every VerificationInterval executions
+			Verification& verification = verifications[configuration];
+			parallel = !verification.failed;
+			verify = parallel && verification.runsSinceVerification == 0;
+
+			if (parallel)
+				verification.runsSinceVerification = (verification.runsSinceVerification + 1) % VerificationInterval;
+		}
+
+		QElapsedTimer timer;
+		timer.start();
+		QByteArray result = executeTypes(input, options, parallel ? chunkCount : 1, !parallel);
+		const double throughput = getThroughput(elementCount, timer.nsecsElapsed());
+
+		double referenceThroughput = parallel ? 0.0 : throughput;
+		bool verified = false;
+
+		if (verify)
+		{
+			timer.restart();
+			QByteArray reference = executeTypes(input, options, 1, true);
+			referenceThroughput = getThroughput(elementCount, timer.nsecsElapsed());
+			verified = matchesReference(result, reference, getOutputType(options));
+
+			// Fall back to the reference, if the parallel implementation failed
+			if (!verified)
+			{
+				result = reference;
+
+				QMutexLocker locker{&verificationMutex};
+				verifications[configuration].failed = true;
+			}
+		}
+
+		if (statistics)
+		{
+			statistics->elementCount = elementCount;
+			statistics->chunkCount = parallel ? chunkCount : 1;
+			statistics->throughput = throughput;
+			statistics->referenceThroughput = referenceThroughput;
+			statistics->referenceMeasured = !parallel || verify;
+			statistics->verified = verified;
+		}
+
+		return result;
+	}
+
+	QByteArray ParallelPrimitives::executeReference(const QByteArray& input, const Options& options)
+	{
+		return executeTypes(input, options, 1, true);
+	}
+}
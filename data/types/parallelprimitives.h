@@ -0,0 +1,139 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef PARALLELPRIMITIVES_H
+#define PARALLELPRIMITIVES_H
+
+#include "types.h"
+
+#include <QByteArray>
+
+namespace ysm
+{
+	/**
+	 * @brief Data-parallel primitives (radix sort, prefix scan, stream compaction and segmented reduction) on raw arrays
+	 * The input is split into chunks, which are processed by the global thread pool. Every configuration and input size class
+	 * is verified against a serial reference implementation on its first execution and periodically afterwards; if they
+	 * don't match, the reference is used for it from then on.
+	 */
+	class ParallelPrimitives
+	{
+	public:
+		/**
+		 * @brief The available primitives
+		 */
+		enum class Primitive
+		{
+			RadixSort,
+			InclusiveScan,
+			ExclusiveScan,
+			Compaction,
+			SegmentedReduction
+		};
+
+		/**
+		 * @brief The operators used for scans and reductions
+		 */
+		enum class Operator
+		{
+			Sum,
+			Minimum,
+			Maximum
+		};
+
+		/**
+		 * @brief The output of a key-value sort; the values are the keys' original indices
+		 */
+		enum class SortOutput
+		{
+			Keys,
+			Values
+		};
+
+		/**
+		 * @brief Options of a primitive
+		 */
+		struct Options
+		{
+			Primitive primitive{Primitive::RadixSort};
+			DataType dataType{DataType::Float};			// Int, UInt or Float
+			Operator reduceOperator{Operator::Sum};
+			SortOutput sortOutput{SortOutput::Keys};
+			unsigned int segmentSize{0};				// Elements per reduced segment, 0 reduces the whole array
+			unsigned int grainSize{0};					// Elements per chunk, 0 selects it automatically
+
+			bool operator==(const Options& other) const
+			{
+				return primitive == other.primitive && dataType == other.dataType && reduceOperator == other.reduceOperator &&
+					   sortOutput == other.sortOutput && segmentSize == other.segmentSize && grainSize == other.grainSize;
+			}
+		};
+
+		/**
+		 * @brief Statistics of the latest execution
+		 */
+		struct Statistics
+		{
+			unsigned int elementCount{0};
+			unsigned int chunkCount{0};
+			double throughput{0.0};						// Elements per second of the parallel implementation
+			double referenceThroughput{0.0};			// Elements per second of the serial reference, zero if it was not executed
+			bool referenceMeasured{false};				// True, if the serial reference was executed
+			bool verified{false};						// True, if the parallel result was compared to the reference and matched
+		};
+
+	public:
+		/**
+		 * @brief Gets the data type of the primitive's output elements
+		 */
+		static DataType getOutputType(const Options& options);
+
+		/**
+		 * @brief Gets the grain size used, if none is specified
+		 * It's derived from the number of hardware threads, so that small arrays are processed serially.
+		 */
+		static unsigned int getDefaultGrainSize();
+
+		/**
+		 * @brief Executes the primitive on @p input, which holds tightly packed elements of the options' data type
+		 * If an error occurs, an exception is thrown.
+		 * @param statistics Receives the statistics, if not null
+		 */
+		static QByteArray execute(const QByteArray& input, const Options& options, Statistics* statistics = nullptr);
+
+		/**
+		 * @brief Executes the serial reference implementation of the primitive
+		 * If an error occurs, an exception is thrown.
+		 */
+		static QByteArray executeReference(const QByteArray& input, const Options& options);
+
+	private:
+		// Construction
+		explicit ParallelPrimitives();
+	};
+}
+
+#endif
@@ -24,12 +24,120 @@
  ***********************************************************************************/
 
 #include "types.h"
+#include "typeutils.h"
 #include "data/blocks/porttype.h"
 
 #include <QOpenGLFunctions>
+#include <QtMath>
+#include <cstring>
 
 namespace ysm
 {
+	namespace
+	{
+		/**
+		 * @brief Converts @p value to a 16 bit float, rounding to the nearest value
+		 */
+		qint32 packHalf(float value)
+		{
+			quint32 bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+
+			quint32 sign = (bits >> 16) & 0x8000;
+			quint32 biasedExponent = (bits >> 23) & 0xFF;
+			qint32 exponent = static_cast<qint32>(biasedExponent) - 127 + 15;
+			quint32 mantissa = bits & 0x7FFFFF;
+
+			// Infinity and NaN
+			if (biasedExponent == 0xFF)
+				return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+
+			// Too large values become infinity
+			if (exponent >= 31)
+				return sign | 0x7C00;
+
+			// Too small values become denormals or zero
+			if (exponent <= 0)
+			{
+				if (exponent < -10)
+					return sign;
+
+				mantissa |= 0x800000;
+
+				quint32 shift = 14 - exponent;
+				quint32 half = mantissa >> shift;
+
+				if ((mantissa >> (shift - 1)) & 1)
+					half++;
+
+				return sign | half;
+			}
+
+			// A rounding carry into the exponent yields the correct result
+			quint32 half = sign | (static_cast<quint32>(exponent) << 10) | (mantissa >> 13);
+
+			if (mantissa & 0x1000)
+				half++;
+
+			return half;
+		}
+
+		/**
+		 * @brief Converts @p value to a signed normalized integer of @p bits bits
+		 */
+		qint32 packSNorm(float value, int bits)
+		{
+			return qRound(qBound(-1.0f, value, 1.0f) * ((1 << (bits - 1)) - 1));
+		}
+
+		/**
+		 * @brief Converts @p value to an unsigned normalized integer of @p bits bits
+		 */
+		qint32 packUNorm(float value, int bits)
+		{
+			return qRound(qBound(0.0f, value, 1.0f) * ((1 << bits) - 1));
+		}
+
+		/**
+		 * @brief Packs @p value as signed normalized GL_INT_2_10_10_10_REV value
+		 */
+		quint32 pack2101010Rev(const QVector4D& value)
+		{
+			quint32 x = static_cast<quint32>(packSNorm(value.x(), 10)) & 0x3FF;
+			quint32 y = static_cast<quint32>(packSNorm(value.y(), 10)) & 0x3FF;
+			quint32 z = static_cast<quint32>(packSNorm(value.z(), 10)) & 0x3FF;
+			quint32 w = static_cast<quint32>(packSNorm(value.w(), 2)) & 0x3;
+
+			return x | (y << 10) | (z << 20) | (w << 30);
+		}
+
+		/**
+		 * @brief Maps the direction @p value onto the octahedron, unfolded into [-1, 1]^2
+		 */
+		QVector2D encodeOctahedral(const QVector3D& value)
+		{
+			float length = qAbs(value.x()) + qAbs(value.y()) + qAbs(value.z());
+
+			if (length <= 0.0f)
+				return QVector2D{0.0f, 0.0f};
+
+			float x = value.x() / length;
+			float y = value.y() / length;
+
+			// Fold the lower hemisphere over the diagonals
+			if (value.z() < 0.0f)
+			{
+				float foldedX = (1.0f - qAbs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+				float foldedY = (1.0f - qAbs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+
+				x = foldedX;
+				y = foldedY;
+			}
+
+			return QVector2D{x, y};
+		}
+	}
+
 	bool TypeConversion::canConvertBetweenTypes(DataType fromType, DataType toType)
 	{
 		bool ret = false;
@@ -40,6 +148,13 @@ namespace ysm
 		if (fromType == DataType::NoType || toType == DataType::NoType)
 			return false;
 
+		// Packed formats can be created from every type, but are never converted any further
+		if (isPackedType(fromType))
+			return false;
+
+		if (isPackedType(toType))
+			return true;
+
 		// Effectively, we can convert everything to everything so far, but that might change one day
 		switch (fromType)
 		{
@@ -75,6 +190,28 @@ namespace ysm
 		return ret;
 	}
 
+	bool TypeConversion::isPackedType(DataType type)
+	{
+		switch (type)
+		{
+		case DataType::HalfVec2:
+		case DataType::HalfVec3:
+		case DataType::HalfVec4:
+		case DataType::SNorm8Vec4:
+		case DataType::UNorm8Vec4:
+		case DataType::SNorm16Vec2:
+		case DataType::SNorm16Vec4:
+		case DataType::UNorm16Vec2:
+		case DataType::UNorm16Vec4:
+		case DataType::SNorm2101010Rev:
+		case DataType::OctahedralSNorm16:
+			return true;
+
+		default:
+			return false;
+		}
+	}
+
 	Vec2Data TypeConversion::convertToVec2(const Vec2Data& data)
 	{
 		return data;
@@ -337,6 +474,81 @@ namespace ysm
 		return convertVectorToByteArray<float, float, GLfloat>(data, valRetriever, index);
 	}
 
+	QByteArray TypeConversion::convertVectorToPackedByteArray(const Vec4Data& data, int index, const ConversionOptions& convOptions)
+	{
+		int components = DataTypeUtils::getTypeComponentCount(convOptions.targetType);
+
+		auto swizzle = [&convOptions](const QVector4D& v)
+		{
+			return QVector4D{getVectorComponent(v, convOptions.swizzlingX), getVectorComponent(v, convOptions.swizzlingY),
+							 getVectorComponent(v, convOptions.swizzlingZ), getVectorComponent(v, convOptions.swizzlingW)};
+		};
+
+		// Packs every component on its own
+		auto packComponents = [&swizzle, components](const QVector4D& v, std::function<qint32(float)> pack)
+		{
+			QVector4D swizzled = swizzle(v);
+			QVector<qint32> vals;
+
+			for (int i = 0; i < components; ++i)
+				vals << pack(swizzled[i]);
+
+			return vals;
+		};
+
+		switch (convOptions.targetType)
+		{
+		case DataType::HalfVec2:
+		case DataType::HalfVec3:
+		case DataType::HalfVec4:
+			return convertVectorToByteArray<QVector4D, qint32, GLushort>(data, [&packComponents](const QVector4D& v) { return packComponents(v, packHalf); }, index);
+
+		case DataType::SNorm8Vec4:
+			return convertVectorToByteArray<QVector4D, qint32, GLbyte>(data, [&packComponents](const QVector4D& v) { return packComponents(v, [](float c) { return packSNorm(c, 8); }); }, index);
+
+		case DataType::UNorm8Vec4:
+			return convertVectorToByteArray<QVector4D, qint32, GLubyte>(data, [&packComponents](const QVector4D& v) { return packComponents(v, [](float c) { return packUNorm(c, 8); }); }, index);
+
+		case DataType::SNorm16Vec2:
+		case DataType::SNorm16Vec4:
+			return convertVectorToByteArray<QVector4D, qint32, GLshort>(data, [&packComponents](const QVector4D& v) { return packComponents(v, [](float c) { return packSNorm(c, 16); }); }, index);
+
+		case DataType::UNorm16Vec2:
+		case DataType::UNorm16Vec4:
+			return convertVectorToByteArray<QVector4D, qint32, GLushort>(data, [&packComponents](const QVector4D& v) { return packComponents(v, [](float c) { return packUNorm(c, 16); }); }, index);
+
+		case DataType::SNorm2101010Rev:
+		{
+			auto valRetriever = [&swizzle](const QVector4D& v)
+			{
+				QVector<quint32> vals;
+
+				vals << pack2101010Rev(swizzle(v));
+				return vals;
+			};
+
+			return convertVectorToByteArray<QVector4D, quint32, GLuint>(data, valRetriever, index);
+		}
+
+		case DataType::OctahedralSNorm16:
+		{
+			auto valRetriever = [&swizzle](const QVector4D& v)
+			{
+				QVector2D octahedral = encodeOctahedral(swizzle(v).toVector3D());
+				QVector<qint32> vals;
+
+				vals << packSNorm(octahedral.x(), 16) << packSNorm(octahedral.y(), 16);
+				return vals;
+			};
+
+			return convertVectorToByteArray<QVector4D, qint32, GLshort>(data, valRetriever, index);
+		}
+
+		default:
+			throw std::invalid_argument{"The target type is no packed vertex format"};
+		}
+	}
+
 	float TypeConversion::getVectorComponent(const QVector2D& vec, VectorComponent comp)
 	{
 		switch (comp)
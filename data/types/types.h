@@ -56,6 +56,19 @@ namespace ysm
 		Int,
 		UInt,
 		Float,
+
+		// Packed vertex formats; these can only be used as conversion targets
+		HalfVec2,
+		HalfVec3,
+		HalfVec4,
+		SNorm8Vec4,
+		UNorm8Vec4,
+		SNorm16Vec2,
+		SNorm16Vec4,
+		UNorm16Vec2,
+		UNorm16Vec4,
+		SNorm2101010Rev,
+		OctahedralSNorm16,
 	};
 
 	enum class VectorComponent
@@ -88,6 +101,11 @@ namespace ysm
 		 */
 		static bool canConvertBetweenTypes(DataType fromType, DataType toType);
 
+		/**
+		 * @brief Checks whether @p type is a packed vertex format (half floats, normalized integers etc.)
+		 */
+		static bool isPackedType(DataType type);
+
 		// Conversion functions (yes, we need all of those; everything else would lead to ugly code)
 		static Vec2Data convertToVec2(const Vec2Data& data);
 		static Vec2Data convertToVec2(const Vec3Data& data);
@@ -139,6 +157,12 @@ namespace ysm
 		static QByteArray convertVectorToByteArray(const UIntData& data, int index, const ConversionOptions& convOptions);
 		static QByteArray convertVectorToByteArray(const FloatData& data, int index, const ConversionOptions& convOptions);
 
+		/**
+		 * @brief Converts @p data to the packed vertex format given in @p convOptions, applying the swizzling first
+		 * Octahedral normals use the swizzled x, y and z components; all other formats use as many components as they have.
+		 */
+		static QByteArray convertVectorToPackedByteArray(const Vec4Data& data, int index, const ConversionOptions& convOptions);
+
 		/**
 		 * @brief Converts objects in a given vector to type @p T; @p F must be convertible to @p T
 		 * @arg T The object return type
@@ -74,6 +74,32 @@ namespace ysm
 			else
 				return sizeof(float);
 
+		// Packed formats only exist as GL types
+		case DataType::HalfVec2:
+			return sizeof(GLushort) * 2;
+
+		case DataType::HalfVec3:
+			return sizeof(GLushort) * 3;
+
+		case DataType::HalfVec4:
+			return sizeof(GLushort) * 4;
+
+		case DataType::SNorm8Vec4:
+		case DataType::UNorm8Vec4:
+			return sizeof(GLubyte) * 4;
+
+		case DataType::SNorm16Vec2:
+		case DataType::UNorm16Vec2:
+		case DataType::OctahedralSNorm16:
+			return sizeof(GLushort) * 2;
+
+		case DataType::SNorm16Vec4:
+		case DataType::UNorm16Vec4:
+			return sizeof(GLushort) * 4;
+
+		case DataType::SNorm2101010Rev:
+			return sizeof(GLuint);
+
 		default:
 			break;
 		}
@@ -89,12 +115,23 @@ namespace ysm
 			return 0;
 
 		case DataType::Vec2:
+		case DataType::HalfVec2:
+		case DataType::SNorm16Vec2:
+		case DataType::UNorm16Vec2:
+		case DataType::OctahedralSNorm16:
 			return 2;
 
 		case DataType::Vec3:
+		case DataType::HalfVec3:
 			return 3;
 
 		case DataType::Vec4:
+		case DataType::HalfVec4:
+		case DataType::SNorm8Vec4:
+		case DataType::UNorm8Vec4:
+		case DataType::SNorm16Vec4:
+		case DataType::UNorm16Vec4:
+		case DataType::SNorm2101010Rev:
 			return 4;
 
 		default:
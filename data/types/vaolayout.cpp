@@ -74,7 +74,7 @@ namespace ysm
 		return !(*this == src);
 	}
 
-	void VaoLayout::addEntry(IConnection *con, QString name, int index, int size, GLDataType type, bool normalized, int stride, int offset, GLSLDataType glslType, int entryIndex)
+	void VaoLayout::addEntry(IConnection *con, QString name, int index, int size, GLDataType type, bool normalized, int stride, int offset, GLSLDataType glslType, int divisor, int entryIndex)
 	{
 		VaoLayoutEntry entry;
 		entry.bufferConnection = con;
@@ -86,6 +86,7 @@ namespace ysm
 		entry.normalized = normalized;
 		entry.stride = stride;
 		entry.offset = offset;
+		entry.divisor = divisor;
 
 		if(entryIndex == -1)
 			_entries << entry;
@@ -114,6 +115,7 @@ namespace ysm
 			elem.setAttribute("normalized", entry.normalized);
 			elem.setAttribute("stride", entry.stride);
 			elem.setAttribute("offset", entry.offset);
+			elem.setAttribute("divisor", entry.divisor);
 
 			xmlElement->appendChild(elem);
 		}
@@ -165,6 +167,7 @@ namespace ysm
             entry.normalized = elem.attribute("normalized").toInt() ? true : false;
 			entry.stride = elem.attribute("stride").toInt();
 			entry.offset = elem.attribute("offset").toInt();
+			entry.divisor = elem.attribute("divisor", "0").toInt();
 
 			_entries << entry;
 		}
@@ -210,6 +213,8 @@ namespace ysm
 			return false;
 		if(entry1.offset != entry2.offset)
 			return false;
+		if(entry1.divisor != entry2.divisor)
+			return false;
 
 		return true;
 	}
@@ -259,6 +264,10 @@ namespace ysm
 		QVector<Connection*> inCons = block->getDataInPort()->assembleConnections(PortDirection::In);
 		bool ret = false;
 
+		// All entries sourced from this buffer advance at the buffer's instance rate
+		int firstEntry = _entries.size();
+		int divisor = *block->getInstanceDivisor();
+
 		if (inCons.size() == 1)
 		{
 			Connection* inCon = inCons[0];
@@ -277,15 +286,13 @@ namespace ysm
 				{
 					MixerLayout layout = *mixer->getMixerLayout();
 
-					// Update the stride size if the layout is a struct
+					// Update the stride size of this buffer's entries if the layout is a struct
 					if (layout.getEntriesAsStruct())
 					{
-						for (VaoLayoutEntry& entry : _entries)
-							entry.stride = stride;
+						for (int i = firstEntry; i < _entries.size(); ++i)
+							_entries[i].stride = stride;
 					}
 				}
-
-				return ret;
 			}
 			else if (dynamic_cast<DataSourceBlock*>(block))
 			{
@@ -295,6 +302,9 @@ namespace ysm
 			}
 		}
 
+		for (int i = firstEntry; i < _entries.size(); ++i)
+			_entries[i].divisor = divisor;
+
 		// The connected block type isn't supported
 		return ret;
 	}
@@ -361,12 +371,13 @@ namespace ysm
 		GLDataType glType = GLDataType::NoType;
 		int count = 0;
 		GLSLDataType glslType = GLSLDataType::NoType;
+		bool normalized = false;
 
-		if (getConnectionGLTypes(conData, glType, count, glslType, convOptions))
+		if (getConnectionGLTypes(conData, glType, count, glslType, normalized, convOptions))
 		{
 			QString name = conData->getSourcePort()->getName().replace(" ", "");
 
-			addEntry(conVaoIn, name, 0, count, glType, false, 0, 0, glslType);
+			addEntry(conVaoIn, name, 0, count, glType, normalized, 0, 0, glslType);
 			return true;
 		}
 
@@ -374,11 +385,12 @@ namespace ysm
 		return false;
 	}
 
-	bool VaoLayout::getConnectionGLTypes(IConnection* con, GLDataType& glType, int& count, GLSLDataType& glslType, TypeConversion::ConversionOptions* convOptions)
+	bool VaoLayout::getConnectionGLTypes(IConnection* con, GLDataType& glType, int& count, GLSLDataType& glslType, bool& normalized, TypeConversion::ConversionOptions* convOptions)
 	{
 		glType= GLDataType::NoType;
 		count = 0;
 		glslType = GLSLDataType::NoType;
+		normalized = false;
 
 		EnumProperty* prop = con->getProperty<EnumProperty>(PropertyID::Data_OutputType);
 
@@ -396,6 +408,7 @@ namespace ysm
 
 		// Get the corresponding GL values of the given output type
 		GLTypes::convertDataTypeToGLTypes(outputType, glType, count, glslType);
+		normalized = GLTypes::isNormalizedDataType(outputType);
 
 		// Check if the GL types are valid
 		if (glType == GLDataType::NoType || count == 0 || glslType == GLSLDataType::NoType)
@@ -68,6 +68,9 @@ namespace ysm
 			bool normalized;
 			int stride;
 			int offset;
+
+			//glVertexAttribDivisor parameter (0 = per vertex, n = advance every n instances)
+			int divisor{0};
 		};
 
 		VaoLayout();
@@ -77,7 +80,7 @@ namespace ysm
 		 * @brief addEntry Function for adding new entries
 		 * @param entryIndex An optional index that specifies, where to add the entry (-1 = append)
 		 */
-		void addEntry(IConnection* con, QString name,  int index, int size, GLDataType type, bool normalized, int stride, int offset, GLSLDataType glslType, int entryIndex = -1);
+		void addEntry(IConnection* con, QString name,  int index, int size, GLDataType type, bool normalized, int stride, int offset, GLSLDataType glslType, int divisor = 0, int entryIndex = -1);
 
 		/**
 		 * @brief Direct access to entry list
@@ -112,9 +115,9 @@ namespace ysm
 		bool autoConfigureLayout_DataSource(IConnection* conVaoIn, DataSourceBlock* dataSource, IConnection* conData, TypeConversion::ConversionOptions* convOptions);
 
 		/**
-		 * @brief Gets the GL types of a data connection
+		 * @brief Gets the GL types of a data connection; @p normalized is set for packed integer formats
 		 */
-		bool getConnectionGLTypes(IConnection* con, GLDataType& glType, int& count, GLSLDataType& glslType, TypeConversion::ConversionOptions* convOptions);
+		bool getConnectionGLTypes(IConnection* con, GLDataType& glType, int& count, GLSLDataType& glslType, bool& normalized, TypeConversion::ConversionOptions* convOptions);
 
 		/**
 		 * @brief Removes all entries using the connection @p con
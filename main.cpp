@@ -24,9 +24,14 @@
  ***********************************************************************************/
 
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QOpenGLFunctions>
+#include <QTextStream>
+
+#include <stdexcept>
 
 #include "data/pipeline/pipelinemanager.h"
+#include "data/pipeline/pipelinebenchmark.h"
 
 #include "views/mainwindow/mainwindow.h"
 #include "views/mainwindow/documentmanager.h"
@@ -35,6 +40,9 @@
 #include "views/document.h"
 #include "sampledata.h"
 
+#include "opengl/gltracerecorder.h"
+#include "opengl/gltracereplayer.h"
+
 using namespace ysm;
 
 /*!
@@ -64,6 +72,67 @@ int main(int argc, char** argv)
 	app.setOrganizationName("WWU Muenster");
 	app.setOrganizationDomain("http://www.uni-muenster.de");
 
+	//Parse the options of GL traces and benchmarks.
+	QCommandLineParser parser;
+	parser.addHelpOption();
+	QCommandLineOption recordOption("record-trace", "Record the OpenGL calls into <file>.", "file");
+	QCommandLineOption replayOption("replay-trace", "Replay the OpenGL calls recorded in <file> and print timing statistics.", "file");
+	QCommandLineOption synchronousOption("synchronous", "Wait for each replayed call to complete.");
+	QCommandLineOption benchmarkOption("benchmark-pipelines", "Build, validate, store and load pipelines of 1000 to 10000 blocks and print the timings.");
+	parser.addOption(recordOption);
+	parser.addOption(replayOption);
+	parser.addOption(synchronousOption);
+	parser.addOption(benchmarkOption);
+	parser.process(app);
+
+	//Measure the pipeline scaling without showing the main window.
+	if(parser.isSet(benchmarkOption))
+	{
+		try
+		{
+			PipelineBenchmark benchmark;
+			benchmark.run(QVector<int>() << 1000 << 2000 << 5000 << 10000);
+			QTextStream(stdout) << benchmark.getReport();
+			return 0;
+		}
+		catch(const std::exception& error)
+		{
+			QTextStream(stderr) << error.what() << endl;
+			return 1;
+		}
+	}
+
+	//Replay a trace without showing the main window.
+	if(parser.isSet(replayOption))
+	{
+		try
+		{
+			GLTraceReplayer replayer(parser.isSet(synchronousOption));
+			replayer.replay(parser.value(replayOption));
+			QTextStream(stdout) << replayer.getReport();
+			return 0;
+		}
+		catch(const std::runtime_error& error)
+		{
+			QTextStream(stderr) << error.what() << endl;
+			return 1;
+		}
+	}
+
+	//Start recording before any context is created.
+	if(parser.isSet(recordOption))
+	{
+		try
+		{
+			GLTraceRecorder::start(parser.value(recordOption));
+		}
+		catch(const std::runtime_error& error)
+		{
+			QTextStream(stderr) << error.what() << endl;
+			return 1;
+		}
+	}
+
 	//Create window and locale.
 	QLocale locale(QLocale::English, QLocale::UnitedStates);
 	MainWindow* mainWindow = MainWindow::getInstance();
@@ -88,5 +157,6 @@ int main(int argc, char** argv)
 
 	//Return.
 	delete mainWindow;
+	GLTraceRecorder::stop();
 	return exitCode;
 }
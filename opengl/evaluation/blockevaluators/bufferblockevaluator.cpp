@@ -57,7 +57,7 @@ namespace ysm
 		BlockEvaluator::evaluate(block, pass);
 
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		// Look, if the block has already been evaluated
 		GLWrapper* wrapper = getEvaluator()->getEvaluatedData(block);
@@ -89,6 +89,7 @@ namespace ysm
 			{
 				// Calculate size
 				unsigned int size = dataSourceBlock->getProperty<VaryingsProperty>(PropertyID::Varyings)->getValue().getSize();
+				getEvaluator()->requestMemory(block, MemoryCategory::GLBuffer, size);
 
 				// Setup Transform Feedback Buffer
 				f->glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, buffer);
@@ -103,11 +104,12 @@ namespace ysm
 
 				// Calculate size
 				unsigned int size = dataInCon[0]->getProperty<VaryingsProperty>(PropertyID::Varyings)->getValue().getSize();
+				getEvaluator()->requestMemory(block, MemoryCategory::GLBuffer, size);
 
 				// Setup Transform Feedback Buffer
-				functions->glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
-				functions->glBufferData(GL_SHADER_STORAGE_BUFFER, size, nullptr, usage);
-				functions->glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+				f->glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+				f->glBufferData(GL_SHADER_STORAGE_BUFFER, size, nullptr, usage);
+				f->glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 			}
 			//Atomic Counter Buffer
 			else if(dataInCon[0]->getSourcePort()->getType() == PortType::Shader_AtomicCounterIn)
@@ -120,14 +122,15 @@ namespace ysm
 				//TODO: fill or reset bufferdata
 				const GLuint data = 0;
 				// Set the data once, using any unspecific target
-				functions->glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, buffer);
-				functions->glBufferData(GL_ATOMIC_COUNTER_BUFFER, 16 * sizeof(GLuint), &data, usage);
-				functions->glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+				f->glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, buffer);
+				f->glBufferData(GL_ATOMIC_COUNTER_BUFFER, 16 * sizeof(GLuint), &data, usage);
+				f->glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
 			}
 			else
 			{
 				// Get the actual data
 				const QByteArray& data = block->getProperty<ByteArrayProperty>(PropertyID::Buffer_Data)->getValue();
+				getEvaluator()->requestMemory(block, MemoryCategory::GLBuffer, data.size());
 
 				// Set the data once, using any unspecific target
 				f->glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
@@ -62,7 +62,7 @@ namespace ysm
 	void FragmentTestsBlockEvaluator::initializeDepthTest(IBlock* block)
 	{
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		bool depthTestEnabled = *block->getProperty<BoolProperty>(PropertyID::FragmentTests_DepthTest);
 		if(depthTestEnabled)
@@ -98,7 +98,7 @@ namespace ysm
 	void FragmentTestsBlockEvaluator::initializeBlending(IBlock* block)
 	{
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		bool blendingEnabled = *block->getProperty<BoolProperty>(PropertyID::FragmentTests_Blending);
 		if(blendingEnabled)
@@ -173,7 +173,7 @@ namespace ysm
 	void FragmentTestsBlockEvaluator::initializeStencilTest(IBlock* block)
 	{
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		bool stencilTestEnabled = *block->getProperty<BoolProperty>(PropertyID::FragmentTests_StencilTest);
 		if(stencilTestEnabled)
@@ -262,7 +262,7 @@ namespace ysm
 	void FragmentTestsBlockEvaluator::initializeScissorTest(IBlock* block)
 	{
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		bool scissorTestEnabled = *block->getProperty<BoolProperty>(PropertyID::FragmentTests_ScissorTest);
 		if(scissorTestEnabled)
@@ -282,7 +282,7 @@ namespace ysm
 	void FragmentTestsBlockEvaluator::initializeDepthMask(IBlock* block)
 	{
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		bool depthMask = *block->getProperty<BoolProperty>(PropertyID::FragmentTests_DepthMask);
 		if(depthMask)
@@ -294,7 +294,7 @@ namespace ysm
 	void FragmentTestsBlockEvaluator::initializeColorMask(IBlock* block)
 	{
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		bool red = *block->getProperty<BoolProperty>(PropertyID::FragmentTests_ColorMaskRed);
 		bool green = *block->getProperty<BoolProperty>(PropertyID::FragmentTests_ColorMaskGreen);
@@ -55,7 +55,7 @@ namespace ysm
 		BlockEvaluator::evaluate(block, pass);
 
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		// Look, if the block has already been evaluated
 		GLContextSensitiveWrapper* wrapper = getEvaluator()->getEvaluatedData<GLContextSensitiveWrapper>(block);
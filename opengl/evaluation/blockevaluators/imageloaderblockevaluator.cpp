@@ -64,7 +64,7 @@ namespace ysm
 		BlockEvaluator::evaluate(block, pass);
 
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		for(IConnection* connection : pass->getOutConnections(block))
 		{
@@ -88,6 +88,10 @@ namespace ysm
 			//calc and set number of possible mipmap levels
 			int levels = qFloor(qLn(qMax(imgSize.width(),imgSize.height()))/qLn(2)) + 1;
 
+			// Warn, if the storage exceeds the memory budget
+			GLenum internalFormat = EvaluationUtils::mapInternalFormatToOpenGL(*textureBlock->getProperty<EnumProperty>(PropertyID::TextureBase_InternalFormat));
+			getEvaluator()->requestMemory(textureBlock, MemoryCategory::GLTexture, EvaluationUtils::getImageMemorySize(internalFormat, imgSize.width(), imgSize.height(), 1, levels));
+
 			QOpenGLFunctions_4_2_Core* functions = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_4_2_Core>();
 
 			// set the actual data
@@ -95,7 +99,7 @@ namespace ysm
 			case TextureBaseBlock::Target_Proxy1D:
 			case TextureBaseBlock::Target_1D:
 				if(functions)
-					functions->glTexStorage1D(target,
+					f->glTexStorage1D(target,
 											  levels,
 											  EvaluationUtils::mapInternalFormatToOpenGL(*textureBlock->getProperty<EnumProperty>(PropertyID::TextureBase_InternalFormat)),
 											  imgSize.width());
@@ -131,7 +135,7 @@ namespace ysm
 			case TextureBaseBlock::Target_CubeMapNegZ:
 			case TextureBaseBlock::Target_ProxyCubeMap:
 				if(functions)
-					functions->glTexStorage2D(target,
+					f->glTexStorage2D(target,
 											  levels,
 											  EvaluationUtils::mapInternalFormatToOpenGL(*textureBlock->getProperty<EnumProperty>(PropertyID::TextureBase_InternalFormat)),
 											  imgSize.width(),
@@ -178,7 +182,7 @@ namespace ysm
 			case TextureBaseBlock::Target_2DArray:
 			case TextureBaseBlock::Target_3D:
 				if(functions)
-					functions->glTexStorage3D(target,
+					f->glTexStorage3D(target,
 											  levels,
 											  EvaluationUtils::mapInternalFormatToOpenGL(*textureBlock->getProperty<EnumProperty>(PropertyID::TextureBase_InternalFormat)),
 											  imgSize.width(),
@@ -53,7 +53,7 @@ namespace ysm
 
 
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		//FronFace settings
 		int frontFace = *block->getProperty<EnumProperty>(PropertyID::Rasterization_FrontFace);
@@ -52,10 +52,19 @@ namespace ysm
 		BlockEvaluator::evaluate(block, pass);
 
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		// Look, if the block has already been evaluated
 		GLWrapper* wrapper = getEvaluator()->getEvaluatedData(block);
+
+		// Share the renderbuffer of a compatible render target, whose lifetime doesn't overlap
+		GLWrapper* aliasedWrapper = wrapper ? nullptr : getEvaluator()->getAliasedData(block);
+		if(aliasedWrapper)
+		{
+			wrapper = new GLWrapper(BlockType::RenderBuffer, aliasedWrapper->getValue());
+			getEvaluator()->setAliasedData(block, wrapper);
+		}
+
 		if(!wrapper)
 		{
 			// Create a new renderbuffer
@@ -78,6 +87,9 @@ namespace ysm
 			if(samples)
 				getEvaluator()->addWarning({"Multisampling currently not supported for Renderbuffers", block});
 
+			// Warn, if the storage exceeds the memory budget
+			getEvaluator()->requestMemory(block, MemoryCategory::GLRenderBuffer, EvaluationUtils::getImageMemorySize(format, width, height, 1));
+
 			f->glRenderbufferStorage(GL_RENDERBUFFER, format, width, height);
 
 			// Release Renderbuffer
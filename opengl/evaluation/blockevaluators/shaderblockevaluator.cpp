@@ -69,7 +69,7 @@ namespace ysm
 		BlockEvaluator::evaluate(block, pass);
 
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		// Get the type of the shader, depending on the given blocks type
 		QOpenGLShader::ShaderType shaderType;
@@ -167,7 +167,7 @@ namespace ysm
 			if(binding > maxBinding)
 				getEvaluator()->addWarning({QString("Binding point is not in the valid range [0, %1]").arg(maxBinding), block});
 
-			functions->glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer->getValue());
+			f->glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer->getValue());
 
 			functions->glShaderStorageBlockBinding(program->programId(), index, binding);
 		}
@@ -190,7 +190,7 @@ namespace ysm
 			if(binding > maxBinding)
 				getEvaluator()->addWarning({QString("Binding point is not in the valid range [0, %1]").arg(maxBinding), block});
 
-			functions->glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, binding, buffer->getValue());
+			f->glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, binding, buffer->getValue());
 		}
 #endif
 	}
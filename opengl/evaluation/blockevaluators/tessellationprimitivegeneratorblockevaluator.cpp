@@ -28,8 +28,7 @@
 
 #include "data/iblock.h"
 #include "data/properties/property.h"
-
-#include <QOpenGLFunctions_4_0_Core>
+#include "opengl/glconfiguration.h"
 
 namespace ysm
 {
@@ -55,8 +54,8 @@ namespace ysm
 		BlockEvaluator::evaluate(block, pass);
 
 		// Get a functions object on the currently active context
-		QOpenGLFunctions_4_0_Core* f = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_4_0_Core>();
-		if(!f)
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
+		if(!f->hasVersion(4, 0))
 			throw EvaluationException("Tessellation Primitive Generator needs OpenGL 4.0, which is not supported by your system", block);
 
 		f->glPatchParameteri(GL_PATCH_VERTICES, *block->getProperty<UIntProperty>(PropertyID::TessellationPrimitiveGenerator_PatchVertices));
@@ -65,10 +65,19 @@ namespace ysm
 		BlockEvaluator::evaluate(block, pass);
 
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		// Look, if the block has already been evaluated
 		GLTextureWrapper* wrapper = getEvaluator()->getEvaluatedData<GLTextureWrapper>(block);
+
+		// Share the texture of a compatible render target, whose lifetime doesn't overlap
+		GLTextureWrapper* aliasedWrapper = wrapper ? nullptr : dynamic_cast<GLTextureWrapper*>(getEvaluator()->getAliasedData(block));
+		if(aliasedWrapper)
+		{
+			wrapper = new GLTextureWrapper(aliasedWrapper->getValue(), aliasedWrapper->getTarget());
+			getEvaluator()->setAliasedData(block, wrapper);
+		}
+
 		if(!wrapper)
 		{
 			// if wrapper was not found, create a new texture
@@ -128,6 +137,9 @@ namespace ysm
 					//calc and set number of possible mipmap levels
 					int levels = qFloor(qLn(qMax(width, height))/qLn(2)) + 1;
 
+					// Warn, if the storage exceeds the memory budget
+					getEvaluator()->requestMemory(block, MemoryCategory::GLTexture, EvaluationUtils::getImageMemorySize(sizedInternalFormat, width, height, 1, levels));
+
 					QOpenGLFunctions_4_2_Core* functions = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_4_2_Core>();
 
 					// set the actual data
@@ -136,7 +148,7 @@ namespace ysm
 					case TextureBaseBlock::Target_Proxy1D:
 					case TextureBaseBlock::Target_1D:
 						if(functions)
-							functions->glTexStorage1D(target,
+							f->glTexStorage1D(target,
 													  levels,
 													  sizedInternalFormat,
 													  width);
@@ -165,7 +177,7 @@ namespace ysm
 					case TextureBaseBlock::Target_CubeMapNegZ:
 					case TextureBaseBlock::Target_ProxyCubeMap:
 						if(functions)
-							functions->glTexStorage2D(target,
+							f->glTexStorage2D(target,
 													  levels,
 													  sizedInternalFormat,
 													  width,
@@ -192,7 +204,7 @@ namespace ysm
 					case TextureBaseBlock::Target_2DArray:
 					case TextureBaseBlock::Target_3D:
 						if(functions)
-							functions->glTexStorage3D(target,
+							f->glTexStorage3D(target,
 													  levels,
 													  sizedInternalFormat,
 													  width,
@@ -221,7 +233,7 @@ namespace ysm
 			//Texturemode available since 4.3 Version
 			QOpenGLFunctions_4_3_Core* functions = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_4_3_Core>();
 			if(functions)
-				functions->glTexParameteri(target, GL_DEPTH_STENCIL_TEXTURE_MODE, EvaluationUtils::mapTextureModeTypeToOpenGL(*block->getProperty<EnumProperty>(PropertyID::Texture_DepthStencilMode)));
+				f->glTexParameteri(target, GL_DEPTH_STENCIL_TEXTURE_MODE, EvaluationUtils::mapTextureModeTypeToOpenGL(*block->getProperty<EnumProperty>(PropertyID::Texture_DepthStencilMode)));
 #endif
 
 			//Swizzling
@@ -61,7 +61,7 @@ namespace ysm
 		BlockEvaluator::evaluate(block, pass);
 
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		// Look, if the block has already been evaluated
 		// Once, get the image data
@@ -91,32 +91,57 @@ namespace ysm
 
 			f->glBindTexture(target, textureName->getValue());
 
-			glm::tvec3<GLsizei> const extent(texture->extent());
 			GLsizei const faceTotal = static_cast<GLsizei>(texture->layers() * texture->faces());
 
 			//handle texture storage (available since OpenGL Version 4.2)
 			QOpenGLFunctions_4_2_Core* functions = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_4_2_Core>();
 			if(functions)
 			{
+				//drop the finest mipmap levels, until the texture fits into the memory budget
+				std::size_t const levelTotal = texture->levels();
+				std::size_t skippedLevels = 0;
+
+				auto getLevelsSize = [&](std::size_t firstLevel) -> qint64
+				{
+					qint64 size = 0;
+					for(std::size_t level = firstLevel; level < levelTotal; ++level)
+						size += static_cast<qint64>(texture->size(level)) * faceTotal;
+					return size;
+				};
+
+				for(; skippedLevels < levelTotal - 1; ++skippedLevels)
+					if(getEvaluator()->requestMemory(textureBlock, MemoryCategory::GLTexture, getLevelsSize(skippedLevels), false))
+						break;
+
+				//the coarsest level is always loaded, with a warning if it still doesn't fit
+				if(skippedLevels == levelTotal - 1)
+					getEvaluator()->requestMemory(textureBlock, MemoryCategory::GLTexture, getLevelsSize(skippedLevels));
+
+				if(skippedLevels > 0)
+					getEvaluator()->addWarning({QString("Dropped %1 mipmap levels to fit the texture memory budget").arg(skippedLevels), textureBlock});
+
+				glm::tvec3<GLsizei> const extent(texture->extent(skippedLevels));
+				GLint const levelCount = static_cast<GLint>(levelTotal - skippedLevels);
+
 				switch(texture->target())
 				{
 					case gli::TARGET_1D:
-						functions->glTexStorage1D(
-										target, static_cast<GLint>(texture->levels()), format.Internal, extent.x);
+						f->glTexStorage1D(
+										target, levelCount, format.Internal, extent.x);
 
 						break;
 					case gli::TARGET_1D_ARRAY:
 					case gli::TARGET_2D:
 					case gli::TARGET_CUBE:
-						functions->glTexStorage2D(
-										target, static_cast<GLint>(texture->levels()), format.Internal,
+						f->glTexStorage2D(
+										target, levelCount, format.Internal,
 										extent.x, texture->target() == gli::TARGET_2D ? extent.y : faceTotal);
 						break;
 					case gli::TARGET_2D_ARRAY:
 					case gli::TARGET_3D:
 					case gli::TARGET_CUBE_ARRAY:
-						functions->glTexStorage3D(
-										target, static_cast<GLint>(texture->levels()), format.Internal,
+						f->glTexStorage3D(
+										target, levelCount, format.Internal,
 										extent.x, extent.y,
 										texture->target() == gli::TARGET_3D ? extent.z : faceTotal);
 						break;
@@ -127,8 +152,9 @@ namespace ysm
 
 				for(std::size_t layer = 0; layer < texture->layers(); ++layer)
 				for(std::size_t face = 0; face < texture->faces(); ++face)
-				for(std::size_t level = 0; level < texture->levels(); ++level)
+				for(std::size_t level = skippedLevels; level < levelTotal; ++level)
 				{
+					GLint const levelGL = static_cast<GLint>(level - skippedLevels);
 					GLsizei const layerGL = static_cast<GLsizei>(layer);
 					glm::tvec3<GLsizei> extent(texture->extent(level));
 					target = gli::is_target_cube(texture->target())
@@ -141,12 +167,12 @@ namespace ysm
 						case gli::TARGET_1D:
 								if(gli::is_compressed(texture->format()))
 									f->glCompressedTexSubImage1D(
-														target, static_cast<GLint>(level), 0, extent.x,
+														target, levelGL, 0, extent.x,
 														format.Internal, static_cast<GLsizei>(texture->size(level)),
 														texture->data(layer, face, level));
 								else
 									f->glTexSubImage1D(
-														target, static_cast<GLint>(level), 0, extent.x,
+														target, levelGL, 0, extent.x,
 														format.External, format.Type,
 														texture->data(layer, face, level));
 
@@ -156,7 +182,7 @@ namespace ysm
 						case gli::TARGET_CUBE:
 								if(gli::is_compressed(texture->format()))
 									f->glCompressedTexSubImage2D(
-														target, static_cast<GLint>(level),
+														target, levelGL,
 														0, 0,
 														extent.x,
 														texture->target() == gli::TARGET_1D_ARRAY ? layerGL : extent.y,
@@ -164,7 +190,7 @@ namespace ysm
 														texture->data(layer, face, level));
 								else
 									f->glTexSubImage2D(
-														target, static_cast<GLint>(level),
+														target, levelGL,
 														0, 0,
 														extent.x,
 														texture->target() == gli::TARGET_1D_ARRAY ? layerGL : extent.y,
@@ -176,7 +202,7 @@ namespace ysm
 						case gli::TARGET_CUBE_ARRAY:
 								if(gli::is_compressed(texture->format()))
 									f->glCompressedTexSubImage3D(
-														target, static_cast<GLint>(level),
+														target, levelGL,
 														0, 0, 0,
 														extent.x, extent.y,
 														texture->target() == gli::TARGET_3D ? extent.z : layerGL,
@@ -184,7 +210,7 @@ namespace ysm
 														texture->data(layer, face, level));
 								else
 									f->glTexSubImage3D(
-														target, static_cast<GLint>(level),
+														target, levelGL,
 														0, 0, 0,
 														extent.x, extent.y,
 														texture->target() == gli::TARGET_3D ? extent.z : layerGL,
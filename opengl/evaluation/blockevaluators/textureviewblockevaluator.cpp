@@ -36,7 +36,6 @@
 #include "data/iconnection.h"
 #include "data/blocks/texturebaseblock.h"
 
-#include <QOpenGLFunctions_4_3_Core>
 #include <QOpenGLShaderProgram>
 
 namespace ysm
@@ -71,7 +70,7 @@ namespace ysm
 		BlockEvaluator::evaluate(block, pass);
 
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		// Look, if the block has already been evaluated
 		GLTextureWrapper* wrapper = getEvaluator()->getEvaluatedData<GLTextureWrapper>(block);
@@ -123,12 +122,11 @@ namespace ysm
 					}
 				}
 
-				QOpenGLFunctions_4_3_Core* functions = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_4_3_Core>();
-				if(!functions)
+				if(!f->hasVersion(4, 3))
 					throw EvaluationException("Texture Views need OpenGL 4.3, which is not supported by your system", block);
 
 				// Setup texture view
-				functions->glTextureView(texture,
+				f->glTextureView(texture,
 										 target,
 										 origTexture->getValue(),
 										 sizedInternalFormat,
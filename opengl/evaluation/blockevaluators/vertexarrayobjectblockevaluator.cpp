@@ -61,7 +61,7 @@ namespace ysm
 		BlockEvaluator::evaluate(block, pass);
 
 		// Get a functions object on the currently active context
-		GLConfiguration::Functions* f = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+		GLConfiguration::Functions* f = GLConfiguration::getFunctions();
 
 		// Look, if the block has already been evaluated
 		GLContextSensitiveWrapper* wrapper = getEvaluator()->getEvaluatedData<GLContextSensitiveWrapper>(block);
@@ -111,6 +111,9 @@ namespace ysm
 				f->glEnableVertexAttribArray(location);
 				f->glVertexAttribPointer(location, entry.size, type, entry.normalized, entry.stride, static_cast<char*>(0) + entry.offset);
 
+				// Per-instance attributes advance every divisor instances instead of every vertex
+				f->glVertexAttribDivisor(location, entry.divisor);
+
 				// Unbind buffer
 				f->glBindBuffer(GL_ARRAY_BUFFER, 0);
 			}
@@ -141,6 +141,7 @@ QString EvaluationUtils::mapDataTypeToString(GLDataType value)
 	case GLDataType::Float:		return "GL_FLOAT";
 	case GLDataType::Double:	return "GL_DOUBLE";
 	case GLDataType::Fixed:		return "GL_FIXED";
+	case GLDataType::Int2101010Rev:	return "GL_INT_2_10_10_10_REV";
 	default:					return ""; // Should not happen
 	}
 }
@@ -499,6 +500,7 @@ GLenum EvaluationUtils::mapDataTypeToOpenGL(GLDataType value)
 	case GLDataType::Float:		return GL_FLOAT;
 	case GLDataType::Double:	return GL_DOUBLE;
 	case GLDataType::Fixed:		return GL_FIXED;
+	case GLDataType::Int2101010Rev:	return GL_INT_2_10_10_10_REV;
 	default:					return 0; // Should not happen
 	}
 }
@@ -756,4 +758,95 @@ GLenum EvaluationUtils::mapPixelDataTypeToOpenGL(int value)
 	}
 }
 
+unsigned int EvaluationUtils::getInternalFormatBits(GLenum format)
+{
+	switch(format)
+	{
+	// Base formats, assuming 8 bits per component
+	case GL_RED:								return 8;
+	case GL_RG:									return 16;
+	case GL_RGB:								return 24;
+	case GL_RGBA:								return 32;
+	case GL_DEPTH_COMPONENT:					return 32;
+	case GL_DEPTH_STENCIL:						return 32;
+
+	// 8 bits
+	case GL_R8: case GL_R8_SNORM: case GL_R8I: case GL_R8UI:
+	case GL_R3_G3_B2: case GL_RGBA2:
+	case GL_STENCIL_INDEX8:
+		return 8;
+
+	// 16 bits
+	case GL_R16: case GL_R16_SNORM: case GL_R16F: case GL_R16I: case GL_R16UI:
+	case GL_RG8: case GL_RG8_SNORM: case GL_RG8I: case GL_RG8UI:
+	case GL_RGB4: case GL_RGB5: case GL_RGBA4: case GL_RGB5_A1:
+	case GL_DEPTH_COMPONENT16: case GL_STENCIL_INDEX16:
+		return 16;
+
+	// 24 bits
+	case GL_RGB8: case GL_RGB8_SNORM: case GL_RGB8I: case GL_RGB8UI: case GL_SRGB8:
+	case GL_DEPTH_COMPONENT24:
+		return 24;
+
+	// 32 bits
+	case GL_R32F: case GL_R32I: case GL_R32UI:
+	case GL_RG16: case GL_RG16_SNORM: case GL_RG16F: case GL_RG16I: case GL_RG16UI:
+	case GL_RGBA8: case GL_RGBA8_SNORM: case GL_RGBA8I: case GL_RGBA8UI: case GL_SRGB8_ALPHA8:
+	case GL_RGB10: case GL_RGB10_A2: case GL_RGB10_A2UI: case GL_R11F_G11F_B10F: case GL_RGB9_E5:
+	case GL_DEPTH24_STENCIL8: case GL_DEPTH_COMPONENT32F:
+		return 32;
+
+	// 36 to 48 bits
+	case GL_RGB12:								return 36;
+	case GL_RGB16_SNORM: case GL_RGB16F: case GL_RGB16I: case GL_RGB16UI:
+	case GL_RGBA12:
+		return 48;
+
+	// 64 bits
+	case GL_RG32F: case GL_RG32I: case GL_RG32UI:
+	case GL_RGBA16: case GL_RGBA16F: case GL_RGBA16I: case GL_RGBA16UI:
+	case GL_DEPTH32F_STENCIL8:
+		return 64;
+
+	// 96 and 128 bits
+	case GL_RGB32F: case GL_RGB32I: case GL_RGB32UI:
+		return 96;
+	case GL_RGBA32F: case GL_RGBA32I: case GL_RGBA32UI:
+		return 128;
+
+	// Compressed formats, per texel of a 4x4 block
+	case GL_COMPRESSED_RED_RGTC1: case GL_COMPRESSED_SIGNED_RED_RGTC1:
+	case GL_COMPRESSED_RED:
+		return 4;
+	case GL_COMPRESSED_RG_RGTC2: case GL_COMPRESSED_SIGNED_RG_RGTC2:
+	case GL_COMPRESSED_RGBA_BPTC_UNORM: case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+	case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT: case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+	case GL_COMPRESSED_RG: case GL_COMPRESSED_RGB: case GL_COMPRESSED_RGBA:
+	case GL_COMPRESSED_SRGB: case GL_COMPRESSED_SRGB_ALPHA:
+		return 8;
+
+	// Packed stencil formats below a byte
+	case GL_STENCIL_INDEX1:						return 1;
+	case GL_STENCIL_INDEX4:						return 4;
+	default:									return 0;
+	}
+}
+
+qint64 EvaluationUtils::getImageMemorySize(GLenum format, int width, int height, int depth, int levels, int samples)
+{
+	qint64 bits = getInternalFormatBits(format);
+	qint64 size = 0;
+
+	// Sum up the mipmap chain, each level is half as large in every dimension
+	for(int level = 0; level < qMax(levels, 1); level++)
+	{
+		size += qint64(qMax(width >> level, 1)) * qMax(height >> level, 1) * qMax(depth >> level, 1) * bits / 8;
+
+		if(width >> level <= 1 && height >> level <= 1 && depth >> level <= 1)
+			break;
+	}
+
+	return size * qMax(samples, 1);
+}
+
 }
@@ -75,6 +75,14 @@ namespace ysm
 		static GLenum mapPixelDataTypeToOpenGL(int value);
 
 
+		// Memory - to be used for memory accounting
+		/// @brief Returns the bits per texel of the given internal format, or 0 if unknown.
+		static unsigned int getInternalFormatBits(GLenum format);
+
+		/// @brief Returns the bytes needed by an image of the given internal format, including its mipmap chain.
+		static qint64 getImageMemorySize(GLenum format, int width, int height, int depth, int levels = 1, int samples = 1);
+
+
 	private:
 
 		// Static class
@@ -0,0 +1,344 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "rendertargetplanner.h"
+
+#include "opengl/glrenderpass.h"
+#include "opengl/glrenderpassset.h"
+#include "opengl/evaluation/evaluationutils.h"
+
+#include "data/iblock.h"
+#include "data/iconnection.h"
+#include "data/iport.h"
+#include "data/ipipeline.h"
+#include "data/irendercommand.h"
+#include "data/properties/property.h"
+#include "data/blocks/framebufferobjectblock.h"
+#include "data/blocks/readbackdatasourceblock.h"
+
+#include <QtMath>
+
+#include <algorithm>
+
+namespace ysm
+{
+
+RenderTargetPlanner::RenderTargetPlanner()
+	: _resourceCount(0),
+	  _unaliasedMemory(0),
+	  _aliasedMemory(0)
+{
+}
+
+void RenderTargetPlanner::clear()
+{
+	_targets.clear();
+	_targetIndices.clear();
+
+	_resourceCount = 0;
+	_unaliasedMemory = 0;
+	_aliasedMemory = 0;
+}
+
+const QList<RenderTargetPlanner::Target>& RenderTargetPlanner::getTargets() const
+{
+	return _targets;
+}
+
+QList<IBlock*> RenderTargetPlanner::getAliasedBlocks(IBlock* block) const
+{
+	QList<IBlock*> blocks;
+
+	int index = _targetIndices.value(block, -1);
+	if(index < 0)
+		return blocks;
+
+	for(const Target& target : _targets)
+	{
+		if(target.resource == _targets[index].resource && target.block != block)
+			blocks.append(target.block);
+	}
+
+	return blocks;
+}
+
+int RenderTargetPlanner::getResourceCount() const
+{
+	return _resourceCount;
+}
+
+qint64 RenderTargetPlanner::getUnaliasedMemory() const
+{
+	return _unaliasedMemory;
+}
+
+qint64 RenderTargetPlanner::getAliasedMemory() const
+{
+	return _aliasedMemory;
+}
+
+void RenderTargetPlanner::plan(GLRenderPassSet* renderPassSet, const QSet<IBlock*>& excludedBlocks)
+{
+	clear();
+
+	// Blocks used outside of this frame keep their own storage
+	QSet<IBlock*> sharedBlocks = excludedBlocks;
+	if(!getSharedBlocks(renderPassSet, sharedBlocks))
+		return;
+
+	// Candidates are the textures and render buffers attached to the framebuffer objects being rendered into
+	QList<IBlock*> candidates;
+	for(GLRenderPass* pass : renderPassSet->getRenderPasses())
+	{
+		IBlock* fbo = pass->getUniqueBlock(BlockType::FrameBufferObject);
+		if(!fbo)
+			continue;
+
+		for(IConnection* connection : fbo->getOutConnections())
+		{
+			IBlock* block = connection->getDest();
+			if((block->getType() == BlockType::Texture || block->getType() == BlockType::RenderBuffer) && !candidates.contains(block))
+				candidates.append(block);
+		}
+	}
+
+	QList<Step> steps = getExecutionSteps(renderPassSet);
+
+	for(IBlock* block : candidates)
+	{
+		if(sharedBlocks.contains(block))
+			continue;
+
+		// Collect all framebuffer objects writing the target
+		QList<IBlock*> fbos;
+		bool valid = true;
+		for(IConnection* connection : block->getInConnections())
+		{
+			IBlock* source = connection->getSource();
+			if(source->getType() == BlockType::FrameBufferObject && !fbos.contains(source))
+			{
+				fbos.append(source);
+				valid &= !sharedBlocks.contains(source);
+			}
+		}
+
+		// Texture views reference the storage of the target
+		for(IConnection* connection : block->getOutConnections())
+			valid &= (connection->getDest()->getType() != BlockType::TextureView);
+
+		Target target;
+		target.block = block;
+		target.firstStep = -1;
+		target.lastStep = -1;
+		target.resource = -1;
+
+		if(!valid || !describeTarget(block, target.bytes, target.key))
+			continue;
+
+		// The target lives from the first to the last step writing or reading it
+		for(int i = 0; i < steps.size() && valid; i++)
+		{
+			IBlock* fbo = steps[i].pass->getUniqueBlock(BlockType::FrameBufferObject);
+			bool written = fbo && fbos.contains(fbo);
+			if(!written && steps[i].pass->getOutConnections(block).isEmpty())
+				continue;
+
+			// Contents of an earlier frame must not be used, so the frame has to start with a clear
+			if(target.firstStep < 0)
+			{
+				valid = written && isCleared(steps[i].command, fbo, block);
+				target.firstStep = i;
+			}
+
+			target.lastStep = i;
+		}
+
+		if(valid && target.firstStep >= 0)
+			_targets.append(target);
+	}
+
+	// Assign the targets to resources in the order their lifetimes start. A resource is reused, if the lifetime of
+	// its last target ended before.
+	std::sort(_targets.begin(), _targets.end(), [](const Target& first, const Target& second) { return first.firstStep < second.firstStep; });
+
+	QList<int> resourceEnds;
+	for(int i = 0; i < _targets.size(); i++)
+	{
+		Target& target = _targets[i];
+		for(int j = 0; j < i && target.resource < 0; j++)
+		{
+			int resource = _targets[j].resource;
+			if(_targets[j].key == target.key && resourceEnds[resource] < target.firstStep)
+				target.resource = resource;
+		}
+
+		if(target.resource < 0)
+		{
+			target.resource = _resourceCount++;
+			resourceEnds.append(-1);
+			_aliasedMemory += target.bytes;
+		}
+
+		resourceEnds[target.resource] = target.lastStep;
+		_unaliasedMemory += target.bytes;
+		_targetIndices.insert(target.block, i);
+	}
+}
+
+QList<RenderTargetPlanner::Step> RenderTargetPlanner::getExecutionSteps(GLRenderPassSet* renderPassSet)
+{
+	QList<Step> steps;
+	for(IRenderCommand* command : renderPassSet->getPipeline()->getRenderCommands())
+	{
+		for(GLRenderPass* pass : renderPassSet->getRenderPasses())
+		{
+			if(!pass->getInvolvedRenderCommands().contains(command))
+				continue;
+
+			steps.append({command, pass});
+
+			// Clear commands are executed in their first pass, only
+			if(command->getCommand() == RenderCommandType::Clear)
+				break;
+		}
+	}
+
+	return steps;
+}
+
+bool RenderTargetPlanner::getSharedBlocks(GLRenderPassSet* renderPassSet, QSet<IBlock*>& sharedBlocks)
+{
+	IPipeline* pipeline = renderPassSet->getPipeline();
+
+	// Readbacks are requested after the frame has been rendered
+	for(IBlock* block : pipeline->getBlocks(BlockType::Readback))
+	{
+		ReadbackDataSourceBlock* readbackBlock = dynamic_cast<ReadbackDataSourceBlock*>(block);
+		if(readbackBlock && readbackBlock->getReadbackSource())
+			sharedBlocks.insert(readbackBlock->getReadbackSource());
+	}
+
+	// The evaluated objects are shared by all views, which render their frames independently
+	for(IBlock* block : pipeline->getBlocks(BlockType::Display))
+	{
+		if(block == renderPassSet->getOutputBlock())
+			continue;
+
+		GLRenderPassSet otherSet(block);
+		if(!otherSet.isValid())
+			return false;
+
+		for(GLRenderPass* pass : otherSet.getRenderPasses())
+			sharedBlocks.unite(pass->getInvolvedBlocks());
+	}
+
+	return true;
+}
+
+bool RenderTargetPlanner::isCleared(IRenderCommand* command, IBlock* fbo, IBlock* target)
+{
+	if(command->getCommand() != RenderCommandType::Clear)
+		return false;
+
+	bool color = *command->getProperty<BoolProperty>(PropertyID::Clear_ColorEnabled);
+	bool depth = *command->getProperty<BoolProperty>(PropertyID::Clear_DepthEnabled);
+	bool stencil = *command->getProperty<BoolProperty>(PropertyID::Clear_StencilEnabled);
+
+	for(IConnection* connection : fbo->getOutConnections())
+	{
+		if(connection->getDest() != target)
+			continue;
+
+		switch(*connection->getProperty<EnumProperty>(PropertyID::FrameBufferObject_Attachment))
+		{
+		case FrameBufferObjectBlock::Attachment_Color0:			if(!color) return false;				break;
+		case FrameBufferObjectBlock::Attachment_Depth:			if(!depth) return false;				break;
+		case FrameBufferObjectBlock::Attachment_Stencil:		if(!stencil) return false;				break;
+		case FrameBufferObjectBlock::Attachment_DepthStencil:	if(!depth || !stencil) return false;	break;
+		default:												return false;
+		}
+	}
+
+	return true;
+}
+
+bool RenderTargetPlanner::describeTarget(IBlock* target, qint64& bytes, QString& key)
+{
+	GLenum format = 0;
+	unsigned int width = 0, height = 0;
+	int levels = 1;
+
+	switch(target->getType())
+	{
+	case BlockType::Texture:
+	{
+		// Only textures rendered into have their size defined by the framebuffer object
+		QVector<IConnection*> dataCon = target->getPort(PortType::Data_In)->getInConnections();
+		if(dataCon.size() != 1 || dataCon[0]->getSource()->getType() != BlockType::FrameBufferObject)
+			return false;
+
+		IBlock* fbo = dataCon[0]->getSource();
+		if(target->getProperty<BoolProperty>(PropertyID::Texture_RenderBufferAutoSize)->getValue())
+		{
+			width = fbo->getProperty<UIntProperty>(PropertyID::RenderBuffer_Width)->getValue();
+			height = fbo->getProperty<UIntProperty>(PropertyID::RenderBuffer_Height)->getValue();
+		}
+		else
+		{
+			width = target->getProperty<UIntProperty>(PropertyID::Texture_Width)->getValue();
+			height = target->getProperty<UIntProperty>(PropertyID::Texture_Height)->getValue();
+		}
+
+		if(!width || !height)
+			return false;
+
+		// Same number of levels as allocated by the texture evaluator
+		levels = qFloor(qLn(qMax(width, height))/qLn(2)) + 1;
+		format = EvaluationUtils::mapInternalFormatToOpenGL(*target->getProperty<EnumProperty>(PropertyID::TextureBase_InternalFormat));
+		break;
+	}
+	case BlockType::RenderBuffer:
+		width = *target->getProperty<UIntProperty>(PropertyID::RenderBuffer_Width);
+		height = *target->getProperty<UIntProperty>(PropertyID::RenderBuffer_Height);
+		format = EvaluationUtils::mapInternalFormatToOpenGL(*target->getProperty<EnumProperty>(PropertyID::RenderBuffer_InternalFormat));
+		break;
+	default:
+		return false;
+	}
+
+	bytes = EvaluationUtils::getImageMemorySize(format, width, height, 1, levels);
+
+	// Texture parameters are part of the shared object, so all properties have to match
+	key = QString("%1:%2x%3").arg(static_cast<int>(target->getType())).arg(width).arg(height);
+	for(IProperty* property : target->getProperties())
+	{
+		if(property->getID() != PropertyID::MessageLog)
+			key += QString(";%1=%2").arg(static_cast<int>(property->getID())).arg(property->toString());
+	}
+
+	return true;
+}
+
+}
@@ -0,0 +1,128 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef RENDERTARGETPLANNER_H
+#define RENDERTARGETPLANNER_H
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+
+namespace ysm
+{
+
+	class IBlock;
+	class IRenderCommand;
+	class GLRenderPass;
+	class GLRenderPassSet;
+
+	/**
+	 * @brief The RenderTargetPlanner class lets transient render targets share their storage.
+	 * A texture or render buffer attached to a framebuffer object is transient, if its contents live within a single
+	 * frame: the first command using it in a frame clears it and nothing reads it after the frame, like readbacks or
+	 * other views. The planner replays the order the commands execute their passes in, computes the lifetime of every
+	 * transient target and assigns targets with identical storage and parameters, whose lifetimes don't overlap, to
+	 * the same physical resource. The evaluators create the resource once and alias it for all of its targets.
+	 */
+	class RenderTargetPlanner
+	{
+	public:
+
+		/// @brief A transient render target
+		struct Target
+		{
+			IBlock* block;			/*!< The texture or render buffer block. */
+			QString key;			/*!< Targets with the same key may share their storage. */
+			qint64 bytes;			/*!< The storage's size. */
+			int firstStep;			/*!< The first step using the target, which clears it. */
+			int lastStep;			/*!< The last step using the target. */
+			int resource;			/*!< The physical resource the target is assigned to. */
+		};
+
+	public:
+
+		/// @brief Constructs an empty plan.
+		RenderTargetPlanner();
+
+		/**
+		 * @brief plan				Plans the transient render targets of the given passes.
+		 * @param renderPassSet		The passes to be rendered
+		 * @param excludedBlocks	Blocks, that must keep their own storage, e.g. since they are already evaluated
+		 */
+		void plan(GLRenderPassSet* renderPassSet, const QSet<IBlock*>& excludedBlocks);
+
+		/// @brief Clears the plan.
+		void clear();
+
+		/// @brief Returns the transient targets, in the order their lifetimes start.
+		const QList<Target>& getTargets() const;
+
+		/// @brief Returns the other blocks, which share the storage of the given one.
+		QList<IBlock*> getAliasedBlocks(IBlock* block) const;
+
+		/// @brief Returns the number of physical resources the targets are assigned to.
+		int getResourceCount() const;
+
+		/// @brief Returns the peak transient memory without aliasing, in which all targets are allocated at once.
+		qint64 getUnaliasedMemory() const;
+
+		/// @brief Returns the peak transient memory with aliasing, which is the size of all physical resources.
+		qint64 getAliasedMemory() const;
+
+	private:
+
+		/// @brief A pass executed by a command
+		struct Step
+		{
+			IRenderCommand* command;	/*!< The executed command. */
+			GLRenderPass* pass;			/*!< The pass the command is executed in. */
+		};
+
+		/// @brief Returns the passes in the order they are executed by the commands, like the render view does.
+		static QList<Step> getExecutionSteps(GLRenderPassSet* renderPassSet);
+
+		/// @brief Collects the blocks used by readbacks and the other displays. Returns false, if they can't be determined.
+		static bool getSharedBlocks(GLRenderPassSet* renderPassSet, QSet<IBlock*>& sharedBlocks);
+
+		/// @brief Determines, whether the clear command clears all buffers the target is attached as.
+		static bool isCleared(IRenderCommand* command, IBlock* fbo, IBlock* target);
+
+		/// @brief Computes the target's storage size and the key describing its storage and parameters.
+		static bool describeTarget(IBlock* target, qint64& bytes, QString& key);
+
+	private:
+
+		QList<Target> _targets;
+		QHash<IBlock*, int> _targetIndices;
+
+		int _resourceCount;
+		qint64 _unaliasedMemory;
+		qint64 _aliasedMemory;
+	};
+
+}
+
+#endif // RENDERTARGETPLANNER_H
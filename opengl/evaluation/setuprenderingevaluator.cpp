@@ -26,6 +26,7 @@
 #include "setuprenderingevaluator.h"
 
 #include "opengl/evaluation/evaluationexception.h"
+#include "opengl/evaluation/evaluationutils.h"
 #include "opengl/glrenderpassset.h"
 #include "opengl/glrenderpass.h"
 #include "opengl/glwrapper.h"
@@ -64,6 +65,9 @@ namespace ysm
 
 SetupRenderingEvaluator::SetupRenderingEvaluator()
 {
+	for(int i = 0; i < MemoryTracker::CategoryCount; i++)
+		_requestedMemory[i] = 0;
+
 	// Register Non-Rendertime Evaluators
 	registerBlockEvaluator<BufferBlockEvaluator>();
 	registerBlockEvaluator<FrameBufferObjectBlockEvaluator>();
@@ -149,6 +153,24 @@ void SetupRenderingEvaluator::setEvaluatedData(IBlock *block, GLWrapper *data, b
 	_evaluationData.insert(block, data);
 }
 
+GLWrapper* SetupRenderingEvaluator::getAliasedData(IBlock* block) const
+{
+	for(IBlock* aliasedBlock : _renderTargetPlanner.getAliasedBlocks(block))
+	{
+		GLWrapper* wrapper = _evaluationData.value(aliasedBlock, nullptr);
+		if(wrapper)
+			return wrapper;
+	}
+
+	return nullptr;
+}
+
+void SetupRenderingEvaluator::setAliasedData(IBlock* block, GLWrapper* data)
+{
+	_evaluationData.insert(block, data);
+	_aliasedData.insert(data);
+}
+
 void SetupRenderingEvaluator::addWarning(const Warning& warning)
 {
 	_warnings.append(warning);
@@ -163,6 +185,9 @@ void SetupRenderingEvaluator::clear(bool destruct)
 	// Delete Wrappers
 	for(GLWrapper* wrapper : _evaluationData)
 	{
+		// The GL object is freed, so is its memory
+		MemoryTracker::getInstance()->removeUsage(wrapper);
+
 		// Extract actual GL name
 		GLuint value = wrapper->getValue();
 
@@ -173,10 +198,11 @@ void SetupRenderingEvaluator::clear(bool destruct)
 		// Skip, if no context is available
 		// Destruct flag is neccessary to avoid memory problems in destructor
 		// TODO: Find the cause of theese problems and handle them correctly
-		if(context && !destruct)
+		// Aliased objects are deleted by the wrapper owning them
+		if(context && !destruct && !_aliasedData.contains(wrapper))
 		{
 			// Get a OpenGL functions object. We use the context the ressource was created in.
-			GLConfiguration::Functions* f = context->versionFunctions<GLConfiguration::Functions>();
+			GLConfiguration::Functions* f = GLConfiguration::getFunctions(context);
 
 			// Delete shareable ressources, only
 			switch(wrapper->getType())
@@ -196,6 +222,8 @@ void SetupRenderingEvaluator::clear(bool destruct)
 
 	// Clear everything left
 	_evaluationData.clear();
+	_aliasedData.clear();
+	_renderTargetPlanner.clear();
 
 	// Delete storages
 	for(QOpenGLShaderProgram* shaderProgram : _shaderPrograms)
@@ -217,7 +245,7 @@ void SetupRenderingEvaluator::evaluate(GLRenderPassSet* renderPassSet)
 	if(renderPassSet->getOutputBlock()->getType() != getEvaluatedBlockType())
 		throw std::runtime_error("A SetupRenderingEvaluator can evaluate Display Blocks, only");
 
-	GLConfiguration::Functions* functions = QOpenGLContext::currentContext()->versionFunctions<GLConfiguration::Functions>();
+	GLConfiguration::Functions* functions = GLConfiguration::getFunctions();
 	if(!functions)
 		throw EvaluationException("The Functions object could not be initialized correctly");
 
@@ -233,9 +261,23 @@ void SetupRenderingEvaluator::evaluate(GLRenderPassSet* renderPassSet)
 	else
 		functions->glDisable(GL_FRAMEBUFFER_SRGB);
 
-	// Clear warnings
+	// Clear warnings and memory requests
 	_warnings.clear();
 
+	for(int i = 0; i < MemoryTracker::CategoryCount; i++)
+		_requestedMemory[i] = 0;
+
+	// Let transient render targets share their storage. Blocks evaluated for other views keep theirs.
+	_renderTargetPlanner.plan(renderPassSet, _evaluationData.keys().toSet());
+
+	if(!_renderTargetPlanner.getTargets().isEmpty())
+		LogView::log(LogSeverity::Info, "Memory", QString("%1 transient render targets share %2 resources, peak memory %3 MB without and %4 MB with aliasing")
+					 .arg(_renderTargetPlanner.getTargets().size())
+					 .arg(_renderTargetPlanner.getResourceCount())
+					 .arg(_renderTargetPlanner.getUnaliasedMemory() / 1048576.0, 0, 'f', 1)
+					 .arg(_renderTargetPlanner.getAliasedMemory() / 1048576.0, 0, 'f', 1),
+					 static_cast<int>(renderPassSet->getOutputBlock()->getID()));
+
 	// Evaluate all passes contained in the set
 	for(GLRenderPass* pass : renderPassSet->getRenderPasses())
 	{
@@ -256,10 +298,13 @@ void SetupRenderingEvaluator::evaluate(GLRenderPassSet* renderPassSet)
 					blockEvaluator->evaluate(block, pass);
 			}
 			else
-				LogView::log(QString("No evaluator registered for Type %1")
+				LogView::log(LogSeverity::Warning, "Evaluation", QString("No evaluator registered for Type %1")
 							 .arg(static_cast<int>(type)));
 		}
 	}
+
+	// Report the actual sizes of the created objects
+	accountMemory();
 }
 
 void SetupRenderingEvaluator::initializeContext(IBlock* block, GLRenderPass* pass)
@@ -277,8 +322,125 @@ void SetupRenderingEvaluator::initializeContext(IBlock* block, GLRenderPass* pas
 			blockEvaluator->evaluate(block, pass);
 	}
 	else
-		LogView::log(QString("No initializer registered for Type %1")
-					 .arg(static_cast<int>(type)));
+		LogView::log(LogSeverity::Warning, "Evaluation", QString("No initializer registered for Type %1")
+					 .arg(static_cast<int>(type)), block->getID());
+}
+
+bool SetupRenderingEvaluator::requestMemory(IBlock* block, MemoryCategory category, qint64 bytes, bool warn)
+{
+	int index = static_cast<int>(category);
+	MemoryTracker* memoryTracker = MemoryTracker::getInstance();
+
+	// The objects created by earlier evaluations of this evaluator were already freed by clear()
+	bool fits = memoryTracker->fitsBudget(category, _requestedMemory[index] + bytes);
+
+	if(fits || warn)
+		_requestedMemory[index] += bytes;
+
+	if(!fits && warn)
+		addWarning({QString("%1 of %2 MB exceed the memory budget of %3 (%4 MB)")
+					.arg(block->getName())
+					.arg(bytes / 1048576.0, 0, 'f', 1)
+					.arg(MemoryTracker::getCategoryName(category))
+					.arg(memoryTracker->getBudget(category) / 1048576.0, 0, 'f', 0), block});
+
+	return fits;
+}
+
+void SetupRenderingEvaluator::accountMemory()
+{
+	// Use the plain functions, so that the queries are not recorded into an active trace
+	QOpenGLFunctions_3_3_Core* f = GLConfiguration::getFunctions();
+
+	for(auto it = _evaluationData.constBegin(); it != _evaluationData.constEnd(); ++it)
+	{
+		IBlock* block = it.key();
+		GLWrapper* wrapper = it.value();
+
+		// Aliased objects are accounted for the block owning them
+		GLuint value = wrapper->getValue();
+		if(!value || _aliasedData.contains(wrapper))
+			continue;
+
+		MemoryCategory category = MemoryCategory::GLBuffer;
+		qint64 bytes = 0;
+
+		switch(block->getType())
+		{
+		case BlockType::Buffer:
+		{
+			GLint size = 0;
+			f->glBindBuffer(GL_COPY_READ_BUFFER, value);
+			f->glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+			f->glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+			category = MemoryCategory::GLBuffer;
+			bytes = size;
+			break;
+		}
+		case BlockType::RenderBuffer:
+		{
+			GLint width = 0, height = 0, format = 0, samples = 0;
+			f->glBindRenderbuffer(GL_RENDERBUFFER, value);
+			f->glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_WIDTH, &width);
+			f->glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_HEIGHT, &height);
+			f->glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_INTERNAL_FORMAT, &format);
+			f->glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_SAMPLES, &samples);
+			f->glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+			category = MemoryCategory::GLRenderBuffer;
+			bytes = EvaluationUtils::getImageMemorySize(format, width, height, 1, 1, samples);
+			break;
+		}
+		case BlockType::Texture:
+		{
+			// Texture buffers use the buffer's memory, which is already accounted
+			GLTextureWrapper* texture = dynamic_cast<GLTextureWrapper*>(wrapper);
+			if(!texture || texture->getTarget() == GL_TEXTURE_BUFFER)
+				continue;
+
+			GLenum target = texture->getTarget();
+			bool isCubeMap = (target == GL_TEXTURE_CUBE_MAP);
+			GLenum levelTarget = isCubeMap ? GL_TEXTURE_CUBE_MAP_POSITIVE_X : target;
+
+			// Sum up all defined levels, computed from their internal format and dimensions
+			f->glBindTexture(target, value);
+			for(GLint level = 0; level < 32; level++)
+			{
+				GLint width = 0, height = 0, depth = 0, format = 0, samples = 0, compressed = 0;
+				f->glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_WIDTH, &width);
+				if(width <= 0)
+					break;
+
+				f->glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_HEIGHT, &height);
+				f->glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_DEPTH, &depth);
+				f->glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_INTERNAL_FORMAT, &format);
+				f->glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_SAMPLES, &samples);
+				f->glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_COMPRESSED, &compressed);
+
+				qint64 levelBytes = 0;
+				if(compressed)
+				{
+					GLint compressedSize = 0;
+					f->glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &compressedSize);
+					levelBytes = compressedSize;
+				}
+				else
+					levelBytes = EvaluationUtils::getImageMemorySize(format, width, height, depth, 1, samples);
+
+				bytes += levelBytes * (isCubeMap ? 6 : 1);
+			}
+			f->glBindTexture(target, 0);
+
+			category = MemoryCategory::GLTexture;
+			break;
+		}
+		default:
+			continue;
+		}
+
+		MemoryTracker::getInstance()->setUsage(wrapper, category, bytes, block->getName(), static_cast<int>(block->getID()));
+	}
 }
 
 
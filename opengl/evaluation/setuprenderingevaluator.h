@@ -27,9 +27,12 @@
 #define SETUPRENDERINGEVALUATOR_H
 
 #include "iglrenderpassevaluator.h"
+#include "rendertargetplanner.h"
+#include "data/common/memorytracker.h"
 
 #include <QLinkedList>
 #include <QMap>
+#include <QSet>
 
 QT_BEGIN_NAMESPACE
 class QOpenGLShaderProgram;
@@ -81,11 +84,31 @@ namespace ysm
 		/// @brief Maps evaluated data to the given block.
 		void setEvaluatedData(IBlock* block, GLWrapper* data, bool replace = true);
 
+		/// @brief Returns the evaluated data of a transient render target, whose storage the given block may share.
+		GLWrapper* getAliasedData(IBlock* block) const;
+
+		/// @brief Maps evaluated data sharing the GL object of another block, which owns and deletes it.
+		void setAliasedData(IBlock* block, GLWrapper* data);
+
 		/// @brief Applies the settings provides by the specified block to the currently active OpenGL context
 		void initializeContext(IBlock* block, GLRenderPass* pass);
 
+		/**
+		 * @brief Checks, whether an allocation fits into the memory budget, before it is made.
+		 * The allocations requested during an evaluation are summed up, as they are accounted after the evaluation.
+		 * @param block The block, that allocates the memory
+		 * @param category The allocation's category
+		 * @param bytes The allocation's size
+		 * @param warn If true, a warning is added and the allocation is assumed to be made, even if it doesn't fit
+		 * @return True, if the allocation fits
+		 */
+		bool requestMemory(IBlock* block, MemoryCategory category, qint64 bytes, bool warn = true);
+
 	private:
 
+		/// @brief Reports the sizes of the evaluated GL objects to the memory tracker.
+		void accountMemory();
+
 		/// @brief Registers a particular evaluator and updates the evaluation order
 		template<typename T>
 		void registerBlockEvaluator();
@@ -103,6 +126,11 @@ namespace ysm
 		QMap<GLRenderPass*, QOpenGLShaderProgram*> _shaderPrograms;
 
 		QList<Warning> _warnings;
+
+		RenderTargetPlanner _renderTargetPlanner;
+		QSet<GLWrapper*> _aliasedData;
+
+		qint64 _requestedMemory[MemoryTracker::CategoryCount];
 	};
 
 	template<typename T>
@@ -0,0 +1,1910 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "glcodegenerator.h"
+#include "glrenderpass.h"
+#include "glrenderpassset.h"
+#include "glwrapper.h"
+
+#include "evaluation/setuprenderingevaluator.h"
+#include "evaluation/evaluationutils.h"
+
+#include "data/iblock.h"
+#include "data/iport.h"
+#include "data/iconnection.h"
+#include "data/properties/standardproperties.h"
+
+#include <QOpenGLShaderProgram>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QRegExp>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace ysm
+{
+
+namespace
+{
+	/// @brief Name of an OpenGL enum, as written into the generated code
+	struct EnumName
+	{
+		GLenum value;
+		const char* name;
+	};
+
+#define ENUM_NAME(e) { e, #e }
+
+	const EnumName primitiveNames[] = {
+		ENUM_NAME(GL_POINTS), ENUM_NAME(GL_LINES), ENUM_NAME(GL_LINE_LOOP), ENUM_NAME(GL_LINE_STRIP),
+		ENUM_NAME(GL_TRIANGLES), ENUM_NAME(GL_TRIANGLE_STRIP), ENUM_NAME(GL_TRIANGLE_FAN), ENUM_NAME(GL_LINES_ADJACENCY),
+		ENUM_NAME(GL_LINE_STRIP_ADJACENCY), ENUM_NAME(GL_TRIANGLES_ADJACENCY), ENUM_NAME(GL_TRIANGLE_STRIP_ADJACENCY),
+		ENUM_NAME(GL_PATCHES)
+	};
+
+	const EnumName textureTargetNames[] = {
+		ENUM_NAME(GL_TEXTURE_1D), ENUM_NAME(GL_TEXTURE_2D), ENUM_NAME(GL_TEXTURE_3D), ENUM_NAME(GL_TEXTURE_1D_ARRAY),
+		ENUM_NAME(GL_TEXTURE_2D_ARRAY), ENUM_NAME(GL_TEXTURE_RECTANGLE), ENUM_NAME(GL_TEXTURE_CUBE_MAP),
+		ENUM_NAME(GL_TEXTURE_CUBE_MAP_ARRAY), ENUM_NAME(GL_TEXTURE_BUFFER), ENUM_NAME(GL_TEXTURE_2D_MULTISAMPLE),
+		ENUM_NAME(GL_TEXTURE_2D_MULTISAMPLE_ARRAY), ENUM_NAME(GL_TEXTURE_CUBE_MAP_POSITIVE_X),
+		ENUM_NAME(GL_TEXTURE_CUBE_MAP_NEGATIVE_X), ENUM_NAME(GL_TEXTURE_CUBE_MAP_POSITIVE_Y),
+		ENUM_NAME(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y), ENUM_NAME(GL_TEXTURE_CUBE_MAP_POSITIVE_Z),
+		ENUM_NAME(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
+	};
+
+	const EnumName filterNames[] = {
+		ENUM_NAME(GL_NEAREST), ENUM_NAME(GL_LINEAR), ENUM_NAME(GL_NEAREST_MIPMAP_NEAREST), ENUM_NAME(GL_NEAREST_MIPMAP_LINEAR),
+		ENUM_NAME(GL_LINEAR_MIPMAP_NEAREST), ENUM_NAME(GL_LINEAR_MIPMAP_LINEAR)
+	};
+
+	const EnumName wrapModeNames[] = {
+		ENUM_NAME(GL_REPEAT), ENUM_NAME(GL_CLAMP_TO_EDGE), ENUM_NAME(GL_CLAMP_TO_BORDER), ENUM_NAME(GL_MIRRORED_REPEAT)
+	};
+
+	const EnumName compareModeNames[] = {
+		ENUM_NAME(GL_NONE), ENUM_NAME(GL_COMPARE_REF_TO_TEXTURE)
+	};
+
+	const EnumName compareFunctionNames[] = {
+		ENUM_NAME(GL_NEVER), ENUM_NAME(GL_LESS), ENUM_NAME(GL_EQUAL), ENUM_NAME(GL_LEQUAL), ENUM_NAME(GL_GREATER),
+		ENUM_NAME(GL_NOTEQUAL), ENUM_NAME(GL_GEQUAL), ENUM_NAME(GL_ALWAYS)
+	};
+
+	const EnumName swizzleNames[] = {
+		ENUM_NAME(GL_RED), ENUM_NAME(GL_GREEN), ENUM_NAME(GL_BLUE), ENUM_NAME(GL_ALPHA), ENUM_NAME(GL_ZERO), ENUM_NAME(GL_ONE)
+	};
+
+	const EnumName depthStencilModeNames[] = {
+		ENUM_NAME(GL_DEPTH_COMPONENT), ENUM_NAME(GL_STENCIL_INDEX)
+	};
+
+	const EnumName blendFactorNames[] = {
+		ENUM_NAME(GL_ZERO), ENUM_NAME(GL_ONE), ENUM_NAME(GL_SRC_COLOR), ENUM_NAME(GL_ONE_MINUS_SRC_COLOR),
+		ENUM_NAME(GL_DST_COLOR), ENUM_NAME(GL_ONE_MINUS_DST_COLOR), ENUM_NAME(GL_SRC_ALPHA), ENUM_NAME(GL_ONE_MINUS_SRC_ALPHA),
+		ENUM_NAME(GL_DST_ALPHA), ENUM_NAME(GL_ONE_MINUS_DST_ALPHA), ENUM_NAME(GL_CONSTANT_COLOR),
+		ENUM_NAME(GL_ONE_MINUS_CONSTANT_COLOR), ENUM_NAME(GL_CONSTANT_ALPHA), ENUM_NAME(GL_ONE_MINUS_CONSTANT_ALPHA),
+		ENUM_NAME(GL_SRC_ALPHA_SATURATE), ENUM_NAME(GL_SRC1_COLOR), ENUM_NAME(GL_ONE_MINUS_SRC1_COLOR),
+		ENUM_NAME(GL_SRC1_ALPHA), ENUM_NAME(GL_ONE_MINUS_SRC1_ALPHA)
+	};
+
+	const EnumName blendEquationNames[] = {
+		ENUM_NAME(GL_FUNC_ADD), ENUM_NAME(GL_FUNC_SUBTRACT), ENUM_NAME(GL_FUNC_REVERSE_SUBTRACT), ENUM_NAME(GL_MIN), ENUM_NAME(GL_MAX)
+	};
+
+	const EnumName logicOpNames[] = {
+		ENUM_NAME(GL_CLEAR), ENUM_NAME(GL_AND), ENUM_NAME(GL_AND_REVERSE), ENUM_NAME(GL_COPY), ENUM_NAME(GL_AND_INVERTED),
+		ENUM_NAME(GL_NOOP), ENUM_NAME(GL_XOR), ENUM_NAME(GL_OR), ENUM_NAME(GL_NOR), ENUM_NAME(GL_EQUIV), ENUM_NAME(GL_INVERT),
+		ENUM_NAME(GL_OR_REVERSE), ENUM_NAME(GL_COPY_INVERTED), ENUM_NAME(GL_OR_INVERTED), ENUM_NAME(GL_NAND), ENUM_NAME(GL_SET)
+	};
+
+	const EnumName stencilOpNames[] = {
+		ENUM_NAME(GL_KEEP), ENUM_NAME(GL_ZERO), ENUM_NAME(GL_REPLACE), ENUM_NAME(GL_INCR), ENUM_NAME(GL_INCR_WRAP),
+		ENUM_NAME(GL_DECR), ENUM_NAME(GL_DECR_WRAP), ENUM_NAME(GL_INVERT)
+	};
+
+	const EnumName faceNames[] = {
+		ENUM_NAME(GL_FRONT), ENUM_NAME(GL_BACK), ENUM_NAME(GL_FRONT_AND_BACK), ENUM_NAME(GL_CW), ENUM_NAME(GL_CCW)
+	};
+
+	const EnumName polygonModeNames[] = {
+		ENUM_NAME(GL_POINT), ENUM_NAME(GL_LINE), ENUM_NAME(GL_FILL)
+	};
+
+	const EnumName vertexTypeNames[] = {
+		ENUM_NAME(GL_BYTE), ENUM_NAME(GL_UNSIGNED_BYTE), ENUM_NAME(GL_SHORT), ENUM_NAME(GL_UNSIGNED_SHORT), ENUM_NAME(GL_INT),
+		ENUM_NAME(GL_UNSIGNED_INT), ENUM_NAME(GL_HALF_FLOAT), ENUM_NAME(GL_FLOAT), ENUM_NAME(GL_DOUBLE), ENUM_NAME(GL_FIXED),
+		ENUM_NAME(GL_INT_2_10_10_10_REV), ENUM_NAME(GL_UNSIGNED_INT_2_10_10_10_REV), ENUM_NAME(GL_UNSIGNED_INT_10F_11F_11F_REV)
+	};
+
+	const EnumName bufferModeNames[] = {
+		ENUM_NAME(GL_INTERLEAVED_ATTRIBS), ENUM_NAME(GL_SEPARATE_ATTRIBS)
+	};
+
+	/// @brief Returns the name of the given value, or its number, if the value is unknown.
+	template<size_t N>
+	QString nameOf(GLenum value, const EnumName (&names)[N])
+	{
+		for(const EnumName& name : names)
+		{
+			if(name.value == value)
+				return name.name;
+		}
+
+		return QString("0x%1").arg(value, 4, 16, QChar('0'));
+	}
+
+	/// @brief Capability toggled by glEnable and glDisable
+	struct Capability
+	{
+		GLenum value;
+		const char* name;
+		bool enabled;			/*!< Whether the capability is enabled in a new context. */
+	};
+
+#define CAPABILITY(e, enabled) { e, #e, enabled }
+
+	const Capability capabilities[] = {
+		CAPABILITY(GL_BLEND, false), CAPABILITY(GL_COLOR_LOGIC_OP, false), CAPABILITY(GL_CULL_FACE, false),
+		CAPABILITY(GL_DEPTH_CLAMP, false), CAPABILITY(GL_DEPTH_TEST, false), CAPABILITY(GL_DITHER, true),
+		CAPABILITY(GL_FRAMEBUFFER_SRGB, false), CAPABILITY(GL_LINE_SMOOTH, false), CAPABILITY(GL_MULTISAMPLE, true),
+		CAPABILITY(GL_POLYGON_OFFSET_FILL, false), CAPABILITY(GL_POLYGON_OFFSET_LINE, false),
+		CAPABILITY(GL_POLYGON_OFFSET_POINT, false), CAPABILITY(GL_POLYGON_SMOOTH, false),
+		CAPABILITY(GL_PRIMITIVE_RESTART, false), CAPABILITY(GL_PROGRAM_POINT_SIZE, false),
+		CAPABILITY(GL_RASTERIZER_DISCARD, false), CAPABILITY(GL_SAMPLE_ALPHA_TO_COVERAGE, false),
+		CAPABILITY(GL_SAMPLE_ALPHA_TO_ONE, false), CAPABILITY(GL_SAMPLE_COVERAGE, false), CAPABILITY(GL_SCISSOR_TEST, false),
+		CAPABILITY(GL_STENCIL_TEST, false), CAPABILITY(GL_TEXTURE_CUBE_MAP_SEAMLESS, false)
+	};
+
+	/// @brief Texture target together with the query for the texture bound to it
+	struct TextureTarget
+	{
+		GLenum target;
+		GLenum binding;
+	};
+
+	const TextureTarget textureTargets[] = {
+		{ GL_TEXTURE_1D, GL_TEXTURE_BINDING_1D }, { GL_TEXTURE_2D, GL_TEXTURE_BINDING_2D },
+		{ GL_TEXTURE_3D, GL_TEXTURE_BINDING_3D }, { GL_TEXTURE_1D_ARRAY, GL_TEXTURE_BINDING_1D_ARRAY },
+		{ GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BINDING_2D_ARRAY }, { GL_TEXTURE_RECTANGLE, GL_TEXTURE_BINDING_RECTANGLE },
+		{ GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BINDING_CUBE_MAP }, { GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_BINDING_CUBE_MAP_ARRAY },
+		{ GL_TEXTURE_BUFFER, GL_TEXTURE_BINDING_BUFFER }, { GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_BINDING_2D_MULTISAMPLE },
+		{ GL_TEXTURE_2D_MULTISAMPLE_ARRAY, GL_TEXTURE_BINDING_2D_MULTISAMPLE_ARRAY }
+	};
+
+	/// @brief Pixel transfer parameters, which read and upload an internal format without conversion
+	struct PixelFormat
+	{
+		GLenum internalFormat;
+		const char* name;
+		GLenum format;
+		const char* formatName;
+		GLenum type;
+		const char* typeName;
+		int size;				/*!< Size of a single pixel in bytes. */
+	};
+
+#define PIXEL_FORMAT(internalFormat, format, type, size) { internalFormat, #internalFormat, format, #format, type, #type, size }
+
+	const PixelFormat pixelFormats[] = {
+		PIXEL_FORMAT(GL_R8, GL_RED, GL_UNSIGNED_BYTE, 1),
+		PIXEL_FORMAT(GL_R8_SNORM, GL_RED, GL_BYTE, 1),
+		PIXEL_FORMAT(GL_R16, GL_RED, GL_UNSIGNED_SHORT, 2),
+		PIXEL_FORMAT(GL_R16_SNORM, GL_RED, GL_SHORT, 2),
+		PIXEL_FORMAT(GL_RG8, GL_RG, GL_UNSIGNED_BYTE, 2),
+		PIXEL_FORMAT(GL_RG8_SNORM, GL_RG, GL_BYTE, 2),
+		PIXEL_FORMAT(GL_RG16, GL_RG, GL_UNSIGNED_SHORT, 4),
+		PIXEL_FORMAT(GL_RG16_SNORM, GL_RG, GL_SHORT, 4),
+		PIXEL_FORMAT(GL_R3_G3_B2, GL_RGB, GL_UNSIGNED_BYTE_3_3_2, 1),
+		PIXEL_FORMAT(GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, 3),
+		PIXEL_FORMAT(GL_RGB8_SNORM, GL_RGB, GL_BYTE, 3),
+		PIXEL_FORMAT(GL_RGB16, GL_RGB, GL_UNSIGNED_SHORT, 6),
+		PIXEL_FORMAT(GL_RGB16_SNORM, GL_RGB, GL_SHORT, 6),
+		PIXEL_FORMAT(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4),
+		PIXEL_FORMAT(GL_RGBA8_SNORM, GL_RGBA, GL_BYTE, 4),
+		PIXEL_FORMAT(GL_RGBA16, GL_RGBA, GL_UNSIGNED_SHORT, 8),
+		PIXEL_FORMAT(GL_RGBA16_SNORM, GL_RGBA, GL_SHORT, 8),
+		PIXEL_FORMAT(GL_RGB10_A2, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV, 4),
+		PIXEL_FORMAT(GL_RGB10_A2UI, GL_RGBA_INTEGER, GL_UNSIGNED_INT_2_10_10_10_REV, 4),
+		PIXEL_FORMAT(GL_SRGB8, GL_RGB, GL_UNSIGNED_BYTE, 3),
+		PIXEL_FORMAT(GL_SRGB8_ALPHA8, GL_RGBA, GL_UNSIGNED_BYTE, 4),
+		PIXEL_FORMAT(GL_R16F, GL_RED, GL_HALF_FLOAT, 2),
+		PIXEL_FORMAT(GL_RG16F, GL_RG, GL_HALF_FLOAT, 4),
+		PIXEL_FORMAT(GL_RGB16F, GL_RGB, GL_HALF_FLOAT, 6),
+		PIXEL_FORMAT(GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8),
+		PIXEL_FORMAT(GL_R32F, GL_RED, GL_FLOAT, 4),
+		PIXEL_FORMAT(GL_RG32F, GL_RG, GL_FLOAT, 8),
+		PIXEL_FORMAT(GL_RGB32F, GL_RGB, GL_FLOAT, 12),
+		PIXEL_FORMAT(GL_RGBA32F, GL_RGBA, GL_FLOAT, 16),
+		PIXEL_FORMAT(GL_R11F_G11F_B10F, GL_RGB, GL_UNSIGNED_INT_10F_11F_11F_REV, 4),
+		PIXEL_FORMAT(GL_RGB9_E5, GL_RGB, GL_UNSIGNED_INT_5_9_9_9_REV, 4),
+		PIXEL_FORMAT(GL_R8I, GL_RED_INTEGER, GL_BYTE, 1),
+		PIXEL_FORMAT(GL_R8UI, GL_RED_INTEGER, GL_UNSIGNED_BYTE, 1),
+		PIXEL_FORMAT(GL_R16I, GL_RED_INTEGER, GL_SHORT, 2),
+		PIXEL_FORMAT(GL_R16UI, GL_RED_INTEGER, GL_UNSIGNED_SHORT, 2),
+		PIXEL_FORMAT(GL_R32I, GL_RED_INTEGER, GL_INT, 4),
+		PIXEL_FORMAT(GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, 4),
+		PIXEL_FORMAT(GL_RG8I, GL_RG_INTEGER, GL_BYTE, 2),
+		PIXEL_FORMAT(GL_RG8UI, GL_RG_INTEGER, GL_UNSIGNED_BYTE, 2),
+		PIXEL_FORMAT(GL_RG16I, GL_RG_INTEGER, GL_SHORT, 4),
+		PIXEL_FORMAT(GL_RG16UI, GL_RG_INTEGER, GL_UNSIGNED_SHORT, 4),
+		PIXEL_FORMAT(GL_RG32I, GL_RG_INTEGER, GL_INT, 8),
+		PIXEL_FORMAT(GL_RG32UI, GL_RG_INTEGER, GL_UNSIGNED_INT, 8),
+		PIXEL_FORMAT(GL_RGB8I, GL_RGB_INTEGER, GL_BYTE, 3),
+		PIXEL_FORMAT(GL_RGB8UI, GL_RGB_INTEGER, GL_UNSIGNED_BYTE, 3),
+		PIXEL_FORMAT(GL_RGB16I, GL_RGB_INTEGER, GL_SHORT, 6),
+		PIXEL_FORMAT(GL_RGB16UI, GL_RGB_INTEGER, GL_UNSIGNED_SHORT, 6),
+		PIXEL_FORMAT(GL_RGB32I, GL_RGB_INTEGER, GL_INT, 12),
+		PIXEL_FORMAT(GL_RGB32UI, GL_RGB_INTEGER, GL_UNSIGNED_INT, 12),
+		PIXEL_FORMAT(GL_RGBA8I, GL_RGBA_INTEGER, GL_BYTE, 4),
+		PIXEL_FORMAT(GL_RGBA8UI, GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, 4),
+		PIXEL_FORMAT(GL_RGBA16I, GL_RGBA_INTEGER, GL_SHORT, 8),
+		PIXEL_FORMAT(GL_RGBA16UI, GL_RGBA_INTEGER, GL_UNSIGNED_SHORT, 8),
+		PIXEL_FORMAT(GL_RGBA32I, GL_RGBA_INTEGER, GL_INT, 16),
+		PIXEL_FORMAT(GL_RGBA32UI, GL_RGBA_INTEGER, GL_UNSIGNED_INT, 16),
+		PIXEL_FORMAT(GL_DEPTH_COMPONENT16, GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT, 2),
+		PIXEL_FORMAT(GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, 4),
+		PIXEL_FORMAT(GL_DEPTH_COMPONENT32, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, 4),
+		PIXEL_FORMAT(GL_DEPTH_COMPONENT32F, GL_DEPTH_COMPONENT, GL_FLOAT, 4),
+		PIXEL_FORMAT(GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, 4),
+		PIXEL_FORMAT(GL_DEPTH32F_STENCIL8, GL_DEPTH_STENCIL, GL_FLOAT_32_UNSIGNED_INT_24_8_REV, 8),
+		PIXEL_FORMAT(GL_STENCIL_INDEX8, GL_STENCIL_INDEX, GL_UNSIGNED_BYTE, 1),
+		PIXEL_FORMAT(GL_RED, GL_RED, GL_UNSIGNED_BYTE, 1),
+		PIXEL_FORMAT(GL_RG, GL_RG, GL_UNSIGNED_BYTE, 2),
+		PIXEL_FORMAT(GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, 3),
+		PIXEL_FORMAT(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, 4),
+		PIXEL_FORMAT(GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT, GL_FLOAT, 4),
+		PIXEL_FORMAT(GL_DEPTH_STENCIL, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, 4)
+	};
+
+	/// @brief Returns the transfer parameters of the given internal format, or null for compressed and unknown formats.
+	const PixelFormat* findPixelFormat(GLenum internalFormat)
+	{
+		for(const PixelFormat& pixelFormat : pixelFormats)
+		{
+			if(pixelFormat.internalFormat == internalFormat)
+				return &pixelFormat;
+		}
+
+		return nullptr;
+	}
+
+	/// @brief How the value of a uniform is read and set
+	enum UniformKind
+	{
+		UniformKind_Float,
+		UniformKind_Int,
+		UniformKind_UInt,
+		UniformKind_Matrix
+	};
+
+	struct UniformType
+	{
+		GLenum type;
+		UniformKind kind;
+		int components;
+		const char* function;
+	};
+
+	const UniformType uniformTypes[] = {
+		{ GL_FLOAT, UniformKind_Float, 1, "glUniform1f" },
+		{ GL_FLOAT_VEC2, UniformKind_Float, 2, "glUniform2f" },
+		{ GL_FLOAT_VEC3, UniformKind_Float, 3, "glUniform3f" },
+		{ GL_FLOAT_VEC4, UniformKind_Float, 4, "glUniform4f" },
+		{ GL_INT, UniformKind_Int, 1, "glUniform1i" },
+		{ GL_INT_VEC2, UniformKind_Int, 2, "glUniform2i" },
+		{ GL_INT_VEC3, UniformKind_Int, 3, "glUniform3i" },
+		{ GL_INT_VEC4, UniformKind_Int, 4, "glUniform4i" },
+		{ GL_BOOL, UniformKind_Int, 1, "glUniform1i" },
+		{ GL_BOOL_VEC2, UniformKind_Int, 2, "glUniform2i" },
+		{ GL_BOOL_VEC3, UniformKind_Int, 3, "glUniform3i" },
+		{ GL_BOOL_VEC4, UniformKind_Int, 4, "glUniform4i" },
+		{ GL_UNSIGNED_INT, UniformKind_UInt, 1, "glUniform1ui" },
+		{ GL_UNSIGNED_INT_VEC2, UniformKind_UInt, 2, "glUniform2ui" },
+		{ GL_UNSIGNED_INT_VEC3, UniformKind_UInt, 3, "glUniform3ui" },
+		{ GL_UNSIGNED_INT_VEC4, UniformKind_UInt, 4, "glUniform4ui" },
+		{ GL_FLOAT_MAT2, UniformKind_Matrix, 4, "glUniformMatrix2fv" },
+		{ GL_FLOAT_MAT3, UniformKind_Matrix, 9, "glUniformMatrix3fv" },
+		{ GL_FLOAT_MAT4, UniformKind_Matrix, 16, "glUniformMatrix4fv" },
+		{ GL_FLOAT_MAT2x3, UniformKind_Matrix, 6, "glUniformMatrix2x3fv" },
+		{ GL_FLOAT_MAT2x4, UniformKind_Matrix, 8, "glUniformMatrix2x4fv" },
+		{ GL_FLOAT_MAT3x2, UniformKind_Matrix, 6, "glUniformMatrix3x2fv" },
+		{ GL_FLOAT_MAT3x4, UniformKind_Matrix, 12, "glUniformMatrix3x4fv" },
+		{ GL_FLOAT_MAT4x2, UniformKind_Matrix, 8, "glUniformMatrix4x2fv" },
+		{ GL_FLOAT_MAT4x3, UniformKind_Matrix, 12, "glUniformMatrix4x3fv" }
+	};
+
+	/// @brief Sampler types, whose uniforms hold texture units
+	const GLenum samplerTypes[] = {
+		GL_SAMPLER_1D, GL_SAMPLER_2D, GL_SAMPLER_3D, GL_SAMPLER_CUBE, GL_SAMPLER_1D_SHADOW, GL_SAMPLER_2D_SHADOW,
+		GL_SAMPLER_1D_ARRAY, GL_SAMPLER_2D_ARRAY, GL_SAMPLER_1D_ARRAY_SHADOW, GL_SAMPLER_2D_ARRAY_SHADOW,
+		GL_SAMPLER_2D_MULTISAMPLE, GL_SAMPLER_2D_MULTISAMPLE_ARRAY, GL_SAMPLER_CUBE_SHADOW, GL_SAMPLER_BUFFER,
+		GL_SAMPLER_2D_RECT, GL_SAMPLER_2D_RECT_SHADOW, GL_SAMPLER_CUBE_MAP_ARRAY, GL_SAMPLER_CUBE_MAP_ARRAY_SHADOW,
+		GL_INT_SAMPLER_1D, GL_INT_SAMPLER_2D, GL_INT_SAMPLER_3D, GL_INT_SAMPLER_CUBE, GL_INT_SAMPLER_1D_ARRAY,
+		GL_INT_SAMPLER_2D_ARRAY, GL_INT_SAMPLER_2D_MULTISAMPLE, GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY, GL_INT_SAMPLER_BUFFER,
+		GL_INT_SAMPLER_2D_RECT, GL_INT_SAMPLER_CUBE_MAP_ARRAY, GL_UNSIGNED_INT_SAMPLER_1D, GL_UNSIGNED_INT_SAMPLER_2D,
+		GL_UNSIGNED_INT_SAMPLER_3D, GL_UNSIGNED_INT_SAMPLER_CUBE, GL_UNSIGNED_INT_SAMPLER_1D_ARRAY,
+		GL_UNSIGNED_INT_SAMPLER_2D_ARRAY, GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE,
+		GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY, GL_UNSIGNED_INT_SAMPLER_BUFFER, GL_UNSIGNED_INT_SAMPLER_2D_RECT,
+		GL_UNSIGNED_INT_SAMPLER_CUBE_MAP_ARRAY
+	};
+
+	/// @brief Returns how uniforms of the given type are set, or null if they are not supported.
+	const UniformType* findUniformType(GLenum type)
+	{
+		static const UniformType samplerType = { GL_SAMPLER_2D, UniformKind_Int, 1, "glUniform1i" };
+		if(std::find(std::begin(samplerTypes), std::end(samplerTypes), type) != std::end(samplerTypes))
+			return &samplerType;
+
+		for(const UniformType& uniformType : uniformTypes)
+		{
+			if(uniformType.type == type)
+				return &uniformType;
+		}
+
+		return nullptr;
+	}
+
+	/// @brief Returns a literal of the given value, which reproduces it exactly.
+	QString number(double value)
+	{
+		return QString::number(value, 'g', 9);
+	}
+
+	QString boolean(bool value)
+	{
+		return value ? "GL_TRUE" : "GL_FALSE";
+	}
+
+	/// @brief Returns a literal of a bit mask.
+	QString mask(GLuint value)
+	{
+		return QString("0x%1u").arg(value, 0, 16);
+	}
+
+	/// @brief Returns the name of a framebuffer attachment.
+	QString attachmentName(GLenum attachment)
+	{
+		switch(attachment)
+		{
+		case GL_DEPTH_ATTACHMENT:			return "GL_DEPTH_ATTACHMENT";
+		case GL_STENCIL_ATTACHMENT:			return "GL_STENCIL_ATTACHMENT";
+		case GL_DEPTH_STENCIL_ATTACHMENT:	return "GL_DEPTH_STENCIL_ATTACHMENT";
+		default:							return QString("GL_COLOR_ATTACHMENT%1").arg(attachment - GL_COLOR_ATTACHMENT0);
+		}
+	}
+
+	/// @brief Returns the generic name of a draw or read buffer of a framebuffer object.
+	QString drawBufferName(GLint buffer)
+	{
+		if(buffer >= GL_COLOR_ATTACHMENT0 && buffer <= GL_COLOR_ATTACHMENT15)
+			return attachmentName(buffer);
+
+		return "GL_NONE";
+	}
+
+	/// @brief Writes a file completely or throws.
+	void writeFile(const QString& path, const QByteArray& data)
+	{
+		QFile file(path);
+		if(!file.open(QIODevice::WriteOnly) || file.write(data) != data.size())
+			throw std::runtime_error(QString("%1 could not be written").arg(QDir::toNativeSeparators(path)).toStdString());
+	}
+
+	/// @brief First line of generated CMake projects, which may be replaced.
+	const char* const CMAKE_MARKER = "# Generated by quiGLy";
+}
+
+GLCodeGenerator::GLCodeGenerator(GLConfiguration::Functions* functions, SetupRenderingEvaluator* evaluator, GLRenderPassSet* renderPassSet,
+								 GLuint defaultFramebuffer, const QSize& viewSize, const QSurfaceFormat& format)
+	: f(functions),
+	  _evaluator(evaluator),
+	  _renderPassSet(renderPassSet),
+	  _defaultFramebuffer(defaultFramebuffer),
+	  _viewSize(viewSize),
+	  _format(format),
+	  _transformFeedbackMode(0),
+	  _transformFeedbackActive(false)
+{
+}
+
+bool GLCodeGenerator::hasVersion(int major, int minor) const
+{
+	return _format.version() >= qMakePair(major, minor);
+}
+
+void GLCodeGenerator::recordObjects()
+{
+	// Pixels are read tightly packed into client memory
+	GLint packAlignment = 4;
+	GLint activeTexture = GL_TEXTURE0;
+	f->glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+	f->glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+	f->glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	f->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	_objects << "glPixelStorei(GL_UNPACK_ALIGNMENT, 1);";
+
+	// Gather the blocks of all passes in a stable order
+	QList<IBlock*> blocks;
+	for(GLRenderPass* pass : _renderPassSet->getRenderPasses())
+	{
+		for(IBlock* block : pass->getInvolvedBlocks())
+		{
+			if(!blocks.contains(block))
+				blocks.append(block);
+		}
+	}
+
+	std::sort(blocks.begin(), blocks.end(), [](IBlock* first, IBlock* second) { return first->getID() < second->getID(); });
+
+	// Objects are baked by kind, since later kinds reference earlier ones. Views reference their textures.
+	QList<BlockType> order;
+	order << BlockType::Buffer << BlockType::Texture << BlockType::TextureView << BlockType::RenderBuffer
+		  << BlockType::FrameBufferObject << BlockType::VertexArrayObject;
+
+	for(BlockType type : order)
+	{
+		for(IBlock* block : blocks)
+		{
+			GLWrapper* wrapper = block->getType() == type ? _evaluator->getEvaluatedData(block) : nullptr;
+			if(!wrapper)
+				continue;
+
+			switch(type)
+			{
+			case BlockType::Buffer:
+				bakeBuffer(block, wrapper->getValue());
+				break;
+			case BlockType::Texture:
+			case BlockType::TextureView:
+				if(GLTextureWrapper* texture = dynamic_cast<GLTextureWrapper*>(wrapper))
+				{
+					bakeTexture(block, texture->getValue(), texture->getTarget());
+
+					// Samplers are baked along with the textures using them
+					if(texture->getSampler() && !_samplers.contains(texture->getSampler()))
+					{
+						_samplers.insert(texture->getSampler(), _samplers.size());
+						bakeParameters(0, texture->getSampler());
+					}
+
+					for(const TextureBindingParameter& binding : texture->getBindings())
+						_textureUnits.insert(binding.unit);
+				}
+				break;
+			case BlockType::RenderBuffer:
+				bakeRenderbuffer(wrapper->getValue());
+				break;
+			case BlockType::FrameBufferObject:
+				bakeFramebuffer(wrapper->getValue());
+				break;
+			case BlockType::VertexArrayObject:
+				bakeVertexArray(wrapper->getValue());
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	for(GLRenderPass* pass : _renderPassSet->getRenderPasses())
+	{
+		QOpenGLShaderProgram* program = _evaluator->getShaderProgram(pass);
+		if(program)
+			bakeProgram(program);
+	}
+
+	// Leave the context as it has been found, the view binds everything else before drawing
+	f->glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+	f->glActiveTexture(activeTexture);
+	f->glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	f->glBindFramebuffer(GL_FRAMEBUFFER, _defaultFramebuffer);
+	f->glBindVertexArray(0);
+}
+
+void GLCodeGenerator::bakeBuffer(IBlock* block, GLuint buffer)
+{
+	if(_buffers.contains(buffer))
+		return;
+
+	_buffers.insert(buffer, _buffers.size());
+	QString name = reference(_buffers, "buffers", buffer);
+
+	GLint size = 0;
+	f->glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+	f->glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+
+	QByteArray data(size, Qt::Uninitialized);
+	if(size > 0)
+		f->glGetBufferSubData(GL_COPY_READ_BUFFER, 0, size, data.data());
+	f->glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+	QString usage = EvaluationUtils::mapUsagePatternToString(*block->getProperty<EnumProperty>(PropertyID::Buffer_UsageFrequency),
+															 *block->getProperty<EnumProperty>(PropertyID::Buffer_UsageAccess));
+	if(usage.isEmpty())
+		usage = "GL_STATIC_DRAW";
+
+	QString pixels = size > 0 ? QString("asset(%1)").arg(addAsset(data)) : "nullptr";
+	_objects << QString("glBindBuffer(GL_COPY_WRITE_BUFFER, %1);").arg(name)
+			 << QString("glBufferData(GL_COPY_WRITE_BUFFER, %1, %2, %3);").arg(QString::number(size), pixels, usage);
+}
+
+void GLCodeGenerator::bakeTexture(IBlock* block, GLuint texture, GLenum target)
+{
+	if(_textures.contains(texture))
+		return;
+
+	_textures.insert(texture, _textures.size());
+	_textureTargets.insert(texture, target);
+	QString name = reference(_textures, "textures", texture);
+	QString targetName = nameOf(target, textureTargetNames);
+
+	// Views share the storage of their origin, they must not be bound before
+	if(block->getType() == BlockType::TextureView)
+	{
+		QVector<IConnection*> connections = block->getPort(PortType::TextureView_Texture)->getInConnections();
+		IBlock* originBlock = connections.isEmpty() ? nullptr : connections[0]->getSource();
+		GLTextureWrapper* origin = originBlock ? _evaluator->getEvaluatedData<GLTextureWrapper>(originBlock) : nullptr;
+		if(origin)
+			bakeTexture(originBlock, origin->getValue(), origin->getTarget());
+
+		f->glBindTexture(target, texture);
+
+		_objects << QString("glTextureView(%1, %2, %3, %4, %5, %6, %7, %8);")
+					.arg(name, targetName, reference(_textures, "textures", origin ? origin->getValue() : 0),
+						 EvaluationUtils::mapInternalFormatToString(*block->getProperty<EnumProperty>(PropertyID::TextureBase_InternalFormat)),
+						 QString::number(*block->getProperty<UIntProperty>(PropertyID::TextureView_MinimumLevel)),
+						 QString::number(*block->getProperty<UIntProperty>(PropertyID::TextureView_LevelCount)),
+						 QString::number(*block->getProperty<UIntProperty>(PropertyID::TextureView_MinimumLayer)),
+						 QString::number(*block->getProperty<UIntProperty>(PropertyID::TextureView_LayerCount)));
+		_objects << QString("glBindTexture(%1, %2);").arg(targetName, name);
+		bakeParameters(target, 0);
+		return;
+	}
+
+	f->glBindTexture(target, texture);
+	_objects << QString("glBindTexture(%1, %2);").arg(targetName, name);
+
+	// Find out, whether the texture is filled by the passes, or by its data source
+	IBlock* source = nullptr;
+	if(IPort* port = block->getPort(PortType::Data_In))
+	{
+		if(!port->getInConnections().isEmpty())
+			source = port->getInConnections()[0]->getSource();
+	}
+
+	// Buffer textures have neither images nor parameters
+	if(target == GL_TEXTURE_BUFFER)
+	{
+		GLWrapper* buffer = source ? _evaluator->getEvaluatedData(source) : nullptr;
+		_objects << QString("glTexBuffer(GL_TEXTURE_BUFFER, %1, %2);")
+					.arg(EvaluationUtils::mapInternalFormatToString(*block->getProperty<EnumProperty>(PropertyID::TextureBase_InternalFormat)),
+						 reference(_buffers, "buffers", buffer ? buffer->getValue() : 0));
+		return;
+	}
+
+	GLenum firstFace = target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X : target;
+	GLint internalFormat = 0;
+	GLint compressed = GL_FALSE;
+	f->glGetTexLevelParameteriv(firstFace, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+	f->glGetTexLevelParameteriv(firstFace, 0, GL_TEXTURE_COMPRESSED, &compressed);
+
+	const PixelFormat* pixelFormat = findPixelFormat(internalFormat);
+	QString formatName = pixelFormat ? QString(pixelFormat->name)
+									 : EvaluationUtils::mapInternalFormatToString(*block->getProperty<EnumProperty>(PropertyID::TextureBase_InternalFormat));
+	if(formatName.isEmpty())
+		formatName = QString("0x%1").arg(internalFormat, 4, 16, QChar('0'));
+
+	// The contents of multisample textures can't be read, they are render targets anyway
+	if(target == GL_TEXTURE_2D_MULTISAMPLE || target == GL_TEXTURE_2D_MULTISAMPLE_ARRAY)
+	{
+		GLint samples = 0, fixedLocations = GL_TRUE, width = 0, height = 0, depth = 0;
+		f->glGetTexLevelParameteriv(target, 0, GL_TEXTURE_SAMPLES, &samples);
+		f->glGetTexLevelParameteriv(target, 0, GL_TEXTURE_FIXED_SAMPLE_LOCATIONS, &fixedLocations);
+		f->glGetTexLevelParameteriv(target, 0, GL_TEXTURE_WIDTH, &width);
+		f->glGetTexLevelParameteriv(target, 0, GL_TEXTURE_HEIGHT, &height);
+		f->glGetTexLevelParameteriv(target, 0, GL_TEXTURE_DEPTH, &depth);
+
+		if(target == GL_TEXTURE_2D_MULTISAMPLE)
+			_objects << QString("glTexImage2DMultisample(%1, %2, %3, %4, %5, %6);")
+						.arg(targetName, QString::number(samples), formatName, QString::number(width), QString::number(height), boolean(fixedLocations));
+		else
+			_objects << QString("glTexImage3DMultisample(%1, %2, %3, %4, %5, %6, %7);")
+						.arg(targetName, QString::number(samples), formatName, QString::number(width), QString::number(height),
+							 QString::number(depth), boolean(fixedLocations));
+		return;
+	}
+
+	// Find the allocated levels
+	QList<QVector<GLint>> levels;
+	for(GLint level = 0; level < 32; level++)
+	{
+		QVector<GLint> size(3, 0);
+		f->glGetTexLevelParameteriv(firstFace, level, GL_TEXTURE_WIDTH, &size[0]);
+		f->glGetTexLevelParameteriv(firstFace, level, GL_TEXTURE_HEIGHT, &size[1]);
+		f->glGetTexLevelParameteriv(firstFace, level, GL_TEXTURE_DEPTH, &size[2]);
+		if(size[0] == 0)
+			break;
+
+		levels.append(size);
+	}
+
+	GLint immutable = GL_FALSE;
+	if(hasVersion(4, 2))
+		f->glGetTexParameteriv(target, GL_TEXTURE_IMMUTABLE_FORMAT, &immutable);
+
+	int dimensions = 2;
+	if(target == GL_TEXTURE_1D)
+		dimensions = 1;
+	else if(target == GL_TEXTURE_3D || target == GL_TEXTURE_2D_ARRAY || target == GL_TEXTURE_CUBE_MAP_ARRAY)
+		dimensions = 3;
+
+	// Render targets are drawn every frame, so their contents are not stored
+	bool renderTarget = source && source->getType() == BlockType::FrameBufferObject;
+	bool withData = !renderTarget && (compressed || pixelFormat);
+
+	QList<GLenum> faces;
+	if(target == GL_TEXTURE_CUBE_MAP)
+		for(GLenum face = GL_TEXTURE_CUBE_MAP_POSITIVE_X; face <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z; face++)
+			faces.append(face);
+	else
+		faces.append(target);
+
+	if(immutable && !levels.isEmpty())
+	{
+		QStringList size;
+		for(int i = 0; i < dimensions; i++)
+			size << QString::number(levels[0][i]);
+
+		_objects << QString("glTexStorage%1D(%2, %3, %4, %5);")
+					.arg(QString::number(dimensions), targetName, QString::number(levels.size()), formatName, size.join(", "));
+	}
+
+	for(int level = 0; level < levels.size(); level++)
+	{
+		QStringList size, offset;
+		for(int i = 0; i < dimensions; i++)
+		{
+			size << QString::number(levels[level][i]);
+			offset << "0";
+		}
+
+		for(GLenum face : faces)
+		{
+			QString faceName = nameOf(face, textureTargetNames);
+			if(withData && compressed)
+			{
+				GLint imageSize = 0;
+				f->glGetTexLevelParameteriv(face, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &imageSize);
+				QByteArray data(imageSize, Qt::Uninitialized);
+				f->glGetCompressedTexImage(face, level, data.data());
+				QString pixels = QString("asset(%1)").arg(addAsset(data));
+
+				if(immutable)
+					_objects << QString("glCompressedTexSubImage%1D(%2, %3, %4, %5, %6, %7, %8);")
+								.arg(QString::number(dimensions), faceName, QString::number(level), offset.join(", "), size.join(", "),
+									 formatName, QString::number(imageSize), pixels);
+				else
+					_objects << QString("glCompressedTexImage%1D(%2, %3, %4, %5, 0, %6, %7);")
+								.arg(QString::number(dimensions), faceName, QString::number(level), formatName, size.join(", "),
+									 QString::number(imageSize), pixels);
+			}
+			else if(withData)
+			{
+				int imageSize = levels[level][0] * levels[level][1] * levels[level][2] * pixelFormat->size;
+				QByteArray data(imageSize, Qt::Uninitialized);
+				f->glGetTexImage(face, level, pixelFormat->format, pixelFormat->type, data.data());
+				QString pixels = QString("asset(%1)").arg(addAsset(data));
+
+				if(immutable)
+					_objects << QString("glTexSubImage%1D(%2, %3, %4, %5, %6, %7, %8);")
+								.arg(QString::number(dimensions), faceName, QString::number(level), offset.join(", "), size.join(", "),
+									 pixelFormat->formatName, pixelFormat->typeName, pixels);
+				else
+					_objects << QString("glTexImage%1D(%2, %3, %4, %5, 0, %6, %7, %8);")
+								.arg(QString::number(dimensions), faceName, QString::number(level), formatName, size.join(", "),
+									 pixelFormat->formatName, pixelFormat->typeName, pixels);
+			}
+			else if(!immutable)
+			{
+				// Allocate the level only, any transfer format matching the internal format is fine
+				_objects << QString("glTexImage%1D(%2, %3, %4, %5, 0, %6, %7, nullptr);")
+							.arg(QString::number(dimensions), faceName, QString::number(level), formatName, size.join(", "),
+								 pixelFormat ? pixelFormat->formatName : "GL_RGBA", pixelFormat ? pixelFormat->typeName : "GL_UNSIGNED_BYTE");
+			}
+		}
+	}
+
+	bakeParameters(target, 0);
+}
+
+void GLCodeGenerator::bakeParameters(GLenum target, GLuint sampler)
+{
+	struct IntegerParameter
+	{
+		GLenum pname;
+		const char* name;
+		GLint defaultValue;
+		const EnumName* names;
+		int nameCount;
+		bool textureOnly;
+	};
+
+#define INTEGER_PARAMETER(pname, defaultValue, names, textureOnly) { pname, #pname, defaultValue, names, int(sizeof(names) / sizeof(EnumName)), textureOnly }
+#define LEVEL_PARAMETER(pname, defaultValue) { pname, #pname, defaultValue, nullptr, 0, true }
+	static const IntegerParameter integerParameters[] = {
+		INTEGER_PARAMETER(GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR, filterNames, false),
+		INTEGER_PARAMETER(GL_TEXTURE_MAG_FILTER, GL_LINEAR, filterNames, false),
+		INTEGER_PARAMETER(GL_TEXTURE_WRAP_S, GL_REPEAT, wrapModeNames, false),
+		INTEGER_PARAMETER(GL_TEXTURE_WRAP_T, GL_REPEAT, wrapModeNames, false),
+		INTEGER_PARAMETER(GL_TEXTURE_WRAP_R, GL_REPEAT, wrapModeNames, false),
+		INTEGER_PARAMETER(GL_TEXTURE_COMPARE_MODE, GL_NONE, compareModeNames, false),
+		INTEGER_PARAMETER(GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL, compareFunctionNames, false),
+		LEVEL_PARAMETER(GL_TEXTURE_BASE_LEVEL, 0),
+		LEVEL_PARAMETER(GL_TEXTURE_MAX_LEVEL, 1000),
+		INTEGER_PARAMETER(GL_TEXTURE_SWIZZLE_R, GL_RED, swizzleNames, true),
+		INTEGER_PARAMETER(GL_TEXTURE_SWIZZLE_G, GL_GREEN, swizzleNames, true),
+		INTEGER_PARAMETER(GL_TEXTURE_SWIZZLE_B, GL_BLUE, swizzleNames, true),
+		INTEGER_PARAMETER(GL_TEXTURE_SWIZZLE_A, GL_ALPHA, swizzleNames, true),
+		INTEGER_PARAMETER(GL_DEPTH_STENCIL_TEXTURE_MODE, GL_DEPTH_COMPONENT, depthStencilModeNames, true)
+	};
+
+	struct FloatParameter
+	{
+		GLenum pname;
+		const char* name;
+		GLfloat defaultValue;
+	};
+
+	static const FloatParameter floatParameters[] = {
+		{ GL_TEXTURE_MIN_LOD, "GL_TEXTURE_MIN_LOD", -1000.0f },
+		{ GL_TEXTURE_MAX_LOD, "GL_TEXTURE_MAX_LOD", 1000.0f },
+		{ GL_TEXTURE_LOD_BIAS, "GL_TEXTURE_LOD_BIAS", 0.0f }
+	};
+
+	// Rectangle textures have different defaults, so all of their parameters are set
+	bool all = target == GL_TEXTURE_RECTANGLE;
+	QString object = sampler ? reference(_samplers, "samplers", sampler) : nameOf(target, textureTargetNames);
+	QString prefix = sampler ? "glSamplerParameter" : "glTexParameter";
+
+	for(const IntegerParameter& parameter : integerParameters)
+	{
+		if((parameter.textureOnly && sampler) || (parameter.pname == GL_DEPTH_STENCIL_TEXTURE_MODE && !hasVersion(4, 3)))
+			continue;
+
+		GLint value = parameter.defaultValue;
+		if(sampler)
+			f->glGetSamplerParameteriv(sampler, parameter.pname, &value);
+		else
+			f->glGetTexParameteriv(target, parameter.pname, &value);
+
+		if(value == parameter.defaultValue && !all)
+			continue;
+
+		QString valueName = QString::number(value);
+		for(int i = 0; i < parameter.nameCount; i++)
+		{
+			if(parameter.names[i].value == GLenum(value))
+				valueName = parameter.names[i].name;
+		}
+
+		_objects << QString("%1i(%2, %3, %4);").arg(prefix, object, parameter.name, valueName);
+	}
+
+	for(const FloatParameter& parameter : floatParameters)
+	{
+		GLfloat value = parameter.defaultValue;
+		if(sampler)
+			f->glGetSamplerParameterfv(sampler, parameter.pname, &value);
+		else
+			f->glGetTexParameterfv(target, parameter.pname, &value);
+
+		if(value != parameter.defaultValue || all)
+			_objects << QString("%1f(%2, %3, %4);").arg(prefix, object, parameter.name, number(value));
+	}
+
+	GLfloat color[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	if(sampler)
+		f->glGetSamplerParameterfv(sampler, GL_TEXTURE_BORDER_COLOR, color);
+	else
+		f->glGetTexParameterfv(target, GL_TEXTURE_BORDER_COLOR, color);
+
+	if(color[0] != 0.0f || color[1] != 0.0f || color[2] != 0.0f || color[3] != 0.0f)
+	{
+		_objects << "{"
+				 << QString("\tstatic const GLfloat color[] = {%1, %2, %3, %4};").arg(number(color[0]), number(color[1]), number(color[2]), number(color[3]))
+				 << QString("\t%1fv(%2, GL_TEXTURE_BORDER_COLOR, color);").arg(prefix, object)
+				 << "}";
+	}
+}
+
+void GLCodeGenerator::bakeRenderbuffer(GLuint renderbuffer)
+{
+	if(_renderbuffers.contains(renderbuffer))
+		return;
+
+	_renderbuffers.insert(renderbuffer, _renderbuffers.size());
+
+	GLint width = 0, height = 0, internalFormat = 0, samples = 0;
+	f->glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+	f->glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_WIDTH, &width);
+	f->glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_HEIGHT, &height);
+	f->glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_INTERNAL_FORMAT, &internalFormat);
+	f->glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_SAMPLES, &samples);
+
+	const PixelFormat* pixelFormat = findPixelFormat(internalFormat);
+	QString formatName = pixelFormat ? QString(pixelFormat->name) : QString("0x%1").arg(internalFormat, 4, 16, QChar('0'));
+
+	_objects << QString("glBindRenderbuffer(GL_RENDERBUFFER, %1);").arg(reference(_renderbuffers, "renderbuffers", renderbuffer))
+			 << QString("glRenderbufferStorageMultisample(GL_RENDERBUFFER, %1, %2, %3, %4);")
+				.arg(QString::number(samples), formatName, QString::number(width), QString::number(height));
+}
+
+void GLCodeGenerator::bakeFramebuffer(GLuint framebuffer)
+{
+	if(_framebuffers.contains(framebuffer))
+		return;
+
+	_framebuffers.insert(framebuffer, _framebuffers.size());
+
+	f->glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	_objects << QString("glBindFramebuffer(GL_FRAMEBUFFER, %1);").arg(reference(_framebuffers, "framebuffers", framebuffer));
+
+	GLint colorAttachments = 0;
+	f->glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &colorAttachments);
+
+	QList<GLenum> attachments;
+	for(GLint i = 0; i < colorAttachments; i++)
+		attachments.append(GL_COLOR_ATTACHMENT0 + i);
+
+	// A combined depth stencil image is attached at once
+	GLint depthName = 0, stencilName = 0;
+	f->glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &depthName);
+	f->glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &stencilName);
+	if(depthName && depthName == stencilName)
+		attachments << GL_DEPTH_STENCIL_ATTACHMENT;
+	else
+		attachments << GL_DEPTH_ATTACHMENT << GL_STENCIL_ATTACHMENT;
+
+	for(GLenum attachment : attachments)
+	{
+		// The combined attachment is queried by one of its parts
+		GLenum queried = attachment == GL_DEPTH_STENCIL_ATTACHMENT ? GL_DEPTH_ATTACHMENT : attachment;
+
+		GLint type = GL_NONE, name = 0;
+		f->glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, queried, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &type);
+		if(type == GL_NONE)
+			continue;
+
+		f->glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, queried, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &name);
+		if(type == GL_RENDERBUFFER)
+		{
+			_objects << QString("glFramebufferRenderbuffer(GL_FRAMEBUFFER, %1, GL_RENDERBUFFER, %2);")
+						.arg(attachmentName(attachment), reference(_renderbuffers, "renderbuffers", name));
+			continue;
+		}
+
+		GLint level = 0, face = 0, layer = 0, layered = GL_FALSE;
+		f->glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, queried, GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL, &level);
+		f->glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, queried, GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE, &face);
+		f->glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, queried, GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LAYER, &layer);
+		f->glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, queried, GL_FRAMEBUFFER_ATTACHMENT_LAYERED, &layered);
+
+		GLenum target = _textureTargets.value(name, GL_TEXTURE_2D);
+		bool layerTarget = target == GL_TEXTURE_1D_ARRAY || target == GL_TEXTURE_2D_ARRAY || target == GL_TEXTURE_3D
+				|| target == GL_TEXTURE_CUBE_MAP_ARRAY || target == GL_TEXTURE_2D_MULTISAMPLE_ARRAY;
+		QString texture = reference(_textures, "textures", name);
+
+		if(!layered && face)
+			_objects << QString("glFramebufferTexture2D(GL_FRAMEBUFFER, %1, %2, %3, %4);")
+						.arg(attachmentName(attachment), nameOf(face, textureTargetNames), texture, QString::number(level));
+		else if(!layered && layerTarget)
+			_objects << QString("glFramebufferTextureLayer(GL_FRAMEBUFFER, %1, %2, %3, %4);")
+						.arg(attachmentName(attachment), texture, QString::number(level), QString::number(layer));
+		else
+			_objects << QString("glFramebufferTexture(GL_FRAMEBUFFER, %1, %2, %3);")
+						.arg(attachmentName(attachment), texture, QString::number(level));
+	}
+
+	// Draw buffers, without trailing unused ones
+	GLint maxDrawBuffers = 0;
+	f->glGetIntegerv(GL_MAX_DRAW_BUFFERS, &maxDrawBuffers);
+
+	QStringList drawBuffers;
+	for(GLint i = 0; i < maxDrawBuffers; i++)
+	{
+		GLint buffer = GL_NONE;
+		f->glGetIntegerv(GL_DRAW_BUFFER0 + i, &buffer);
+		drawBuffers << drawBufferName(buffer);
+	}
+
+	while(!drawBuffers.isEmpty() && drawBuffers.last() == "GL_NONE")
+		drawBuffers.removeLast();
+
+	if(drawBuffers.isEmpty())
+		_objects << "glDrawBuffer(GL_NONE);";
+	else
+		_objects << "{"
+				 << QString("\tstatic const GLenum drawBuffers[] = {%1};").arg(drawBuffers.join(", "))
+				 << QString("\tglDrawBuffers(%1, drawBuffers);").arg(drawBuffers.size())
+				 << "}";
+
+	GLint readBuffer = GL_NONE;
+	f->glGetIntegerv(GL_READ_BUFFER, &readBuffer);
+	_objects << QString("glReadBuffer(%1);").arg(drawBufferName(readBuffer));
+}
+
+void GLCodeGenerator::bakeVertexArray(GLuint vertexArray)
+{
+	if(_vertexArrays.contains(vertexArray))
+		return;
+
+	_vertexArrays.insert(vertexArray, _vertexArrays.size());
+
+	f->glBindVertexArray(vertexArray);
+	_objects << QString("glBindVertexArray(%1);").arg(reference(_vertexArrays, "vertexArrays", vertexArray));
+
+	GLint attributes = 0;
+	f->glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &attributes);
+
+	// The array buffer is only bound again, if it changes between attributes
+	GLint boundBuffer = -1;
+	for(GLint i = 0; i < attributes; i++)
+	{
+		GLint enabled = GL_FALSE;
+		f->glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+		if(!enabled)
+			continue;
+
+		GLint buffer = 0, size = 4, type = GL_FLOAT, normalized = GL_FALSE, integer = GL_FALSE, stride = 0, divisor = 0;
+		GLvoid* pointer = nullptr;
+		f->glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &buffer);
+		f->glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_SIZE, &size);
+		f->glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_TYPE, &type);
+		f->glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &normalized);
+		f->glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_INTEGER, &integer);
+		f->glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &stride);
+		f->glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_DIVISOR, &divisor);
+		f->glGetVertexAttribPointerv(i, GL_VERTEX_ATTRIB_ARRAY_POINTER, &pointer);
+
+		if(buffer != boundBuffer)
+		{
+			_objects << QString("glBindBuffer(GL_ARRAY_BUFFER, %1);").arg(reference(_buffers, "buffers", buffer));
+			boundBuffer = buffer;
+		}
+
+		QString offset = QString("reinterpret_cast<const void*>(%1)").arg(reinterpret_cast<quintptr>(pointer));
+		if(integer)
+			_objects << QString("glVertexAttribIPointer(%1, %2, %3, %4, %5);")
+						.arg(QString::number(i), QString::number(size), nameOf(type, vertexTypeNames), QString::number(stride), offset);
+		else
+			_objects << QString("glVertexAttribPointer(%1, %2, %3, %4, %5, %6);")
+						.arg(QString::number(i), QString::number(size), nameOf(type, vertexTypeNames), boolean(normalized),
+							 QString::number(stride), offset);
+
+		if(divisor)
+			_objects << QString("glVertexAttribDivisor(%1, %2);").arg(i).arg(divisor);
+
+		_objects << QString("glEnableVertexAttribArray(%1);").arg(i);
+	}
+
+	GLint elementBuffer = 0;
+	f->glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &elementBuffer);
+	if(elementBuffer)
+		_objects << QString("glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, %1);").arg(reference(_buffers, "buffers", elementBuffer));
+
+	_objects << "glBindVertexArray(0);";
+	if(boundBuffer > 0)
+		_objects << "glBindBuffer(GL_ARRAY_BUFFER, 0);";
+}
+
+void GLCodeGenerator::bakeProgram(QOpenGLShaderProgram* program)
+{
+	GLuint id = program->programId();
+	if(_programs.contains(id))
+		return;
+
+	_programs.insert(id, _programs.size());
+	QString name = reference(_programs, "programs", id);
+	_objects << QString("%1 = glCreateProgram();").arg(name);
+
+	// The sources are stored as assets, they are compiled by the generated code
+	for(QOpenGLShader* shader : program->shaders())
+	{
+		QString type;
+		switch(shader->shaderType())
+		{
+		case QOpenGLShader::Vertex:					type = "GL_VERTEX_SHADER";			break;
+		case QOpenGLShader::Fragment:				type = "GL_FRAGMENT_SHADER";		break;
+		case QOpenGLShader::Geometry:				type = "GL_GEOMETRY_SHADER";		break;
+		case QOpenGLShader::TessellationControl:	type = "GL_TESS_CONTROL_SHADER";	break;
+		case QOpenGLShader::TessellationEvaluation:	type = "GL_TESS_EVALUATION_SHADER";	break;
+		case QOpenGLShader::Compute:				type = "GL_COMPUTE_SHADER";			break;
+		default:									continue;
+		}
+
+		QByteArray source = shader->sourceCode();
+		_objects << QString("attachShader(%1, %2, %3, %4);").arg(name, type, QString::number(addAsset(source)), QString::number(source.size()));
+	}
+
+	// Attribute locations might have been assigned by the linker
+	GLint count = 0, maxLength = 0;
+	f->glGetProgramiv(id, GL_ACTIVE_ATTRIBUTES, &count);
+	f->glGetProgramiv(id, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+	for(GLint i = 0; i < count; i++)
+	{
+		QByteArray buffer(maxLength + 1, '\0');
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		f->glGetActiveAttrib(id, i, buffer.size(), &length, &size, &type, buffer.data());
+
+		QByteArray attribute = buffer.left(length);
+		GLint location = f->glGetAttribLocation(id, attribute.constData());
+		if(location >= 0 && !attribute.startsWith("gl_"))
+			_objects << QString("glBindAttribLocation(%1, %2, \"%3\");").arg(name, QString::number(location), QString::fromLatin1(attribute));
+	}
+
+	// Transform feedback varyings are part of the link settings
+	f->glGetProgramiv(id, GL_TRANSFORM_FEEDBACK_VARYINGS, &count);
+	f->glGetProgramiv(id, GL_TRANSFORM_FEEDBACK_VARYING_MAX_LENGTH, &maxLength);
+	if(count > 0)
+	{
+		QStringList varyings;
+		for(GLint i = 0; i < count; i++)
+		{
+			QByteArray buffer(maxLength + 1, '\0');
+			GLsizei length = 0, size = 0;
+			GLenum type = 0;
+			f->glGetTransformFeedbackVarying(id, i, buffer.size(), &length, &size, &type, buffer.data());
+			varyings << QString("\"%1\"").arg(QString::fromLatin1(buffer.left(length)));
+		}
+
+		GLint bufferMode = GL_INTERLEAVED_ATTRIBS;
+		f->glGetProgramiv(id, GL_TRANSFORM_FEEDBACK_BUFFER_MODE, &bufferMode);
+		_objects << "{"
+				 << QString("\tstatic const GLchar* const varyings[] = {%1};").arg(varyings.join(", "))
+				 << QString("\tglTransformFeedbackVaryings(%1, %2, varyings, %3);").arg(name, QString::number(count), nameOf(bufferMode, bufferModeNames))
+				 << "}";
+	}
+
+	_objects << QString("linkProgram(%1);").arg(name);
+
+	GLint blocks = 0;
+	f->glGetProgramiv(id, GL_ACTIVE_UNIFORM_BLOCKS, &blocks);
+	f->glGetProgramiv(id, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength);
+	for(GLint i = 0; i < blocks; i++)
+	{
+		QByteArray buffer(maxLength + 1, '\0');
+		GLsizei length = 0;
+		GLint binding = 0;
+		f->glGetActiveUniformBlockName(id, i, buffer.size(), &length, buffer.data());
+		f->glGetActiveUniformBlockiv(id, i, GL_UNIFORM_BLOCK_BINDING, &binding);
+
+		_objects << QString("glUniformBlockBinding(%1, glGetUniformBlockIndex(%1, \"%2\"), %3);")
+					.arg(name, QString::fromLatin1(buffer.left(length)), QString::number(binding));
+	}
+}
+
+void GLCodeGenerator::recordClear(GLbitfield mask)
+{
+	QStringList buffers;
+	if(mask & GL_COLOR_BUFFER_BIT)
+		buffers << "GL_COLOR_BUFFER_BIT";
+	if(mask & GL_DEPTH_BUFFER_BIT)
+		buffers << "GL_DEPTH_BUFFER_BIT";
+	if(mask & GL_STENCIL_BUFFER_BIT)
+		buffers << "GL_STENCIL_BUFFER_BIT";
+
+	if(buffers.isEmpty())
+		return;
+
+	captureState(nullptr).calls << QString("glClear(%1);").arg(buffers.join(" | "));
+}
+
+void GLCodeGenerator::recordDraw(GLRenderPass* pass, GLenum mode, bool indexed, GLuint first, GLuint count, bool instanced, GLuint instanceCount)
+{
+	Step& step = captureState(pass);
+	QString modeName = nameOf(mode, primitiveNames);
+
+	// Transform feedback is begun after the state has been set, since most state must not change while it is active
+	if(_transformFeedbackMode)
+	{
+		step.calls << QString("glBeginTransformFeedback(%1);").arg(nameOf(_transformFeedbackMode, primitiveNames));
+		_transformFeedbackMode = 0;
+		_transformFeedbackActive = true;
+	}
+
+	if(indexed)
+	{
+		QString offset = QString("reinterpret_cast<const void*>(%1)").arg(first * sizeof(GLuint));
+		if(instanced)
+			step.calls << QString("glDrawElementsInstanced(%1, %2, GL_UNSIGNED_INT, %3, %4);").arg(modeName).arg(count).arg(offset).arg(instanceCount);
+		else
+			step.calls << QString("glDrawElements(%1, %2, GL_UNSIGNED_INT, %3);").arg(modeName).arg(count).arg(offset);
+	}
+	else
+	{
+		if(instanced)
+			step.calls << QString("glDrawArraysInstanced(%1, %2, %3, %4);").arg(modeName).arg(first).arg(count).arg(instanceCount);
+		else
+			step.calls << QString("glDrawArrays(%1, %2, %3);").arg(modeName).arg(first).arg(count);
+	}
+}
+
+void GLCodeGenerator::recordBeginTransformFeedback(GLenum mode)
+{
+	_transformFeedbackMode = mode;
+}
+
+void GLCodeGenerator::recordEndTransformFeedback()
+{
+	if(_transformFeedbackActive && !_steps.isEmpty())
+		_steps.last().calls << "glEndTransformFeedback();";
+
+	_transformFeedbackMode = 0;
+	_transformFeedbackActive = false;
+}
+
+GLCodeGenerator::Step& GLCodeGenerator::captureState(GLRenderPass* pass)
+{
+	_steps.append(Step());
+	QList<StateEntry>& state = _steps.last().state;
+	auto add = [&state](const QString& key, const QString& statement, bool isDefault)
+	{
+		state.append(StateEntry{key, statement, isDefault, false});
+	};
+
+	// The view's framebuffer is the window's one
+	GLint framebuffer = 0;
+	f->glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+	if(GLuint(framebuffer) == _defaultFramebuffer)
+		add("framebuffer", "glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());", true);
+	else
+		add("framebuffer", QString("glBindFramebuffer(GL_FRAMEBUFFER, %1);").arg(reference(_framebuffers, "framebuffers", framebuffer)), false);
+
+	// A viewport covering the view follows the size of the window, so it is set every time
+	GLint viewport[4];
+	f->glGetIntegerv(GL_VIEWPORT, viewport);
+	if(viewport[0] == 0 && viewport[1] == 0 && viewport[2] == _viewSize.width() && viewport[3] == _viewSize.height())
+		state.append(StateEntry{"viewport", "glViewport(0, 0, width(), height());", false, true});
+	else
+		add("viewport", QString("glViewport(%1, %2, %3, %4);").arg(viewport[0]).arg(viewport[1]).arg(viewport[2]).arg(viewport[3]), false);
+
+	if(f->glIsEnabled(GL_SCISSOR_TEST))
+	{
+		GLint scissor[4];
+		f->glGetIntegerv(GL_SCISSOR_BOX, scissor);
+		add("scissor", QString("glScissor(%1, %2, %3, %4);").arg(scissor[0]).arg(scissor[1]).arg(scissor[2]).arg(scissor[3]), false);
+	}
+
+	GLint program = 0, vertexArray = 0, elementBuffer = 0;
+	f->glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+	f->glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vertexArray);
+	f->glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &elementBuffer);
+	add("program", QString("glUseProgram(%1);").arg(reference(_programs, "programs", program)), program == 0);
+
+	// The element buffer belongs to the vertex array, so both are set together
+	QString vertexArrayStatement = QString("glBindVertexArray(%1);").arg(reference(_vertexArrays, "vertexArrays", vertexArray));
+	if(vertexArray)
+		vertexArrayStatement += QString(" glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, %1);").arg(reference(_buffers, "buffers", elementBuffer));
+	add("vertexArray", vertexArrayStatement, vertexArray == 0);
+
+	for(const Capability& capability : capabilities)
+	{
+		bool enabled = f->glIsEnabled(capability.value);
+		add(QString("enable/%1").arg(capability.name), QString("%1(%2);").arg(enabled ? "glEnable" : "glDisable", capability.name),
+			enabled == capability.enabled);
+	}
+
+	// Depth
+	GLint depthFunc = GL_LESS;
+	GLboolean depthMask = GL_TRUE;
+	GLfloat depthRange[2] = {0.0f, 1.0f};
+	GLfloat polygonOffset[2] = {0.0f, 0.0f};
+	f->glGetIntegerv(GL_DEPTH_FUNC, &depthFunc);
+	f->glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+	f->glGetFloatv(GL_DEPTH_RANGE, depthRange);
+	f->glGetFloatv(GL_POLYGON_OFFSET_FACTOR, &polygonOffset[0]);
+	f->glGetFloatv(GL_POLYGON_OFFSET_UNITS, &polygonOffset[1]);
+	add("depthFunc", QString("glDepthFunc(%1);").arg(nameOf(depthFunc, compareFunctionNames)), depthFunc == GL_LESS);
+	add("depthMask", QString("glDepthMask(%1);").arg(boolean(depthMask)), depthMask == GL_TRUE);
+	add("depthRange", QString("glDepthRange(%1, %2);").arg(number(depthRange[0]), number(depthRange[1])),
+		depthRange[0] == 0.0f && depthRange[1] == 1.0f);
+	add("polygonOffset", QString("glPolygonOffset(%1, %2);").arg(number(polygonOffset[0]), number(polygonOffset[1])),
+		polygonOffset[0] == 0.0f && polygonOffset[1] == 0.0f);
+
+	// Blending and color output
+	GLint blend[6] = {GL_ONE, GL_ZERO, GL_ONE, GL_ZERO, GL_FUNC_ADD, GL_FUNC_ADD};
+	GLint logicOp = GL_COPY;
+	GLfloat blendColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	GLboolean colorMask[4] = {GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE};
+	f->glGetIntegerv(GL_BLEND_SRC_RGB, &blend[0]);
+	f->glGetIntegerv(GL_BLEND_DST_RGB, &blend[1]);
+	f->glGetIntegerv(GL_BLEND_SRC_ALPHA, &blend[2]);
+	f->glGetIntegerv(GL_BLEND_DST_ALPHA, &blend[3]);
+	f->glGetIntegerv(GL_BLEND_EQUATION_RGB, &blend[4]);
+	f->glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &blend[5]);
+	f->glGetIntegerv(GL_LOGIC_OP_MODE, &logicOp);
+	f->glGetFloatv(GL_BLEND_COLOR, blendColor);
+	f->glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+	add("blendFunc", QString("glBlendFuncSeparate(%1, %2, %3, %4);").arg(nameOf(blend[0], blendFactorNames), nameOf(blend[1], blendFactorNames),
+																		 nameOf(blend[2], blendFactorNames), nameOf(blend[3], blendFactorNames)),
+		blend[0] == GL_ONE && blend[1] == GL_ZERO && blend[2] == GL_ONE && blend[3] == GL_ZERO);
+	add("blendEquation", QString("glBlendEquationSeparate(%1, %2);").arg(nameOf(blend[4], blendEquationNames), nameOf(blend[5], blendEquationNames)),
+		blend[4] == GL_FUNC_ADD && blend[5] == GL_FUNC_ADD);
+	add("blendColor", QString("glBlendColor(%1, %2, %3, %4);").arg(number(blendColor[0]), number(blendColor[1]), number(blendColor[2]), number(blendColor[3])),
+		blendColor[0] == 0.0f && blendColor[1] == 0.0f && blendColor[2] == 0.0f && blendColor[3] == 0.0f);
+	add("logicOp", QString("glLogicOp(%1);").arg(nameOf(logicOp, logicOpNames)), logicOp == GL_COPY);
+	add("colorMask", QString("glColorMask(%1, %2, %3, %4);").arg(boolean(colorMask[0]), boolean(colorMask[1]), boolean(colorMask[2]), boolean(colorMask[3])),
+		colorMask[0] && colorMask[1] && colorMask[2] && colorMask[3]);
+
+	// Stencil, separately for both faces
+	struct StencilFace
+	{
+		const char* face;
+		GLenum func, ref, valueMask, fail, depthFail, depthPass, writeMask;
+	};
+
+	static const StencilFace stencilFaces[] = {
+		{ "GL_FRONT", GL_STENCIL_FUNC, GL_STENCIL_REF, GL_STENCIL_VALUE_MASK, GL_STENCIL_FAIL, GL_STENCIL_PASS_DEPTH_FAIL,
+		  GL_STENCIL_PASS_DEPTH_PASS, GL_STENCIL_WRITEMASK },
+		{ "GL_BACK", GL_STENCIL_BACK_FUNC, GL_STENCIL_BACK_REF, GL_STENCIL_BACK_VALUE_MASK, GL_STENCIL_BACK_FAIL,
+		  GL_STENCIL_BACK_PASS_DEPTH_FAIL, GL_STENCIL_BACK_PASS_DEPTH_PASS, GL_STENCIL_BACK_WRITEMASK }
+	};
+
+	for(const StencilFace& face : stencilFaces)
+	{
+		GLint func = GL_ALWAYS, ref = 0, valueMask = -1, fail = GL_KEEP, depthFail = GL_KEEP, depthPass = GL_KEEP, writeMask = -1;
+		f->glGetIntegerv(face.func, &func);
+		f->glGetIntegerv(face.ref, &ref);
+		f->glGetIntegerv(face.valueMask, &valueMask);
+		f->glGetIntegerv(face.fail, &fail);
+		f->glGetIntegerv(face.depthFail, &depthFail);
+		f->glGetIntegerv(face.depthPass, &depthPass);
+		f->glGetIntegerv(face.writeMask, &writeMask);
+
+		add(QString("stencilFunc/%1").arg(face.face),
+			QString("glStencilFuncSeparate(%1, %2, %3, %4);").arg(face.face, nameOf(func, compareFunctionNames), QString::number(ref), mask(valueMask)),
+			func == GL_ALWAYS && ref == 0 && GLuint(valueMask) == ~GLuint(0));
+		add(QString("stencilOp/%1").arg(face.face),
+			QString("glStencilOpSeparate(%1, %2, %3, %4);").arg(face.face, nameOf(fail, stencilOpNames), nameOf(depthFail, stencilOpNames),
+																nameOf(depthPass, stencilOpNames)),
+			fail == GL_KEEP && depthFail == GL_KEEP && depthPass == GL_KEEP);
+		add(QString("stencilMask/%1").arg(face.face), QString("glStencilMaskSeparate(%1, %2);").arg(face.face, mask(writeMask)),
+			GLuint(writeMask) == ~GLuint(0));
+	}
+
+	// Rasterization
+	GLint cullFace = GL_BACK, frontFace = GL_CCW, polygonMode[2] = {GL_FILL, GL_FILL};
+	GLint primitiveRestartIndex = 0;
+	GLfloat lineWidth = 1.0f, pointSize = 1.0f;
+	f->glGetIntegerv(GL_CULL_FACE_MODE, &cullFace);
+	f->glGetIntegerv(GL_FRONT_FACE, &frontFace);
+	f->glGetIntegerv(GL_POLYGON_MODE, polygonMode);
+	f->glGetIntegerv(GL_PRIMITIVE_RESTART_INDEX, &primitiveRestartIndex);
+	f->glGetFloatv(GL_LINE_WIDTH, &lineWidth);
+	f->glGetFloatv(GL_POINT_SIZE, &pointSize);
+	add("cullFace", QString("glCullFace(%1);").arg(nameOf(cullFace, faceNames)), cullFace == GL_BACK);
+	add("frontFace", QString("glFrontFace(%1);").arg(nameOf(frontFace, faceNames)), frontFace == GL_CCW);
+	add("polygonMode", QString("glPolygonMode(GL_FRONT_AND_BACK, %1);").arg(nameOf(polygonMode[0], polygonModeNames)), polygonMode[0] == GL_FILL);
+	add("primitiveRestartIndex", QString("glPrimitiveRestartIndex(%1u);").arg(GLuint(primitiveRestartIndex)), primitiveRestartIndex == 0);
+	add("lineWidth", QString("glLineWidth(%1);").arg(number(lineWidth)), lineWidth == 1.0f);
+	add("pointSize", QString("glPointSize(%1);").arg(number(pointSize)), pointSize == 1.0f);
+
+	if(hasVersion(4, 0))
+	{
+		GLint patchVertices = 3;
+		GLfloat outerLevels[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+		GLfloat innerLevels[2] = {1.0f, 1.0f};
+		f->glGetIntegerv(GL_PATCH_VERTICES, &patchVertices);
+		f->glGetFloatv(GL_PATCH_DEFAULT_OUTER_LEVEL, outerLevels);
+		f->glGetFloatv(GL_PATCH_DEFAULT_INNER_LEVEL, innerLevels);
+		add("patchVertices", QString("glPatchParameteri(GL_PATCH_VERTICES, %1);").arg(patchVertices), patchVertices == 3);
+		add("patchOuterLevels", QString("{ static const GLfloat levels[] = {%1, %2, %3, %4}; glPatchParameterfv(GL_PATCH_DEFAULT_OUTER_LEVEL, levels); }")
+			.arg(number(outerLevels[0]), number(outerLevels[1]), number(outerLevels[2]), number(outerLevels[3])),
+			outerLevels[0] == 1.0f && outerLevels[1] == 1.0f && outerLevels[2] == 1.0f && outerLevels[3] == 1.0f);
+		add("patchInnerLevels", QString("{ static const GLfloat levels[] = {%1, %2}; glPatchParameterfv(GL_PATCH_DEFAULT_INNER_LEVEL, levels); }")
+			.arg(number(innerLevels[0]), number(innerLevels[1])),
+			innerLevels[0] == 1.0f && innerLevels[1] == 1.0f);
+	}
+
+	// Clear values
+	GLfloat clearColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	GLfloat clearDepth = 1.0f;
+	GLint clearStencil = 0;
+	f->glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+	f->glGetFloatv(GL_DEPTH_CLEAR_VALUE, &clearDepth);
+	f->glGetIntegerv(GL_STENCIL_CLEAR_VALUE, &clearStencil);
+	add("clearColor", QString("glClearColor(%1, %2, %3, %4);").arg(number(clearColor[0]), number(clearColor[1]), number(clearColor[2]), number(clearColor[3])),
+		clearColor[0] == 0.0f && clearColor[1] == 0.0f && clearColor[2] == 0.0f && clearColor[3] == 0.0f);
+	add("clearDepth", QString("glClearDepth(%1);").arg(number(clearDepth)), clearDepth == 1.0f);
+	add("clearStencil", QString("glClearStencil(%1);").arg(clearStencil), clearStencil == 0);
+
+	// Indexed buffer bindings
+	struct IndexedTarget
+	{
+		GLenum target;
+		const char* name;
+		GLenum count, binding, start, size;
+	};
+
+	QList<IndexedTarget> indexedTargets;
+	indexedTargets << IndexedTarget{GL_UNIFORM_BUFFER, "GL_UNIFORM_BUFFER", GL_MAX_UNIFORM_BUFFER_BINDINGS, GL_UNIFORM_BUFFER_BINDING,
+									GL_UNIFORM_BUFFER_START, GL_UNIFORM_BUFFER_SIZE}
+				   << IndexedTarget{GL_TRANSFORM_FEEDBACK_BUFFER, "GL_TRANSFORM_FEEDBACK_BUFFER", GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS,
+									GL_TRANSFORM_FEEDBACK_BUFFER_BINDING, GL_TRANSFORM_FEEDBACK_BUFFER_START, GL_TRANSFORM_FEEDBACK_BUFFER_SIZE};
+	if(hasVersion(4, 3))
+		indexedTargets << IndexedTarget{GL_SHADER_STORAGE_BUFFER, "GL_SHADER_STORAGE_BUFFER", GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS,
+										GL_SHADER_STORAGE_BUFFER_BINDING, GL_SHADER_STORAGE_BUFFER_START, GL_SHADER_STORAGE_BUFFER_SIZE};
+
+	for(const IndexedTarget& target : indexedTargets)
+	{
+		GLint count = 0;
+		f->glGetIntegerv(target.count, &count);
+		for(GLint i = 0; i < count; i++)
+		{
+			GLint buffer = 0, start = 0, size = 0;
+			f->glGetIntegeri_v(target.binding, i, &buffer);
+			f->glGetIntegeri_v(target.start, i, &start);
+			f->glGetIntegeri_v(target.size, i, &size);
+
+			QString key = QString("%1/%2").arg(target.name).arg(i);
+			if(size > 0)
+				add(key, QString("glBindBufferRange(%1, %2, %3, %4, %5);").arg(target.name, QString::number(i), reference(_buffers, "buffers", buffer),
+																			QString::number(start), QString::number(size)), false);
+			else
+				add(key, QString("glBindBufferBase(%1, %2, %3);").arg(target.name, QString::number(i), reference(_buffers, "buffers", buffer)), buffer == 0);
+		}
+	}
+
+	// Textures and samplers of the units used by the passes
+	GLint activeTexture = GL_TEXTURE0;
+	f->glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+
+	QList<GLuint> units = _textureUnits.toList();
+	std::sort(units.begin(), units.end());
+	for(GLuint unit : units)
+	{
+		f->glActiveTexture(GL_TEXTURE0 + unit);
+		for(const TextureTarget& target : textureTargets)
+		{
+			if(target.target == GL_TEXTURE_CUBE_MAP_ARRAY && !hasVersion(4, 0))
+				continue;
+
+			GLint texture = 0;
+			f->glGetIntegerv(target.binding, &texture);
+
+			QString targetName = nameOf(target.target, textureTargetNames);
+			add(QString("texture/%1/%2").arg(unit).arg(targetName),
+				QString("glActiveTexture(GL_TEXTURE0 + %1); glBindTexture(%2, %3);").arg(QString::number(unit), targetName, reference(_textures, "textures", texture)),
+				texture == 0);
+		}
+
+		GLint sampler = 0;
+		f->glGetIntegerv(GL_SAMPLER_BINDING, &sampler);
+		add(QString("sampler/%1").arg(unit), QString("glBindSampler(%1, %2);").arg(QString::number(unit), reference(_samplers, "samplers", sampler)), sampler == 0);
+	}
+
+	f->glActiveTexture(activeTexture);
+
+	// Uniforms set by elapsed time blocks are animated
+	if(program)
+	{
+		QSet<GLint> elapsedTimeLocations;
+		if(pass)
+		{
+			for(IBlock* block : pass->getInvolvedBlocks())
+			{
+				if(block->getType() != BlockType::Uniform_ElapsedTime)
+					continue;
+
+				for(IConnection* connection : pass->getOutConnections(block))
+				{
+					if(connection->getDest()->getType() == BlockType::Buffer)
+						continue;
+
+					if(connection->getProperty<BoolProperty>(PropertyID::Uniform_ExplicitLocation)->getValue())
+						elapsedTimeLocations.insert(*connection->getProperty<UIntProperty>(PropertyID::Uniform_Location));
+					else
+					{
+						QString name = *connection->getProperty<StringProperty>(PropertyID::Uniform_Name);
+						elapsedTimeLocations.insert(f->glGetUniformLocation(program, name.toLatin1().constData()));
+					}
+				}
+			}
+		}
+
+		captureUniforms(program, elapsedTimeLocations, state);
+	}
+
+	return _steps.last();
+}
+
+void GLCodeGenerator::captureUniforms(GLuint program, const QSet<GLint>& elapsedTimeLocations, QList<StateEntry>& state)
+{
+	if(!_programs.contains(program))
+		return;
+
+	int programIndex = _programs.value(program);
+
+	GLint count = 0, maxLength = 0;
+	f->glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+	f->glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+	for(GLuint i = 0; i < GLuint(count); i++)
+	{
+		QByteArray buffer(maxLength + 1, '\0');
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		f->glGetActiveUniform(program, i, buffer.size(), &length, &size, &type, buffer.data());
+
+		// Members of uniform blocks are stored in buffers
+		GLint blockIndex = -1;
+		f->glGetActiveUniformsiv(program, 1, &i, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+		const UniformType* uniformType = findUniformType(type);
+		if(blockIndex >= 0 || !uniformType)
+			continue;
+
+		QString name = QString::fromLatin1(buffer.left(length));
+		bool array = name.endsWith("[0]");
+		if(array)
+			name.chop(3);
+
+		for(GLint element = 0; element < size; element++)
+		{
+			QString elementName = array ? QString("%1[%2]").arg(name).arg(element) : name;
+			GLint location = f->glGetUniformLocation(program, elementName.toLatin1().constData());
+			if(location < 0)
+				continue;
+
+			QString key = QString("uniform/%1/%2").arg(programIndex).arg(elementName);
+			QString variable = QString("uniforms[%1]").arg(getUniformLocation(programIndex, elementName));
+			if(elapsedTimeLocations.contains(location))
+			{
+				state.append(StateEntry{key, QString("glUniform1i(%1, elapsed());").arg(variable), false, true});
+				continue;
+			}
+
+			QStringList values;
+			bool isDefault = true;
+			switch(uniformType->kind)
+			{
+			case UniformKind_Float:
+			case UniformKind_Matrix:
+			{
+				GLfloat value[16];
+				f->glGetUniformfv(program, location, value);
+				for(int c = 0; c < uniformType->components; c++)
+				{
+					values << number(value[c]);
+					isDefault = isDefault && value[c] == 0.0f;
+				}
+			}
+				break;
+			case UniformKind_Int:
+			{
+				GLint value[4];
+				f->glGetUniformiv(program, location, value);
+				for(int c = 0; c < uniformType->components; c++)
+				{
+					values << QString::number(value[c]);
+					isDefault = isDefault && value[c] == 0;
+				}
+			}
+				break;
+			case UniformKind_UInt:
+			{
+				GLuint value[4];
+				f->glGetUniformuiv(program, location, value);
+				for(int c = 0; c < uniformType->components; c++)
+				{
+					values << QString("%1u").arg(value[c]);
+					isDefault = isDefault && value[c] == 0;
+				}
+			}
+				break;
+			}
+
+			// Matrices are read in column major order, so they are not transposed
+			QString statement;
+			if(uniformType->kind == UniformKind_Matrix)
+				statement = QString("{ static const GLfloat value[] = {%1}; %2(%3, 1, GL_FALSE, value); }")
+							.arg(values.join(", "), uniformType->function, variable);
+			else
+				statement = QString("%1(%2, %3);").arg(uniformType->function, variable, values.join(", "));
+
+			state.append(StateEntry{key, statement, isDefault, false});
+		}
+	}
+}
+
+int GLCodeGenerator::addAsset(const QByteArray& data)
+{
+	QByteArray hash = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+	if(_assetOffsets.contains(hash))
+		return _assetOffsets.value(hash);
+
+	// Every asset starts aligned, so that it can be uploaded directly
+	while(_assets.size() % 16)
+		_assets.append('\0');
+
+	int offset = _assets.size();
+	_assets.append(data);
+	_assetOffsets.insert(hash, offset);
+	return offset;
+}
+
+QString GLCodeGenerator::reference(const QHash<GLuint, int>& objects, const QString& array, GLuint name) const
+{
+	// Objects not belonging to the passes, like internal objects of the view, are not exported
+	if(!name || !objects.contains(name))
+		return "0";
+
+	return QString("%1[%2]").arg(array).arg(objects.value(name));
+}
+
+int GLCodeGenerator::getUniformLocation(int program, const QString& name)
+{
+	QString key = QString("%1/%2").arg(program).arg(name);
+	if(!_uniformIndices.contains(key))
+	{
+		_uniformIndices.insert(key, _uniforms.size());
+		_uniforms.append(qMakePair(program, name));
+	}
+
+	return _uniformIndices.value(key);
+}
+
+void GLCodeGenerator::generateStatements(QStringList& init, QStringList& frame) const
+{
+	// Objects first, the state of the frame references them
+	init = _objects;
+	for(int i = 0; i < _uniforms.size(); i++)
+		init << QString("uniforms[%1] = glGetUniformLocation(programs[%2], \"%3\");").arg(i).arg(_uniforms[i].first).arg(_uniforms[i].second);
+
+	QHash<QString, QString> current;
+	for(const Step& step : _steps)
+	{
+		for(const StateEntry& entry : step.state)
+		{
+			bool changed = current.contains(entry.key) ? current.value(entry.key) != entry.statement : !entry.isDefault;
+			if(changed && !entry.isVolatile)
+				init << entry.statement;
+
+			current.insert(entry.key, entry.statement);
+		}
+	}
+
+	// Every frame begins on the window's framebuffer
+	current.insert("framebuffer", "glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());");
+
+	frame.clear();
+	for(const Step& step : _steps)
+	{
+		for(const StateEntry& entry : step.state)
+		{
+			if(entry.isVolatile || current.value(entry.key) != entry.statement)
+				frame << entry.statement;
+
+			current.insert(entry.key, entry.statement);
+		}
+
+		frame << step.calls;
+	}
+}
+
+QString GLCodeGenerator::generateSource(const QString& projectName) const
+{
+	static const char* const source =
+			"// Generated by quiGLy. Renders the exported frame continuously.\n"
+			"// Run with --benchmark [frames] to print the average frame time instead.\n"
+			"\n"
+			"#include <QGuiApplication>\n"
+			"#include <QOpenGLWindow>\n"
+			"#include <QOpenGLFunctions_$VERSION$_Core>\n"
+			"#include <QElapsedTimer>\n"
+			"#include <QStringList>\n"
+			"#include <QFile>\n"
+			"\n"
+			"#include <cstdio>\n"
+			"#include <cstdlib>\n"
+			"\n"
+			"class Renderer : public QOpenGLWindow, protected QOpenGLFunctions_$VERSION$_Core\n"
+			"{\n"
+			"public:\n"
+			"\texplicit Renderer(int benchmarkFrames)\n"
+			"\t\t: _benchmarkFrames(benchmarkFrames), _frames(0)\n"
+			"\t{\n"
+			"\t}\n"
+			"\n"
+			"protected:\n"
+			"\tvoid initializeGL() override\n"
+			"\t{\n"
+			"\t\tif(!initializeOpenGLFunctions())\n"
+			"\t\t\tfail(\"OpenGL $MAJOR$.$MINOR$ core profile is not supported\");\n"
+			"\n"
+			"\t\tQFile file(\":/$ASSETS$\");\n"
+			"\t\tif(!file.open(QIODevice::ReadOnly))\n"
+			"\t\t\tfail(\"The assets could not be opened\");\n"
+			"\t\t_assets = file.readAll();\n"
+			"\n"
+			"\t\t_time.start();\n"
+			"\t\tinit();\n"
+			"\t}\n"
+			"\n"
+			"\tvoid paintGL() override\n"
+			"\t{\n"
+			"\t\tframe();\n"
+			"\n"
+			"\t\tif(_benchmarkFrames > 0)\n"
+			"\t\t{\n"
+			"\t\t\t// The first frame is not measured, it includes lazy initializations of the driver\n"
+			"\t\t\tif(_frames == 0)\n"
+			"\t\t\t{\n"
+			"\t\t\t\tglFinish();\n"
+			"\t\t\t\t_benchmark.start();\n"
+			"\t\t\t}\n"
+			"\t\t\telse if(_frames == _benchmarkFrames)\n"
+			"\t\t\t{\n"
+			"\t\t\t\tglFinish();\n"
+			"\t\t\t\tdouble milliseconds = _benchmark.nsecsElapsed() / 1.0e6;\n"
+			"\t\t\t\tstd::printf(\"%d frames, %.3f ms per frame\\n\", _benchmarkFrames, milliseconds / _benchmarkFrames);\n"
+			"\t\t\t\tQGuiApplication::quit();\n"
+			"\t\t\t\treturn;\n"
+			"\t\t\t}\n"
+			"\n"
+			"\t\t\t_frames++;\n"
+			"\t\t}\n"
+			"\n"
+			"\t\tupdate();\n"
+			"\t}\n"
+			"\n"
+			"private:\n"
+			"\tconst char* asset(qint64 offset) const\n"
+			"\t{\n"
+			"\t\treturn _assets.constData() + offset;\n"
+			"\t}\n"
+			"\n"
+			"\tGLint elapsed() const\n"
+			"\t{\n"
+			"\t\treturn GLint(_time.elapsed() % 32767);\n"
+			"\t}\n"
+			"\n"
+			"\tstatic void fail(const char* message)\n"
+			"\t{\n"
+			"\t\tstd::fprintf(stderr, \"%s\\n\", message);\n"
+			"\t\tstd::exit(EXIT_FAILURE);\n"
+			"\t}\n"
+			"\n"
+			"\tvoid attachShader(GLuint program, GLenum type, qint64 offset, GLint length)\n"
+			"\t{\n"
+			"\t\tGLuint shader = glCreateShader(type);\n"
+			"\t\tconst GLchar* source = asset(offset);\n"
+			"\t\tglShaderSource(shader, 1, &source, &length);\n"
+			"\t\tglCompileShader(shader);\n"
+			"\n"
+			"\t\tGLint status = GL_FALSE;\n"
+			"\t\tglGetShaderiv(shader, GL_COMPILE_STATUS, &status);\n"
+			"\t\tif(!status)\n"
+			"\t\t{\n"
+			"\t\t\tGLchar log[4096];\n"
+			"\t\t\tglGetShaderInfoLog(shader, sizeof(log), nullptr, log);\n"
+			"\t\t\tfail(log);\n"
+			"\t\t}\n"
+			"\n"
+			"\t\tglAttachShader(program, shader);\n"
+			"\t\tglDeleteShader(shader);\n"
+			"\t}\n"
+			"\n"
+			"\tvoid linkProgram(GLuint program)\n"
+			"\t{\n"
+			"\t\tglLinkProgram(program);\n"
+			"\n"
+			"\t\tGLint status = GL_FALSE;\n"
+			"\t\tglGetProgramiv(program, GL_LINK_STATUS, &status);\n"
+			"\t\tif(!status)\n"
+			"\t\t{\n"
+			"\t\t\tGLchar log[4096];\n"
+			"\t\t\tglGetProgramInfoLog(program, sizeof(log), nullptr, log);\n"
+			"\t\t\tfail(log);\n"
+			"\t\t}\n"
+			"\t}\n"
+			"\n"
+			"\tvoid init()\n"
+			"\t{\n"
+			"$INIT$"
+			"\t}\n"
+			"\n"
+			"\tvoid frame()\n"
+			"\t{\n"
+			"$FRAME$"
+			"\t}\n"
+			"\n"
+			"\tint _benchmarkFrames;\n"
+			"\tint _frames;\n"
+			"\tQElapsedTimer _time;\n"
+			"\tQElapsedTimer _benchmark;\n"
+			"\tQByteArray _assets;\n"
+			"$OBJECTS$"
+			"};\n"
+			"\n"
+			"int main(int argc, char* argv[])\n"
+			"{\n"
+			"\tQGuiApplication application(argc, argv);\n"
+			"\n"
+			"\tint benchmarkFrames = 0;\n"
+			"\tQStringList arguments = application.arguments();\n"
+			"\tint index = arguments.indexOf(\"--benchmark\");\n"
+			"\tif(index >= 0)\n"
+			"\t\tbenchmarkFrames = index + 1 < arguments.size() ? qMax(1, arguments[index + 1].toInt()) : 1000;\n"
+			"\n"
+			"\tQSurfaceFormat format;\n"
+			"\tformat.setVersion($MAJOR$, $MINOR$);\n"
+			"\tformat.setProfile(QSurfaceFormat::CoreProfile);\n"
+			"\tformat.setDepthBufferSize($DEPTH$);\n"
+			"\tformat.setStencilBufferSize($STENCIL$);\n"
+			"\tformat.setSamples($SAMPLES$);\n"
+			"\n"
+			"\t// Measure the rendering, not the display's refresh rate\n"
+			"\tif(benchmarkFrames > 0)\n"
+			"\t\tformat.setSwapInterval(0);\n"
+			"\n"
+			"\tRenderer renderer(benchmarkFrames);\n"
+			"\trenderer.setFormat(format);\n"
+			"\trenderer.setTitle(\"$NAME$\");\n"
+			"\trenderer.resize($WIDTH$, $HEIGHT$);\n"
+			"\trenderer.show();\n"
+			"\n"
+			"\treturn application.exec();\n"
+			"}\n";
+
+	// Functions are available for OpenGL 3.3 up to 4.5
+	QPair<int, int> version = qMax(qMakePair(3, 3), qMin(_format.version(), qMakePair(4, 5)));
+	if(version.first == 3)
+		version.second = 3;
+
+	QStringList init, frame;
+	generateStatements(init, frame);
+
+	// The names of all objects are created at once
+	QStringList objects;
+	QString generate;
+	struct ObjectArray
+	{
+		const char* name;
+		const char* function;
+		int count;
+	};
+
+	const ObjectArray arrays[] = {
+		{ "buffers", "glGenBuffers", _buffers.size() },
+		{ "textures", "glGenTextures", _textures.size() },
+		{ "samplers", "glGenSamplers", _samplers.size() },
+		{ "renderbuffers", "glGenRenderbuffers", _renderbuffers.size() },
+		{ "framebuffers", "glGenFramebuffers", _framebuffers.size() },
+		{ "vertexArrays", "glGenVertexArrays", _vertexArrays.size() },
+		{ "programs", nullptr, _programs.size() }
+	};
+
+	for(const ObjectArray& array : arrays)
+	{
+		if(!array.count)
+			continue;
+
+		objects << QString("\tGLuint %1[%2];\n").arg(array.name).arg(array.count);
+		if(array.function)
+			generate += QString("\t\t%1(%2, %3);\n").arg(array.function).arg(array.count).arg(array.name);
+	}
+
+	if(!_uniforms.isEmpty())
+		objects << QString("\tGLint uniforms[%1];\n").arg(_uniforms.size());
+
+	QString initBody = generate;
+	for(const QString& line : init)
+		initBody += "\t\t" + line + "\n";
+
+	QString frameBody;
+	for(const QString& line : frame)
+		frameBody += "\t\t" + line + "\n";
+
+	QString result = source;
+	result.replace("$VERSION$", QString("%1_%2").arg(version.first).arg(version.second))
+		  .replace("$MAJOR$", QString::number(version.first))
+		  .replace("$MINOR$", QString::number(version.second))
+		  .replace("$ASSETS$", projectName + ".bin")
+		  .replace("$NAME$", projectName)
+		  .replace("$WIDTH$", QString::number(_viewSize.width()))
+		  .replace("$HEIGHT$", QString::number(_viewSize.height()))
+		  .replace("$DEPTH$", QString::number(qMax(0, _format.depthBufferSize())))
+		  .replace("$STENCIL$", QString::number(qMax(0, _format.stencilBufferSize())))
+		  .replace("$SAMPLES$", QString::number(qMax(0, _format.samples())))
+		  .replace("$OBJECTS$", objects.join(""))
+		  .replace("$INIT$", initBody)
+		  .replace("$FRAME$", frameBody);
+
+	return result;
+}
+
+void GLCodeGenerator::write(const QString& fileName) const
+{
+	QFileInfo info(fileName);
+	QString projectName = info.completeBaseName();
+	if(projectName.isEmpty())
+		throw std::runtime_error("No output file has been chosen");
+
+	QDir directory = info.absoluteDir();
+	if(!directory.exists())
+		throw std::runtime_error(QString("%1 does not exist").arg(QDir::toNativeSeparators(directory.absolutePath())).toStdString());
+
+	writeFile(directory.filePath(projectName + ".cpp"), generateSource(projectName).toUtf8());
+	writeFile(directory.filePath(projectName + ".bin"), _assets);
+	writeFile(directory.filePath(projectName + ".qrc"),
+			  QString("<RCC>\n\t<qresource prefix=\"/\">\n\t\t<file>%1.bin</file>\n\t</qresource>\n</RCC>\n").arg(projectName).toUtf8());
+
+	// Projects written by hand are left alone
+	QFile cmake(directory.filePath("CMakeLists.txt"));
+	if(cmake.exists())
+	{
+		if(!cmake.open(QIODevice::ReadOnly) || !cmake.readLine().startsWith(CMAKE_MARKER))
+			return;
+		cmake.close();
+	}
+
+	// The name of the target must be a valid identifier
+	QString target = projectName;
+	target.replace(QRegExp("[^A-Za-z0-9_]"), "_");
+
+	writeFile(cmake.fileName(), QString("%1\n"
+										"cmake_minimum_required(VERSION 3.1)\n"
+										"project(%2 CXX)\n"
+										"\n"
+										"set(CMAKE_CXX_STANDARD 11)\n"
+										"set(CMAKE_AUTORCC ON)\n"
+										"\n"
+										"find_package(Qt5 COMPONENTS Gui REQUIRED)\n"
+										"\n"
+										"add_executable(%2 %3.cpp %3.qrc)\n"
+										"target_link_libraries(%2 Qt5::Gui)\n").arg(CMAKE_MARKER, target, projectName).toUtf8());
+}
+
+QString GLCodeGenerator::getSummary() const
+{
+	QStringList init, frame;
+	generateStatements(init, frame);
+
+	int objects = _buffers.size() + _textures.size() + _samplers.size() + _renderbuffers.size() + _framebuffers.size()
+			+ _vertexArrays.size() + _programs.size();
+
+	return QString("%1 objects with %2 bytes of assets, %3 statements for initialization and %4 per frame")
+			.arg(objects).arg(_assets.size()).arg(init.size()).arg(frame.size());
+}
+
+}
@@ -0,0 +1,214 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef GLCODEGENERATOR_H
+#define GLCODEGENERATOR_H
+
+#include "glconfiguration.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QSet>
+#include <QSize>
+#include <QStringList>
+#include <QSurfaceFormat>
+
+QT_BEGIN_NAMESPACE
+class QOpenGLShaderProgram;
+QT_END_NAMESPACE
+
+namespace ysm
+{
+
+	class IBlock;
+	class GLRenderPass;
+	class GLRenderPassSet;
+	class SetupRenderingEvaluator;
+
+	/**
+	 * @brief The GLCodeGenerator class exports a rendered frame as a standalone C++ project using Qt and OpenGL.
+	 * The objects of all passes are read back from the context and baked into a single binary asset file, which is
+	 * uploaded as-is by the generated initialization code. While the frame is rendered, the complete OpenGL state is
+	 * captured right before every clear and draw call. The generated frame only contains the state changes between
+	 * consecutive calls, in a cycle beginning and ending with the state at the end of the frame, which is established
+	 * once during initialization.
+	 * The generator must only be used while the context of the rendering view is current.
+	 */
+	class GLCodeGenerator
+	{
+	public:
+
+		/**
+		 * @brief GLCodeGenerator		Constructs a generator for the frame rendered into a view.
+		 * @param functions				OpenGL functions of the context the frame is rendered in
+		 * @param evaluator				The evaluator holding the objects of the passes
+		 * @param renderPassSet			The passes rendered by the view
+		 * @param defaultFramebuffer	The framebuffer the view renders into, mapped to the window's framebuffer
+		 * @param viewSize				The size of the view, its viewport is mapped to the size of the window
+		 * @param format				The format of the view's context, used for the window of the generated code
+		 */
+		GLCodeGenerator(GLConfiguration::Functions* functions, SetupRenderingEvaluator* evaluator, GLRenderPassSet* renderPassSet,
+						GLuint defaultFramebuffer, const QSize& viewSize, const QSurfaceFormat& format);
+
+		/// @brief Reads all objects of the passes back from the context. Must be called before the frame is rendered.
+		void recordObjects();
+
+		/// @brief Records a clear of the given buffers with the current state.
+		void recordClear(GLbitfield mask);
+
+		/**
+		 * @brief recordDraw		Records a draw call with the current state.
+		 * @param pass				The pass being drawn
+		 * @param mode				The primitive mode
+		 * @param indexed			Whether unsigned int indices of the bound index buffer are drawn
+		 * @param first				The first vertex or index
+		 * @param count				The number of vertices or indices
+		 * @param instanced			Whether an instanced draw call is used
+		 * @param instanceCount		The number of instances
+		 */
+		void recordDraw(GLRenderPass* pass, GLenum mode, bool indexed, GLuint first, GLuint count, bool instanced, GLuint instanceCount);
+
+		/// @brief Records the start of transform feedback, which is begun right before the next draw call.
+		void recordBeginTransformFeedback(GLenum mode);
+
+		/// @brief Records the end of transform feedback after the last draw call.
+		void recordEndTransformFeedback();
+
+		/**
+		 * @brief write			Writes the generated project next to the given source file.
+		 * Besides the source file, the assets, a Qt resource file and a CMake project are written. An existing
+		 * CMakeLists.txt is only replaced, if it has been generated before.
+		 * @param fileName		Path of the C++ source file to be written
+		 * @throws std::runtime_error, if a file cannot be written
+		 */
+		void write(const QString& fileName) const;
+
+		/// @brief Returns a short summary of the recorded frame for the log.
+		QString getSummary() const;
+
+	private:
+
+		/// @brief A single piece of OpenGL state, set by a statement.
+		struct StateEntry
+		{
+			QString key;			/*!< Identifies the state, e.g. "blendFunc" or "texture/0/GL_TEXTURE_2D". */
+			QString statement;		/*!< The statement setting the state. */
+			bool isDefault;			/*!< Whether the statement sets the initial value of a new context. */
+			bool isVolatile;		/*!< Whether the statement needs to be executed every time, like animated uniforms. */
+		};
+
+		/// @brief A clear or draw call together with the state it is executed with.
+		struct Step
+		{
+			QList<StateEntry> state;	/*!< The complete state the calls depend on. */
+			QStringList calls;			/*!< The calls executed after the state has been set. */
+		};
+
+		/// @brief Reads back a buffer and uploads it in the initialization.
+		void bakeBuffer(IBlock* block, GLuint buffer);
+
+		/// @brief Reads back a texture or texture view and uploads it in the initialization.
+		void bakeTexture(IBlock* block, GLuint texture, GLenum target);
+
+		/// @brief Reads back the parameters of the texture bound to the target or of a sampler. Default values are skipped.
+		void bakeParameters(GLenum target, GLuint sampler);
+
+		/// @brief Reads back a renderbuffer and allocates it in the initialization.
+		void bakeRenderbuffer(GLuint renderbuffer);
+
+		/// @brief Reads back the attachments of a framebuffer.
+		void bakeFramebuffer(GLuint framebuffer);
+
+		/// @brief Reads back the attribute pointers of a vertex array.
+		void bakeVertexArray(GLuint vertexArray);
+
+		/// @brief Reads back the shaders and link settings of a program.
+		void bakeProgram(QOpenGLShaderProgram* program);
+
+		/// @brief Captures the current state into a new step.
+		Step& captureState(GLRenderPass* pass);
+
+		/// @brief Captures the uniform values of the current program.
+		void captureUniforms(GLuint program, const QSet<GLint>& elapsedTimeLocations, QList<StateEntry>& state);
+
+		/// @brief Adds data to the assets and returns its offset. Identical data is only stored once.
+		int addAsset(const QByteArray& data);
+
+		/// @brief Returns the expression referencing a baked object of the given kind, or 0.
+		QString reference(const QHash<GLuint, int>& objects, const QString& array, GLuint name) const;
+
+		/// @brief Returns the index of the location variable of the given uniform.
+		int getUniformLocation(int program, const QString& name);
+
+		/**
+		 * @brief Generates the statements of the initialization and the frame.
+		 * The initialization replays the state changes of the frame without its calls, so that uniforms and
+		 * element buffers are set while their program and vertex array are bound. Afterwards, the context is in the
+		 * state at the end of the frame, which is the state at the beginning of the next one.
+		 */
+		void generateStatements(QStringList& init, QStringList& frame) const;
+
+		/// @brief Generates the source file of the project.
+		QString generateSource(const QString& projectName) const;
+
+		/// @brief Returns true, if the context supports at least the given version.
+		bool hasVersion(int major, int minor) const;
+
+	private:
+
+		GLConfiguration::Functions* f;		/*!< Functions of the context the frame is rendered in. */
+		SetupRenderingEvaluator* _evaluator;/*!< The evaluator holding the objects of the passes. */
+		GLRenderPassSet* _renderPassSet;	/*!< The passes being exported. */
+		GLuint _defaultFramebuffer;			/*!< The framebuffer of the view. */
+		QSize _viewSize;					/*!< The size of the view. */
+		QSurfaceFormat _format;				/*!< The format of the view's context. */
+
+		QHash<GLuint, int> _buffers;		/*!< Indices of the baked buffers in the generated code. */
+		QHash<GLuint, int> _textures;		/*!< Indices of the baked textures in the generated code. */
+		QHash<GLuint, int> _samplers;		/*!< Indices of the baked samplers in the generated code. */
+		QHash<GLuint, int> _renderbuffers;	/*!< Indices of the baked renderbuffers in the generated code. */
+		QHash<GLuint, int> _framebuffers;	/*!< Indices of the baked framebuffers in the generated code. */
+		QHash<GLuint, int> _vertexArrays;	/*!< Indices of the baked vertex arrays in the generated code. */
+		QHash<GLuint, int> _programs;		/*!< Indices of the baked programs in the generated code. */
+		QHash<GLuint, GLenum> _textureTargets; /*!< Targets of the baked textures. */
+		QSet<GLuint> _textureUnits;			/*!< Texture units used by any pass. */
+
+		QList<QPair<int, QString>> _uniforms;	/*!< Program and name of every uniform location variable. */
+		QHash<QString, int> _uniformIndices;	/*!< Index of the location variable per program and uniform name. */
+
+		QByteArray _assets;					/*!< The baked buffers, textures and shaders. */
+		QHash<QByteArray, int> _assetOffsets; /*!< Offsets of the stored data by hash. */
+
+		QStringList _objects;				/*!< Statements creating the baked objects. */
+		QList<Step> _steps;					/*!< The recorded clear and draw calls. */
+		GLenum _transformFeedbackMode;		/*!< Primitive mode of transform feedback to be begun, or 0. */
+		bool _transformFeedbackActive;		/*!< Whether transform feedback has been begun by a recorded draw call. */
+	};
+}
+
+#endif // GLCODEGENERATOR_H
@@ -26,7 +26,9 @@
 #ifndef GLCONFIGURATION
 #define GLCONFIGURATION
 
-#include <QOpenGLFunctions_3_3_Core>
+#include "gltracefunctions.h"
+
+#include <QOpenGLFunctions_4_3_Core>
 
 namespace ysm
 {
@@ -34,7 +36,17 @@ namespace ysm
 	{
 		static const unsigned int GL_MINIMUM_VERSION = 330;
 
-		using Functions = QOpenGLFunctions_3_3_Core;
+		/// @brief Functions used for rendering, which are recorded into an active GL trace.
+		using Functions = GLTraceFunctions;
+
+		/// @brief Optional functions used for indirect multi draws, if the context supports them.
+		using MultiDrawFunctions = QOpenGLFunctions_4_3_Core;
+
+		/// @brief Returns the functions object of the given context, which must be current on first use.
+		static Functions* getFunctions(QOpenGLContext* context = QOpenGLContext::currentContext())
+		{
+			return Functions::forContext(context);
+		}
 	};
 
 }
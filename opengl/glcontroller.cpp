@@ -139,7 +139,7 @@ void GLController::registerView(GLRenderView* view)
 		// Log success
 		IBlock* displayBlock = view->getDisplayBlock();
 		QString widgetName = QString("%1 #%2").arg(displayBlock->getName()).arg(displayBlock->getID());
-		LogView::log(QString("\n=== RENDERING STARTED [%1] ===\n").arg(widgetName));
+		LogView::log(LogSeverity::Info, "Rendering", QString("=== RENDERING STARTED [%1] ===").arg(widgetName), displayBlock->getID());
 
 		GLRenderPassSet* renderPassSet = view->getRenderPassSet();
 
@@ -157,15 +157,17 @@ void GLController::registerView(GLRenderView* view)
 		// Evaluate Pipeline
 		_setupRenderingEvaluator->evaluate(renderPassSet);
 
-		// Add the warnings to the blocks
+		// Add the warnings to the blocks and the log
 		for(const SetupRenderingEvaluator::Warning& warning : _setupRenderingEvaluator->getWarnings())
 		{
 			if(warning.block)
 				view->executeCommand(new UpdateStatusCommand(warning.block, PipelineItemStatus::Chilled, warning.message));
+
+			LogView::log(LogSeverity::Warning, "Evaluation", warning.message, warning.block ? static_cast<int>(warning.block->getID()) : -1);
 		}
 
 		// Log success
-		LogView::log(QString("\n=== RENDERING SUCCESSFUL [%1] ===\n").arg(widgetName));
+		LogView::log(LogSeverity::Info, "Rendering", QString("=== RENDERING SUCCESSFUL [%1] ===").arg(widgetName), displayBlock->getID());
 
 		// Tell the view that the registration was successful
 		view->onRegistrationSuccessful();
@@ -189,7 +191,7 @@ void GLController::registerView(GLRenderView* view)
 			reason = QString("Error during evaluation: %1").arg(exception.what());
 
 		// Signal that something went wrong
-		signalAbortRendering(view, reason, exception.getLog());
+		signalAbortRendering(view, reason, exception.getLog(), block);
 	}
 
 	// Tell the world we might have some messages left to be read
@@ -199,7 +201,7 @@ void GLController::registerView(GLRenderView* view)
 #endif
 }
 
-void GLController::signalAbortRendering(GLRenderView* view, const QString& reason, const QString& log)
+void GLController::signalAbortRendering(GLRenderView* view, const QString& reason, const QString& log, IBlock* block)
 {
 	// We need to ensure that nothing is rendered on the view anymore
 	view->onRenderingAborted();
@@ -207,11 +209,12 @@ void GLController::signalAbortRendering(GLRenderView* view, const QString& reaso
 	// Log the rendering failure
 	IBlock* displayBlock = view->getDisplayBlock();
 	QString widgetName = QString("%1 #%2").arg(displayBlock->getName()).arg(displayBlock->getID());
-	LogView::log(QString("\n=== RENDERING ABORTED [%1] ===\n").arg(widgetName));
+	LogView::log(LogSeverity::Error, "Rendering", QString("=== RENDERING ABORTED [%1] ===").arg(widgetName), displayBlock->getID());
 
-	// Append reason and detail log
-	LogView::log(reason);
-	LogView::log(log);
+	// Append reason and detail log, attributed to the failed block if known
+	int blockId = block ? static_cast<int>(block->getID()) : static_cast<int>(displayBlock->getID());
+	LogView::log(LogSeverity::Error, "Rendering", reason, blockId);
+	LogView::log(LogSeverity::Error, "Rendering", log, blockId);
 
 	// Create an event which will be handled last in the eventqueue
 	QCoreApplication::postEvent(parent(), new AbortRenderingEvent(view, reason, log));
@@ -220,8 +223,18 @@ void GLController::signalAbortRendering(GLRenderView* view, const QString& reaso
 #ifdef QT_DEBUG
 void GLController::onMessageLogged(QOpenGLDebugMessage message)
 {
+	// Map the driver's severity to the log's severity
+	LogSeverity severity = LogSeverity::Debug;
+	switch(message.severity())
+	{
+		case QOpenGLDebugMessage::HighSeverity: severity = LogSeverity::Error; break;
+		case QOpenGLDebugMessage::MediumSeverity: severity = LogSeverity::Warning; break;
+		case QOpenGLDebugMessage::LowSeverity: severity = LogSeverity::Info; break;
+		default: break;
+	}
+
 	//Set breakpoint here
-	LogView::log(message.message());
+	LogView::log(severity, "OpenGL", message.message());
 }
 #endif
 
@@ -91,8 +91,14 @@ namespace ysm
 		 */
 		void registerView(GLRenderView* view);
 
-		/// @brief Called by GLRenderView, if rendering has to be aborted for any given reason.
-		void signalAbortRendering(GLRenderView* view, const QString& reason, const QString& log = "");
+		/**
+		 * @brief Called by GLRenderView, if rendering has to be aborted for any given reason.
+		 * @param view The view to stop rendering
+		 * @param reason The reason
+		 * @param log The detail log
+		 * @param block The block that caused the failure, if known
+		 */
+		void signalAbortRendering(GLRenderView* view, const QString& reason, const QString& log = "", IBlock* block = nullptr);
 
 	signals:
 
@@ -0,0 +1,292 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "glreadbackqueue.h"
+
+#include <cstring>
+
+namespace ysm
+{
+
+GLReadbackQueue::GLReadbackQueue(GLConfiguration::Functions* functions)
+	: f(functions)
+{
+}
+
+GLReadbackQueue::~GLReadbackQueue()
+{
+	for(Ring& ring : _rings)
+	{
+		for(Slot& slot : ring.slots)
+		{
+			if(slot.fence)
+				f->glDeleteSync(slot.fence);
+			if(slot.buffer)
+				f->glDeleteBuffers(1, &slot.buffer);
+		}
+	}
+}
+
+GLReadbackQueue::Slot* GLReadbackQueue::acquireSlot(IBlock* target, GLsizeiptr size, unsigned int frame)
+{
+	// Create an empty ring for new targets
+	if(!_rings.contains(target))
+	{
+		Ring ring;
+		ring.next = 0;
+		for(Slot& slot : ring.slots)
+			slot = Slot{0, 0, 0, nullptr, 0, 0, 0};
+		_rings.insert(target, ring);
+	}
+
+	// Slots are written in turn and retired in order, so the next slot is only busy, if all of them are
+	Ring& ring = _rings[target];
+	Slot* slot = &ring.slots[ring.next];
+	if(slot->fence)
+		return nullptr;
+
+	// Grow the staging buffer, if necessary
+	if(!slot->buffer)
+		f->glGenBuffers(1, &slot->buffer);
+	if(slot->capacity < size)
+	{
+		f->glBindBuffer(GL_COPY_WRITE_BUFFER, slot->buffer);
+		f->glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, GL_STREAM_READ);
+		f->glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		slot->capacity = size;
+	}
+
+	slot->size = size;
+	slot->frame = frame;
+	slot->readType = 0;
+	slot->type = 0;
+	return slot;
+}
+
+void GLReadbackQueue::submitSlot(IBlock* target, Slot* slot)
+{
+	// The fence signals, once the copy has been executed
+	slot->fence = f->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	Ring& ring = _rings[target];
+	ring.next = (ring.next + 1) % RING_SIZE;
+}
+
+bool GLReadbackQueue::readBuffer(IBlock* target, GLuint buffer, unsigned int frame)
+{
+	// Query the size, which does not need to wait for the GPU
+	GLint size = 0;
+	f->glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+	f->glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+
+	Slot* slot = size > 0 ? acquireSlot(target, size, frame) : nullptr;
+	if(slot)
+	{
+		// Copy on the GPU, the data is fetched as soon as the fence signals
+		f->glBindBuffer(GL_COPY_WRITE_BUFFER, slot->buffer);
+		f->glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, size);
+		f->glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		submitSlot(target, slot);
+	}
+
+	f->glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	return slot != nullptr;
+}
+
+bool GLReadbackQueue::readTexture(IBlock* target, GLenum textureTarget, GLuint texture, GLenum type, unsigned int frame)
+{
+	// Cube maps, multisample and buffer textures cannot be read as a whole
+	switch(textureTarget)
+	{
+	case GL_TEXTURE_1D:
+	case GL_TEXTURE_1D_ARRAY:
+	case GL_TEXTURE_2D:
+	case GL_TEXTURE_2D_ARRAY:
+	case GL_TEXTURE_3D:
+	case GL_TEXTURE_RECTANGLE:
+		break;
+	default:
+		return false;
+	}
+
+	if(type != GL_FLOAT && type != GL_INT && type != GL_UNSIGNED_INT)
+		return false;
+
+	// Query the dimensions and format, which does not need to wait for the GPU
+	GLint width = 0, height = 0, depth = 0, depthSize = 0, internalFormat = 0;
+	f->glBindTexture(textureTarget, texture);
+	f->glGetTexLevelParameteriv(textureTarget, 0, GL_TEXTURE_WIDTH, &width);
+	f->glGetTexLevelParameteriv(textureTarget, 0, GL_TEXTURE_HEIGHT, &height);
+	f->glGetTexLevelParameteriv(textureTarget, 0, GL_TEXTURE_DEPTH, &depth);
+	f->glGetTexLevelParameteriv(textureTarget, 0, GL_TEXTURE_DEPTH_SIZE, &depthSize);
+	f->glGetTexLevelParameteriv(textureTarget, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+
+	// The format has to match the texture, the requested type is converted on the CPU
+	GLenum readType = getReadType(internalFormat);
+	GLenum format = depthSize > 0 ? GL_DEPTH_COMPONENT : (readType == GL_FLOAT ? GL_RGBA : GL_RGBA_INTEGER);
+
+	// All read types have 4 bytes per component
+	GLsizeiptr size = static_cast<GLsizeiptr>(width) * height * depth * (depthSize > 0 ? 1 : 4) * 4;
+
+	Slot* slot = (size > 0 && readType) ? acquireSlot(target, size, frame) : nullptr;
+	if(slot)
+	{
+		slot->readType = readType;
+		slot->type = type;
+
+		// Pack into the staging buffer, so glGetTexImage returns immediately
+		f->glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+		f->glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		f->glGetTexImage(textureTarget, 0, format, readType, nullptr);
+		f->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		submitSlot(target, slot);
+	}
+
+	f->glBindTexture(textureTarget, 0);
+	return slot != nullptr;
+}
+
+QList<GLReadbackQueue::Result> GLReadbackQueue::collect()
+{
+	QList<Result> results;
+
+	for(auto it = _rings.begin(); it != _rings.end(); ++it)
+	{
+		// Visit the slots from the oldest to the newest readback
+		Ring& ring = it.value();
+		for(int i = 0; i < RING_SIZE; i++)
+		{
+			Slot& slot = ring.slots[(ring.next + i) % RING_SIZE];
+			if(!slot.fence)
+				continue;
+
+			// Poll with zero timeout, newer readbacks cannot be finished either, if this one is still pending
+			GLenum status = f->glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+			if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+				break;
+
+			f->glDeleteSync(slot.fence);
+			slot.fence = nullptr;
+
+			// The copy is complete, so mapping does not stall
+			Result result{it.key(), QByteArray(), slot.frame};
+			f->glBindBuffer(GL_COPY_READ_BUFFER, slot.buffer);
+			if(const void* data = f->glMapBufferRange(GL_COPY_READ_BUFFER, 0, slot.size, GL_MAP_READ_BIT))
+			{
+				result.data = QByteArray(static_cast<const char*>(data), static_cast<int>(slot.size));
+				f->glUnmapBuffer(GL_COPY_READ_BUFFER);
+
+				if(slot.readType && slot.readType != slot.type)
+					convertComponents(result.data, slot.readType, slot.type);
+			}
+			f->glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+			results.append(result);
+		}
+	}
+
+	return results;
+}
+
+GLenum GLReadbackQueue::getReadType(GLint internalFormat)
+{
+	switch(internalFormat)
+	{
+	// Integer formats must be read as integers
+	case GL_R8I: case GL_R16I: case GL_R32I:
+	case GL_RG8I: case GL_RG16I: case GL_RG32I:
+	case GL_RGB8I: case GL_RGB16I: case GL_RGB32I:
+	case GL_RGBA8I: case GL_RGBA16I: case GL_RGBA32I:
+		return GL_INT;
+
+	case GL_R8UI: case GL_R16UI: case GL_R32UI:
+	case GL_RG8UI: case GL_RG16UI: case GL_RG32UI:
+	case GL_RGB8UI: case GL_RGB16UI: case GL_RGB32UI:
+	case GL_RGBA8UI: case GL_RGBA16UI: case GL_RGBA32UI:
+	case GL_RGB10_A2UI:
+		return GL_UNSIGNED_INT;
+
+	// Stencil indices have no depth or color components
+	case GL_STENCIL_INDEX:
+	case GL_STENCIL_INDEX1:
+	case GL_STENCIL_INDEX4:
+	case GL_STENCIL_INDEX8:
+	case GL_STENCIL_INDEX16:
+	case 0:
+		return 0;
+
+	// Normalized, floating point and depth formats are read as floats
+	default:
+		return GL_FLOAT;
+	}
+}
+
+void GLReadbackQueue::convertComponents(QByteArray& data, GLenum fromType, GLenum toType)
+{
+	int count = data.size() / 4;
+	char* components = data.data();
+
+	for(int i = 0; i < count; i++)
+	{
+		char* component = components + i * 4;
+
+		// Read the component as double, which holds all values of the supported types exactly
+		double value = 0;
+		switch(fromType)
+		{
+		case GL_FLOAT:			{ float v; std::memcpy(&v, component, 4); value = v; break; }
+		case GL_INT:			{ qint32 v; std::memcpy(&v, component, 4); value = v; break; }
+		case GL_UNSIGNED_INT:	{ quint32 v; std::memcpy(&v, component, 4); value = v; break; }
+		default: return;
+		}
+
+		// Clamp into the target's range, casting values out of range is undefined
+		switch(toType)
+		{
+		case GL_FLOAT:
+		{
+			float v = static_cast<float>(value);
+			std::memcpy(component, &v, 4);
+			break;
+		}
+		case GL_INT:
+		{
+			qint32 v = static_cast<qint32>(qBound(-2147483648.0, value, 2147483647.0));
+			std::memcpy(component, &v, 4);
+			break;
+		}
+		case GL_UNSIGNED_INT:
+		{
+			quint32 v = static_cast<quint32>(qBound(0.0, value, 4294967295.0));
+			std::memcpy(component, &v, 4);
+			break;
+		}
+		default:
+			return;
+		}
+	}
+}
+
+}
@@ -0,0 +1,142 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef GLREADBACKQUEUE_H
+#define GLREADBACKQUEUE_H
+
+#include "glconfiguration.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+
+namespace ysm
+{
+
+	class IBlock;
+
+	/**
+	 * @brief The GLReadbackQueue class copies GPU resources back to the CPU without stalling the rendering.
+	 * Every readback target owns a small ring of staging buffers. A readback copies the resource into a free staging
+	 * buffer, a pixel pack buffer in case of textures, and inserts a fence behind the copy. The fences are polled
+	 * without waiting, so results are delivered one or more frames after they have been requested. If all staging
+	 * buffers of a target are still in flight, the readback is skipped for that frame instead of waiting for the GPU.
+	 * The queue must only be used while the context it was created in is current.
+	 */
+	class GLReadbackQueue
+	{
+	public:
+
+		static const int RING_SIZE = 3; /*!< Number of readbacks that can be in flight per target. */
+
+		/// @brief A finished readback
+		struct Result
+		{
+			IBlock* target;			/*!< The block the readback has been requested for. */
+			QByteArray data;		/*!< The data read back from the GPU. */
+			unsigned int frame;		/*!< The frame the readback has been requested in. */
+		};
+
+	public:
+
+		/**
+		 * @brief GLReadbackQueue	Constructs an empty queue.
+		 * @param functions			OpenGL functions of the context the queue is used in
+		 */
+		GLReadbackQueue(GLConfiguration::Functions* functions);
+
+		/// @brief Destructs this instance and releases all staging buffers and fences.
+		~GLReadbackQueue();
+
+		/**
+		 * @brief readBuffer	Requests a readback of the whole buffer.
+		 * @param target		Block the result is delivered to
+		 * @param buffer		The buffer to read back
+		 * @param frame			The current frame
+		 * @return				False, if the readback was skipped
+		 */
+		bool readBuffer(IBlock* target, GLuint buffer, unsigned int frame);
+
+		/**
+		 * @brief readTexture	Requests a readback of the texture's base level.
+		 * Color textures are read as RGBA, depth textures as depth component. The texture is read in the component
+		 * type matching its internal format and converted to the requested type on the CPU.
+		 * @param target		Block the result is delivered to
+		 * @param textureTarget	The texture's target
+		 * @param texture		The texture to read back
+		 * @param type			The component type, one of GL_FLOAT, GL_INT or GL_UNSIGNED_INT
+		 * @param frame			The current frame
+		 * @return				False, if the readback was skipped or the texture's format is not supported
+		 */
+		bool readTexture(IBlock* target, GLenum textureTarget, GLuint texture, GLenum type, unsigned int frame);
+
+		/**
+		 * @brief collect	Returns all readbacks that have been finished by the GPU, without waiting for pending ones.
+		 * The results of a target are returned in the order they have been requested.
+		 * @return			The finished readbacks
+		 */
+		QList<Result> collect();
+
+	private:
+
+		/// @brief A staging buffer of a ring
+		struct Slot
+		{
+			GLuint buffer;			/*!< The staging buffer. */
+			GLsizeiptr capacity;	/*!< The allocated size of the staging buffer. */
+			GLsizeiptr size;		/*!< The size of the pending readback. */
+			GLsync fence;			/*!< Fence behind the copy, or null if the slot is free. */
+			unsigned int frame;		/*!< The frame the readback has been requested in. */
+			GLenum readType;		/*!< The component type read from the texture, or zero for buffers. */
+			GLenum type;			/*!< The component type requested by the target. */
+		};
+
+		/// @brief The staging buffers of a single target
+		struct Ring
+		{
+			Slot slots[RING_SIZE];	/*!< The staging buffers. */
+			int next;				/*!< The slot written next, which is the oldest one in flight, if any. */
+		};
+
+		/// @brief Returns the next free slot of the target with at least the given capacity, or null if all are in flight.
+		Slot* acquireSlot(IBlock* target, GLsizeiptr size, unsigned int frame);
+
+		/// @brief Inserts the fence behind the copy into the slot and advances the ring.
+		void submitSlot(IBlock* target, Slot* slot);
+
+		/// @brief Returns the component type a texture of the given internal format can be read in, or zero if none.
+		static GLenum getReadType(GLint internalFormat);
+
+		/// @brief Converts tightly packed 4 byte components from one type to another in place.
+		static void convertComponents(QByteArray& data, GLenum fromType, GLenum toType);
+
+	private:
+
+		GLConfiguration::Functions* f;		/*!< The OpenGL functions of the queue's context. */
+		QHash<IBlock*, Ring> _rings;		/*!< The staging buffers mapped to their targets. */
+	};
+}
+
+#endif // GLREADBACKQUEUE_H
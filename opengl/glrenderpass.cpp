@@ -67,13 +67,7 @@ QList<BlockType> GLRenderPass::getRequiredBlockTypes()
 
 QList<IBlock*> GLRenderPass::getBlocksByType(BlockType type) const
 {
-	QList<IBlock*> result;
-
-	for(IBlock* block : _involvedBlocks)
-		if(block->getType() == type)
-			result.append(block);
-
-	return result;
+	return _blocksByType.value(type);
 }
 
 IBlock* GLRenderPass::getUniqueBlock(BlockType type) const
@@ -81,11 +75,11 @@ IBlock* GLRenderPass::getUniqueBlock(BlockType type) const
 	if(!isUniqueBlockType(type))
 		return nullptr;
 
-	QList<IBlock*> result = getBlocksByType(type);
-	if(result.isEmpty())
+	QMap<BlockType, QList<IBlock*> >::const_iterator it = _blocksByType.constFind(type);
+	if(it == _blocksByType.constEnd() || it.value().isEmpty())
 		return nullptr;
 
-	return result.first();
+	return it.value().first();
 }
 
 IBlock* GLRenderPass::getIndexBufferObjectBlock() const
@@ -105,7 +99,7 @@ IBlock* GLRenderPass::getIndexBufferObjectBlock() const
 bool GLRenderPass::isValid() const
 {
 	for(BlockType type : getRequiredBlockTypes())
-		if(getBlocksByType(type).isEmpty())
+		if(!_blocksByType.contains(type))
 			return false;
 
 	return true;
@@ -121,12 +115,17 @@ void GLRenderPass::addInvolvedBlock(IBlock* block)
 	if(!block)
 		throw std::runtime_error("block may not be null");
 
+	// Blocks are added again whenever passes meet, so skip the checks
+	if(_involvedBlocks.contains(block))
+		return;
+
 	IBlock* existing = getUniqueBlock(block->getType());
 	if(existing && existing != block)
 		throw std::runtime_error("tried to add a unique block again");
 
-	// Finally, append the block
+	// Finally, append the block and index it by type
 	_involvedBlocks.insert(block);
+	_blocksByType[block->getType()].append(block);
 }
 
 QList<IConnection*> GLRenderPass::getOutConnections(IBlock* block, PortType type) const
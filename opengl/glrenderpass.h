@@ -28,6 +28,7 @@
 
 #include <QList>
 #include <QSet>
+#include <QMap>
 
 #include "data/blocks/blocktype.h"
 #include "data/blocks/porttype.h"
@@ -113,6 +114,8 @@ namespace ysm
 
 		QSet<IBlock*> _involvedBlocks;						/*!< Holds all blocks involved in this pass. */
 		QSet<IRenderCommand*> _involvedRenderCommands;		/*!< Holds all rendercommands involved in this pass. */
+
+		QMap<BlockType, QList<IBlock*> > _blocksByType;		/*!< Indexes the involved blocks by their type. */
 	};
 }
 
@@ -67,6 +67,10 @@ GLRenderPassSet::GLRenderPassSet(IBlock* outputBlock)
 	// Receive pipeline
 	_pipeline = _outputBlock->getPipeline();
 
+	// Index the render commands once, instead of scanning all commands for every visited block
+	for(IRenderCommand* command : _pipeline->getRenderCommands())
+		_assignedRenderCommands[command->getAssignedBlock()].append(command);
+
 	// A vector from all iterators not having finished their iteration
 	QVector<PipelineIterator*> iterators;
 
@@ -182,16 +186,9 @@ bool GLRenderPassSet::PipelineIterator::isValid() const
 	return !_blockFront.isEmpty();
 }
 
-QList<IRenderCommand*> GLRenderPassSet::findAssignedRenderCommands(IBlock* block)
+QList<IRenderCommand*> GLRenderPassSet::findAssignedRenderCommands(IBlock* block) const
 {
-	QList<IRenderCommand*> commands;
-	for(IRenderCommand* command : _pipeline->getRenderCommands())
-	{
-		if(command->getAssignedBlock() == block)
-			commands.append(command);
-	}
-
-	return commands;
+	return _assignedRenderCommands.value(block);
 }
 
 QVector<GLRenderPassSet::PipelineIterator*> GLRenderPassSet::PipelineIterator::iterate()
@@ -209,8 +206,11 @@ QVector<GLRenderPassSet::PipelineIterator*> GLRenderPassSet::PipelineIterator::i
 		// Add all front blocks to the pass
 		_pass->addInvolvedBlock(block);
 
-		// Add connections to the pass
-		QVector<IConnection*> connections = block->getInConnections();
+		// Add connections to the pass. Readback results are consumed on the CPU, so the blocks being read back do not
+		// feed this pass and must not be iterated, which would otherwise introduce cycles.
+		QVector<IConnection*> connections;
+		if(block->getType() != BlockType::Readback)
+			connections = block->getInConnections();
 
 		// Actual update of the block front happens here
 		for(IConnection* connection : connections)
@@ -31,6 +31,7 @@
 #include <QVector>
 #include <QMap>
 #include <QSet>
+#include <QHash>
 
 namespace ysm
 {
@@ -71,7 +72,7 @@ namespace ysm
 	private:
 
 		/// @brief Returns a list containing all render commands assigned to the specified block
-		QList<IRenderCommand*> findAssignedRenderCommands(IBlock* block);
+		QList<IRenderCommand*> findAssignedRenderCommands(IBlock* block) const;
 
 	private:
 
@@ -87,6 +88,9 @@ namespace ysm
 		/// @brief validity flag
 		bool _valid;
 
+		/// @brief The render commands assigned to each block, in order of the pipeline's command list
+		QHash<IBlock*, QList<IRenderCommand*> > _assignedRenderCommands;
+
 		/**
 		 * @brief Interally used iterator to collect all components of a Renderpass.
 		 */
@@ -28,19 +28,30 @@
 #include "glrenderpassset.h"
 #include "glcontroller.h"
 #include "glwrapper.h"
+#include "glreadbackqueue.h"
+#include "glcodegenerator.h"
+#include "gltracerecorder.h"
 
 #include "evaluation/setuprenderingevaluator.h"
 #include "evaluation/evaluationexception.h"
 
+#include "commands/pipeline/change/updatestatuscommand.h"
+#include "views/logview/logview.h"
+
 #include "data/irendercommand.h"
 #include "data/iblock.h"
 #include "data/iconnection.h"
 #include "data/iconnection.h"
 #include "data/rendercommands/drawrendercommand.h"
 #include "data/blocks/framebufferobjectblock.h"
+#include "data/blocks/readbackdatasourceblock.h"
+#include "data/blocks/meshlodblock.h"
+#include "data/blocks/codegeneratorblock.h"
+#include "data/types/gltypes.h"
 
 #include <QOpenGLShaderProgram>
 #include <QMouseEvent>
+#include <QDir>
 
 namespace ysm
 {
@@ -53,8 +64,14 @@ GLRenderView::GLRenderView(GLController* controller, IBlock* displayBlock)
 	  _controller(controller),
 	  _evaluator(nullptr),
 	  _renderPassSet(nullptr),
+	  _multiDrawFunctions(nullptr),
+	  _indirectBuffer(0),
+	  _viewportHeight(0),
 	  _valid(false),
-	  _cameraControl(nullptr)
+	  _cameraControl(nullptr),
+	  _readbackQueue(nullptr),
+	  _frame(0),
+	  _codeGenerator(nullptr)
 {
 	// Enable partial update
 	setUpdateBehavior(PartialUpdate);
@@ -76,10 +93,54 @@ GLRenderView::GLRenderView(GLController* controller, IBlock* displayBlock)
 			break;
 		}
 	}
+
+	// Search for readback blocks, whose sources are rendered in one of the passes
+	for(IBlock* block : _renderPassSet->getPipeline()->getBlocks(BlockType::Readback))
+	{
+		ReadbackDataSourceBlock* readbackBlock = dynamic_cast<ReadbackDataSourceBlock*>(block);
+		IBlock* source = readbackBlock ? readbackBlock->getReadbackSource() : nullptr;
+		for(GLRenderPass* pass : _renderPassSet->getRenderPasses())
+		{
+			if(source && pass->getInvolvedBlocks().contains(source))
+			{
+				_readbackBlocks.append(readbackBlock);
+				break;
+			}
+		}
+	}
+
+	// Search for code generator blocks, which are attached to the fragment tests of one of the passes
+	for(IBlock* block : _renderPassSet->getPipeline()->getBlocks(BlockType::CodeGenerator))
+	{
+		CodeGeneratorBlock* codeGeneratorBlock = dynamic_cast<CodeGeneratorBlock*>(block);
+		if(!codeGeneratorBlock)
+			continue;
+
+		for(IConnection* connection : codeGeneratorBlock->getGenericInPort()->getInConnections())
+		{
+			IBlock* source = connection->getSource();
+			for(GLRenderPass* pass : _renderPassSet->getRenderPasses())
+			{
+				if(pass->getInvolvedBlocks().contains(source) && !_codeGeneratorBlocks.contains(block))
+					_codeGeneratorBlocks.append(block);
+			}
+		}
+	}
 }
 
 GLRenderView::~GLRenderView()
 {
+	// Staging buffers, fences and the indirect buffer belong to the view's context
+	if(_readbackQueue || _indirectBuffer)
+	{
+		makeCurrent();
+		delete _readbackQueue;
+		if(_indirectBuffer)
+			f->glDeleteBuffers(1, &_indirectBuffer);
+		doneCurrent();
+	}
+
+	delete _codeGenerator;
 	delete _renderPassSet;
 }
 
@@ -95,12 +156,21 @@ IBlock* GLRenderView::getDisplayBlock() const
 
 void GLRenderView::onRegistrationSuccessful()
 {
+	// The levels are generated during the evaluation, so they are only fetched once instead of on every draw
+	_lodChains.clear();
+	for(GLRenderPass* pass : _renderPassSet->getRenderPasses())
+	{
+		if(MeshLODBlock* lodBlock = findLODBlock(pass))
+			_lodChains.insert(pass, lodBlock->getLevelChain());
+	}
+
 	_valid = true;
 }
 
 void GLRenderView::onRenderingAborted()
 {
 	_valid = false;
+	_lodChains.clear();
 }
 
 QVector3D GLRenderView::getCamera() const
@@ -160,7 +230,14 @@ void GLRenderView::initializeGL()
 
 	// Initialize GL-Functions Object
 	// Should not fail, because this one was called and catched in the evaluator before
-	f = context()->versionFunctions<GLConfiguration::Functions>();
+	f = GLConfiguration::getFunctions(context());
+
+	// Indirect multi draws are optional, this is null if OpenGL 4.3 is not supported
+	_multiDrawFunctions = context()->versionFunctions<GLConfiguration::MultiDrawFunctions>();
+
+	// Readbacks are only needed, if a readback block is attached
+	if(!_readbackBlocks.isEmpty())
+		_readbackQueue = new GLReadbackQueue(f);
 }
 
 //TODO: Thread synchronization problems with stopping rendering process.
@@ -174,59 +251,99 @@ void GLRenderView::paintGL()
 	// Let's draw! - but safe
 	try
 	{
+		_frame++;
+
+		// The viewport of the widget is set before painting
+		_viewportHeight = height() * devicePixelRatio();
+
+		// Mark the frame in an active GL trace
+		if(GLTraceRecorder* recorder = GLTraceRecorder::getActive())
+			recorder->recordFrame(f, defaultFramebufferObject(), size() * devicePixelRatio());
+
+		// Deliver the readbacks, the GPU has finished in the meantime
+		collectReadbacks();
+
 		// At first, update Camera control data
 		setupCameraControl();
 
+		// The first frame is recorded for code generator blocks, after all objects have been read back
+		if(_frame == 1 && !_codeGeneratorBlocks.isEmpty())
+		{
+			_codeGenerator = new GLCodeGenerator(f, _evaluator, _renderPassSet, defaultFramebufferObject(), size(), context()->format());
+			_codeGenerator->recordObjects();
+		}
+
 		// Iterate over all commands stored in the underlying pipeline
-		for(IRenderCommand* command : _renderPassSet->getPipeline()->getRenderCommands())
+		QVector<IRenderCommand*> commands = _renderPassSet->getPipeline()->getRenderCommands();
+		for(int i = 0; i < commands.size(); i++)
 		{
+			IRenderCommand* command = commands[i];
+			QList<GLRenderPass*> passes = findRenderPasses(command);
+
+			// Consecutive draw commands of the same single pass are drawn at once. Commands being part of multiple
+			// passes are not batched, since that would change the order in which the passes are drawn. Neither are
+			// commands capturing transform feedback, since every draw has to overwrite the feedback buffer.
+			QList<IRenderCommand*> batch;
+			batch.append(command);
+
+			while(passes.size() == 1 && !passes.first()->getUniqueBlock(BlockType::TransformFeedback) && i + 1 < commands.size() && isBatchCompatible(command, commands[i + 1])
+				  && findRenderPasses(commands[i + 1]) == passes)
+				batch.append(commands[++i]);
+
 			bool clearCommand = false;
-			for(GLRenderPass* pass : _renderPassSet->getRenderPasses())
+			for(GLRenderPass* pass : passes)
 			{
-				if(pass->getInvolvedRenderCommands().contains(command))
-				{
-					// Look for a framebuffer object to be bound
-					IBlock* fbo = pass->getUniqueBlock(BlockType::FrameBufferObject);
-					if(fbo)
-						f->glBindFramebuffer(GL_FRAMEBUFFER, _evaluator->getEvaluatedData(fbo)->getValue());
-
-					// Execute command
-					switch (command->getCommand()) {
-					case RenderCommandType::Clear:
-						callClearSettings(command);
-						clearCommand = true;
-						break;
-					case RenderCommandType::Draw:
-						callDrawCommand(command, pass);
-						break;
-					default:
-						break;
-					}
-
-					// Release framebuffer
-					if(fbo)
-						f->glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
-
-					// Sync between passes
-					GLsync sync = f->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-					f->glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, SYNC_TIMEOUT);
-					f->glDeleteSync(sync);
-
-					// In case we have a clear command, we break here, because otherwise the command could be called
-					// multiple times, since a FBO or Display can be part of multiple passes.
-					if(clearCommand)
-						break;
+				// Look for a framebuffer object to be bound
+				IBlock* fbo = pass->getUniqueBlock(BlockType::FrameBufferObject);
+				if(fbo)
+					f->glBindFramebuffer(GL_FRAMEBUFFER, _evaluator->getEvaluatedData(fbo)->getValue());
+
+				// Execute command
+				switch (command->getCommand()) {
+				case RenderCommandType::Clear:
+					callClearSettings(command);
+					clearCommand = true;
+					break;
+				case RenderCommandType::Draw:
+					callDrawCommands(batch, pass);
+					break;
+				default:
+					break;
 				}
+
+				// Release framebuffer
+				if(fbo)
+					f->glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
+
+				// Sync between passes
+				GLsync sync = f->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				f->glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, SYNC_TIMEOUT);
+				f->glDeleteSync(sync);
+
+				// In case we have a clear command, we break here, because otherwise the command could be called
+				// multiple times, since a FBO or Display can be part of multiple passes.
+				if(clearCommand)
+					break;
 			}
 		}
+
+		// Read back the results of this frame, they are delivered in one of the next frames
+		requestReadbacks();
+
+		if(_codeGenerator)
+			writeGeneratedCode();
 	}
 	catch(EvaluationException exception)
 	{
 		// Don't forget to bind Default FBO
 		f->glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
 
+		// An incomplete frame is not exported
+		delete _codeGenerator;
+		_codeGenerator = nullptr;
+
 		// Tell the Controller it should stop rendering
-		_controller->signalAbortRendering(this, exception.what());
+		_controller->signalAbortRendering(this, exception.what(), "", exception.getBlock());
 	}
 }
 
@@ -300,15 +417,34 @@ void GLRenderView::bindTexture(IBlock* block, GLRenderPass* pass) const
 	}
 }
 
-void GLRenderView::callDrawCommand(IRenderCommand* command, GLRenderPass* pass)
+QList<GLRenderPass*> GLRenderView::findRenderPasses(IRenderCommand* command) const
 {
-	// Initialize this pass for being drawn
-	initializePass(pass);
+	QList<GLRenderPass*> passes;
+	for(GLRenderPass* pass : _renderPassSet->getRenderPasses())
+	{
+		if(pass->getInvolvedRenderCommands().contains(command))
+			passes.append(pass);
+	}
 
-	// Bind the vao
-	IBlock* vao = pass->getUniqueBlock(BlockType::VertexArrayObject);
-	f->glBindVertexArray(_evaluator->getEvaluatedData(vao)->getValue());
+	return passes;
+}
+
+bool GLRenderView::isBatchCompatible(IRenderCommand* first, IRenderCommand* second)
+{
+	if(first->getCommand() != RenderCommandType::Draw || second->getCommand() != RenderCommandType::Draw)
+		return false;
 
+	// Counts, offsets and instance counts may differ, everything else must match
+	int firstDrawMode = *first->getProperty<EnumProperty>(PropertyID::Draw_DrawMode);
+	int secondDrawMode = *second->getProperty<EnumProperty>(PropertyID::Draw_DrawMode);
+	int firstPrimitiveMode = *first->getProperty<EnumProperty>(PropertyID::Draw_PrimitiveMode);
+	int secondPrimitiveMode = *second->getProperty<EnumProperty>(PropertyID::Draw_PrimitiveMode);
+
+	return firstDrawMode == secondDrawMode && firstPrimitiveMode == secondPrimitiveMode;
+}
+
+GLenum GLRenderView::getPrimitiveMode(IRenderCommand* command)
+{
 	int primitiveMode = *command->getProperty<EnumProperty>(PropertyID::Draw_PrimitiveMode);
 	switch (primitiveMode)
 	{
@@ -352,57 +488,221 @@ void GLRenderView::callDrawCommand(IRenderCommand* command, GLRenderPass* pass)
 		break;
 	}
 
-	// Look for transform feedback to be enabled
-	IBlock* tfb = pass->getUniqueBlock(BlockType::TransformFeedback);
-	if(tfb) // TODO: limit selection here
-		f->glBeginTransformFeedback(primitiveMode);
+	return primitiveMode;
+}
 
+int GLRenderView::getElementCount(IRenderCommand* command, GLRenderPass* pass) const
+{
 	// Get the element count either from auto detection or user input
-	int elementCount = 0;
 	if(command->getProperty<BoolProperty>(PropertyID::Draw_AutoElementCount)->getValue())
 	{
 		// Per design by contract, we can guarantee exactly one Vertex Puller
 		IBlock* puller = pass->getUniqueBlock(BlockType::VertexPuller);
-		elementCount = *puller->getProperty<UIntProperty>(PropertyID::VertexPuller_ElementCount);
+		return *puller->getProperty<UIntProperty>(PropertyID::VertexPuller_ElementCount);
+	}
+
+	return *command->getProperty<UIntProperty>(PropertyID::Draw_ElementCount);
+}
+
+MeshLODBlock* GLRenderView::findLODBlock(GLRenderPass* pass) const
+{
+	// The detail levels are only known, if the index buffer is filled by the LOD block directly
+	IBlock* ibo = pass->getIndexBufferObjectBlock();
+	if(!ibo)
+		return nullptr;
+
+	for(IConnection* connection : ibo->getPort(PortType::Data_In)->getInConnections())
+	{
+		if(MeshLODBlock* lodBlock = dynamic_cast<MeshLODBlock*>(connection->getSource()))
+			return lodBlock;
 	}
+
+	return nullptr;
+}
+
+void GLRenderView::selectLODLevel(IRenderCommand* command, GLRenderPass* pass, const MeshLODDataSource::LevelChain& chain, GLuint& firstIndex, GLuint& elementCount) const
+{
+	if(chain.levels.isEmpty())
+		return;
+
+	int selected = 0;
+	IBlock* mvp = pass->getUniqueBlock(BlockType::ModelViewProjection);
+	if(mvp && *command->getProperty<BoolProperty>(PropertyID::Draw_LODSelection))
+	{
+		QMatrix4x4 modelView = *mvp->getProperty<Mat4x4Property>(PropertyID::MVP_MatMV);
+		QMatrix4x4 projection = *mvp->getProperty<Mat4x4Property>(PropertyID::MVP_MatP);
+
+		// Object space errors grow with the largest scaling of the transformation
+		float scale = qMax(modelView.column(0).toVector3D().length(),
+						   qMax(modelView.column(1).toVector3D().length(), modelView.column(2).toVector3D().length()));
+
+		float pixelsPerUnit = projection(1, 1) * _viewportHeight * 0.5f;
+
+		// Perspective projections shrink the error with the distance of the nearest point of the bounding sphere
+		bool perspective = projection(3, 3) == 0.0f;
+		float distance = -modelView.map(chain.boundsCenter).z() - chain.boundsRadius * scale;
+
+		if(!perspective || distance > 0.0f)
+		{
+			if(perspective)
+				pixelsPerUnit /= distance;
+
+			float threshold = *command->getProperty<FloatProperty>(PropertyID::Draw_LODThreshold);
+			for(selected = chain.levels.size() - 1; selected > 0; selected--)
+			{
+				if(chain.levels[selected].error * scale * pixelsPerUnit <= threshold)
+					break;
+			}
+		}
+	}
+
+	// A user defined count may only shorten the level
+	const MeshLODDataSource::Level& level = chain.levels[selected];
+	firstIndex = level.firstIndex;
+	if(command->getProperty<BoolProperty>(PropertyID::Draw_AutoElementCount)->getValue())
+		elementCount = level.indexCount;
 	else
-		elementCount = *command->getProperty<UIntProperty>(PropertyID::Draw_ElementCount);
+		elementCount = qMin(elementCount, level.indexCount);
+}
+
+void GLRenderView::callDrawCommands(const QList<IRenderCommand*>& commands, GLRenderPass* pass)
+{
+	// Initialize this pass for being drawn
+	initializePass(pass);
+
+	// Bind the vao
+	IBlock* vao = pass->getUniqueBlock(BlockType::VertexArrayObject);
+	f->glBindVertexArray(_evaluator->getEvaluatedData(vao)->getValue());
+
+	// All commands share the primitive and draw mode of the first one
+	IRenderCommand* firstCommand = commands.first();
+	GLenum primitiveMode = getPrimitiveMode(firstCommand);
+	int drawMode = *firstCommand->getProperty<EnumProperty>(PropertyID::Draw_DrawMode);
 
-	switch (*command->getProperty<EnumProperty>(PropertyID::Draw_DrawMode))
+	// Look for transform feedback to be enabled
+	IBlock* tfb = pass->getUniqueBlock(BlockType::TransformFeedback);
+	if(tfb) // TODO: limit selection here
 	{
-	case DrawRenderCommand::DrawMode_Elements:
+		f->glBeginTransformFeedback(primitiveMode);
+		if(_codeGenerator)
+			_codeGenerator->recordBeginTransformFeedback(primitiveMode);
+	}
+
+	// Index buffers filled by a LOD block hold all levels, only one of them is drawn
+	const MeshLODDataSource::LevelChain* lodChain = nullptr;
+	if(drawMode == DrawRenderCommand::DrawMode_Elements)
 	{
 		GLWrapper* ibo = _evaluator->getEvaluatedData(pass->getIndexBufferObjectBlock());
 		f->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo->getValue());
-		if(*command->getProperty<BoolProperty>(PropertyID::Draw_Instanced))
+
+		auto it = _lodChains.constFind(pass);
+		if(it != _lodChains.constEnd())
+			lodChain = &it.value();
+	}
+
+	if(commands.size() > 1 && _multiDrawFunctions)
+	{
+		// Gather the parameters of all commands in the layout expected by OpenGL
+		QVector<GLuint> parameters;
+		for(IRenderCommand* command : commands)
 		{
-			unsigned int instanceCount = *command->getProperty<UIntProperty>(PropertyID::Draw_InstanceCount);
-			f->glDrawElementsInstanced(primitiveMode, elementCount, GL_UNSIGNED_INT, 0, instanceCount);
+			GLuint instanceCount = 1;
+			if(*command->getProperty<BoolProperty>(PropertyID::Draw_Instanced))
+				instanceCount = *command->getProperty<UIntProperty>(PropertyID::Draw_InstanceCount);
+
+			GLuint elementCount = getElementCount(command, pass);
+			GLuint firstIndex = 0;
+			if(lodChain)
+				selectLODLevel(command, pass, *lodChain, firstIndex, elementCount);
+
+			// The generated code draws the commands one by one
+			if(_codeGenerator)
+			{
+				bool indexed = drawMode == DrawRenderCommand::DrawMode_Elements;
+				GLuint first = indexed ? firstIndex : GLuint(*command->getProperty<UIntProperty>(PropertyID::Draw_FirstIndex));
+				bool instanced = *command->getProperty<BoolProperty>(PropertyID::Draw_Instanced);
+				_codeGenerator->recordDraw(pass, primitiveMode, indexed, first, elementCount, instanced, instanceCount);
+			}
+
+			// Elements: count, instance count, first index, base vertex, base instance
+			// Arrays: count, instance count, first, base instance
+			parameters << elementCount << instanceCount;
+			if(drawMode == DrawRenderCommand::DrawMode_Elements)
+				parameters << firstIndex << 0 << 0;
+			else
+				parameters << *command->getProperty<UIntProperty>(PropertyID::Draw_FirstIndex) << 0;
 		}
+
+		if(!_indirectBuffer)
+			f->glGenBuffers(1, &_indirectBuffer);
+
+		// The buffer is orphaned every time, so that the driver doesn't need to wait for previous draws
+		f->glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _indirectBuffer);
+		f->glBufferData(GL_DRAW_INDIRECT_BUFFER, parameters.size() * sizeof(GLuint), parameters.constData(), GL_STREAM_DRAW);
+
+		if(drawMode == DrawRenderCommand::DrawMode_Elements)
+			f->glMultiDrawElementsIndirect(primitiveMode, GL_UNSIGNED_INT, 0, commands.size(), 0);
 		else
-			f->glDrawElements(primitiveMode, elementCount, GL_UNSIGNED_INT, 0);
-		f->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+			f->glMultiDrawArraysIndirect(primitiveMode, 0, commands.size(), 0);
+
+		f->glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
 	}
-		break;
-	case DrawRenderCommand::DrawMode_Arrays:
+	else
 	{
-		int firstIndex = *command->getProperty<UIntProperty>(PropertyID::Draw_FirstIndex);
-		if(*command->getProperty<BoolProperty>(PropertyID::Draw_Instanced))
+		// Without indirect draws, at least the pass state is shared
+		for(IRenderCommand* command : commands)
 		{
+			int elementCount = getElementCount(command, pass);
+			bool instanced = *command->getProperty<BoolProperty>(PropertyID::Draw_Instanced);
 			unsigned int instanceCount = *command->getProperty<UIntProperty>(PropertyID::Draw_InstanceCount);
-			f->glDrawArraysInstanced(primitiveMode, firstIndex, elementCount, instanceCount);
+
+			switch (drawMode)
+			{
+			case DrawRenderCommand::DrawMode_Elements:
+			{
+				GLuint firstIndex = 0;
+				GLuint levelCount = elementCount;
+				if(lodChain)
+					selectLODLevel(command, pass, *lodChain, firstIndex, levelCount);
+
+				if(_codeGenerator)
+					_codeGenerator->recordDraw(pass, primitiveMode, true, firstIndex, levelCount, instanced, instanceCount);
+
+				const void* offset = reinterpret_cast<const void*>(firstIndex * sizeof(GLuint));
+				if(instanced)
+					f->glDrawElementsInstanced(primitiveMode, levelCount, GL_UNSIGNED_INT, offset, instanceCount);
+				else
+					f->glDrawElements(primitiveMode, levelCount, GL_UNSIGNED_INT, offset);
+			}
+				break;
+			case DrawRenderCommand::DrawMode_Arrays:
+			{
+				int firstIndex = *command->getProperty<UIntProperty>(PropertyID::Draw_FirstIndex);
+				if(_codeGenerator)
+					_codeGenerator->recordDraw(pass, primitiveMode, false, firstIndex, elementCount, instanced, instanceCount);
+
+				if(instanced)
+					f->glDrawArraysInstanced(primitiveMode, firstIndex, elementCount, instanceCount);
+				else
+					f->glDrawArrays(primitiveMode, firstIndex, elementCount);
+			}
+				break;
+			default:
+				break;
+			}
 		}
-		else
-			f->glDrawArrays(primitiveMode, firstIndex, elementCount);
-	}
-		break;
-	default:
-		break;
 	}
 
 	// Reset state
+	if(drawMode == DrawRenderCommand::DrawMode_Elements)
+		f->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
 	if(tfb)
+	{
 		f->glEndTransformFeedback();
+		if(_codeGenerator)
+			_codeGenerator->recordEndTransformFeedback();
+	}
 
 	f->glBindVertexArray(0);
 }
@@ -415,6 +715,7 @@ void GLRenderView::callClearSettings(IRenderCommand* command)
 	{
 		//TODO: which size to choose for a FBO?
 		f->glViewport(0, 0, width(), height());
+		_viewportHeight = height();
 	}
 	else
 	{
@@ -422,6 +723,7 @@ void GLRenderView::callClearSettings(IRenderCommand* command)
 		int width = command->getProperty<UIntProperty>(PropertyID::Clear_ViewportWidth)->getValue();
 		int height = command->getProperty<UIntProperty>(PropertyID::Clear_ViewportHeight)->getValue();
 		f->glViewport(lowerLeft.x(), lowerLeft.y(), width, height);
+		_viewportHeight = height;
 	}
 
 	// initialize bitmask, to be able to use a single API call
@@ -452,9 +754,89 @@ void GLRenderView::callClearSettings(IRenderCommand* command)
 	}
 
 	// Clear selected buffers
+	if(_codeGenerator)
+		_codeGenerator->recordClear(field);
+
 	f->glClear(field);
 }
 
+void GLRenderView::requestReadbacks()
+{
+	if(!_readbackQueue)
+		return;
+
+	for(ReadbackDataSourceBlock* block : _readbackBlocks)
+	{
+		// Skip sources, that have not been evaluated
+		IBlock* source = block->getReadbackSource();
+		GLWrapper* wrapper = source ? _evaluator->getEvaluatedData(source) : nullptr;
+		if(!wrapper)
+			continue;
+
+		// If the previous readbacks are still pending, the request is skipped instead of waiting
+		if(source->getType() == BlockType::Buffer)
+			_readbackQueue->readBuffer(block, wrapper->getValue(), _frame);
+		else if(GLTextureWrapper* texture = dynamic_cast<GLTextureWrapper*>(wrapper))
+		{
+			// Read the components in the type the results are interpreted as
+			GLenum type = GL_FLOAT;
+			switch(static_cast<DataType>(block->getDataType()->getValue()))
+			{
+			case DataType::Int:
+				type = GL_INT;
+				break;
+			case DataType::UInt:
+				type = GL_UNSIGNED_INT;
+				break;
+			default:
+				break;
+			}
+
+			_readbackQueue->readTexture(block, texture->getTarget(), texture->getValue(), type, _frame);
+		}
+	}
+}
+
+void GLRenderView::collectReadbacks()
+{
+	if(!_readbackQueue)
+		return;
+
+	for(const GLReadbackQueue::Result& result : _readbackQueue->collect())
+	{
+		ReadbackDataSourceBlock* block = dynamic_cast<ReadbackDataSourceBlock*>(result.target);
+		if(block)
+			block->setReadbackResult(result.data, result.frame);
+	}
+}
+
+void GLRenderView::writeGeneratedCode()
+{
+	LogView::log(LogSeverity::Info, "Code generation", QString("Recorded frame for code generation: %1").arg(_codeGenerator->getSummary()));
+
+	for(IBlock* block : _codeGeneratorBlocks)
+	{
+		QString fileName = *block->getProperty<FilenameProperty>(PropertyID::CodeGenerator_FileName);
+		if(fileName.isEmpty())
+			continue;
+
+		try
+		{
+			_codeGenerator->write(fileName);
+			LogView::log(LogSeverity::Info, "Code generation", QString("Code generated into %1").arg(QDir::toNativeSeparators(fileName)), block->getID());
+		}
+		catch(std::runtime_error& error)
+		{
+			executeCommand(new UpdateStatusCommand(block, PipelineItemStatus::Sick, error.what()));
+			LogView::log(LogSeverity::Error, "Code generation", QString("Code generation failed: %1").arg(error.what()), block->getID());
+		}
+	}
+
+	// Only the first frame is exported
+	delete _codeGenerator;
+	_codeGenerator = nullptr;
+}
+
 
 void GLRenderView::mouseMoveEvent(QMouseEvent* event)
 {
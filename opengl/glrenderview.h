@@ -27,6 +27,7 @@
 #define GLRENDERVIEW_H
 
 #include <QOpenGLWidget>
+#include <QHash>
 #include <QMatrix4x4>
 
 #include "glconfiguration.h"
@@ -34,6 +35,7 @@
 #include "views/view.h"
 #include "data/blocks/blocktype.h"
 #include "data/rendercommands/rendercommandtype.h"
+#include "data/types/meshloddatasource.h"
 
 namespace ysm
 {
@@ -44,7 +46,11 @@ namespace ysm
 	class GLRenderPass;
 	class GLRenderPassSet;
 	class GLController;
+	class GLReadbackQueue;
+	class GLCodeGenerator;
 	class SetupRenderingEvaluator;
+	class ReadbackDataSourceBlock;
+	class MeshLODBlock;
 
 	/**
 	 * @brief The GLRenderView class is needed for achieving visual feedback from the pipeline in terms of OpenGL.
@@ -73,7 +79,7 @@ namespace ysm
 		/// @brief gets the DisplayBlock the view was created for.
 		IBlock* getDisplayBlock() const;
 
-		/// @brief Called, when registration was successful
+		/// @brief Called, when registration was successful, takes over the level chains of the evaluated LOD blocks.
 		void onRegistrationSuccessful();
 
 		/// @brief Called, when rendering should be aborted for any reason
@@ -121,12 +127,50 @@ namespace ysm
 		/// @brief binds all textures to their specified units and targets.
 		void bindTexture(IBlock* textureBlock, GLRenderPass* pass) const;
 
-		/// @brief Sets everything to be done for drawing actual data.
-		void callDrawCommand(IRenderCommand* command, GLRenderPass* pass);
+		/// @brief Returns the passes the given command is part of.
+		QList<GLRenderPass*> findRenderPasses(IRenderCommand* command) const;
+
+		/**
+		 * @brief Checks whether two draw commands can be drawn at once.
+		 * This is the case, if they only differ in their counts, offsets and instance counts.
+		 */
+		static bool isBatchCompatible(IRenderCommand* first, IRenderCommand* second);
+
+		/// @brief Returns the OpenGL primitive mode of the given draw command.
+		static GLenum getPrimitiveMode(IRenderCommand* command);
+
+		/// @brief Returns the number of elements to be drawn by the given draw command.
+		int getElementCount(IRenderCommand* command, GLRenderPass* pass) const;
+
+		/// @brief Returns the mesh LOD block filling the index buffer of the given pass, or null if there is none.
+		MeshLODBlock* findLODBlock(GLRenderPass* pass) const;
+
+		/**
+		 * @brief Restricts an indexed draw command to a single level of the given level chain.
+		 * If enabled by the command, the coarsest level whose error projects to at most the command's threshold in
+		 * pixels is chosen, using the model view and projection matrices of the pass. Otherwise, the finest level is drawn.
+		 */
+		void selectLODLevel(IRenderCommand* command, GLRenderPass* pass, const MeshLODDataSource::LevelChain& chain, GLuint& firstIndex, GLuint& elementCount) const;
+
+		/**
+		 * @brief Sets everything to be done for drawing actual data.
+		 * All commands must be compatible to the first one. The pass state is set up only once and the
+		 * commands are submitted with a single indirect multi draw, if supported.
+		 */
+		void callDrawCommands(const QList<IRenderCommand*>& commands, GLRenderPass* pass);
 
 		/// @brief Calls glClear with respective Parameters according to RenderCommand Properties.
 		void callClearSettings(IRenderCommand* command);
 
+		/// @brief Requests readbacks of all sources rendered by this view, without waiting for the GPU.
+		void requestReadbacks();
+
+		/// @brief Delivers all finished readbacks to their blocks, without waiting for the GPU.
+		void collectReadbacks();
+
+		/// @brief Writes the recorded frame to the files of all code generator blocks and releases the generator.
+		void writeGeneratedCode();
+
 	private:
 
 		// Attributes
@@ -135,12 +179,24 @@ namespace ysm
 
 		GLRenderPassSet* _renderPassSet;	/*!< The PipelineInfo instance used by this RenderView. */
 		GLConfiguration::Functions* f;		/*!< The OpenGL-Functions Object to gain access to the necessary functions. */
+		GLConfiguration::MultiDrawFunctions* _multiDrawFunctions; /*!< Functions for indirect multi draws, or null if not supported. */
+		GLuint _indirectBuffer;				/*!< Buffer holding the parameters of batched draw commands. */
+		GLint _viewportHeight;				/*!< Height of the viewport last set for drawing. */
 
 		bool _valid;						/*!< Determines, whether view is actually ready to be rendered. */
 
 		IBlock* _cameraControl;				/*!< A Pointer to the only camera control block, if exists. */
 		QPoint _grabMousePosition;			/*!< Stores the relative position the grab event took place. */
 		QVector3D _cameraTransform;			/*!< The camera position within this RenderView */
+
+		GLReadbackQueue* _readbackQueue;	/*!< Pending readbacks, created with the context. */
+		QList<ReadbackDataSourceBlock*> _readbackBlocks; /*!< Readback blocks whose sources are rendered by this view. */
+		unsigned int _frame;				/*!< Number of frames rendered so far. */
+
+		QHash<GLRenderPass*, MeshLODDataSource::LevelChain> _lodChains; /*!< Level chains of the LOD blocks filling the index buffers of the passes. */
+
+		QList<IBlock*> _codeGeneratorBlocks;/*!< Code generator blocks attached to the output of one of the passes. */
+		GLCodeGenerator* _codeGenerator;	/*!< Records the first frame for the code generator blocks, null otherwise. */
 	};
 }
 
@@ -37,6 +37,7 @@
 #include "glslssbodeclarationcheck.h"
 #include "glslubodeclarationcheck.h"
 #include "glslredefinitioncheck.h"
+#include "glsltagindex.h"
 
 #include <QRegularExpression>
 
@@ -65,6 +66,14 @@ GLSLPipelineAdapter::GLSLPipelineAdapter(GLSLDocument* parentDocument) :
 
 	//VAO check is registered dynamically for vertex shaders.
 	_vaoCheck = new GLSLVaoDeclarationCheck();
+
+	//Index all tags, the order must match the tag enumeration.
+	_tagIndex = new GLSLTagIndex(parentDocument, QStringList()
+		<< GLSLDocument::editableStart
+		<< GLSLDocument::editableEnd
+		<< GLSLDocument::editableBlockStart
+		<< GLSLDocument::editableBlockEnd
+		<< SECTION_DIVIDER);
 }
 
 GLSLPipelineAdapter::~GLSLPipelineAdapter()
@@ -79,7 +88,7 @@ bool GLSLPipelineAdapter::checkCursorPosition(const QTextCursor& oldCursor, QTex
 	if(!_pipelineBlock) return true;
 
 	//Find the fixed section's end.
-	int fixedSection = _parentDocument->find(SECTION_DIVIDER).selectionEnd();
+	int fixedSection = getFixedSectionEnd();
 
 	//If the cursor is outside the fixed section, position is always allowed.
 	if(newCursor.selectionStart() > fixedSection)
@@ -95,31 +104,27 @@ bool GLSLPipelineAdapter::checkCursorPosition(const QTextCursor& oldCursor, QTex
 	//Tag offset is calculated by editable start, it's assumed that all tags have the same length.
 	int tagLength = GLSLDocument::editableStart.length();
 
-	//Create a cursor to select the text around the new cursor position.
-	QTextCursor checkCursor(_parentDocument);
-	checkCursor.setPosition(newCursor.position() - tagLength, QTextCursor::MoveAnchor);
-	checkCursor.setPosition(newCursor.position() + tagLength, QTextCursor::KeepAnchor);
-
-	//Find a possible tag that surrounds the cursor.
-	QString surroundingText = checkCursor.selectedText();
+	//Calculate the range around the new cursor position, clamped to the document.
+	int rangeStart = qMax(0, newCursor.position() - tagLength);
+	int rangeEnd = qMin(_parentDocument->characterCount() - 1, newCursor.position() + tagLength);
 	int cursorTagType = 0;
 
 	//Identify the tag that surrounds the cursor (opening or closing).
-	if(surroundingText.contains(GLSLDocument::editableBlockStart)) cursorTagType = -1;
-	if(surroundingText.contains(GLSLDocument::editableBlockEnd)) cursorTagType = 1;
-	if(surroundingText.contains(GLSLDocument::editableStart)) cursorTagType = -1;
-	if(surroundingText.contains(GLSLDocument::editableEnd)) cursorTagType = 1;
+	if(_tagIndex->containsTag(EditableBlockStart, rangeStart, rangeEnd)) cursorTagType = -1;
+	if(_tagIndex->containsTag(EditableBlockEnd, rangeStart, rangeEnd)) cursorTagType = 1;
+	if(_tagIndex->containsTag(EditableStart, rangeStart, rangeEnd)) cursorTagType = -1;
+	if(_tagIndex->containsTag(EditableEnd, rangeStart, rangeEnd)) cursorTagType = 1;
 
-	//Check wether the check cursor contains a tag, in this case the cursor's position is invalid.
+	//Check wether the range contains a tag, in this case the cursor's position is invalid.
 	if(!cursorTagType)
 		return true;
 
 	//It's actually allowed that a cursor is directly behind an opening tag or directly in front of a closing tag.
 	bool validPosition =
-		surroundingText.startsWith(GLSLDocument::editableBlockStart) ||
-		surroundingText.endsWith(GLSLDocument::editableBlockEnd) ||
-		surroundingText.startsWith(GLSLDocument::editableStart) ||
-		surroundingText.endsWith(GLSLDocument::editableEnd);
+		_tagIndex->isTagAt(EditableBlockStart, rangeStart) ||
+		_tagIndex->isTagAt(EditableBlockEnd, rangeEnd - _tagIndex->getTagLength(EditableBlockEnd)) ||
+		_tagIndex->isTagAt(EditableStart, rangeStart) ||
+		_tagIndex->isTagAt(EditableEnd, rangeEnd - _tagIndex->getTagLength(EditableEnd));
 
 	//If the position is valid, no change is neccessary.
 	if(validPosition)
@@ -143,46 +148,47 @@ bool GLSLPipelineAdapter::checkLineEditingPermission(int pressedKey, QTextCursor
 {
 	//Find the next tags from the cursor's start and end.
 	int startOffset = textCursor.selectionStart() - GLSLDocument::editableStart.length() + 1;
-	QTextCursor startTag = _parentDocument->find(GLSLDocument::editableStart, startOffset);
-	QTextCursor endTag = _parentDocument->find(GLSLDocument::editableEnd, textCursor.selectionEnd());
+	int startTag = _tagIndex->findNext(EditableStart, startOffset);
+	int endTag = _tagIndex->findNext(EditableEnd, textCursor.selectionEnd());
 
 	//If no end tag is found, editing is forbidden.
-	if(endTag.isNull())
+	if(endTag < 0)
 		return false;
 
 	//If the next tag is a closing tag, the edit is permitted, as long as no newline is added.
 	return
-		(startTag.isNull() || startTag.selectionEnd() > endTag.selectionEnd()) &&
+		(startTag < 0 ||
+		 startTag + _tagIndex->getTagLength(EditableStart) > endTag + _tagIndex->getTagLength(EditableEnd)) &&
 		(pressedKey != Qt::Key_Return && pressedKey != Qt::Key_Enter);
 }
 
 bool GLSLPipelineAdapter::checkBlockEditingPermission(QTextCursor textCursor)
 {
-	//Iterate over all blocks from the selection start to selection end.
-	for(QTextBlock currentBlock = textCursor.block(); ;currentBlock = currentBlock.next())
-	{
-		//Check if the current block contains a tag, if so editing is permitted.
-		if(!currentBlock.isValid() ||
-			currentBlock.text().contains(GLSLDocument::editableBlockStart) ||
-			currentBlock.text().contains(GLSLDocument::editableBlockEnd))
-			return false;
-
-		//If the block contains the cursor, no tag is contained in the cursor's selection.
-		if(currentBlock.contains(textCursor.selectionEnd()))
-			break;
-	}
+	//Find the range of all blocks from the cursor's block to the selection's end.
+	QTextBlock lastBlock = _parentDocument->findBlock(textCursor.selectionEnd());
+	if(!lastBlock.isValid())
+		return false;
+
+	int rangeStart = textCursor.block().position();
+	int rangeEnd = lastBlock.position() + lastBlock.length();
+
+	//Check if any of these blocks contains a tag, if so editing is forbidden.
+	if(_tagIndex->containsTag(EditableBlockStart, rangeStart, rangeEnd) ||
+		_tagIndex->containsTag(EditableBlockEnd, rangeStart, rangeEnd))
+		return false;
 
 	//Find the next start and end tag.
 	int tagOffset = textCursor.selectionEnd();
-	QTextCursor startTag = _parentDocument->find(GLSLDocument::editableBlockStart, tagOffset);
-	QTextCursor endTag = _parentDocument->find(GLSLDocument::editableBlockEnd, tagOffset);
+	int startTag = _tagIndex->findNext(EditableBlockStart, tagOffset);
+	int endTag = _tagIndex->findNext(EditableBlockEnd, tagOffset);
 
 	//If no end tag is found, editing is forbidden.
-	if(endTag.isNull())
+	if(endTag < 0)
 		return false;
 
 	//If the next tag is a closing tag, the edit is permitted.
-	return startTag.isNull() || startTag.selectionEnd() > endTag.selectionEnd();
+	return startTag < 0 ||
+		startTag + _tagIndex->getTagLength(EditableBlockStart) > endTag + _tagIndex->getTagLength(EditableBlockEnd);
 }
 
 bool GLSLPipelineAdapter::checkEditingPermission(int pressedKey, Qt::KeyboardModifiers keyModifiers,
@@ -192,7 +198,7 @@ bool GLSLPipelineAdapter::checkEditingPermission(int pressedKey, Qt::KeyboardMod
 	if(!_pipelineBlock) return true;
 
 	//Find the fixed section's end.
-	int fixedSection = _parentDocument->find(SECTION_DIVIDER).selectionEnd();
+	int fixedSection = getFixedSectionEnd();
 
 	//Delete keys need to be handled differently, because they are not adding but removing text. Thus, the removed
 	//character needs to be included in the selection so it's handled correctly.
@@ -221,7 +227,7 @@ bool GLSLPipelineAdapter::checkEditingPermission(int pressedKey, Qt::KeyboardMod
 void GLSLPipelineAdapter::insertStatements(const QList<IGLSLPipelineCheck::FixedStatement>& statements)
 {
 	//Find the fixed section's end.
-	int fixedSection = _parentDocument->find(SECTION_DIVIDER).selectionEnd();
+	int fixedSection = getFixedSectionEnd();
 
 	//Create the header format.
 	QTextBlockFormat headerFormat;
@@ -354,6 +360,13 @@ QString& GLSLPipelineAdapter::validatePlainText(QString& plainText, bool keepLen
 		.remove(GLSLDocument::editableEnd);
 }
 
+int GLSLPipelineAdapter::getFixedSectionEnd() const
+{
+	//The first section divider marks the end of the fixed section.
+	int sectionDivider = _tagIndex->findNext(SectionDivider);
+	return sectionDivider >= 0 ? sectionDivider + _tagIndex->getTagLength(SectionDivider) : -1;
+}
+
 void GLSLPipelineAdapter::addCheck(IGLSLPipelineCheck* pipelineCheck) { _pipelineChecks.append(pipelineCheck); }
 void GLSLPipelineAdapter::removeCheck(IGLSLPipelineCheck* pipelineCheck) { _pipelineChecks.removeOne(pipelineCheck); }
 
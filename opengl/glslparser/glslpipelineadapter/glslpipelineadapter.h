@@ -40,6 +40,7 @@ namespace ysm
 	class GLSLCodeBlock;
 
 	class GLSLVaoDeclarationCheck;
+	class GLSLTagIndex;
 
 	//! \brief Brigde between a GLSL document and the quiGLy pipeline.
 	//! This class uses the parsed GLSL code to match the statements to existing pipeline items, create the fixed
@@ -152,8 +153,26 @@ namespace ysm
 		 */
 		bool checkBlockEditingPermission(QTextCursor textCursor);
 
+	protected:
+
+		/*!
+		 * \brief Returns the fixed section's end position using the tag index.
+		 * \return The fixed section's end or -1, if the document has no fixed section.
+		 */
+		int getFixedSectionEnd() const;
+
 	private:
 
+		//! \brief Tags that are watched by the tag index.
+		enum Tag
+		{
+			EditableStart,
+			EditableEnd,
+			EditableBlockStart,
+			EditableBlockEnd,
+			SectionDivider,
+		};
+
 		//! \brief The connected shader block.
 		IBlock* _pipelineBlock;
 
@@ -163,14 +182,8 @@ namespace ysm
 		//! \brief Checks executed to match code to pipeline.
 		QList<IGLSLPipelineCheck*> _pipelineChecks;
 
-		//! \brief Stores all available single line editable sections inside the fixed section.
-		QList<QPair<int, int>> _editableSingleSections;
-
-		//! \brief Stores all available multi line editable sections inside the fixed section.
-		QList<QPair<int, int>> _editableMultiSections;
-
-		//! \brief Latest fixed section ending.
-		int _latestFixedSection;
+		//! \brief Index of all section and editing tags inside the document.
+		GLSLTagIndex* _tagIndex;
 
 		//! \brief Checks that need to be adjusted.
 		GLSLVaoDeclarationCheck* _vaoCheck;
@@ -0,0 +1,138 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "glsltagindex.h"
+
+#include <QTextDocument>
+#include <QTextCursor>
+
+#include <algorithm>
+
+using namespace ysm;
+
+GLSLTagIndex::GLSLTagIndex(QTextDocument* document, const QStringList& tags) :
+	QObject(document),
+	_document(document),
+	_tags(tags),
+	_maxTagLength(1),
+	_positions(tags.size())
+{
+	//Find the longest tag, which defines how far a change can affect surrounding tags.
+	foreach(QString tag, _tags)
+		_maxTagLength = qMax(_maxTagLength, tag.length());
+
+	//Watch the document's content and build the initial index.
+	connect(_document, &QTextDocument::contentsChange, this, &GLSLTagIndex::updateIndex);
+	rebuild();
+}
+
+int GLSLTagIndex::getDocumentLength() const { return qMax(0, _document->characterCount() - 1); }
+int GLSLTagIndex::getTagLength(int tag) const { return _tags[tag].length(); }
+
+int GLSLTagIndex::findNext(int tag, int position) const
+{
+	//Binary search for the first occurrence at or behind the position.
+	const QVector<int>& positions = _positions[tag];
+	QVector<int>::const_iterator next = std::lower_bound(positions.constBegin(), positions.constEnd(), position);
+	return next != positions.constEnd() ? *next : -1;
+}
+
+bool GLSLTagIndex::isTagAt(int tag, int position) const { return findNext(tag, position) == position; }
+
+bool GLSLTagIndex::containsTag(int tag, int from, int to) const
+{
+	//The first occurrence behind the range's start must also end inside the range.
+	int next = findNext(tag, from);
+	return next >= 0 && next + getTagLength(tag) <= to;
+}
+
+void GLSLTagIndex::rebuild()
+{
+	//Clear all positions and scan the whole document.
+	for(int tag = 0; tag < _positions.size(); tag++)
+		_positions[tag].clear();
+
+	int documentLength = getDocumentLength();
+	scanRange(0, documentLength, documentLength);
+}
+
+void GLSLTagIndex::updateIndex(int position, int charsRemoved, int charsAdded)
+{
+	//Any tag starting up to one tag length in front of the change might have been modified.
+	int affectedStart = qMax(0, position - _maxTagLength + 1);
+	int delta = charsAdded - charsRemoved;
+
+	for(int tag = 0; tag < _positions.size(); tag++)
+	{
+		QVector<int>& positions = _positions[tag];
+
+		//Drop all occurrences starting inside the affected range (using the old positions).
+		QVector<int>::iterator first = std::lower_bound(positions.begin(), positions.end(), affectedStart);
+		QVector<int>::iterator last = std::lower_bound(first, positions.end(), position + charsRemoved);
+		int firstIndex = first - positions.begin();
+		positions.erase(first, last);
+
+		//Shift all following occurrences, they were not touched by the change.
+		if(delta)
+			for(int i = firstIndex; i < positions.size(); i++)
+				positions[i] += delta;
+	}
+
+	//Re-scan the changed range including the surrounding tag margin. Occurrences starting behind the change were kept
+	//and must not be added twice.
+	int affectedEnd = qMin(getDocumentLength(), position + charsAdded + _maxTagLength - 1);
+	scanRange(affectedStart, affectedEnd, position + charsAdded);
+}
+
+void GLSLTagIndex::scanRange(int from, int to, int limit)
+{
+	//Nothing to do on empty ranges.
+	if(from >= to) return;
+
+	//Select the range. Tags never span multiple lines, so the paragraph separators do not matter.
+	QTextCursor rangeCursor(_document);
+	rangeCursor.setPosition(from, QTextCursor::MoveAnchor);
+	rangeCursor.setPosition(to, QTextCursor::KeepAnchor);
+	QString rangeText = rangeCursor.selectedText();
+
+	for(int tag = 0; tag < _tags.size(); tag++)
+	{
+		//Collect all occurrences in ascending order.
+		QVector<int> found;
+		for(int index = rangeText.indexOf(_tags[tag]); index >= 0 && from + index < limit;
+			index = rangeText.indexOf(_tags[tag], index + _tags[tag].length()))
+			found.append(from + index);
+
+		//The range is free of indexed occurrences, so insert them as one sorted run.
+		if(!found.isEmpty())
+		{
+			QVector<int>& positions = _positions[tag];
+			int insertIndex = std::lower_bound(positions.begin(), positions.end(), from) - positions.begin();
+			for(int i = 0; i < found.size(); i++)
+				positions.insert(insertIndex + i, found[i]);
+		}
+	}
+}
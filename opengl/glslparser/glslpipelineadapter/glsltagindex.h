@@ -0,0 +1,134 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef GLSLTAGINDEX_H
+#define GLSLTAGINDEX_H
+
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+
+class QTextDocument;
+
+namespace ysm
+{
+	//! \brief Sorted index of all marker tag positions inside a text document.
+	//! The index is updated incrementally from the document's change notifications, so that the pipeline adapter can
+	//! look up fixed and editable sections using binary search instead of searching the whole document.
+	class GLSLTagIndex : public QObject
+	{
+		Q_OBJECT
+
+	public:
+
+		/*!
+		 * \brief Initialize new instance.
+		 * \param document The document to watch.
+		 * \param tags The tags to index, queries use the tag's list index.
+		 */
+		GLSLTagIndex(QTextDocument* document, const QStringList& tags);
+
+		/*!
+		 * \brief Returns the length of the given tag.
+		 * \param tag The tag's index.
+		 * \return The tag's length.
+		 */
+		int getTagLength(int tag) const;
+
+		/*!
+		 * \brief Finds the first occurrence of the given tag starting at or behind the given position.
+		 * \param tag The tag's index.
+		 * \param position The position to start at.
+		 * \return The occurrence's start position or -1, if there is none.
+		 */
+		int findNext(int tag, int position = 0) const;
+
+		/*!
+		 * \brief Checks whether an occurrence of the given tag starts at the given position.
+		 * \param tag The tag's index.
+		 * \param position The position.
+		 * \return True, if the tag starts at the position.
+		 */
+		bool isTagAt(int tag, int position) const;
+
+		/*!
+		 * \brief Checks whether an occurrence of the given tag lies completely inside the given range.
+		 * \param tag The tag's index.
+		 * \param from The range's start (inclusive).
+		 * \param to The range's end (exclusive).
+		 * \return True, if the range contains the tag.
+		 */
+		bool containsTag(int tag, int from, int to) const;
+
+	public slots:
+
+		//! \brief Rebuild the index by scanning the whole document.
+		void rebuild();
+
+	protected slots:
+
+		/*!
+		 * \brief Update the index after the document's content changed.
+		 * \param position The position of the change.
+		 * \param charsRemoved The number of removed characters.
+		 * \param charsAdded The number of added characters.
+		 */
+		void updateIndex(int position, int charsRemoved, int charsAdded);
+
+	protected:
+
+		/*!
+		 * \brief Scans the given document range and inserts all found tags that start in front of the given limit.
+		 * \param from The range's start.
+		 * \param to The range's end.
+		 * \param limit Only occurrences starting in front of this position are added.
+		 */
+		void scanRange(int from, int to, int limit);
+
+		/*!
+		 * \brief Returns the document's length, excluding the final paragraph separator.
+		 * \return The document's length.
+		 */
+		int getDocumentLength() const;
+
+	private:
+
+		//! \brief The watched document.
+		QTextDocument* _document;
+
+		//! \brief The indexed tags.
+		QStringList _tags;
+
+		//! \brief The length of the longest tag.
+		int _maxTagLength;
+
+		//! \brief Sorted start positions of all occurrences, per tag.
+		QVector<QVector<int>> _positions;
+	};
+
+}
+
+#endif // GLSLTAGINDEX_H
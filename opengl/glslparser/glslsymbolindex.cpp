@@ -0,0 +1,149 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "glslsymbolindex.h"
+#include "glslcodeblock.h"
+#include "glslstatements/glsldeclaration.h"
+
+#include <QSet>
+
+using namespace ysm;
+
+GLSLSymbolIndex::GLSLSymbolIndex() :
+	_rootBlock(NULL)
+{
+}
+
+void GLSLSymbolIndex::rebuild(GLSLCodeBlock* rootBlock)
+{
+	//Drop the old tables and index the new tree.
+	clear();
+	_rootBlock = rootBlock;
+	indexBlock(rootBlock);
+}
+
+void GLSLSymbolIndex::clear()
+{
+	_rootBlock = NULL;
+	_localScopes.clear();
+	_globalScope = Scope();
+}
+
+GLSLCodeBlock* GLSLSymbolIndex::getRootBlock() const { return _rootBlock; }
+
+void GLSLSymbolIndex::indexBlock(GLSLCodeBlock* codeBlock)
+{
+	//Ensure the block exists.
+	if(!codeBlock) return;
+
+	//Sort the block's declarations into the local and global tables.
+	Scope& localScope = _localScopes[codeBlock];
+	foreach(GLSLDeclaration* declaration, codeBlock->getStatements<GLSLDeclaration>(GLSLStatementType::Declaration))
+	{
+		if(isLocalSymbol(declaration))
+			addSymbol(localScope, declaration);
+		else if(isGlobalSymbol(declaration))
+			addSymbol(_globalScope, declaration);
+	}
+
+	//Index all children.
+	foreach(GLSLCodeBlock* childBlock, codeBlock->getChildBlocks())
+		indexBlock(childBlock);
+}
+
+void GLSLSymbolIndex::collectLocalScope(GLSLCodeBlock* codeBlock, Scope& scope)
+{
+	foreach(GLSLDeclaration* declaration, codeBlock->getStatements<GLSLDeclaration>(GLSLStatementType::Declaration))
+		if(isLocalSymbol(declaration))
+			addSymbol(scope, declaration);
+}
+
+void GLSLSymbolIndex::addSymbol(Scope& scope, GLSLDeclaration* declaration)
+{
+	//The first declaration of a name wins.
+	if(scope.symbols.contains(declaration->getName()))
+		return;
+
+	scope.symbols.insert(declaration->getName(), declaration);
+	scope.declarations.append(declaration);
+}
+
+bool GLSLSymbolIndex::isLocalSymbol(GLSLDeclaration* declaration)
+{
+	//Do not add global scope or invalid declarations.
+	return !declaration->isGlobalScope() && declaration->getGLSLErrors().isEmpty();
+}
+
+bool GLSLSymbolIndex::isGlobalSymbol(GLSLDeclaration* declaration)
+{
+	//Do not add local scope declarations.
+	if(!declaration->isGlobalScope())
+		return false;
+
+	//Do not add instance declarations, they are contained because of their structural declaration.
+	if(declaration->getStructureDeclaration())
+		return false;
+
+	//Do not add structural declarations without instance declarations. Their members are accessed directly.
+	if(declaration->getDataType().isEmpty() && !declaration->getInstanceDeclaration())
+		return false;
+
+	//Do not add invalid declarations.
+	return declaration->getGLSLErrors().isEmpty();
+}
+
+QList<GLSLDeclaration*> GLSLSymbolIndex::getVisibleDeclarations(GLSLCodeBlock* codeBlock) const
+{
+	QList<GLSLDeclaration*> declarations;
+	QSet<QString> names;
+
+	//Walk from the innermost scope to the root, hidden names are skipped.
+	for(GLSLCodeBlock* scopeBlock = codeBlock; scopeBlock; scopeBlock = scopeBlock->getParentBlock())
+	{
+		//Blocks of a tree that has not been indexed yet are collected on the fly.
+		Scope unindexedScope;
+		QHash<const GLSLCodeBlock*, Scope>::const_iterator it = _localScopes.constFind(scopeBlock);
+		if(it == _localScopes.constEnd())
+			collectLocalScope(scopeBlock, unindexedScope);
+		const Scope& scope = it != _localScopes.constEnd() ? it.value() : unindexedScope;
+
+		foreach(GLSLDeclaration* declaration, scope.declarations)
+			if(!names.contains(declaration->getName()))
+			{
+				names.insert(declaration->getName());
+				declarations.append(declaration);
+			}
+	}
+
+	//Add the global declarations last.
+	foreach(GLSLDeclaration* declaration, _globalScope.declarations)
+		if(!names.contains(declaration->getName()))
+		{
+			names.insert(declaration->getName());
+			declarations.append(declaration);
+		}
+
+	return declarations;
+}
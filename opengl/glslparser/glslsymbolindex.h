@@ -0,0 +1,134 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef GLSLSYMBOLINDEX_H
+#define GLSLSYMBOLINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+namespace ysm
+{
+	class GLSLCodeBlock;
+	class GLSLDeclaration;
+
+	//! \brief Hashed symbol tables for all scopes of a parsed GLSL document.
+	//! The index mirrors the code block tree: every block holds the local declarations made inside of it and the root
+	//! additionally holds the global declarations. Visible declarations are collected by walking from a block up to
+	//! the root, so the cost depends on the nesting depth and not on the size of the document.
+	class GLSLSymbolIndex
+	{
+
+	public:
+
+		//! \brief Initialize new instance.
+		GLSLSymbolIndex();
+
+		/*!
+		 * \brief Rebuilds the index from the given root block.
+		 * \param rootBlock The document's root block, can be NULL.
+		 */
+		void rebuild(GLSLCodeBlock* rootBlock);
+
+		//! \brief Removes all indexed declarations.
+		void clear();
+
+		/*!
+		 * \brief Returns the root block the index was built from.
+		 * \return The root block.
+		 */
+		GLSLCodeBlock* getRootBlock() const;
+
+		/*!
+		 * \brief Returns all declarations visible in the given code block.
+		 * Declarations of the innermost scope come first and hide equally named declarations of outer scopes. Global
+		 * declarations come last.
+		 * \param codeBlock The code block, can be NULL to get the global declarations only.
+		 * \return The visible declarations.
+		 */
+		QList<GLSLDeclaration*> getVisibleDeclarations(GLSLCodeBlock* codeBlock) const;
+
+	private:
+
+		//! \brief The symbol table of a single scope.
+		struct Scope
+		{
+			//! \brief The declarations in order of appearance.
+			QList<GLSLDeclaration*> declarations;
+
+			//! \brief The declarations mapped to their names.
+			QHash<QString, GLSLDeclaration*> symbols;
+		};
+
+		/*!
+		 * \brief Recursively adds the declarations of the given block and its children.
+		 * \param codeBlock The code block.
+		 */
+		void indexBlock(GLSLCodeBlock* codeBlock);
+
+		/*!
+		 * \brief Collects the local declarations of a block that is not part of the index.
+		 * \param codeBlock The code block.
+		 * \param scope The scope to fill.
+		 */
+		static void collectLocalScope(GLSLCodeBlock* codeBlock, Scope& scope);
+
+		/*!
+		 * \brief Adds the declaration to the scope, unless the name is already declared there.
+		 * \param scope The scope.
+		 * \param declaration The declaration.
+		 */
+		static void addSymbol(Scope& scope, GLSLDeclaration* declaration);
+
+		/*!
+		 * \brief Checks, if the declaration is a valid local declaration.
+		 * \param declaration The declaration.
+		 * \return True, if the declaration is offered in its local scope.
+		 */
+		static bool isLocalSymbol(GLSLDeclaration* declaration);
+
+		/*!
+		 * \brief Checks, if the declaration is a valid global declaration.
+		 * \param declaration The declaration.
+		 * \return True, if the declaration is offered globally.
+		 */
+		static bool isGlobalSymbol(GLSLDeclaration* declaration);
+
+	private:
+
+		//! \brief The root block the index was built from.
+		GLSLCodeBlock* _rootBlock;
+
+		//! \brief The local scopes mapped to their blocks.
+		QHash<const GLSLCodeBlock*, Scope> _localScopes;
+
+		//! \brief The global scope.
+		Scope _globalScope;
+	};
+
+}
+
+#endif // GLSLSYMBOLINDEX_H
@@ -0,0 +1,396 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "gltrace.h"
+
+#include <QOpenGLFunctions_4_3_Core>
+
+#include <cstring>
+
+namespace ysm
+{
+
+namespace
+{
+	// Must be in the order of GLTraceCommand
+	const GLTraceCommandInfo CommandInfos[] =
+	{
+		{ "Context",						"i",			nullptr,				0 },
+		{ "Frame",							"Fii",			nullptr,				0 },
+		{ "DefineProgram",					"p",			nullptr,				0 },
+		{ "UseProgram",						"p",			"Program",				0 },
+		{ "SetUniforms",					"p",			nullptr,				0 },
+
+		{ "glGenBuffers",					"N",			nullptr,				0 },
+		{ "glDeleteBuffers",				"N",			nullptr,				0 },
+		{ "glGenTextures",					"N",			nullptr,				0 },
+		{ "glDeleteTextures",				"N",			nullptr,				0 },
+		{ "glGenSamplers",					"N",			nullptr,				0 },
+		{ "glDeleteSamplers",				"N",			nullptr,				0 },
+		{ "glGenRenderbuffers",				"N",			nullptr,				0 },
+		{ "glDeleteRenderbuffers",			"N",			nullptr,				0 },
+		{ "glGenFramebuffers",				"N",			nullptr,				0 },
+		{ "glDeleteFramebuffers",			"N",			nullptr,				0 },
+		{ "glGenVertexArrays",				"N",			nullptr,				0 },
+		{ "glDeleteVertexArrays",			"N",			nullptr,				0 },
+		{ "glFenceSync",					"yii",			nullptr,				0 },
+		{ "glClientWaitSync",				"yii",			nullptr,				0 },
+		{ "glDeleteSync",					"y",			nullptr,				0 },
+
+		{ "glActiveTexture",				"i",			"ActiveTexture",		0 },
+		{ "glBindBuffer",					"ib",			"BindBuffer",			1 },
+		{ "glBindBufferBase",				"iib",			"BindBufferBase",		2 },
+		{ "glBindFramebuffer",				"iF",			"BindFramebuffer",		1 },
+		{ "glBindRenderbuffer",				"ir",			"BindRenderbuffer",		1 },
+		{ "glBindSampler",					"is",			"BindSampler",			1 },
+		{ "glBindTexture",					"it",			"BindTexture",			1 },
+		{ "glBindVertexArray",				"v",			"BindVertexArray",		0 },
+
+		{ "glEnable",						"i",			"Capability",			1 },
+		{ "glDisable",						"i",			"Capability",			1 },
+		{ "glBlendEquation",				"i",			"BlendEquation",		0 },
+		{ "glBlendFuncSeparate",			"iiii",			"BlendFunc",			0 },
+		{ "glClearColor",					"ffff",			"ClearColor",			0 },
+		{ "glClearDepth",					"d",			"ClearDepth",			0 },
+		{ "glClearStencil",					"i",			"ClearStencil",			0 },
+		{ "glColorMask",					"iiii",			"ColorMask",			0 },
+		{ "glCullFace",						"i",			"CullFace",				0 },
+		{ "glDepthFunc",					"i",			"DepthFunc",			0 },
+		{ "glDepthMask",					"i",			"DepthMask",			0 },
+		{ "glFrontFace",					"i",			"FrontFace",			0 },
+		{ "glLineWidth",					"f",			"LineWidth",			0 },
+		{ "glPointSize",					"f",			"PointSize",			0 },
+		{ "glPolygonMode",					"ii",			"PolygonMode",			1 },
+		{ "glPixelStorei",					"ii",			"PixelStore",			1 },
+		{ "glScissor",						"iiii",			"Scissor",				0 },
+		{ "glViewport",						"iiii",			"Viewport",				0 },
+		{ "glStencilFunc",					"iii",			"StencilFunc",			0 },
+		{ "glStencilFuncSeparate",			"iiii",			"StencilFuncSeparate",	1 },
+		{ "glStencilOpSeparate",			"iiii",			"StencilOpSeparate",	1 },
+		{ "glDrawBuffer",					"i",			nullptr,				0 },
+		{ "glDrawBuffers",					"iP",			nullptr,				0 },
+		{ "glPatchParameteri",				"ii",			"PatchParameter",		1 },
+		{ "glPatchParameterfv",				"iP",			nullptr,				0 },
+
+		{ "glEnableVertexAttribArray",		"i",			nullptr,				0 },
+		{ "glVertexAttribPointer",			"iiiiio",		nullptr,				0 },
+		{ "glVertexAttribDivisor",			"ii",			nullptr,				0 },
+
+		{ "glTexParameteri",				"iii",			nullptr,				0 },
+		{ "glTexParameterf",				"iif",			nullptr,				0 },
+		{ "glTexParameteriv",				"iiP",			nullptr,				0 },
+		{ "glTexParameterfv",				"iiP",			nullptr,				0 },
+		{ "glSamplerParameteri",			"sii",			"SamplerParameter",		2 },
+		{ "glSamplerParameterf",			"sif",			"SamplerParameter",		2 },
+		{ "glSamplerParameterfv",			"siP",			nullptr,				0 },
+
+		{ "glBufferData",					"iiPi",			nullptr,				0 },
+		{ "glCopyBufferSubData",			"iiiii",		nullptr,				0 },
+		{ "glTexBuffer",					"iib",			nullptr,				0 },
+		{ "glTexImage1D",					"iiiiiiiP",		nullptr,				0 },
+		{ "glTexImage2D",					"iiiiiiiiP",	nullptr,				0 },
+		{ "glTexImage3D",					"iiiiiiiiiP",	nullptr,				0 },
+		{ "glTexImage2DMultisample",		"iiiiii",		nullptr,				0 },
+		{ "glTexSubImage1D",				"iiiiiiP",		nullptr,				0 },
+		{ "glTexSubImage2D",				"iiiiiiiiP",	nullptr,				0 },
+		{ "glTexSubImage3D",				"iiiiiiiiiiP",	nullptr,				0 },
+		{ "glCompressedTexSubImage1D",		"iiiiiiP",		nullptr,				0 },
+		{ "glCompressedTexSubImage2D",		"iiiiiiiiP",	nullptr,				0 },
+		{ "glCompressedTexSubImage3D",		"iiiiiiiiiiP",	nullptr,				0 },
+		{ "glTexStorage1D",					"iiii",			nullptr,				0 },
+		{ "glTexStorage2D",					"iiiii",		nullptr,				0 },
+		{ "glTexStorage3D",					"iiiiii",		nullptr,				0 },
+		{ "glTextureView",					"titiiiii",		nullptr,				0 },
+		{ "glGenerateMipmap",				"i",			nullptr,				0 },
+		{ "glRenderbufferStorage",			"iiii",			nullptr,				0 },
+		{ "glFramebufferRenderbuffer",		"iiir",			nullptr,				0 },
+		{ "glFramebufferTexture",			"iiti",			nullptr,				0 },
+		{ "glFramebufferTexture2D",			"iiiti",		nullptr,				0 },
+		{ "glFramebufferTextureLayer",		"iitii",		nullptr,				0 },
+
+		{ "glClear",						"i",			nullptr,				0 },
+		{ "glDrawArrays",					"iii",			nullptr,				0 },
+		{ "glDrawArraysInstanced",			"iiii",			nullptr,				0 },
+		{ "glDrawElements",					"iiiP",			nullptr,				0 },
+		{ "glDrawElementsInstanced",		"iiiPi",		nullptr,				0 },
+		{ "glMultiDrawArraysIndirect",		"ioii",			nullptr,				0 },
+		{ "glMultiDrawElementsIndirect",	"iioii",		nullptr,				0 },
+		{ "glBeginTransformFeedback",		"i",			nullptr,				0 },
+		{ "glEndTransformFeedback",			"",				nullptr,				0 }
+	};
+
+	static_assert(sizeof(CommandInfos) / sizeof(CommandInfos[0]) == static_cast<size_t>(GLTraceCommand::CommandCount),
+				  "Every trace command needs a description");
+
+	struct UniformLayout
+	{
+		GLenum type;
+		GLTrace::UniformKind kind;
+		int components;
+	};
+
+	const UniformLayout UniformLayouts[] =
+	{
+		{ GL_FLOAT,									GLTrace::UniformKind_Float,		1 },
+		{ GL_FLOAT_VEC2,							GLTrace::UniformKind_Float,		2 },
+		{ GL_FLOAT_VEC3,							GLTrace::UniformKind_Float,		3 },
+		{ GL_FLOAT_VEC4,							GLTrace::UniformKind_Float,		4 },
+		{ GL_INT,									GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_VEC2,								GLTrace::UniformKind_Int,		2 },
+		{ GL_INT_VEC3,								GLTrace::UniformKind_Int,		3 },
+		{ GL_INT_VEC4,								GLTrace::UniformKind_Int,		4 },
+		{ GL_UNSIGNED_INT,							GLTrace::UniformKind_UInt,		1 },
+		{ GL_UNSIGNED_INT_VEC2,						GLTrace::UniformKind_UInt,		2 },
+		{ GL_UNSIGNED_INT_VEC3,						GLTrace::UniformKind_UInt,		3 },
+		{ GL_UNSIGNED_INT_VEC4,						GLTrace::UniformKind_UInt,		4 },
+		{ GL_BOOL,									GLTrace::UniformKind_Int,		1 },
+		{ GL_BOOL_VEC2,								GLTrace::UniformKind_Int,		2 },
+		{ GL_BOOL_VEC3,								GLTrace::UniformKind_Int,		3 },
+		{ GL_BOOL_VEC4,								GLTrace::UniformKind_Int,		4 },
+		{ GL_FLOAT_MAT2,							GLTrace::UniformKind_Matrix,	4 },
+		{ GL_FLOAT_MAT3,							GLTrace::UniformKind_Matrix,	9 },
+		{ GL_FLOAT_MAT4,							GLTrace::UniformKind_Matrix,	16 },
+		{ GL_FLOAT_MAT2x3,							GLTrace::UniformKind_Matrix,	6 },
+		{ GL_FLOAT_MAT2x4,							GLTrace::UniformKind_Matrix,	8 },
+		{ GL_FLOAT_MAT3x2,							GLTrace::UniformKind_Matrix,	6 },
+		{ GL_FLOAT_MAT3x4,							GLTrace::UniformKind_Matrix,	12 },
+		{ GL_FLOAT_MAT4x2,							GLTrace::UniformKind_Matrix,	8 },
+		{ GL_FLOAT_MAT4x3,							GLTrace::UniformKind_Matrix,	12 },
+
+		// Samplers and images are set by their unit
+		{ GL_SAMPLER_1D,							GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_2D,							GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_3D,							GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_CUBE,							GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_1D_SHADOW,						GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_2D_SHADOW,						GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_1D_ARRAY,						GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_2D_ARRAY,						GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_1D_ARRAY_SHADOW,				GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_2D_ARRAY_SHADOW,				GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_2D_MULTISAMPLE,				GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_2D_MULTISAMPLE_ARRAY,			GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_CUBE_SHADOW,					GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_CUBE_MAP_ARRAY,				GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_CUBE_MAP_ARRAY_SHADOW,			GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_BUFFER,						GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_2D_RECT,						GLTrace::UniformKind_Int,		1 },
+		{ GL_SAMPLER_2D_RECT_SHADOW,				GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_SAMPLER_1D,						GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_SAMPLER_2D,						GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_SAMPLER_3D,						GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_SAMPLER_CUBE,						GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_SAMPLER_1D_ARRAY,					GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_SAMPLER_2D_ARRAY,					GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_SAMPLER_2D_MULTISAMPLE,			GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY,		GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_SAMPLER_CUBE_MAP_ARRAY,			GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_SAMPLER_BUFFER,					GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_SAMPLER_2D_RECT,					GLTrace::UniformKind_Int,		1 },
+		{ GL_UNSIGNED_INT_SAMPLER_1D,				GLTrace::UniformKind_Int,		1 },
+		{ GL_UNSIGNED_INT_SAMPLER_2D,				GLTrace::UniformKind_Int,		1 },
+		{ GL_UNSIGNED_INT_SAMPLER_3D,				GLTrace::UniformKind_Int,		1 },
+		{ GL_UNSIGNED_INT_SAMPLER_CUBE,				GLTrace::UniformKind_Int,		1 },
+		{ GL_UNSIGNED_INT_SAMPLER_1D_ARRAY,			GLTrace::UniformKind_Int,		1 },
+		{ GL_UNSIGNED_INT_SAMPLER_2D_ARRAY,			GLTrace::UniformKind_Int,		1 },
+		{ GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE,	GLTrace::UniformKind_Int,		1 },
+		{ GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY, GLTrace::UniformKind_Int,	1 },
+		{ GL_UNSIGNED_INT_SAMPLER_CUBE_MAP_ARRAY,	GLTrace::UniformKind_Int,		1 },
+		{ GL_UNSIGNED_INT_SAMPLER_BUFFER,			GLTrace::UniformKind_Int,		1 },
+		{ GL_UNSIGNED_INT_SAMPLER_2D_RECT,			GLTrace::UniformKind_Int,		1 },
+		{ GL_IMAGE_1D,								GLTrace::UniformKind_Int,		1 },
+		{ GL_IMAGE_2D,								GLTrace::UniformKind_Int,		1 },
+		{ GL_IMAGE_3D,								GLTrace::UniformKind_Int,		1 },
+		{ GL_IMAGE_CUBE,							GLTrace::UniformKind_Int,		1 },
+		{ GL_IMAGE_1D_ARRAY,						GLTrace::UniformKind_Int,		1 },
+		{ GL_IMAGE_2D_ARRAY,						GLTrace::UniformKind_Int,		1 },
+		{ GL_IMAGE_BUFFER,							GLTrace::UniformKind_Int,		1 },
+		{ GL_INT_IMAGE_2D,							GLTrace::UniformKind_Int,		1 },
+		{ GL_UNSIGNED_INT_IMAGE_2D,					GLTrace::UniformKind_Int,		1 },
+		{ GL_UNSIGNED_INT_ATOMIC_COUNTER,			GLTrace::UniformKind_Int,		1 }
+	};
+}
+
+const GLTraceCommandInfo& GLTrace::getCommandInfo(GLTraceCommand command)
+{
+	Q_ASSERT(command < GLTraceCommand::CommandCount);
+	return CommandInfos[static_cast<int>(command)];
+}
+
+int GLTrace::getPixelSize(GLenum format, GLenum type)
+{
+	// Packed types store a whole pixel
+	switch(type)
+	{
+	case GL_UNSIGNED_BYTE_3_3_2:
+	case GL_UNSIGNED_BYTE_2_3_3_REV:
+		return 1;
+	case GL_UNSIGNED_SHORT_5_6_5:
+	case GL_UNSIGNED_SHORT_5_6_5_REV:
+	case GL_UNSIGNED_SHORT_4_4_4_4:
+	case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+	case GL_UNSIGNED_SHORT_5_5_5_1:
+	case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+		return 2;
+	case GL_UNSIGNED_INT_8_8_8_8:
+	case GL_UNSIGNED_INT_8_8_8_8_REV:
+	case GL_UNSIGNED_INT_10_10_10_2:
+	case GL_UNSIGNED_INT_2_10_10_10_REV:
+	case GL_UNSIGNED_INT_24_8:
+	case GL_UNSIGNED_INT_10F_11F_11F_REV:
+	case GL_UNSIGNED_INT_5_9_9_9_REV:
+		return 4;
+	case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+		return 8;
+	default:
+		break;
+	}
+
+	int componentSize = 0;
+	switch(type)
+	{
+	case GL_UNSIGNED_BYTE:
+	case GL_BYTE:
+		componentSize = 1;
+		break;
+	case GL_UNSIGNED_SHORT:
+	case GL_SHORT:
+	case GL_HALF_FLOAT:
+		componentSize = 2;
+		break;
+	case GL_UNSIGNED_INT:
+	case GL_INT:
+	case GL_FLOAT:
+		componentSize = 4;
+		break;
+	default:
+		return 0;
+	}
+
+	switch(format)
+	{
+	case GL_RED:
+	case GL_RED_INTEGER:
+	case GL_GREEN:
+	case GL_BLUE:
+	case GL_DEPTH_COMPONENT:
+	case GL_STENCIL_INDEX:
+		return componentSize;
+	case GL_RG:
+	case GL_RG_INTEGER:
+	case GL_DEPTH_STENCIL:
+		return 2 * componentSize;
+	case GL_RGB:
+	case GL_BGR:
+	case GL_RGB_INTEGER:
+	case GL_BGR_INTEGER:
+		return 3 * componentSize;
+	case GL_RGBA:
+	case GL_BGRA:
+	case GL_RGBA_INTEGER:
+	case GL_BGRA_INTEGER:
+		return 4 * componentSize;
+	default:
+		return 0;
+	}
+}
+
+int GLTrace::getParameterCount(GLenum pname)
+{
+	switch(pname)
+	{
+	case GL_TEXTURE_SWIZZLE_RGBA:
+	case GL_TEXTURE_BORDER_COLOR:
+	case GL_PATCH_DEFAULT_OUTER_LEVEL:
+		return 4;
+	case GL_PATCH_DEFAULT_INNER_LEVEL:
+		return 2;
+	default:
+		return 1;
+	}
+}
+
+int GLTrace::getIndexSize(GLenum type)
+{
+	switch(type)
+	{
+	case GL_UNSIGNED_BYTE:	return 1;
+	case GL_UNSIGNED_SHORT:	return 2;
+	case GL_UNSIGNED_INT:	return 4;
+	default:				return 0;
+	}
+}
+
+bool GLTrace::getUniformLayout(GLenum type, UniformKind& kind, int& components)
+{
+	for(const UniformLayout& layout : UniformLayouts)
+	{
+		if(layout.type == type)
+		{
+			kind = layout.kind;
+			components = layout.components;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+quint64 GLTrace::encode(float value)
+{
+	quint32 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+quint64 GLTrace::encode(double value)
+{
+	quint64 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+quint64 GLTrace::encodePointer(const void* pointer)
+{
+	return reinterpret_cast<quintptr>(pointer);
+}
+
+float GLTrace::decodeFloat(quint64 value)
+{
+	quint32 bits = quint32(value);
+	float result;
+	std::memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+double GLTrace::decodeDouble(quint64 value)
+{
+	double result;
+	std::memcpy(&result, &value, sizeof(result));
+	return result;
+}
+
+}
@@ -0,0 +1,243 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef GLTRACE_H
+#define GLTRACE_H
+
+#include <QtGlobal>
+#include <QOpenGLContext>
+
+namespace ysm
+{
+
+	/**
+	 * @brief The recorded commands of a GL trace.
+	 * Besides the traced OpenGL calls, a trace contains a few synthetic commands describing things not issued through
+	 * the traced functions, like the current context, frames and shader programs. The values are stored in trace files,
+	 * so new commands must only be appended.
+	 */
+	enum class GLTraceCommand : quint16
+	{
+		// Synthetic commands
+		Context,				/*!< The following commands are issued in another context. */
+		Frame,					/*!< A frame is rendered into the given default framebuffer. */
+		DefineProgram,			/*!< A program is (re-)linked from the shaders and settings in the payload. */
+		UseProgram,				/*!< The current program changes. */
+		SetUniforms,			/*!< The uniforms of the current program change to the values in the payload. */
+
+		// Objects
+		GenBuffers,
+		DeleteBuffers,
+		GenTextures,
+		DeleteTextures,
+		GenSamplers,
+		DeleteSamplers,
+		GenRenderbuffers,
+		DeleteRenderbuffers,
+		GenFramebuffers,
+		DeleteFramebuffers,
+		GenVertexArrays,
+		DeleteVertexArrays,
+		FenceSync,
+		ClientWaitSync,
+		DeleteSync,
+
+		// Bindings
+		ActiveTexture,
+		BindBuffer,
+		BindBufferBase,
+		BindFramebuffer,
+		BindRenderbuffer,
+		BindSampler,
+		BindTexture,
+		BindVertexArray,
+
+		// Fixed function state
+		Enable,
+		Disable,
+		BlendEquation,
+		BlendFuncSeparate,
+		ClearColor,
+		ClearDepth,
+		ClearStencil,
+		ColorMask,
+		CullFace,
+		DepthFunc,
+		DepthMask,
+		FrontFace,
+		LineWidth,
+		PointSize,
+		PolygonMode,
+		PixelStorei,
+		Scissor,
+		Viewport,
+		StencilFunc,
+		StencilFuncSeparate,
+		StencilOpSeparate,
+		DrawBuffer,
+		DrawBuffers,
+		PatchParameteri,
+		PatchParameterfv,
+
+		// Vertex arrays
+		EnableVertexAttribArray,
+		VertexAttribPointer,
+		VertexAttribDivisor,
+
+		// Texture and sampler parameters
+		TexParameteri,
+		TexParameterf,
+		TexParameteriv,
+		TexParameterfv,
+		SamplerParameteri,
+		SamplerParameterf,
+		SamplerParameterfv,
+
+		// Storage and data
+		BufferData,
+		CopyBufferSubData,
+		TexBuffer,
+		TexImage1D,
+		TexImage2D,
+		TexImage3D,
+		TexImage2DMultisample,
+		TexSubImage1D,
+		TexSubImage2D,
+		TexSubImage3D,
+		CompressedTexSubImage1D,
+		CompressedTexSubImage2D,
+		CompressedTexSubImage3D,
+		TexStorage1D,
+		TexStorage2D,
+		TexStorage3D,
+		TextureView,
+		GenerateMipmap,
+		RenderbufferStorage,
+		FramebufferRenderbuffer,
+		FramebufferTexture,
+		FramebufferTexture2D,
+		FramebufferTextureLayer,
+
+		// Drawing
+		Clear,
+		DrawArrays,
+		DrawArraysInstanced,
+		DrawElements,
+		DrawElementsInstanced,
+		MultiDrawArraysIndirect,
+		MultiDrawElementsIndirect,
+		BeginTransformFeedback,
+		EndTransformFeedback,
+
+		CommandCount
+	};
+
+	/**
+	 * @brief Static description of a trace command.
+	 * The arguments are described by one character each:
+	 * i - integer or enum, f - float, d - double, o - offset into a bound buffer,
+	 * P - client data, stored in the payload, or an offset into a bound buffer, if there is no payload,
+	 * N - number of object names, stored in the payload,
+	 * b - buffer, t - texture, s - sampler, r - renderbuffer, F - framebuffer, v - vertex array, p - program, y - sync.
+	 */
+	struct GLTraceCommandInfo
+	{
+		const char* name;		/*!< Name of the OpenGL function. */
+		const char* arguments;	/*!< Kinds of the arguments. */
+		const char* state;		/*!< The state set by the command, or null if the command doesn't set any state. */
+		int keyArguments;		/*!< Number of leading arguments selecting the part of the state being set. */
+	};
+
+	/**
+	 * @brief The GLTrace class defines the binary format of GL traces.
+	 * A trace starts with a header of the magic number and the format version. It is followed by records of a command,
+	 * its arguments and an optional payload, all stored in little endian:
+	 * quint16 command, quint8 argument count, quint64 arguments, quint32 payload size, payload.
+	 * Integers are stored sign extended, floats and doubles by their bits.
+	 */
+	class GLTrace
+	{
+	public:
+
+		static const quint32 MAGIC = 0x544C4751;	/*!< "QGLT" */
+		static const quint16 VERSION = 1;			/*!< Version of the format. */
+
+		/// @brief How the values of a uniform are read and set
+		enum UniformKind
+		{
+			UniformKind_Float,
+			UniformKind_Int,
+			UniformKind_UInt,
+			UniformKind_Matrix
+		};
+
+	public:
+
+		/// @brief Returns the description of the given command.
+		static const GLTraceCommandInfo& getCommandInfo(GLTraceCommand command);
+
+		/// @brief Returns the size of the pixels of the given transfer format and type in bytes, or 0 if they are unknown.
+		static int getPixelSize(GLenum format, GLenum type);
+
+		/// @brief Returns the number of values passed to the vector versions of the parameter setters for the given parameter.
+		static int getParameterCount(GLenum pname);
+
+		/// @brief Returns the size of indices of the given type in bytes, or 0 if it is unknown.
+		static int getIndexSize(GLenum type);
+
+		/**
+		 * @brief getUniformLayout	Returns how uniforms of the given type are stored.
+		 * Double precision uniforms are not supported.
+		 * @param type				The type of the uniform, as returned by glGetActiveUniform
+		 * @param kind				Receives how the values are read and set
+		 * @param components		Receives the number of values per element
+		 * @return					False, if the type isn't supported
+		 */
+		static bool getUniformLayout(GLenum type, UniformKind& kind, int& components);
+
+		/// @brief Encodes an integer argument.
+		template<typename T>
+		static quint64 encode(T value) { return quint64(qint64(value)); }
+
+		/// @brief Encodes a float argument.
+		static quint64 encode(float value);
+
+		/// @brief Encodes a double argument.
+		static quint64 encode(double value);
+
+		/// @brief Encodes an offset into a bound buffer or a sync object.
+		static quint64 encodePointer(const void* pointer);
+
+		/// @brief Decodes a float argument.
+		static float decodeFloat(quint64 value);
+
+		/// @brief Decodes a double argument.
+		static double decodeDouble(quint64 value);
+	};
+
+}
+
+#endif // GLTRACE_H
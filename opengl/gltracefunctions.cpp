@@ -0,0 +1,796 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "gltracefunctions.h"
+#include "gltracerecorder.h"
+
+#include <QHash>
+
+#include <type_traits>
+
+namespace ysm
+{
+
+namespace
+{
+	// The functions objects of all contexts
+	QHash<QOpenGLContext*, GLTraceFunctions*>& getInstances()
+	{
+		static QHash<QOpenGLContext*, GLTraceFunctions*> instances;
+		return instances;
+	}
+
+	// Encodes an argument depending on its type
+	template<typename T>
+	typename std::enable_if<std::is_integral<T>::value, quint64>::type argument(T value)
+	{
+		return GLTrace::encode(value);
+	}
+
+	quint64 argument(GLfloat value)
+	{
+		return GLTrace::encode(value);
+	}
+
+	quint64 argument(GLdouble value)
+	{
+		return GLTrace::encode(value);
+	}
+
+	quint64 argument(const void* value)
+	{
+		return GLTrace::encodePointer(value);
+	}
+}
+
+GLTraceFunctions::GLTraceFunctions(QOpenGLContext* context)
+	: _context(context),
+	  _functions_4_0(context->versionFunctions<QOpenGLFunctions_4_0_Core>()),
+	  _functions_4_2(context->versionFunctions<QOpenGLFunctions_4_2_Core>()),
+	  _functions_4_3(context->versionFunctions<QOpenGLFunctions_4_3_Core>())
+{
+}
+
+GLTraceFunctions* GLTraceFunctions::forContext(QOpenGLContext* context)
+{
+	if(!context)
+		return nullptr;
+
+	QHash<QOpenGLContext*, GLTraceFunctions*>& instances = getInstances();
+	auto it = instances.find(context);
+	if(it != instances.end())
+		return it.value();
+
+	// Resolving the functions needs the context to be current
+	if(context != QOpenGLContext::currentContext())
+		return nullptr;
+
+	GLTraceFunctions* functions = new GLTraceFunctions(context);
+	if(!functions->initializeOpenGLFunctions())
+	{
+		delete functions;
+		return nullptr;
+	}
+
+	instances.insert(context, functions);
+	QObject::connect(context, &QOpenGLContext::aboutToBeDestroyed, [context]() {
+		delete getInstances().take(context);
+	});
+
+	return functions;
+}
+
+QOpenGLContext* GLTraceFunctions::getContext() const
+{
+	return _context;
+}
+
+bool GLTraceFunctions::hasVersion(int major, int minor) const
+{
+	return _context->format().version() >= qMakePair(major, minor);
+}
+
+bool GLTraceFunctions::isRecording() const
+{
+	return GLTraceRecorder::getActive() != nullptr;
+}
+
+void GLTraceFunctions::record(GLTraceCommand command, std::initializer_list<quint64> arguments, const void* payload, qint64 payloadSize)
+{
+	if(GLTraceRecorder* recorder = GLTraceRecorder::getActive())
+		recorder->record(this, command, arguments, payload, payloadSize);
+}
+
+GLTraceFunctions::Payload GLTraceFunctions::getPayload(GLenum binding, const void* pointer, qint64 size)
+{
+	// A pointer is an offset, if a buffer is bound
+	GLint buffer = 0;
+	if(binding != GL_NONE)
+		QOpenGLFunctions_3_3_Core::glGetIntegerv(binding, &buffer);
+
+	if(buffer)
+		return Payload{GLTrace::encodePointer(pointer), nullptr, 0};
+
+	// Data of unknown size is replayed as null
+	if(pointer && size > 0)
+		return Payload{0, pointer, size};
+
+	return Payload{0, nullptr, 0};
+}
+
+qint64 GLTraceFunctions::getImageSize(int dimensions, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type)
+{
+	const int pixelSize = GLTrace::getPixelSize(format, type);
+	if(!pixelSize || width <= 0 || height <= 0 || depth <= 0)
+		return 0;
+
+	GLint alignment = 4, rowLength = 0, imageHeight = 0, skipPixels = 0, skipRows = 0, skipImages = 0;
+	QOpenGLFunctions_3_3_Core::glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+	QOpenGLFunctions_3_3_Core::glGetIntegerv(GL_UNPACK_ROW_LENGTH, &rowLength);
+	QOpenGLFunctions_3_3_Core::glGetIntegerv(GL_UNPACK_IMAGE_HEIGHT, &imageHeight);
+	QOpenGLFunctions_3_3_Core::glGetIntegerv(GL_UNPACK_SKIP_PIXELS, &skipPixels);
+	QOpenGLFunctions_3_3_Core::glGetIntegerv(GL_UNPACK_SKIP_ROWS, &skipRows);
+	QOpenGLFunctions_3_3_Core::glGetIntegerv(GL_UNPACK_SKIP_IMAGES, &skipImages);
+
+	// Rows are padded to the alignment, except for the last one
+	const qint64 rowSize = (qint64(rowLength > 0 ? rowLength : width) * pixelSize + alignment - 1) / alignment * alignment;
+	const qint64 imageSize = rowSize * (imageHeight > 0 ? imageHeight : height);
+
+	qint64 size = qint64(skipPixels + width) * pixelSize;
+	if(dimensions > 1)
+		size += (skipRows + height - 1) * rowSize;
+	if(dimensions > 2)
+		size += (skipImages + depth - 1) * imageSize;
+
+	return size;
+}
+
+// Objects
+
+void GLTraceFunctions::glGenBuffers(GLsizei n, GLuint* buffers)
+{
+	QOpenGLFunctions_3_3_Core::glGenBuffers(n, buffers);
+	record(GLTraceCommand::GenBuffers, {argument(n)}, buffers, n * sizeof(GLuint));
+}
+
+void GLTraceFunctions::glDeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+	QOpenGLFunctions_3_3_Core::glDeleteBuffers(n, buffers);
+	record(GLTraceCommand::DeleteBuffers, {argument(n)}, buffers, n * sizeof(GLuint));
+}
+
+void GLTraceFunctions::glGenTextures(GLsizei n, GLuint* textures)
+{
+	QOpenGLFunctions_3_3_Core::glGenTextures(n, textures);
+	record(GLTraceCommand::GenTextures, {argument(n)}, textures, n * sizeof(GLuint));
+}
+
+void GLTraceFunctions::glDeleteTextures(GLsizei n, const GLuint* textures)
+{
+	QOpenGLFunctions_3_3_Core::glDeleteTextures(n, textures);
+	record(GLTraceCommand::DeleteTextures, {argument(n)}, textures, n * sizeof(GLuint));
+}
+
+void GLTraceFunctions::glGenSamplers(GLsizei count, GLuint* samplers)
+{
+	QOpenGLFunctions_3_3_Core::glGenSamplers(count, samplers);
+	record(GLTraceCommand::GenSamplers, {argument(count)}, samplers, count * sizeof(GLuint));
+}
+
+void GLTraceFunctions::glDeleteSamplers(GLsizei count, const GLuint* samplers)
+{
+	QOpenGLFunctions_3_3_Core::glDeleteSamplers(count, samplers);
+	record(GLTraceCommand::DeleteSamplers, {argument(count)}, samplers, count * sizeof(GLuint));
+}
+
+void GLTraceFunctions::glGenRenderbuffers(GLsizei n, GLuint* renderbuffers)
+{
+	QOpenGLFunctions_3_3_Core::glGenRenderbuffers(n, renderbuffers);
+	record(GLTraceCommand::GenRenderbuffers, {argument(n)}, renderbuffers, n * sizeof(GLuint));
+}
+
+void GLTraceFunctions::glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers)
+{
+	QOpenGLFunctions_3_3_Core::glDeleteRenderbuffers(n, renderbuffers);
+	record(GLTraceCommand::DeleteRenderbuffers, {argument(n)}, renderbuffers, n * sizeof(GLuint));
+}
+
+void GLTraceFunctions::glGenFramebuffers(GLsizei n, GLuint* framebuffers)
+{
+	QOpenGLFunctions_3_3_Core::glGenFramebuffers(n, framebuffers);
+	record(GLTraceCommand::GenFramebuffers, {argument(n)}, framebuffers, n * sizeof(GLuint));
+}
+
+void GLTraceFunctions::glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+{
+	QOpenGLFunctions_3_3_Core::glDeleteFramebuffers(n, framebuffers);
+	record(GLTraceCommand::DeleteFramebuffers, {argument(n)}, framebuffers, n * sizeof(GLuint));
+}
+
+void GLTraceFunctions::glGenVertexArrays(GLsizei n, GLuint* arrays)
+{
+	QOpenGLFunctions_3_3_Core::glGenVertexArrays(n, arrays);
+	record(GLTraceCommand::GenVertexArrays, {argument(n)}, arrays, n * sizeof(GLuint));
+}
+
+void GLTraceFunctions::glDeleteVertexArrays(GLsizei n, const GLuint* arrays)
+{
+	QOpenGLFunctions_3_3_Core::glDeleteVertexArrays(n, arrays);
+	record(GLTraceCommand::DeleteVertexArrays, {argument(n)}, arrays, n * sizeof(GLuint));
+}
+
+GLsync GLTraceFunctions::glFenceSync(GLenum condition, GLbitfield flags)
+{
+	GLsync sync = QOpenGLFunctions_3_3_Core::glFenceSync(condition, flags);
+	record(GLTraceCommand::FenceSync, {argument(sync), argument(condition), argument(flags)});
+	return sync;
+}
+
+GLenum GLTraceFunctions::glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+	GLenum result = QOpenGLFunctions_3_3_Core::glClientWaitSync(sync, flags, timeout);
+	record(GLTraceCommand::ClientWaitSync, {argument(sync), argument(flags), argument(timeout)});
+	return result;
+}
+
+void GLTraceFunctions::glDeleteSync(GLsync sync)
+{
+	QOpenGLFunctions_3_3_Core::glDeleteSync(sync);
+	record(GLTraceCommand::DeleteSync, {argument(sync)});
+}
+
+// Bindings
+
+void GLTraceFunctions::glActiveTexture(GLenum texture)
+{
+	QOpenGLFunctions_3_3_Core::glActiveTexture(texture);
+	record(GLTraceCommand::ActiveTexture, {argument(texture)});
+}
+
+void GLTraceFunctions::glBindBuffer(GLenum target, GLuint buffer)
+{
+	QOpenGLFunctions_3_3_Core::glBindBuffer(target, buffer);
+	record(GLTraceCommand::BindBuffer, {argument(target), argument(buffer)});
+}
+
+void GLTraceFunctions::glBindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+	QOpenGLFunctions_3_3_Core::glBindBufferBase(target, index, buffer);
+	record(GLTraceCommand::BindBufferBase, {argument(target), argument(index), argument(buffer)});
+}
+
+void GLTraceFunctions::glBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+	QOpenGLFunctions_3_3_Core::glBindFramebuffer(target, framebuffer);
+	record(GLTraceCommand::BindFramebuffer, {argument(target), argument(framebuffer)});
+}
+
+void GLTraceFunctions::glBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+	QOpenGLFunctions_3_3_Core::glBindRenderbuffer(target, renderbuffer);
+	record(GLTraceCommand::BindRenderbuffer, {argument(target), argument(renderbuffer)});
+}
+
+void GLTraceFunctions::glBindSampler(GLuint unit, GLuint sampler)
+{
+	QOpenGLFunctions_3_3_Core::glBindSampler(unit, sampler);
+	record(GLTraceCommand::BindSampler, {argument(unit), argument(sampler)});
+}
+
+void GLTraceFunctions::glBindTexture(GLenum target, GLuint texture)
+{
+	QOpenGLFunctions_3_3_Core::glBindTexture(target, texture);
+	record(GLTraceCommand::BindTexture, {argument(target), argument(texture)});
+}
+
+void GLTraceFunctions::glBindVertexArray(GLuint array)
+{
+	QOpenGLFunctions_3_3_Core::glBindVertexArray(array);
+	record(GLTraceCommand::BindVertexArray, {argument(array)});
+}
+
+// Fixed function state
+
+void GLTraceFunctions::glEnable(GLenum cap)
+{
+	QOpenGLFunctions_3_3_Core::glEnable(cap);
+	record(GLTraceCommand::Enable, {argument(cap)});
+}
+
+void GLTraceFunctions::glDisable(GLenum cap)
+{
+	QOpenGLFunctions_3_3_Core::glDisable(cap);
+	record(GLTraceCommand::Disable, {argument(cap)});
+}
+
+void GLTraceFunctions::glBlendEquation(GLenum mode)
+{
+	QOpenGLFunctions_3_3_Core::glBlendEquation(mode);
+	record(GLTraceCommand::BlendEquation, {argument(mode)});
+}
+
+void GLTraceFunctions::glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha)
+{
+	QOpenGLFunctions_3_3_Core::glBlendFuncSeparate(sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha);
+	record(GLTraceCommand::BlendFuncSeparate, {argument(sfactorRGB), argument(dfactorRGB), argument(sfactorAlpha), argument(dfactorAlpha)});
+}
+
+void GLTraceFunctions::glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+	QOpenGLFunctions_3_3_Core::glClearColor(red, green, blue, alpha);
+	record(GLTraceCommand::ClearColor, {argument(red), argument(green), argument(blue), argument(alpha)});
+}
+
+void GLTraceFunctions::glClearDepth(GLdouble depth)
+{
+	QOpenGLFunctions_3_3_Core::glClearDepth(depth);
+	record(GLTraceCommand::ClearDepth, {argument(depth)});
+}
+
+void GLTraceFunctions::glClearStencil(GLint s)
+{
+	QOpenGLFunctions_3_3_Core::glClearStencil(s);
+	record(GLTraceCommand::ClearStencil, {argument(s)});
+}
+
+void GLTraceFunctions::glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+{
+	QOpenGLFunctions_3_3_Core::glColorMask(red, green, blue, alpha);
+	record(GLTraceCommand::ColorMask, {argument(red), argument(green), argument(blue), argument(alpha)});
+}
+
+void GLTraceFunctions::glCullFace(GLenum mode)
+{
+	QOpenGLFunctions_3_3_Core::glCullFace(mode);
+	record(GLTraceCommand::CullFace, {argument(mode)});
+}
+
+void GLTraceFunctions::glDepthFunc(GLenum func)
+{
+	QOpenGLFunctions_3_3_Core::glDepthFunc(func);
+	record(GLTraceCommand::DepthFunc, {argument(func)});
+}
+
+void GLTraceFunctions::glDepthMask(GLboolean flag)
+{
+	QOpenGLFunctions_3_3_Core::glDepthMask(flag);
+	record(GLTraceCommand::DepthMask, {argument(flag)});
+}
+
+void GLTraceFunctions::glFrontFace(GLenum mode)
+{
+	QOpenGLFunctions_3_3_Core::glFrontFace(mode);
+	record(GLTraceCommand::FrontFace, {argument(mode)});
+}
+
+void GLTraceFunctions::glLineWidth(GLfloat width)
+{
+	QOpenGLFunctions_3_3_Core::glLineWidth(width);
+	record(GLTraceCommand::LineWidth, {argument(width)});
+}
+
+void GLTraceFunctions::glPointSize(GLfloat size)
+{
+	QOpenGLFunctions_3_3_Core::glPointSize(size);
+	record(GLTraceCommand::PointSize, {argument(size)});
+}
+
+void GLTraceFunctions::glPolygonMode(GLenum face, GLenum mode)
+{
+	QOpenGLFunctions_3_3_Core::glPolygonMode(face, mode);
+	record(GLTraceCommand::PolygonMode, {argument(face), argument(mode)});
+}
+
+void GLTraceFunctions::glPixelStorei(GLenum pname, GLint param)
+{
+	QOpenGLFunctions_3_3_Core::glPixelStorei(pname, param);
+	record(GLTraceCommand::PixelStorei, {argument(pname), argument(param)});
+}
+
+void GLTraceFunctions::glScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	QOpenGLFunctions_3_3_Core::glScissor(x, y, width, height);
+	record(GLTraceCommand::Scissor, {argument(x), argument(y), argument(width), argument(height)});
+}
+
+void GLTraceFunctions::glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	QOpenGLFunctions_3_3_Core::glViewport(x, y, width, height);
+	record(GLTraceCommand::Viewport, {argument(x), argument(y), argument(width), argument(height)});
+}
+
+void GLTraceFunctions::glStencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+	QOpenGLFunctions_3_3_Core::glStencilFunc(func, ref, mask);
+	record(GLTraceCommand::StencilFunc, {argument(func), argument(ref), argument(mask)});
+}
+
+void GLTraceFunctions::glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask)
+{
+	QOpenGLFunctions_3_3_Core::glStencilFuncSeparate(face, func, ref, mask);
+	record(GLTraceCommand::StencilFuncSeparate, {argument(face), argument(func), argument(ref), argument(mask)});
+}
+
+void GLTraceFunctions::glStencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)
+{
+	QOpenGLFunctions_3_3_Core::glStencilOpSeparate(face, sfail, dpfail, dppass);
+	record(GLTraceCommand::StencilOpSeparate, {argument(face), argument(sfail), argument(dpfail), argument(dppass)});
+}
+
+void GLTraceFunctions::glDrawBuffer(GLenum mode)
+{
+	QOpenGLFunctions_3_3_Core::glDrawBuffer(mode);
+	record(GLTraceCommand::DrawBuffer, {argument(mode)});
+}
+
+void GLTraceFunctions::glDrawBuffers(GLsizei n, const GLenum* bufs)
+{
+	QOpenGLFunctions_3_3_Core::glDrawBuffers(n, bufs);
+	record(GLTraceCommand::DrawBuffers, {argument(n), 0}, bufs, n * sizeof(GLenum));
+}
+
+void GLTraceFunctions::glPatchParameteri(GLenum pname, GLint value)
+{
+	Q_ASSERT(_functions_4_0);
+	_functions_4_0->glPatchParameteri(pname, value);
+	record(GLTraceCommand::PatchParameteri, {argument(pname), argument(value)});
+}
+
+void GLTraceFunctions::glPatchParameterfv(GLenum pname, const GLfloat* values)
+{
+	Q_ASSERT(_functions_4_0);
+	_functions_4_0->glPatchParameterfv(pname, values);
+	record(GLTraceCommand::PatchParameterfv, {argument(pname), 0}, values, GLTrace::getParameterCount(pname) * sizeof(GLfloat));
+}
+
+// Vertex arrays
+
+void GLTraceFunctions::glEnableVertexAttribArray(GLuint index)
+{
+	QOpenGLFunctions_3_3_Core::glEnableVertexAttribArray(index);
+	record(GLTraceCommand::EnableVertexAttribArray, {argument(index)});
+}
+
+void GLTraceFunctions::glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* pointer)
+{
+	QOpenGLFunctions_3_3_Core::glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+	record(GLTraceCommand::VertexAttribPointer, {argument(index), argument(size), argument(type), argument(normalized), argument(stride), argument(pointer)});
+}
+
+void GLTraceFunctions::glVertexAttribDivisor(GLuint index, GLuint divisor)
+{
+	QOpenGLFunctions_3_3_Core::glVertexAttribDivisor(index, divisor);
+	record(GLTraceCommand::VertexAttribDivisor, {argument(index), argument(divisor)});
+}
+
+// Texture and sampler parameters
+
+void GLTraceFunctions::glTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+	QOpenGLFunctions_3_3_Core::glTexParameteri(target, pname, param);
+	record(GLTraceCommand::TexParameteri, {argument(target), argument(pname), argument(param)});
+}
+
+void GLTraceFunctions::glTexParameterf(GLenum target, GLenum pname, GLfloat param)
+{
+	QOpenGLFunctions_3_3_Core::glTexParameterf(target, pname, param);
+	record(GLTraceCommand::TexParameterf, {argument(target), argument(pname), argument(param)});
+}
+
+void GLTraceFunctions::glTexParameteriv(GLenum target, GLenum pname, const GLint* params)
+{
+	QOpenGLFunctions_3_3_Core::glTexParameteriv(target, pname, params);
+	record(GLTraceCommand::TexParameteriv, {argument(target), argument(pname), 0}, params, GLTrace::getParameterCount(pname) * sizeof(GLint));
+}
+
+void GLTraceFunctions::glTexParameterfv(GLenum target, GLenum pname, const GLfloat* params)
+{
+	QOpenGLFunctions_3_3_Core::glTexParameterfv(target, pname, params);
+	record(GLTraceCommand::TexParameterfv, {argument(target), argument(pname), 0}, params, GLTrace::getParameterCount(pname) * sizeof(GLfloat));
+}
+
+void GLTraceFunctions::glSamplerParameteri(GLuint sampler, GLenum pname, GLint param)
+{
+	QOpenGLFunctions_3_3_Core::glSamplerParameteri(sampler, pname, param);
+	record(GLTraceCommand::SamplerParameteri, {argument(sampler), argument(pname), argument(param)});
+}
+
+void GLTraceFunctions::glSamplerParameterf(GLuint sampler, GLenum pname, GLfloat param)
+{
+	QOpenGLFunctions_3_3_Core::glSamplerParameterf(sampler, pname, param);
+	record(GLTraceCommand::SamplerParameterf, {argument(sampler), argument(pname), argument(param)});
+}
+
+void GLTraceFunctions::glSamplerParameterfv(GLuint sampler, GLenum pname, const GLfloat* param)
+{
+	QOpenGLFunctions_3_3_Core::glSamplerParameterfv(sampler, pname, param);
+	record(GLTraceCommand::SamplerParameterfv, {argument(sampler), argument(pname), 0}, param, GLTrace::getParameterCount(pname) * sizeof(GLfloat));
+}
+
+// Storage and data
+
+void GLTraceFunctions::glBufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage)
+{
+	QOpenGLFunctions_3_3_Core::glBufferData(target, size, data, usage);
+	record(GLTraceCommand::BufferData, {argument(target), argument(size), 0, argument(usage)}, data, data ? size : 0);
+}
+
+void GLTraceFunctions::glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)
+{
+	QOpenGLFunctions_3_3_Core::glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+	record(GLTraceCommand::CopyBufferSubData, {argument(readTarget), argument(writeTarget), argument(readOffset), argument(writeOffset), argument(size)});
+}
+
+void GLTraceFunctions::glTexBuffer(GLenum target, GLenum internalformat, GLuint buffer)
+{
+	QOpenGLFunctions_3_3_Core::glTexBuffer(target, internalformat, buffer);
+	record(GLTraceCommand::TexBuffer, {argument(target), argument(internalformat), argument(buffer)});
+}
+
+void GLTraceFunctions::glTexImage1D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const GLvoid* pixels)
+{
+	QOpenGLFunctions_3_3_Core::glTexImage1D(target, level, internalformat, width, border, format, type, pixels);
+	if(isRecording())
+	{
+		Payload payload = getPayload(GL_PIXEL_UNPACK_BUFFER_BINDING, pixels, getImageSize(1, width, 1, 1, format, type));
+		record(GLTraceCommand::TexImage1D, {argument(target), argument(level), argument(internalformat), argument(width), argument(border),
+											argument(format), argument(type), payload.argument}, payload.data, payload.size);
+	}
+}
+
+void GLTraceFunctions::glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels)
+{
+	QOpenGLFunctions_3_3_Core::glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+	if(isRecording())
+	{
+		Payload payload = getPayload(GL_PIXEL_UNPACK_BUFFER_BINDING, pixels, getImageSize(2, width, height, 1, format, type));
+		record(GLTraceCommand::TexImage2D, {argument(target), argument(level), argument(internalformat), argument(width), argument(height),
+											argument(border), argument(format), argument(type), payload.argument}, payload.data, payload.size);
+	}
+}
+
+void GLTraceFunctions::glTexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const GLvoid* pixels)
+{
+	QOpenGLFunctions_3_3_Core::glTexImage3D(target, level, internalformat, width, height, depth, border, format, type, pixels);
+	if(isRecording())
+	{
+		Payload payload = getPayload(GL_PIXEL_UNPACK_BUFFER_BINDING, pixels, getImageSize(3, width, height, depth, format, type));
+		record(GLTraceCommand::TexImage3D, {argument(target), argument(level), argument(internalformat), argument(width), argument(height),
+											argument(depth), argument(border), argument(format), argument(type), payload.argument},
+			   payload.data, payload.size);
+	}
+}
+
+void GLTraceFunctions::glTexImage2DMultisample(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations)
+{
+	QOpenGLFunctions_3_3_Core::glTexImage2DMultisample(target, samples, internalformat, width, height, fixedsamplelocations);
+	record(GLTraceCommand::TexImage2DMultisample, {argument(target), argument(samples), argument(internalformat), argument(width),
+												   argument(height), argument(fixedsamplelocations)});
+}
+
+void GLTraceFunctions::glTexSubImage1D(GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const GLvoid* pixels)
+{
+	QOpenGLFunctions_3_3_Core::glTexSubImage1D(target, level, xoffset, width, format, type, pixels);
+	if(isRecording())
+	{
+		Payload payload = getPayload(GL_PIXEL_UNPACK_BUFFER_BINDING, pixels, getImageSize(1, width, 1, 1, format, type));
+		record(GLTraceCommand::TexSubImage1D, {argument(target), argument(level), argument(xoffset), argument(width), argument(format),
+											   argument(type), payload.argument}, payload.data, payload.size);
+	}
+}
+
+void GLTraceFunctions::glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels)
+{
+	QOpenGLFunctions_3_3_Core::glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+	if(isRecording())
+	{
+		Payload payload = getPayload(GL_PIXEL_UNPACK_BUFFER_BINDING, pixels, getImageSize(2, width, height, 1, format, type));
+		record(GLTraceCommand::TexSubImage2D, {argument(target), argument(level), argument(xoffset), argument(yoffset), argument(width),
+											   argument(height), argument(format), argument(type), payload.argument}, payload.data, payload.size);
+	}
+}
+
+void GLTraceFunctions::glTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const GLvoid* pixels)
+{
+	QOpenGLFunctions_3_3_Core::glTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+	if(isRecording())
+	{
+		Payload payload = getPayload(GL_PIXEL_UNPACK_BUFFER_BINDING, pixels, getImageSize(3, width, height, depth, format, type));
+		record(GLTraceCommand::TexSubImage3D, {argument(target), argument(level), argument(xoffset), argument(yoffset), argument(zoffset),
+											   argument(width), argument(height), argument(depth), argument(format), argument(type),
+											   payload.argument}, payload.data, payload.size);
+	}
+}
+
+void GLTraceFunctions::glCompressedTexSubImage1D(GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const GLvoid* data)
+{
+	QOpenGLFunctions_3_3_Core::glCompressedTexSubImage1D(target, level, xoffset, width, format, imageSize, data);
+	if(isRecording())
+	{
+		Payload payload = getPayload(GL_PIXEL_UNPACK_BUFFER_BINDING, data, imageSize);
+		record(GLTraceCommand::CompressedTexSubImage1D, {argument(target), argument(level), argument(xoffset), argument(width), argument(format),
+														 argument(imageSize), payload.argument}, payload.data, payload.size);
+	}
+}
+
+void GLTraceFunctions::glCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const GLvoid* data)
+{
+	QOpenGLFunctions_3_3_Core::glCompressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, imageSize, data);
+	if(isRecording())
+	{
+		Payload payload = getPayload(GL_PIXEL_UNPACK_BUFFER_BINDING, data, imageSize);
+		record(GLTraceCommand::CompressedTexSubImage2D, {argument(target), argument(level), argument(xoffset), argument(yoffset), argument(width),
+														 argument(height), argument(format), argument(imageSize), payload.argument},
+			   payload.data, payload.size);
+	}
+}
+
+void GLTraceFunctions::glCompressedTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const GLvoid* data)
+{
+	QOpenGLFunctions_3_3_Core::glCompressedTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data);
+	if(isRecording())
+	{
+		Payload payload = getPayload(GL_PIXEL_UNPACK_BUFFER_BINDING, data, imageSize);
+		record(GLTraceCommand::CompressedTexSubImage3D, {argument(target), argument(level), argument(xoffset), argument(yoffset), argument(zoffset),
+														 argument(width), argument(height), argument(depth), argument(format), argument(imageSize),
+														 payload.argument}, payload.data, payload.size);
+	}
+}
+
+void GLTraceFunctions::glTexStorage1D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width)
+{
+	Q_ASSERT(_functions_4_2);
+	_functions_4_2->glTexStorage1D(target, levels, internalformat, width);
+	record(GLTraceCommand::TexStorage1D, {argument(target), argument(levels), argument(internalformat), argument(width)});
+}
+
+void GLTraceFunctions::glTexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
+{
+	Q_ASSERT(_functions_4_2);
+	_functions_4_2->glTexStorage2D(target, levels, internalformat, width, height);
+	record(GLTraceCommand::TexStorage2D, {argument(target), argument(levels), argument(internalformat), argument(width), argument(height)});
+}
+
+void GLTraceFunctions::glTexStorage3D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)
+{
+	Q_ASSERT(_functions_4_2);
+	_functions_4_2->glTexStorage3D(target, levels, internalformat, width, height, depth);
+	record(GLTraceCommand::TexStorage3D, {argument(target), argument(levels), argument(internalformat), argument(width), argument(height),
+										  argument(depth)});
+}
+
+void GLTraceFunctions::glTextureView(GLuint texture, GLenum target, GLuint origtexture, GLenum internalformat, GLuint minlevel, GLuint numlevels, GLuint minlayer, GLuint numlayers)
+{
+	Q_ASSERT(_functions_4_3);
+	_functions_4_3->glTextureView(texture, target, origtexture, internalformat, minlevel, numlevels, minlayer, numlayers);
+	record(GLTraceCommand::TextureView, {argument(texture), argument(target), argument(origtexture), argument(internalformat), argument(minlevel),
+										 argument(numlevels), argument(minlayer), argument(numlayers)});
+}
+
+void GLTraceFunctions::glGenerateMipmap(GLenum target)
+{
+	QOpenGLFunctions_3_3_Core::glGenerateMipmap(target);
+	record(GLTraceCommand::GenerateMipmap, {argument(target)});
+}
+
+void GLTraceFunctions::glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+	QOpenGLFunctions_3_3_Core::glRenderbufferStorage(target, internalformat, width, height);
+	record(GLTraceCommand::RenderbufferStorage, {argument(target), argument(internalformat), argument(width), argument(height)});
+}
+
+void GLTraceFunctions::glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+	QOpenGLFunctions_3_3_Core::glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+	record(GLTraceCommand::FramebufferRenderbuffer, {argument(target), argument(attachment), argument(renderbuffertarget), argument(renderbuffer)});
+}
+
+void GLTraceFunctions::glFramebufferTexture(GLenum target, GLenum attachment, GLuint texture, GLint level)
+{
+	QOpenGLFunctions_3_3_Core::glFramebufferTexture(target, attachment, texture, level);
+	record(GLTraceCommand::FramebufferTexture, {argument(target), argument(attachment), argument(texture), argument(level)});
+}
+
+void GLTraceFunctions::glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+	QOpenGLFunctions_3_3_Core::glFramebufferTexture2D(target, attachment, textarget, texture, level);
+	record(GLTraceCommand::FramebufferTexture2D, {argument(target), argument(attachment), argument(textarget), argument(texture), argument(level)});
+}
+
+void GLTraceFunctions::glFramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer)
+{
+	QOpenGLFunctions_3_3_Core::glFramebufferTextureLayer(target, attachment, texture, level, layer);
+	record(GLTraceCommand::FramebufferTextureLayer, {argument(target), argument(attachment), argument(texture), argument(level), argument(layer)});
+}
+
+// Drawing
+
+void GLTraceFunctions::glClear(GLbitfield mask)
+{
+	QOpenGLFunctions_3_3_Core::glClear(mask);
+	record(GLTraceCommand::Clear, {argument(mask)});
+}
+
+void GLTraceFunctions::glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	QOpenGLFunctions_3_3_Core::glDrawArrays(mode, first, count);
+	record(GLTraceCommand::DrawArrays, {argument(mode), argument(first), argument(count)});
+}
+
+void GLTraceFunctions::glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount)
+{
+	QOpenGLFunctions_3_3_Core::glDrawArraysInstanced(mode, first, count, instancecount);
+	record(GLTraceCommand::DrawArraysInstanced, {argument(mode), argument(first), argument(count), argument(instancecount)});
+}
+
+void GLTraceFunctions::glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices)
+{
+	QOpenGLFunctions_3_3_Core::glDrawElements(mode, count, type, indices);
+	if(isRecording())
+	{
+		Payload payload = getPayload(GL_ELEMENT_ARRAY_BUFFER_BINDING, indices, qint64(count) * GLTrace::getIndexSize(type));
+		record(GLTraceCommand::DrawElements, {argument(mode), argument(count), argument(type), payload.argument}, payload.data, payload.size);
+	}
+}
+
+void GLTraceFunctions::glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instancecount)
+{
+	QOpenGLFunctions_3_3_Core::glDrawElementsInstanced(mode, count, type, indices, instancecount);
+	if(isRecording())
+	{
+		Payload payload = getPayload(GL_ELEMENT_ARRAY_BUFFER_BINDING, indices, qint64(count) * GLTrace::getIndexSize(type));
+		record(GLTraceCommand::DrawElementsInstanced, {argument(mode), argument(count), argument(type), payload.argument, argument(instancecount)},
+			   payload.data, payload.size);
+	}
+}
+
+void GLTraceFunctions::glMultiDrawArraysIndirect(GLenum mode, const void* indirect, GLsizei drawcount, GLsizei stride)
+{
+	Q_ASSERT(_functions_4_3);
+	_functions_4_3->glMultiDrawArraysIndirect(mode, indirect, drawcount, stride);
+	record(GLTraceCommand::MultiDrawArraysIndirect, {argument(mode), argument(indirect), argument(drawcount), argument(stride)});
+}
+
+void GLTraceFunctions::glMultiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride)
+{
+	Q_ASSERT(_functions_4_3);
+	_functions_4_3->glMultiDrawElementsIndirect(mode, type, indirect, drawcount, stride);
+	record(GLTraceCommand::MultiDrawElementsIndirect, {argument(mode), argument(type), argument(indirect), argument(drawcount), argument(stride)});
+}
+
+void GLTraceFunctions::glBeginTransformFeedback(GLenum primitiveMode)
+{
+	QOpenGLFunctions_3_3_Core::glBeginTransformFeedback(primitiveMode);
+	record(GLTraceCommand::BeginTransformFeedback, {argument(primitiveMode)});
+}
+
+void GLTraceFunctions::glEndTransformFeedback()
+{
+	QOpenGLFunctions_3_3_Core::glEndTransformFeedback();
+	record(GLTraceCommand::EndTransformFeedback, {});
+}
+
+}
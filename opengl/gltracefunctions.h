@@ -0,0 +1,215 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef GLTRACEFUNCTIONS_H
+#define GLTRACEFUNCTIONS_H
+
+#include "gltrace.h"
+
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLFunctions_4_0_Core>
+#include <QOpenGLFunctions_4_2_Core>
+#include <QOpenGLFunctions_4_3_Core>
+
+#include <initializer_list>
+
+namespace ysm
+{
+
+	/**
+	 * @brief The GLTraceFunctions class is the functions object used for rendering.
+	 * It hides the state changing functions of the core profile and passes each call on to the active GLTraceRecorder,
+	 * if there is one. Getters are not hidden and therefore never recorded. Without an active recorder, the overhead is
+	 * a single check per call.
+	 * It also provides the few functions of later versions used by quiGLy. These must only be called, if the context
+	 * supports them, which is checked by hasVersion().
+	 */
+	class GLTraceFunctions : public QOpenGLFunctions_3_3_Core
+	{
+	public:
+
+		/**
+		 * @brief forContext	Returns the functions object of the given context.
+		 * The object is created on first use and deleted together with the context.
+		 * @param context		The context, must be current for the first call
+		 * @return				The functions object, or null, if the context doesn't support OpenGL 3.3
+		 */
+		static GLTraceFunctions* forContext(QOpenGLContext* context);
+
+		/// @brief Returns the context the functions belong to.
+		QOpenGLContext* getContext() const;
+
+		/// @brief Returns true, if the context supports at least the given OpenGL version.
+		bool hasVersion(int major, int minor) const;
+
+	public:
+
+		// Objects
+		void glGenBuffers(GLsizei n, GLuint* buffers);
+		void glDeleteBuffers(GLsizei n, const GLuint* buffers);
+		void glGenTextures(GLsizei n, GLuint* textures);
+		void glDeleteTextures(GLsizei n, const GLuint* textures);
+		void glGenSamplers(GLsizei count, GLuint* samplers);
+		void glDeleteSamplers(GLsizei count, const GLuint* samplers);
+		void glGenRenderbuffers(GLsizei n, GLuint* renderbuffers);
+		void glDeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers);
+		void glGenFramebuffers(GLsizei n, GLuint* framebuffers);
+		void glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+		void glGenVertexArrays(GLsizei n, GLuint* arrays);
+		void glDeleteVertexArrays(GLsizei n, const GLuint* arrays);
+		GLsync glFenceSync(GLenum condition, GLbitfield flags);
+		GLenum glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout);
+		void glDeleteSync(GLsync sync);
+
+		// Bindings
+		void glActiveTexture(GLenum texture);
+		void glBindBuffer(GLenum target, GLuint buffer);
+		void glBindBufferBase(GLenum target, GLuint index, GLuint buffer);
+		void glBindFramebuffer(GLenum target, GLuint framebuffer);
+		void glBindRenderbuffer(GLenum target, GLuint renderbuffer);
+		void glBindSampler(GLuint unit, GLuint sampler);
+		void glBindTexture(GLenum target, GLuint texture);
+		void glBindVertexArray(GLuint array);
+
+		// Fixed function state
+		void glEnable(GLenum cap);
+		void glDisable(GLenum cap);
+		void glBlendEquation(GLenum mode);
+		void glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha);
+		void glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+		void glClearDepth(GLdouble depth);
+		void glClearStencil(GLint s);
+		void glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+		void glCullFace(GLenum mode);
+		void glDepthFunc(GLenum func);
+		void glDepthMask(GLboolean flag);
+		void glFrontFace(GLenum mode);
+		void glLineWidth(GLfloat width);
+		void glPointSize(GLfloat size);
+		void glPolygonMode(GLenum face, GLenum mode);
+		void glPixelStorei(GLenum pname, GLint param);
+		void glScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+		void glViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+		void glStencilFunc(GLenum func, GLint ref, GLuint mask);
+		void glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+		void glStencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass);
+		void glDrawBuffer(GLenum mode);
+		void glDrawBuffers(GLsizei n, const GLenum* bufs);
+		void glPatchParameteri(GLenum pname, GLint value);				/*!< Needs OpenGL 4.0 */
+		void glPatchParameterfv(GLenum pname, const GLfloat* values);	/*!< Needs OpenGL 4.0 */
+
+		// Vertex arrays
+		void glEnableVertexAttribArray(GLuint index);
+		void glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* pointer);
+		void glVertexAttribDivisor(GLuint index, GLuint divisor);
+
+		// Texture and sampler parameters
+		void glTexParameteri(GLenum target, GLenum pname, GLint param);
+		void glTexParameterf(GLenum target, GLenum pname, GLfloat param);
+		void glTexParameteriv(GLenum target, GLenum pname, const GLint* params);
+		void glTexParameterfv(GLenum target, GLenum pname, const GLfloat* params);
+		void glSamplerParameteri(GLuint sampler, GLenum pname, GLint param);
+		void glSamplerParameterf(GLuint sampler, GLenum pname, GLfloat param);
+		void glSamplerParameterfv(GLuint sampler, GLenum pname, const GLfloat* param);
+
+		// Storage and data
+		void glBufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage);
+		void glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size);
+		void glTexBuffer(GLenum target, GLenum internalformat, GLuint buffer);
+		void glTexImage1D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const GLvoid* pixels);
+		void glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels);
+		void glTexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const GLvoid* pixels);
+		void glTexImage2DMultisample(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations);
+		void glTexSubImage1D(GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const GLvoid* pixels);
+		void glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels);
+		void glTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const GLvoid* pixels);
+		void glCompressedTexSubImage1D(GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const GLvoid* data);
+		void glCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const GLvoid* data);
+		void glCompressedTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const GLvoid* data);
+		void glTexStorage1D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width);	/*!< Needs OpenGL 4.2 */
+		void glTexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);	/*!< Needs OpenGL 4.2 */
+		void glTexStorage3D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth);	/*!< Needs OpenGL 4.2 */
+		void glTextureView(GLuint texture, GLenum target, GLuint origtexture, GLenum internalformat, GLuint minlevel, GLuint numlevels, GLuint minlayer, GLuint numlayers);	/*!< Needs OpenGL 4.3 */
+		void glGenerateMipmap(GLenum target);
+		void glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+		void glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+		void glFramebufferTexture(GLenum target, GLenum attachment, GLuint texture, GLint level);
+		void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+		void glFramebufferTextureLayer(GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer);
+
+		// Drawing
+		void glClear(GLbitfield mask);
+		void glDrawArrays(GLenum mode, GLint first, GLsizei count);
+		void glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+		void glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices);
+		void glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei instancecount);
+		void glMultiDrawArraysIndirect(GLenum mode, const void* indirect, GLsizei drawcount, GLsizei stride);	/*!< Needs OpenGL 4.3 */
+		void glMultiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);	/*!< Needs OpenGL 4.3 */
+		void glBeginTransformFeedback(GLenum primitiveMode);
+		void glEndTransformFeedback();
+
+	private:
+
+		/// @brief Data passed by pointer, which is either stored in the trace or read from a bound buffer
+		struct Payload
+		{
+			quint64 argument;	/*!< The recorded pointer argument, which is an offset, if the data is read from a buffer. */
+			const void* data;	/*!< The data to store in the trace, if any. */
+			qint64 size;		/*!< Size of the stored data in bytes. */
+		};
+
+	private:
+
+		GLTraceFunctions(QOpenGLContext* context);
+
+		/// @brief Returns true, if calls are being recorded.
+		bool isRecording() const;
+
+		/// @brief Passes a call on to the active recorder, if there is one.
+		void record(GLTraceCommand command, std::initializer_list<quint64> arguments, const void* payload = nullptr, qint64 payloadSize = 0);
+
+		/**
+		 * @brief getPayload	Returns how data passed by pointer is recorded.
+		 * @param binding		The binding of the buffer the pointer refers to, if one is bound, or GL_NONE
+		 * @param pointer		The pointer passed to the call
+		 * @param size			The size of the data at the pointer in bytes, or 0, if it isn't known
+		 */
+		Payload getPayload(GLenum binding, const void* pointer, qint64 size);
+
+		/// @brief Returns the size of an image read with the current unpack state in bytes, or 0, if it isn't known.
+		qint64 getImageSize(int dimensions, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type);
+
+	private:
+
+		QOpenGLContext* _context;						/*!< The context the functions belong to. */
+		QOpenGLFunctions_4_0_Core* _functions_4_0;		/*!< Functions of OpenGL 4.0, or null if not supported. */
+		QOpenGLFunctions_4_2_Core* _functions_4_2;		/*!< Functions of OpenGL 4.2, or null if not supported. */
+		QOpenGLFunctions_4_3_Core* _functions_4_3;		/*!< Functions of OpenGL 4.3, or null if not supported. */
+	};
+
+}
+
+#endif // GLTRACEFUNCTIONS_H
@@ -0,0 +1,325 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "gltracerecorder.h"
+#include "gltracefunctions.h"
+
+#include <QVector>
+
+#include <stdexcept>
+
+namespace ysm
+{
+
+namespace
+{
+	// Reads a name of at most the given length through the given getter
+	template<typename Getter>
+	QByteArray readName(GLint maxLength, Getter getter)
+	{
+		QByteArray name(qMax(maxLength, 1), '\0');
+		GLsizei length = 0;
+		getter(name.size(), &length, name.data());
+		name.truncate(length);
+		return name;
+	}
+}
+
+GLTraceRecorder* GLTraceRecorder::_active = nullptr;
+
+GLTraceRecorder::GLTraceRecorder()
+	: _context(nullptr)
+{
+}
+
+GLTraceRecorder::~GLTraceRecorder()
+{
+	_file.close();
+}
+
+void GLTraceRecorder::start(const QString& fileName)
+{
+	stop();
+
+	GLTraceRecorder* recorder = new GLTraceRecorder();
+	recorder->_file.setFileName(fileName);
+	if(!recorder->_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		delete recorder;
+		throw std::runtime_error(QString("Could not open \"%1\" for writing").arg(fileName).toStdString());
+	}
+
+	recorder->_stream.setDevice(&recorder->_file);
+	recorder->_stream.setVersion(QDataStream::Qt_5_0);
+	recorder->_stream.setByteOrder(QDataStream::LittleEndian);
+	recorder->_stream << GLTrace::MAGIC << GLTrace::VERSION;
+
+	_active = recorder;
+}
+
+void GLTraceRecorder::stop()
+{
+	delete _active;
+	_active = nullptr;
+}
+
+GLTraceRecorder* GLTraceRecorder::getActive()
+{
+	return _active;
+}
+
+void GLTraceRecorder::record(GLTraceFunctions* f, GLTraceCommand command, std::initializer_list<quint64> arguments, const void* payload, qint64 payloadSize)
+{
+	selectContext(f);
+
+	// The program used by draw calls is bound behind our back
+	if(command >= GLTraceCommand::DrawArrays && command <= GLTraceCommand::BeginTransformFeedback)
+		syncProgram(f);
+
+	write(command, arguments, payload, payloadSize);
+}
+
+void GLTraceRecorder::recordFrame(GLTraceFunctions* f, GLuint defaultFramebuffer, const QSize& size)
+{
+	selectContext(f);
+	write(GLTraceCommand::Frame, {GLTrace::encode(defaultFramebuffer), GLTrace::encode(size.width()), GLTrace::encode(size.height())});
+}
+
+void GLTraceRecorder::write(GLTraceCommand command, std::initializer_list<quint64> arguments, const void* payload, qint64 payloadSize)
+{
+	Q_ASSERT(qstrlen(GLTrace::getCommandInfo(command).arguments) == arguments.size());
+
+	_stream << static_cast<quint16>(command) << static_cast<quint8>(arguments.size());
+	for(quint64 argument : arguments)
+		_stream << argument;
+
+	if(!payload)
+		payloadSize = 0;
+
+	_stream << static_cast<quint32>(payloadSize);
+	if(payloadSize)
+		_stream.writeRawData(static_cast<const char*>(payload), static_cast<int>(payloadSize));
+}
+
+void GLTraceRecorder::selectContext(GLTraceFunctions* f)
+{
+	QOpenGLContext* context = f->getContext();
+	if(context == _context)
+		return;
+
+	if(!_contextIds.contains(context))
+		_contextIds.insert(context, _contextIds.size());
+
+	_context = context;
+	write(GLTraceCommand::Context, {_contextIds.value(context)});
+}
+
+void GLTraceRecorder::syncProgram(GLTraceFunctions* f)
+{
+	GLint current = 0;
+	f->glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+	GLuint program = static_cast<GLuint>(current);
+
+	if(program)
+	{
+		// Names of deleted programs are reused, so the definition is compared instead of the name
+		QByteArray definition = getProgramDefinition(f, program);
+		if(!_programDefinitions.contains(program) || _programDefinitions.value(program) != definition)
+		{
+			write(GLTraceCommand::DefineProgram, {GLTrace::encode(program)}, definition.constData(), definition.size());
+			_programDefinitions.insert(program, definition);
+			_programUniforms.remove(program);
+
+			// A redefined program has to be made current again
+			for(auto it = _usedPrograms.begin(); it != _usedPrograms.end();)
+			{
+				if(it.value() == program)
+					it = _usedPrograms.erase(it);
+				else
+					++it;
+			}
+		}
+	}
+
+	if(!_usedPrograms.contains(_context) || _usedPrograms.value(_context) != program)
+	{
+		write(GLTraceCommand::UseProgram, {GLTrace::encode(program)});
+		_usedPrograms.insert(_context, program);
+	}
+
+	if(program)
+	{
+		QByteArray uniforms = getProgramUniforms(f, program);
+		if(!_programUniforms.contains(program) || _programUniforms.value(program) != uniforms)
+		{
+			write(GLTraceCommand::SetUniforms, {GLTrace::encode(program)}, uniforms.constData(), uniforms.size());
+			_programUniforms.insert(program, uniforms);
+		}
+	}
+}
+
+QByteArray GLTraceRecorder::getProgramDefinition(GLTraceFunctions* f, GLuint program)
+{
+	QByteArray definition;
+	QDataStream stream(&definition, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream.setByteOrder(QDataStream::LittleEndian);
+
+	GLint count = 0;
+	GLint maxLength = 0;
+
+	// Shader sources
+	f->glGetProgramiv(program, GL_ATTACHED_SHADERS, &count);
+	QVector<GLuint> shaders(count);
+	if(count)
+		f->glGetAttachedShaders(program, count, nullptr, shaders.data());
+
+	stream << static_cast<quint32>(shaders.size());
+	for(GLuint shader : shaders)
+	{
+		GLint type = 0;
+		f->glGetShaderiv(shader, GL_SHADER_TYPE, &type);
+		f->glGetShaderiv(shader, GL_SHADER_SOURCE_LENGTH, &maxLength);
+		QByteArray source = readName(maxLength, [&](GLsizei size, GLsizei* length, char* data) {
+			f->glGetShaderSource(shader, size, length, data);
+		});
+
+		stream << static_cast<quint32>(type) << source;
+	}
+
+	// Attribute locations, which might have been bound before linking
+	f->glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count);
+	f->glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+	stream << static_cast<quint32>(count);
+	for(GLint i = 0; i < count; ++i)
+	{
+		GLint size = 0;
+		GLenum type = GL_NONE;
+		QByteArray name = readName(maxLength, [&](GLsizei bufSize, GLsizei* length, char* data) {
+			f->glGetActiveAttrib(program, i, bufSize, length, &size, &type, data);
+		});
+
+		stream << name << static_cast<qint32>(f->glGetAttribLocation(program, name.constData()));
+	}
+
+	// Transform feedback varyings
+	GLint mode = GL_INTERLEAVED_ATTRIBS;
+	f->glGetProgramiv(program, GL_TRANSFORM_FEEDBACK_BUFFER_MODE, &mode);
+	f->glGetProgramiv(program, GL_TRANSFORM_FEEDBACK_VARYINGS, &count);
+	f->glGetProgramiv(program, GL_TRANSFORM_FEEDBACK_VARYING_MAX_LENGTH, &maxLength);
+	stream << static_cast<quint32>(mode) << static_cast<quint32>(count);
+	for(GLint i = 0; i < count; ++i)
+	{
+		GLsizei size = 0;
+		GLenum type = GL_NONE;
+		stream << readName(maxLength, [&](GLsizei bufSize, GLsizei* length, char* data) {
+			f->glGetTransformFeedbackVarying(program, i, bufSize, length, &size, &type, data);
+		});
+	}
+
+	// Uniform block bindings
+	f->glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+	f->glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength);
+	stream << static_cast<quint32>(count);
+	for(GLint i = 0; i < count; ++i)
+	{
+		GLint binding = 0;
+		f->glGetActiveUniformBlockiv(program, i, GL_UNIFORM_BLOCK_BINDING, &binding);
+		stream << readName(maxLength, [&](GLsizei bufSize, GLsizei* length, char* data) {
+			f->glGetActiveUniformBlockName(program, i, bufSize, length, data);
+		}) << static_cast<quint32>(binding);
+	}
+
+	return definition;
+}
+
+QByteArray GLTraceRecorder::getProgramUniforms(GLTraceFunctions* f, GLuint program)
+{
+	QByteArray uniforms;
+	QDataStream stream(&uniforms, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream.setByteOrder(QDataStream::LittleEndian);
+
+	GLint count = 0;
+	GLint maxLength = 0;
+	f->glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+	f->glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+	for(GLuint i = 0; i < static_cast<GLuint>(count); ++i)
+	{
+		// Uniforms in blocks are stored in buffers
+		GLint blockIndex = -1;
+		f->glGetActiveUniformsiv(program, 1, &i, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+		if(blockIndex != -1)
+			continue;
+
+		GLint size = 0;
+		GLenum type = GL_NONE;
+		QByteArray name = readName(maxLength, [&](GLsizei bufSize, GLsizei* length, char* data) {
+			f->glGetActiveUniform(program, i, bufSize, length, &size, &type, data);
+		});
+
+		GLTrace::UniformKind kind;
+		int components = 0;
+		if(!GLTrace::getUniformLayout(type, kind, components))
+			continue;
+
+		// Arrays are reported by their first element
+		if(name.endsWith("[0]"))
+			name.chop(3);
+
+		for(GLint element = 0; element < size; ++element)
+		{
+			QByteArray elementName = size > 1 ? name + '[' + QByteArray::number(element) + ']' : name;
+			GLint location = f->glGetUniformLocation(program, elementName.constData());
+			if(location < 0)
+				continue;
+
+			// All kinds have 32 bit components
+			GLfloat values[16];
+			switch(kind)
+			{
+			case GLTrace::UniformKind_Float:
+			case GLTrace::UniformKind_Matrix:
+				f->glGetUniformfv(program, location, values);
+				break;
+			case GLTrace::UniformKind_Int:
+				f->glGetUniformiv(program, location, reinterpret_cast<GLint*>(values));
+				break;
+			case GLTrace::UniformKind_UInt:
+				f->glGetUniformuiv(program, location, reinterpret_cast<GLuint*>(values));
+				break;
+			}
+
+			stream << elementName << static_cast<quint32>(type);
+			stream.writeRawData(reinterpret_cast<const char*>(values), components * 4);
+		}
+	}
+
+	return uniforms;
+}
+
+}
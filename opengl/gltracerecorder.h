@@ -0,0 +1,126 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef GLTRACERECORDER_H
+#define GLTRACERECORDER_H
+
+#include "gltrace.h"
+
+#include <QFile>
+#include <QDataStream>
+#include <QHash>
+#include <QSize>
+
+#include <initializer_list>
+
+namespace ysm
+{
+	class GLTraceFunctions;
+
+	/**
+	 * @brief The GLTraceRecorder class writes the calls issued through GLTraceFunctions into a trace file.
+	 * At most one recorder is active at a time. Calls are recorded for all contexts, a Context record is written
+	 * whenever the calls switch to another context.
+	 * Shader programs are bound and their uniforms are set by QOpenGLShaderProgram, which doesn't use the traced
+	 * functions. Therefore, the current program and its uniforms are captured before each draw call and recorded as
+	 * snapshots, if they changed. A program is recorded with its shader sources, attribute locations, transform
+	 * feedback varyings and uniform block bindings, which is everything needed to link it again.
+	 */
+	class GLTraceRecorder
+	{
+	public:
+
+		/**
+		 * @brief start		Starts recording into the given file, replacing the active recorder.
+		 * Throws a std::runtime_error, if the file can't be written.
+		 * @param fileName	The file to write the trace to
+		 */
+		static void start(const QString& fileName);
+
+		/// @brief Stops recording and closes the trace file.
+		static void stop();
+
+		/// @brief Returns the active recorder, or null if no calls are being recorded.
+		static GLTraceRecorder* getActive();
+
+	public:
+
+		/**
+		 * @brief record		Records a call.
+		 * @param f				The functions object the call was issued through
+		 * @param command		The command
+		 * @param arguments		The encoded arguments
+		 * @param payload		Data passed by pointer, if it needs to be stored in the trace
+		 * @param payloadSize	Size of the payload in bytes
+		 */
+		void record(GLTraceFunctions* f, GLTraceCommand command, std::initializer_list<quint64> arguments, const void* payload, qint64 payloadSize);
+
+		/**
+		 * @brief recordFrame			Records the start of a frame.
+		 * @param f						The functions object of the context rendering the frame
+		 * @param defaultFramebuffer	The framebuffer the frame is displayed from
+		 * @param size					Size of the framebuffer in pixels
+		 */
+		void recordFrame(GLTraceFunctions* f, GLuint defaultFramebuffer, const QSize& size);
+
+	private:
+
+		GLTraceRecorder();
+		~GLTraceRecorder();
+
+		/// @brief Writes a record into the trace.
+		void write(GLTraceCommand command, std::initializer_list<quint64> arguments, const void* payload = nullptr, qint64 payloadSize = 0);
+
+		/// @brief Writes a Context record, if the calls of the given functions object go to another context than the last ones.
+		void selectContext(GLTraceFunctions* f);
+
+		/// @brief Records changes to the current program and its uniforms.
+		void syncProgram(GLTraceFunctions* f);
+
+		/// @brief Returns everything needed to link the given program again, in the format of DefineProgram records.
+		QByteArray getProgramDefinition(GLTraceFunctions* f, GLuint program);
+
+		/// @brief Returns the values of the default block uniforms of the given program, in the format of SetUniforms records.
+		QByteArray getProgramUniforms(GLTraceFunctions* f, GLuint program);
+
+	private:
+
+		static GLTraceRecorder* _active;				/*!< The active recorder, if any. */
+
+		QFile _file;									/*!< The trace file. */
+		QDataStream _stream;							/*!< Stream writing into the trace file. */
+
+		QOpenGLContext* _context;						/*!< Context of the last recorded call. */
+		QHash<QOpenGLContext*, quint64> _contextIds;	/*!< Ids of the contexts, as recorded in Context records. */
+
+		QHash<QOpenGLContext*, GLuint> _usedPrograms;	/*!< The last recorded current program of each context. */
+		QHash<GLuint, QByteArray> _programDefinitions;	/*!< The last recorded definition of each program. */
+		QHash<GLuint, QByteArray> _programUniforms;		/*!< The last recorded uniform values of each program. */
+	};
+
+}
+
+#endif // GLTRACERECORDER_H
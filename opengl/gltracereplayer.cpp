@@ -0,0 +1,924 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "gltracereplayer.h"
+#include "gltracefunctions.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QOffscreenSurface>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ysm
+{
+
+namespace
+{
+	GLint integer(const QVector<quint64>& arguments, int index)
+	{
+		return static_cast<GLint>(static_cast<qint64>(arguments[index]));
+	}
+
+	GLfloat real(const QVector<quint64>& arguments, int index)
+	{
+		return GLTrace::decodeFloat(arguments[index]);
+	}
+
+	const void* offset(const QVector<quint64>& arguments, int index)
+	{
+		return reinterpret_cast<const void*>(static_cast<quintptr>(arguments[index]));
+	}
+
+	// Data passed by pointer is either stored in the payload or an offset into a bound buffer
+	const void* data(const QVector<quint64>& arguments, const QByteArray& payload, int index)
+	{
+		return payload.isEmpty() ? offset(arguments, index) : payload.constData();
+	}
+
+	void setUniform(GLTraceFunctions* f, GLint location, GLenum type, const char* values)
+	{
+		GLTrace::UniformKind kind;
+		int components = 0;
+		if(!GLTrace::getUniformLayout(type, kind, components))
+			return;
+
+		const GLfloat* floats = reinterpret_cast<const GLfloat*>(values);
+		const GLint* ints = reinterpret_cast<const GLint*>(values);
+		const GLuint* uints = reinterpret_cast<const GLuint*>(values);
+
+		switch(kind)
+		{
+		case GLTrace::UniformKind_Float:
+			switch(components)
+			{
+			case 1: f->glUniform1fv(location, 1, floats); break;
+			case 2: f->glUniform2fv(location, 1, floats); break;
+			case 3: f->glUniform3fv(location, 1, floats); break;
+			case 4: f->glUniform4fv(location, 1, floats); break;
+			}
+			break;
+		case GLTrace::UniformKind_Int:
+			switch(components)
+			{
+			case 1: f->glUniform1iv(location, 1, ints); break;
+			case 2: f->glUniform2iv(location, 1, ints); break;
+			case 3: f->glUniform3iv(location, 1, ints); break;
+			case 4: f->glUniform4iv(location, 1, ints); break;
+			}
+			break;
+		case GLTrace::UniformKind_UInt:
+			switch(components)
+			{
+			case 1: f->glUniform1uiv(location, 1, uints); break;
+			case 2: f->glUniform2uiv(location, 1, uints); break;
+			case 3: f->glUniform3uiv(location, 1, uints); break;
+			case 4: f->glUniform4uiv(location, 1, uints); break;
+			}
+			break;
+		case GLTrace::UniformKind_Matrix:
+			switch(type)
+			{
+			case GL_FLOAT_MAT2:		f->glUniformMatrix2fv(location, 1, GL_FALSE, floats); break;
+			case GL_FLOAT_MAT3:		f->glUniformMatrix3fv(location, 1, GL_FALSE, floats); break;
+			case GL_FLOAT_MAT4:		f->glUniformMatrix4fv(location, 1, GL_FALSE, floats); break;
+			case GL_FLOAT_MAT2x3:	f->glUniformMatrix2x3fv(location, 1, GL_FALSE, floats); break;
+			case GL_FLOAT_MAT2x4:	f->glUniformMatrix2x4fv(location, 1, GL_FALSE, floats); break;
+			case GL_FLOAT_MAT3x2:	f->glUniformMatrix3x2fv(location, 1, GL_FALSE, floats); break;
+			case GL_FLOAT_MAT3x4:	f->glUniformMatrix3x4fv(location, 1, GL_FALSE, floats); break;
+			case GL_FLOAT_MAT4x2:	f->glUniformMatrix4x2fv(location, 1, GL_FALSE, floats); break;
+			case GL_FLOAT_MAT4x3:	f->glUniformMatrix4x3fv(location, 1, GL_FALSE, floats); break;
+			}
+			break;
+		}
+	}
+}
+
+GLTraceReplayer::GLTraceReplayer(bool synchronous)
+	: _synchronous(synchronous),
+	  _surface(new QOffscreenSurface()),
+	  _current(nullptr),
+	  _statistics(static_cast<int>(GLTraceCommand::CommandCount))
+{
+	_surface->setFormat(QSurfaceFormat::defaultFormat());
+	_surface->create();
+
+	for(int i = 0; i < _statistics.size(); ++i)
+		_statistics[i] = CommandStatistics{GLTrace::getCommandInfo(static_cast<GLTraceCommand>(i)).name, 0, 0, 0};
+}
+
+GLTraceReplayer::~GLTraceReplayer()
+{
+	// Deleting the contexts deletes all objects created by the replay
+	for(Context* context : _contexts)
+	{
+		delete context->context;
+		delete context;
+	}
+
+	delete _surface;
+}
+
+void GLTraceReplayer::replay(const QString& fileName)
+{
+	QFile file(fileName);
+	if(!file.open(QIODevice::ReadOnly))
+		throw std::runtime_error(QString("Could not open \"%1\" for reading").arg(fileName).toStdString());
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream.setByteOrder(QDataStream::LittleEndian);
+
+	quint32 magic = 0;
+	quint16 version = 0;
+	stream >> magic >> version;
+	if(magic != GLTrace::MAGIC || version != GLTrace::VERSION)
+		throw std::runtime_error(QString("\"%1\" is not a supported GL trace").arg(fileName).toStdString());
+
+	while(!stream.atEnd())
+	{
+		Record record;
+
+		quint16 command = 0;
+		quint8 argumentCount = 0;
+		stream >> command >> argumentCount;
+		if(command >= static_cast<quint16>(GLTraceCommand::CommandCount))
+			throw std::runtime_error("The trace contains an unknown command");
+
+		record.command = static_cast<GLTraceCommand>(command);
+		if(argumentCount != qstrlen(GLTrace::getCommandInfo(record.command).arguments))
+			throw std::runtime_error("The trace contains a record with invalid arguments");
+
+		record.arguments.resize(argumentCount);
+		for(quint64& argument : record.arguments)
+			stream >> argument;
+
+		quint32 payloadSize = 0;
+		stream >> payloadSize;
+		record.payload.resize(payloadSize);
+		if(payloadSize)
+			stream.readRawData(record.payload.data(), payloadSize);
+
+		if(stream.status() != QDataStream::Ok)
+			throw std::runtime_error("The trace is truncated");
+
+		// Everything before the first context record can't be replayed
+		if(!_current && record.command != GLTraceCommand::Context)
+			throw std::runtime_error("The trace doesn't start with a context");
+
+		// Pointers are replaced by the payload, which has to hold all data read by the call
+		if(!hasValidPayload(record))
+			throw std::runtime_error("The trace contains a record with an invalid payload");
+
+		CommandStatistics& statistics = _statistics[command];
+		++statistics.calls;
+		if(isRedundant(record))
+			++statistics.redundantCalls;
+
+		QElapsedTimer timer;
+		timer.start();
+
+		execute(record);
+		if(_synchronous)
+			_current->f->glFinish();
+
+		statistics.time += timer.nsecsElapsed();
+	}
+
+	finishFrame();
+}
+
+QVector<GLTraceReplayer::CommandStatistics> GLTraceReplayer::getStatistics() const
+{
+	QVector<CommandStatistics> statistics;
+	for(const CommandStatistics& command : _statistics)
+	{
+		if(command.calls)
+			statistics.append(command);
+	}
+
+	std::stable_sort(statistics.begin(), statistics.end(), [](const CommandStatistics& a, const CommandStatistics& b) {
+		return a.time > b.time;
+	});
+
+	return statistics;
+}
+
+const QVector<qint64>& GLTraceReplayer::getFrameTimes() const
+{
+	return _frameTimes;
+}
+
+QString GLTraceReplayer::getReport() const
+{
+	QString report = QString("%1 %2 %3 %4 %5\n")
+			.arg("Command", -32)
+			.arg("Calls", 10)
+			.arg("Redundant", 10)
+			.arg("Total [ms]", 12)
+			.arg("Average [us]", 14);
+
+	qint64 total = 0;
+	for(const CommandStatistics& command : getStatistics())
+	{
+		report += QString("%1 %2 %3 %4 %5\n")
+				.arg(command.name, -32)
+				.arg(command.calls, 10)
+				.arg(command.redundantCalls, 10)
+				.arg(command.time / 1e6, 12, 'f', 3)
+				.arg(command.time / 1e3 / command.calls, 14, 'f', 3);
+		total += command.time;
+	}
+
+	report += QString("\nTotal: %1 ms\n").arg(total / 1e6, 0, 'f', 3);
+
+	if(!_frameTimes.isEmpty())
+	{
+		qint64 sum = 0;
+		for(qint64 time : _frameTimes)
+			sum += time;
+
+		report += QString("Frames: %1, average %2 ms, minimum %3 ms, maximum %4 ms\n")
+				.arg(_frameTimes.size())
+				.arg(sum / 1e6 / _frameTimes.size(), 0, 'f', 3)
+				.arg(*std::min_element(_frameTimes.begin(), _frameTimes.end()) / 1e6, 0, 'f', 3)
+				.arg(*std::max_element(_frameTimes.begin(), _frameTimes.end()) / 1e6, 0, 'f', 3);
+	}
+
+	return report;
+}
+
+void GLTraceReplayer::selectContext(quint64 id)
+{
+	if(!_contexts.contains(id))
+	{
+		// All replaying contexts share their objects with the first one
+		QOpenGLContext* context = new QOpenGLContext();
+		context->setFormat(QSurfaceFormat::defaultFormat());
+		if(!_contexts.isEmpty())
+			context->setShareContext(_contexts.begin().value()->context);
+
+		if(!context->create() || !context->makeCurrent(_surface))
+		{
+			delete context;
+			throw std::runtime_error("Could not create an OpenGL context for the replay");
+		}
+
+		GLTraceFunctions* f = GLTraceFunctions::forContext(context);
+		if(!f)
+		{
+			delete context;
+			throw std::runtime_error("Replaying a trace needs at least OpenGL 3.3");
+		}
+
+		_contexts.insert(id, new Context{context, f, {}, {}, 0, {0, 0}, QSize(512, 512), GL_TEXTURE0, {}});
+	}
+
+	_current = _contexts.value(id);
+	if(QOpenGLContext::currentContext() != _current->context)
+		_current->context->makeCurrent(_surface);
+}
+
+bool GLTraceReplayer::isRedundant(const Record& record)
+{
+	const GLTraceCommandInfo& info = GLTrace::getCommandInfo(record.command);
+	const QVector<quint64>& arguments = record.arguments;
+
+	switch(record.command)
+	{
+	// Bindings of deleted objects are reset, and their names may be reused
+	case GLTraceCommand::DeleteBuffers:
+	case GLTraceCommand::DeleteTextures:
+	case GLTraceCommand::DeleteSamplers:
+	case GLTraceCommand::DeleteRenderbuffers:
+	case GLTraceCommand::DeleteFramebuffers:
+	case GLTraceCommand::DeleteVertexArrays:
+		_current->state.clear();
+		return false;
+	case GLTraceCommand::DefineProgram:
+		for(Context* context : _contexts)
+			context->state.remove("Program");
+		return false;
+	case GLTraceCommand::ActiveTexture:
+		_current->activeTexture = static_cast<GLenum>(arguments[0]);
+		break;
+	case GLTraceCommand::BindVertexArray:
+		// The element array buffer is part of the vertex array
+		_current->state.remove("BindBuffer:" + QByteArray::number(GL_ELEMENT_ARRAY_BUFFER));
+		break;
+	case GLTraceCommand::BindFramebuffer:
+		// GL_FRAMEBUFFER sets both the read and draw framebuffer
+		for(GLenum target : {GL_FRAMEBUFFER, GL_READ_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER})
+		{
+			if(target != arguments[0])
+				_current->state.remove("BindFramebuffer:" + QByteArray::number(target));
+		}
+		break;
+	default:
+		break;
+	}
+
+	if(!info.state)
+		return false;
+
+	QByteArray key(info.state);
+	for(int i = 0; i < info.keyArguments; ++i)
+		key += ':' + QByteArray::number(arguments[i]);
+
+	// Textures are bound per unit
+	if(record.command == GLTraceCommand::BindTexture)
+		key += ':' + QByteArray::number(_current->activeTexture);
+
+	QVector<quint64> value;
+	value.append(static_cast<quint64>(record.command));
+	for(int i = info.keyArguments; i < arguments.size(); ++i)
+		value.append(arguments[i]);
+
+	auto it = _current->state.find(key);
+	if(it != _current->state.end() && it.value() == value)
+		return true;
+
+	_current->state.insert(key, value);
+	return false;
+}
+
+bool GLTraceReplayer::hasValidPayload(const Record& record)
+{
+	// Without a payload, pointers are offsets into the bound buffer or null
+	if(record.payload.isEmpty())
+		return true;
+
+	const QVector<quint64>& a = record.arguments;
+	qint64 size = 0;
+
+	switch(record.command)
+	{
+	case GLTraceCommand::DrawBuffers:
+		size = qint64(integer(a, 0)) * sizeof(GLenum);
+		break;
+	case GLTraceCommand::PatchParameterfv:
+		size = GLTrace::getParameterCount(a[0]) * sizeof(GLfloat);
+		break;
+	case GLTraceCommand::TexParameteriv:
+	case GLTraceCommand::TexParameterfv:
+	case GLTraceCommand::SamplerParameterfv:
+		size = GLTrace::getParameterCount(a[1]) * sizeof(GLfloat);
+		break;
+	case GLTraceCommand::BufferData:
+		size = static_cast<qint64>(a[1]);
+		break;
+
+	// Images are read with the replayed unpack state
+	case GLTraceCommand::TexImage1D:
+		size = _current->f->getImageSize(1, integer(a, 3), 1, 1, a[5], a[6]);
+		break;
+	case GLTraceCommand::TexImage2D:
+		size = _current->f->getImageSize(2, integer(a, 3), integer(a, 4), 1, a[6], a[7]);
+		break;
+	case GLTraceCommand::TexImage3D:
+		size = _current->f->getImageSize(3, integer(a, 3), integer(a, 4), integer(a, 5), a[7], a[8]);
+		break;
+	case GLTraceCommand::TexSubImage1D:
+		size = _current->f->getImageSize(1, integer(a, 3), 1, 1, a[4], a[5]);
+		break;
+	case GLTraceCommand::TexSubImage2D:
+		size = _current->f->getImageSize(2, integer(a, 4), integer(a, 5), 1, a[6], a[7]);
+		break;
+	case GLTraceCommand::TexSubImage3D:
+		size = _current->f->getImageSize(3, integer(a, 5), integer(a, 6), integer(a, 7), a[8], a[9]);
+		break;
+	case GLTraceCommand::CompressedTexSubImage1D:
+		size = integer(a, 5);
+		break;
+	case GLTraceCommand::CompressedTexSubImage2D:
+		size = integer(a, 7);
+		break;
+	case GLTraceCommand::CompressedTexSubImage3D:
+		size = integer(a, 9);
+		break;
+
+	case GLTraceCommand::DrawElements:
+	case GLTraceCommand::DrawElementsInstanced:
+		size = qint64(integer(a, 1)) * GLTrace::getIndexSize(a[2]);
+		break;
+
+	// The remaining payloads are parsed with bounds checks
+	default:
+		return true;
+	}
+
+	// Data of unknown size is never recorded
+	return size > 0 && record.payload.size() >= size;
+}
+
+void GLTraceReplayer::execute(const Record& record)
+{
+	const QVector<quint64>& a = record.arguments;
+	const QByteArray& payload = record.payload;
+	GLTraceFunctions* f = _current ? _current->f : nullptr;
+
+	switch(record.command)
+	{
+	// Synthetic commands
+	case GLTraceCommand::Context:
+		selectContext(a[0]);
+		break;
+	case GLTraceCommand::Frame:
+		finishFrame();
+		resizeTarget(QSize(integer(a, 1), integer(a, 2)));
+		_frameTimer.start();
+		break;
+	case GLTraceCommand::DefineProgram:
+		defineProgram(record);
+		break;
+	case GLTraceCommand::UseProgram:
+		f->glUseProgram(_programs.value(static_cast<GLuint>(a[0])));
+		break;
+	case GLTraceCommand::SetUniforms:
+		setUniforms(record);
+		break;
+
+	// Objects
+	case GLTraceCommand::GenBuffers:			generateNames(record, _buffers, &QOpenGLFunctions_3_3_Core::glGenBuffers); break;
+	case GLTraceCommand::DeleteBuffers:			deleteNames(record, _buffers, &QOpenGLFunctions_3_3_Core::glDeleteBuffers); break;
+	case GLTraceCommand::GenTextures:			generateNames(record, _textures, &QOpenGLFunctions_3_3_Core::glGenTextures); break;
+	case GLTraceCommand::DeleteTextures:		deleteNames(record, _textures, &QOpenGLFunctions_3_3_Core::glDeleteTextures); break;
+	case GLTraceCommand::GenSamplers:			generateNames(record, _samplers, &QOpenGLFunctions_3_3_Core::glGenSamplers); break;
+	case GLTraceCommand::DeleteSamplers:		deleteNames(record, _samplers, &QOpenGLFunctions_3_3_Core::glDeleteSamplers); break;
+	case GLTraceCommand::GenRenderbuffers:		generateNames(record, _renderbuffers, &QOpenGLFunctions_3_3_Core::glGenRenderbuffers); break;
+	case GLTraceCommand::DeleteRenderbuffers:	deleteNames(record, _renderbuffers, &QOpenGLFunctions_3_3_Core::glDeleteRenderbuffers); break;
+	case GLTraceCommand::GenFramebuffers:		generateNames(record, _current->framebuffers, &QOpenGLFunctions_3_3_Core::glGenFramebuffers); break;
+	case GLTraceCommand::DeleteFramebuffers:	deleteNames(record, _current->framebuffers, &QOpenGLFunctions_3_3_Core::glDeleteFramebuffers); break;
+	case GLTraceCommand::GenVertexArrays:		generateNames(record, _current->vertexArrays, &QOpenGLFunctions_3_3_Core::glGenVertexArrays); break;
+	case GLTraceCommand::DeleteVertexArrays:	deleteNames(record, _current->vertexArrays, &QOpenGLFunctions_3_3_Core::glDeleteVertexArrays); break;
+	case GLTraceCommand::FenceSync:
+		if(GLsync sync = _syncs.take(a[0]))
+			f->glDeleteSync(sync);
+		_syncs.insert(a[0], f->glFenceSync(a[1], a[2]));
+		break;
+	case GLTraceCommand::ClientWaitSync:
+		if(GLsync sync = _syncs.value(a[0]))
+			f->glClientWaitSync(sync, a[1], a[2]);
+		break;
+	case GLTraceCommand::DeleteSync:
+		if(GLsync sync = _syncs.take(a[0]))
+			f->glDeleteSync(sync);
+		break;
+
+	// Bindings
+	case GLTraceCommand::ActiveTexture:			f->glActiveTexture(a[0]); break;
+	case GLTraceCommand::BindBuffer:			f->glBindBuffer(a[0], getBuffer(a[1])); break;
+	case GLTraceCommand::BindBufferBase:		f->glBindBufferBase(a[0], a[1], getBuffer(a[2])); break;
+	case GLTraceCommand::BindFramebuffer:		f->glBindFramebuffer(a[0], getFramebuffer(a[1])); break;
+	case GLTraceCommand::BindRenderbuffer:		f->glBindRenderbuffer(a[0], getRenderbuffer(a[1])); break;
+	case GLTraceCommand::BindSampler:			f->glBindSampler(a[0], getSampler(a[1])); break;
+	case GLTraceCommand::BindTexture:			f->glBindTexture(a[0], getTexture(a[1])); break;
+	case GLTraceCommand::BindVertexArray:		f->glBindVertexArray(getVertexArray(a[0])); break;
+
+	// Fixed function state
+	case GLTraceCommand::Enable:				f->glEnable(a[0]); break;
+	case GLTraceCommand::Disable:				f->glDisable(a[0]); break;
+	case GLTraceCommand::BlendEquation:			f->glBlendEquation(a[0]); break;
+	case GLTraceCommand::BlendFuncSeparate:		f->glBlendFuncSeparate(a[0], a[1], a[2], a[3]); break;
+	case GLTraceCommand::ClearColor:			f->glClearColor(real(a, 0), real(a, 1), real(a, 2), real(a, 3)); break;
+	case GLTraceCommand::ClearDepth:			f->glClearDepth(GLTrace::decodeDouble(a[0])); break;
+	case GLTraceCommand::ClearStencil:			f->glClearStencil(integer(a, 0)); break;
+	case GLTraceCommand::ColorMask:				f->glColorMask(a[0], a[1], a[2], a[3]); break;
+	case GLTraceCommand::CullFace:				f->glCullFace(a[0]); break;
+	case GLTraceCommand::DepthFunc:				f->glDepthFunc(a[0]); break;
+	case GLTraceCommand::DepthMask:				f->glDepthMask(a[0]); break;
+	case GLTraceCommand::FrontFace:				f->glFrontFace(a[0]); break;
+	case GLTraceCommand::LineWidth:				f->glLineWidth(real(a, 0)); break;
+	case GLTraceCommand::PointSize:				f->glPointSize(real(a, 0)); break;
+	case GLTraceCommand::PolygonMode:			f->glPolygonMode(a[0], a[1]); break;
+	case GLTraceCommand::PixelStorei:			f->glPixelStorei(a[0], integer(a, 1)); break;
+	case GLTraceCommand::Scissor:				f->glScissor(integer(a, 0), integer(a, 1), integer(a, 2), integer(a, 3)); break;
+	case GLTraceCommand::Viewport:				f->glViewport(integer(a, 0), integer(a, 1), integer(a, 2), integer(a, 3)); break;
+	case GLTraceCommand::StencilFunc:			f->glStencilFunc(a[0], integer(a, 1), a[2]); break;
+	case GLTraceCommand::StencilFuncSeparate:	f->glStencilFuncSeparate(a[0], a[1], integer(a, 2), a[3]); break;
+	case GLTraceCommand::StencilOpSeparate:		f->glStencilOpSeparate(a[0], a[1], a[2], a[3]); break;
+	case GLTraceCommand::DrawBuffer:			f->glDrawBuffer(a[0]); break;
+	case GLTraceCommand::DrawBuffers:
+		f->glDrawBuffers(integer(a, 0), static_cast<const GLenum*>(data(a, payload, 1)));
+		break;
+	case GLTraceCommand::PatchParameteri:
+	case GLTraceCommand::PatchParameterfv:
+		if(!f->hasVersion(4, 0))
+			throw std::runtime_error("The trace uses tessellation, which needs OpenGL 4.0");
+		if(record.command == GLTraceCommand::PatchParameteri)
+			f->glPatchParameteri(a[0], integer(a, 1));
+		else
+			f->glPatchParameterfv(a[0], static_cast<const GLfloat*>(data(a, payload, 1)));
+		break;
+
+	// Vertex arrays
+	case GLTraceCommand::EnableVertexAttribArray:	f->glEnableVertexAttribArray(a[0]); break;
+	case GLTraceCommand::VertexAttribPointer:		f->glVertexAttribPointer(a[0], integer(a, 1), a[2], a[3], integer(a, 4), offset(a, 5)); break;
+	case GLTraceCommand::VertexAttribDivisor:		f->glVertexAttribDivisor(a[0], a[1]); break;
+
+	// Texture and sampler parameters
+	case GLTraceCommand::TexParameteri:			f->glTexParameteri(a[0], a[1], integer(a, 2)); break;
+	case GLTraceCommand::TexParameterf:			f->glTexParameterf(a[0], a[1], real(a, 2)); break;
+	case GLTraceCommand::TexParameteriv:		f->glTexParameteriv(a[0], a[1], static_cast<const GLint*>(data(a, payload, 2))); break;
+	case GLTraceCommand::TexParameterfv:		f->glTexParameterfv(a[0], a[1], static_cast<const GLfloat*>(data(a, payload, 2))); break;
+	case GLTraceCommand::SamplerParameteri:		f->glSamplerParameteri(getSampler(a[0]), a[1], integer(a, 2)); break;
+	case GLTraceCommand::SamplerParameterf:		f->glSamplerParameterf(getSampler(a[0]), a[1], real(a, 2)); break;
+	case GLTraceCommand::SamplerParameterfv:	f->glSamplerParameterfv(getSampler(a[0]), a[1], static_cast<const GLfloat*>(data(a, payload, 2))); break;
+
+	// Storage and data
+	case GLTraceCommand::BufferData:
+		f->glBufferData(a[0], static_cast<GLsizeiptr>(a[1]), payload.isEmpty() ? nullptr : payload.constData(), a[3]);
+		break;
+	case GLTraceCommand::CopyBufferSubData:
+		f->glCopyBufferSubData(a[0], a[1], static_cast<GLintptr>(a[2]), static_cast<GLintptr>(a[3]), static_cast<GLsizeiptr>(a[4]));
+		break;
+	case GLTraceCommand::TexBuffer:
+		f->glTexBuffer(a[0], a[1], getBuffer(a[2]));
+		break;
+	case GLTraceCommand::TexImage1D:
+		f->glTexImage1D(a[0], integer(a, 1), integer(a, 2), integer(a, 3), integer(a, 4), a[5], a[6], data(a, payload, 7));
+		break;
+	case GLTraceCommand::TexImage2D:
+		f->glTexImage2D(a[0], integer(a, 1), integer(a, 2), integer(a, 3), integer(a, 4), integer(a, 5), a[6], a[7], data(a, payload, 8));
+		break;
+	case GLTraceCommand::TexImage3D:
+		f->glTexImage3D(a[0], integer(a, 1), integer(a, 2), integer(a, 3), integer(a, 4), integer(a, 5), integer(a, 6), a[7], a[8],
+						data(a, payload, 9));
+		break;
+	case GLTraceCommand::TexImage2DMultisample:
+		f->glTexImage2DMultisample(a[0], integer(a, 1), a[2], integer(a, 3), integer(a, 4), a[5]);
+		break;
+	case GLTraceCommand::TexSubImage1D:
+		f->glTexSubImage1D(a[0], integer(a, 1), integer(a, 2), integer(a, 3), a[4], a[5], data(a, payload, 6));
+		break;
+	case GLTraceCommand::TexSubImage2D:
+		f->glTexSubImage2D(a[0], integer(a, 1), integer(a, 2), integer(a, 3), integer(a, 4), integer(a, 5), a[6], a[7], data(a, payload, 8));
+		break;
+	case GLTraceCommand::TexSubImage3D:
+		f->glTexSubImage3D(a[0], integer(a, 1), integer(a, 2), integer(a, 3), integer(a, 4), integer(a, 5), integer(a, 6), integer(a, 7),
+						   a[8], a[9], data(a, payload, 10));
+		break;
+	case GLTraceCommand::CompressedTexSubImage1D:
+		f->glCompressedTexSubImage1D(a[0], integer(a, 1), integer(a, 2), integer(a, 3), a[4], integer(a, 5), data(a, payload, 6));
+		break;
+	case GLTraceCommand::CompressedTexSubImage2D:
+		f->glCompressedTexSubImage2D(a[0], integer(a, 1), integer(a, 2), integer(a, 3), integer(a, 4), integer(a, 5), a[6], integer(a, 7),
+									 data(a, payload, 8));
+		break;
+	case GLTraceCommand::CompressedTexSubImage3D:
+		f->glCompressedTexSubImage3D(a[0], integer(a, 1), integer(a, 2), integer(a, 3), integer(a, 4), integer(a, 5), integer(a, 6),
+									 integer(a, 7), a[8], integer(a, 9), data(a, payload, 10));
+		break;
+	case GLTraceCommand::TexStorage1D:
+	case GLTraceCommand::TexStorage2D:
+	case GLTraceCommand::TexStorage3D:
+		if(!f->hasVersion(4, 2))
+			throw std::runtime_error("The trace uses immutable textures, which need OpenGL 4.2");
+		if(record.command == GLTraceCommand::TexStorage1D)
+			f->glTexStorage1D(a[0], integer(a, 1), a[2], integer(a, 3));
+		else if(record.command == GLTraceCommand::TexStorage2D)
+			f->glTexStorage2D(a[0], integer(a, 1), a[2], integer(a, 3), integer(a, 4));
+		else
+			f->glTexStorage3D(a[0], integer(a, 1), a[2], integer(a, 3), integer(a, 4), integer(a, 5));
+		break;
+	case GLTraceCommand::TextureView:
+		if(!f->hasVersion(4, 3))
+			throw std::runtime_error("The trace uses texture views, which need OpenGL 4.3");
+		f->glTextureView(getTexture(a[0]), a[1], getTexture(a[2]), a[3], a[4], a[5], a[6], a[7]);
+		break;
+	case GLTraceCommand::GenerateMipmap:
+		f->glGenerateMipmap(a[0]);
+		break;
+	case GLTraceCommand::RenderbufferStorage:
+		f->glRenderbufferStorage(a[0], a[1], integer(a, 2), integer(a, 3));
+		break;
+	case GLTraceCommand::FramebufferRenderbuffer:
+		f->glFramebufferRenderbuffer(a[0], a[1], a[2], getRenderbuffer(a[3]));
+		break;
+	case GLTraceCommand::FramebufferTexture:
+		f->glFramebufferTexture(a[0], a[1], getTexture(a[2]), integer(a, 3));
+		break;
+	case GLTraceCommand::FramebufferTexture2D:
+		f->glFramebufferTexture2D(a[0], a[1], a[2], getTexture(a[3]), integer(a, 4));
+		break;
+	case GLTraceCommand::FramebufferTextureLayer:
+		f->glFramebufferTextureLayer(a[0], a[1], getTexture(a[2]), integer(a, 3), integer(a, 4));
+		break;
+
+	// Drawing
+	case GLTraceCommand::Clear:
+		f->glClear(a[0]);
+		break;
+	case GLTraceCommand::DrawArrays:
+		f->glDrawArrays(a[0], integer(a, 1), integer(a, 2));
+		break;
+	case GLTraceCommand::DrawArraysInstanced:
+		f->glDrawArraysInstanced(a[0], integer(a, 1), integer(a, 2), integer(a, 3));
+		break;
+	case GLTraceCommand::DrawElements:
+		f->glDrawElements(a[0], integer(a, 1), a[2], data(a, payload, 3));
+		break;
+	case GLTraceCommand::DrawElementsInstanced:
+		f->glDrawElementsInstanced(a[0], integer(a, 1), a[2], data(a, payload, 3), integer(a, 4));
+		break;
+	case GLTraceCommand::MultiDrawArraysIndirect:
+	case GLTraceCommand::MultiDrawElementsIndirect:
+		if(!f->hasVersion(4, 3))
+			throw std::runtime_error("The trace uses indirect multi draws, which need OpenGL 4.3");
+		if(record.command == GLTraceCommand::MultiDrawArraysIndirect)
+			f->glMultiDrawArraysIndirect(a[0], offset(a, 1), integer(a, 2), integer(a, 3));
+		else
+			f->glMultiDrawElementsIndirect(a[0], a[1], offset(a, 2), integer(a, 3), integer(a, 4));
+		break;
+	case GLTraceCommand::BeginTransformFeedback:
+		f->glBeginTransformFeedback(a[0]);
+		break;
+	case GLTraceCommand::EndTransformFeedback:
+		f->glEndTransformFeedback();
+		break;
+
+	case GLTraceCommand::CommandCount:
+		break;
+	}
+}
+
+void GLTraceReplayer::defineProgram(const Record& record)
+{
+	GLTraceFunctions* f = _current->f;
+
+	QDataStream stream(record.payload);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream.setByteOrder(QDataStream::LittleEndian);
+
+	GLuint program = f->glCreateProgram();
+	quint32 count = 0;
+
+	// Shaders
+	QVector<GLuint> shaders;
+	stream >> count;
+	for(quint32 i = 0; i < count; ++i)
+	{
+		quint32 type = 0;
+		QByteArray source;
+		stream >> type >> source;
+
+		GLuint shader = f->glCreateShader(type);
+		const char* text = source.constData();
+		f->glShaderSource(shader, 1, &text, nullptr);
+		f->glCompileShader(shader);
+		f->glAttachShader(program, shader);
+		shaders.append(shader);
+	}
+
+	// Attribute locations
+	stream >> count;
+	for(quint32 i = 0; i < count; ++i)
+	{
+		QByteArray name;
+		qint32 location = -1;
+		stream >> name >> location;
+
+		// Built-in inputs have no location
+		if(location >= 0 && !name.startsWith("gl_"))
+			f->glBindAttribLocation(program, location, name.constData());
+	}
+
+	// Transform feedback varyings
+	quint32 mode = GL_INTERLEAVED_ATTRIBS;
+	stream >> mode >> count;
+	QList<QByteArray> varyings;
+	QVector<const char*> varyingNames;
+	for(quint32 i = 0; i < count; ++i)
+	{
+		QByteArray name;
+		stream >> name;
+		varyings.append(name);
+	}
+	for(const QByteArray& varying : varyings)
+		varyingNames.append(varying.constData());
+	if(!varyingNames.isEmpty())
+		f->glTransformFeedbackVaryings(program, varyingNames.size(), varyingNames.data(), mode);
+
+	f->glLinkProgram(program);
+
+	for(GLuint shader : shaders)
+	{
+		f->glDetachShader(program, shader);
+		f->glDeleteShader(shader);
+	}
+
+	GLint linked = GL_FALSE;
+	f->glGetProgramiv(program, GL_LINK_STATUS, &linked);
+	if(!linked)
+	{
+		f->glDeleteProgram(program);
+		throw std::runtime_error("A recorded program could not be linked");
+	}
+
+	// Uniform block bindings
+	stream >> count;
+	for(quint32 i = 0; i < count; ++i)
+	{
+		QByteArray name;
+		quint32 binding = 0;
+		stream >> name >> binding;
+
+		GLuint index = f->glGetUniformBlockIndex(program, name.constData());
+		if(index != GL_INVALID_INDEX)
+			f->glUniformBlockBinding(program, index, binding);
+	}
+
+	if(stream.status() != QDataStream::Ok)
+		throw std::runtime_error("The trace contains an invalid program");
+
+	// Replace an earlier definition
+	const GLuint name = static_cast<GLuint>(record.arguments[0]);
+	if(GLuint previous = _programs.value(name))
+		f->glDeleteProgram(previous);
+	_programs.insert(name, program);
+}
+
+void GLTraceReplayer::setUniforms(const Record& record)
+{
+	GLTraceFunctions* f = _current->f;
+	GLuint program = _programs.value(static_cast<GLuint>(record.arguments[0]));
+	if(!program)
+		return;
+
+	QDataStream stream(record.payload);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream.setByteOrder(QDataStream::LittleEndian);
+
+	while(!stream.atEnd())
+	{
+		QByteArray name;
+		quint32 type = 0;
+		stream >> name >> type;
+
+		GLTrace::UniformKind kind;
+		int components = 0;
+		if(!GLTrace::getUniformLayout(type, kind, components))
+			throw std::runtime_error("The trace contains an unsupported uniform");
+
+		GLfloat values[16];
+		if(stream.readRawData(reinterpret_cast<char*>(values), components * 4) != components * 4)
+			throw std::runtime_error("The trace contains invalid uniforms");
+
+		GLint location = f->glGetUniformLocation(program, name.constData());
+		if(location >= 0)
+			setUniform(f, location, type, reinterpret_cast<const char*>(values));
+	}
+}
+
+void GLTraceReplayer::resizeTarget(const QSize& size)
+{
+	GLTraceFunctions* f = _current->f;
+	if(_current->targetFramebuffer && _current->targetSize == size)
+		return;
+
+	// Keep the bindings of the replayed calls
+	GLint drawFramebuffer = 0, readFramebuffer = 0, renderbuffer = 0;
+	f->glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer);
+	f->glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+	f->glGetIntegerv(GL_RENDERBUFFER_BINDING, &renderbuffer);
+
+	if(!_current->targetFramebuffer)
+	{
+		f->glGenFramebuffers(1, &_current->targetFramebuffer);
+		f->glGenRenderbuffers(2, _current->targetRenderbuffers);
+	}
+
+	_current->targetSize = size.expandedTo(QSize(1, 1));
+
+	f->glBindRenderbuffer(GL_RENDERBUFFER, _current->targetRenderbuffers[0]);
+	f->glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, _current->targetSize.width(), _current->targetSize.height());
+	f->glBindRenderbuffer(GL_RENDERBUFFER, _current->targetRenderbuffers[1]);
+	f->glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, _current->targetSize.width(), _current->targetSize.height());
+
+	f->glBindFramebuffer(GL_FRAMEBUFFER, _current->targetFramebuffer);
+	f->glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, _current->targetRenderbuffers[0]);
+	f->glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, _current->targetRenderbuffers[1]);
+
+	f->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer);
+	f->glBindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer);
+	f->glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+}
+
+void GLTraceReplayer::finishFrame()
+{
+	if(!_frameTimer.isValid())
+		return;
+
+	_current->f->glFinish();
+	_frameTimes.append(_frameTimer.nsecsElapsed());
+	_frameTimer.invalidate();
+}
+
+void GLTraceReplayer::generateNames(const Record& record, QHash<GLuint, GLuint>& names, void (QOpenGLFunctions_3_3_Core::*generate)(GLsizei, GLuint*))
+{
+	const GLuint* recorded = reinterpret_cast<const GLuint*>(record.payload.constData());
+	const int count = record.payload.size() / static_cast<int>(sizeof(GLuint));
+
+	QVector<GLuint> replayed(count);
+	(_current->f->*generate)(count, replayed.data());
+
+	for(int i = 0; i < count; ++i)
+		names.insert(recorded[i], replayed[i]);
+}
+
+void GLTraceReplayer::deleteNames(const Record& record, QHash<GLuint, GLuint>& names, void (QOpenGLFunctions_3_3_Core::*remove)(GLsizei, const GLuint*))
+{
+	const GLuint* recorded = reinterpret_cast<const GLuint*>(record.payload.constData());
+	const int count = record.payload.size() / static_cast<int>(sizeof(GLuint));
+
+	QVector<GLuint> replayed;
+	for(int i = 0; i < count; ++i)
+	{
+		if(GLuint name = names.take(recorded[i]))
+			replayed.append(name);
+	}
+
+	if(!replayed.isEmpty())
+		(_current->f->*remove)(replayed.size(), replayed.constData());
+}
+
+GLuint GLTraceReplayer::getName(QHash<GLuint, GLuint>& names, quint64 name, void (QOpenGLFunctions_3_3_Core::*generate)(GLsizei, GLuint*))
+{
+	if(!name)
+		return 0;
+
+	// Objects created before the recording started are created on first use
+	auto it = names.find(static_cast<GLuint>(name));
+	if(it == names.end())
+	{
+		GLuint replayed = 0;
+		(_current->f->*generate)(1, &replayed);
+		it = names.insert(static_cast<GLuint>(name), replayed);
+	}
+
+	return it.value();
+}
+
+GLuint GLTraceReplayer::getBuffer(quint64 name)
+{
+	return getName(_buffers, name, &QOpenGLFunctions_3_3_Core::glGenBuffers);
+}
+
+GLuint GLTraceReplayer::getTexture(quint64 name)
+{
+	return getName(_textures, name, &QOpenGLFunctions_3_3_Core::glGenTextures);
+}
+
+GLuint GLTraceReplayer::getSampler(quint64 name)
+{
+	return getName(_samplers, name, &QOpenGLFunctions_3_3_Core::glGenSamplers);
+}
+
+GLuint GLTraceReplayer::getRenderbuffer(quint64 name)
+{
+	return getName(_renderbuffers, name, &QOpenGLFunctions_3_3_Core::glGenRenderbuffers);
+}
+
+GLuint GLTraceReplayer::getFramebuffer(quint64 name)
+{
+	// The default framebuffers of the recorded contexts aren't created by the trace
+	auto it = _current->framebuffers.find(static_cast<GLuint>(name));
+	if(!name || it == _current->framebuffers.end())
+	{
+		resizeTarget(_current->targetSize);
+		return _current->targetFramebuffer;
+	}
+
+	return it.value();
+}
+
+GLuint GLTraceReplayer::getVertexArray(quint64 name)
+{
+	return getName(_current->vertexArrays, name, &QOpenGLFunctions_3_3_Core::glGenVertexArrays);
+}
+
+}
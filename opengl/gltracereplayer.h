@@ -0,0 +1,180 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef GLTRACEREPLAYER_H
+#define GLTRACEREPLAYER_H
+
+#include "gltrace.h"
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QSize>
+#include <QVector>
+
+class QOffscreenSurface;
+
+namespace ysm
+{
+	class GLTraceFunctions;
+
+	/**
+	 * @brief The GLTraceReplayer class replays recorded GL traces and measures the time spent per command.
+	 * The calls are issued in offscreen contexts, one for each recorded context, which share their objects like the
+	 * recorded ones did. Object names are mapped to the names created during the replay. Rendering into the default
+	 * framebuffer of a recorded context is redirected into an offscreen framebuffer of the size of the last frame.
+	 * As the trace is replayed in recorded order, replaying the same trace always issues the same calls.
+	 * Besides the time, the replayer counts calls which set state to the value it already had.
+	 */
+	class GLTraceReplayer
+	{
+	public:
+
+		/// @brief Statistics of one command
+		struct CommandStatistics
+		{
+			const char* name;			/*!< Name of the command. */
+			quint64 calls;				/*!< Number of calls. */
+			quint64 redundantCalls;		/*!< Number of calls, which didn't change the state. */
+			qint64 time;				/*!< Time spent in the calls in nanoseconds. */
+		};
+
+	public:
+
+		/**
+		 * @brief GLTraceReplayer	Initializes a new instance.
+		 * @param synchronous		If true, the replayer waits for each call to complete. Otherwise, the measured times
+		 *							only include the time needed to issue the calls.
+		 */
+		GLTraceReplayer(bool synchronous);
+		~GLTraceReplayer();
+
+		/**
+		 * @brief replay		Replays the given trace.
+		 * Throws a std::runtime_error, if the trace can't be read or the calls can't be replayed.
+		 * @param fileName		The trace file
+		 */
+		void replay(const QString& fileName);
+
+		/// @brief Returns the statistics of all replayed commands, sorted by time descending.
+		QVector<CommandStatistics> getStatistics() const;
+
+		/// @brief Returns the durations of the replayed frames in nanoseconds.
+		const QVector<qint64>& getFrameTimes() const;
+
+		/// @brief Returns a human readable table of the statistics.
+		QString getReport() const;
+
+	private:
+
+		/// @brief A record read from the trace
+		struct Record
+		{
+			GLTraceCommand command;			/*!< The recorded command. */
+			QVector<quint64> arguments;		/*!< The encoded arguments. */
+			QByteArray payload;				/*!< Data passed by pointer, if stored in the trace. */
+		};
+
+		/// @brief A context replaying the calls of a recorded context
+		struct Context
+		{
+			QOpenGLContext* context;				/*!< The replaying context. */
+			GLTraceFunctions* f;					/*!< Functions of the replaying context. */
+			QHash<GLuint, GLuint> vertexArrays;		/*!< Names of the vertex arrays, which aren't shared. */
+			QHash<GLuint, GLuint> framebuffers;		/*!< Names of the framebuffers, which aren't shared. */
+			GLuint targetFramebuffer;				/*!< Framebuffer replacing the default framebuffer. */
+			GLuint targetRenderbuffers[2];			/*!< Color and depth stencil attachment of the target framebuffer. */
+			QSize targetSize;						/*!< Size of the target framebuffer. */
+			GLenum activeTexture;					/*!< The active texture unit, for tracking texture bindings. */
+			QHash<QByteArray, QVector<quint64>> state;	/*!< The last values set for each part of the state. */
+		};
+
+	private:
+
+		/// @brief Makes the replaying context of the recorded context with the given id current, creating it if necessary.
+		void selectContext(quint64 id);
+
+		/// @brief Returns true, if the given record sets the state to the value it already has, and updates the tracked state.
+		bool isRedundant(const Record& record);
+
+		/// @brief Returns true, if the payload of the given record holds all data the replayed call reads.
+		bool hasValidPayload(const Record& record);
+
+		/// @brief Issues the calls of the given record.
+		void execute(const Record& record);
+
+		/// @brief Links a program from a DefineProgram record.
+		void defineProgram(const Record& record);
+
+		/// @brief Sets the uniforms of the current program from a SetUniforms record.
+		void setUniforms(const Record& record);
+
+		/// @brief Creates or resizes the framebuffer replacing the default framebuffer of the current context.
+		void resizeTarget(const QSize& size);
+
+		/// @brief Stops the time of the current frame, if any.
+		void finishFrame();
+
+		/// @brief Generates the names recorded in the payload of a Gen* record.
+		void generateNames(const Record& record, QHash<GLuint, GLuint>& names, void (QOpenGLFunctions_3_3_Core::*generate)(GLsizei, GLuint*));
+
+		/// @brief Deletes the names recorded in the payload of a Delete* record.
+		void deleteNames(const Record& record, QHash<GLuint, GLuint>& names, void (QOpenGLFunctions_3_3_Core::*remove)(GLsizei, const GLuint*));
+
+		/// @brief Returns the replayed name of a recorded name, generating it if it wasn't recorded.
+		GLuint getName(QHash<GLuint, GLuint>& names, quint64 name, void (QOpenGLFunctions_3_3_Core::*generate)(GLsizei, GLuint*));
+
+		GLuint getBuffer(quint64 name);
+		GLuint getTexture(quint64 name);
+		GLuint getSampler(quint64 name);
+		GLuint getRenderbuffer(quint64 name);
+		GLuint getFramebuffer(quint64 name);
+		GLuint getVertexArray(quint64 name);
+
+	private:
+
+		bool _synchronous;						/*!< Wait for each call to complete. */
+		QOffscreenSurface* _surface;			/*!< Surface the contexts are made current on. */
+
+		QHash<quint64, Context*> _contexts;		/*!< Replaying contexts by recorded id. */
+		Context* _current;						/*!< The current replaying context. */
+
+		QHash<GLuint, GLuint> _buffers;			/*!< Replayed names of the recorded buffers. */
+		QHash<GLuint, GLuint> _textures;		/*!< Replayed names of the recorded textures. */
+		QHash<GLuint, GLuint> _samplers;		/*!< Replayed names of the recorded samplers. */
+		QHash<GLuint, GLuint> _renderbuffers;	/*!< Replayed names of the recorded renderbuffers. */
+		QHash<GLuint, GLuint> _programs;		/*!< Replayed names of the recorded programs. */
+		QHash<quint64, GLsync> _syncs;			/*!< Replayed sync objects of the recorded ones. */
+
+		QVector<CommandStatistics> _statistics;	/*!< Statistics by command. */
+		QVector<qint64> _frameTimes;			/*!< Durations of the replayed frames. */
+		QElapsedTimer _frameTimer;				/*!< Measures the current frame, if valid. */
+	};
+
+}
+
+#endif // GLTRACEREPLAYER_H
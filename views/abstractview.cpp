@@ -45,6 +45,9 @@ AbstractView::~AbstractView()
 	//Block all updates.
 	_blockUpdates = true;
 
+	//Release all notifications and resets.
+	NotificationBus::getInstance()->unsubscribe(this);
+
 	//Clear all child view's parent.
 	foreach(IView* childView, _childViews)
 		childView->setParentView(NULL);
@@ -143,25 +146,14 @@ void AbstractView::setActiveItem(IPipelineItem *pipelineItem)
 void AbstractView::updateView(Document* document, const QList<IChangeable*>& changedObjects,
 							  IChangeable::Operation operation)
 {
-	//Execute all notifications.
-	foreach(IChangeable* changedObject, changedObjects)
-		foreach(INotification* notification, _notifications)
-			notification->notify(document, changedObject, operation);
-
-	//Forward the change to all child views, that are operating on the active document.
-	foreach(IView* childView, _childViews)
-		childView->updateView(document, changedObjects, operation);
+	//Deliver the change to the notifications of this view and all child views at once.
+	NotificationBus::getInstance()->dispatch(this, document, changedObjects, operation);
 }
 
 void AbstractView::resetView(Document* document)
 {
-	//Execute all resets.
-	foreach(IReset* reset, _resets)
-		reset->notify(document);
-
-	//Forward the change to all child views, that are operating on the active document.
-	foreach(IView* childView, _childViews)
-		childView->resetView(document);
+	//Execute the resets of this view and all child views.
+	NotificationBus::getInstance()->reset(this, document);
 }
 
 bool AbstractView::tryBlockUpdates()  { return (!_blockUpdates) && (_blockUpdates = true); }
@@ -27,6 +27,7 @@
 #define ABSTRACTVIEW_H
 
 #include "iview.h"
+#include "notificationbus.h"
 
 namespace ysm
 {
@@ -36,161 +37,6 @@ namespace ysm
 	class AbstractView : public IView
 	{
 
-	private:
-
-		//! \brief Possible notification types.
-		enum NotificationType
-		{
-			Static,
-			Dynamic,
-			All,
-		};
-
-		//! \brief Non-generic base interface for resets.
-		class IReset
-		{
-		public:
-
-			//! \brief Initialize new instance.
-			IReset() { }
-
-			//! \brief Destruct instance.
-			virtual ~IReset() { }
-
-			/*!
-			 * \brief Execute the actual notification handler, if the object applies to it.
-			 * \param document The document that was reset.
-			 */
-			virtual void notify(Document* document) const = 0;
-		};
-
-		//! \brief Non-generic base interface for notifications.
-		class INotification
-		{
-		public:
-
-			//! \brief Initialize new instance.
-			INotification() { }
-
-			//! \brief Destruct instance.
-			virtual ~INotification() { }
-
-			/*!
-			 * \brief Execute the actual notification handler, if the object applies to it.
-			 * \param document The document that was changed.
-			 * \param changeable The object that was changed.
-			 * \param operation The operation.
-			 */
-			virtual void notify(Document* document, IChangeable* changeable,
-								IChangeable::Operation operation) const = 0;
-		};
-
-		//! \brief Special reset interface.
-		template<typename V> class Reset : public IReset
-		{
-		public:
-
-			/*!
-			 * \brief Initialize new instance.
-			 * \param type The notification type.
-			 * \param instance The instance to call the slot on.
-			 * \param slot The slot.
-			 */
-			Reset(NotificationType type, V* instance, void (V::*slot)()) :
-				_type(type),
-				_instance(instance),
-				_slot(slot)
-			{ _document = instance->getActiveDocument(); }
-
-			/*!
-			 * \brief Execute the actual notification handler, if the object applies to it.
-			 * \param document The document that was reset.
-			 */
-			void notify(Document* document) const Q_DECL_OVERRIDE
-			{
-				//Check if document matches.
-				if(_type == Static && _document != document) return;
-				if(_type == Dynamic && _instance->getActiveDocument() != document) return;
-
-				//Execute the reset handler.
-				(_instance->*_slot)();
-			}
-
-		private:
-
-			//! \brief The notification type.
-			NotificationType _type;
-
-			//! \brief The instance to execute the notification on.
-			V* _instance;
-
-			//! \brief The notification to execute.
-			void (V::*_slot)();
-
-			//! \brief Document if static.
-			Document* _document;
-		};
-
-		//! \brief Special notification interface.
-		template<typename T, typename V> class Notification : public INotification
-		{
-		public:
-
-			/*!
-			 * \brief Initialize new instance.
-			 * \param type The notification type.
-			 * \param operation The operation to watch.
-			 * \param instance The instance to call the slot on.
-			 * \param slot The slot.
-			 */
-			Notification(NotificationType type, IChangeable::Operation operation, V* instance, void (V::*slot)(T*)) :
-				_operation(operation),
-				_type(type),
-				_instance(instance),
-				_slot(slot)
-			{ _document = instance->getActiveDocument(); }
-
-			/*!
-			 * \brief Execute the actual notification handler, if the object applies to it.
-			 * \param document The document that was changed.
-			 * \param changeable The object that was changed.
-			 * \param operation The operation.
-			 */
-			void notify(Document* document, IChangeable* changeable,
-						IChangeable::Operation operation) const Q_DECL_OVERRIDE
-			{
-				//Check if document matches.
-				if(_type == Static && _document != document) return;
-				if(_type == Dynamic && _instance->getActiveDocument() != document) return;
-
-				//Check if the operation matches.
-				if(operation == _operation)
-				{
-					//Try to cast, to check for type matches.
-					T* converted = dynamic_cast<T*>(changeable);
-					if(converted)
-						(_instance->*_slot)(converted);
-				}
-			}
-
-		private:
-
-			//! \brief The operation to look for.
-			IChangeable::Operation _operation;
-
-			//! \brief The notification type.
-			NotificationType _type;
-
-			//! \brief The instance to execute the notification on.
-			V* _instance;
-
-			//! \brief The notification to execute.
-			void (V::*_slot)(T*);
-
-			//! \brief Document if static.
-			Document* _document;
-		};
-
 	public:
 
 		/*!
@@ -321,8 +167,9 @@ namespace ysm
 		template<typename T, typename V>
 		void notifyStatic(IChangeable::Operation operation, V* instance, void (V::*slot)(T*))
 		{
-			//Just create and append the notification.
-			_notifications.append(new Notification<T, V>(Static, operation, instance, slot));
+			//Subscribe to the notification bus.
+			NotificationBus::getInstance()->subscribe(
+				new NotificationBus::Notification<T, V>(NotificationBus::Static, operation, this, instance, slot));
 		}
 
 		/*!
@@ -333,8 +180,8 @@ namespace ysm
 		template<typename V>
 		void notifyStatic(V* instance, void(V::*slot)())
 		{
-			//Just create and append the reset.
-			_resets.append(new Reset<V>(Static, instance, slot));
+			//Subscribe to the notification bus.
+			NotificationBus::getInstance()->subscribe(new NotificationBus::Reset<V>(NotificationBus::Static, this, instance, slot));
 		}
 
 		/*!
@@ -346,8 +193,9 @@ namespace ysm
 		template<typename T, typename V>
 		void notifyDynamic(IChangeable::Operation operation, V* instance, void (V::*slot)(T*))
 		{
-			//Just create and append the notification.
-			_notifications.append(new Notification<T, V>(Dynamic, operation, instance, slot));
+			//Subscribe to the notification bus.
+			NotificationBus::getInstance()->subscribe(
+				new NotificationBus::Notification<T, V>(NotificationBus::Dynamic, operation, this, instance, slot));
 		}
 
 		/*!
@@ -358,8 +206,8 @@ namespace ysm
 		template<typename V>
 		void notifyDynamic(V* instance, void(V::*slot)())
 		{
-			//Just create and append the reset.
-			_resets.append(new Reset<V>(Dynamic, instance, slot));
+			//Subscribe to the notification bus.
+			NotificationBus::getInstance()->subscribe(new NotificationBus::Reset<V>(NotificationBus::Dynamic, this, instance, slot));
 		}
 
 		/*!
@@ -371,8 +219,9 @@ namespace ysm
 		template<typename T, typename V>
 		void notifyAll(IChangeable::Operation operation, V* instance, void (V::*slot)(T*))
 		{
-			//Just create and append the notification.
-			_notifications.append(new Notification<T, V>(All, operation, instance, slot));
+			//Subscribe to the notification bus.
+			NotificationBus::getInstance()->subscribe(
+				new NotificationBus::Notification<T, V>(NotificationBus::All, operation, this, instance, slot));
 		}
 
 		/*!
@@ -383,8 +232,8 @@ namespace ysm
 		template<typename V>
 		void notifyAll(V* instance, void(V::*slot)())
 		{
-			//Just create and append the reset.
-			_resets.append(new Reset<V>(All, instance, slot));
+			//Subscribe to the notification bus.
+			NotificationBus::getInstance()->subscribe(new NotificationBus::Reset<V>(NotificationBus::All, this, instance, slot));
 		}
 
 	protected:
@@ -403,12 +252,6 @@ namespace ysm
 		//! \brief The child views.
 		QList<IView*> _childViews;
 
-		//! \brief List of all notifications sent.
-		QList<INotification*> _notifications;
-
-		//! \brief List of all resets sent.
-		QList<IReset*> _resets;
-
 		//! \brief Avoids call cycles during internal update.
 		bool _blockUpdates;
 	};
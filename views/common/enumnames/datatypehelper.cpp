@@ -46,4 +46,15 @@ IMPLEMENTATION_ADD(Conversions, DataType::Vec4, "To 4D Vector")
 IMPLEMENTATION_ADD(Conversions, DataType::Int, "To Int")
 IMPLEMENTATION_ADD(Conversions, DataType::UInt, "To UInt")
 IMPLEMENTATION_ADD(Conversions, DataType::Float, "To Float")
+IMPLEMENTATION_ADD(Conversions, DataType::HalfVec2, "To Half 2D Vector")
+IMPLEMENTATION_ADD(Conversions, DataType::HalfVec3, "To Half 3D Vector")
+IMPLEMENTATION_ADD(Conversions, DataType::HalfVec4, "To Half 4D Vector")
+IMPLEMENTATION_ADD(Conversions, DataType::SNorm8Vec4, "To SNorm8 4D Vector")
+IMPLEMENTATION_ADD(Conversions, DataType::UNorm8Vec4, "To UNorm8 4D Vector")
+IMPLEMENTATION_ADD(Conversions, DataType::SNorm16Vec2, "To SNorm16 2D Vector")
+IMPLEMENTATION_ADD(Conversions, DataType::SNorm16Vec4, "To SNorm16 4D Vector")
+IMPLEMENTATION_ADD(Conversions, DataType::UNorm16Vec2, "To UNorm16 2D Vector")
+IMPLEMENTATION_ADD(Conversions, DataType::UNorm16Vec4, "To UNorm16 4D Vector")
+IMPLEMENTATION_ADD(Conversions, DataType::SNorm2101010Rev, "To Packed 2-10-10-10 Normal")
+IMPLEMENTATION_ADD(Conversions, DataType::OctahedralSNorm16, "To Octahedral Normal")
 IMPLEMENTATION_END_ADD()
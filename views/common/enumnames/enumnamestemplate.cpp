@@ -39,6 +39,7 @@
 #include "data/blocks/framebufferobjectblock.h"
 #include "data/blocks/codegeneratorblock.h"
 #include "data/blocks/arraydatasourceblock.h"
+#include "data/blocks/parallelprimitiveblock.h"
 
 #include "data/rendercommands/drawrendercommand.h"
 
@@ -161,8 +162,18 @@ QMap<int, QString> EnumPropertyHelper::getNames(const EnumProperty* enumProperty
 
 
 	case PropertyID::Array_DataType:
+	case PropertyID::Readback_DataType:
+	case PropertyID::Primitive_DataType:
 		return ArrayDataSourceBlock::getDataTypeNames();
 
+	// Parallel Primitive
+	case PropertyID::Primitive_Primitive:
+		return ParallelPrimitiveBlock::getPrimitiveNames();
+	case PropertyID::Primitive_Operator:
+		return ParallelPrimitiveBlock::getOperatorNames();
+	case PropertyID::Primitive_SortOutput:
+		return ParallelPrimitiveBlock::getSortOutputNames();
+
 	default:
 		return QMap<int, QString>();
 	}
@@ -39,6 +39,7 @@ QColor YSMPalette::getBlockColor(BlockType blockType)
 	case BlockType::ImageLoader: return QColor("#446cb3");
 	case BlockType::TextureLoader: return QColor("#224A8E");
 	case BlockType::Array: return QColor("#33467A");
+	case BlockType::Readback: return QColor("#2C3E70");
 
 	//Texture data: Deep purple.
 	case BlockType::Texture: return QColor("#bf55ec");
@@ -48,6 +49,9 @@ QColor YSMPalette::getBlockColor(BlockType blockType)
 	//Data storage: Green.
 	case BlockType::Buffer: return QColor("#86e2d5");
 	case BlockType::Mixer: return QColor("#4ecdc4");
+	case BlockType::MeshOptimizer: return QColor("#36b5a0");
+	case BlockType::ParallelPrimitive: return QColor("#3a9fb5");
+	case BlockType::MeshLOD: return QColor("#2e9e8a");
 	case BlockType::VertexArrayObject: return QColor("#66cc99");
 
 	//Rendering: Mixed.
@@ -37,6 +37,8 @@
 #include <QAbstractItemView>
 #include <QToolTip>
 
+#include <algorithm>
+
 using namespace ysm;
 
 GLSLCompleterModel::GLSLCompleterModel(GLSLDocument* glslDocument, QObject* parent) :
@@ -50,65 +52,49 @@ GLSLCompleterModel::GLSLCompleterModel(GLSLDocument* glslDocument, QObject* pare
 	updateData();
 }
 
-void GLSLCompleterModel::findLocalScopeDeclarations(GLSLCodeBlock* codeBlock)
+QHash<QPair<int, int>, KeywordReader::KeywordList> GLSLCompleterModel::_keywordCache;
+
+KeywordReader::KeywordList GLSLCompleterModel::getKeywords(IBlock* block, int version)
 {
-	//Ensure the block exists.
-	if(!codeBlock) return;
+	//Check if the keywords have already been filtered.
+	QPair<int, int> key(block ? static_cast<int>(block->getType()) : -1, version);
+	QHash<QPair<int, int>, KeywordReader::KeywordList>::const_iterator it = _keywordCache.constFind(key);
+	if(it != _keywordCache.constEnd())
+		return it.value();
+
+	//Collect the completable keyword types.
+	KeywordReader::KeywordList keywords;
+	foreach(const KeywordReader::Keyword& keyword, KeywordReader().getKeywords())
+		if(keyword.type == GLSL_KEYWORDS_BUILTIN || keyword.type == GLSL_KEYWORDS_FUNCTIONS ||
+			keyword.type == GLSL_KEYWORDS_CONSTANT)
+			keywords.append(keyword);
 
-	//Get the local scope declarations.
-	foreach(GLSLDeclaration* declaration, codeBlock->getStatements<GLSLDeclaration>(GLSLStatementType::Declaration))
-	{
-		//If global scope, skip.
-		if(declaration->isGlobalScope())
-			continue;
+	//Filter the keywords.
+	if(version)
+		keywords = keywords.ofVersion(version);
+	if(block)
+		keywords = keywords.ofShader(block->getType());
 
-		//Do not add invalid declarations.
-		if(!declaration->getGLSLErrors().isEmpty())
-			continue;
+	//Remove all expression keywords.
+	for(int i = keywords.count() - 1; i >= 0; i--)
+		if(keywords[i].isRegex)
+			keywords.removeAt(i);
 
-		//Add all remaining declarations.
-		if(!_userKeywordNames.contains(declaration->getName()))
-		{
-			_userKeywordNames.append(declaration->getName());
-			_userKeywords.append(declaration);
-		}
-	}
+	//Sort by text, the order of equal texts is kept.
+	std::stable_sort(keywords.begin(), keywords.end(),
+		[](const KeywordReader::Keyword& a, const KeywordReader::Keyword& b) { return a.text < b.text; });
 
-	//Add all parent declarations.
-	findLocalScopeDeclarations(codeBlock->getParentBlock());
+	//Cache the keywords.
+	_keywordCache.insert(key, keywords);
+	return keywords;
 }
 
-void GLSLCompleterModel::findGlobalScopeDeclarations(GLSLCodeBlock* codeBlock)
+void GLSLCompleterModel::mergeEntries()
 {
-	//Ensure the block exists.
-	if(!codeBlock) return;
-
-	//Get the global scope declarations.
-	foreach(GLSLDeclaration* declaration, codeBlock->getStatements<GLSLDeclaration>(GLSLStatementType::Declaration, true))
-	{
-		//Do not add local scope declarations.
-		if(!declaration->isGlobalScope())
-			continue;
-
-		//Do not add instance declarations, they are contained because of their structural declaration.
-		if(declaration->getStructureDeclaration())
-			continue;
-
-		//Do not add structural declarations without instance declarations. Their members are accessed directly.
-		if(declaration->getDataType().isEmpty() && !declaration->getInstanceDeclaration())
-			continue;
-
-		//Do not add invalid declarations.
-		if(!declaration->getGLSLErrors().isEmpty())
-			continue;
-
-		//Add all remaining declarations.
-		if(!_userKeywordNames.contains(declaration->getName()))
-		{
-			_userKeywordNames.append(declaration->getName());
-			_userKeywords.append(declaration);
-		}
-	}
+	//Both lists are sorted already, user declarations come before equally named keywords.
+	_entries.resize(_userEntries.count() + _keywordEntries.count());
+	std::merge(_userEntries.constBegin(), _userEntries.constEnd(),
+		_keywordEntries.constBegin(), _keywordEntries.constEnd(), _entries.begin());
 }
 
 void GLSLCompleterModel::setCurrentBlock(GLSLCodeBlock* codeBlock)
@@ -116,42 +102,49 @@ void GLSLCompleterModel::setCurrentBlock(GLSLCodeBlock* codeBlock)
 	//Notify about changes.
 	beginResetModel();
 
-	//Update the user declarations.
-	_userKeywords.clear();
-	_userKeywordNames.clear();
+	//Ensure the symbol index matches the document's current code.
+	GLSLCodeBlock* rootBlock = _document->getFullCodeBlock();
+	if(rootBlock != _symbolIndex.getRootBlock())
+		_symbolIndex.rebuild(rootBlock);
 
-	findLocalScopeDeclarations(codeBlock);
-	findGlobalScopeDeclarations(_document->getFullCodeBlock());
+	//Update the user declarations.
+	_userEntries.clear();
+	foreach(GLSLDeclaration* declaration, _symbolIndex.getVisibleDeclarations(codeBlock))
+	{
+		GLSLDeclaration* instance = declaration->getInstanceDeclaration();
+		Entry entry = { instance ? instance->getName() : declaration->getName(), declaration, -1 };
+		_userEntries.append(entry);
+	}
+	std::stable_sort(_userEntries.begin(), _userEntries.end());
+	mergeEntries();
 
 	//Fire changes.
 	endResetModel();
 }
 
-void GLSLCompleterModel::updateData()
+void GLSLCompleterModel::updateData(GLSLCodeBlock* rootBlock)
 {
 	//Notify about changes.
 	beginResetModel();
 
+	//Index the verified code.
+	if(rootBlock)
+		_symbolIndex.rebuild(rootBlock);
+
 	//Get the document data.
 	int version = _document->getDocumentInfo()->getVersion().first;
 	IBlock* block = _document->getPipelineAdapter()->getBlock();
 
 	//Update the GLSL keywords.
-	_glslKeywords.clear();
-	_glslKeywords.append(KeywordReader().getKeywords().ofType(GLSL_KEYWORDS_BUILTIN));
-	_glslKeywords.append(KeywordReader().getKeywords().ofType(GLSL_KEYWORDS_FUNCTIONS));
-	_glslKeywords.append(KeywordReader().getKeywords().ofType(GLSL_KEYWORDS_CONSTANT));
-
-	//Filter the keywords.
-	if(version)
-		_glslKeywords = _glslKeywords.ofVersion(version);
-	if(block)
-		_glslKeywords = _glslKeywords.ofShader(block->getType());
-
-	//Remove all expression keywords.
-	for(int i = _glslKeywords.count() - 1; i >= 0; i--)
-		if(_glslKeywords[i].isRegex)
-			_glslKeywords.removeAt(i);
+	_glslKeywords = getKeywords(block, version);
+	_keywordEntries.clear();
+	_keywordEntries.reserve(_glslKeywords.count());
+	for(int i = 0; i < _glslKeywords.count(); i++)
+	{
+		Entry entry = { _glslKeywords[i].text, NULL, i };
+		_keywordEntries.append(entry);
+	}
+	mergeEntries();
 
 	//Fire changes.
 	endResetModel();
@@ -163,21 +156,22 @@ int GLSLCompleterModel::rowCount(const QModelIndex& parent) const
 	if(parent.isValid())
 		return 0;
 
-	//Return the appended count.
-	return _glslKeywords.count() + _userKeywords.count();
+	//Return the merged count.
+	return _entries.count();
 }
 
 QVariant GLSLCompleterModel::data(const QModelIndex& index, int role) const
 {
 	//Ensure index is valid.
 	int currentIndex = index.row();
-	if(currentIndex < 0)
+	if(currentIndex < 0 || currentIndex >= _entries.count())
 		return QVariant::Invalid;
 
-	//Check if in global scope range.
-	if(currentIndex < _userKeywords.count())
+	//Check if user declaration.
+	const Entry& entry = _entries[currentIndex];
+	if(entry.declaration)
 	{
-		GLSLDeclaration* declaration = _userKeywords[currentIndex];
+		GLSLDeclaration* declaration = entry.declaration;
 		GLSLDeclaration* instance = declaration->getInstanceDeclaration();
 		switch(role)
 		{
@@ -202,10 +196,9 @@ QVariant GLSLCompleterModel::data(const QModelIndex& index, int role) const
 	}
 
 	//Check if GLSL keyword.
-	currentIndex -= _userKeywords.count();
-	if(currentIndex < _glslKeywords.count())
+	if(entry.keyword >= 0)
 	{
-		KeywordReader::Keyword keyword = _glslKeywords[currentIndex];
+		const KeywordReader::Keyword& keyword = _glslKeywords[entry.keyword];
 		switch(role)
 		{
 		case Qt::DisplayRole:
@@ -256,6 +249,7 @@ GLSLCompleter::GLSLCompleter(GLSLDocument* glslDocument, QObject* parent) :
 	setPopup(new GLSLCompleterView());
 	setCompletionMode(QCompleter::PopupCompletion);
 	setCompletionRole(Qt::UserRole + 1);
+	setModelSorting(QCompleter::CaseSensitivelySortedModel);
 
 	//Connect signals and slots.
 	connect(_glslDocument, &GLSLDocument::contentsChanged, this, &GLSLCompleter::documentChanged);
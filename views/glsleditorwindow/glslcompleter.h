@@ -34,12 +34,14 @@
 #include "data/iblock.h"
 #include "opengl/glslparser/glsldocument.h"
 #include "opengl/glslparser/keywordreader.h"
+#include "opengl/glslparser/glslsymbolindex.h"
 
 namespace ysm
 {
 	class IGLSLCompleterDelegate;
 
 	//! \brief The completer's underlying model.
+	//! The rows are sorted case sensitively by their completion text, so the completer can search prefixes binary.
 	class GLSLCompleterModel : public QAbstractListModel
 	{
 		Q_OBJECT
@@ -73,35 +75,63 @@ namespace ysm
 	protected:
 
 		/*!
-		 * \brief Recursively finds global scope declarations.
-		 * \param codeBlock The code block to search in.
+		 * \brief Returns the completable GLSL keywords, sorted by their text.
+		 * The lists are cached for each combination of shader type and version.
+		 * \param block The shader block or NULL, if the keywords are not filtered by shader type.
+		 * \param version The GLSL version or zero, if the keywords are not filtered by version.
+		 * \return The keywords.
 		 */
-		void findGlobalScopeDeclarations(GLSLCodeBlock* codeBlock);
+		static KeywordReader::KeywordList getKeywords(IBlock* block, int version);
 
-		/*!
-		 * \brief Recursively finds local scope declarations.
-		 * \param codeBlock The code block to search in.
-		 */
-		void findLocalScopeDeclarations(GLSLCodeBlock* codeBlock);
+		//! \brief Merges the sorted user and keyword entries into the model's rows.
+		void mergeEntries();
 
 	protected slots:
 
-		//! \brief Update the internal data.
-		void updateData();
+		/*!
+		 * \brief Update the internal data.
+		 * \param rootBlock The verified root block.
+		 */
+		void updateData(GLSLCodeBlock* rootBlock = NULL);
 
 	private:
 
+		//! \brief A single completion, either a user declaration or a GLSL keyword.
+		struct Entry
+		{
+			//! \brief The completion text.
+			QString text;
+
+			//! \brief The user declaration or NULL, if keyword.
+			GLSLDeclaration* declaration;
+
+			//! \brief The index into the GLSL keywords or -1, if user declaration.
+			int keyword;
+
+			//! \brief Compares entries by their completion text.
+			bool operator<(const Entry& other) const { return text < other.text; }
+		};
+
 		//! \brief The underlying document.
 		GLSLDocument* _document;
 
+		//! \brief The declarations of all scopes of the document.
+		GLSLSymbolIndex _symbolIndex;
+
 		//! \brief The GLSL keywords.
 		KeywordReader::KeywordList _glslKeywords;
 
-		//! \brief List of all added user keyword names, to remove hidden elements.
-		QList<QString> _userKeywordNames;
+		//! \brief The GLSL keywords as entries, sorted by their text.
+		QVector<Entry> _keywordEntries;
+
+		//! \brief The user declarations visible in the current block as entries, sorted by their text.
+		QVector<Entry> _userEntries;
+
+		//! \brief The user declarations and GLSL keywords, sorted by their text.
+		QVector<Entry> _entries;
 
-		//! \brief The user keywords.
-		QList<GLSLDeclaration*> _userKeywords;
+		//! \brief The filtered GLSL keywords mapped to shader type and version.
+		static QHash<QPair<int, int>, KeywordReader::KeywordList> _keywordCache;
 
 	};
 
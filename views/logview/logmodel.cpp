@@ -0,0 +1,328 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "logmodel.h"
+#include "views/common/ysmpalette.h"
+
+#include <QDateTime>
+
+#include <algorithm>
+
+using namespace ysm;
+
+//Number of records kept in the history.
+#define LOG_MODEL_CAPACITY 100000
+
+//Length of the rate limiting window in milliseconds and the number of records a source may log per window.
+#define LOG_RATE_WINDOW 1000
+#define LOG_RATE_LIMIT 100
+
+//History indices are normalized before they can overflow.
+#define LOG_INDEX_LIMIT (1 << 30)
+
+LogModel::LogModel(QObject* parent) :
+	QAbstractTableModel(parent),
+	_records(LOG_MODEL_CAPACITY),
+	_severityFilter(LogSeverity::Debug),
+	_blockFilter(-1)
+{ }
+
+int LogModel::rowCount(const QModelIndex& parent) const
+{
+	if(parent.isValid())
+		return 0;
+
+	return _rows.size();
+}
+
+int LogModel::columnCount(const QModelIndex& parent) const
+{
+	if(parent.isValid())
+		return 0;
+
+	return ColumnCount;
+}
+
+QVariant LogModel::data(const QModelIndex& index, int role) const
+{
+	if(!index.isValid() || index.row() >= _rows.size())
+		return QVariant();
+
+	const LogRecord& record = _records.at(_rows.at(index.row()));
+	if(role == Qt::DisplayRole)
+	{
+		switch(index.column())
+		{
+			case TimeColumn:
+				return QDateTime::fromMSecsSinceEpoch(record._timestamp).toString("hh:mm:ss.zzz");
+
+			case SeverityColumn:
+				switch(record._severity)
+				{
+					case LogSeverity::Debug: return tr("Debug");
+					case LogSeverity::Info: return tr("Info");
+					case LogSeverity::Warning: return tr("Warning");
+					case LogSeverity::Error: return tr("Error");
+				}
+				break;
+
+			case BlockColumn:
+				return record._blockId < 0 ? QString() : QString("#%1").arg(record._blockId);
+
+			case CategoryColumn:
+				return record._category;
+
+			case MessageColumn:
+				if(record._repeatCount > 1)
+					return QString("%1 (%2x)").arg(record._message).arg(record._repeatCount);
+				return record._message;
+		}
+	}
+	else if(role == Qt::ForegroundRole)
+	{
+		//Highlight problems, using the same colors as the pipeline items.
+		if(record._severity == LogSeverity::Error)
+			return YSMPalette::getPipelineItemStatusColor(PipelineItemStatus::Sick);
+		if(record._severity == LogSeverity::Warning)
+			return YSMPalette::getPipelineItemStatusColor(PipelineItemStatus::Chilled);
+	}
+	else if(role == Qt::ToolTipRole && index.column() == MessageColumn)
+		return record._message;
+
+	return QVariant();
+}
+
+QVariant LogModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if(orientation != Qt::Horizontal || role != Qt::DisplayRole)
+		return QVariant();
+
+	switch(section)
+	{
+		case TimeColumn: return tr("Time");
+		case SeverityColumn: return tr("Severity");
+		case BlockColumn: return tr("Block");
+		case CategoryColumn: return tr("Category");
+		case MessageColumn: return tr("Message");
+	}
+
+	return QVariant();
+}
+
+QVector<LogRecord> LogModel::appendRecords(const QVector<LogRecord>& records, qint64 time)
+{
+	QVector<LogRecord> addedRecords;
+	int firstChanged = -1, lastChanged = -1;
+
+	//Normalize the history indices before they overflow. This only shifts the internal indices, the rows stay the same.
+	if(_records.lastIndex() >= LOG_INDEX_LIMIT)
+	{
+		int shift = _records.firstIndex();
+		_records.normalizeIndexes();
+		shift -= _records.firstIndex();
+
+		for(int i = 0; i < _rows.size(); i++)
+			_rows[i] -= shift;
+		for(auto source = _sources.begin(); source != _sources.end(); ++source)
+			source.value()._lastRecord -= shift;
+	}
+
+	//Report suppressed records of finished windows, also when the source is idle.
+	auto reportSuppressed = [&](const QPair<int, QString>& key, Source& source)
+	{
+		if(source._suppressedCount == 0)
+			return;
+
+		LogRecord record(LogSeverity::Warning, key.second,
+			tr("%1 similar messages were suppressed.").arg(source._suppressedCount), key.first);
+		record._timestamp = time;
+		source._suppressedCount = 0;
+		source._lastRecord = storeRecord(record);
+		addedRecords.append(record);
+	};
+
+	for(auto source = _sources.begin(); source != _sources.end();)
+	{
+		if(time - source.value()._windowStart < LOG_RATE_WINDOW)
+		{
+			++source;
+			continue;
+		}
+
+		reportSuppressed(source.key(), source.value());
+
+		//Forget idle sources, whose last record left the history.
+		if(!_records.containsIndex(source.value()._lastRecord))
+			source = _sources.erase(source);
+		else
+		{
+			source.value()._windowStart = time;
+			source.value()._recordCount = 0;
+			++source;
+		}
+	}
+
+	foreach(const LogRecord& record, records)
+	{
+		QPair<int, QString> key(record._blockId, record._category);
+		auto sourceIterator = _sources.find(key);
+		if(sourceIterator == _sources.end())
+		{
+			Source newSource;
+			newSource._windowStart = record._timestamp;
+			newSource._recordCount = 0;
+			newSource._suppressedCount = 0;
+			newSource._lastRecord = -1;
+			sourceIterator = _sources.insert(key, newSource);
+		}
+
+		Source& source = sourceIterator.value();
+		if(record._timestamp - source._windowStart >= LOG_RATE_WINDOW)
+		{
+			reportSuppressed(key, source);
+			source._windowStart = record._timestamp;
+			source._recordCount = 0;
+		}
+
+		//Merge repetitions of the source's last message.
+		if(_records.containsIndex(source._lastRecord))
+		{
+			LogRecord& lastRecord = _records[source._lastRecord];
+			if(lastRecord._severity == record._severity && lastRecord._message == record._message)
+			{
+				lastRecord._repeatCount += record._repeatCount;
+				lastRecord._timestamp = record._timestamp;
+
+				if(firstChanged < 0 || source._lastRecord < firstChanged)
+					firstChanged = source._lastRecord;
+				lastChanged = qMax(lastChanged, source._lastRecord);
+				continue;
+			}
+		}
+
+		//Drop the record if the source exceeds its rate.
+		if(source._recordCount >= LOG_RATE_LIMIT)
+		{
+			source._suppressedCount++;
+			continue;
+		}
+
+		source._recordCount++;
+		source._lastRecord = storeRecord(record);
+		addedRecords.append(record);
+	}
+
+	//Remove the rows of records that left the history.
+	int evictedRows = std::lower_bound(_rows.begin(), _rows.end(), _records.firstIndex()) - _rows.begin();
+	if(evictedRows > 0)
+	{
+		beginRemoveRows(QModelIndex(), 0, evictedRows - 1);
+		_rows.remove(0, evictedRows);
+		endRemoveRows();
+	}
+
+	//Announce the new rows at once.
+	auto pendingRow = std::lower_bound(_pendingRows.begin(), _pendingRows.end(), _records.firstIndex());
+	_pendingRows.erase(_pendingRows.begin(), pendingRow);
+	if(!_pendingRows.isEmpty())
+	{
+		beginInsertRows(QModelIndex(), _rows.size(), _rows.size() + _pendingRows.size() - 1);
+		_rows += _pendingRows;
+		endInsertRows();
+	}
+
+	_pendingRows.clear();
+
+	//Update the merged rows.
+	if(firstChanged >= 0)
+	{
+		int firstRow = std::lower_bound(_rows.begin(), _rows.end(), firstChanged) - _rows.begin();
+		int lastRow = std::upper_bound(_rows.begin(), _rows.end(), lastChanged) - _rows.begin() - 1;
+		if(firstRow <= lastRow)
+			emit dataChanged(index(firstRow, 0), index(lastRow, ColumnCount - 1));
+	}
+
+	return addedRecords;
+}
+
+void LogModel::clear()
+{
+	beginResetModel();
+	_records.clear();
+	_rows.clear();
+	_pendingRows.clear();
+	_sources.clear();
+	endResetModel();
+}
+
+void LogModel::setSeverityFilter(LogSeverity severity)
+{
+	if(_severityFilter == severity)
+		return;
+
+	_severityFilter = severity;
+	updateRows();
+}
+
+void LogModel::setBlockFilter(int blockId)
+{
+	if(_blockFilter == blockId)
+		return;
+
+	_blockFilter = blockId;
+	updateRows();
+}
+
+bool LogModel::isVisible(const LogRecord& record) const
+{
+	if(record._severity < _severityFilter)
+		return false;
+
+	return _blockFilter < 0 || record._blockId == _blockFilter;
+}
+
+int LogModel::storeRecord(const LogRecord& record)
+{
+	//Appending to the full history evicts the oldest record, its row is removed by the caller.
+	_records.append(record);
+
+	int index = _records.lastIndex();
+	if(isVisible(record))
+		_pendingRows.append(index);
+
+	return index;
+}
+
+void LogModel::updateRows()
+{
+	beginResetModel();
+
+	_rows.clear();
+	for(int i = _records.firstIndex(); i <= _records.lastIndex() && !_records.isEmpty(); i++)
+		if(isVisible(_records.at(i)))
+			_rows.append(i);
+
+	endResetModel();
+}
@@ -0,0 +1,171 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef LOGMODEL_H
+#define LOGMODEL_H
+
+#include "logstore.h"
+
+#include <QAbstractTableModel>
+#include <QContiguousCache>
+#include <QHash>
+#include <QPair>
+
+namespace ysm
+{
+
+	//! \brief Table model of the logged records. Keeps a bounded history, merges repeated messages, limits the
+	//! message rate per source and filters the records by severity and source block.
+	class LogModel : public QAbstractTableModel
+	{
+		Q_OBJECT
+
+	public:
+
+		//! \brief The model's columns.
+		enum Column
+		{
+			TimeColumn,
+			SeverityColumn,
+			BlockColumn,
+			CategoryColumn,
+			MessageColumn,
+			ColumnCount,
+		};
+
+		/*!
+		 * \brief Initialize new instance.
+		 * \param parent The parent.
+		 */
+		explicit LogModel(QObject* parent);
+
+		/*!
+		 * \brief Get the row count.
+		 * \param parent The parent index.
+		 * \return The number of visible records.
+		 */
+		int rowCount(const QModelIndex& parent) const Q_DECL_OVERRIDE;
+
+		/*!
+		 * \brief Get the column count.
+		 * \param parent The parent index.
+		 * \return The column count.
+		 */
+		int columnCount(const QModelIndex& parent) const Q_DECL_OVERRIDE;
+
+		/*!
+		 * \brief Get the data.
+		 * \param index The model index.
+		 * \param role The role.
+		 * \return The data.
+		 */
+		QVariant data(const QModelIndex& index, int role) const Q_DECL_OVERRIDE;
+
+		/*!
+		 * \brief Get the header data.
+		 * \param section The section.
+		 * \param orientation The orientation.
+		 * \param role The role.
+		 * \return The header data.
+		 */
+		QVariant headerData(int section, Qt::Orientation orientation, int role) const Q_DECL_OVERRIDE;
+
+		/*!
+		 * \brief Adds the given records, after merging and rate limiting them.
+		 * \param records The new records.
+		 * \param time The current time, in milliseconds since epoch.
+		 * \return The records that were added as new rows.
+		 */
+		QVector<LogRecord> appendRecords(const QVector<LogRecord>& records, qint64 time);
+
+		//! \brief Removes all records.
+		void clear();
+
+		/*!
+		 * \brief Only shows records with at least the given severity.
+		 * \param severity The minimum severity.
+		 */
+		void setSeverityFilter(LogSeverity severity);
+
+		/*!
+		 * \brief Only shows records of the given source block.
+		 * \param blockId The block's ID or -1, to show the records of all blocks.
+		 */
+		void setBlockFilter(int blockId);
+
+	protected:
+
+		/*!
+		 * \brief Checks if the record passes the filters.
+		 * \param record The record.
+		 * \return True, if the record is visible.
+		 */
+		bool isVisible(const LogRecord& record) const;
+
+		/*!
+		 * \brief Stores a record in the history.
+		 * \param record The record.
+		 * \return The record's index in the history.
+		 */
+		int storeRecord(const LogRecord& record);
+
+		//! \brief Recreates the visible rows.
+		void updateRows();
+
+	private:
+
+		//! \brief State of a single log source, identified by block and category.
+		struct Source
+		{
+			//! \brief Start of the current rate limiting window.
+			qint64 _windowStart;
+
+			//! \brief Records added and suppressed during the current window.
+			int _recordCount, _suppressedCount;
+
+			//! \brief History index of the source's last record, used to merge repetitions.
+			int _lastRecord;
+		};
+
+		//! \brief The bounded record history.
+		QContiguousCache<LogRecord> _records;
+
+		//! \brief The history indices of the visible records, in ascending order.
+		QVector<int> _rows;
+
+		//! \brief History indices of new visible records, that are not yet announced as rows.
+		QVector<int> _pendingRows;
+
+		//! \brief The log sources.
+		QHash<QPair<int, QString>, Source> _sources;
+
+		//! \brief The filters.
+		LogSeverity _severityFilter;
+		int _blockFilter;
+	};
+
+}
+
+#endif // LOGMODEL_H
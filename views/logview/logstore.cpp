@@ -0,0 +1,123 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "logstore.h"
+
+#include <QDateTime>
+
+using namespace ysm;
+
+//Number of queued records, must be a power of two.
+#define LOG_STORE_CAPACITY 16384
+
+LogRecord::LogRecord() :
+	_timestamp(0),
+	_severity(LogSeverity::Info),
+	_blockId(-1),
+	_repeatCount(1)
+{ }
+
+LogRecord::LogRecord(LogSeverity severity, const QString& category, const QString& message, int blockId) :
+	_timestamp(QDateTime::currentMSecsSinceEpoch()),
+	_severity(severity),
+	_blockId(blockId),
+	_category(category),
+	_message(message),
+	_repeatCount(1)
+{ }
+
+LogStore* LogStore::getInstance()
+{
+	//Created on first use, which is thread safe.
+	static LogStore logStore;
+	return &logStore;
+}
+
+LogStore::LogStore() :
+	_tail(0),
+	_head(0),
+	_droppedCount(0)
+{
+	//Every slot is initially free for the producer at its position.
+	_slots = new Slot[LOG_STORE_CAPACITY];
+	for(quint32 i = 0; i < LOG_STORE_CAPACITY; i++)
+		_slots[i]._sequence.storeRelease(i);
+}
+
+LogStore::~LogStore() { delete[] _slots; }
+
+bool LogStore::push(const LogRecord& record)
+{
+	quint32 position = _tail.loadAcquire();
+	forever
+	{
+		Slot& slot = _slots[position & (LOG_STORE_CAPACITY - 1)];
+		qint32 difference = static_cast<qint32>(slot._sequence.loadAcquire() - position);
+
+		if(difference == 0)
+		{
+			//The slot is free, try to claim the position.
+			if(_tail.testAndSetOrdered(position, position + 1, position))
+			{
+				//Publish the record to the consumer.
+				slot._record = record;
+				slot._sequence.storeRelease(position + 1);
+				return true;
+			}
+		}
+		else if(difference < 0)
+		{
+			//The consumer did not free the slot yet, the queue is full.
+			_droppedCount.fetchAndAddRelaxed(1);
+			return false;
+		}
+		else
+			position = _tail.loadAcquire();
+	}
+}
+
+int LogStore::drain(QVector<LogRecord>& records, int maxRecords)
+{
+	int count = 0;
+	while(count < maxRecords)
+	{
+		//Ensure the record at the head is published.
+		Slot& slot = _slots[_head & (LOG_STORE_CAPACITY - 1)];
+		if(static_cast<qint32>(slot._sequence.loadAcquire() - (_head + 1)) != 0)
+			break;
+
+		//Take the record and free the slot for the next round.
+		records.append(slot._record);
+		slot._record = LogRecord();
+		slot._sequence.storeRelease(_head + LOG_STORE_CAPACITY);
+
+		_head++;
+		count++;
+	}
+
+	return count;
+}
+
+int LogStore::takeDroppedCount() { return _droppedCount.fetchAndStoreRelaxed(0); }
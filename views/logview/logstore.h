@@ -0,0 +1,140 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef LOGSTORE_H
+#define LOGSTORE_H
+
+#include <QAtomicInteger>
+#include <QString>
+#include <QVector>
+
+namespace ysm
+{
+
+	//! \brief Severity of a log record, in ascending order.
+	enum class LogSeverity
+	{
+		Debug,
+		Info,
+		Warning,
+		Error,
+	};
+
+	//! \brief A single structured log message.
+	struct LogRecord
+	{
+		//! \brief Initialize new instance.
+		LogRecord();
+
+		/*!
+		 * \brief Initialize new instance, using the current time.
+		 * \param severity The severity.
+		 * \param category The category, e.g. "Rendering".
+		 * \param message The message.
+		 * \param blockId The ID of the source block or -1, if the message has no source block.
+		 */
+		LogRecord(LogSeverity severity, const QString& category, const QString& message, int blockId);
+
+		//! \brief The time the message was logged, in milliseconds since epoch.
+		qint64 _timestamp;
+
+		//! \brief The message's severity.
+		LogSeverity _severity;
+
+		//! \brief The ID of the source block or -1.
+		int _blockId;
+
+		//! \brief The message's category and text.
+		QString _category, _message;
+
+		//! \brief How often the message was logged in a row.
+		int _repeatCount;
+	};
+
+	//! \brief Bounded, lock-free queue of log records. Any thread can log records, a single consumer (the log view)
+	//! drains them. When the queue is full, new records are dropped and counted instead of blocking the logging thread.
+	class LogStore
+	{
+
+	public:
+
+		/*!
+		 * \brief Returns the application's log store.
+		 * \return The log store.
+		 */
+		static LogStore* getInstance();
+
+		//! \brief Destruct instance.
+		~LogStore();
+
+		/*!
+		 * \brief Enqueues a record. Can be called from any thread.
+		 * \param record The record.
+		 * \return False, if the queue was full and the record was dropped.
+		 */
+		bool push(const LogRecord& record);
+
+		/*!
+		 * \brief Dequeues the available records. Must only be called by a single consumer thread.
+		 * \param records The list, the records are appended to.
+		 * \param maxRecords The maximum number of records to dequeue.
+		 * \return The number of dequeued records.
+		 */
+		int drain(QVector<LogRecord>& records, int maxRecords);
+
+		/*!
+		 * \brief Returns the number of records that were dropped since the last call and resets it.
+		 * \return The dropped record count.
+		 */
+		int takeDroppedCount();
+
+	private:
+
+		//! \brief Initialize new instance.
+		LogStore();
+
+		//! \brief A queue slot. The sequence tells producers and the consumer, whose turn it is.
+		struct Slot
+		{
+			QAtomicInteger<quint32> _sequence;
+			LogRecord _record;
+		};
+
+		//! \brief The ring buffer.
+		Slot* _slots;
+
+		//! \brief The next position to write, shared by all producers.
+		QAtomicInteger<quint32> _tail;
+
+		//! \brief The next position to read, only used by the consumer.
+		quint32 _head;
+
+		//! \brief The number of dropped records.
+		QAtomicInt _droppedCount;
+	};
+
+}
+
+#endif // LOGSTORE_H
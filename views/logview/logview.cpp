@@ -24,50 +24,151 @@
  ***********************************************************************************/
 
 #include "logview.h"
+#include "logmodel.h"
 #include "../mainwindow/mainwindow.h"
 #include "../mainwindow/viewmanager.h"
 
+#include "data/ipipelineitem.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QPushButton>
+#include <QScrollBar>
+#include <QVBoxLayout>
+
 using namespace ysm;
 
+//Interval of moving queued records to the table in milliseconds and the maximum number of records moved at once.
+#define LOG_DRAIN_INTERVAL 50
+#define LOG_DRAIN_LIMIT 2000
+
 LogView::LogView(QWidget* parentWidget, IView* parentView) :
 	QDockWidget(parentWidget),
 	View(parentView)
 {
-	//Initialize the output widget.
-	_textLog = new QPlainTextEdit(this);
-	_textLog->setReadOnly(true);
+	//Initialize the model and the table, uniform rows keep large logs fast.
+	_model = new LogModel(this);
+	_table = new QTreeView();
+	_table->setModel(_model);
+	_table->setRootIsDecorated(false);
+	_table->setUniformRowHeights(true);
+	_table->setItemsExpandable(false);
+	_table->setAlternatingRowColors(true);
+	_table->setSelectionMode(QAbstractItemView::ExtendedSelection);
+	_table->header()->setStretchLastSection(true);
+	_table->setColumnWidth(LogModel::TimeColumn, 90);
+	_table->setColumnWidth(LogModel::SeverityColumn, 70);
+	_table->setColumnWidth(LogModel::BlockColumn, 50);
+	_table->setColumnWidth(LogModel::CategoryColumn, 110);
+
+	//Initialize the filters.
+	_severityFilter = new QComboBox();
+	_severityFilter->addItem(tr("All"), static_cast<int>(LogSeverity::Debug));
+	_severityFilter->addItem(tr("Info and above"), static_cast<int>(LogSeverity::Info));
+	_severityFilter->addItem(tr("Warnings and errors"), static_cast<int>(LogSeverity::Warning));
+	_severityFilter->addItem(tr("Errors only"), static_cast<int>(LogSeverity::Error));
+	_severityFilter->setCurrentIndex(1);
+
+	_blockFilter = new QCheckBox(tr("Selected block only"));
+
+	QPushButton* clearButton = new QPushButton(tr("Clear"));
+
+	QHBoxLayout* filterLayout = new QHBoxLayout();
+	filterLayout->addWidget(_severityFilter);
+	filterLayout->addWidget(_blockFilter);
+	filterLayout->addStretch();
+	filterLayout->addWidget(clearButton);
+
+	//Use the table below the filters.
+	QWidget* container = new QWidget(this);
+	QVBoxLayout* layout = new QVBoxLayout(container);
+	layout->setContentsMargins(0, 0, 0, 0);
+	layout->addLayout(filterLayout);
+	layout->addWidget(_table);
+	setWidget(container);
 
-	//Use the output widget.
-	setWidget(_textLog);
+	connect(_severityFilter, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &LogView::updateFilters);
+	connect(_blockFilter, &QCheckBox::toggled, this, &LogView::updateFilters);
+	connect(clearButton, &QPushButton::clicked, this, &LogView::clear);
+	updateFilters();
+
+	//Periodically move the records, which might be logged by any thread, to the table.
+	_drainTimer = new QTimer(this);
+	_drainTimer->setInterval(LOG_DRAIN_INTERVAL);
+	connect(_drainTimer, &QTimer::timeout, this, &LogView::drainRecords);
+	_drainTimer->start();
 }
 
 void LogView::clear()
 {
-	//Access the active log view to clear it.
+	//Access the active log view to clear it, including the records that are still queued.
 	LogView* activeLog = MainWindow::getInstance()->getViewManager()->getLogView();
-	activeLog->_textLog->clear();
+
+	QVector<LogRecord> queuedRecords;
+	while(LogStore::getInstance()->drain(queuedRecords, LOG_DRAIN_LIMIT) > 0)
+		queuedRecords.clear();
+
+	activeLog->_model->clear();
 }
 
 void LogView::log(const QString &log)
 {
-	//Also log to debug console.
-	qDebug() << log;
-
-	//Access the active log view to log the message.
-	LogView* activeLog = MainWindow::getInstance()->getViewManager()->getLogView();
-	activeLog->_textLog->appendPlainText(log);
+	LogView::log(LogSeverity::Info, "General", log);
 }
 
 void LogView::log(const QStringList &log)
 {
-	//Also log to debug console.
-	qDebug() << log;
-
-	//Access the active log view to log the message.
-	LogView* activeLog = MainWindow::getInstance()->getViewManager()->getLogView();
 	foreach(QString message, log)
-		activeLog->_textLog->appendPlainText(message);
+		LogView::log(LogSeverity::Info, "General", message);
+}
+
+void LogView::log(LogSeverity severity, const QString& category, const QString& message, int blockId)
+{
+	//Log every line separately, which keeps the table's rows uniform.
+	foreach(const QString& line, message.split('\n', QString::SkipEmptyParts))
+		LogStore::getInstance()->push(LogRecord(severity, category, line.trimmed(), blockId));
 }
 
 void LogView::updateDocument() { }
-void LogView::updateItem() { }
+
+void LogView::updateItem()
+{
+	//The block filter follows the selection.
+	updateFilters();
+}
+
+void LogView::drainRecords()
+{
+	QVector<LogRecord> records;
+	LogStore::getInstance()->drain(records, LOG_DRAIN_LIMIT);
+
+	//Report records that did not fit into the queue.
+	int droppedCount = LogStore::getInstance()->takeDroppedCount();
+	if(droppedCount > 0)
+		records.append(LogRecord(LogSeverity::Warning, "Log", tr("%1 messages were dropped, the log is flooded.").arg(droppedCount), -1));
+
+	//Keep following the log, if it is scrolled to the end.
+	QScrollBar* scrollBar = _table->verticalScrollBar();
+	bool followLog = scrollBar->value() == scrollBar->maximum();
+
+	//Also log the added records to the debug console.
+	QVector<LogRecord> addedRecords = _model->appendRecords(records, QDateTime::currentMSecsSinceEpoch());
+	foreach(const LogRecord& record, addedRecords)
+		qDebug() << record._category << record._message;
+
+	if(followLog && !addedRecords.isEmpty())
+		_table->scrollToBottom();
+}
+
+void LogView::updateFilters()
+{
+	_model->setSeverityFilter(static_cast<LogSeverity>(_severityFilter->currentData().toInt()));
+
+	//Only filter by block, if a block is selected.
+	if(_blockFilter->isChecked() && getActiveItem())
+		_model->setBlockFilter(static_cast<int>(getActiveItem()->getID()));
+	else
+		_model->setBlockFilter(-1);
+}
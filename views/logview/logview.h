@@ -27,14 +27,20 @@
 #define LOGVIEW_H
 
 #include "../view.h"
+#include "logstore.h"
 
+#include <QCheckBox>
+#include <QComboBox>
 #include <QDockWidget>
-#include <QPlainTextEdit>
+#include <QTimer>
+#include <QTreeView>
 
 namespace ysm
 {
+	class LogModel;
 
-	//! \brief Simply log view that displays output to the user.
+	//! \brief Log view that displays structured output to the user. Records are queued by any thread and periodically
+	//! moved to a virtualized table, which can be filtered by severity and by the selected block.
 	class LogView : public QDockWidget, public View
 	{
 		Q_OBJECT
@@ -53,7 +59,7 @@ namespace ysm
 
 		/*!
 		 * \brief Convenience method to log the given message to the main window's log view.
-		 * \param log The message.
+		 * \param log The message, each line is logged as a separate record.
 		 */
 		static void log(const QString& log);
 
@@ -63,6 +69,15 @@ namespace ysm
 		 */
 		static void log(const QStringList& log);
 
+		/*!
+		 * \brief Logs a structured message to the main window's log view. Can be called from any thread.
+		 * \param severity The severity.
+		 * \param category The category, e.g. "Rendering".
+		 * \param message The message, each line is logged as a separate record.
+		 * \param blockId The ID of the source block or -1, if the message has no source block.
+		 */
+		static void log(LogSeverity severity, const QString& category, const QString& message, int blockId = -1);
+
 	protected:
 
 		//! \brief Called whenever the selected document might have changed.
@@ -71,10 +86,28 @@ namespace ysm
 		//! \brief Called whenever the selected item might have changed.
 		void updateItem() Q_DECL_OVERRIDE;
 
+	protected slots:
+
+		//! \brief Moves the queued records to the table.
+		void drainRecords();
+
+		//! \brief Applies the selected filters.
+		void updateFilters();
+
 	private:
 
-		//! \brief Simple text log.
-		QPlainTextEdit* _textLog;
+		//! \brief The logged records.
+		LogModel* _model;
+
+		//! \brief Table displaying the records.
+		QTreeView* _table;
+
+		//! \brief The filter widgets.
+		QComboBox* _severityFilter;
+		QCheckBox* _blockFilter;
+
+		//! \brief Periodically drains the queued records.
+		QTimer* _drainTimer;
 	};
 
 }
@@ -41,6 +41,8 @@
 #include "views/pipelineview/pipelineview.h"
 #include "views/pipelineview/pipelinetab.h"
 #include "views/pipelineview/pipelinescene.h"
+#include "views/pipelineview/pipelinescenelayouter.h"
+#include "views/logview/logview.h"
 
 #include "views/wizardwindow/dialogs/wizardselectdialog.h"
 #include "views/wizardwindow/dialogs/wizardoverviewdialog.h"
@@ -210,14 +212,48 @@ void MainDelegate::onRedo()
 }
 
 void MainDelegate::onAutoLayout()
+{
+	//Layout the whole pipeline.
+	startAutoLayout(false);
+}
+
+void MainDelegate::onIncrementalLayout()
+{
+	//Only layout new and changed blocks.
+	startAutoLayout(true);
+}
+
+void MainDelegate::startAutoLayout(bool incremental)
 {
 	//Find the active layouter.
 	Document* activeDocument = _mainWindow->getActiveDocument();
 	PipelineTab* activeTab = _mainWindow->getViewManager()->getPipelineView()->findTab(activeDocument);
 	PipelineSceneLayouter* layouter = activeTab->getPipelineScene()->getLayouter();
 
+	//Calculate the layout in the background, the layout command is executed when it's finished.
+	connect(layouter, &PipelineSceneLayouter::autoLayoutFinished, this, &MainDelegate::autoLayoutFinished,
+			Qt::UniqueConnection);
+	layouter->startAutoLayout(activeDocument->getPipeline(), incremental);
+}
+
+void MainDelegate::autoLayoutFinished(IPipeline* pipeline)
+{
+	//Drop the layout, if the pipeline's document is not active anymore.
+	PipelineSceneLayouter* layouter = qobject_cast<PipelineSceneLayouter*>(sender());
+	Document* activeDocument = _mainWindow->getActiveDocument();
+	if(!activeDocument || activeDocument->getPipeline() != pipeline)
+	{
+		layouter->discardFinishedAutoLayout();
+		return;
+	}
+
+	//Store the layout and report its statistics.
+	layouter->applyFinishedAutoLayout();
+	LogView::log(LogSeverity::Info, "Layout", QString("Auto layout finished in %1 ms with %2 edge crossings.")
+				 .arg(layouter->getAutoLayoutTime()).arg(layouter->getAutoLayoutCrossingCount()));
+
 	//Execute the layout command.
-	_mainWindow->executeCommand(new AutoLayoutItemsCommand(activeDocument->getPipeline(), layouter));
+	_mainWindow->executeCommand(new AutoLayoutItemsCommand(pipeline, layouter));
 }
 
 void MainDelegate::onRender()
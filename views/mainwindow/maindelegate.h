@@ -31,6 +31,7 @@
 namespace ysm
 {
 	class MainWindow;
+	class IPipeline;
 
 	//! \brief Class that manages the main window's actions.
 	//! By outsourcing the actions to a seperate class, main menu and main tool bar can use the same actions, without
@@ -68,6 +69,7 @@ namespace ysm
 
 		//! \brief Pipeline actions.
 		void onAutoLayout();
+		void onIncrementalLayout();
 
 		//! \brief Rendering actions.
 		void onRender();
@@ -104,6 +106,22 @@ namespace ysm
 		 */
 		QString showExportDialog();
 
+	protected slots:
+
+		/*!
+		 * \brief Reports the auto layout and applies it to the pipeline.
+		 * \param pipeline The layouted pipeline.
+		 */
+		void autoLayoutFinished(IPipeline* pipeline);
+
+	protected:
+
+		/*!
+		 * \brief Starts to auto layout the active document's pipeline.
+		 * \param incremental If true, only new blocks and blocks with changed connections are layouted.
+		 */
+		void startAutoLayout(bool incremental);
+
 	private:
 
 		//! \brief Reference to the main window.
@@ -61,6 +61,8 @@ MainToolBar::MainToolBar(MainDelegate* delegate, MainWindow* parentWindow) :
 	ITEM_M(_saveAsAction, "Save as", ":/tango/24x24/actions/document-save-as", onSaveAs);
 	ITEM_S;
 	ITEM_M(_autoLayoutAction, "Auto layout", ":/tango/24x24/stock/image/stock_modify-layout", onAutoLayout);
+	ITEM_M(_incrementalLayoutAction, "Layout changes", ":/tango/24x24/stock/image/stock_graphics-align-centered",
+		   onIncrementalLayout);
 	ITEM_S;
 	ITEM_M(_validateAction, "Validate", ":/tango/24x24/stock/generic/stock_mark", onValidate);
 	ITEM_M(_renderAction, "Render", ":/tango/24x24/actions/", onRender);
@@ -78,6 +80,7 @@ void MainToolBar::updateToolBar()
 	_saveAction->setEnabled(_document);
 	_saveAsAction->setEnabled(_document);
 	_autoLayoutAction->setEnabled(_document);
+	_incrementalLayoutAction->setEnabled(_document);
 	_validateAction->setEnabled(_document);
 
 	//Check wether rendering is possible
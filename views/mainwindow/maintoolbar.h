@@ -82,6 +82,7 @@ namespace ysm
 		QAction* _saveAction;
 		QAction* _saveAsAction;
 		QAction* _autoLayoutAction;
+		QAction* _incrementalLayoutAction;
 		QAction* _validateAction;
 		QAction* _renderAction;
 	};
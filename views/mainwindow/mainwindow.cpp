@@ -34,6 +34,7 @@
 #include "maindelegate.h"
 
 #include <QSettings>
+#include <QStatusBar>
 
 using namespace ysm;
 
@@ -97,6 +98,17 @@ void MainWindow::updateTitles()
 	//Update the title.
 	setWindowTitle(getActiveDocument() ? "[*] " + getActiveDocument()->getName() : "quiGLy");
 	setWindowModified(getActiveDocument() && getActiveDocument()->hasUnsavedChanges());
+
+	//Show the undo history's memory usage.
+	if(getActiveDocument())
+	{
+		IUICommandQueue* commandQueue = getActiveDocument()->getCommandQueue();
+		statusBar()->showMessage(tr("Undo history: %1 MB of %2 MB")
+			.arg(commandQueue->getHistorySize() / 1048576.0, 0, 'f', 1)
+			.arg(commandQueue->getHistoryBudget() / 1048576.0, 0, 'f', 0));
+	}
+	else
+		statusBar()->clearMessage();
 }
 
 void MainWindow::updateDocument()
@@ -33,6 +33,7 @@
 #include "../document.h"
 
 #include "../logview/logview.h"
+#include "../memoryview/memoryview.h"
 #include "../toolview/toolview.h"
 #include "../commandview/commandview.h"
 #include "../propertyview/propertyview.h"
@@ -74,6 +75,9 @@ ViewManager::ViewManager(MainWindow* parentWindow) :
 
 	//Create dock widgets.
 	WIDGET_D(_logView, LogView, Qt::BottomDockWidgetArea, "Log", 350);
+	WIDGET_D(_memoryView, MemoryView, Qt::BottomDockWidgetArea, "Memory", 350);
+	_parentWindow->tabifyDockWidget(_logView, _memoryView);
+	_logView->raise();
 	WIDGET_D(_toolView, ToolView, Qt::LeftDockWidgetArea, "Blocks", 50);
 	WIDGET_D(_commandView, CommandView, Qt::LeftDockWidgetArea, "Commands", 50);
 	WIDGET_D(_propertyView, PropertyView, Qt::RightDockWidgetArea, "Properties", 350);
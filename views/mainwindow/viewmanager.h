@@ -36,6 +36,7 @@ namespace ysm
 	class MainToolBar;
 	class ToolView;
 	class LogView;
+	class MemoryView;
 	class CommandView;
 	class PropertyView;
 	class RenderView;
@@ -100,6 +101,9 @@ namespace ysm
 		//! \brief The log view.
 		LogView* _logView;
 
+		//! \brief The memory view.
+		MemoryView* _memoryView;
+
 		//! \brief The pipeline view.
 		PipelineView* _pipelineView;
 
@@ -0,0 +1,175 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "memoryview.h"
+#include "../logview/logview.h"
+
+#include <QHeaderView>
+#include <QInputDialog>
+#include <QSplitter>
+
+using namespace ysm;
+
+//Interval of polling the memory tracker in milliseconds.
+#define MEMORY_UPDATE_INTERVAL 500
+
+//Number of consumers shown.
+#define MEMORY_CONSUMER_COUNT 20
+
+namespace
+{
+	//Formats a number of bytes for display.
+	QString formatSize(qint64 bytes)
+	{
+		if(bytes >= 1048576)
+			return QString("%1 MB").arg(bytes / 1048576.0, 0, 'f', 1);
+		if(bytes >= 1024)
+			return QString("%1 KB").arg(bytes / 1024.0, 0, 'f', 1);
+		return QString("%1 B").arg(bytes);
+	}
+}
+
+MemoryView::MemoryView(QWidget* parentWidget, IView* parentView) :
+	QDockWidget(parentWidget),
+	View(parentView),
+	_revision(0)
+{
+	//Initialize the category table, the last row shows the total.
+	_categories = new QTreeWidget();
+	_categories->setRootIsDecorated(false);
+	_categories->setUniformRowHeights(true);
+	_categories->setHeaderLabels(QStringList() << tr("Category") << tr("Usage") << tr("Peak") << tr("Budget"));
+	_categories->setToolTip(tr("Double click a category to edit its budget."));
+
+	for(int i = 0; i < MemoryTracker::CategoryCount; i++)
+	{
+		QTreeWidgetItem* item = new QTreeWidgetItem(_categories);
+		item->setText(0, MemoryTracker::getCategoryName(static_cast<MemoryCategory>(i)));
+		item->setData(0, Qt::UserRole, i);
+	}
+
+	QTreeWidgetItem* totalItem = new QTreeWidgetItem(_categories);
+	totalItem->setText(0, tr("Total"));
+	totalItem->setData(0, Qt::UserRole, -1);
+
+	QFont totalFont = totalItem->font(0);
+	totalFont.setBold(true);
+	for(int i = 0; i < _categories->columnCount(); i++)
+		totalItem->setFont(i, totalFont);
+
+	//Initialize the consumer table.
+	_consumers = new QTreeWidget();
+	_consumers->setRootIsDecorated(false);
+	_consumers->setUniformRowHeights(true);
+	_consumers->setHeaderLabels(QStringList() << tr("Block") << tr("Name") << tr("Size"));
+
+	//Show both tables side by side.
+	QSplitter* splitter = new QSplitter(Qt::Horizontal, this);
+	splitter->addWidget(_categories);
+	splitter->addWidget(_consumers);
+	setWidget(splitter);
+
+	connect(_categories, &QTreeWidget::itemDoubleClicked, this, &MemoryView::editBudget);
+	connect(MemoryTracker::getInstance(), &MemoryTracker::budgetExceeded, this, &MemoryView::budgetExceeded);
+
+	//Poll the tracker, as the memory is reported by any thread.
+	_updateTimer = new QTimer(this);
+	_updateTimer->setInterval(MEMORY_UPDATE_INTERVAL);
+	connect(_updateTimer, &QTimer::timeout, this, &MemoryView::updateUsage);
+	_updateTimer->start();
+}
+
+void MemoryView::updateDocument() { }
+void MemoryView::updateItem() { }
+
+void MemoryView::updateUsage()
+{
+	//Skip, if nothing changed or nobody can see it.
+	MemoryTracker* memoryTracker = MemoryTracker::getInstance();
+	quint64 revision = memoryTracker->getRevision();
+	if(revision == _revision || !isVisible())
+		return;
+
+	_revision = revision;
+
+	//Update the categories.
+	for(int i = 0; i < _categories->topLevelItemCount(); i++)
+	{
+		QTreeWidgetItem* item = _categories->topLevelItem(i);
+		int category = item->data(0, Qt::UserRole).toInt();
+		if(category < 0)
+		{
+			item->setText(1, formatSize(memoryTracker->getTotalUsage()));
+			item->setText(2, formatSize(memoryTracker->getTotalHighWaterMark()));
+			continue;
+		}
+
+		MemoryCategory memoryCategory = static_cast<MemoryCategory>(category);
+		qint64 budget = memoryTracker->getBudget(memoryCategory);
+		item->setText(1, formatSize(memoryTracker->getUsage(memoryCategory)));
+		item->setText(2, formatSize(memoryTracker->getHighWaterMark(memoryCategory)));
+		item->setText(3, budget > 0 ? formatSize(budget) : tr("Unlimited"));
+	}
+
+	//Recreate the consumers.
+	_consumers->clear();
+	foreach(const MemoryTracker::Consumer& consumer, memoryTracker->getTopConsumers(MEMORY_CONSUMER_COUNT))
+	{
+		QTreeWidgetItem* item = new QTreeWidgetItem(_consumers);
+		item->setText(0, consumer.blockId < 0 ? QString() : QString("#%1").arg(consumer.blockId));
+		item->setText(1, consumer.name);
+		item->setText(2, formatSize(consumer.bytes));
+		item->setToolTip(1, consumer.name);
+	}
+}
+
+void MemoryView::editBudget(QTreeWidgetItem* item)
+{
+	//The total has no budget.
+	int category = item->data(0, Qt::UserRole).toInt();
+	if(category < 0)
+		return;
+
+	MemoryCategory memoryCategory = static_cast<MemoryCategory>(category);
+	MemoryTracker* memoryTracker = MemoryTracker::getInstance();
+
+	bool accepted = false;
+	double budget = QInputDialog::getDouble(this, tr("Memory budget"),
+		tr("Budget of %1 in MB (0 for unlimited):").arg(MemoryTracker::getCategoryName(memoryCategory)),
+		memoryTracker->getBudget(memoryCategory) / 1048576.0, 0, 1048576, 0, &accepted);
+
+	if(accepted)
+	{
+		memoryTracker->setBudget(memoryCategory, static_cast<qint64>(budget * 1048576.0));
+		_revision = 0;
+		updateUsage();
+	}
+}
+
+void MemoryView::budgetExceeded(MemoryCategory category, qint64 usage, qint64 budget)
+{
+	LogView::log(LogSeverity::Warning, "Memory", tr("%1 use %2, which exceeds the budget of %3.")
+				 .arg(MemoryTracker::getCategoryName(category)).arg(formatSize(usage)).arg(formatSize(budget)));
+}
@@ -0,0 +1,98 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef MEMORYVIEW_H
+#define MEMORYVIEW_H
+
+#include "../view.h"
+#include "data/common/memorytracker.h"
+
+#include <QDockWidget>
+#include <QTimer>
+#include <QTreeWidget>
+
+namespace ysm
+{
+
+	//! \brief Shows the memory accounted by the memory tracker: totals, high-water marks and budgets per category
+	//! and the largest consumers. Budgets are edited by double clicking a category.
+	class MemoryView : public QDockWidget, public View
+	{
+		Q_OBJECT
+
+	public:
+
+		/*!
+		 * \brief Initialize new instance.
+		 * \param parentWidget The parent widget.
+		 * \param parentView The parent view.
+		 */
+		explicit MemoryView(QWidget* parentWidget, IView* parentView);
+
+	protected:
+
+		//! \brief Called whenever the selected document might have changed.
+		void updateDocument() Q_DECL_OVERRIDE;
+
+		//! \brief Called whenever the selected item might have changed.
+		void updateItem() Q_DECL_OVERRIDE;
+
+	protected slots:
+
+		//! \brief Updates the tables, if the accounted memory changed.
+		void updateUsage();
+
+		/*!
+		 * \brief Lets the user edit the budget of the clicked category.
+		 * \param item The clicked item.
+		 */
+		void editBudget(QTreeWidgetItem* item);
+
+		/*!
+		 * \brief Logs a warning about an exceeded budget.
+		 * \param category The category.
+		 * \param usage The used memory in bytes.
+		 * \param budget The budget in bytes.
+		 */
+		void budgetExceeded(MemoryCategory category, qint64 usage, qint64 budget);
+
+	private:
+
+		//! \brief The categories' usage, including the total.
+		QTreeWidget* _categories;
+
+		//! \brief The largest consumers.
+		QTreeWidget* _consumers;
+
+		//! \brief Polls the memory tracker.
+		QTimer* _updateTimer;
+
+		//! \brief The tracker's revision, the tables show.
+		quint64 _revision;
+	};
+
+}
+
+#endif // MEMORYVIEW_H
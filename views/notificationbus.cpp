@@ -0,0 +1,247 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "notificationbus.h"
+#include "iview.h"
+
+#include <QSet>
+#include <typeinfo>
+#include <algorithm>
+
+using namespace ysm;
+
+NotificationBus* NotificationBus::_sharedInstance = NULL;
+
+NotificationBus::NotificationBus() :
+	_nextSequence(0),
+	_dispatchDepth(0)
+{
+}
+
+NotificationBus::~NotificationBus()
+{
+	//Delete all subscriptions.
+	foreach(const QList<INotification*>& notifications, _notifications)
+		qDeleteAll(notifications);
+
+	qDeleteAll(_resets);
+	qDeleteAll(_inactiveNotifications);
+	qDeleteAll(_inactiveResets);
+}
+
+NotificationBus* NotificationBus::getInstance()
+{
+	//Check if instance is already initialized.
+	if(!_sharedInstance)
+		_sharedInstance = new NotificationBus();
+
+	//Return the shared instance.
+	return _sharedInstance;
+}
+
+void NotificationBus::subscribe(INotification* notification)
+{
+	//Append in order of subscription.
+	notification->_sequence = _nextSequence++;
+	_notifications[notification->getOperation()].append(notification);
+
+	//The cached matches are outdated.
+	_index.clear();
+}
+
+void NotificationBus::subscribe(IReset* reset)
+{
+	//Append in order of subscription.
+	reset->_sequence = _nextSequence++;
+	_resets.append(reset);
+}
+
+void NotificationBus::unsubscribe(IView* view)
+{
+	//Remove all notifications of the view.
+	bool removed = false;
+	for(QHash<int, QList<INotification*> >::iterator it = _notifications.begin(); it != _notifications.end(); ++it)
+	{
+		QList<INotification*>& notifications = it.value();
+		for(int i = notifications.size() - 1; i >= 0; i--)
+		{
+			INotification* notification = notifications[i];
+			if(notification->getView() != view)
+				continue;
+
+			//Running dispatches might still refer to the notification, so only mark it.
+			notifications.removeAt(i);
+			notification->_active = false;
+			_inactiveNotifications.append(notification);
+			removed = true;
+		}
+	}
+
+	//Remove all resets of the view.
+	for(int i = _resets.size() - 1; i >= 0; i--)
+	{
+		IReset* reset = _resets[i];
+		if(reset->getView() != view)
+			continue;
+
+		_resets.removeAt(i);
+		reset->_active = false;
+		_inactiveResets.append(reset);
+	}
+
+	//The cached matches are outdated.
+	if(removed)
+		_index.clear();
+
+	releaseInactive();
+}
+
+const QList<NotificationBus::INotification*>& NotificationBus::getSubscribers(Document* document,
+	IChangeable* changeable, IChangeable::Operation operation)
+{
+	//Check for cached matches of the concrete type.
+	IndexKey key(document, operation, std::type_index(typeid(*changeable)));
+	QHash<IndexKey, QList<INotification*> >::const_iterator it = _index.constFind(key);
+	if(it != _index.constEnd())
+		return it.value();
+
+	//Resolve the type matches once, they are the same for all objects of this type.
+	QList<INotification*>& subscribers = _index[key];
+	foreach(INotification* notification, _notifications.value(operation))
+	{
+		//Static notifications are bound to their document.
+		if(notification->getType() == Static && notification->getDocument() != document)
+			continue;
+
+		if(notification->matchesType(changeable))
+			subscribers.append(notification);
+	}
+
+	return subscribers;
+}
+
+int NotificationBus::dispatch(IView* rootView, Document* document, const QList<IChangeable*>& changedObjects,
+							  IChangeable::Operation operation)
+{
+	//Collect the changed objects per subscriber, every object is delivered once.
+	QList<INotification*> subscribers;
+	QHash<INotification*, QList<IChangeable*> > batches;
+	QSet<IChangeable*> visitedObjects;
+	foreach(IChangeable* changedObject, changedObjects)
+	{
+		if(!changedObject || visitedObjects.contains(changedObject))
+			continue;
+
+		visitedObjects.insert(changedObject);
+		foreach(INotification* notification, getSubscribers(document, changedObject, operation))
+		{
+			QList<IChangeable*>& batch = batches[notification];
+			if(batch.isEmpty())
+				subscribers.append(notification);
+
+			batch.append(changedObject);
+		}
+	}
+
+	//Deliver in order of subscription, so parent views are notified before their children.
+	std::sort(subscribers.begin(), subscribers.end(), [](INotification* first, INotification* second)
+	{ return first->_sequence < second->_sequence; });
+
+	_dispatchDepth++;
+
+	int deliveredCount = 0;
+	foreach(INotification* notification, subscribers)
+	{
+		//Skip subscribers removed by previous handlers or outside of the root view's hierarchy.
+		if(!notification->_active || !isChildView(notification->getView(), rootView))
+			continue;
+
+		//The active document of dynamic subscribers might have changed meanwhile.
+		if(!notification->matchesDocument(document))
+			continue;
+
+		//Deliver the whole batch, unless the subscriber is removed by its own handler.
+		foreach(IChangeable* changedObject, batches.value(notification))
+		{
+			notification->notify(changedObject);
+			if(!notification->_active)
+				break;
+		}
+
+		deliveredCount++;
+	}
+
+	_dispatchDepth--;
+	releaseInactive();
+
+	return deliveredCount;
+}
+
+int NotificationBus::reset(IView* rootView, Document* document)
+{
+	//Resets subscribed during the dispatch are not executed.
+	QList<IReset*> resets = _resets;
+
+	_dispatchDepth++;
+
+	int deliveredCount = 0;
+	foreach(IReset* reset, resets)
+	{
+		if(!reset->_active || !isChildView(reset->getView(), rootView) || !reset->matchesDocument(document))
+			continue;
+
+		reset->notify();
+		deliveredCount++;
+	}
+
+	_dispatchDepth--;
+	releaseInactive();
+
+	return deliveredCount;
+}
+
+bool NotificationBus::isChildView(IView* view, IView* rootView)
+{
+	//Walk up the hierarchy.
+	for(; view; view = view->getParentView())
+		if(view == rootView)
+			return true;
+
+	return false;
+}
+
+void NotificationBus::releaseInactive()
+{
+	//Running dispatches might still refer to the subscriptions.
+	if(_dispatchDepth)
+		return;
+
+	qDeleteAll(_inactiveNotifications);
+	qDeleteAll(_inactiveResets);
+
+	_inactiveNotifications.clear();
+	_inactiveResets.clear();
+}
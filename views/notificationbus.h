@@ -0,0 +1,458 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef NOTIFICATIONBUS_H
+#define NOTIFICATIONBUS_H
+
+#include "commands/ichangeable.h"
+
+#include <QHash>
+#include <QList>
+#include <typeindex>
+
+namespace ysm
+{
+	class Document;
+	class IView;
+
+	//! \brief Central dispatcher for the change notifications of all views.
+	//! Views subscribe to operations on objects of a certain type. Subscribers are indexed by document, operation and
+	//! the changed object's concrete type, so that the type matches are resolved once per concrete type instead of once
+	//! per changed object and subscriber. A batch of changed objects is delivered to each subscriber at once.
+	class NotificationBus
+	{
+
+	public:
+
+		//! \brief Possible notification types.
+		enum NotificationType
+		{
+			Static,
+			Dynamic,
+			All,
+		};
+
+		//! \brief Non-generic base interface for resets.
+		class IReset
+		{
+		public:
+
+			//! \brief Initialize new instance.
+			IReset() : _sequence(0), _active(true) { }
+
+			//! \brief Destruct instance.
+			virtual ~IReset() { }
+
+			/*!
+			 * \brief Returns the view, that subscribed.
+			 * \return The subscribing view.
+			 */
+			virtual IView* getView() const = 0;
+
+			/*!
+			 * \brief Checks, wether the given document applies to this reset.
+			 * \param document The document that was reset.
+			 * \return True, if the reset must be executed.
+			 */
+			virtual bool matchesDocument(Document* document) const = 0;
+
+			//! \brief Execute the actual reset handler.
+			virtual void notify() const = 0;
+
+		private:
+
+			friend class NotificationBus;
+
+			//! \brief Registration order.
+			quint64 _sequence;
+
+			//! \brief False, if unsubscribed during a dispatch.
+			bool _active;
+		};
+
+		//! \brief Non-generic base interface for notifications.
+		class INotification
+		{
+		public:
+
+			//! \brief Initialize new instance.
+			INotification() : _sequence(0), _active(true) { }
+
+			//! \brief Destruct instance.
+			virtual ~INotification() { }
+
+			/*!
+			 * \brief Returns the view, that subscribed.
+			 * \return The subscribing view.
+			 */
+			virtual IView* getView() const = 0;
+
+			/*!
+			 * \brief Returns the operation to watch.
+			 * \return The operation.
+			 */
+			virtual IChangeable::Operation getOperation() const = 0;
+
+			/*!
+			 * \brief Returns the notification type.
+			 * \return The notification type.
+			 */
+			virtual NotificationType getType() const = 0;
+
+			/*!
+			 * \brief Returns the document active on subscription.
+			 * \return The document, static notifications are bound to.
+			 */
+			virtual Document* getDocument() const = 0;
+
+			/*!
+			 * \brief Checks, wether the given document applies to this notification.
+			 * \param document The document that was changed.
+			 * \return True, if the notification must be executed.
+			 */
+			virtual bool matchesDocument(Document* document) const = 0;
+
+			/*!
+			 * \brief Checks, wether the changed object's type applies to this notification.
+			 * The result only depends on the object's concrete type.
+			 * \param changeable The object that was changed.
+			 * \return True, if the notification must be executed.
+			 */
+			virtual bool matchesType(IChangeable* changeable) const = 0;
+
+			/*!
+			 * \brief Execute the actual notification handler.
+			 * \param changeable The object that was changed, must match the type.
+			 */
+			virtual void notify(IChangeable* changeable) const = 0;
+
+		private:
+
+			friend class NotificationBus;
+
+			//! \brief Registration order.
+			quint64 _sequence;
+
+			//! \brief False, if unsubscribed during a dispatch.
+			bool _active;
+		};
+
+		//! \brief Special reset interface.
+		template<typename V> class Reset : public IReset
+		{
+		public:
+
+			/*!
+			 * \brief Initialize new instance.
+			 * \param type The notification type.
+			 * \param view The subscribing view.
+			 * \param instance The instance to call the slot on.
+			 * \param slot The slot.
+			 */
+			Reset(NotificationType type, IView* view, V* instance, void (V::*slot)()) :
+				_type(type),
+				_view(view),
+				_instance(instance),
+				_slot(slot)
+			{ _document = instance->getActiveDocument(); }
+
+			/*!
+			 * \brief Returns the view, that subscribed.
+			 * \return The subscribing view.
+			 */
+			IView* getView() const Q_DECL_OVERRIDE { return _view; }
+
+			/*!
+			 * \brief Checks, wether the given document applies to this reset.
+			 * \param document The document that was reset.
+			 * \return True, if the reset must be executed.
+			 */
+			bool matchesDocument(Document* document) const Q_DECL_OVERRIDE
+			{
+				if(_type == Static) return _document == document;
+				if(_type == Dynamic) return _instance->getActiveDocument() == document;
+				return true;
+			}
+
+			//! \brief Execute the actual reset handler.
+			void notify() const Q_DECL_OVERRIDE { (_instance->*_slot)(); }
+
+		private:
+
+			//! \brief The notification type.
+			NotificationType _type;
+
+			//! \brief The subscribing view.
+			IView* _view;
+
+			//! \brief The instance to execute the notification on.
+			V* _instance;
+
+			//! \brief The notification to execute.
+			void (V::*_slot)();
+
+			//! \brief Document if static.
+			Document* _document;
+		};
+
+		//! \brief Special notification interface.
+		template<typename T, typename V> class Notification : public INotification
+		{
+		public:
+
+			/*!
+			 * \brief Initialize new instance.
+			 * \param type The notification type.
+			 * \param operation The operation to watch.
+			 * \param view The subscribing view.
+			 * \param instance The instance to call the slot on.
+			 * \param slot The slot.
+			 */
+			Notification(NotificationType type, IChangeable::Operation operation, IView* view, V* instance,
+						 void (V::*slot)(T*)) :
+				_operation(operation),
+				_type(type),
+				_view(view),
+				_instance(instance),
+				_slot(slot)
+			{ _document = instance->getActiveDocument(); }
+
+			/*!
+			 * \brief Returns the view, that subscribed.
+			 * \return The subscribing view.
+			 */
+			IView* getView() const Q_DECL_OVERRIDE { return _view; }
+
+			/*!
+			 * \brief Returns the operation to watch.
+			 * \return The operation.
+			 */
+			IChangeable::Operation getOperation() const Q_DECL_OVERRIDE { return _operation; }
+
+			/*!
+			 * \brief Returns the notification type.
+			 * \return The notification type.
+			 */
+			NotificationType getType() const Q_DECL_OVERRIDE { return _type; }
+
+			/*!
+			 * \brief Returns the document active on subscription.
+			 * \return The document, static notifications are bound to.
+			 */
+			Document* getDocument() const Q_DECL_OVERRIDE { return _document; }
+
+			/*!
+			 * \brief Checks, wether the given document applies to this notification.
+			 * \param document The document that was changed.
+			 * \return True, if the notification must be executed.
+			 */
+			bool matchesDocument(Document* document) const Q_DECL_OVERRIDE
+			{
+				if(_type == Static) return _document == document;
+				if(_type == Dynamic) return _instance->getActiveDocument() == document;
+				return true;
+			}
+
+			/*!
+			 * \brief Checks, wether the changed object's type applies to this notification.
+			 * \param changeable The object that was changed.
+			 * \return True, if the notification must be executed.
+			 */
+			bool matchesType(IChangeable* changeable) const Q_DECL_OVERRIDE
+			{ return dynamic_cast<T*>(changeable) != NULL; }
+
+			/*!
+			 * \brief Execute the actual notification handler.
+			 * \param changeable The object that was changed, must match the type.
+			 */
+			void notify(IChangeable* changeable) const Q_DECL_OVERRIDE
+			{
+				//The type was already checked, but the cast must adjust the pointer.
+				T* converted = dynamic_cast<T*>(changeable);
+				if(converted)
+					(_instance->*_slot)(converted);
+			}
+
+		private:
+
+			//! \brief The operation to look for.
+			IChangeable::Operation _operation;
+
+			//! \brief The notification type.
+			NotificationType _type;
+
+			//! \brief The subscribing view.
+			IView* _view;
+
+			//! \brief The instance to execute the notification on.
+			V* _instance;
+
+			//! \brief The notification to execute.
+			void (V::*_slot)(T*);
+
+			//! \brief Document if static.
+			Document* _document;
+		};
+
+	public:
+
+		//! \brief Destruct instance.
+		~NotificationBus();
+
+		/*!
+		 * \brief Returns the shared notification bus or creates it.
+		 * \return The application's notification bus.
+		 */
+		static NotificationBus* getInstance();
+
+		/*!
+		 * \brief Adds a notification. The bus takes ownership.
+		 * \param notification The notification.
+		 */
+		void subscribe(INotification* notification);
+
+		/*!
+		 * \brief Adds a reset. The bus takes ownership.
+		 * \param reset The reset.
+		 */
+		void subscribe(IReset* reset);
+
+		/*!
+		 * \brief Removes and deletes all notifications and resets of the given view.
+		 * \param view The subscribing view.
+		 */
+		void unsubscribe(IView* view);
+
+		/*!
+		 * \brief Delivers the changed objects to all matching subscribers of the given view and its children.
+		 * Each subscriber is called once for all of its matching objects, duplicated objects are delivered once.
+		 * \param rootView The view, whose subtree is notified.
+		 * \param document The changed document.
+		 * \param changedObjects List of changed data objects.
+		 * \param operation The change operation executed.
+		 * \return The number of subscribers the change was delivered to.
+		 */
+		int dispatch(IView* rootView, Document* document, const QList<IChangeable*>& changedObjects,
+					 IChangeable::Operation operation);
+
+		/*!
+		 * \brief Executes all matching resets of the given view and its children.
+		 * \param rootView The view, whose subtree is notified.
+		 * \param document The document that was reset.
+		 * \return The number of subscribers the reset was delivered to.
+		 */
+		int reset(IView* rootView, Document* document);
+
+	private:
+
+		//! \brief Key of the subscriber index.
+		struct IndexKey
+		{
+			//! \brief The changed document.
+			Document* document;
+
+			//! \brief The change operation.
+			IChangeable::Operation operation;
+
+			//! \brief The changed object's concrete type.
+			std::type_index type;
+
+			/*!
+			 * \brief Initialize new instance.
+			 * \param document The changed document.
+			 * \param operation The change operation.
+			 * \param type The changed object's concrete type.
+			 */
+			IndexKey(Document* document, IChangeable::Operation operation, std::type_index type) :
+				document(document),
+				operation(operation),
+				type(type)
+			{ }
+
+			//! \brief Compares two keys.
+			bool operator==(const IndexKey& other) const
+			{ return document == other.document && operation == other.operation && type == other.type; }
+		};
+
+		//! \brief Hashes an index key.
+		friend uint qHash(const IndexKey& key, uint seed)
+		{ return qHash(key.document, seed) ^ qHash(int(key.operation), seed) ^ uint(key.type.hash_code()); }
+
+		//! \brief Initialize new instance.
+		NotificationBus();
+
+		/*!
+		 * \brief Returns the notifications, that match the changed object's concrete type.
+		 * The result is cached, static notifications bound to other documents are omitted.
+		 * \param document The changed document.
+		 * \param changeable The object that was changed.
+		 * \param operation The change operation.
+		 * \return The matching notifications in order of subscription.
+		 */
+		const QList<INotification*>& getSubscribers(Document* document, IChangeable* changeable,
+													IChangeable::Operation operation);
+
+		/*!
+		 * \brief Checks, wether the view is the root view or one of its children.
+		 * \param view The view to check.
+		 * \param rootView The root view.
+		 * \return True, if the view is part of the root view's hierarchy.
+		 */
+		static bool isChildView(IView* view, IView* rootView);
+
+		//! \brief Deletes the subscriptions removed during a dispatch.
+		void releaseInactive();
+
+	private:
+
+		//! \brief The shared notification bus.
+		static NotificationBus* _sharedInstance;
+
+		//! \brief Notifications per operation, in order of subscription.
+		QHash<int, QList<INotification*> > _notifications;
+
+		//! \brief Resets in order of subscription.
+		QList<IReset*> _resets;
+
+		//! \brief Matching notifications per document, operation and concrete type.
+		QHash<IndexKey, QList<INotification*> > _index;
+
+		//! \brief Counter for the subscription order.
+		quint64 _nextSequence;
+
+		//! \brief Depth of nested dispatches.
+		int _dispatchDepth;
+
+		//! \brief Notifications removed during a dispatch.
+		QList<INotification*> _inactiveNotifications;
+
+		//! \brief Resets removed during a dispatch.
+		QList<IReset*> _inactiveResets;
+	};
+
+}
+
+#endif // NOTIFICATIONBUS_H
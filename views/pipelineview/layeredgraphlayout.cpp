@@ -0,0 +1,972 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "layeredgraphlayout.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QLineF>
+#include <QMap>
+#include <QPair>
+#include <QRectF>
+#include <QtMath>
+
+#include <algorithm>
+#include <limits>
+
+using namespace ysm;
+
+//Horizontal distance between a port and the vertical part of a detour.
+#define ROUTE_MARGIN 12
+
+//Number of sweeps without improvement, before the crossing minimization stops.
+#define SWEEP_PATIENCE 4
+
+//Number of sweeps used to balance the vertical node positions.
+#define BALANCE_ITERATIONS 8
+
+//Additional weight of dummy nodes while balancing, which keeps long edges straight.
+#define DUMMY_WEIGHT 4
+
+//Tolerance used to compare route coordinates.
+#define ROUTE_EPSILON 0.01
+
+namespace
+{
+	//! \brief Finds the representative of the given node, compressing the path.
+	int findComponent(QVector<int>& parents, int node)
+	{
+		while(parents[node] != node)
+			node = parents[node] = parents[parents[node]];
+
+		return node;
+	}
+
+	//! \brief Counts the pairs i < j with values[i] > values[j] using merge sort. Sorts the given range.
+	int countInversions(QVector<qreal>& values, QVector<qreal>& buffer, int begin, int end)
+	{
+		//Single values are always sorted.
+		if(end - begin < 2)
+			return 0;
+
+		//Sort both halves.
+		int middle = (begin + end) / 2;
+		int inversions = countInversions(values, buffer, begin, middle) + countInversions(values, buffer, middle, end);
+
+		//Merge the halves, every value taken from the right half passes all remaining values of the left half.
+		int left = begin, right = middle, output = begin;
+		while(left < middle && right < end)
+		{
+			if(values[right] < values[left])
+			{
+				inversions += middle - left;
+				buffer[output++] = values[right++];
+			}
+			else
+				buffer[output++] = values[left++];
+		}
+
+		while(left < middle) buffer[output++] = values[left++];
+		while(right < end) buffer[output++] = values[right++];
+
+		//Copy the merged range back.
+		for(int i = begin; i < end; i++)
+			values[i] = buffer[i];
+
+		return inversions;
+	}
+
+	//! \brief Fits the positions to the desired ones with least weighted squares, keeping their order and the given
+	//! minimum gaps (pool adjacent violators).
+	QVector<qreal> fitPositions(const QVector<qreal>& desired, const QVector<qreal>& weights, const QVector<qreal>& gaps)
+	{
+		//Remove the gaps, so that only the order needs to be kept.
+		QVector<qreal> offsets(desired.size());
+		qreal offset = 0;
+		for(int i = 0; i < desired.size(); i++)
+			offsets[i] = offset += gaps[i];
+
+		//Merge neighbouring blocks as long as they violate the order.
+		QVector<qreal> values, blockWeights;
+		QVector<int> blockSizes;
+		for(int i = 0; i < desired.size(); i++)
+		{
+			values.append(desired[i] - offsets[i]);
+			blockWeights.append(weights[i]);
+			blockSizes.append(1);
+
+			while(values.size() > 1 && values[values.size() - 2] > values.last())
+			{
+				int last = values.size() - 1;
+				qreal weight = blockWeights[last - 1] + blockWeights[last];
+				values[last - 1] = (values[last - 1] * blockWeights[last - 1] + values[last] * blockWeights[last]) / weight;
+				blockWeights[last - 1] = weight;
+				blockSizes[last - 1] += blockSizes[last];
+
+				values.removeLast();
+				blockWeights.removeLast();
+				blockSizes.removeLast();
+			}
+		}
+
+		//Expand the blocks and restore the gaps.
+		QVector<qreal> positions;
+		for(int block = 0; block < values.size(); block++)
+			for(int i = 0; i < blockSizes[block]; i++)
+				positions.append(values[block] + offsets[positions.size()]);
+
+		return positions;
+	}
+
+	//! \brief Compares two route coordinates.
+	bool isEqual(qreal first, qreal second) { return qAbs(first - second) < ROUTE_EPSILON; }
+
+	//! \brief Removes duplicate and collinear points from an orthogonal route.
+	QVector<QPointF> simplifyRoute(const QVector<QPointF>& route)
+	{
+		QVector<QPointF> result;
+		foreach(const QPointF& point, route)
+		{
+			//Skip duplicates.
+			if(!result.isEmpty() && isEqual(result.last().x(), point.x()) && isEqual(result.last().y(), point.y()))
+				continue;
+
+			//Extend the last segment, if the point continues it.
+			if(result.size() >= 2)
+			{
+				const QPointF& first = result[result.size() - 2];
+				const QPointF& second = result.last();
+				if((isEqual(first.x(), second.x()) && isEqual(second.x(), point.x())) ||
+				   (isEqual(first.y(), second.y()) && isEqual(second.y(), point.y())))
+				{
+					result.last() = point;
+					continue;
+				}
+			}
+
+			result.append(point);
+		}
+
+		return result;
+	}
+
+	//! \brief Creates a route that leaves the source to the right, passes below at the given height and enters the
+	//! target from the left. Used for edges that point backwards.
+	QVector<QPointF> createDetour(const QPointF& source, const QPointF& target, qreal detour)
+	{
+		QVector<QPointF> route;
+		route << source
+			  << QPointF(source.x() + ROUTE_MARGIN, source.y())
+			  << QPointF(source.x() + ROUTE_MARGIN, detour)
+			  << QPointF(target.x() - ROUTE_MARGIN, detour)
+			  << QPointF(target.x() - ROUTE_MARGIN, target.y())
+			  << target;
+
+		return simplifyRoute(route);
+	}
+}
+
+LayeredGraphLayout::LayeredGraphLayout(qreal layerSpacing, qreal nodeSpacing, qreal portDistance, qreal gridSize) :
+	_layerSpacing(layerSpacing),
+	_nodeSpacing(nodeSpacing),
+	_portDistance(portDistance),
+	_gridSize(gridSize),
+	_iterationLimit(24),
+	_nodeCount(0),
+	_incremental(false),
+	_crossingCount(0),
+	_elapsedTime(0)
+{ }
+
+int LayeredGraphLayout::addNode(qreal top, qreal bottom)
+{
+	//Create a free node.
+	Node node;
+	node._top = top;
+	node._bottom = bottom;
+	node._layer = node._order = node._component = 0;
+	node._dummy = node._fixed = false;
+
+	//Nodes must be added before the first dummy node is created.
+	_nodes.append(node);
+	return _nodeCount++;
+}
+
+void LayeredGraphLayout::setNodeFixed(int node, const QPointF& position)
+{
+	//Store the position, the layout is incremental from now on.
+	_nodes[node]._fixed = true;
+	_nodes[node]._fixedPosition = position;
+	_incremental = true;
+}
+
+int LayeredGraphLayout::addEdge(int source, int target, qreal sourcePort, qreal targetPort)
+{
+	Edge edge;
+	edge._source = source;
+	edge._target = target;
+	edge._sourcePort = sourcePort;
+	edge._targetPort = targetPort;
+	edge._reversed = false;
+
+	_edges.append(edge);
+	return _edges.size() - 1;
+}
+
+void LayeredGraphLayout::setIterationLimit(int iterationLimit) { _iterationLimit = iterationLimit; }
+
+void LayeredGraphLayout::run()
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	//Execute the layout phases.
+	removeCycles();
+	assignLayers();
+	insertDummyNodes();
+	orderLayers();
+	assignCoordinates();
+	placeIncrementally();
+	routeEdges();
+	countRouteCrossings();
+
+	_elapsedTime = timer.elapsed();
+}
+
+void LayeredGraphLayout::removeCycles()
+{
+	//Collect the outgoing edges and start with the nodes that have no incoming edges.
+	QVector<QVector<int>> outEdges(_nodeCount);
+	QVector<bool> hasInEdges(_nodeCount, false);
+	for(int i = 0; i < _edges.size(); i++)
+		if(_edges[i]._source != _edges[i]._target)
+		{
+			outEdges[_edges[i]._source].append(i);
+			hasInEdges[_edges[i]._target] = true;
+		}
+
+	QVector<int> startNodes;
+	for(int node = 0; node < _nodeCount; node++)
+		if(!hasInEdges[node]) startNodes.append(node);
+	for(int node = 0; node < _nodeCount; node++)
+		if(hasInEdges[node]) startNodes.append(node);
+
+	//Depth first search, edges pointing to a node on the stack close a cycle and are reversed.
+	enum State { Unvisited, Active, Done };
+	QVector<State> states(_nodeCount, Unvisited);
+	QVector<QPair<int, int>> stack;
+	foreach(int startNode, startNodes)
+	{
+		if(states[startNode] != Unvisited)
+			continue;
+
+		states[startNode] = Active;
+		stack.append(qMakePair(startNode, 0));
+		while(!stack.isEmpty())
+		{
+			int node = stack.last().first;
+			if(stack.last().second < outEdges[node].size())
+			{
+				//Follow the next edge.
+				int edge = outEdges[node][stack.last().second++];
+				int target = _edges[edge]._target;
+
+				if(states[target] == Active)
+					_edges[edge]._reversed = true;
+				else if(states[target] == Unvisited)
+				{
+					states[target] = Active;
+					stack.append(qMakePair(target, 0));
+				}
+			}
+			else
+			{
+				//All edges are processed.
+				states[node] = Done;
+				stack.removeLast();
+			}
+		}
+	}
+}
+
+void LayeredGraphLayout::assignLayers()
+{
+	//Collect the layered neighbours, reversed edges already point downwards.
+	QVector<QVector<int>> successors(_nodeCount), predecessors(_nodeCount);
+	QVector<int> inDegrees(_nodeCount, 0);
+	QVector<int> parents(_nodeCount);
+	for(int node = 0; node < _nodeCount; node++)
+		parents[node] = node;
+
+	foreach(const Edge& edge, _edges)
+		if(edge._source != edge._target)
+		{
+			int upper = edge._reversed ? edge._target : edge._source;
+			int lower = edge._reversed ? edge._source : edge._target;
+			successors[upper].append(lower);
+			predecessors[lower].append(upper);
+			inDegrees[lower]++;
+
+			//Merge the connected components.
+			parents[findComponent(parents, upper)] = findComponent(parents, lower);
+		}
+
+	//Sort the nodes topologically.
+	QVector<int> order;
+	for(int node = 0; node < _nodeCount; node++)
+		if(!inDegrees[node]) order.append(node);
+	for(int i = 0; i < order.size(); i++)
+		foreach(int successor, successors[order[i]])
+			if(!--inDegrees[successor]) order.append(successor);
+
+	//Longest path layering.
+	foreach(int node, order)
+		foreach(int successor, successors[node])
+			_nodes[successor]._layer = qMax(_nodes[successor]._layer, _nodes[node]._layer + 1);
+
+	//Move nodes towards their successors, if that shortens more edges than it stretches. This keeps sources that feed
+	//distant nodes, like uniform blocks feeding several shaders, right next to their targets.
+	for(int i = order.size() - 1; i >= 0; i--)
+	{
+		int node = order[i];
+		if(successors[node].size() <= predecessors[node].size())
+			continue;
+
+		int layer = std::numeric_limits<int>::max();
+		foreach(int successor, successors[node])
+			layer = qMin(layer, _nodes[successor]._layer - 1);
+
+		_nodes[node]._layer = qMax(_nodes[node]._layer, layer);
+	}
+
+	//Number the components in the order of their first node.
+	QHash<int, int> componentIds;
+	for(int node = 0; node < _nodeCount; node++)
+	{
+		int root = findComponent(parents, node);
+		if(!componentIds.contains(root))
+		{
+			int componentId = componentIds.size();
+			componentIds[root] = componentId;
+		}
+
+		_nodes[node]._component = componentIds[root];
+	}
+
+	//Every component starts at the first layer.
+	QVector<int> minLayers(componentIds.size(), std::numeric_limits<int>::max());
+	for(int node = 0; node < _nodeCount; node++)
+		minLayers[_nodes[node]._component] = qMin(minLayers[_nodes[node]._component], _nodes[node]._layer);
+	for(int node = 0; node < _nodeCount; node++)
+		_nodes[node]._layer -= minLayers[_nodes[node]._component];
+}
+
+void LayeredGraphLayout::insertDummyNodes()
+{
+	for(int i = 0; i < _edges.size(); i++)
+	{
+		Edge& edge = _edges[i];
+		if(edge._source == edge._target)
+			continue;
+
+		//Get the edge in layered direction.
+		int upper = edge._reversed ? edge._target : edge._source;
+		int lower = edge._reversed ? edge._source : edge._target;
+		qreal upperPort = edge._reversed ? edge._targetPort : edge._sourcePort;
+		qreal lowerPort = edge._reversed ? edge._sourcePort : edge._targetPort;
+
+		//Create a dummy node in every layer the edge passes.
+		edge._chain.append(upper);
+		for(int layer = _nodes[upper]._layer + 1; layer < _nodes[lower]._layer; layer++)
+		{
+			Node dummy;
+			dummy._top = dummy._bottom = 0;
+			dummy._layer = layer;
+			dummy._order = 0;
+			dummy._component = _nodes[upper]._component;
+			dummy._dummy = true;
+			dummy._fixed = false;
+
+			edge._chain.append(_nodes.size());
+			_nodes.append(dummy);
+		}
+		edge._chain.append(lower);
+
+		//Connect the chain by segments.
+		for(int j = 0; j + 1 < edge._chain.size(); j++)
+		{
+			Segment segment;
+			segment._upper = edge._chain[j];
+			segment._lower = edge._chain[j + 1];
+			segment._upperPort = j == 0 ? upperPort : 0;
+			segment._lowerPort = j + 2 == edge._chain.size() ? lowerPort : 0;
+
+			_nodes[segment._upper]._lowerSegments.append(_segments.size());
+			_nodes[segment._lower]._upperSegments.append(_segments.size());
+			_segments.append(segment);
+		}
+	}
+
+	//Create the layers.
+	int layerCount = 0;
+	foreach(const Node& node, _nodes)
+		layerCount = qMax(layerCount, node._layer + 1);
+
+	_layers = QVector<QVector<int>>(layerCount);
+}
+
+void LayeredGraphLayout::orderLayers()
+{
+	//Initial order: depth first from the nodes without upper neighbours, component by component.
+	QVector<int> startNodes;
+	for(int node = 0; node < _nodes.size(); node++)
+		if(_nodes[node]._upperSegments.isEmpty())
+			startNodes.append(node);
+
+	std::stable_sort(startNodes.begin(), startNodes.end(), [this](int first, int second)
+	{
+		return _nodes[first]._component < _nodes[second]._component;
+	});
+
+	QVector<bool> visited(_nodes.size(), false);
+	foreach(int startNode, startNodes)
+	{
+		QVector<int> stack;
+		stack.append(startNode);
+		while(!stack.isEmpty())
+		{
+			int node = stack.takeLast();
+			if(visited[node])
+				continue;
+
+			//Append the node to its layer.
+			visited[node] = true;
+			_nodes[node]._order = _layers[_nodes[node]._layer].size();
+			_layers[_nodes[node]._layer].append(node);
+
+			//Visit the lower neighbours in their port order.
+			for(int i = _nodes[node]._lowerSegments.size() - 1; i >= 0; i--)
+				stack.append(_segments[_nodes[node]._lowerSegments[i]]._lower);
+		}
+	}
+
+	//Count the initial crossings.
+	int bestCrossings = 0;
+	for(int layer = 0; layer + 1 < _layers.size(); layer++)
+		bestCrossings += countCrossings(layer);
+
+	//Alternate downward and upward sweeps, sorting every layer by the barycenters of its neighbours in the previous
+	//layer of the sweep. Components are kept together.
+	QVector<QVector<int>> bestLayers = _layers;
+	int failedSweeps = 0;
+	for(int iteration = 0; iteration < _iterationLimit && bestCrossings > 0 && failedSweeps < SWEEP_PATIENCE; iteration++)
+	{
+		bool downwards = iteration % 2 == 0;
+		for(int step = 1; step < _layers.size(); step++)
+		{
+			int layer = downwards ? step : _layers.size() - 1 - step;
+
+			//Calculate the barycenters, nodes without neighbours keep their place.
+			QVector<QPair<QPair<int, qreal>, int>> keys;
+			foreach(int node, _layers[layer])
+			{
+				const QVector<int>& segments = downwards ? _nodes[node]._upperSegments : _nodes[node]._lowerSegments;
+				qreal barycenter = _nodes[node]._order;
+				if(!segments.isEmpty())
+				{
+					barycenter = 0;
+					foreach(int segment, segments)
+					{
+						const Segment& current = _segments[segment];
+						barycenter += downwards ? getPortKey(current._upper, current._upperPort)
+												: getPortKey(current._lower, current._lowerPort);
+					}
+
+					barycenter /= segments.size();
+				}
+
+				keys.append(qMakePair(qMakePair(_nodes[node]._component, barycenter), node));
+			}
+
+			//Sort the layer.
+			std::stable_sort(keys.begin(), keys.end(), [](const QPair<QPair<int, qreal>, int>& first,
+														  const QPair<QPair<int, qreal>, int>& second)
+			{
+				return first.first < second.first;
+			});
+
+			for(int i = 0; i < keys.size(); i++)
+			{
+				_layers[layer][i] = keys[i].second;
+				_nodes[keys[i].second]._order = i;
+			}
+		}
+
+		//Keep the best order.
+		int crossings = 0;
+		for(int layer = 0; layer + 1 < _layers.size(); layer++)
+			crossings += countCrossings(layer);
+
+		if(crossings < bestCrossings)
+		{
+			bestCrossings = crossings;
+			bestLayers = _layers;
+			failedSweeps = 0;
+		}
+		else
+			failedSweeps++;
+	}
+
+	//Restore the best order.
+	_layers = bestLayers;
+	foreach(const QVector<int>& layer, _layers)
+		for(int i = 0; i < layer.size(); i++)
+			_nodes[layer[i]]._order = i;
+}
+
+void LayeredGraphLayout::assignCoordinates()
+{
+	int componentCount = 0;
+	foreach(const Node& node, _nodes)
+		componentCount = qMax(componentCount, node._component + 1);
+
+	//Layout the components one below the other.
+	qreal componentOffset = 0;
+	for(int component = 0; component < componentCount; component++)
+	{
+		//Collect the component's part of every layer and stack the nodes initially.
+		QVector<QVector<int>> layers(_layers.size());
+		for(int layer = 0; layer < _layers.size(); layer++)
+		{
+			qreal position = 0;
+			foreach(int node, _layers[layer])
+				if(_nodes[node]._component == component)
+				{
+					if(!layers[layer].isEmpty())
+						position += getSpacing(layers[layer].last(), node);
+
+					_nodes[node]._position = QPointF(layer * _layerSpacing, position);
+					layers[layer].append(node);
+				}
+		}
+
+		//Move the nodes towards their neighbours' ports, keeping their order and spacing. The final sweeps use the
+		//neighbours on both sides.
+		for(int iteration = 0; iteration < BALANCE_ITERATIONS; iteration++)
+		{
+			bool downwards = iteration % 2 == 0;
+			bool bothSides = iteration >= BALANCE_ITERATIONS - 2;
+			for(int step = 0; step < layers.size(); step++)
+			{
+				const QVector<int>& nodes = layers[downwards ? step : layers.size() - 1 - step];
+				if(nodes.isEmpty())
+					continue;
+
+				QVector<qreal> desired, weights, gaps;
+				for(int i = 0; i < nodes.size(); i++)
+				{
+					const Node& node = _nodes[nodes[i]];
+					qreal sum = 0;
+					int count = 0;
+
+					if(downwards || bothSides)
+						foreach(int segment, node._upperSegments)
+						{
+							const Segment& current = _segments[segment];
+							sum += _nodes[current._upper]._position.y() + current._upperPort - current._lowerPort;
+							count++;
+						}
+
+					if(!downwards || bothSides)
+						foreach(int segment, node._lowerSegments)
+						{
+							const Segment& current = _segments[segment];
+							sum += _nodes[current._lower]._position.y() + current._lowerPort - current._upperPort;
+							count++;
+						}
+
+					desired.append(count ? sum / count : node._position.y());
+					weights.append(qMax(count, 1) * (node._dummy ? DUMMY_WEIGHT : 1));
+					gaps.append(i ? getSpacing(nodes[i - 1], nodes[i]) : 0);
+				}
+
+				QVector<qreal> positions = fitPositions(desired, weights, gaps);
+				for(int i = 0; i < nodes.size(); i++)
+					_nodes[nodes[i]]._position.setY(positions[i]);
+			}
+		}
+
+		//Move the component below the previous one.
+		qreal top = std::numeric_limits<qreal>::max(), bottom = -std::numeric_limits<qreal>::max();
+		foreach(const QVector<int>& nodes, layers)
+			foreach(int node, nodes)
+			{
+				top = qMin(top, _nodes[node]._position.y() - _nodes[node]._top);
+				bottom = qMax(bottom, _nodes[node]._position.y() + _nodes[node]._bottom);
+			}
+
+		if(top > bottom)
+			continue;
+
+		foreach(const QVector<int>& nodes, layers)
+			foreach(int node, nodes)
+				_nodes[node]._position.ry() += componentOffset - top;
+
+		componentOffset += bottom - top + 2 * _nodeSpacing;
+	}
+
+	//Align all nodes to the grid.
+	for(int node = 0; node < _nodes.size(); node++)
+		_nodes[node]._position = QPointF(qRound(_nodes[node]._position.x() / _gridSize) * _gridSize,
+										 qRound(_nodes[node]._position.y() / _gridSize) * _gridSize);
+}
+
+void LayeredGraphLayout::placeIncrementally()
+{
+	//Only needed if some nodes keep their position.
+	if(!_incremental)
+		return;
+
+	//The offsets between the fixed and the calculated positions are passed on to the free nodes through their edges.
+	QVector<QVector<int>> neighbours(_nodeCount);
+	foreach(const Edge& edge, _edges)
+		if(edge._source != edge._target)
+		{
+			neighbours[edge._source].append(edge._target);
+			neighbours[edge._target].append(edge._source);
+		}
+
+	QVector<QPointF> offsets(_nodeCount);
+	QVector<bool> resolved(_nodeCount, false);
+	QVector<int> freeNodes;
+	for(int node = 0; node < _nodeCount; node++)
+	{
+		if(_nodes[node]._fixed)
+		{
+			offsets[node] = _nodes[node]._fixedPosition - _nodes[node]._position;
+			resolved[node] = true;
+		}
+		else
+			freeNodes.append(node);
+	}
+
+	std::stable_sort(freeNodes.begin(), freeNodes.end(), [this](int first, int second)
+	{
+		return _nodes[first]._layer < _nodes[second]._layer;
+	});
+
+	bool progress = true;
+	while(progress)
+	{
+		progress = false;
+		foreach(int node, freeNodes)
+		{
+			if(resolved[node])
+				continue;
+
+			//Use the average offset of all resolved neighbours.
+			QPointF offset;
+			int count = 0;
+			foreach(int neighbour, neighbours[node])
+				if(resolved[neighbour])
+				{
+					offset += offsets[neighbour];
+					count++;
+				}
+
+			if(count)
+			{
+				offsets[node] = offset / count;
+				resolved[node] = progress = true;
+			}
+		}
+	}
+
+	//Free nodes without any resolved neighbour are moved below all other nodes, keeping their relative layout.
+	qreal resolvedBottom = -std::numeric_limits<qreal>::max(), unresolvedTop = std::numeric_limits<qreal>::max();
+	for(int node = 0; node < _nodeCount; node++)
+	{
+		if(resolved[node])
+			resolvedBottom = qMax(resolvedBottom, _nodes[node]._position.y() + offsets[node].y() + _nodes[node]._bottom);
+		else
+			unresolvedTop = qMin(unresolvedTop, _nodes[node]._position.y() - _nodes[node]._top);
+	}
+
+	foreach(int node, freeNodes)
+		if(!resolved[node])
+			offsets[node] = QPointF(0, resolvedBottom + 2 * _nodeSpacing - unresolvedTop);
+
+	//Place the fixed nodes first.
+	QVector<QRectF> placedRects;
+	for(int node = 0; node < _nodeCount; node++)
+		if(_nodes[node]._fixed)
+		{
+			_nodes[node]._position = _nodes[node]._fixedPosition;
+			placedRects.append(QRectF(_nodes[node]._position.x() - _portDistance, _nodes[node]._position.y() - _nodes[node]._top,
+									  2 * _portDistance, _nodes[node]._top + _nodes[node]._bottom));
+		}
+
+	//Place the free nodes, moving them down until they do not overlap any placed node.
+	foreach(int node, freeNodes)
+	{
+		QPointF position = _nodes[node]._position + offsets[node];
+		position = QPointF(qRound(position.x() / _gridSize) * _gridSize, qRound(position.y() / _gridSize) * _gridSize);
+
+		bool moved = true;
+		while(moved)
+		{
+			moved = false;
+			QRectF rect(position.x() - _portDistance, position.y() - _nodes[node]._top,
+						2 * _portDistance, _nodes[node]._top + _nodes[node]._bottom);
+
+			foreach(const QRectF& placedRect, placedRects)
+				if(rect.intersects(placedRect.adjusted(-_gridSize, -_nodeSpacing / 2, _gridSize, _nodeSpacing / 2)))
+				{
+					position.setY(qCeil((placedRect.bottom() + _nodeSpacing + _nodes[node]._top) / _gridSize) * _gridSize);
+					moved = true;
+					break;
+				}
+		}
+
+		_nodes[node]._position = position;
+		placedRects.append(QRectF(position.x() - _portDistance, position.y() - _nodes[node]._top,
+								  2 * _portDistance, _nodes[node]._top + _nodes[node]._bottom));
+	}
+}
+
+void LayeredGraphLayout::routeEdges()
+{
+	//Incremental layouts do not keep the layers, so every edge is routed directly between its ports.
+	if(_incremental)
+	{
+		for(int i = 0; i < _edges.size(); i++)
+		{
+			Edge& edge = _edges[i];
+			if(edge._source != edge._target)
+			{
+				const Node& source = _nodes[edge._source];
+				const Node& target = _nodes[edge._target];
+				QPointF sourcePoint(source._position.x() + _portDistance, source._position.y() + edge._sourcePort);
+				QPointF targetPoint(target._position.x() - _portDistance, target._position.y() + edge._targetPort);
+
+				//Use a single channel centered between the ports, or a detour if the target is not to the right.
+				QVector<QPointF> route;
+				if(targetPoint.x() - sourcePoint.x() >= 2 * ROUTE_MARGIN)
+				{
+					qreal channel = (sourcePoint.x() + targetPoint.x()) / 2;
+					route << sourcePoint << QPointF(channel, sourcePoint.y()) << QPointF(channel, targetPoint.y())
+						  << targetPoint;
+					route = simplifyRoute(route);
+				}
+				else
+					route = createDetour(sourcePoint, targetPoint, qMax(source._position.y() + source._bottom,
+																	 target._position.y() + target._bottom) + _nodeSpacing / 2);
+
+				edge._route = route;
+			}
+		}
+
+		return;
+	}
+
+	//Collect the segment end points of all forward edges. Segments that change their height need a vertical channel
+	//in the gap behind their upper layer.
+	QVector<QVector<QPair<QPointF, QPointF>>> edgeSegments(_edges.size());
+	QVector<QMap<QPair<int, qreal>, int>> channels(_layers.size());
+	for(int i = 0; i < _edges.size(); i++)
+	{
+		const Edge& edge = _edges[i];
+		if(edge._source == edge._target || edge._reversed)
+			continue;
+
+		for(int j = 0; j + 1 < edge._chain.size(); j++)
+		{
+			const Node& upper = _nodes[edge._chain[j]];
+			const Node& lower = _nodes[edge._chain[j + 1]];
+			QPointF start = j == 0 ? QPointF(upper._position.x() + _portDistance, upper._position.y() + edge._sourcePort)
+								   : upper._position;
+			QPointF end = j + 2 == edge._chain.size() ? QPointF(lower._position.x() - _portDistance,
+																lower._position.y() + edge._targetPort)
+													  : lower._position;
+			edgeSegments[i].append(qMakePair(start, end));
+
+			//Downward channels are ordered from bottom to top and upward channels from top to bottom, which avoids
+			//crossings between them. Edges leaving the same port share their channel.
+			if(!isEqual(start.y(), end.y()))
+			{
+				bool downwards = end.y() > start.y();
+				channels[upper._layer].insert(qMakePair(downwards ? 0 : 1, downwards ? -start.y() : start.y()), 0);
+			}
+		}
+	}
+
+	//Distribute the channels of every gap evenly.
+	for(int layer = 0; layer < channels.size(); layer++)
+	{
+		int index = 0;
+		for(QMap<QPair<int, qreal>, int>::iterator it = channels[layer].begin(); it != channels[layer].end(); ++it)
+			it.value() = ++index;
+	}
+
+	for(int i = 0; i < _edges.size(); i++)
+	{
+		Edge& edge = _edges[i];
+		if(edge._source == edge._target || edge._reversed)
+			continue;
+
+		//Connect the segments through their channels.
+		QVector<QPointF> route;
+		for(int j = 0; j < edgeSegments[i].size(); j++)
+		{
+			QPointF start = edgeSegments[i][j].first;
+			QPointF end = edgeSegments[i][j].second;
+			route << start;
+
+			if(!isEqual(start.y(), end.y()))
+			{
+				int layer = _nodes[edge._chain[j]]._layer;
+				bool downwards = end.y() > start.y();
+				const QMap<QPair<int, qreal>, int>& gap = channels[layer];
+				int track = gap.value(qMakePair(downwards ? 0 : 1, downwards ? -start.y() : start.y()));
+
+				qreal left = layer * _layerSpacing + _portDistance;
+				qreal width = _layerSpacing - 2 * _portDistance;
+				qreal channel = left + track * width / (gap.size() + 1);
+				route << QPointF(channel, start.y()) << QPointF(channel, end.y());
+			}
+
+			route << end;
+		}
+
+		edge._route = simplifyRoute(route);
+	}
+
+	//Reversed edges detour below their component.
+	QHash<int, qreal> componentBottoms;
+	foreach(const Node& node, _nodes)
+		componentBottoms[node._component] = qMax(componentBottoms.value(node._component, -std::numeric_limits<qreal>::max()),
+												 node._position.y() + node._bottom);
+
+	QHash<int, int> componentDetours;
+	for(int i = 0; i < _edges.size(); i++)
+	{
+		Edge& edge = _edges[i];
+		if(edge._source == edge._target || !edge._reversed)
+			continue;
+
+		const Node& source = _nodes[edge._source];
+		const Node& target = _nodes[edge._target];
+		int detour = componentDetours[source._component]++;
+
+		edge._route = createDetour(QPointF(source._position.x() + _portDistance, source._position.y() + edge._sourcePort),
+								   QPointF(target._position.x() - _portDistance, target._position.y() + edge._targetPort),
+								   componentBottoms[source._component] + _nodeSpacing / 2 + detour * _gridSize);
+	}
+}
+
+void LayeredGraphLayout::countRouteCrossings()
+{
+	//Split the routes into horizontal and vertical lines.
+	QVector<QPair<int, QLineF>> horizontalLines, verticalLines;
+	for(int i = 0; i < _edges.size(); i++)
+		for(int j = 0; j + 1 < _edges[i]._route.size(); j++)
+		{
+			QLineF line(_edges[i]._route[j], _edges[i]._route[j + 1]);
+			if(isEqual(line.y1(), line.y2()))
+				horizontalLines.append(qMakePair(i, line));
+			else
+				verticalLines.append(qMakePair(i, line));
+		}
+
+	//Sort the vertical lines, so that only the lines inside a horizontal line's range are tested.
+	std::sort(verticalLines.begin(), verticalLines.end(), [](const QPair<int, QLineF>& first,
+															 const QPair<int, QLineF>& second)
+	{
+		return first.second.x1() < second.second.x1();
+	});
+
+	//Count the proper intersections between lines of different edges. Shared channels do not cross.
+	_crossingCount = 0;
+	foreach(const auto& horizontal, horizontalLines)
+	{
+		qreal left = qMin(horizontal.second.x1(), horizontal.second.x2());
+		qreal right = qMax(horizontal.second.x1(), horizontal.second.x2());
+		qreal y = horizontal.second.y1();
+
+		auto vertical = std::upper_bound(verticalLines.begin(), verticalLines.end(), left + ROUTE_EPSILON,
+										 [](qreal x, const QPair<int, QLineF>& line) { return x < line.second.x1(); });
+		for(; vertical != verticalLines.end() && vertical->second.x1() < right - ROUTE_EPSILON; ++vertical)
+		{
+			qreal top = qMin(vertical->second.y1(), vertical->second.y2());
+			qreal bottom = qMax(vertical->second.y1(), vertical->second.y2());
+
+			if(horizontal.first != vertical->first && y > top + ROUTE_EPSILON && y < bottom - ROUTE_EPSILON)
+				_crossingCount++;
+		}
+	}
+}
+
+int LayeredGraphLayout::countCrossings(int layer) const
+{
+	//Collect the segment end points, sorted by their upper key.
+	QVector<QPair<qreal, qreal>> keys;
+	foreach(int node, _layers[layer])
+		foreach(int segment, _nodes[node]._lowerSegments)
+		{
+			const Segment& current = _segments[segment];
+			keys.append(qMakePair(getPortKey(current._upper, current._upperPort), getPortKey(current._lower, current._lowerPort)));
+		}
+
+	std::sort(keys.begin(), keys.end());
+
+	//Every inversion of the lower keys is a crossing.
+	QVector<qreal> values, buffer(keys.size());
+	for(int i = 0; i < keys.size(); i++)
+		values.append(keys[i].second);
+
+	return countInversions(values, buffer, 0, values.size());
+}
+
+qreal LayeredGraphLayout::getPortKey(int node, qreal port) const
+{
+	//The port offset always stays below half a node.
+	const Node& current = _nodes[node];
+	return current._order + port / (current._top + current._bottom + _nodeSpacing);
+}
+
+qreal LayeredGraphLayout::getSpacing(int previous, int next) const
+{
+	//Dummy nodes may be packed closer together.
+	const Node& first = _nodes[previous];
+	const Node& second = _nodes[next];
+	qreal spacing = first._dummy && second._dummy ? 2 * _gridSize : _nodeSpacing;
+	return first._bottom + spacing + second._top;
+}
+
+QPointF LayeredGraphLayout::getNodePosition(int node) const { return _nodes[node]._position; }
+QVector<QPointF> LayeredGraphLayout::getEdgeRoute(int edge) const { return _edges[edge]._route; }
+int LayeredGraphLayout::getLayerCount() const { return _layers.size(); }
+int LayeredGraphLayout::getCrossingCount() const { return _crossingCount; }
+qint64 LayeredGraphLayout::getElapsedTime() const { return _elapsedTime; }
@@ -0,0 +1,245 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef LAYEREDGRAPHLAYOUT_H
+#define LAYEREDGRAPHLAYOUT_H
+
+#include <QPointF>
+#include <QVector>
+
+namespace ysm
+{
+
+	//! \brief Layered graph layout, used to auto layout large pipelines.
+	//! Nodes are assigned to layers from left to right, ordered to minimize edge crossings and connected by
+	//! orthogonal edge routes between their ports. The layout only operates on plain data, so it can safely be run on
+	//! a worker thread.
+	class LayeredGraphLayout
+	{
+
+	public:
+
+		/*!
+		 * \brief Initialize new instance.
+		 * \param layerSpacing Horizontal distance between the centers of two neighbouring layers.
+		 * \param nodeSpacing Minimum vertical space between two nodes.
+		 * \param portDistance Horizontal distance between a node's center and its ports.
+		 * \param gridSize Size of the grid, the node positions are rounded to.
+		 */
+		LayeredGraphLayout(qreal layerSpacing, qreal nodeSpacing, qreal portDistance, qreal gridSize);
+
+		/*!
+		 * \brief Adds a node to the graph.
+		 * \param top The node's extent above its center.
+		 * \param bottom The node's extent below its center.
+		 * \return The node's index.
+		 */
+		int addNode(qreal top, qreal bottom);
+
+		/*!
+		 * \brief Keeps the node at the given position. Used for incremental layouts.
+		 * \param node The node's index.
+		 * \param position The node's fixed position.
+		 */
+		void setNodeFixed(int node, const QPointF& position);
+
+		/*!
+		 * \brief Adds a directed edge, from an out port of the source node to an in port of the target node.
+		 * \param source The source node's index.
+		 * \param target The target node's index.
+		 * \param sourcePort The vertical offset of the source port, relative to the source node's center.
+		 * \param targetPort The vertical offset of the target port, relative to the target node's center.
+		 * \return The edge's index.
+		 */
+		int addEdge(int source, int target, qreal sourcePort, qreal targetPort);
+
+		/*!
+		 * \brief Sets the maximum number of crossing minimization sweeps.
+		 * \param iterationLimit The iteration limit.
+		 */
+		void setIterationLimit(int iterationLimit);
+
+		//! \brief Calculates the layout.
+		void run();
+
+		/*!
+		 * \brief Returns a node's calculated position.
+		 * \param node The node's index.
+		 * \return The node's center position.
+		 */
+		QPointF getNodePosition(int node) const;
+
+		/*!
+		 * \brief Returns an edge's calculated route.
+		 * \param edge The edge's index.
+		 * \return The route, from source port to target port. Empty, if the edge could not be routed.
+		 */
+		QVector<QPointF> getEdgeRoute(int edge) const;
+
+		/*!
+		 * \brief Returns the number of layers used by the layout.
+		 * \return The layer count.
+		 */
+		int getLayerCount() const;
+
+		/*!
+		 * \brief Returns the number of crossings between the calculated edge routes.
+		 * \return The crossing count.
+		 */
+		int getCrossingCount() const;
+
+		/*!
+		 * \brief Returns the time needed to calculate the layout.
+		 * \return The time in milliseconds.
+		 */
+		qint64 getElapsedTime() const;
+
+	private:
+
+		//! \brief A node of the layered graph, which might be a dummy node of a long edge.
+		struct Node
+		{
+			//! \brief The node's extents.
+			qreal _top, _bottom;
+
+			//! \brief The node's calculated and fixed position.
+			QPointF _position, _fixedPosition;
+
+			//! \brief The node's layer, order inside the layer and connected component.
+			int _layer, _order, _component;
+
+			//! \brief Wether the node is a dummy node or keeps its position.
+			bool _dummy, _fixed;
+
+			//! \brief Segments to the previous and to the next layer.
+			QVector<int> _upperSegments, _lowerSegments;
+		};
+
+		//! \brief An edge of the input graph.
+		struct Edge
+		{
+			//! \brief The source and target nodes.
+			int _source, _target;
+
+			//! \brief The port offsets.
+			qreal _sourcePort, _targetPort;
+
+			//! \brief Wether the edge was reversed to break a cycle.
+			bool _reversed;
+
+			//! \brief The layered nodes, from the upper to the lower layer, including all dummy nodes.
+			QVector<int> _chain;
+
+			//! \brief The calculated route.
+			QVector<QPointF> _route;
+		};
+
+		//! \brief Part of an edge between two neighbouring layers.
+		struct Segment
+		{
+			//! \brief The nodes in the upper and lower layer.
+			int _upper, _lower;
+
+			//! \brief The port offsets at the upper and lower node.
+			qreal _upperPort, _lowerPort;
+		};
+
+		//! \brief Reverses edges until the graph is acyclic.
+		void removeCycles();
+
+		//! \brief Assigns the layers using the longest path, then moves nodes towards their successors.
+		void assignLayers();
+
+		//! \brief Splits edges spanning multiple layers using dummy nodes.
+		void insertDummyNodes();
+
+		//! \brief Orders the layers using barycentric sweeps.
+		void orderLayers();
+
+		//! \brief Assigns the node coordinates, component by component.
+		void assignCoordinates();
+
+		//! \brief Moves all free nodes relative to their fixed neighbours and resolves overlaps.
+		void placeIncrementally();
+
+		//! \brief Creates the orthogonal edge routes.
+		void routeEdges();
+
+		/*!
+		 * \brief Counts the crossings between two neighbouring layers.
+		 * \param layer The upper layer.
+		 * \return The crossing count.
+		 */
+		int countCrossings(int layer) const;
+
+		/*!
+		 * \brief Returns the sort key of a segment end point.
+		 * \param node The node.
+		 * \param port The port offset.
+		 * \return The node's order, slightly adjusted by the port offset.
+		 */
+		qreal getPortKey(int node, qreal port) const;
+
+		/*!
+		 * \brief Returns the minimum distance between the centers of two neighbouring nodes in a layer.
+		 * \param previous The upper node.
+		 * \param next The lower node.
+		 * \return The distance.
+		 */
+		qreal getSpacing(int previous, int next) const;
+
+		//! \brief Counts the crossings of the calculated routes.
+		void countRouteCrossings();
+
+	private:
+
+		//! \brief The layout parameters.
+		qreal _layerSpacing, _nodeSpacing, _portDistance, _gridSize;
+
+		//! \brief The maximum number of crossing minimization sweeps.
+		int _iterationLimit;
+
+		//! \brief The number of nodes that were added, which excludes the dummy nodes.
+		int _nodeCount;
+
+		//! \brief Wether some nodes keep their position.
+		bool _incremental;
+
+		//! \brief The nodes, edges and segments.
+		QVector<Node> _nodes;
+		QVector<Edge> _edges;
+		QVector<Segment> _segments;
+
+		//! \brief The node indices of every layer, in their order.
+		QVector<QVector<int>> _layers;
+
+		//! \brief The results.
+		int _crossingCount;
+		qint64 _elapsedTime;
+	};
+
+}
+
+#endif // LAYEREDGRAPHLAYOUT_H
@@ -34,6 +34,8 @@
 #include <QStyleOptionGraphicsItem>
 #include <QWidget>
 #include <QPainterPath>
+#include <QLineF>
+#include <QVector>
 #include <QtMath>
 
 namespace ysm
@@ -130,6 +132,13 @@ namespace ysm
 		 */
 		virtual QColor getTargetColor() const;
 
+		/*!
+		 * \brief Gets the connection's calculated route, relative to the parent's coordinate system.
+		 * The route is only used, if it starts at the source and ends at the target position.
+		 * \return The route or an empty route, to use the default curve.
+		 */
+		virtual QVector<QPointF> getRoute() const;
+
 		//! \brief Updates the connection.
 		virtual void layoutChanged();
 
@@ -141,6 +150,9 @@ namespace ysm
 		//! \brief The last calculated source and target positions.
 		QPointF _sourcePos, _targetPos;
 
+		//! \brief The route that is followed instead of the default curve, relative to the connection's position.
+		QVector<QPointF> _route;
+
 		//! \brief The current highlight state.
 		PipelineConnectionState _highlightState;
 	};
@@ -153,6 +165,8 @@ namespace ysm
 
 #define SELECTION_OFFSET 5
 #define CONNECTION_CURVINESS 7.5
+#define ROUTE_CORNER_RADIUS 6.0
+#define ROUTE_TOLERANCE 0.5
 
 //Implement the template methods in header file.
 namespace ysm
@@ -168,6 +182,7 @@ namespace ysm
 
 	template<typename T> QColor PipelineConnection<T>::getSourceColor() const { return Qt::white; }
 	template<typename T> QColor PipelineConnection<T>::getTargetColor() const { return Qt::white; }
+	template<typename T> QVector<QPointF> PipelineConnection<T>::getRoute() const { return QVector<QPointF>(); }
 
 	template<typename T> void PipelineConnection<T>::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
 														   QWidget* widget)
@@ -216,6 +231,14 @@ namespace ysm
 		//Get the new source and target pos, relative to the new position.
 		_sourcePos = this->mapFromParent(getSourcePos());
 		_targetPos = this->mapFromParent(getTargetPos());
+
+		//Follow the calculated route, as long as it still connects both positions.
+		_route.clear();
+		QVector<QPointF> route = getRoute();
+		if(route.size() >= 2 && QLineF(route.first(), sourcePos).length() < ROUTE_TOLERANCE &&
+		   QLineF(route.last(), targetPos).length() < ROUTE_TOLERANCE)
+			foreach(const QPointF& point, route)
+				_route.append(this->mapFromParent(point));
 	}
 
 	template<typename T> void PipelineConnection<T>::highlightChanged(PipelineConnectionState) { }
@@ -243,6 +266,26 @@ namespace ysm
 
 	template<typename T> QPainterPath PipelineConnection<T>::getPath() const
 	{
+		//Follow the route, if available, and round its corners.
+		if(!_route.isEmpty())
+		{
+			QPainterPath path(_route.first());
+			for(int i = 1; i + 1 < _route.size(); i++)
+			{
+				QLineF incoming(_route[i], _route[i - 1]);
+				QLineF outgoing(_route[i], _route[i + 1]);
+				qreal radius = qMin(ROUTE_CORNER_RADIUS, qMin(incoming.length(), outgoing.length()) / 2);
+				incoming.setLength(radius);
+				outgoing.setLength(radius);
+
+				path.lineTo(incoming.p2());
+				path.quadTo(_route[i], outgoing.p2());
+			}
+
+			path.lineTo(_route.last());
+			return path;
+		}
+
 		//Start from source draw simple bezier to target.
 		double heightDifference = qSqrt(qAbs(_sourcePos.y() - _targetPos.y())) * CONNECTION_CURVINESS;
 		QPainterPath path(QPointF(_sourcePos.x(), _sourcePos.y()));
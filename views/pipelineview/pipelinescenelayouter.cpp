@@ -25,28 +25,113 @@
 
 #include "pipelinescenelayouter.h"
 #include "pipelinetab.h"
+#include "layeredgraphlayout.h"
 
 #include "data/iconnection.h"
 #include "data/ipipeline.h"
 #include "data/ipipelinemanager.h"
+#include "data/iport.h"
 
-#include "data/blocks/vertexpullerblock.h"
 #include "data/common/serializationcontext.h"
+#include "data/common/threadpool.h"
 
 #include <QtGlobal>
 #include <QDebug>
+#include <QAtomicInt>
+#include <QEasingCurve>
+#include <QHash>
+#include <QTimer>
+#include <QVariantAnimation>
 
 using namespace ysm;
 
 #define AUTO_X_SPACE 270
-#define AUTO_Y_SPACE 340
+#define AUTO_Y_SPACE 40
+#define AUTO_ITERATIONS 24
+#define AUTO_LAYOUT_POLL_INTERVAL 15
 #define COMMAND_Y_SPACE 100
-#define X_SPACING_FACTOR 1
-#define Y_SPACING_FACTOR 2
+#define LAYOUT_GRID 10
+#define ANIMATION_DURATION 400
+
+//Block geometry, must match the visual blocks.
+#define BLOCK_PORT_DISTANCE 94
+#define BLOCK_PORT_PITCH 32
+#define BLOCK_PORT_SPACER 8
+#define BLOCK_HEADER_HEIGHT 40
+#define BLOCK_MESSAGE_HEIGHT 20
+
+namespace
+{
+	//! \brief Returns the vertical offset of a port, relative to its block's center.
+	qreal getPortOffset(const QVector<IPort*>& ports, IPort* port)
+	{
+		return -(ports.count() / 2.0 - 0.5 - ports.indexOf(port)) * BLOCK_PORT_PITCH;
+	}
+
+	//! \brief Returns the block's extents above and below its center.
+	void getBlockExtents(IBlock* block, qreal* top, qreal* bottom)
+	{
+		int maxPortCount = qMax(block->getInPorts().count(), block->getOutPorts().count());
+		qreal contentHeight = BLOCK_PORT_SPACER + maxPortCount * BLOCK_PORT_PITCH;
+
+		*top = contentHeight / 2 + BLOCK_HEADER_HEIGHT;
+		*bottom = contentHeight / 2 + BLOCK_MESSAGE_HEIGHT;
+	}
+
+	//! \brief Returns all blocks connected to the given block.
+	QSet<IBlock*> getNeighbours(IBlock* block)
+	{
+		QSet<IBlock*> neighbours;
+		foreach(IConnection* connection, block->getInConnections())
+			neighbours.insert(connection->getSource());
+		foreach(IConnection* connection, block->getOutConnections())
+			neighbours.insert(connection->getDest());
+
+		return neighbours;
+	}
+}
+
+struct PipelineSceneLayouter::AutoLayoutTask
+{
+	AutoLayoutTask() : _layout(AUTO_X_SPACE, AUTO_Y_SPACE, BLOCK_PORT_DISTANCE, LAYOUT_GRID) { }
+
+	//! \brief The layout, which owns all data used by the worker thread.
+	LayeredGraphLayout _layout;
+
+	//! \brief The layouted pipeline.
+	IPipeline* _pipeline;
+
+	//! \brief The blocks and connections by node and edge index. Only accessed on the main thread.
+	QVector<IBlock*> _blocks;
+	QVector<IConnection*> _connections;
+	QVector<IBlock*> _connectionSources;
+
+	//! \brief The block's neighbours at the time of the snapshot.
+	QVector<QSet<IBlock*>> _neighbours;
+
+	//! \brief Set when the layout is calculated.
+	QAtomicInt _finished{0};
+};
 
 PipelineSceneLayouter::PipelineSceneLayouter(QObject *parent) :
-	QObject(parent)
-{ }
+	QObject(parent),
+	_crossingCount(0),
+	_layoutTime(0)
+{
+	//Poll running auto layouts.
+	_autoLayoutTimer = new QTimer(this);
+	_autoLayoutTimer->setInterval(AUTO_LAYOUT_POLL_INTERVAL);
+	connect(_autoLayoutTimer, &QTimer::timeout, this, &PipelineSceneLayouter::pollAutoLayout);
+
+	//Animate to the auto layout positions.
+	_animation = new QVariantAnimation(this);
+	_animation->setStartValue(0.0);
+	_animation->setEndValue(1.0);
+	_animation->setDuration(ANIMATION_DURATION);
+	_animation->setEasingCurve(QEasingCurve::OutCubic);
+	connect(_animation, &QVariantAnimation::valueChanged, this, &PipelineSceneLayouter::animationStep);
+	connect(_animation, &QVariantAnimation::finished, this, &PipelineSceneLayouter::finishAnimation);
+}
 
 bool PipelineSceneLayouter::getLayoutInfo(IPipelineItem *pipelineItem, PipelineSceneLayouter::LayoutInfo **layoutInfo)
 {
@@ -58,6 +143,8 @@ bool PipelineSceneLayouter::getLayoutInfo(IPipelineItem *pipelineItem, PipelineS
 		//Set the default layout data.
 		(*layoutInfo)->_rootBlock = NULL;
 		(*layoutInfo)->_selected = false;
+		(*layoutInfo)->_layoutPending = true;
+		(*layoutInfo)->_layoutRecorded = false;
 
 		//Store the layout info.
 		_itemLayoutInfos[pipelineItem] = *layoutInfo;
@@ -91,8 +178,31 @@ QPointF PipelineSceneLayouter::getAutoLayoutItemPosition(IPipelineItem* pipeline
 	return layoutInfo->_rootBlock ? layoutInfo->_autoPosition : QPointF();
 }
 
+bool PipelineSceneLayouter::hasAutoLayoutItemPosition(IPipelineItem* pipelineItem)
+{
+	//Get the layout info.
+	LayoutInfo* layoutInfo = NULL;
+	getLayoutInfo(pipelineItem, &layoutInfo);
+
+	//Only items with an anchor were layouted.
+	return layoutInfo->_rootBlock != NULL;
+}
+
+QVector<QPointF> PipelineSceneLayouter::getConnectionRoute(IConnection* connection)
+{
+	//Get the layout info.
+	LayoutInfo* layoutInfo = NULL;
+	getLayoutInfo(connection, &layoutInfo);
+
+	//Return the connection's route.
+	return layoutInfo->_route;
+}
+
 QPointF PipelineSceneLayouter::setItemPosition(IPipelineItem *pipelineItem, QPointF position)
 {
+	//Explicit positions override running animations.
+	finishAnimation();
+
 	//Get the layout info.
 	LayoutInfo* layoutInfo = NULL;
 	getLayoutInfo(pipelineItem, &layoutInfo);
@@ -107,10 +217,17 @@ QPointF PipelineSceneLayouter::setItemPosition(IPipelineItem *pipelineItem, QPoi
 
 QPointF PipelineSceneLayouter::moveItem(IPipelineItem *pipelineItem, QPointF offset, bool previewOnly)
 {
+	//Explicit positions override running animations.
+	finishAnimation();
+
 	//Get the layout info.
 	LayoutInfo* layoutInfo = NULL;
 	getLayoutInfo(pipelineItem, &layoutInfo);
 
+	//The item is placed by the user from now on.
+	if(!previewOnly)
+		layoutInfo->_layoutPending = false;
+
 	//Use the correct source position to calculate the new position.
 	QPointF sourcePosition = previewOnly ? layoutInfo->_previewPosition : layoutInfo->_basePosition;
 	setItemPosition(layoutInfo, sourcePosition + offset, previewOnly);
@@ -152,6 +269,7 @@ void PipelineSceneLayouter::unregisterItem(IPipelineItem* pipelineItem)
 		//Remove the position.
 		LayoutInfo* layoutInfo = _itemLayoutInfos[pipelineItem];
 		_itemLayoutInfos.remove(pipelineItem);
+		_animatedItems.remove(pipelineItem);
 		delete layoutInfo;
 	}
 }
@@ -216,6 +334,7 @@ void PipelineSceneLayouter::deserialize(const QDomElement* base, SerializationCo
 			//Store the position.
 			setItemPosition(layoutInfo, QPointF(layoutItem.attribute("XPos").toDouble(),
 												layoutItem.attribute("YPos").toDouble()), false);
+			layoutInfo->_layoutPending = false;
 		}
 	}
 }
@@ -241,171 +360,238 @@ void PipelineSceneLayouter::setItemPosition(LayoutInfo* layoutInfo, QPointF posi
 
 void PipelineSceneLayouter::updateAutoLayout(IPipeline *pipeline)
 {
-	//Clear all auto layout info.
-	foreach(LayoutInfo* layoutInfo, _itemLayoutInfos.values())
-		layoutInfo->_rootBlock = NULL;
+	//Calculate the layout right away.
+	QSharedPointer<AutoLayoutTask> task = createAutoLayoutTask(pipeline, false);
+	task->_layout.run();
+	applyAutoLayout(task.data());
+}
+
+void PipelineSceneLayouter::startAutoLayout(IPipeline* pipeline, bool incremental)
+{
+	//The snapshot must contain the final positions.
+	finishAnimation();
+
+	//Calculate the layout on a worker thread. The task only accesses its own data there, so a discarded task can
+	//safely finish after the layouter is gone.
+	QSharedPointer<AutoLayoutTask> task = createAutoLayoutTask(pipeline, incremental);
+	ThreadPool::start([task]()
+	{
+		task->_layout.run();
+		task->_finished.storeRelease(1);
+	});
+
+	//Wait for the result.
+	_autoLayoutTask = task;
+	_finishedLayoutTask.clear();
+	_autoLayoutTimer->start();
+}
+
+bool PipelineSceneLayouter::isAutoLayoutRunning() const { return !_autoLayoutTask.isNull(); }
+int PipelineSceneLayouter::getAutoLayoutCrossingCount() const { return _crossingCount; }
+qint64 PipelineSceneLayouter::getAutoLayoutTime() const { return _layoutTime; }
+
+void PipelineSceneLayouter::pollAutoLayout()
+{
+	//Ensure the running layout is finished.
+	if(!_autoLayoutTask || !_autoLayoutTask->_finished.loadAcquire())
+		return;
+
+	QSharedPointer<AutoLayoutTask> task = _autoLayoutTask;
+	_autoLayoutTask.clear();
+	_autoLayoutTimer->stop();
+
+	//Keep the result, it is only stored when the receiver applies it.
+	_finishedLayoutTask = task;
+	emit autoLayoutFinished(task->_pipeline);
+}
+
+void PipelineSceneLayouter::applyFinishedAutoLayout()
+{
+	if(!_finishedLayoutTask)
+		return;
+
+	QSharedPointer<AutoLayoutTask> task = _finishedLayoutTask;
+	_finishedLayoutTask.clear();
+	applyAutoLayout(task.data());
+}
+
+void PipelineSceneLayouter::discardFinishedAutoLayout() { _finishedLayoutTask.clear(); }
+
+QSharedPointer<PipelineSceneLayouter::AutoLayoutTask> PipelineSceneLayouter::createAutoLayoutTask(IPipeline* pipeline,
+																								   bool incremental)
+{
+	QSharedPointer<AutoLayoutTask> task(new AutoLayoutTask());
+	task->_pipeline = pipeline;
+	task->_layout.setIterationLimit(AUTO_ITERATIONS);
+
+	//Render commands are placed above their blocks, reserve the space.
+	QHash<IBlock*, int> commandCounts;
+	foreach(IRenderCommand* renderCommand, pipeline->getRenderCommands())
+		if(renderCommand->getAssignedBlock())
+			commandCounts[renderCommand->getAssignedBlock()]++;
 
-	//Find all available vertex pullers, which act as source.
-	QSet<IBlock*> leftLayoutedBlocks, rightLayoutedBlocks, rootBlocks;
+	//Create a node for every block.
+	QHash<IBlock*, int> blockNodes;
 	foreach(IBlock* block, pipeline->getBlocks())
-		if(dynamic_cast<VertexPullerBlock*>(block))
+	{
+		qreal top, bottom;
+		getBlockExtents(block, &top, &bottom);
+		blockNodes[block] = task->_layout.addNode(top + commandCounts.value(block) * COMMAND_Y_SPACE, bottom);
+		task->_blocks.append(block);
+		task->_neighbours.append(getNeighbours(block));
+
+		//Get the layout info.
+		LayoutInfo* layoutInfo = NULL;
+		getLayoutInfo(block, &layoutInfo);
+
+		//Incremental layouts keep all blocks, which were placed before and whose connections did not change.
+		bool touched = layoutInfo->_layoutPending ||
+					   (layoutInfo->_layoutRecorded && layoutInfo->_layoutNeighbours != task->_neighbours.last());
+		if(incremental && !touched)
+			task->_layout.setNodeFixed(blockNodes[block], layoutInfo->_basePosition);
+	}
+
+	//Create an edge for every connection, between the actual ports.
+	foreach(IBlock* block, task->_blocks)
+		foreach(IConnection* connection, block->getOutConnections())
 		{
-			//Get the layout info.
-			LayoutInfo* layoutInfo = NULL;
-			getLayoutInfo(block, &layoutInfo);
+			IBlock* dest = connection->getDest();
+			if(!blockNodes.contains(dest))
+				continue;
+
+			task->_layout.addEdge(blockNodes[block], blockNodes[dest],
+								  getPortOffset(block->getOutPorts(), connection->getSourcePort()),
+								  getPortOffset(dest->getInPorts(), connection->getDestPort()));
+			task->_connections.append(connection);
+			task->_connectionSources.append(block);
+		}
 
-			//Store the block's info.
-			layoutInfo->_rootBlock = block;
-			layoutInfo->_logicalPosition.setX(0);
+	return task;
+}
 
-			//Use as current edge.
-			leftLayoutedBlocks.insert(block);
-			rightLayoutedBlocks.insert(block);
-			rootBlocks.insert(block);
-		}
+void PipelineSceneLayouter::applyAutoLayout(AutoLayoutTask* task)
+{
+	//Clear all auto layout info.
+	foreach(LayoutInfo* layoutInfo, _itemLayoutInfos.values())
+	{
+		layoutInfo->_rootBlock = NULL;
+		layoutInfo->_route.clear();
+	}
 
-	//Iterate over the pipeline step by step, until all items are layouted.
-	while(!leftLayoutedBlocks.empty() || !rightLayoutedBlocks.empty())
+	//Items might have been removed during the calculation.
+	QSet<IBlock*> existingBlocks;
+	foreach(IBlock* block, task->_pipeline->getBlocks())
+		existingBlocks.insert(block);
+
+	//Store the block positions.
+	for(int i = 0; i < task->_blocks.size(); i++)
 	{
-		//Continue layouting in the directions.
-		leftLayoutedBlocks = autoLayoutHorizontally(leftLayoutedBlocks, -1);
-		rightLayoutedBlocks = autoLayoutHorizontally(rightLayoutedBlocks, 1);
-
-		//If no more blocks are available, find blocks that are connected only in reverse direction.
-		if(leftLayoutedBlocks.empty() && rightLayoutedBlocks.empty())
-			foreach(IBlock* block, pipeline->getBlocks())
-			{
-				//Get the layout info.
-				LayoutInfo* blockInfo = NULL;
-				getLayoutInfo(block, &blockInfo);
-
-				//Check if the block has a layouted neighbour.
-				if(!blockInfo->_rootBlock)
-				{
-					//Check left neighbours.
-					foreach(IConnection* connection, block->getInConnections())
-					{
-						//Get the layout info.
-						LayoutInfo* layoutInfo = NULL;
-						getLayoutInfo(connection->getSource(), &layoutInfo);
-
-						//If the neighbour is layouted, continue with this block.
-						if(layoutInfo->_rootBlock)
-							rightLayoutedBlocks.insert(connection->getSource());
-					}
-
-					//Check right neighbours.
-					foreach(IConnection* connection, block->getOutConnections())
-					{
-						//Get the layout info.
-						LayoutInfo* layoutInfo = NULL;
-						getLayoutInfo(connection->getDest(), &layoutInfo);
-
-						//If the neighbour is layouted, continue with this block.
-						if(layoutInfo->_rootBlock)
-							leftLayoutedBlocks.insert(connection->getDest());
-					}
-				}
-			}
+		IBlock* block = task->_blocks[i];
+		if(!existingBlocks.contains(block))
+			continue;
+
+		LayoutInfo* layoutInfo = NULL;
+		getLayoutInfo(block, &layoutInfo);
+
+		layoutInfo->_rootBlock = block;
+		layoutInfo->_autoPosition = task->_layout.getNodePosition(i);
+		layoutInfo->_layoutNeighbours = task->_neighbours[i];
+		layoutInfo->_layoutPending = false;
+		layoutInfo->_layoutRecorded = true;
 	}
 
-	//Calculate the vertical positions.
-	autoLayoutVertically(rootBlocks);
+	//Store the routes of all connections, that still exist.
+	for(int i = 0; i < task->_connections.size(); i++)
+	{
+		IConnection* connection = task->_connections[i];
+		IBlock* sourceBlock = task->_connectionSources[i];
+		if(!existingBlocks.contains(sourceBlock) || !sourceBlock->getOutConnections().contains(connection))
+			continue;
 
-	//Calculate the actual positions.
-	foreach(LayoutInfo* layoutInfo, _itemLayoutInfos.values())
-		if(layoutInfo->_rootBlock)
-			layoutInfo->_autoPosition = QPointF(layoutInfo->_logicalPosition.x() * AUTO_X_SPACE,
-												layoutInfo->_logicalPosition.y() * AUTO_Y_SPACE);
+		LayoutInfo* layoutInfo = NULL;
+		getLayoutInfo(connection, &layoutInfo);
 
-	//Layout the render commands after the blocks.
-	foreach(IRenderCommand* renderCommand, pipeline->getRenderCommands())
+		layoutInfo->_route = task->_layout.getEdgeRoute(i);
+		emit layoutChanged(connection);
+	}
+
+	//Layout the render commands after the blocks, stacked above their assigned block.
+	QHash<IBlock*, int> commandCounts;
+	foreach(IRenderCommand* renderCommand, task->_pipeline->getRenderCommands())
 	{
 		//Get the command's layout info.
 		LayoutInfo* commandInfo = NULL;
 		getLayoutInfo(renderCommand, &commandInfo);
 
-		//Ensure command has assigned block.
-		commandInfo->_rootBlock = renderCommand->getAssignedBlock();
-		if(commandInfo->_rootBlock)
-		{
-			//Get the block's layout info.
-			LayoutInfo* blockInfo = NULL;
-			getLayoutInfo(commandInfo->_rootBlock, &blockInfo);
+		//Ensure command has assigned and layouted block.
+		IBlock* block = renderCommand->getAssignedBlock();
+		if(!block || !existingBlocks.contains(block))
+			continue;
 
-			//Set position right above the block.
-			commandInfo->_autoPosition = QPointF(blockInfo->_autoPosition.x(),
-												 blockInfo->_autoPosition.y() - COMMAND_Y_SPACE);
-		}
+		LayoutInfo* blockInfo = NULL;
+		getLayoutInfo(block, &blockInfo);
+		if(!blockInfo->_rootBlock)
+			continue;
+
+		//Set position right above the block.
+		qreal top, bottom;
+		getBlockExtents(block, &top, &bottom);
+		int commandIndex = commandCounts[block]++;
+
+		commandInfo->_rootBlock = block;
+		commandInfo->_autoPosition = QPointF(blockInfo->_autoPosition.x(), blockInfo->_autoPosition.y() - top -
+											 COMMAND_Y_SPACE / 2 - commandIndex * COMMAND_Y_SPACE);
 	}
+
+	//Store the statistics.
+	_crossingCount = task->_layout.getCrossingCount();
+	_layoutTime = task->_layout.getElapsedTime();
 }
 
-QSet<IBlock*> PipelineSceneLayouter::autoLayoutHorizontally(QSet<IBlock*> sourceBlocks, int direction)
+void PipelineSceneLayouter::animateItemPositions(const QMap<IPipelineItem*, QPointF>& positions)
 {
-	//Iterate over all source blocks.
-	QSet<IBlock*> layoutedBlocks;
-	foreach(IBlock* sourceBlock, sourceBlocks)
-	{
-		//Get the block's layout info.
-		LayoutInfo* sourceInfo = NULL;
-		getLayoutInfo(sourceBlock, &sourceInfo);
-
-		//Retrieve the correct connections.
-		QVector<IConnection*> connections;
-		if(direction < 0) connections = sourceBlock->getInConnections();
-		if(direction > 0) connections = sourceBlock->getOutConnections();
+	//Complete the previous animation.
+	finishAnimation();
 
-		//Iterate over the connections.
-		foreach(IConnection* connection, connections)
-		{
-			//Get the connection's corresponding block.
-			IBlock* layoutedBlock = NULL;
-			if(direction < 0) layoutedBlock = connection->getSource();
-			if(direction > 0) layoutedBlock = connection->getDest();
+	//Store the final positions, but keep the items at their current position.
+	foreach(IPipelineItem* pipelineItem, positions.keys())
+	{
+		LayoutInfo* layoutInfo = NULL;
+		getLayoutInfo(pipelineItem, &layoutInfo);
 
-			//Get the block's layout info.
-			LayoutInfo* layoutInfo = NULL;
-			getLayoutInfo(layoutedBlock, &layoutInfo);
-
-			//Ensure the block is not already layouted in another pipeline.
-			if(!layoutInfo->_rootBlock || layoutInfo->_rootBlock == sourceInfo->_rootBlock)
-			{
-				layoutInfo->_rootBlock = sourceInfo->_rootBlock;
-				layoutInfo->_logicalPosition.setX(sourceInfo->_logicalPosition.x() + direction);
-				layoutedBlocks.insert(layoutedBlock);
-			}
-		}
+		QPointF startPosition = layoutInfo->_currentPosition;
+		setItemPosition(layoutInfo, positions[pipelineItem], false);
+		_animatedItems[pipelineItem] = QLineF(startPosition, layoutInfo->_currentPosition);
+		layoutInfo->_currentPosition = startPosition;
 	}
 
-	//Return all layouted blocks.
-	return layoutedBlocks;
+	_animation->start();
 }
 
-void PipelineSceneLayouter::autoLayoutVertically(QSet<IBlock*> rootBlocks)
+void PipelineSceneLayouter::animationStep(const QVariant& value)
 {
-	//Iterate over all pipelines.
-	int pipelineOffset = 0;
-	foreach(IBlock* rootBlock, rootBlocks)
+	//Interpolate the positions of all animated items.
+	foreach(IPipelineItem* pipelineItem, _animatedItems.keys())
 	{
-		//Iterate over all layouted items of the current pipeline and align them vertically.
-		int maxOffset = 0;
-		QMap<int, int> verticalCounts;
-		foreach(LayoutInfo* layoutInfo, _itemLayoutInfos.values())
-		{
-			//Ensure block is part of current pipeline.
-			if(layoutInfo->_rootBlock == rootBlock)
-			{
-				//Check if a block on the same horizontal position was already layouted.
-				int verticalPosition = verticalCounts.value(layoutInfo->_logicalPosition.x(), 0);
-				verticalCounts[layoutInfo->_logicalPosition.x()] = verticalPosition + 1;
-
-				//Set the vertical position.
-				layoutInfo->_logicalPosition.setY(verticalPosition + pipelineOffset);
-				maxOffset = qMax(maxOffset, verticalPosition);
-			}
-		}
+		_itemLayoutInfos[pipelineItem]->_currentPosition = _animatedItems[pipelineItem].pointAt(value.toReal());
+		emit layoutChanged(pipelineItem);
+	}
+}
+
+void PipelineSceneLayouter::finishAnimation()
+{
+	//Ensure an animation is running.
+	if(_animatedItems.isEmpty())
+		return;
+
+	QList<IPipelineItem*> animatedItems = _animatedItems.keys();
+	_animatedItems.clear();
+	_animation->stop();
 
-		//Adjust total offset for each pipeline.
-		pipelineOffset += maxOffset + 1;
+	//Move the items to their final position.
+	foreach(IPipelineItem* pipelineItem, animatedItems)
+	{
+		_itemLayoutInfos[pipelineItem]->_currentPosition = _itemLayoutInfos[pipelineItem]->_basePosition;
+		emit layoutChanged(pipelineItem);
 	}
 }
@@ -28,18 +28,28 @@
 
 #include "commands/ichangeable.h"
 #include "data/iblock.h"
+#include "data/iconnection.h"
 #include "data/irendercommand.h"
 #include "data/ipipelineitem.h"
 #include "data/iserializable.h"
 
 #include <QObject>
 #include <QPointF>
+#include <QLineF>
 #include <QMap>
+#include <QSet>
+#include <QSharedPointer>
+#include <QVariant>
+#include <QVector>
+
+class QTimer;
+class QVariantAnimation;
 
 namespace ysm
 {
 
 	//! \brief Responsible for layouting pipeline scenes. Stores the layout information scene independently.
+	//! Auto layouts are calculated by a layered graph layout on a worker thread, the items are animated to the result.
 	class PipelineSceneLayouter : public QObject, public ISerializable, public IChangeable
 	{
 		Q_OBJECT
@@ -52,16 +62,28 @@ namespace ysm
 			//! \brief The item's positions.
 			QPointF _previewPosition, _basePosition, _currentPosition, _autoPosition;
 
-			//! \brief Logical auto layout position.
-			QPoint _logicalPosition;
+			//! \brief The connection's auto layout route.
+			QVector<QPointF> _route;
+
+			//! \brief The block's neighbours at the time of the last auto layout.
+			QSet<IBlock*> _layoutNeighbours;
 
 			//! \brief Block that defines the item's auto layout anchor.
 			IBlock* _rootBlock;
 
 			//! \brief Wether the item is selected or not.
 			bool _selected;
+
+			//! \brief Wether the item was neither placed by the user nor by an auto layout.
+			bool _layoutPending;
+
+			//! \brief Wether the layout neighbours were recorded.
+			bool _layoutRecorded;
 		};
 
+		//! \brief Snapshot of a pipeline, which is layouted on a worker thread.
+		struct AutoLayoutTask;
+
 	public:
 
 		/*!
@@ -85,6 +107,21 @@ namespace ysm
 		 */
 		QPointF getAutoLayoutItemPosition(IPipelineItem* pipelineItem);
 
+		/*!
+		 * \brief Checks if the latest auto layout calculated a position for the given item.
+		 * \param pipelineItem The pipeline item.
+		 * \return True, if the item has an auto layout position.
+		 */
+		bool hasAutoLayoutItemPosition(IPipelineItem* pipelineItem);
+
+		/*!
+		 * \brief Returns the connection's route, calculated by the latest auto layout.
+		 * The route is only valid, as long as the connected blocks stay at their auto layout position.
+		 * \param connection The connection.
+		 * \return The route in scene coordinates, from source to target port.
+		 */
+		QVector<QPointF> getConnectionRoute(IConnection* connection);
+
 		/*!
 		 * \brief Sets the item's position.
 		 * \param pipelineItem The pipeline item.
@@ -126,6 +163,47 @@ namespace ysm
 		 */
 		void updateAutoLayout(IPipeline* pipeline);
 
+		/*!
+		 * \brief Starts to auto layout the given pipeline on a worker thread. Emits autoLayoutFinished() when the auto
+		 * layout is calculated, the receiver either applies or discards it. A running auto layout is discarded.
+		 * \param pipeline The pipeline.
+		 * \param incremental If true, only new blocks and blocks with changed connections are layouted.
+		 */
+		void startAutoLayout(IPipeline* pipeline, bool incremental);
+
+		/*!
+		 * \brief Checks if an auto layout is calculated at the moment.
+		 * \return True, if the auto layout is running.
+		 */
+		bool isAutoLayoutRunning() const;
+
+		//! \brief Stores the finished auto layout as auto layout information, if any.
+		void applyFinishedAutoLayout();
+
+		//! \brief Drops the finished auto layout without changing the layout information.
+		void discardFinishedAutoLayout();
+
+		/*!
+		 * \brief Returns the number of edge crossings of the latest auto layout.
+		 * \return The crossing count.
+		 */
+		int getAutoLayoutCrossingCount() const;
+
+		/*!
+		 * \brief Returns the time needed to calculate the latest auto layout.
+		 * \return The time in milliseconds.
+		 */
+		qint64 getAutoLayoutTime() const;
+
+		/*!
+		 * \brief Sets the positions of the given items and animates the items towards them.
+		 * \param positions The new item positions.
+		 */
+		void animateItemPositions(const QMap<IPipelineItem*, QPointF>& positions);
+
+		//! \brief Moves all animated items to their final position.
+		void finishAnimation();
+
 		/*!
 		 * \brief Unregisters a block from the layouter.
 		 * \param pipelineItem The pipeline item.
@@ -153,6 +231,9 @@ namespace ysm
 		//! \brief An item's layout data changed.
 		void layoutChanged(IPipelineItem*);
 
+		//! \brief The auto layout of the pipeline was calculated and waits to be applied or discarded.
+		void autoLayoutFinished(IPipeline*);
+
 	protected:
 
 		/*!
@@ -171,23 +252,51 @@ namespace ysm
 		void setItemPosition(LayoutInfo* layoutInfo, QPointF position, bool previewOnly);
 
 		/*!
-		 * \brief Auto layout all blocks, that are connected to the source blocks.
-		 * \param sourceBlocks The source blocks.
-		 * \param direction The direction: -1 for left, 1 for right.
-		 * \return All affected blocks.
+		 * \brief Creates a snapshot of the pipeline, that can be layouted without accessing the pipeline.
+		 * \param pipeline The pipeline.
+		 * \param incremental If true, untouched blocks keep their position.
+		 * \return The auto layout task.
 		 */
-		QSet<IBlock*> autoLayoutHorizontally(QSet<IBlock*> sourceBlocks, int direction);
+		QSharedPointer<AutoLayoutTask> createAutoLayoutTask(IPipeline* pipeline, bool incremental);
 
 		/*!
-		 * \brief Layout the blocks vertically, after the horizontal layout is done.
-		 * \param rootBlocks The root blocks blocks.
+		 * \brief Stores the calculated layout as auto layout information.
+		 * \param task The finished auto layout task.
 		 */
-		void autoLayoutVertically(QSet<IBlock*> rootBlocks);
+		void applyAutoLayout(AutoLayoutTask* task);
+
+	protected slots:
+
+		//! \brief Checks if the running auto layout is finished.
+		void pollAutoLayout();
+
+		/*!
+		 * \brief Moves the animated items.
+		 * \param value The animation's progress.
+		 */
+		void animationStep(const QVariant& value);
 
 	private:
 
 		//! \brief Contains all pipeline item positions indexed by the pipeline item id.
 		QMap<IPipelineItem*, LayoutInfo*> _itemLayoutInfos;
+
+		//! \brief The running auto layout.
+		QSharedPointer<AutoLayoutTask> _autoLayoutTask;
+
+		//! \brief The finished auto layout, which was not applied yet.
+		QSharedPointer<AutoLayoutTask> _finishedLayoutTask;
+
+		//! \brief Polls the running auto layout.
+		QTimer* _autoLayoutTimer;
+
+		//! \brief The statistics of the latest auto layout.
+		int _crossingCount;
+		qint64 _layoutTime;
+
+		//! \brief Animates the items, with their start and end positions.
+		QVariantAnimation* _animation;
+		QMap<IPipelineItem*, QLineF> _animatedItems;
 	};
 
 }
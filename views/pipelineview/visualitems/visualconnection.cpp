@@ -119,10 +119,24 @@ QColor VisualConnection::getTargetColor() const
 	return PipelineConnection::getTargetColor();
 }
 
+QVector<QPointF> VisualConnection::getRoute() const
+{
+	//Use the route of the scene's auto layout.
+	PipelineScene* pipelineScene = getPipelineScene();
+	if(pipelineScene)
+		return pipelineScene->getLayouter()->getConnectionRoute(_connection);
+
+	//No route available.
+	return QVector<QPointF>();
+}
+
 void VisualConnection::restoreFromLayouter(PipelineSceneLayouter* layouter)
 {
 	//Restore the position.
 	VisualPipelineItem::restoreFromLayouter(layouter);
+
+	//The route might have changed.
+	layoutChanged();
 }
 
 IPipelineItem* VisualConnection::getPipelineItem() const { return _connection; }
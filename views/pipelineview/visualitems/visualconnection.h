@@ -108,6 +108,12 @@ namespace ysm
 		 */
 		QColor getTargetColor() const Q_DECL_OVERRIDE;
 
+		/*!
+		 * \brief Gets the route calculated by the scene's auto layout.
+		 * \return The route.
+		 */
+		QVector<QPointF> getRoute() const Q_DECL_OVERRIDE;
+
 		//! \brief Restores the layout using the parent scene's layouter.
 		void restoreFromLayouter(PipelineSceneLayouter* layouter) Q_DECL_OVERRIDE;
 
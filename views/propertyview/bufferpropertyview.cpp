@@ -39,4 +39,5 @@ BufferPropertyView::BufferPropertyView(IPipelineItem* pipelineItem, QWidget* par
     //Set Layout
     setPropertyGroup(pipelineItem->getProperty<EnumProperty>(PropertyID::Buffer_UsageAccess), "Usage");
     setPropertyGroup(pipelineItem->getProperty<EnumProperty>(PropertyID::Buffer_UsageFrequency), "Usage");
+	setPropertyGroup(pipelineItem->getProperty<UIntProperty>(PropertyID::Buffer_InstanceDivisor), "Usage");
 }
@@ -52,4 +52,8 @@ MeshGeneratorPropertyView::MeshGeneratorPropertyView(IPipelineItem* pipelineItem
     setPropertyGroup(pipelineItem->getProperty<FloatProperty>(PropertyID::Mesh_Depth), "Measurements");
     setPropertyGroup(pipelineItem->getProperty<FloatProperty>(PropertyID::Mesh_Radius), "Measurements");
     setPropertyGroup(pipelineItem->getProperty<UIntProperty>(PropertyID::Mesh_Sections), "Measurements");
+    setPropertyGroup(pipelineItem->getProperty<UIntProperty>(PropertyID::Mesh_Rings), "Measurements");
+    setPropertyGroup(pipelineItem->getProperty<UIntProperty>(PropertyID::Mesh_Subdivisions), "Measurements");
+    setPropertyGroup(pipelineItem->getProperty<FloatProperty>(PropertyID::Mesh_TubeRadius), "Measurements");
+    setPropertyGroup(pipelineItem->getProperty<FilenameProperty>(PropertyID::Mesh_HeightMap), "Measurements");
 }
@@ -0,0 +1,82 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "meshlodpropertyview.h"
+#include "data/blocks/meshlodblock.h"
+
+using namespace ysm;
+
+namespace
+{
+	//The level properties.
+	const PropertyID LevelIDs[] = {PropertyID::LOD_TriangleCounts, PropertyID::LOD_Errors};
+}
+
+MeshLODPropertyView::MeshLODPropertyView(IPipelineItem* pipelineItem, QWidget* parentWidget, IView* parentView) :
+	PipelineItemPropertyView(pipelineItem, parentWidget, parentView)
+{
+	//Set Hidden Things
+	setPropertyHidden(pipelineItem->getProperty<UIntProperty>(PropertyID::Data_Outputs));
+	setPropertyHidden(pipelineItem->getProperty<Vec3DataProperty>(PropertyID::Data_VertexPositions));
+	setPropertyHidden(pipelineItem->getProperty<Vec3DataProperty>(PropertyID::Data_VertexNormals));
+	setPropertyHidden(pipelineItem->getProperty<Vec3DataProperty>(PropertyID::Data_VertexTangents));
+	setPropertyHidden(pipelineItem->getProperty<Vec3DataProperty>(PropertyID::Data_VertexBitangents));
+	setPropertyHidden(pipelineItem->getProperty<Vec4DataProperty>(PropertyID::Data_VertexColors));
+	setPropertyHidden(pipelineItem->getProperty<Vec3DataProperty>(PropertyID::Data_TextureCoordinates));
+	setPropertyHidden(pipelineItem->getProperty<UIntDataProperty>(PropertyID::Data_IndexList));
+
+	//Set Simplification Group
+	setPropertyGroup(pipelineItem->getProperty<UIntProperty>(PropertyID::LOD_LevelCount), "Simplification");
+	setPropertyGroup(pipelineItem->getProperty<FloatProperty>(PropertyID::LOD_LevelRatio), "Simplification");
+	setPropertyGroup(pipelineItem->getProperty<BoolProperty>(PropertyID::LOD_PreserveBorders), "Simplification");
+
+	//Set Levels Group
+	for(PropertyID id : LevelIDs)
+		setPropertyGroup(pipelineItem->getProperty<StringProperty>(id), "Levels");
+
+	//Poll the levels.
+	connect(&_refreshTimer, &QTimer::timeout, this, &MeshLODPropertyView::refreshLevels);
+	_refreshTimer.start(REFRESH_INTERVAL);
+}
+
+void MeshLODPropertyView::refreshLevels()
+{
+	if(!isVisible())
+		return;
+
+	//Update the information that changed.
+	IPipelineItem* pipelineItem = getPipelineItem();
+	for(int i = 0; i < 2; i++)
+	{
+		StringProperty* levels = pipelineItem->getProperty<StringProperty>(LevelIDs[i]);
+		QString value = *levels;
+		if(value == _shownLevels[i])
+			continue;
+
+		_shownLevels[i] = value;
+		updatePropertyItemView(levels);
+	}
+}
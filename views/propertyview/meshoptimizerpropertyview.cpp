@@ -0,0 +1,85 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "meshoptimizerpropertyview.h"
+#include "data/blocks/meshoptimizerblock.h"
+
+using namespace ysm;
+
+namespace
+{
+	//The statistic properties.
+	const PropertyID StatisticIDs[] = {PropertyID::Optimizer_ACMRBefore, PropertyID::Optimizer_ACMRAfter,
+									   PropertyID::Optimizer_ATVRBefore, PropertyID::Optimizer_ATVRAfter};
+}
+
+MeshOptimizerPropertyView::MeshOptimizerPropertyView(IPipelineItem* pipelineItem, QWidget* parentWidget, IView* parentView) :
+	PipelineItemPropertyView(pipelineItem, parentWidget, parentView),
+	_shownStatistics{0.0f, 0.0f, 0.0f, 0.0f}
+{
+	//Set Hidden Things
+	setPropertyHidden(pipelineItem->getProperty<UIntProperty>(PropertyID::Data_Outputs));
+	setPropertyHidden(pipelineItem->getProperty<Vec3DataProperty>(PropertyID::Data_VertexPositions));
+	setPropertyHidden(pipelineItem->getProperty<Vec3DataProperty>(PropertyID::Data_VertexNormals));
+	setPropertyHidden(pipelineItem->getProperty<Vec3DataProperty>(PropertyID::Data_VertexTangents));
+	setPropertyHidden(pipelineItem->getProperty<Vec3DataProperty>(PropertyID::Data_VertexBitangents));
+	setPropertyHidden(pipelineItem->getProperty<Vec4DataProperty>(PropertyID::Data_VertexColors));
+	setPropertyHidden(pipelineItem->getProperty<Vec3DataProperty>(PropertyID::Data_TextureCoordinates));
+	setPropertyHidden(pipelineItem->getProperty<UIntDataProperty>(PropertyID::Data_IndexList));
+
+	//Set Optimization Group
+	setPropertyGroup(pipelineItem->getProperty<BoolProperty>(PropertyID::Optimizer_VertexCache), "Optimization");
+	setPropertyGroup(pipelineItem->getProperty<BoolProperty>(PropertyID::Optimizer_VertexFetch), "Optimization");
+	setPropertyGroup(pipelineItem->getProperty<BoolProperty>(PropertyID::Optimizer_Overdraw), "Optimization");
+	setPropertyGroup(pipelineItem->getProperty<FloatProperty>(PropertyID::Optimizer_OverdrawThreshold), "Optimization");
+	setPropertyGroup(pipelineItem->getProperty<UIntProperty>(PropertyID::Optimizer_CacheSize), "Optimization");
+
+	//Set Statistics Group
+	for(PropertyID id : StatisticIDs)
+		setPropertyGroup(pipelineItem->getProperty<FloatProperty>(id), "Statistics");
+
+	//Poll the statistics.
+	connect(&_refreshTimer, &QTimer::timeout, this, &MeshOptimizerPropertyView::refreshStatistics);
+	_refreshTimer.start(REFRESH_INTERVAL);
+}
+
+void MeshOptimizerPropertyView::refreshStatistics()
+{
+	if(!isVisible())
+		return;
+
+	//Update the statistics that changed.
+	IPipelineItem* pipelineItem = getPipelineItem();
+	for(int i = 0; i < 4; i++)
+	{
+		FloatProperty* statistic = pipelineItem->getProperty<FloatProperty>(StatisticIDs[i]);
+		float value = *statistic;
+		if(value == _shownStatistics[i])
+			continue;
+
+		_shownStatistics[i] = value;
+		updatePropertyItemView(statistic);
+	}
+}
@@ -0,0 +1,75 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "parallelprimitivepropertyview.h"
+#include "data/blocks/parallelprimitiveblock.h"
+
+using namespace ysm;
+
+ParallelPrimitivePropertyView::ParallelPrimitivePropertyView(IPipelineItem* pipelineItem, QWidget* parentWidget, IView* parentView) :
+	PipelineItemPropertyView(pipelineItem, parentWidget, parentView),
+	_shownThroughput(0.0f)
+{
+	//Set Primitive Group
+	setPropertyGroup(pipelineItem->getProperty<EnumProperty>(PropertyID::Primitive_Primitive), "Primitive");
+	setPropertyGroup(pipelineItem->getProperty<EnumProperty>(PropertyID::Primitive_DataType), "Primitive");
+	setPropertyGroup(pipelineItem->getProperty<EnumProperty>(PropertyID::Primitive_Operator), "Primitive");
+	setPropertyGroup(pipelineItem->getProperty<EnumProperty>(PropertyID::Primitive_SortOutput), "Primitive");
+	setPropertyGroup(pipelineItem->getProperty<UIntProperty>(PropertyID::Primitive_SegmentSize), "Primitive");
+	setPropertyGroup(pipelineItem->getProperty<UIntProperty>(PropertyID::Primitive_GrainSize), "Primitive");
+
+	//Set Statistics Group
+	setPropertyGroup(pipelineItem->getProperty<UIntProperty>(PropertyID::Primitive_ElementCount), "Statistics");
+	setPropertyGroup(pipelineItem->getProperty<UIntProperty>(PropertyID::Primitive_ChunkCount), "Statistics");
+	setPropertyGroup(pipelineItem->getProperty<FloatProperty>(PropertyID::Primitive_Throughput), "Statistics");
+	setPropertyGroup(pipelineItem->getProperty<FloatProperty>(PropertyID::Primitive_ReferenceThroughput), "Statistics");
+	setPropertyGroup(pipelineItem->getProperty<BoolProperty>(PropertyID::Primitive_ReferenceMeasured), "Statistics");
+	setPropertyGroup(pipelineItem->getProperty<BoolProperty>(PropertyID::Primitive_Verified), "Statistics");
+
+	//Poll the statistics.
+	connect(&_refreshTimer, &QTimer::timeout, this, &ParallelPrimitivePropertyView::refreshStatistics);
+	_refreshTimer.start(REFRESH_INTERVAL);
+}
+
+void ParallelPrimitivePropertyView::refreshStatistics()
+{
+	if(!isVisible())
+		return;
+
+	//Every execution is measured anew, so the throughput identifies new statistics.
+	IPipelineItem* pipelineItem = getPipelineItem();
+	float throughput = *pipelineItem->getProperty<FloatProperty>(PropertyID::Primitive_Throughput);
+	if(throughput == _shownThroughput)
+		return;
+
+	_shownThroughput = throughput;
+	updatePropertyItemView(pipelineItem->getProperty<UIntProperty>(PropertyID::Primitive_ElementCount));
+	updatePropertyItemView(pipelineItem->getProperty<UIntProperty>(PropertyID::Primitive_ChunkCount));
+	updatePropertyItemView(pipelineItem->getProperty<FloatProperty>(PropertyID::Primitive_Throughput));
+	updatePropertyItemView(pipelineItem->getProperty<FloatProperty>(PropertyID::Primitive_ReferenceThroughput));
+	updatePropertyItemView(pipelineItem->getProperty<BoolProperty>(PropertyID::Primitive_ReferenceMeasured));
+	updatePropertyItemView(pipelineItem->getProperty<BoolProperty>(PropertyID::Primitive_Verified));
+}
@@ -0,0 +1,72 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef PARALLELPRIMITIVEPROPERTYVIEW_H
+#define PARALLELPRIMITIVEPROPERTYVIEW_H
+
+#include "pipelineitempropertyview.h"
+
+#include <QTimer>
+
+namespace ysm
+{
+
+	//! \brief Custom property view for parallel primitives, which shows the throughput statistics.
+	//! The primitive is executed whenever the pipeline is evaluated, so the view polls the statistics while it is visible.
+	class ParallelPrimitivePropertyView : public PipelineItemPropertyView
+	{
+		Q_OBJECT
+
+	public:
+
+		/*!
+		 * \brief Initialize new instance.
+		 * \param pipelineItem The pipeline item.
+		 * \param parentWidget The parent widget.
+		 * \param parentView The parent item.
+		 */
+		ParallelPrimitivePropertyView(IPipelineItem* pipelineItem, QWidget* parentWidget, IView* parentView);
+
+	private slots:
+
+		//! \brief Updates the statistics, if new ones are available.
+		void refreshStatistics();
+
+	private:
+
+		//! \brief The refresh interval in milliseconds.
+		static const int REFRESH_INTERVAL = 250;
+
+		//! \brief Timer that triggers the refresh.
+		QTimer _refreshTimer;
+
+		//! \brief The throughput shown.
+		float _shownThroughput;
+	};
+
+}
+
+#endif // PARALLELPRIMITIVEPROPERTYVIEW_H
@@ -139,6 +139,13 @@ void PipelineItemPropertyView::createPropertyItemView(IProperty* property)
 		qDebug() << "Missing edit field for	property of type:" << property->getName();
 }
 
+void PipelineItemPropertyView::updatePropertyItemView(IProperty* property)
+{
+	//Update the property view, if visible.
+	if(_propertyViews.contains(property))
+		_propertyViews[property]->updateView();
+}
+
 void PipelineItemPropertyView::deletePropertyItemView(IProperty* property)
 {
 	//Ensure the property belongs to the correct pipeline item.
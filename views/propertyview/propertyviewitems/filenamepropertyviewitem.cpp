@@ -50,8 +50,8 @@ FilenamePropertyViewItem::FilenamePropertyViewItem(IProperty* property, IView* p
 
 void FilenamePropertyViewItem::browseFile()
 {
-	//Show file dialog.
-	QString filename = QFileDialog::getOpenFileName();
+	//Show file dialog, output files may not exist yet.
+	QString filename = getProperty()->isOutput() ? QFileDialog::getSaveFileName() : QFileDialog::getOpenFileName();
 	if(!filename.isEmpty())
 		_fileSelect->setFilename(filename);
 }
@@ -70,6 +70,7 @@ VaoLayoutPropertyViewItemTab* VaoLayoutPropertyViewItem::createTab(QFormLayout*
 	tabItem->_offset = new QSpinBox();
 	tabItem->_size = new QSpinBox();
 	tabItem->_stride = new QSpinBox();
+	tabItem->_divisor = new QSpinBox();
 	tabItem->_type = new EnumComboBox<GLDataType>(GLTypes::getDataTypeNames());
 	tabItem->_glslType = new EnumComboBox<GLSLDataType>(GLTypes::getGLSLDataTypeNames());
 
@@ -78,6 +79,7 @@ VaoLayoutPropertyViewItemTab* VaoLayoutPropertyViewItem::createTab(QFormLayout*
 	tabItem->_offset->setRange(0, INT_MAX);
 	tabItem->_size->setRange(0, INT_MAX);
 	tabItem->_stride->setRange(0, INT_MAX);
+	tabItem->_divisor->setRange(0, INT_MAX);
 
 	//Connect to model update.
 	connect(tabItem->_connection, SIGNAL(currentIndexChanged(int)), this, SLOT(updateModelValue()));
@@ -87,6 +89,7 @@ VaoLayoutPropertyViewItemTab* VaoLayoutPropertyViewItem::createTab(QFormLayout*
 	connect(tabItem->_offset, SIGNAL(editingFinished()), this, SLOT(updateModelValue()));
 	connect(tabItem->_size, SIGNAL(editingFinished()), this, SLOT(updateModelValue()));
 	connect(tabItem->_stride, SIGNAL(editingFinished()), this, SLOT(updateModelValue()));
+	connect(tabItem->_divisor, SIGNAL(editingFinished()), this, SLOT(updateModelValue()));
 	connect(tabItem->_type, SIGNAL(currentIndexChanged(int)), this, SLOT(updateModelValue()));
 	connect(tabItem->_glslType, SIGNAL(currentIndexChanged(int)), this, SLOT(updateModelValue()));
 
@@ -100,6 +103,7 @@ VaoLayoutPropertyViewItemTab* VaoLayoutPropertyViewItem::createTab(QFormLayout*
 	layout->addRow(NULL, tabItem->_normalized);
 	layout->addRow(new QLabel("Offset"), tabItem->_offset);
 	layout->addRow(new QLabel("Stride"), tabItem->_stride);
+	layout->addRow(new QLabel("Instance Divisor"), tabItem->_divisor);
 
 	//Update the values.
 	updateTab(tabItem, entry);
@@ -119,6 +123,7 @@ void VaoLayoutPropertyViewItem::updateTab(VaoLayoutPropertyViewItemTab* item, in
 	item->_offset->setValue(layoutEntry.offset);
 	item->_size->setValue(layoutEntry.size);
 	item->_stride->setValue(layoutEntry.stride);
+	item->_divisor->setValue(layoutEntry.divisor);
 	item->_type->setCurrentEnum(layoutEntry.type);
 	item->_glslType->setCurrentEnum(layoutEntry.glslType);
 }
@@ -133,7 +138,8 @@ void VaoLayoutPropertyViewItem::updateModelValue()
 		VaoLayoutPropertyViewItemTab* item = getItem(i);
 		newLayout.addEntry(item->_connection->getCurrentConnection(), item->_name->text(), item->_index->value(),
 						   item->_size->value(), item->_type->getCurrentEnum(), item->_normalized->isChecked(),
-						   item->_stride->value(), item->_offset->value(), item->_glslType->getCurrentEnum());
+						   item->_stride->value(), item->_offset->value(), item->_glslType->getCurrentEnum(),
+						   item->_divisor->value());
 	}
 
 	//Call the base to store the property.
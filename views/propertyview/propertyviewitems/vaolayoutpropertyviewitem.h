@@ -52,6 +52,7 @@ namespace ysm
 		QSpinBox* _offset;
 		QSpinBox* _size;
 		QSpinBox* _stride;
+		QSpinBox* _divisor;
 		EnumComboBox<GLDataType>* _type;
 		EnumComboBox<GLSLDataType>* _glslType;
 	};
@@ -0,0 +1,58 @@
+/***********************************************************************************
+ *                                                                                 *
+ * quiGLy - quick GL prototyping                                                   *
+ *                                                                                 *
+ * Copyright (C) 2015-2018 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the quiGLy software package. quiGLy is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * quiGLy is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "readbackpropertyview.h"
+#include "data/blocks/readbackdatasourceblock.h"
+
+using namespace ysm;
+
+ReadbackPropertyView::ReadbackPropertyView(IPipelineItem* pipelineItem, QWidget* parentWidget, IView* parentView) :
+	PipelineItemPropertyView(pipelineItem, parentWidget, parentView),
+	_shownFrame(0)
+{
+	//Set Layout
+	setPropertyGroup(pipelineItem->getProperty<UIntProperty>(PropertyID::Readback_Frame), "Result");
+	setPropertyGroup(pipelineItem->getProperty<UIntProperty>(PropertyID::Readback_Byte), "Result");
+	setPropertyGroup(pipelineItem->getProperty<FloatDataProperty>(PropertyID::Readback_Data), "Result");
+
+	//Poll the results.
+	connect(&_refreshTimer, &QTimer::timeout, this, &ReadbackPropertyView::refreshResult);
+	_refreshTimer.start(REFRESH_INTERVAL);
+}
+
+void ReadbackPropertyView::refreshResult()
+{
+	//Skip, if hidden or nothing new arrived.
+	IPipelineItem* pipelineItem = getPipelineItem();
+	unsigned int frame = *pipelineItem->getProperty<UIntProperty>(PropertyID::Readback_Frame);
+	if(!isVisible() || frame == _shownFrame)
+		return;
+
+	//Update the result properties.
+	_shownFrame = frame;
+	updatePropertyItemView(pipelineItem->getProperty<UIntProperty>(PropertyID::Readback_Frame));
+	updatePropertyItemView(pipelineItem->getProperty<UIntProperty>(PropertyID::Readback_Byte));
+	updatePropertyItemView(pipelineItem->getProperty<FloatDataProperty>(PropertyID::Readback_Data));
+}
@@ -41,6 +41,10 @@
 #include "propertyview/rasterizationpropertyview.h"
 #include "propertyview/timeuniformpropertyview.h"
 #include "propertyview/varyingspropertyview.h"
+#include "propertyview/readbackpropertyview.h"
+#include "propertyview/meshoptimizerpropertyview.h"
+#include "propertyview/parallelprimitivepropertyview.h"
+#include "propertyview/meshlodpropertyview.h"
 
 #include "pipelineview/visualitems/visualpipelineitem.h"
 #include "pipelineview/visualitems/visualpipelineitemfactory.h"
@@ -65,11 +69,15 @@ Registry::Registry(QObject* parent) :
 	registerBlockType<VisualBlock, ModelLoaderPropertyView>(BlockType::ModelLoader, "Model Loader", "Data Source");
 	registerBlockType<VisualBlock, MeshGeneratorPropertyView>(BlockType::MeshGenerator, "Mesh Generator", "Data Source");
 	registerBlockType<VisualBlock, PipelineItemPropertyView>(BlockType::Array, "Array", "Data Source");
+	registerBlockType<VisualBlock, ReadbackPropertyView>(BlockType::Readback, "Readback", "Data Source");
 	registerBlockType<VisualImageLoaderBlock, ImageLoaderPropertyView>(BlockType::ImageLoader, "Image Loader", "Data Source");
 	registerBlockType<VisualBlock, PipelineItemPropertyView>(BlockType::TextureLoader, "Texture Loader", "Data Source");
 
 	//Data processing blocks.
 	registerBlockType<VisualBlock, BufferPropertyView>(BlockType::Buffer, "Buffer", "Data Processing");
+	registerBlockType<VisualBlock, MeshOptimizerPropertyView>(BlockType::MeshOptimizer, "Mesh Optimizer", "Data Processing");
+	registerBlockType<VisualBlock, ParallelPrimitivePropertyView>(BlockType::ParallelPrimitive, "Parallel Primitive", "Data Processing");
+	registerBlockType<VisualBlock, MeshLODPropertyView>(BlockType::MeshLOD, "Mesh LOD", "Data Processing");
 	registerBlockType<VisualBlock, MixerPropertyView>(BlockType::Mixer, "Mixer", "Data Processing");
 	registerBlockType<VisualBlock, VaoPropertyView>(BlockType::VertexArrayObject, "Vertex Array Object", "Data Processing");
 
@@ -112,7 +120,7 @@ Registry::Registry(QObject* parent) :
 	registerBlockType<VisualBlock, PipelineItemPropertyView>(BlockType::Material, "Material", "Uniform");
 
 	//Output / Input blocks.
-	//registerBlockType<VisualBlock, PipelineItemPropertyView>(BlockType::CodeGenerator, "Code Generator", "User In/Out");
+	registerBlockType<VisualBlock, PipelineItemPropertyView>(BlockType::CodeGenerator, "Code Generator", "User In/Out");
 	registerBlockType<VisualOutputBlock, PipelineItemPropertyView>(BlockType::Display, "Display", "User In/Out");
 	registerBlockType<VisualBlock, PipelineItemPropertyView>(BlockType::CameraControl, "Camera Control", "User In/Out");
 